@@ -81,6 +81,13 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \remarks This function can only be used by primary command buffers, i.e. command buffers that have \e not been created with the flag CommandBufferFlags::Secondary.
         \remarks Once this command buffer is submitted for execution to one or more primary command buffers,
         it <b>must not</b> be updated unless all of such primary command buffers are also updated before their next submission to the command queue.
+        \remarks Secondary command buffers can be encoded on worker threads, concurrently to each other and to their primary command buffers,
+        as long as they have finished encoding before they are passed to this function.
+        \note For the OpenGL renderer, the secondary command buffer is referenced rather than copied.
+        If it does not set its own index buffer, its indexed draw commands use the index buffer that is bound when it is executed.
+        If it does not set its own pipeline state, its resource heaps are bound for the pipeline state that is bound when it is executed,
+        but SetResource and SetUniforms require a pipeline state that is set in the secondary command buffer itself.
+        The pipeline state and index buffer it sets remain bound in this command buffer after this call.
         \see CommandBufferFlags
         \todo Incomplete for: D3D12, Vulkan, Metal.
         */
@@ -467,6 +474,8 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \param[in] descriptor Specifies the zero-based index of the descriptor in the currently bound pipeline layout.
         This \b must be in the half-open range <code>[0, PipelineLayout::GetNumBindings)</code>.
         \param[in] resource Specifies the resource that is to be bound to the shader pipeline.
+        \remarks A pipeline state with a pipeline layout must have been set in this command buffer before this call,
+        i.e. secondary command buffers cannot bind individual resources for a pipeline state they inherit from their primary command buffer.
         \see PipelineLayoutDescriptor::bindings
         */
         virtual void SetResource(std::uint32_t descriptor, Resource& resource) = 0;
@@ -24,6 +24,35 @@ namespace LLGL
 {
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Image compression quality enumeration.
+\remarks Higher quality levels reduce the compression error at the cost of a longer encoding time.
+\see CompressImageBuffer
+*/
+enum class CompressionQuality
+{
+    Fast,   //!< Endpoints are determined by the bounding box of the block colors. This is intended for images that are generated every frame.
+    Normal, //!< Endpoints are determined by the principal axis of the block colors.
+    High,   //!< Same as Normal but endpoints are iteratively refined with a least-squares fit and alternative endpoint modes are evaluated.
+};
+
+/**
+\brief Image filter enumeration for resampling images on the CPU.
+\see Image::GenerateMipChain
+\see Image::Resize
+*/
+enum class ImageFilter
+{
+    Box,        //!< Box filter that averages all source pixels covered by each destination pixel. This is the fastest filter.
+    Bilinear,   //!< Triangle filter with a radius of 1 pixel. Equivalent to bilinear interpolation when upsampling.
+    Bicubic,    //!< Catmull-Rom cubic filter with a radius of 2 pixels. Sharper than the bilinear filter with slight ringing.
+    Kaiser,     //!< Kaiser-windowed sinc filter with a radius of 3 pixels. Preserves more detail than the box filter with little ringing.
+    Lanczos3,   //!< Lanczos filter with a radius of 3 pixels. Preserves the most detail but may introduce ringing at hard edges.
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -235,6 +264,8 @@ If this is less than 2, no multi-threading is used. If this is equal to \c LLGL_
 the number of threads will be determined by the workload and the available CPU cores the system supports (e.g. 4 on a quad-core processor).
 Note that this does not guarantee the maximum number of threads the system supports if the workload does not demand it. By default 0.
 \return Byte buffer with the decompressed image data or null if the compression format is not supported for decompression.
+\remarks Supported compression formats are BC1 to BC7. Signed formats are remapped from [-1, 1] to [0, 1] and BC6H is clamped to [0, 1].
+The image extent does not need to be a multiple of the block size.
 */
 LLGL_EXPORT DynamicByteArray DecompressImageBufferToRGBA8UNorm(
     Format              compressedFormat,
@@ -243,6 +274,30 @@ LLGL_EXPORT DynamicByteArray DecompressImageBufferToRGBA8UNorm(
     unsigned            threadCount = 0
 );
 
+/**
+\brief Compresses the specified image buffer into a block compressed format.
+\param[in] compressedFormat Specifies the destination format. This must be Format::BC1UNorm, Format::BC1UNorm_sRGB, Format::BC3UNorm, Format::BC3UNorm_sRGB, Format::BC4UNorm, or Format::BC5UNorm.
+\param[in] srcImageView Specifies the source image view. This can be any uncompressed color format;
+if it is not ImageFormat::RGBA with DataType::UInt8, the image is converted to that format first.
+\param[in] extent Specifies the image extent. This does not need to be a multiple of the block size.
+\param[in] quality Specifies the compression quality. By default CompressionQuality::Normal.
+\param[in] threadCount Specifies the number of threads to use for compression.
+If this is less than 2, no multi-threading is used. If this is equal to \c LLGL_MAX_THREAD_COUNT,
+the number of threads will be determined by the workload and the available CPU cores the system supports (e.g. 4 on a quad-core processor).
+Note that this does not guarantee the maximum number of threads the system supports if the workload does not demand it. By default 0.
+\return Byte buffer with the compressed image data or null if the compression format is not supported for compression.
+\remarks BC1 uses 1-bit alpha for pixels with an alpha value less than 128. BC4 only encodes the red channel and BC5 the red and green channels.
+Color values of sRGB formats are not converted. The result can be passed directly to RenderSystem::CreateTexture.
+\see DecompressImageBufferToRGBA8UNorm
+*/
+LLGL_EXPORT DynamicByteArray CompressImageBuffer(
+    Format              compressedFormat,
+    const ImageView&    srcImageView,
+    const Extent2D&     extent,
+    CompressionQuality  quality     = CompressionQuality::Normal,
+    unsigned            threadCount = 0
+);
+
 /**
 \brief Copies an image buffer region from the source buffer to the destination buffer.
 \param[out] dstImageView Specifies the destination image view.
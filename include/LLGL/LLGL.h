@@ -14,6 +14,7 @@
 #include <LLGL/Canvas.h>
 #include <LLGL/Display.h>
 #include <LLGL/Timer.h>
+#include <LLGL/ThreadPool.h>
 #include <LLGL/TypeInfo.h>
 #include <LLGL/RenderSystem.h>
 #include <LLGL/Log.h>
@@ -219,6 +219,7 @@ struct RenderSystemFlags
         - OpenGL: A debug callback will be registered via \c glDebugMessageCallback if the OpenGL extension \c "GL_KHR_debug" is available.<br>
           See https://www.khronos.org/opengl/wiki/Debug_Output
         - Metal: Not supported.
+        - Null: Buffers are mapped via a temporary copy that is written back on unmap and buffer ranges mapped with read-only access are validated to be unmodified.
         */
         DebugDevice         = (1 << 0),
 
@@ -142,6 +142,59 @@ struct RendererConfigurationOpenGL
     the respective extension and procedure name is printed to standard error output.
     */
     bool                    suppressFailedExtensions    = false;
+
+    /**
+    \brief Specifies whether command buffers with the CommandBufferFlags::MultiSubmit flag are optimized when their encoding ends. By default false.
+    \remarks If this is true, CommandBuffer::End removes redundant viewport, scissor, pipeline state, vertex buffer, and resource heap bindings,
+    merges consecutive indirect draw commands with contiguous arguments in the same buffer, and packs all commands into a single memory block.
+    This increases the cost of CommandBuffer::End but reduces the cost of each submission.
+    \remarks If \c GL_ARB_multi_draw_indirect is supported, merged draw commands are submitted with a single multi-draw command,
+    in which case the \c gl_DrawID shader input enumerates the merged draws instead of being zero for each of them.
+    */
+    bool                    optimizeCommandBuffers      = false;
+
+    /**
+    \brief Specifies whether command buffers with the CommandBufferFlags::MultiSubmit flag are compiled when their encoding ends. By default false.
+    \remarks If this is true, CommandBuffer::End pre-decodes all commands into a list of function pointers, so each submission
+    calls one function per command instead of decoding the command opcodes and sizes again.
+    This is beneficial for command buffers that are recorded once and submitted many times.
+    \remarks If \c optimizeCommandBuffers is also true, command buffers are optimized before they are compiled.
+    */
+    bool                    compileCommandBuffers       = false;
+};
+
+
+/**
+\brief Structure for a Null renderer specific configuration.
+\remarks The Null renderer executes all commands on the CPU and can be used for headless testing.
+*/
+struct RendererConfigurationNull
+{
+    /**
+    \brief Specifies whether command buffers are executed asynchronously on a worker thread. By default false.
+    \remarks If this is false, command buffers are executed on the calling thread when they are submitted.
+    If this is true, CommandQueue::Submit only enqueues command buffers and fences, which are then executed in order on a worker thread.
+    This mimics the behavior of a GPU, i.e. query results are only available and fences are only signaled once the worker thread has reached them,
+    and it allows to test frame pipelining with multiple frames in flight.
+    \remarks RenderSystem functions that read or write resources, e.g. RenderSystem::MapBuffer, and releasing objects wait for the command queue to become idle.
+    */
+    bool asyncSubmission = false;
+
+    /**
+    \brief Specifies whether textures keep a copy of their texels in Morton order (Z-order) for sampling in shaders. By default false.
+    \remarks Texels that are close to each other in 2D are also close to each other in memory in Morton order, which improves cache hit rates for filtered
+    and rotated texture access. The copy is updated lazily on the first sampling operation after a texture has been modified.
+    \remarks This only affects sampling operations in CPU shaders of the Null renderer. Textures with non-power-of-two extents require up to four times the memory.
+    */
+    bool tiledTextures = false;
+
+    /**
+    \brief Specifies whether command buffers with the CommandBufferFlags::MultiSubmit flag are compiled when their encoding ends. By default false.
+    \remarks If this is true, CommandBuffer::End pre-decodes all commands into a list of function pointers, so each submission
+    calls one function per command instead of decoding the command opcodes and sizes again.
+    \see RendererConfigurationOpenGL::compileCommandBuffers
+    */
+    bool compileCommandBuffers = false;
 };
 
 
@@ -0,0 +1,79 @@
+/*
+ * ThreadPool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Constants.h>
+#include <functional>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+/**
+\brief Process-wide pool of worker threads that is used for multi-threaded CPU work in LLGL, such as image conversions.
+\remarks The worker threads are created lazily on first use and persist until the worker count is changed or the process terminates.
+Applications can share this pool for their own CPU work with the Submit and ParallelFor functions.
+*/
+namespace ThreadPool
+{
+
+
+/**
+\brief Sets the number of worker threads of the thread pool.
+\param[in] workerCount Specifies the number of worker threads.
+If this is equal to \c LLGL_MAX_THREAD_COUNT, the number of worker threads is determined by the available CPU cores. This is the default.
+If this is zero, the thread pool is disabled and multi-threaded functions create their own threads for each invocation instead.
+\remarks Changing the worker count waits for all pending tasks of the current pool to complete before its worker threads are released.
+This must not be called from within a task of the thread pool or while other threads submit tasks to the thread pool.
+\see LLGL_MAX_THREAD_COUNT
+*/
+LLGL_EXPORT void SetWorkerCount(unsigned workerCount);
+
+/**
+\brief Returns the number of worker threads of the thread pool or zero if the thread pool is disabled.
+\remarks This does not create the worker threads if they have not been created yet.
+*/
+LLGL_EXPORT unsigned GetWorkerCount();
+
+/**
+\brief Submits the specified task to be executed asynchronously by the next available worker thread.
+\remarks If the thread pool is disabled, the task is executed immediately on the calling thread.
+*/
+LLGL_EXPORT void Submit(const std::function<void()>& task);
+
+/**
+\brief Executes the specified task concurrently over the half-open range <code>[0, count)</code> and waits until all sub-ranges have been processed.
+\param[in] task Specifies the task that is called for each sub-range <code>[begin, end)</code>.
+\param[in] count Specifies the size of the entire range.
+\param[in] threadCount Specifies the maximum number of threads to use. The calling thread also processes sub-ranges.
+If this is equal to \c LLGL_MAX_THREAD_COUNT, the number of threads will be determined by the workload and the available CPU cores. By default \c LLGL_MAX_THREAD_COUNT.
+\param[in] threadMinWorkSize Specifies the minimum size of each sub-range. By default 64.
+\remarks This can be called from within a task of the thread pool.
+*/
+LLGL_EXPORT void ParallelFor(
+    const std::function<void(std::size_t begin, std::size_t end)>&  task,
+    std::size_t                                                     count,
+    unsigned                                                        threadCount         = LLGL_MAX_THREAD_COUNT,
+    unsigned                                                        threadMinWorkSize   = 64
+);
+
+
+} // /namespace ThreadPool
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
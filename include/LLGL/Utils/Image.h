@@ -14,12 +14,72 @@
 #include <LLGL/ImageFlags.h>
 #include <LLGL/SamplerFlags.h>
 #include <LLGL/Utils/ColorRGBA.h>
+#include <LLGL/Utils/TaskScheduler.h>
+#include <LLGL/Container/ArrayView.h>
+#include <LLGL/Container/DynamicVector.h>
 
 
 namespace LLGL
 {
 
 
+class Image;
+
+/**
+\brief Image region structure for batched blit operations.
+\see Image::Blit(const ArrayView<ImageBlitRegion>&, unsigned)
+*/
+struct ImageBlitRegion
+{
+    //! Specifies the source image whose region is to be copied. If this is null, the region is ignored.
+    const Image*    srcImage        = nullptr;
+
+    //! Specifies the offset within the source image. This will be clamped if it exceeds the source image area.
+    Offset3D        srcRegionOffset;
+
+    //! Specifies the extent of the region to copy. This will be clamped if it exceeds the source or destination image area.
+    Extent3D        srcRegionExtent;
+
+    //! Specifies the offset within the destination image. This can also be outside of the image area.
+    Offset3D        dstRegionOffset;
+};
+
+/**
+\brief Descriptor structure for generating MIP-map chains on the CPU.
+\see Image::GenerateMipChain
+*/
+struct MipChainDescriptor
+{
+    //! Specifies the filter to downsample each MIP-map with. By default ImageFilter::Box.
+    ImageFilter     filter              = ImageFilter::Box;
+
+    /**
+    \brief Specifies the number of MIP-maps to generate below the base image. By default 0.
+    \remarks If this is zero, the full MIP-map chain down to a single pixel is generated.
+    */
+    std::uint32_t   numMipLevels        = 0;
+
+    /**
+    \brief Specifies whether the color components are in non-linear sRGB color space. By default false.
+    \remarks If this is true, the color components are averaged in linear color space. The alpha component is always considered linear.
+    */
+    bool            sRGB                = false;
+
+    /**
+    \brief Specifies whether the depth of the image is downsampled as well, i.e. whether the image is a volume. By default false.
+    \remarks If this is false, depth slices are considered array layers (or cube faces) and each slice is downsampled independently.
+    */
+    bool            downsampleDepth     = false;
+
+    /**
+    \brief Specifies the reference value for alpha-tested coverage. By default 0.
+    \remarks If this is greater than zero, the alpha components of each MIP-map are scaled so that the fraction of pixels
+    whose alpha component is greater than this reference value matches the base image.
+    This prevents alpha-tested geometry such as foliage from fading out in the distance.
+    */
+    float           alphaCoverageRef    = 0.0f;
+};
+
 /**
 \brief Utility class to manage the storage and attributes of an image.
 
@@ -106,6 +166,18 @@ class LLGL_EXPORT Image
         */
         void Resize(const Extent3D& extent, const ColorRGBAf& fillColor, const Offset3D& offset);
 
+        /**
+        \brief Resizes the image and scales the previous pixels to the new extent with the specified filter.
+        \param[in] extent Specifies the new image size. If the depth changes, the image is scaled along the depth as well.
+        \param[in] filter Specifies the resampling filter. For downsampling, the filter is widened to cover all source pixels.
+        \param[in] sRGB Specifies whether the color components are in non-linear sRGB color space and are to be filtered in linear color space.
+        \param[in] threadCount Specifies the number of threads the rows are distributed over. See ConvertImageBuffer for details.
+        \remarks Pixels are filtered in 32-bit floating-point precision with separable passes, and values of unsigned normalized data types are clamped.
+        This has no effect if the image has a compressed, depth-stencil, or stencil format.
+        \see ImageFilter
+        */
+        void Resize(const Extent3D& extent, const ImageFilter filter, bool sRGB = false, unsigned threadCount = 0);
+
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
 
@@ -122,13 +194,50 @@ class LLGL_EXPORT Image
         //! Releases the ownership of the image buffer and resets all attributes.
         DynamicByteArray Release();
 
+        /* ----- MIP-maps ----- */
+
+        /**
+        \brief Generates a chain of MIP-map images from this image.
+        \param[in] desc Specifies the filter and color options for downsampling.
+        \param[in] threadCount Specifies the number of threads to use. Rows of all layers are distributed over these threads.
+        If this is equal to \c LLGL_MAX_THREAD_COUNT, the number of threads will be determined by the workload and the available CPU cores. By default 0.
+        \return Array of MIP-map images, starting with the first MIP-map below this image. Each MIP-map has half the extent of its predecessor.
+        The array is empty if this image has a compressed, depth-stencil, or stencil format.
+        \remarks Each MIP-map is downsampled from the previous one in 32-bit floating-point precision,
+        so the images can be uploaded as a complete MIP-map chain with RenderSystem::WriteTexture instead of generating MIP-maps on the GPU.
+        \see MipChainDescriptor
+        \see NumMipLevels
+        */
+        DynamicVector<Image> GenerateMipChain(const MipChainDescriptor& desc = {}, unsigned threadCount = 0) const;
+
+        /**
+        \brief Generates a chain of MIP-map images from this image with tasks of the TaskScheduler.
+        \param[out] outMipChain Receives the MIP-map images. The array is allocated immediately, but the image contents are undefined until the returned task has completed.
+        \param[in] desc Specifies the filter and color options for downsampling.
+        \param[in] threadCount Specifies the number of threads each task uses to convert and downsample its rows. By default 0.
+        \param[in] dependencies Specifies the tasks that must complete before this image is read, e.g. a task that decodes this image.
+        \return Handle to the task that completes once all MIP-maps have been generated.
+        This is an invalid handle if there is nothing to generate, i.e. if \c outMipChain is empty.
+        \remarks Each layer, or the entire volume if MipChainDescriptor::downsampleDepth is true, is downsampled by its own chain of tasks with one task per MIP-map.
+        This allows the MIP-map chains of several layers and several images to be generated concurrently. The results are identical to GenerateMipChain.
+        \remarks This image and \c outMipChain must neither be modified nor destroyed until the returned task has completed.
+        \see GenerateMipChain
+        \see TaskScheduler::WaitAll
+        */
+        TaskHandle GenerateMipChainAsync(
+            DynamicVector<Image>&           outMipChain,
+            const MipChainDescriptor&       desc            = {},
+            unsigned                        threadCount     = 0,
+            const ArrayView<TaskHandle>&    dependencies    = {}
+        ) const;
+
         /* ----- Pixels ----- */
 
         /**
         \brief Copies a region of the specified source image into this image.
         \param[in] dstRegionOffset Specifies the offset within the destination image (i.e. this Image instance). This can also be outside of the image area.
         \param[in] srcImage Specifies the source image whose region is to be copied. This must have the same format and data type as this image.
-        If the source image is the same object as this image and the destination and source regions overlap, an internal temporary copy is allocated for reading the data.
+        If the source image is the same object as this image, the destination and source regions may overlap.
         \param[in] srcRegionOffset Specifies the offset within the source image. This will be clamped if it exceeds the source image area.
         \param[in] srcRegionExtent Specifies the extent of the region to copy. This will be clamped if it exceeds the source or destination image area.
         \remarks If one of the region offsets is clamped, the region extent will be adjusted respectively.
@@ -137,6 +246,21 @@ class LLGL_EXPORT Image
         */
         void Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent);
 
+        /**
+        \brief Copies a batch of regions from the specified source images into this image.
+        \param[in] regions Specifies the regions to copy. Each region is clamped the same way as for the single-region Blit function.
+        Regions whose source image has a different format or data type compared to this image are ignored.
+        \param[in] threadCount Specifies the number of threads to copy large workloads with. By default 0.
+        If this is equal to \c LLGL_MAX_THREAD_COUNT, the number of threads will be determined by the workload and the available CPU cores.
+        \remarks This is intended for use cases like packing many small images into a texture atlas:
+        the regions are copied in the order of their destination, horizontally adjacent regions are merged to copy entire rows at once,
+        and large workloads are split into bands of rows that are distributed over multiple threads. No temporary image buffer is allocated.
+        \remarks The destination regions must not overlap with each other, or with any source region within this image other than their own source region.
+        Otherwise, the result is undefined.
+        \see Blit(Offset3D, const Image&, Offset3D, Extent3D)
+        */
+        void Blit(const ArrayView<ImageBlitRegion>& regions, unsigned threadCount = 0);
+
         /**
         \brief Reads a region of pixels from this image into the destination image buffer specified by \c imageView.
         \param[in] offset Specifies the region offset within this image to read from.
@@ -166,6 +290,7 @@ class LLGL_EXPORT Image
         \param[in] extent Specifies the region extent within this image to write to.
         \param[in] imageView Specifies the source image view to read the region from.
         If the \c data member of this descriptor is null or if the sub-image region is not inside the image, this function has no effect.
+        The \c rowStride and \c layerStride members of this descriptor are respected; if they are zero, the source rows and layers are assumed to be tightly packed.
         \param[in] threadCount Specifies the number of threads to use if the data needs to be converted (see ConvertImageBuffer for more details). By default 0.
         \see IsRegionInside
         \see ConvertImageBuffer
@@ -253,6 +378,8 @@ class LLGL_EXPORT Image
 
         void ClampRegion(Offset3D& offset, Extent3D& extent) const;
 
+        bool ClampBlitRegion(Offset3D& dstRegionOffset, const Image& srcImage, Offset3D& srcRegionOffset, Extent3D& srcRegionExtent) const;
+
     private:
 
         Extent3D            extent_;
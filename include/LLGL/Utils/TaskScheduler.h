@@ -0,0 +1,121 @@
+/*
+ * TaskScheduler.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_TASK_SCHEDULER_H
+#define LLGL_TASK_SCHEDULER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Container/ArrayView.h>
+#include <functional>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Handle to a task that has been scheduled with the TaskScheduler.
+\remarks Task handles are reference counted, i.e. copying a handle refers to the same task.
+A task is kept alive until it has been executed, even if all handles to it have been released.
+\see TaskScheduler::Schedule
+*/
+class LLGL_EXPORT TaskHandle
+{
+
+    public:
+
+        //! Initializes an invalid task handle.
+        TaskHandle() = default;
+
+        TaskHandle(const TaskHandle& rhs);
+        TaskHandle(TaskHandle&& rhs) noexcept;
+
+        TaskHandle& operator = (const TaskHandle& rhs);
+        TaskHandle& operator = (TaskHandle&& rhs) noexcept;
+
+        ~TaskHandle();
+
+    public:
+
+        //! Returns true if this handle refers to a task.
+        bool IsValid() const;
+
+        //! Returns true if the task has completed execution. Invalid handles are always considered to be completed.
+        bool IsCompleted() const;
+
+        /**
+        \brief Waits until the task has completed execution.
+        \remarks While waiting, the calling thread executes other pending tasks. This can also be called from within a task.
+        */
+        void Wait() const;
+
+        /**
+        \brief Schedules the specified task as continuation of this task.
+        \remarks This is equivalent to <code>TaskScheduler::Schedule(task, { *this })</code>.
+        \return Handle to the continuation task.
+        */
+        TaskHandle Then(const std::function<void()>& task) const;
+
+    public:
+
+        //! Returns true if this handle refers to a task.
+        inline explicit operator bool () const
+        {
+            return IsValid();
+        }
+
+    private:
+
+        struct Pimpl;
+
+        explicit TaskHandle(Pimpl* pimpl);
+
+        friend struct TaskSchedulerFriend;
+
+    private:
+
+        Pimpl* pimpl_ = nullptr;
+
+};
+
+/**
+\brief Scheduler for tasks with dependencies that are executed by the process-wide pool of worker threads.
+\remarks Idle worker threads steal tasks from each other, so nested parallel work inside tasks (such as image conversions) keeps all worker threads busy.
+If the thread pool is disabled, each task is executed immediately on the thread that completes its last dependency.
+\see ThreadPool::SetWorkerCount
+*/
+namespace TaskScheduler
+{
+
+
+/**
+\brief Schedules the specified task to be executed once all of its dependencies have completed.
+\param[in] task Specifies the task function.
+\param[in] dependencies Specifies the tasks that must complete before this task is executed. Invalid handles are ignored.
+\return Handle to the new task.
+*/
+LLGL_EXPORT TaskHandle Schedule(const std::function<void()>& task, const ArrayView<TaskHandle>& dependencies = {});
+
+/**
+\brief Waits until all specified tasks have completed execution.
+\remarks While waiting, the calling thread executes other pending tasks.
+\see TaskHandle::Wait
+*/
+LLGL_EXPORT void WaitAll(const ArrayView<TaskHandle>& tasks);
+
+
+} // /namespace TaskScheduler
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
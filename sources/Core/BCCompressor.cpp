@@ -0,0 +1,691 @@
+/*
+ * BCCompressor.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "BCCompressor.h"
+#include "Threading.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+// Source 4x4 block of RGBA8 pixels in row-major order.
+struct BCSourceBlock
+{
+    std::uint8_t pixels[16][4];
+};
+
+// Encoded 64-bit color block of BC1 and BC3.
+struct BCColorBlock
+{
+    std::uint16_t color0;
+    std::uint16_t color1;
+    std::uint32_t indices;
+};
+
+// Function pointer type to encode a single block.
+typedef void (*PFN_EncodeBCBlock)(std::uint8_t* dst, const BCSourceBlock& src, CompressionQuality quality);
+
+
+/* ----- Common functions ----- */
+
+static void WriteUInt16(std::uint8_t* bytes, std::uint16_t value)
+{
+    bytes[0] = static_cast<std::uint8_t>(value & 0xFF);
+    bytes[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+static void WriteUInt32(std::uint8_t* bytes, std::uint32_t value)
+{
+    for_range(i, 4u)
+        bytes[i] = static_cast<std::uint8_t>((value >> (i * 8)) & 0xFF);
+}
+
+static std::uint8_t ExpandUNormBits(std::uint32_t value, unsigned bits)
+{
+    value <<= (8 - bits);
+    return static_cast<std::uint8_t>(value | (value >> bits));
+}
+
+static std::uint32_t QuantizeUNormBits(float value, unsigned bits)
+{
+    const float maxValue = static_cast<float>((1u << bits) - 1u);
+    return static_cast<std::uint32_t>(std::max(0.0f, std::min(value * maxValue / 255.0f + 0.5f, maxValue)));
+}
+
+
+/* ----- BC1 and BC3 color blocks ----- */
+
+static std::uint16_t QuantizeRGB565(const float (&color)[3])
+{
+    return static_cast<std::uint16_t>
+    (
+        (QuantizeUNormBits(color[0], 5) << 11) |
+        (QuantizeUNormBits(color[1], 6) <<  5) |
+        (QuantizeUNormBits(color[2], 5)      )
+    );
+}
+
+static void DecodeRGB565(std::uint8_t* dst, std::uint16_t color)
+{
+    dst[0] = ExpandUNormBits((color >> 11) & 0x1F, 5);
+    dst[1] = ExpandUNormBits((color >>  5) & 0x3F, 6);
+    dst[2] = ExpandUNormBits((color      ) & 0x1F, 5);
+}
+
+// Generates the color palette the same way as the decoder. Only the RGB components are generated.
+static void MakeColorPalette(std::uint8_t (&palette)[4][3], std::uint16_t color0, std::uint16_t color1, bool threeColorMode)
+{
+    DecodeRGB565(palette[0], color0);
+    DecodeRGB565(palette[1], color1);
+
+    if (threeColorMode)
+    {
+        for_range(i, 3u)
+        {
+            palette[2][i] = static_cast<std::uint8_t>((palette[0][i] + palette[1][i] + 1) / 2);
+            palette[3][i] = 0;
+        }
+    }
+    else
+    {
+        for_range(i, 3u)
+        {
+            palette[2][i] = static_cast<std::uint8_t>((2 * palette[0][i] + palette[1][i] + 1) / 3);
+            palette[3][i] = static_cast<std::uint8_t>((palette[0][i] + 2 * palette[1][i] + 1) / 3);
+        }
+    }
+}
+
+static std::uint32_t ColorDistanceSq(const std::uint8_t* lhs, const std::uint8_t* rhs)
+{
+    std::uint32_t distSq = 0;
+    for_range(i, 3u)
+    {
+        const int d = static_cast<int>(lhs[i]) - static_cast<int>(rhs[i]);
+        distSq += static_cast<std::uint32_t>(d * d);
+    }
+    return distSq;
+}
+
+/*
+Quantizes the specified endpoints and selects the closest palette entry for each pixel. Returns the squared error of the block.
+If 'transparentMask' is non-zero, the 3-color mode is used and the masked pixels are mapped to transparent black.
+*/
+static std::uint32_t EncodeColorEndpoints(
+    BCColorBlock&           outBlock,
+    const BCSourceBlock&    src,
+    const float             (&endpoint0)[3],
+    const float             (&endpoint1)[3],
+    std::uint32_t           transparentMask)
+{
+    const bool threeColorMode = (transparentMask != 0);
+
+    std::uint16_t color0 = QuantizeRGB565(endpoint0);
+    std::uint16_t color1 = QuantizeRGB565(endpoint1);
+
+    /* Order endpoints to select the palette mode: color0 > color1 for 4-color mode, color0 <= color1 for 3-color mode */
+    if (threeColorMode ? (color0 > color1) : (color0 < color1))
+        std::swap(color0, color1);
+
+    outBlock.color0     = color0;
+    outBlock.color1     = color1;
+    outBlock.indices    = 0;
+
+    if (color0 == color1 && !threeColorMode)
+    {
+        /* Both endpoints are equal, so the block decodes in 3-color mode; only use the first palette entry */
+        std::uint8_t color[3];
+        DecodeRGB565(color, color0);
+        std::uint32_t error = 0;
+        for_range(i, 16u)
+            error += ColorDistanceSq(src.pixels[i], color);
+        return error;
+    }
+
+    std::uint8_t palette[4][3];
+    MakeColorPalette(palette, color0, color1, threeColorMode);
+
+    const std::uint32_t numColors = (threeColorMode ? 3 : 4);
+    std::uint32_t error = 0;
+
+    for_range(i, 16u)
+    {
+        std::uint32_t bestIndex = 0;
+
+        if (((transparentMask >> i) & 0x1) != 0)
+            bestIndex = 3;
+        else
+        {
+            std::uint32_t bestDistSq = ColorDistanceSq(src.pixels[i], palette[0]);
+            for_subrange(j, 1u, numColors)
+            {
+                const std::uint32_t distSq = ColorDistanceSq(src.pixels[i], palette[j]);
+                if (distSq < bestDistSq)
+                {
+                    bestDistSq  = distSq;
+                    bestIndex   = j;
+                }
+            }
+            error += bestDistSq;
+        }
+
+        outBlock.indices |= (bestIndex << (i * 2));
+    }
+
+    return error;
+}
+
+// Determines the endpoints by the inset bounding box of all opaque pixels, using the diagonal that best matches the color distribution.
+static void ComputeBoundingBoxEndpoints(float (&endpoint0)[3], float (&endpoint1)[3], const BCSourceBlock& src, std::uint32_t transparentMask)
+{
+    float minColor[3] = { 255.0f, 255.0f, 255.0f };
+    float maxColor[3] = {   0.0f,   0.0f,   0.0f };
+
+    for_range(i, 16u)
+    {
+        if (((transparentMask >> i) & 0x1) == 0)
+        {
+            for_range(c, 3u)
+            {
+                minColor[c] = std::min(minColor[c], static_cast<float>(src.pixels[i][c]));
+                maxColor[c] = std::max(maxColor[c], static_cast<float>(src.pixels[i][c]));
+            }
+        }
+    }
+
+    /* Flip diagonal for red and blue if they correlate negatively with green */
+    float center[3];
+    for_range(c, 3u)
+        center[c] = (minColor[c] + maxColor[c]) * 0.5f;
+
+    float covarianceRG = 0.0f;
+    float covarianceBG = 0.0f;
+
+    for_range(i, 16u)
+    {
+        if (((transparentMask >> i) & 0x1) == 0)
+        {
+            const float g = static_cast<float>(src.pixels[i][1]) - center[1];
+            covarianceRG += (static_cast<float>(src.pixels[i][0]) - center[0]) * g;
+            covarianceBG += (static_cast<float>(src.pixels[i][2]) - center[2]) * g;
+        }
+    }
+
+    if (covarianceRG < 0.0f)
+        std::swap(minColor[0], maxColor[0]);
+    if (covarianceBG < 0.0f)
+        std::swap(minColor[2], maxColor[2]);
+
+    /* Inset bounding box by 1/16 of its size to reduce the error of the interpolated colors */
+    for_range(c, 3u)
+    {
+        const float inset = (maxColor[c] - minColor[c]) / 16.0f;
+        endpoint0[c] = maxColor[c] - inset;
+        endpoint1[c] = minColor[c] + inset;
+    }
+}
+
+// Determines the endpoints by projecting all opaque pixels onto the principal axis of their color distribution.
+static void ComputePrincipalAxisEndpoints(float (&endpoint0)[3], float (&endpoint1)[3], const BCSourceBlock& src, std::uint32_t transparentMask)
+{
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    float minColor[3] = { 255.0f, 255.0f, 255.0f };
+    float maxColor[3] = {   0.0f,   0.0f,   0.0f };
+    float numPixels = 0.0f;
+
+    for_range(i, 16u)
+    {
+        if (((transparentMask >> i) & 0x1) == 0)
+        {
+            for_range(c, 3u)
+            {
+                const float value = static_cast<float>(src.pixels[i][c]);
+                mean[c] += value;
+                minColor[c] = std::min(minColor[c], value);
+                maxColor[c] = std::max(maxColor[c], value);
+            }
+            numPixels += 1.0f;
+        }
+    }
+
+    for_range(c, 3u)
+        mean[c] /= numPixels;
+
+    /* Compute covariance matrix (only the upper triangle as it's symmetric) */
+    float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+    for_range(i, 16u)
+    {
+        if (((transparentMask >> i) & 0x1) == 0)
+        {
+            const float r = static_cast<float>(src.pixels[i][0]) - mean[0];
+            const float g = static_cast<float>(src.pixels[i][1]) - mean[1];
+            const float b = static_cast<float>(src.pixels[i][2]) - mean[2];
+            covariance[0] += r*r;
+            covariance[1] += r*g;
+            covariance[2] += r*b;
+            covariance[3] += g*g;
+            covariance[4] += g*b;
+            covariance[5] += b*b;
+        }
+    }
+
+    /* Find principal axis with power iteration, starting with the bounding box diagonal */
+    float axis[3];
+    for_range(c, 3u)
+        axis[c] = maxColor[c] - minColor[c];
+
+    for_range(iteration, 8u)
+    {
+        const float x = axis[0]*covariance[0] + axis[1]*covariance[1] + axis[2]*covariance[2];
+        const float y = axis[0]*covariance[1] + axis[1]*covariance[3] + axis[2]*covariance[4];
+        const float z = axis[0]*covariance[2] + axis[1]*covariance[4] + axis[2]*covariance[5];
+
+        const float norm = std::max(std::abs(x), std::max(std::abs(y), std::abs(z)));
+        if (norm <= 0.0f)
+            break;
+
+        axis[0] = x / norm;
+        axis[1] = y / norm;
+        axis[2] = z / norm;
+    }
+
+    const float axisLengthSq = axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2];
+    if (axisLengthSq <= 0.0f)
+    {
+        /* All opaque pixels have the same color */
+        for_range(c, 3u)
+        {
+            endpoint0[c] = mean[c];
+            endpoint1[c] = mean[c];
+        }
+        return;
+    }
+
+    /* Project pixels onto principal axis to find the extreme points */
+    float minProj = 0.0f;
+    float maxProj = 0.0f;
+
+    for_range(i, 16u)
+    {
+        if (((transparentMask >> i) & 0x1) == 0)
+        {
+            float proj = 0.0f;
+            for_range(c, 3u)
+                proj += (static_cast<float>(src.pixels[i][c]) - mean[c]) * axis[c];
+            minProj = std::min(minProj, proj);
+            maxProj = std::max(maxProj, proj);
+        }
+    }
+
+    for_range(c, 3u)
+    {
+        endpoint0[c] = std::max(0.0f, std::min(mean[c] + axis[c] * maxProj / axisLengthSq, 255.0f));
+        endpoint1[c] = std::max(0.0f, std::min(mean[c] + axis[c] * minProj / axisLengthSq, 255.0f));
+    }
+}
+
+/*
+Computes the least-squares fit of both endpoints for the indices of the specified block.
+Returns false if the indices do not span a solvable system, e.g. if all pixels use the same palette entry.
+*/
+static bool RefineColorEndpoints(
+    float                   (&endpoint0)[3],
+    float                   (&endpoint1)[3],
+    const BCSourceBlock&    src,
+    const BCColorBlock&     block,
+    std::uint32_t           transparentMask)
+{
+    /* Weights of the first endpoint for each palette entry in 4-color mode and 3-color mode */
+    static const float g_weights4[4] = { 1.0f, 0.0f, 2.0f/3.0f, 1.0f/3.0f };
+    static const float g_weights3[4] = { 1.0f, 0.0f, 1.0f/2.0f, 0.0f };
+
+    const float* weights = (transparentMask != 0 ? g_weights3 : g_weights4);
+
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[3] = { 0.0f, 0.0f, 0.0f };
+    float bx[3] = { 0.0f, 0.0f, 0.0f };
+
+    for_range(i, 16u)
+    {
+        if (((transparentMask >> i) & 0x1) == 0)
+        {
+            const float a = weights[(block.indices >> (i * 2)) & 0x3];
+            const float b = 1.0f - a;
+
+            aa += a*a;
+            ab += a*b;
+            bb += b*b;
+
+            for_range(c, 3u)
+            {
+                ax[c] += a * static_cast<float>(src.pixels[i][c]);
+                bx[c] += b * static_cast<float>(src.pixels[i][c]);
+            }
+        }
+    }
+
+    const float det = aa*bb - ab*ab;
+    if (std::abs(det) < 1.0e-6f)
+        return false;
+
+    for_range(c, 3u)
+    {
+        endpoint0[c] = std::max(0.0f, std::min((bb*ax[c] - ab*bx[c]) / det, 255.0f));
+        endpoint1[c] = std::max(0.0f, std::min((aa*bx[c] - ab*ax[c]) / det, 255.0f));
+    }
+
+    return true;
+}
+
+static void WriteColorBlock(std::uint8_t* dst, const BCColorBlock& block)
+{
+    WriteUInt16(dst,     block.color0);
+    WriteUInt16(dst + 2, block.color1);
+    WriteUInt32(dst + 4, block.indices);
+}
+
+/*
+Encodes the 64-bit color block of BC1 and BC3.
+Only BC1 supports the 3-color mode with a transparent black palette entry, which is used for pixels with an alpha value below 128.
+*/
+static void EncodeColorBlock(std::uint8_t* dst, const BCSourceBlock& src, CompressionQuality quality, bool allowTransparency)
+{
+    std::uint32_t transparentMask = 0;
+    if (allowTransparency)
+    {
+        for_range(i, 16u)
+        {
+            if (src.pixels[i][3] < 128)
+                transparentMask |= (1u << i);
+        }
+
+        if (transparentMask == 0xFFFF)
+        {
+            /* All pixels are transparent */
+            const BCColorBlock block = { 0, 0, 0xFFFFFFFF };
+            WriteColorBlock(dst, block);
+            return;
+        }
+    }
+
+    float endpoint0[3], endpoint1[3];
+    if (quality == CompressionQuality::Fast)
+        ComputeBoundingBoxEndpoints(endpoint0, endpoint1, src, transparentMask);
+    else
+        ComputePrincipalAxisEndpoints(endpoint0, endpoint1, src, transparentMask);
+
+    BCColorBlock block;
+    std::uint32_t error = EncodeColorEndpoints(block, src, endpoint0, endpoint1, transparentMask);
+
+    if (quality == CompressionQuality::High)
+    {
+        /* Refine endpoints as long as the error decreases */
+        for_range(iteration, 4u)
+        {
+            if (error == 0 || !RefineColorEndpoints(endpoint0, endpoint1, src, block, transparentMask))
+                break;
+
+            BCColorBlock refinedBlock;
+            const std::uint32_t refinedError = EncodeColorEndpoints(refinedBlock, src, endpoint0, endpoint1, transparentMask);
+            if (refinedError >= error)
+                break;
+
+            block = refinedBlock;
+            error = refinedError;
+        }
+    }
+
+    WriteColorBlock(dst, block);
+}
+
+
+/* ----- BC3 alpha blocks, BC4 and BC5 ----- */
+
+/*
+Selects the closest palette entry for each value and returns the squared error of the block.
+The palette mode is determined by the order of the endpoints the same way as the decoder.
+*/
+static std::uint32_t EncodeChannelEndpoints(std::uint64_t& outBlock, const std::uint8_t (&values)[16], std::uint32_t value0, std::uint32_t value1)
+{
+    std::uint32_t palette[8];
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if (value0 > value1)
+    {
+        for (std::uint32_t i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+    }
+    else
+    {
+        for (std::uint32_t i = 2; i < 6; ++i)
+            palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    outBlock = (static_cast<std::uint64_t>(value0) | (static_cast<std::uint64_t>(value1) << 8));
+    std::uint32_t error = 0;
+
+    for_range(i, 16u)
+    {
+        std::uint32_t bestIndex     = 0;
+        std::uint32_t bestDistSq    = ~0u;
+
+        for_range(j, 8u)
+        {
+            const int d = static_cast<int>(values[i]) - static_cast<int>(palette[j]);
+            const std::uint32_t distSq = static_cast<std::uint32_t>(d * d);
+            if (distSq < bestDistSq)
+            {
+                bestDistSq  = distSq;
+                bestIndex   = j;
+            }
+        }
+
+        outBlock |= (static_cast<std::uint64_t>(bestIndex) << (16 + i * 3));
+        error += bestDistSq;
+    }
+
+    return error;
+}
+
+/*
+Encodes a 64-bit single channel block of BC4 from the specified channel of the source pixels.
+This is also used for the alpha channel of BC3 and both channels of BC5.
+*/
+static void EncodeChannelBlock(std::uint8_t* dst, const BCSourceBlock& src, unsigned channel, CompressionQuality quality)
+{
+    std::uint8_t values[16];
+    std::uint32_t minValue = 255, maxValue = 0;
+
+    for_range(i, 16u)
+    {
+        values[i] = src.pixels[i][channel];
+        minValue = std::min<std::uint32_t>(minValue, values[i]);
+        maxValue = std::max<std::uint32_t>(maxValue, values[i]);
+    }
+
+    /* Use 8-value mode with the full range of values */
+    std::uint64_t block = 0;
+    std::uint32_t error = EncodeChannelEndpoints(block, values, maxValue, minValue);
+
+    if (quality == CompressionQuality::High && error > 0)
+    {
+        /* Try 6-value mode with explicit 0 and 255 entries for blocks with outliers at the extremes of the range */
+        std::uint32_t minInnerValue = 255, maxInnerValue = 0;
+        for_range(i, 16u)
+        {
+            if (values[i] > 0 && values[i] < 255)
+            {
+                minInnerValue = std::min<std::uint32_t>(minInnerValue, values[i]);
+                maxInnerValue = std::max<std::uint32_t>(maxInnerValue, values[i]);
+            }
+        }
+
+        if (minInnerValue <= maxInnerValue)
+        {
+            std::uint64_t innerBlock = 0;
+            const std::uint32_t innerError = EncodeChannelEndpoints(innerBlock, values, minInnerValue, maxInnerValue);
+            if (innerError < error)
+                block = innerBlock;
+        }
+    }
+
+    for_range(i, 8u)
+        dst[i] = static_cast<std::uint8_t>((block >> (i * 8)) & 0xFF);
+}
+
+
+/* ----- Block encoders ----- */
+
+static void EncodeBC1Block(std::uint8_t* dst, const BCSourceBlock& src, CompressionQuality quality)
+{
+    EncodeColorBlock(dst, src, quality, true);
+}
+
+static void EncodeBC3Block(std::uint8_t* dst, const BCSourceBlock& src, CompressionQuality quality)
+{
+    EncodeChannelBlock(dst, src, 3, quality);
+    EncodeColorBlock(dst + 8, src, quality, false);
+}
+
+static void EncodeBC4Block(std::uint8_t* dst, const BCSourceBlock& src, CompressionQuality quality)
+{
+    EncodeChannelBlock(dst, src, 0, quality);
+}
+
+static void EncodeBC5Block(std::uint8_t* dst, const BCSourceBlock& src, CompressionQuality quality)
+{
+    EncodeChannelBlock(dst, src, 0, quality);
+    EncodeChannelBlock(dst + 8, src, 1, quality);
+}
+
+
+/* ----- Block compression ----- */
+
+// Worker thread procedure for the "CompressRGBA8UNormToBCBlocks" function
+static void CompressRGBA8UNormToBCBlocksWorker(
+    const Extent2D&         extent,
+    const std::uint8_t*     src,
+    std::size_t             blockSize,
+    PFN_EncodeBCBlock       encodeBlock,
+    CompressionQuality      quality,
+    std::uint8_t*           dst,
+    std::size_t             begin,
+    std::size_t             end)
+{
+    const std::uint32_t numBlocksX = (extent.width + 3) / 4;
+
+    BCSourceBlock block;
+
+    for_subrange(i, begin, end)
+    {
+        /* Copy pixels into source block and pad it with the edge pixels of the image */
+        const std::uint32_t x = static_cast<std::uint32_t>(i % numBlocksX) * 4;
+        const std::uint32_t y = static_cast<std::uint32_t>(i / numBlocksX) * 4;
+
+        for_range(row, 4u)
+        {
+            const std::uint32_t srcY = std::min(y + row, extent.height - 1);
+            for_range(col, 4u)
+            {
+                const std::uint32_t srcX = std::min(x + col, extent.width - 1);
+                ::memcpy(block.pixels[row * 4 + col], src + (static_cast<std::size_t>(srcY) * extent.width + srcX) * 4, 4);
+            }
+        }
+
+        encodeBlock(dst + i * blockSize, block, quality);
+    }
+}
+
+static DynamicByteArray CompressRGBA8UNormToBCBlocks(
+    const Extent2D&     extent,
+    const char*         data,
+    std::size_t         dataSize,
+    std::size_t         blockSize,
+    PFN_EncodeBCBlock   encodeBlock,
+    CompressionQuality  quality,
+    unsigned            threadCount)
+{
+    const std::size_t numBlocksX    = (extent.width  + 3) / 4;
+    const std::size_t numBlocksY    = (extent.height + 3) / 4;
+    const std::size_t numBlocks     = numBlocksX * numBlocksY;
+
+    /* Return null on invalid arguments */
+    if (numBlocks == 0 || data == nullptr || dataSize < static_cast<std::size_t>(extent.width) * extent.height * 4)
+        return nullptr;
+
+    DynamicByteArray dstImage{ numBlocks * blockSize, UninitializeTag{} };
+
+    /* Encode independent blocks concurrently; a minimum of 16 blocks per thread amortizes the thread creation */
+    DoConcurrentRange(
+        [&extent, data, blockSize, encodeBlock, quality, &dstImage](std::size_t begin, std::size_t end)
+        {
+            CompressRGBA8UNormToBCBlocksWorker(
+                extent,
+                reinterpret_cast<const std::uint8_t*>(data),
+                blockSize,
+                encodeBlock,
+                quality,
+                reinterpret_cast<std::uint8_t*>(dstImage.get()),
+                begin,
+                end
+            );
+        },
+        numBlocks,
+        threadCount,
+        16
+    );
+
+    return dstImage;
+}
+
+DynamicByteArray CompressRGBA8UNormToBC(
+    Format              compressedFormat,
+    const Extent2D&     extent,
+    const char*         data,
+    std::size_t         dataSize,
+    CompressionQuality  quality,
+    unsigned            threadCount)
+{
+    switch (compressedFormat)
+    {
+        case Format::BC1UNorm:
+        case Format::BC1UNorm_sRGB:
+            return CompressRGBA8UNormToBCBlocks(extent, data, dataSize, 8, EncodeBC1Block, quality, threadCount);
+
+        case Format::BC3UNorm:
+        case Format::BC3UNorm_sRGB:
+            return CompressRGBA8UNormToBCBlocks(extent, data, dataSize, 16, EncodeBC3Block, quality, threadCount);
+
+        case Format::BC4UNorm:
+            return CompressRGBA8UNormToBCBlocks(extent, data, dataSize, 8, EncodeBC4Block, quality, threadCount);
+
+        case Format::BC5UNorm:
+            return CompressRGBA8UNormToBCBlocks(extent, data, dataSize, 16, EncodeBC5Block, quality, threadCount);
+
+        default:
+            return nullptr;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
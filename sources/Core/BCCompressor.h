@@ -0,0 +1,47 @@
+/*
+ * BCCompressor.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_BC_COMPRESSOR_H
+#define LLGL_BC_COMPRESSOR_H
+
+
+#include <LLGL/Types.h>
+#include <LLGL/Format.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Container/DynamicArray.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/*
+Returns an image buffer in the specified BC1, BC3, BC4, or BC5 format for the specified RGBA8UNorm image data, or null on failure.
+The 4x4 blocks are encoded independently, distributed over the specified number of threads.
+If width or height of the input image are not a multiple of 4, the blocks at the right and bottom edges are padded with their edge pixels.
+*/
+DynamicByteArray CompressRGBA8UNormToBC(
+    Format              compressedFormat,
+    const Extent2D&     extent,
+    const char*         data,
+    std::size_t         dataSize,
+    CompressionQuality  quality,
+    unsigned            threadCount = 0
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,119 +6,981 @@
  */
 
 #include "BCDecompressor.h"
+#include "Float16Compressor.h"
+#include "Threading.h"
 #include <LLGL/Types.h>
 #include <LLGL/Utils/ForRange.h>
+#include <algorithm>
 #include <cstring>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
-static void DecompressRGBColor16Bit(std::uint8_t* dst, std::uint16_t src)
+/* ----- Internal structures ----- */
+
+// Decoded 4x4 block of RGBA8 pixels in row-major order.
+struct BCBlockRGBA8
 {
-    dst[0] = ((src >> 12) & 0x000F) * 0xFF / 0x0F;
-    dst[1] = ((src >>  6) & 0x001F) * 0xFF / 0x1F;
-    dst[2] = ((src >>  1) & 0x000F) * 0xFF / 0x0F;
+    std::uint8_t pixels[16][4];
+};
+
+// Function pointer type to decode a single compressed block.
+typedef void (*PFN_DecodeBCBlock)(BCBlockRGBA8& dst, const std::uint8_t* src);
+
+// Reads bit fields from a 128-bit block, starting at the least significant bit of the first byte.
+class BCBitReader
+{
+
+    public:
+
+        BCBitReader(const std::uint8_t* block) :
+            lo_ { ReadUInt64(block)     },
+            hi_ { ReadUInt64(block + 8) }
+        {
+        }
+
+        // Reads the next bit field with up to 32 bits.
+        std::uint32_t Read(unsigned count)
+        {
+            if (count == 0)
+                return 0;
+            const std::uint32_t value = static_cast<std::uint32_t>(lo_ & ((1ull << count) - 1ull));
+            lo_ = (lo_ >> count) | (hi_ << (64 - count));
+            hi_ >>= count;
+            return value;
+        }
+
+    private:
+
+        static std::uint64_t ReadUInt64(const std::uint8_t* bytes)
+        {
+            std::uint64_t value = 0;
+            for_range(i, 8u)
+                value |= (static_cast<std::uint64_t>(bytes[i]) << (i * 8));
+            return value;
+        }
+
+    private:
+
+        std::uint64_t lo_;
+        std::uint64_t hi_;
+
+};
+
+
+/* ----- Common functions ----- */
+
+static std::uint16_t ReadUInt16(const std::uint8_t* bytes)
+{
+    return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
 }
 
-#if 0 //UNUSED
-static void DecompressRGBAColor16Bit(std::uint8_t* dst, std::uint16_t src)
+static std::uint32_t ReadUInt32(const std::uint8_t* bytes)
 {
-    DecompressRGBColor16Bit(dst, src);
-    dst[3] = (src & 0x0001) * 0xFF;
+    return
+    (
+        (static_cast<std::uint32_t>(bytes[0])      ) |
+        (static_cast<std::uint32_t>(bytes[1]) <<  8) |
+        (static_cast<std::uint32_t>(bytes[2]) << 16) |
+        (static_cast<std::uint32_t>(bytes[3]) << 24)
+    );
 }
 
-static std::uint8_t DecompressAlphaChannel4Bit(std::uint32_t& src)
+// Expands an n-bit unsigned normalized value to 8 bits by replicating its most significant bits.
+static std::uint8_t ExpandUNormBits(std::uint32_t value, unsigned bits)
 {
-    auto alpha = static_cast<std::uint8_t >((src & 0x0000000F) * 0xFF / 0x0F);
-    src >>= 4;
-    return alpha;
+    value <<= (8 - bits);
+    return static_cast<std::uint8_t>(value | (value >> bits));
 }
 
-static void Decompress16AlphaChannels4Bit(std::uint8_t* dst, std::uint32_t src0, std::uint32_t src1)
+// Interpolation weights for 2-, 3-, and 4-bit indices of BC6H and BC7 in the range [0, 64].
+static const std::uint8_t g_bptcWeights2[4]    = { 0, 21, 43, 64 };
+static const std::uint8_t g_bptcWeights3[8]    = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static const std::uint8_t g_bptcWeights4[16]   = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+static const std::uint8_t* GetBPTCWeights(unsigned indexBits)
 {
-    for (int i = 0; i < 8; ++i)
+    switch (indexBits)
     {
-        dst[i    ] = DecompressAlphaChannel4Bit(src0);
-        dst[i + 8] = DecompressAlphaChannel4Bit(src1);
+        case 2:     return g_bptcWeights2;
+        case 3:     return g_bptcWeights3;
+        default:    return g_bptcWeights4;
     }
 }
-#endif
 
-static std::uint8_t InterpolateColorComponent(std::uint16_t a, std::uint16_t b)
+static std::int32_t InterpolateBPTC(std::int32_t e0, std::int32_t e1, std::uint32_t weight)
+{
+    return ((64 - static_cast<std::int32_t>(weight)) * e0 + static_cast<std::int32_t>(weight) * e1 + 32) >> 6;
+}
+
+/*
+Partition tables for BC6H and BC7 with two subsets. Bit i specifies the subset of pixel i.
+The second table specifies the anchor index of the second subset.
+*/
+static const std::uint16_t g_bptcPartitions2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+static const std::uint8_t g_bptcAnchors2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// Partition table for BC7 with three subsets, and the anchor indices of the second and third subset.
+static const std::uint8_t g_bptcPartitions3[64][16] =
+{
+    { 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 2, 0, 0, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+    { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 1, 0, 1, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1 },
+    { 0, 0, 1, 1, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2 },
+    { 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2, 0, 1, 1, 2 },
+    { 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2, 0, 1, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2, 1, 2, 2, 2 },
+    { 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0, 2, 2, 2, 0 },
+    { 0, 0, 0, 1, 0, 0, 1, 1, 0, 1, 1, 2, 1, 1, 2, 2 },
+    { 0, 1, 1, 1, 0, 0, 1, 1, 2, 0, 0, 1, 2, 2, 0, 0 },
+    { 0, 0, 0, 0, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 2, 2, 0, 0, 2, 2, 1, 1, 1, 1 },
+    { 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2, 0, 2, 2, 2 },
+    { 0, 0, 0, 1, 0, 0, 0, 1, 2, 2, 2, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2 },
+    { 0, 0, 0, 0, 1, 1, 0, 0, 2, 2, 1, 0, 2, 2, 1, 0 },
+    { 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1, 0, 0, 0, 0 },
+    { 0, 0, 1, 2, 0, 0, 1, 2, 1, 1, 2, 2, 2, 2, 2, 2 },
+    { 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1, 0, 1, 1, 0 },
+    { 0, 0, 0, 0, 0, 1, 1, 0, 1, 2, 2, 1, 1, 2, 2, 1 },
+    { 0, 0, 2, 2, 1, 1, 0, 2, 1, 1, 0, 2, 0, 0, 2, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 2, 0, 0, 2, 2, 2, 2, 2 },
+    { 0, 0, 1, 1, 0, 1, 2, 2, 0, 1, 2, 2, 0, 0, 1, 1 },
+    { 0, 0, 0, 0, 2, 0, 0, 0, 2, 2, 1, 1, 2, 2, 2, 1 },
+    { 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 2, 2, 2 },
+    { 0, 2, 2, 2, 0, 0, 2, 2, 0, 0, 1, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 0, 0, 1, 2, 0, 0, 2, 2, 0, 2, 2, 2 },
+    { 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 2, 0 },
+    { 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0 },
+    { 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0, 1, 2, 0 },
+    { 0, 1, 2, 0, 2, 0, 1, 2, 1, 2, 0, 1, 0, 1, 2, 0 },
+    { 0, 0, 1, 1, 2, 2, 0, 0, 1, 1, 2, 2, 0, 0, 1, 1 },
+    { 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 0, 0, 0, 0, 1, 1 },
+    { 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1 },
+    { 0, 0, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2, 1, 1, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 2, 2, 0, 0, 1, 1 },
+    { 0, 2, 2, 0, 1, 2, 2, 1, 0, 2, 2, 0, 1, 2, 2, 1 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 0, 1, 0, 1 },
+    { 0, 0, 0, 0, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1 },
+    { 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 2, 2, 2, 2 },
+    { 0, 2, 2, 2, 0, 1, 1, 1, 0, 2, 2, 2, 0, 1, 1, 1 },
+    { 0, 0, 0, 2, 1, 1, 1, 2, 0, 0, 0, 2, 1, 1, 1, 2 },
+    { 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 2, 2, 2, 0, 1, 1, 1, 0, 1, 1, 1, 0, 2, 2, 2 },
+    { 0, 0, 0, 2, 1, 1, 1, 2, 1, 1, 1, 2, 0, 0, 0, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2, 2, 1, 1, 2 },
+    { 0, 1, 1, 0, 0, 1, 1, 0, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 0, 2, 2, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 2, 2 },
+    { 0, 0, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 0, 0, 2, 2 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 1, 2 },
+    { 0, 0, 0, 2, 0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 1 },
+    { 0, 2, 2, 2, 1, 2, 2, 2, 0, 2, 2, 2, 1, 2, 2, 2 },
+    { 0, 1, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 },
+    { 0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0 },
+};
+
+static const std::uint8_t g_bptcAnchors3a[64] =
+{
+     3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+     3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+     8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+     3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+};
+
+static const std::uint8_t g_bptcAnchors3b[64] =
+{
+    15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+    15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+    15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+    15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+};
+
+static unsigned GetBPTCSubset(unsigned numSubsets, unsigned partition, unsigned pixel)
 {
-    if (a > b)
-        return static_cast<std::uint8_t>((2 * a + b + 1) / 3);
+    switch (numSubsets)
+    {
+        case 2:     return ((g_bptcPartitions2[partition] >> pixel) & 0x1);
+        case 3:     return g_bptcPartitions3[partition][pixel];
+        default:    return 0;
+    }
+}
+
+// Returns true if the specified pixel is an anchor pixel, whose index omits the most significant bit.
+static bool IsBPTCAnchor(unsigned numSubsets, unsigned partition, unsigned pixel)
+{
+    switch (numSubsets)
+    {
+        case 2:     return (pixel == 0 || pixel == g_bptcAnchors2[partition]);
+        case 3:     return (pixel == 0 || pixel == g_bptcAnchors3a[partition] || pixel == g_bptcAnchors3b[partition]);
+        default:    return (pixel == 0);
+    }
+}
+
+
+/* ----- BC1 - BC3 ----- */
+
+static void DecodeRGB565(std::uint8_t* dst, std::uint16_t color)
+{
+    dst[0] = ExpandUNormBits((color >> 11) & 0x1F, 5);
+    dst[1] = ExpandUNormBits((color >>  5) & 0x3F, 6);
+    dst[2] = ExpandUNormBits((color      ) & 0x1F, 5);
+    dst[3] = 0xFF;
+}
+
+/*
+Decodes the 64-bit color block of BC1, BC2, and BC3.
+Only BC1 supports the 3-color mode with a transparent black palette entry, which is selected by the order of the endpoints.
+*/
+static void DecodeColorBlock(BCBlockRGBA8& dst, const std::uint8_t* src, bool allowTransparency)
+{
+    const std::uint16_t color0 = ReadUInt16(src);
+    const std::uint16_t color1 = ReadUInt16(src + 2);
+
+    std::uint8_t palette[4][4];
+    DecodeRGB565(palette[0], color0);
+    DecodeRGB565(palette[1], color1);
+
+    if (color0 > color1 || !allowTransparency)
+    {
+        /* Generate two more colors at 1/3 and 2/3 between the endpoints */
+        for_range(i, 3u)
+        {
+            palette[2][i] = static_cast<std::uint8_t>((2 * palette[0][i] + palette[1][i] + 1) / 3);
+            palette[3][i] = static_cast<std::uint8_t>((palette[0][i] + 2 * palette[1][i] + 1) / 3);
+        }
+        palette[2][3] = 0xFF;
+        palette[3][3] = 0xFF;
+    }
     else
-        return static_cast<std::uint8_t>((a + b) / 2);
+    {
+        /* Generate one more color halfway between the endpoints and transparent black */
+        for_range(i, 3u)
+            palette[2][i] = static_cast<std::uint8_t>((palette[0][i] + palette[1][i] + 1) / 2);
+        palette[2][3] = 0xFF;
+        ::memset(palette[3], 0, sizeof(palette[3]));
+    }
+
+    /* Generate 4x4 pixel block from 2-bit palette indices */
+    const std::uint32_t indices = ReadUInt32(src + 4);
+    for_range(i, 16u)
+        ::memcpy(dst.pixels[i], palette[(indices >> (i * 2)) & 0x3], 4);
 }
 
-static void InterpolateColor(std::uint8_t* dst, const std::uint8_t* src0, const std::uint8_t* src1)
+// Maps a signed normalized 8-bit value from [-127, 127] to [0, 254]. The value -128 is clamped to -127.
+static std::uint32_t SNorm8ToOffsetUNorm(std::uint8_t value)
 {
-    dst[0] = InterpolateColorComponent(src0[0], src1[0]);
-    dst[1] = InterpolateColorComponent(src0[1], src1[1]);
-    dst[2] = InterpolateColorComponent(src0[2], src1[2]);
+    const std::int32_t signedValue = static_cast<std::int8_t>(value);
+    return static_cast<std::uint32_t>(std::max(signedValue, -127) + 127);
 }
 
-DynamicByteArray DecompressBC1ToRGBA8UNorm(
-    const Extent2D& extent,
-    const char*     data,
-    std::size_t     dataSize,
-    unsigned        /*threadCount*/)
+/*
+Decodes a 64-bit single channel block of BC4 into the specified channel of the destination pixels.
+This is also used for the alpha channel of BC3 and both channels of BC5.
+Signed values are interpolated in the offset range [0, 254] which is then remapped to [0, 255].
+*/
+template <bool IsSigned>
+void DecodeChannelBlock(BCBlockRGBA8& dst, const std::uint8_t* src, unsigned channel)
 {
-    /* Return null on invalid arguments */
-    if (extent.width % 4 != 0 || extent.height % 4 != 0 || data == nullptr || dataSize < extent.width * extent.height / 2)
-        return nullptr;
+    const std::uint32_t maxValue = (IsSigned ? 254 : 255);
+    const std::uint32_t value0   = (IsSigned ? SNorm8ToOffsetUNorm(src[0]) : src[0]);
+    const std::uint32_t value1   = (IsSigned ? SNorm8ToOffsetUNorm(src[1]) : src[1]);
+
+    std::uint32_t palette[8];
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if (value0 > value1)
+    {
+        /* Generate six more values in between the endpoints */
+        for (std::uint32_t i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+    }
+    else
+    {
+        /* Generate four more values in between the endpoints and the minimum and maximum values */
+        for (std::uint32_t i = 2; i < 6; ++i)
+            palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+        palette[6] = 0;
+        palette[7] = maxValue;
+    }
+
+    if (IsSigned)
+    {
+        for_range(i, 8u)
+            palette[i] = (palette[i] * 255 + 127) / 254;
+    }
 
-    DynamicByteArray dstImage{ extent.width * extent.height * 4, UninitializeTag{} };
+    /* Generate 4x4 pixel block from 3-bit palette indices */
+    std::uint64_t indices = 0;
+    for_range(i, 6u)
+        indices |= (static_cast<std::uint64_t>(src[2 + i]) << (i * 8));
 
-    std::uint8_t* output = reinterpret_cast<std::uint8_t*>(dstImage.get());
-    std::uint16_t compressedColor[2];
-    std::uint8_t decompressedColor[4][3];
+    for_range(i, 16u)
+        dst.pixels[i][channel] = static_cast<std::uint8_t>(palette[(indices >> (i * 3)) & 0x7]);
+}
 
-    const std::size_t formatByteSize = 4;
+static void DecodeBC1Block(BCBlockRGBA8& dst, const std::uint8_t* src)
+{
+    DecodeColorBlock(dst, src, true);
+}
+
+static void DecodeBC2Block(BCBlockRGBA8& dst, const std::uint8_t* src)
+{
+    DecodeColorBlock(dst, src + 8, false);
 
-    for_range(y, extent.height / 4u)
+    /* Decode explicit 4-bit alpha values */
+    for_range(i, 16u)
     {
-        for_range(x, extent.width / 4u)
+        const std::uint32_t alpha = (src[i / 2] >> ((i % 2) * 4)) & 0xF;
+        dst.pixels[i][3] = static_cast<std::uint8_t>(alpha * 0x11);
+    }
+}
+
+static void DecodeBC3Block(BCBlockRGBA8& dst, const std::uint8_t* src)
+{
+    DecodeColorBlock(dst, src + 8, false);
+    DecodeChannelBlock<false>(dst, src, 3);
+}
+
+
+/* ----- BC4 and BC5 ----- */
+
+template <bool IsSigned>
+void DecodeBC4Block(BCBlockRGBA8& dst, const std::uint8_t* src)
+{
+    DecodeChannelBlock<IsSigned>(dst, src, 0);
+    for_range(i, 16u)
+    {
+        dst.pixels[i][1] = 0x00;
+        dst.pixels[i][2] = 0x00;
+        dst.pixels[i][3] = 0xFF;
+    }
+}
+
+template <bool IsSigned>
+void DecodeBC5Block(BCBlockRGBA8& dst, const std::uint8_t* src)
+{
+    DecodeChannelBlock<IsSigned>(dst, src, 0);
+    DecodeChannelBlock<IsSigned>(dst, src + 8, 1);
+    for_range(i, 16u)
+    {
+        dst.pixels[i][2] = 0x00;
+        dst.pixels[i][3] = 0xFF;
+    }
+}
+
+
+/* ----- BC6H ----- */
+
+// Endpoint fields of the BC6H mode descriptors: W and X are the endpoints of the first subset, Y and Z of the second subset.
+enum BC6HField : std::uint8_t
+{
+    RW, GW, BW,
+    RX, GX, BX,
+    RY, GY, BY,
+    RZ, GZ, BZ,
+    PartitionField,
+    EndOfFields,
+};
+
+// Bit field that is stored in a BC6H block: 'count' bits starting at bit 'shift' of the specified field.
+struct BC6HBitField
+{
+    BC6HField       field;
+    std::uint8_t    shift;
+    std::uint8_t    count;
+};
+
+struct BC6HMode
+{
+    bool            transformed;
+    std::uint8_t    numSubsets;
+    std::uint8_t    endpointBits;
+    std::uint8_t    deltaBits[3];
+    BC6HBitField    fields[32];
+};
+
+// BC6H modes 1 to 14 with their bit layout after the mode bits (see the BPTC specification).
+static const BC6HMode g_bc6hModes[14] =
+{
+    // Mode 1
+    {
+        true, 2, 10, { 5, 5, 5 },
         {
-            /* Decompress two 16 bit colors */
-            for_range(i, 2)
-            {
-                compressedColor[i] = *reinterpret_cast<const std::uint16_t*>(data);
-                DecompressRGBColor16Bit(decompressedColor[i], compressedColor[i]);
-                data += 2;
-            }
+            { GY, 4, 1 }, { BY, 4, 1 }, { BZ, 4, 1 }, { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 5 }, { GZ, 4, 1 },
+            { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 },
+            { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 2
+    {
+        true, 2, 7, { 6, 6, 6 },
+        {
+            { GY, 5, 1 }, { GZ, 4, 1 }, { GZ, 5, 1 }, { RW, 0, 7 }, { BZ, 0, 1 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 7 },
+            { BY, 5, 1 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 7 }, { BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 },
+            { GY, 0, 4 }, { GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 }, { PartitionField, 0, 5 },
+            { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 3
+    {
+        true, 2, 11, { 5, 4, 4 },
+        {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 5 }, { RW, 10, 1 }, { GY, 0, 4 }, { GX, 0, 4 }, { GW, 10, 1 },
+            { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 4 }, { BW, 10, 1 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 },
+            { RZ, 0, 5 }, { BZ, 3, 1 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 4
+    {
+        true, 2, 11, { 4, 5, 4 },
+        {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 },
+            { GW, 10, 1 }, { GZ, 0, 4 }, { BX, 0, 4 }, { BW, 10, 1 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 0, 1 },
+            { BZ, 2, 1 }, { RZ, 0, 4 }, { GY, 4, 1 }, { BZ, 3, 1 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 5
+    {
+        true, 2, 11, { 4, 4, 5 },
+        {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 10, 1 }, { BY, 4, 1 }, { GY, 0, 4 }, { GX, 0, 4 },
+            { GW, 10, 1 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BW, 10, 1 }, { BY, 0, 4 }, { RY, 0, 4 }, { BZ, 1, 1 },
+            { BZ, 2, 1 }, { RZ, 0, 4 }, { BZ, 4, 1 }, { BZ, 3, 1 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 6
+    {
+        true, 2, 9, { 5, 5, 5 },
+        {
+            { RW, 0, 9 }, { BY, 4, 1 }, { GW, 0, 9 }, { GY, 4, 1 }, { BW, 0, 9 }, { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 },
+            { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 }, { BY, 0, 4 }, { RY, 0, 5 },
+            { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 7
+    {
+        true, 2, 8, { 6, 5, 5 },
+        {
+            { RW, 0, 8 }, { GZ, 4, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 8 }, { BZ, 3, 1 },
+            { BZ, 4, 1 }, { RX, 0, 6 }, { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 },
+            { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 8
+    {
+        true, 2, 8, { 5, 6, 5 },
+        {
+            { RW, 0, 8 }, { BZ, 0, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { GY, 5, 1 }, { GY, 4, 1 }, { BW, 0, 8 }, { GZ, 5, 1 },
+            { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 5 }, { BZ, 1, 1 },
+            { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 9
+    {
+        true, 2, 8, { 5, 5, 6 },
+        {
+            { RW, 0, 8 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 8 }, { BY, 5, 1 }, { GY, 4, 1 }, { BW, 0, 8 }, { BZ, 5, 1 },
+            { BZ, 4, 1 }, { RX, 0, 5 }, { GZ, 4, 1 }, { GY, 0, 4 }, { GX, 0, 5 }, { BZ, 0, 1 }, { GZ, 0, 4 }, { BX, 0, 6 },
+            { BY, 0, 4 }, { RY, 0, 5 }, { BZ, 2, 1 }, { RZ, 0, 5 }, { BZ, 3, 1 }, { PartitionField, 0, 5 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 10
+    {
+        false, 2, 6, { 6, 6, 6 },
+        {
+            { RW, 0, 6 }, { GZ, 4, 1 }, { BZ, 0, 1 }, { BZ, 1, 1 }, { BY, 4, 1 }, { GW, 0, 6 }, { GY, 5, 1 }, { BY, 5, 1 },
+            { BZ, 2, 1 }, { GY, 4, 1 }, { BW, 0, 6 }, { GZ, 5, 1 }, { BZ, 3, 1 }, { BZ, 5, 1 }, { BZ, 4, 1 }, { RX, 0, 6 },
+            { GY, 0, 4 }, { GX, 0, 6 }, { GZ, 0, 4 }, { BX, 0, 6 }, { BY, 0, 4 }, { RY, 0, 6 }, { RZ, 0, 6 }, { PartitionField, 0, 5 },
+            { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 11
+    {
+        false, 1, 10, { 10, 10, 10 },
+        {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 10 }, { GX, 0, 10 }, { BX, 0, 10 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 12
+    {
+        true, 1, 11, { 9, 9, 9 },
+        {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 9 }, { RW, 10, 1 }, { GX, 0, 9 }, { GW, 10, 1 }, { BX, 0, 9 },
+            { BW, 10, 1 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 13: Most significant bits of the base endpoint are stored in reversed order
+    {
+        true, 1, 12, { 8, 8, 8 },
+        {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 8 }, { RW, 11, 1 }, { RW, 10, 1 }, { GX, 0, 8 }, { GW, 11, 1 },
+            { GW, 10, 1 }, { BX, 0, 8 }, { BW, 11, 1 }, { BW, 10, 1 }, { EndOfFields, 0, 0 }
+        }
+    },
+    // Mode 14: Most significant bits of the base endpoint are stored in reversed order
+    {
+        true, 1, 16, { 4, 4, 4 },
+        {
+            { RW, 0, 10 }, { GW, 0, 10 }, { BW, 0, 10 }, { RX, 0, 4 }, { RW, 15, 1 }, { RW, 14, 1 }, { RW, 13, 1 }, { RW, 12, 1 },
+            { RW, 11, 1 }, { RW, 10, 1 }, { GX, 0, 4 }, { GW, 15, 1 }, { GW, 14, 1 }, { GW, 13, 1 }, { GW, 12, 1 }, { GW, 11, 1 },
+            { GW, 10, 1 }, { BX, 0, 4 }, { BW, 15, 1 }, { BW, 14, 1 }, { BW, 13, 1 }, { BW, 12, 1 }, { BW, 11, 1 }, { BW, 10, 1 },
+            { EndOfFields, 0, 0 }
+        }
+    },
+};
 
-            /* Generate two more colors by interpolating the previous two */
-            InterpolateColor(decompressedColor[2], decompressedColor[0], decompressedColor[1]);
-            InterpolateColor(decompressedColor[3], decompressedColor[1], decompressedColor[0]);
+// Returns the index into g_bc6hModes for the specified mode bits, or -1 for reserved modes.
+static int ReadBC6HMode(BCBitReader& reader)
+{
+    const std::uint32_t modeLo = reader.Read(2);
+    if (modeLo < 2)
+        return static_cast<int>(modeLo);
 
-            /* Read palette bitfield */
-            std::uint32_t palette = *reinterpret_cast<const std::uint32_t*>(data);
-            data += 4;
+    const std::uint32_t modeHi = reader.Read(3);
+    if (modeLo == 2)
+        return static_cast<int>(2 + modeHi);
+    if (modeHi < 4)
+        return static_cast<int>(10 + modeHi);
+
+    return -1;
+}
 
-            /* Generate 4x4 pixel block from palette bitmask */
-            for_range(i, 16u)
+static std::int32_t SignExtend(std::int32_t value, unsigned bits)
+{
+    const std::int32_t signBit = (1 << (bits - 1));
+    value &= ((1 << bits) - 1);
+    return ((value ^ signBit) - signBit);
+}
+
+static std::int32_t UnquantizeBC6HEndpoint(std::int32_t value, unsigned bits, bool isSigned)
+{
+    if (isSigned)
+    {
+        if (bits >= 16)
+            return value;
+
+        const bool isNegative = (value < 0);
+        if (isNegative)
+            value = -value;
+
+        std::int32_t result;
+        if (value == 0)
+            result = 0;
+        else if (value >= ((1 << (bits - 1)) - 1))
+            result = 0x7FFF;
+        else
+            result = ((value << 15) + 0x4000) >> (bits - 1);
+
+        return (isNegative ? -result : result);
+    }
+    else
+    {
+        if (bits >= 15)
+            return value;
+        if (value == 0)
+            return 0;
+        if (value == ((1 << bits) - 1))
+            return 0xFFFF;
+        return ((value << 16) + 0x8000) >> bits;
+    }
+}
+
+// Scales the interpolated value to the final half-float bit pattern.
+static std::uint16_t FinishUnquantizeBC6H(std::int32_t value, bool isSigned)
+{
+    if (isSigned)
+    {
+        if (value < 0)
+            return static_cast<std::uint16_t>(0x8000 | (((-value) * 31) >> 5));
+        else
+            return static_cast<std::uint16_t>((value * 31) >> 5);
+    }
+    else
+        return static_cast<std::uint16_t>((value * 31) >> 6);
+}
+
+static std::uint8_t Float16ToUNorm8(std::uint16_t value)
+{
+    const float valueF32 = std::max(0.0f, std::min(DecompressFloat16(value), 1.0f));
+    return static_cast<std::uint8_t>(valueF32 * 255.0f + 0.5f);
+}
+
+template <bool IsSigned>
+void DecodeBC6HBlock(BCBlockRGBA8& dst, const std::uint8_t* src)
+{
+    BCBitReader reader{ src };
+
+    const int modeIndex = ReadBC6HMode(reader);
+    if (modeIndex < 0)
+    {
+        /* Reserved modes decode to black */
+        for_range(i, 16u)
+        {
+            dst.pixels[i][0] = 0x00;
+            dst.pixels[i][1] = 0x00;
+            dst.pixels[i][2] = 0x00;
+            dst.pixels[i][3] = 0xFF;
+        }
+        return;
+    }
+
+    const BC6HMode& mode = g_bc6hModes[modeIndex];
+
+    /* Read endpoints and partition index */
+    std::int32_t endpoints[4][3] = {};
+    std::uint32_t partition = 0;
+
+    for (const BC6HBitField* field = mode.fields; field->field != EndOfFields; ++field)
+    {
+        const std::uint32_t bits = (reader.Read(field->count) << field->shift);
+        if (field->field == PartitionField)
+            partition |= bits;
+        else
+            endpoints[field->field / 3][field->field % 3] |= static_cast<std::int32_t>(bits);
+    }
+
+    /* Apply sign extension and delta transformation to endpoints */
+    const unsigned numEndpoints = mode.numSubsets * 2u;
+    const std::int32_t endpointMask = ((1 << mode.endpointBits) - 1);
+
+    for_range(c, 3u)
+    {
+        if (IsSigned)
+            endpoints[0][c] = SignExtend(endpoints[0][c], mode.endpointBits);
+
+        for (unsigned i = 1; i < numEndpoints; ++i)
+        {
+            if (mode.transformed)
             {
-                /* Get palette index from last two bits */
-                const std::uint32_t paletteIndex = palette & 0x00000003;
-                palette >>= 2;
-
-                /* Write out image color */
-                const std::size_t outputOffset = (((y * 4 + i/4) * extent.width) + (x*4 + i%4)) * formatByteSize;
-                output[outputOffset + 0] = decompressedColor[paletteIndex][0];
-                output[outputOffset + 1] = decompressedColor[paletteIndex][1];
-                output[outputOffset + 2] = decompressedColor[paletteIndex][2];
-                output[outputOffset + 3] = 0xFF;
+                const std::int32_t delta = SignExtend(endpoints[i][c], mode.deltaBits[c]);
+                endpoints[i][c] = (endpoints[0][c] + delta) & endpointMask;
             }
+            if (IsSigned)
+                endpoints[i][c] = SignExtend(endpoints[i][c], mode.endpointBits);
+        }
+
+        for_range(i, numEndpoints)
+            endpoints[i][c] = UnquantizeBC6HEndpoint(endpoints[i][c], mode.endpointBits, IsSigned);
+    }
+
+    /* Read indices and interpolate colors */
+    const unsigned indexBits = (mode.numSubsets == 2 ? 3 : 4);
+    const std::uint8_t* weights = GetBPTCWeights(indexBits);
+
+    for_range(i, 16u)
+    {
+        const unsigned subset   = GetBPTCSubset(mode.numSubsets, partition, i);
+        const unsigned index    = reader.Read(IsBPTCAnchor(mode.numSubsets, partition, i) ? indexBits - 1 : indexBits);
+        const std::int32_t* e0  = endpoints[subset * 2];
+        const std::int32_t* e1  = endpoints[subset * 2 + 1];
+
+        for_range(c, 3u)
+            dst.pixels[i][c] = Float16ToUNorm8(FinishUnquantizeBC6H(InterpolateBPTC(e0[c], e1[c], weights[index]), IsSigned));
+
+        dst.pixels[i][3] = 0xFF;
+    }
+}
+
+
+/* ----- BC7 ----- */
+
+struct BC7Mode
+{
+    std::uint8_t numSubsets;
+    std::uint8_t partitionBits;
+    std::uint8_t rotationBits;
+    std::uint8_t indexSelectionBits;
+    std::uint8_t colorBits;
+    std::uint8_t alphaBits;
+    std::uint8_t endpointPBits;
+    std::uint8_t sharedPBits;
+    std::uint8_t indexBits;
+    std::uint8_t indexBits2;
+};
+
+static const BC7Mode g_bc7Modes[8] =
+{
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+static void DecodeBC7Block(BCBlockRGBA8& dst, const std::uint8_t* src)
+{
+    BCBitReader reader{ src };
+
+    /* Mode is encoded as number of zero bits before the first one bit */
+    unsigned modeIndex = 0;
+    while (modeIndex < 8 && reader.Read(1) == 0)
+        ++modeIndex;
+
+    if (modeIndex == 8)
+    {
+        /* Reserved mode decodes to transparent black */
+        ::memset(&dst, 0, sizeof(dst));
+        return;
+    }
+
+    const BC7Mode& mode = g_bc7Modes[modeIndex];
+
+    const unsigned partition        = reader.Read(mode.partitionBits);
+    const unsigned rotation         = reader.Read(mode.rotationBits);
+    const unsigned indexSelection   = reader.Read(mode.indexSelectionBits);
+
+    /* Read endpoints: all red components first, then green, blue, and alpha */
+    const unsigned numEndpoints = mode.numSubsets * 2u;
+    std::uint32_t endpoints[6][4] = {};
+
+    for_range(c, 3u)
+    {
+        for_range(i, numEndpoints)
+            endpoints[i][c] = reader.Read(mode.colorBits);
+    }
+
+    if (mode.alphaBits > 0)
+    {
+        for_range(i, numEndpoints)
+            endpoints[i][3] = reader.Read(mode.alphaBits);
+    }
+
+    /* Append P-bits, either unique per endpoint or shared per subset */
+    unsigned colorBits = mode.colorBits;
+    unsigned alphaBits = mode.alphaBits;
+
+    if (mode.endpointPBits != 0 || mode.sharedPBits != 0)
+    {
+        for_range(i, numEndpoints)
+        {
+            const std::uint32_t pBit = (mode.endpointPBits != 0 || i % 2 == 0 ? reader.Read(1) : endpoints[i - 1][0] & 0x1);
+            for_range(c, 4u)
+                endpoints[i][c] = (endpoints[i][c] << 1) | pBit;
         }
+        ++colorBits;
+        if (alphaBits > 0)
+            ++alphaBits;
+    }
+
+    /* Expand endpoints to 8 bits */
+    for_range(i, numEndpoints)
+    {
+        for_range(c, 3u)
+            endpoints[i][c] = ExpandUNormBits(endpoints[i][c], colorBits);
+        endpoints[i][3] = (alphaBits > 0 ? ExpandUNormBits(endpoints[i][3], alphaBits) : 0xFF);
+    }
+
+    /* Read primary and secondary indices */
+    std::uint8_t indices[16];
+    std::uint8_t indices2[16];
+
+    for_range(i, 16u)
+        indices[i] = static_cast<std::uint8_t>(reader.Read(IsBPTCAnchor(mode.numSubsets, partition, i) ? mode.indexBits - 1 : mode.indexBits));
+
+    if (mode.indexBits2 > 0)
+    {
+        for_range(i, 16u)
+            indices2[i] = static_cast<std::uint8_t>(reader.Read(i == 0 ? mode.indexBits2 - 1 : mode.indexBits2));
     }
 
+    /* Select which indices are used for color and alpha */
+    const std::uint8_t* colorIndices    = indices;
+    const std::uint8_t* alphaIndices    = indices;
+    unsigned            colorIndexBits  = mode.indexBits;
+    unsigned            alphaIndexBits  = mode.indexBits;
+
+    if (mode.indexBits2 > 0)
+    {
+        if (indexSelection == 0)
+        {
+            alphaIndices    = indices2;
+            alphaIndexBits  = mode.indexBits2;
+        }
+        else
+        {
+            colorIndices    = indices2;
+            colorIndexBits  = mode.indexBits2;
+        }
+    }
+
+    const std::uint8_t* colorWeights = GetBPTCWeights(colorIndexBits);
+    const std::uint8_t* alphaWeights = GetBPTCWeights(alphaIndexBits);
+
+    /* Interpolate colors */
+    for_range(i, 16u)
+    {
+        const unsigned subset       = GetBPTCSubset(mode.numSubsets, partition, i);
+        const std::uint32_t* e0     = endpoints[subset * 2];
+        const std::uint32_t* e1     = endpoints[subset * 2 + 1];
+        std::uint8_t* pixel         = dst.pixels[i];
+
+        for_range(c, 3u)
+            pixel[c] = static_cast<std::uint8_t>(InterpolateBPTC(e0[c], e1[c], colorWeights[colorIndices[i]]));
+        pixel[3] = static_cast<std::uint8_t>(InterpolateBPTC(e0[3], e1[3], alphaWeights[alphaIndices[i]]));
+
+        /* Swap alpha channel with one of the color channels */
+        if (rotation > 0)
+            std::swap(pixel[3], pixel[rotation - 1]);
+    }
+}
+
+
+/* ----- Block decompression ----- */
+
+// Worker thread procedure for the "DecompressBCBlocksToRGBA8UNorm" function
+static void DecompressBCBlocksToRGBA8UNormWorker(
+    const Extent2D&         extent,
+    const std::uint8_t*     src,
+    std::size_t             blockSize,
+    PFN_DecodeBCBlock       decodeBlock,
+    std::uint8_t*           dst,
+    std::size_t             begin,
+    std::size_t             end)
+{
+    const std::uint32_t numBlocksX = (extent.width + 3) / 4;
+
+    BCBlockRGBA8 block;
+
+    for_subrange(i, begin, end)
+    {
+        decodeBlock(block, src + i * blockSize);
+
+        /* Copy decoded block into output image and clip it against the image boundary */
+        const std::uint32_t x       = static_cast<std::uint32_t>(i % numBlocksX) * 4;
+        const std::uint32_t y       = static_cast<std::uint32_t>(i / numBlocksX) * 4;
+        const std::uint32_t width   = std::min(4u, extent.width  - x);
+        const std::uint32_t height  = std::min(4u, extent.height - y);
+
+        for_range(row, height)
+        {
+            const std::size_t dstOffset = ((static_cast<std::size_t>(y + row) * extent.width) + x) * 4;
+            ::memcpy(dst + dstOffset, block.pixels[row * 4], width * 4);
+        }
+    }
+}
+
+static DynamicByteArray DecompressBCBlocksToRGBA8UNorm(
+    const Extent2D&     extent,
+    const char*         data,
+    std::size_t         dataSize,
+    std::size_t         blockSize,
+    PFN_DecodeBCBlock   decodeBlock,
+    unsigned            threadCount)
+{
+    const std::size_t numBlocksX    = (extent.width  + 3) / 4;
+    const std::size_t numBlocksY    = (extent.height + 3) / 4;
+    const std::size_t numBlocks     = numBlocksX * numBlocksY;
+
+    /* Return null on invalid arguments */
+    if (numBlocks == 0 || data == nullptr || dataSize < numBlocks * blockSize)
+        return nullptr;
+
+    DynamicByteArray dstImage{ static_cast<std::size_t>(extent.width) * extent.height * 4, UninitializeTag{} };
+
+    /* Decode independent blocks concurrently; a minimum of 16 blocks per thread amortizes the thread creation */
+    DoConcurrentRange(
+        [&extent, data, blockSize, decodeBlock, &dstImage](std::size_t begin, std::size_t end)
+        {
+            DecompressBCBlocksToRGBA8UNormWorker(
+                extent,
+                reinterpret_cast<const std::uint8_t*>(data),
+                blockSize,
+                decodeBlock,
+                reinterpret_cast<std::uint8_t*>(dstImage.get()),
+                begin,
+                end
+            );
+        },
+        numBlocks,
+        threadCount,
+        16
+    );
+
     return dstImage;
 }
 
+DynamicByteArray DecompressBCToRGBA8UNorm(
+    Format          compressedFormat,
+    const Extent2D& extent,
+    const char*     data,
+    std::size_t     dataSize,
+    unsigned        threadCount)
+{
+    switch (compressedFormat)
+    {
+        case Format::BC1UNorm:
+        case Format::BC1UNorm_sRGB:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 8, DecodeBC1Block, threadCount);
+
+        case Format::BC2UNorm:
+        case Format::BC2UNorm_sRGB:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 16, DecodeBC2Block, threadCount);
+
+        case Format::BC3UNorm:
+        case Format::BC3UNorm_sRGB:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 16, DecodeBC3Block, threadCount);
+
+        case Format::BC4UNorm:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 8, DecodeBC4Block<false>, threadCount);
+
+        case Format::BC4SNorm:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 8, DecodeBC4Block<true>, threadCount);
+
+        case Format::BC5UNorm:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 16, DecodeBC5Block<false>, threadCount);
+
+        case Format::BC5SNorm:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 16, DecodeBC5Block<true>, threadCount);
+
+        case Format::BC6HUFloat:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 16, DecodeBC6HBlock<false>, threadCount);
+
+        case Format::BC6HSFloat:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 16, DecodeBC6HBlock<true>, threadCount);
+
+        case Format::BC7UNorm:
+        case Format::BC7UNorm_sRGB:
+            return DecompressBCBlocksToRGBA8UNorm(extent, data, dataSize, 16, DecodeBC7Block, threadCount);
+
+        default:
+            return nullptr;
+    }
+}
+
 
 } // /namespace LLGL
 
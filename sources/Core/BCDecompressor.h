@@ -10,6 +10,7 @@
 
 
 #include <LLGL/Types.h>
+#include <LLGL/Format.h>
 #include <LLGL/Container/DynamicArray.h>
 #include <cstddef>
 
@@ -23,10 +24,14 @@ struct Extent2D;
 /* ----- Functions ----- */
 
 /*
-Returns an image buffer in the Format::RGBA8UNorm format for the specified BC1 encoded data, or null on failure
-Width and height of the input image must be a multiple of 4.
+Returns an image buffer in the Format::RGBA8UNorm format for the specified BC1 - BC7 encoded data, or null on failure.
+The 4x4 blocks are decoded independently, distributed over the specified number of threads.
+If width or height of the input image are not a multiple of 4, the blocks at the right and bottom edges are clipped.
+Signed formats (BC4SNorm, BC5SNorm) are remapped from [-1, 1] to [0, 1] and HDR formats (BC6H) are clamped to [0, 1].
+Missing color components are set to the default color (0, 0, 0, 1). Color values of sRGB formats are not converted.
 */
-DynamicByteArray DecompressBC1ToRGBA8UNorm(
+DynamicByteArray DecompressBCToRGBA8UNorm(
+    Format          compressedFormat,
     const Extent2D& extent,
     const char*     data,
     std::size_t     dataSize,
@@ -0,0 +1,119 @@
+/*
+ * CPUFeatures.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "CPUFeatures.h"
+#include <LLGL/Platform/Platform.h>
+#include <cstdint>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   if defined _MSC_VER
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+
+namespace LLGL
+{
+
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+
+static void QueryCPUID(unsigned leaf, unsigned subleaf, unsigned (&regs)[4])
+{
+    #if defined _MSC_VER
+    int cpuInfo[4] = {};
+    __cpuidex(cpuInfo, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<unsigned>(cpuInfo[i]);
+    #else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+// Returns the extended control register XCR0, which specifies what register states the operating system saves on context switches.
+static std::uint64_t QueryXCR0()
+{
+    #if defined _MSC_VER
+    return _xgetbv(0);
+    #else
+    std::uint32_t eax = 0, edx = 0;
+    __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((static_cast<std::uint64_t>(edx) << 32) | eax);
+    #endif
+}
+
+static long QueryCPUFeatures()
+{
+    long features = 0;
+
+    unsigned regs[4] = {};
+    QueryCPUID(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+
+    if (maxLeaf >= 1)
+    {
+        QueryCPUID(1, 0, regs);
+
+        const unsigned ecx = regs[2];
+        const unsigned edx = regs[3];
+
+        if ((edx & (1u << 26)) != 0)
+            features |= CPUFeatureFlags::SSE2;
+        if ((ecx & (1u <<  9)) != 0)
+            features |= CPUFeatureFlags::SSSE3;
+        if ((ecx & (1u << 19)) != 0)
+            features |= CPUFeatureFlags::SSE4_1;
+
+        /* AVX based extensions also require the OS to save the YMM registers (XCR0 bits 1 and 2) */
+        const bool hasOSXSAVE   = ((ecx & (1u << 27)) != 0);
+        const bool hasAVX       = ((ecx & (1u << 28)) != 0);
+        const bool hasAVXState  = (hasOSXSAVE && hasAVX && (QueryXCR0() & 0x6) == 0x6);
+
+        if (hasAVXState)
+        {
+            if ((ecx & (1u << 29)) != 0)
+                features |= CPUFeatureFlags::F16C;
+
+            if (maxLeaf >= 7)
+            {
+                QueryCPUID(7, 0, regs);
+                if ((regs[1] & (1u << 5)) != 0)
+                    features |= CPUFeatureFlags::AVX2;
+            }
+        }
+    }
+
+    return features;
+}
+
+#else
+
+static long QueryCPUFeatures()
+{
+    #if defined LLGL_ARCH_ARM64 || (defined LLGL_ARCH_ARM && defined __ARM_NEON)
+    return CPUFeatureFlags::NEON; // NEON is mandatory on ARM64
+    #else
+    return 0;
+    #endif
+}
+
+#endif // /LLGL_ARCH_AMD64 || LLGL_ARCH_IA32
+
+LLGL_EXPORT long GetCPUFeatures()
+{
+    static const long features = QueryCPUFeatures();
+    return features;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,47 @@
+/*
+ * CPUFeatures.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_CPU_FEATURES_H
+#define LLGL_CPU_FEATURES_H
+
+
+#include <LLGL/Export.h>
+
+
+namespace LLGL
+{
+
+
+// SIMD instruction set extensions that can be queried at runtime.
+struct CPUFeatureFlags
+{
+    enum
+    {
+        SSE2    = (1 << 0),
+        SSSE3   = (1 << 1),
+        SSE4_1  = (1 << 2),
+        AVX2    = (1 << 3),
+        F16C    = (1 << 4),
+        NEON    = (1 << 5),
+    };
+};
+
+/*
+Returns the bitwise OR combination of CPUFeatureFlags entries that are supported by the host CPU and operating system.
+The features are only queried once and then cached.
+*/
+LLGL_EXPORT long GetCPUFeatures();
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
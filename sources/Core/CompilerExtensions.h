@@ -38,6 +38,13 @@
 #   define LLGL_NODISCARD
 #endif
 
+// Enables an instruction set extension for a single function, e.g. LLGL_TARGET_ATTRIBUTE("avx2"). MSVC doesn't need this to use intrinsics.
+#if defined __GNUC__ || defined __clang__ // GNU/Clang extensions
+#   define LLGL_TARGET_ATTRIBUTE(TARGET) __attribute__((target(TARGET)))
+#else
+#   define LLGL_TARGET_ATTRIBUTE(TARGET)
+#endif
+
 #if defined _MSC_VER
 #   define LLGL_BEGIN_NO_OPTIMIZE   __pragma(optimize("", off)) __declspec(noinline)
 #   define LLGL_END_NO_OPTIMIZE     __pragma(optimize("", on))
@@ -6,6 +6,18 @@
  */
 
 #include "Float16Compressor.h"
+#include "CPUFeatures.h"
+#include "CompilerExtensions.h"
+#include <LLGL/Platform/Platform.h>
+#include <string.h>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_FLOAT16_COMPRESSOR_F16C
+#   include <immintrin.h>
+#elif defined LLGL_ARCH_ARM64
+#   define LLGL_FLOAT16_COMPRESSOR_NEON
+#   include <arm_neon.h>
+#endif
 
 
 namespace LLGL
@@ -92,6 +104,278 @@ class Float16Compressor
 };
 
 
+/*
+Lookup tables for half-float conversion without the multiplications and masking of Float16Compressor.
+see "Fast Half Float Conversions" by Jeroen van der Zijp (2008), ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf
+Compression is adjusted to truncate and to handle overflow and NaN the same way as Float16Compressor.
+*/
+class Float16ConversionTables
+{
+
+    public:
+
+        Float16ConversionTables()
+        {
+            /* Initialize tables for decompression */
+            mantissaTable_[0] = 0;
+            for (std::uint32_t i = 1; i < 1024; ++i)
+                mantissaTable_[i] = ConvertSubnormalMantissa(i);
+            for (std::uint32_t i = 1024; i < 2048; ++i)
+                mantissaTable_[i] = 0x38000000 + ((i - 1024) << 13);
+
+            for (std::uint32_t i = 0; i < 64; ++i)
+            {
+                const std::uint32_t sign        = ((i & 0x20) << 26);
+                const std::uint32_t exponent    = (i & 0x1F);
+                if (exponent == 0)
+                    exponentTable_[i] = sign;
+                else if (exponent == 31)
+                    exponentTable_[i] = sign | 0x47800000;
+                else
+                    exponentTable_[i] = sign | (exponent << 23);
+                offsetTable_[i] = (exponent == 0 ? 0 : 1024);
+            }
+
+            /* Initialize tables for compression */
+            for (std::int32_t i = 0; i < 256; ++i)
+            {
+                const std::int32_t e = i - 127;
+                std::uint16_t base;
+                std::uint8_t shift;
+                if (e < -24)
+                {
+                    /* Underflow to zero */
+                    base    = 0x0000;
+                    shift   = 24;
+                }
+                else if (e < -14)
+                {
+                    /* Subnormal half-floats */
+                    base    = static_cast<std::uint16_t>(0x0400 >> (-e - 14));
+                    shift   = static_cast<std::uint8_t>(-e - 1);
+                }
+                else if (e <= 15)
+                {
+                    /* Normal half-floats */
+                    base    = static_cast<std::uint16_t>((e + 15) << 10);
+                    shift   = 13;
+                }
+                else if (e < 128)
+                {
+                    /* Overflow to infinity */
+                    base    = 0x7C00;
+                    shift   = 24;
+                }
+                else
+                {
+                    /* Infinity and NaN */
+                    base    = 0x7C00;
+                    shift   = 13;
+                }
+                baseTable_[i        ] = base;
+                baseTable_[i | 0x100] = (base | 0x8000);
+                shiftTable_[i        ] = shift;
+                shiftTable_[i | 0x100] = shift;
+            }
+        }
+
+        std::uint16_t Compress(float value) const
+        {
+            std::uint32_t bits;
+            ::memcpy(&bits, &value, sizeof(bits));
+
+            /* Map values beyond the largest half-float to infinity and NaNs with a truncated payload to the smallest NaN */
+            const std::uint32_t absBits = (bits & 0x7FFFFFFF);
+            if (absBits > 0x477FE000 && absBits < 0x7F800000)
+                bits = (bits & 0x80000000) | 0x7F800000;
+            else if (absBits > 0x7F800000 && absBits < 0x7F802000)
+                bits = (bits & 0x80000000) | 0x7F802000;
+
+            const std::uint32_t index = (bits >> 23);
+            return static_cast<std::uint16_t>(baseTable_[index] + ((bits & 0x007FFFFF) >> shiftTable_[index]));
+        }
+
+        float Decompress(std::uint16_t value) const
+        {
+            const std::uint32_t index = (value >> 10);
+            const std::uint32_t bits = mantissaTable_[offsetTable_[index] + (value & 0x03FF)] + exponentTable_[index];
+            float result;
+            ::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+    public:
+
+        static const Float16ConversionTables& Get()
+        {
+            static const Float16ConversionTables tables;
+            return tables;
+        }
+
+    private:
+
+        // Returns the normalized 32-bit float bit pattern of the specified subnormal half-float mantissa.
+        static std::uint32_t ConvertSubnormalMantissa(std::uint32_t i)
+        {
+            std::uint32_t m = (i << 13);
+            std::uint32_t e = 0;
+            while ((m & 0x00800000) == 0)
+            {
+                e -= 0x00800000;
+                m <<= 1;
+            }
+            m &= ~0x00800000u;
+            e += 0x38800000;
+            return (m | e);
+        }
+
+    private:
+
+        std::uint32_t mantissaTable_[2048];
+        std::uint32_t exponentTable_[64];
+        std::uint16_t offsetTable_[64];
+        std::uint16_t baseTable_[512];
+        std::uint8_t  shiftTable_[512];
+
+};
+
+static void CompressFloat16ArrayTable(std::uint16_t* dst, const float* src, std::size_t count)
+{
+    const Float16ConversionTables& tables = Float16ConversionTables::Get();
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = tables.Compress(src[i]);
+}
+
+static void DecompressFloat16ArrayTable(float* dst, const std::uint16_t* src, std::size_t count)
+{
+    const Float16ConversionTables& tables = Float16ConversionTables::Get();
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = tables.Decompress(src[i]);
+}
+
+#if defined LLGL_FLOAT16_COMPRESSOR_F16C
+
+/*
+F16C converts NaNs into quiet NaNs whereas Float16Compressor keeps their payload,
+so vectors that contain NaNs fall back to the scalar conversion.
+F16C also clamps finite values to the largest half-float when rounding towards zero, but Float16Compressor returns infinity,
+so finite values beyond that range are replaced by infinity with the same sign beforehand.
+*/
+LLGL_TARGET_ATTRIBUTE("f16c")
+static void CompressFloat16ArrayF16C(std::uint16_t* dst, const float* src, std::size_t count)
+{
+    const __m128i absMask       = _mm_set1_epi32(0x7FFFFFFF);
+    const __m128i signMask      = _mm_set1_epi32(static_cast<int>(0x80000000));
+    const __m128i infinity      = _mm_set1_epi32(0x7F800000);
+    const __m128i maxFloat16    = _mm_set1_epi32(0x477FE000);
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i bits      = _mm_castps_si128(_mm_loadu_ps(src + i));
+        const __m128i absBits   = _mm_and_si128(bits, absMask);
+
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(absBits, infinity)) != 0)
+        {
+            for (std::size_t j = i; j < i + 4; ++j)
+                dst[j] = Float16Compressor::Compress(src[j]);
+            continue;
+        }
+
+        const __m128i overflow  = _mm_cmpgt_epi32(absBits, maxFloat16);
+        const __m128i signedInf = _mm_or_si128(_mm_and_si128(bits, signMask), infinity);
+        const __m128i clamped   = _mm_or_si128(_mm_and_si128(overflow, signedInf), _mm_andnot_si128(overflow, bits));
+
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_cvtps_ph(_mm_castsi128_ps(clamped), _MM_FROUND_TO_ZERO));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Compress(src[i]);
+}
+
+// F16C converts signaling NaNs into quiet NaNs, so vectors that contain NaNs fall back to the scalar conversion.
+LLGL_TARGET_ATTRIBUTE("f16c")
+static void DecompressFloat16ArrayF16C(float* dst, const std::uint16_t* src, std::size_t count)
+{
+    const __m128i absMask   = _mm_set1_epi16(0x7FFF);
+    const __m128i infinity  = _mm_set1_epi16(0x7C00);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i halfs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        if (_mm_movemask_epi8(_mm_cmpgt_epi16(_mm_and_si128(halfs, absMask), infinity)) != 0)
+        {
+            for (std::size_t j = i; j < i + 8; ++j)
+                dst[j] = Float16Compressor::Decompress(src[j]);
+            continue;
+        }
+
+        _mm_storeu_ps(dst + i    , _mm_cvtph_ps(halfs));
+        _mm_storeu_ps(dst + i + 4, _mm_cvtph_ps(_mm_unpackhi_epi64(halfs, halfs)));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Decompress(src[i]);
+}
+
+#endif // /LLGL_FLOAT16_COMPRESSOR_F16C
+
+#if defined LLGL_FLOAT16_COMPRESSOR_NEON
+
+/*
+Native half-float decompression is exact, but converts signaling NaNs into quiet NaNs,
+so vectors that contain NaNs fall back to the scalar conversion.
+Compression is not vectorized since the native conversion rounds to nearest instead of truncating.
+*/
+static void DecompressFloat16ArrayNEON(float* dst, const std::uint16_t* src, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const uint16x4_t halfs = vld1_u16(src + i);
+
+        if (vmaxv_u16(vand_u16(halfs, vdup_n_u16(0x7FFF))) > 0x7C00)
+        {
+            for (std::size_t j = i; j < i + 4; ++j)
+                dst[j] = Float16Compressor::Decompress(src[j]);
+            continue;
+        }
+
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(halfs)));
+    }
+
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Decompress(src[i]);
+}
+
+#endif // /LLGL_FLOAT16_COMPRESSOR_NEON
+
+typedef void (*PFN_CompressFloat16Array)(std::uint16_t* dst, const float* src, std::size_t count);
+typedef void (*PFN_DecompressFloat16Array)(float* dst, const std::uint16_t* src, std::size_t count);
+
+static PFN_CompressFloat16Array SelectCompressFloat16Array()
+{
+    #if defined LLGL_FLOAT16_COMPRESSOR_F16C
+    if ((GetCPUFeatures() & CPUFeatureFlags::F16C) != 0)
+        return CompressFloat16ArrayF16C;
+    #endif
+    return CompressFloat16ArrayTable;
+}
+
+static PFN_DecompressFloat16Array SelectDecompressFloat16Array()
+{
+    #if defined LLGL_FLOAT16_COMPRESSOR_F16C
+    if ((GetCPUFeatures() & CPUFeatureFlags::F16C) != 0)
+        return DecompressFloat16ArrayF16C;
+    #elif defined LLGL_FLOAT16_COMPRESSOR_NEON
+    if ((GetCPUFeatures() & CPUFeatureFlags::NEON) != 0)
+        return DecompressFloat16ArrayNEON;
+    #endif
+    return DecompressFloat16ArrayTable;
+}
+
 LLGL_EXPORT std::uint16_t CompressFloat16(float value)
 {
     return Float16Compressor::Compress(value);
@@ -102,6 +386,18 @@ LLGL_EXPORT float DecompressFloat16(std::uint16_t value)
     return Float16Compressor::Decompress(value);
 }
 
+LLGL_EXPORT void CompressFloat16Array(std::uint16_t* dst, const float* src, std::size_t count)
+{
+    static const PFN_CompressFloat16Array compressFloat16Array = SelectCompressFloat16Array();
+    compressFloat16Array(dst, src, count);
+}
+
+LLGL_EXPORT void DecompressFloat16Array(float* dst, const std::uint16_t* src, std::size_t count)
+{
+    static const PFN_DecompressFloat16Array decompressFloat16Array = SelectDecompressFloat16Array();
+    decompressFloat16Array(dst, src, count);
+}
+
 
 } // /namespace LLGL
 
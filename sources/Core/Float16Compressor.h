@@ -11,6 +11,7 @@
 
 #include <LLGL/Export.h>
 #include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -23,6 +24,18 @@ LLGL_EXPORT std::uint16_t CompressFloat16(float value);
 // Decompresses the specified 16-bit float (represented as 16-bit unsigned integer) into a 32-bit float.
 LLGL_EXPORT float DecompressFloat16(std::uint16_t value);
 
+/*
+Compresses the specified array of 32-bit floats into 16-bit floats. Source and destination must not overlap.
+Results are bitwise identical to CompressFloat16() but use F16C instructions or lookup tables when available.
+*/
+LLGL_EXPORT void CompressFloat16Array(std::uint16_t* dst, const float* src, std::size_t count);
+
+/*
+Decompresses the specified array of 16-bit floats into 32-bit floats. Source and destination must not overlap.
+Results are bitwise identical to DecompressFloat16() but use F16C/NEON instructions or lookup tables when available.
+*/
+LLGL_EXPORT void DecompressFloat16Array(float* dst, const std::uint16_t* src, std::size_t count);
+
 
 } // /namespace LLGL
 
@@ -8,8 +8,14 @@
 #include <LLGL/Utils/Image.h>
 #include "ImageUtils.h"
 #include "Exception.h"
+#include "ImageResampler.h"
 #include "PrintfUtils.h"
+#include <LLGL/TextureFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <LLGL/Container/SmallVector.h>
 #include <algorithm>
+#include <memory>
+#include <vector>
 #include <string.h>
 
 
@@ -17,6 +23,202 @@ namespace LLGL
 {
 
 
+/* ----- Internal functions ----- */
+
+// Returns true if images of the specified format can be resampled, i.e. converted to and from RGBA32Float.
+static bool IsResamplableImageFormat(ImageFormat format)
+{
+    return (format != ImageFormat::Compressed && format != ImageFormat::DepthStencil && format != ImageFormat::Stencil);
+}
+
+// Returns the bias that is added to normalized values before they are truncated to unsigned integers, so they are rounded to the nearest integer.
+static float GetUNormRoundingBias(DataType dataType)
+{
+    switch (dataType)
+    {
+        case DataType::UInt8:   return 0.5f / 255.0f;
+        case DataType::UInt16:  return 0.5f / 65535.0f;
+        default:                return 0.0f;
+    }
+}
+
+// Converts the specified image into RGBA32Float pixels in linear color space.
+static void ConvertToLinearRGBA32Float(const ImageView& srcImageView, const Extent3D& extent, bool sRGB, unsigned threadCount, float* pixels)
+{
+    const std::size_t numPixels = static_cast<std::size_t>(extent.width) * extent.height * extent.depth;
+
+    ConvertImageBuffer(
+        srcImageView,
+        MutableImageView{ ImageFormat::RGBA, DataType::Float32, pixels, numPixels * 4 * sizeof(float) },
+        extent,
+        threadCount,
+        true
+    );
+
+    if (sRGB)
+        ConvertRGBA32FloatSRGBToLinear(pixels, numPixels, threadCount);
+}
+
+// Converts the specified RGBA32Float pixels in linear color space into the destination image. The input pixels are modified in place.
+static void ConvertFromLinearRGBA32Float(std::vector<float>& pixels, const MutableImageView& dstImageView, const Extent3D& extent, bool sRGB, unsigned threadCount)
+{
+    if (sRGB)
+        ConvertRGBA32FloatLinearToSRGB(pixels.data(), pixels.size() / 4, threadCount);
+
+    if (!IsFloatDataType(dstImageView.dataType))
+    {
+        /* Clamp ringing of sharpening filters and round to nearest integer */
+        const float roundingBias = GetUNormRoundingBias(dstImageView.dataType);
+        for (float& value : pixels)
+            value = std::max(0.0f, std::min(value, 1.0f)) + roundingBias;
+    }
+
+    ConvertImageBuffer(
+        ImageView{ ImageFormat::RGBA, DataType::Float32, pixels.data(), pixels.size() * sizeof(float) },
+        dstImageView,
+        extent,
+        threadCount,
+        true
+    );
+}
+
+
+// Returns the extent of the MIP-map below the specified extent.
+static Extent3D GetNextMipExtent(const Extent3D& extent, bool downsampleDepth)
+{
+    return Extent3D
+    {
+        std::max(1u, extent.width  / 2),
+        std::max(1u, extent.height / 2),
+        (downsampleDepth ? std::max(1u, extent.depth / 2) : extent.depth)
+    };
+}
+
+// Allocates the uninitialized images of the MIP-map chain below the specified image. Returns an empty array if there is nothing to generate.
+static DynamicVector<Image> AllocMipChain(const Image& image, const MipChainDescriptor& desc)
+{
+    DynamicVector<Image> mipChain;
+
+    if (image.GetData() == nullptr || !IsResamplableImageFormat(image.GetFormat()))
+        return mipChain;
+
+    /* Determine number of MIP-maps below this image */
+    const Extent3D&     extent          = image.GetExtent();
+    const std::uint32_t maxNumMipLevels = NumMipLevels(extent.width, extent.height, (desc.downsampleDepth ? extent.depth : 1u)) - 1;
+    const std::uint32_t numMipLevels    = (desc.numMipLevels > 0 ? std::min(desc.numMipLevels, maxNumMipLevels) : maxNumMipLevels);
+
+    mipChain.reserve(numMipLevels);
+
+    Extent3D mipExtent = extent;
+    for_range(mipLevel, numMipLevels)
+    {
+        mipExtent = GetNextMipExtent(mipExtent, desc.downsampleDepth);
+        mipChain.push_back(Image{ mipExtent, image.GetFormat(), image.GetDataType() });
+    }
+
+    return mipChain;
+}
+
+/*
+Generates the MIP-maps for a range of layers of an image, or for the entire volume if depth is downsampled, one MIP-map after another.
+Each MIP-map is written into the respective layers of a preallocated image, so generators for disjoint layers can run concurrently.
+*/
+class MipChainGenerator
+{
+
+    public:
+
+        MipChainGenerator(const Image& image, const MipChainDescriptor& desc, std::uint32_t firstLayer, std::uint32_t numLayers) :
+            image_         { image                                       },
+            desc_          { desc                                        },
+            firstLayer_    { (desc.downsampleDepth ? 0u : firstLayer)    },
+            numLayers_     { (desc.downsampleDepth ? 1u : numLayers)     },
+            prevMipExtent_ { image.GetExtent()                           }
+        {
+            if (!desc.downsampleDepth)
+                prevMipExtent_.depth = numLayers;
+        }
+
+        // Converts the base layers into RGBA32Float pixels in linear color space and determines their alpha coverage.
+        void ConvertBaseLevel(unsigned threadCount)
+        {
+            const std::size_t numPixels = GetNumPixels(prevMipExtent_);
+            prevMipPixels_.resize(numPixels * 4);
+
+            const std::size_t depthStride = image_.GetDepthStride();
+            const ImageView srcImageView
+            {
+                image_.GetFormat(),
+                image_.GetDataType(),
+                static_cast<const char*>(image_.GetData()) + depthStride * firstLayer_,
+                depthStride * prevMipExtent_.depth
+            };
+            ConvertToLinearRGBA32Float(srcImageView, prevMipExtent_, desc_.sRGB, threadCount, prevMipPixels_.data());
+
+            if (desc_.alphaCoverageRef > 0.0f)
+            {
+                const std::size_t numLayerPixels = numPixels / numLayers_;
+                for_range(layer, numLayers_)
+                    alphaCoverages_.push_back(ComputeAlphaCoverage(&prevMipPixels_[layer * numLayerPixels * 4], numLayerPixels, desc_.alphaCoverageRef));
+            }
+        }
+
+        // Generates the next MIP-map from its predecessor and writes it into the respective layers of the specified image.
+        void GenerateNextMipMap(Image& mipMap, unsigned threadCount)
+        {
+            const Extent3D mipExtent = GetNextMipExtent(prevMipExtent_, desc_.downsampleDepth);
+
+            const std::size_t numMipPixels = GetNumPixels(mipExtent);
+            mipPixels_.resize(numMipPixels * 4);
+
+            ResampleRGBA32Float(desc_.filter, prevMipPixels_.data(), prevMipExtent_, mipPixels_.data(), mipExtent, threadCount);
+
+            /* Adjust alpha coverage and color space of output pixels only, so the next MIP-map is generated from unmodified pixels */
+            outputPixels_ = mipPixels_;
+
+            if (!alphaCoverages_.empty())
+            {
+                const std::size_t numLayerPixels = numMipPixels / numLayers_;
+                for_range(layer, numLayers_)
+                    ScaleAlphaToCoverage(&outputPixels_[layer * numLayerPixels * 4], numLayerPixels, desc_.alphaCoverageRef, alphaCoverages_[layer]);
+            }
+
+            const std::size_t depthStride = mipMap.GetDepthStride();
+            const MutableImageView dstImageView
+            {
+                mipMap.GetFormat(),
+                mipMap.GetDataType(),
+                static_cast<char*>(mipMap.GetData()) + depthStride * firstLayer_,
+                depthStride * mipExtent.depth
+            };
+            ConvertFromLinearRGBA32Float(outputPixels_, dstImageView, mipExtent, desc_.sRGB, threadCount);
+
+            std::swap(prevMipPixels_, mipPixels_);
+            prevMipExtent_ = mipExtent;
+        }
+
+    private:
+
+        static std::size_t GetNumPixels(const Extent3D& extent)
+        {
+            return static_cast<std::size_t>(extent.width) * extent.height * extent.depth;
+        }
+
+    private:
+
+        const Image&        image_;
+        MipChainDescriptor  desc_;
+        std::uint32_t       firstLayer_     = 0;
+        std::uint32_t       numLayers_      = 1;
+        Extent3D            prevMipExtent_;
+        std::vector<float>  prevMipPixels_;
+        std::vector<float>  mipPixels_;
+        std::vector<float>  outputPixels_;
+        std::vector<float>  alphaCoverages_;
+
+};
+
+
 /* ----- Common ----- */
 
 Image::Image(const Extent3D& extent, const ImageFormat format, const DataType dataType) :
@@ -150,6 +352,55 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAf& fillColor, const Of
     }
 }
 
+void Image::Resize(const Extent3D& extent, const ImageFilter filter, bool sRGB, unsigned threadCount)
+{
+    if (extent == GetExtent() || !IsResamplableImageFormat(GetFormat()))
+        return;
+
+    if (!data_ || extent.width == 0 || extent.height == 0 || extent.depth == 0)
+    {
+        /* Nothing to scale, so only resize the image buffer */
+        Resize(extent);
+        return;
+    }
+
+    /* Convert source rows on demand while they are scaled horizontally, so the source image is never converted as a whole */
+    const Extent3D&     srcExtent       = GetExtent();
+    const std::size_t   srcRowStride    = GetRowStride();
+    const std::uint32_t numSrcRows      = srcExtent.height * srcExtent.depth;
+
+    std::vector<float> scaledRowPixels(static_cast<std::size_t>(numSrcRows) * extent.width * 4);
+
+    ResampleRowsRGBA32Float(
+        filter,
+        srcExtent.width,
+        extent.width,
+        numSrcRows,
+        [&](std::uint32_t firstRow, std::uint32_t numRows, float* dst)
+        {
+            const ImageView srcRowsView{ GetFormat(), GetDataType(), data_.get() + firstRow * srcRowStride, numRows * srcRowStride };
+            ConvertToLinearRGBA32Float(srcRowsView, Extent3D{ srcExtent.width, numRows, 1 }, sRGB, 0, dst);
+        },
+        scaledRowPixels.data(),
+        threadCount
+    );
+
+    /* Scale columns and depth slices of the horizontally scaled rows */
+    std::vector<float> dstPixels;
+    if (extent.height != srcExtent.height || extent.depth != srcExtent.depth)
+    {
+        dstPixels.resize(static_cast<std::size_t>(extent.width) * extent.height * extent.depth * 4);
+        ResampleRGBA32Float(filter, scaledRowPixels.data(), Extent3D{ extent.width, srcExtent.height, srcExtent.depth }, dstPixels.data(), extent, threadCount);
+    }
+    else
+        dstPixels = std::move(scaledRowPixels);
+
+    /* Convert scaled pixels back into the image format */
+    extent_ = extent;
+    data_   = DynamicByteArray{ GetDataSize(), UninitializeTag{} };
+    ConvertFromLinearRGBA32Float(dstPixels, GetMutableView(), extent, sRGB, threadCount);
+}
+
 void Image::Swap(Image& rhs)
 {
     std::swap(extent_,   rhs.extent_  );
@@ -178,6 +429,74 @@ DynamicByteArray Image::Release()
     return std::move(data_);
 }
 
+/* ----- MIP-maps ----- */
+
+DynamicVector<Image> Image::GenerateMipChain(const MipChainDescriptor& desc, unsigned threadCount) const
+{
+    DynamicVector<Image> mipChain = AllocMipChain(*this, desc);
+
+    if (!mipChain.empty())
+    {
+        /* Generate each MIP-map of all layers from its predecessor */
+        MipChainGenerator generator{ *this, desc, 0, GetExtent().depth };
+        generator.ConvertBaseLevel(threadCount);
+        for (Image& mipMap : mipChain)
+            generator.GenerateNextMipMap(mipMap, threadCount);
+    }
+
+    return mipChain;
+}
+
+TaskHandle Image::GenerateMipChainAsync(
+    DynamicVector<Image>&           outMipChain,
+    const MipChainDescriptor&       desc,
+    unsigned                        threadCount,
+    const ArrayView<TaskHandle>&    dependencies) const
+{
+    outMipChain = AllocMipChain(*this, desc);
+
+    if (outMipChain.empty())
+        return TaskHandle{};
+
+    /* Schedule a chain of tasks for each layer, or a single chain for the entire volume, with one task per MIP-map */
+    const std::uint32_t numLayers = (desc.downsampleDepth ? 1u : GetExtent().depth);
+
+    std::vector<TaskHandle> layerTasks;
+    layerTasks.reserve(numLayers);
+
+    for_range(layer, numLayers)
+    {
+        auto generator = std::make_shared<MipChainGenerator>(*this, desc, layer, 1u);
+
+        TaskHandle task = TaskScheduler::Schedule(
+            [generator, threadCount]() -> void
+            {
+                generator->ConvertBaseLevel(threadCount);
+            },
+            dependencies
+        );
+
+        for (Image& mipMap : outMipChain)
+        {
+            Image* mipMapPtr = &mipMap;
+            task = task.Then(
+                [generator, mipMapPtr, threadCount]() -> void
+                {
+                    generator->GenerateNextMipMap(*mipMapPtr, threadCount);
+                }
+            );
+        }
+
+        layerTasks.push_back(std::move(task));
+    }
+
+    /* Join all layer chains into a single task */
+    if (layerTasks.size() == 1)
+        return layerTasks.front();
+
+    return TaskScheduler::Schedule([]() {}, layerTasks);
+}
+
 /* ----- Pixels ----- */
 
 static bool ShiftNegative1DRegion(std::int32_t& dstOffset, std::uint32_t dstExtent, std::int32_t& srcOffset, std::uint32_t& srcExtent)
@@ -217,67 +536,92 @@ static bool ShiftNegative1DRegion(std::int32_t& dstOffset, std::uint32_t dstExte
     return true;
 }
 
-static bool Overlap1DRegion(std::int32_t dstOffset, std::int32_t srcOffset, std::uint32_t extent)
+void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent)
 {
-    const std::uint32_t dstOffsetMin = static_cast<std::uint32_t>(dstOffset);
-    const std::uint32_t dstOffsetMax = dstOffsetMin + extent;
-
-    const std::uint32_t srcOffsetMin = static_cast<std::uint32_t>(srcOffset);
-    const std::uint32_t srcOffsetMax = srcOffsetMin + extent;
-
-    return (dstOffsetMin <= srcOffsetMax && dstOffsetMax >= srcOffsetMin);
+    if (ClampBlitRegion(dstRegionOffset, srcImage, srcRegionOffset, srcRegionExtent))
+    {
+        /* Copy image buffer region; overlapping regions within the same image are handled by the copy itself */
+        const Extent3D srcExtent = srcImage.GetExtent();
+        const Extent3D dstExtent = GetExtent();
+
+        CopyImageBufferRegion(
+            GetMutableView(),
+            dstRegionOffset,
+            dstExtent.width,
+            dstExtent.width * dstExtent.height,
+            srcImage.GetView(),
+            srcRegionOffset,
+            srcExtent.width,
+            srcExtent.width * srcExtent.height,
+            srcRegionExtent
+        );
+    }
 }
 
-static bool Overlap3DRegion(const Offset3D& dstOffset, const Offset3D& srcOffset, const Extent3D& extent)
+// Returns the byte offset of the specified pixel within an image of the specified extent.
+static std::size_t GetImageBufferOffset(const Offset3D& offset, const Extent3D& extent, std::uint32_t bpp)
 {
-    return
-    (
-        Overlap1DRegion(dstOffset.x, srcOffset.x, extent.width ) &&
-        Overlap1DRegion(dstOffset.y, srcOffset.y, extent.height) &&
-        Overlap1DRegion(dstOffset.z, srcOffset.z, extent.depth )
-    );
+    const std::size_t x = static_cast<std::size_t>(offset.x);
+    const std::size_t y = static_cast<std::size_t>(offset.y);
+    const std::size_t z = static_cast<std::size_t>(offset.z);
+    return (bpp * (x + (y + z * extent.height) * extent.width));
 }
 
-void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent)
+void Image::Blit(const ArrayView<ImageBlitRegion>& regions, unsigned threadCount)
 {
-    if (GetFormat() == srcImage.GetFormat() && GetDataType() == srcImage.GetDataType())
+    /* Source images must have the same format and data type, so all images share the same pixel size */
+    const std::uint32_t bpp         = GetBytesPerPixel();
+    const Extent3D&     dstExtent   = GetExtent();
+    char*               dstData     = static_cast<char*>(GetData());
+
+    SmallVector<BitBlitRegion, 16> bitBlitRegions;
+    bitBlitRegions.reserve(regions.size());
+
+    for (const ImageBlitRegion& region : regions)
     {
-        /* First clamp source region to source image dimension */
-        srcImage.ClampRegion(srcRegionOffset, srcRegionExtent);
+        if (region.srcImage == nullptr)
+            continue;
 
-        /* Then shift negative destination region */
-        if ( ShiftNegative1DRegion(dstRegionOffset.x, GetExtent().width,  srcRegionOffset.x, srcRegionExtent.width ) &&
-             ShiftNegative1DRegion(dstRegionOffset.y, GetExtent().height, srcRegionOffset.y, srcRegionExtent.height) &&
-             ShiftNegative1DRegion(dstRegionOffset.z, GetExtent().depth,  srcRegionOffset.z, srcRegionExtent.depth ) )
-        {
-            /* Check if a temporary copy of the source image must be allocated */
-            Image srcImageTemp;
-            const Image* srcImageRef = &srcImage;
+        const Image&    srcImage        = *region.srcImage;
+        Offset3D        dstRegionOffset = region.dstRegionOffset;
+        Offset3D        srcRegionOffset = region.srcRegionOffset;
+        Extent3D        srcRegionExtent = region.srcRegionExtent;
 
-            if (srcImageRef == this && Overlap3DRegion(dstRegionOffset, srcRegionOffset, srcRegionExtent))
-            {
-                /* Copy source image */
-                srcImageTemp = *this;
-                srcImageRef = &srcImageTemp;
-            }
+        if (!ClampBlitRegion(dstRegionOffset, srcImage, srcRegionOffset, srcRegionExtent))
+            continue;
+
+        const Extent3D& srcExtent = srcImage.GetExtent();
+
+        BitBlitRegion bitBlitRegion;
+        {
+            bitBlitRegion.dst               = dstData + GetImageBufferOffset(dstRegionOffset, dstExtent, bpp);
+            bitBlitRegion.dstRowStride      = dstExtent.width * bpp;
+            bitBlitRegion.dstLayerStride    = dstExtent.width * dstExtent.height * bpp;
+            bitBlitRegion.src               = static_cast<const char*>(srcImage.GetData()) + GetImageBufferOffset(srcRegionOffset, srcExtent, bpp);
+            bitBlitRegion.srcRowStride      = srcExtent.width * bpp;
+            bitBlitRegion.srcLayerStride    = srcExtent.width * srcExtent.height * bpp;
+            bitBlitRegion.extent            = srcRegionExtent;
+        }
 
-            /* Copy image buffer region */
-            const Extent3D srcExtent = srcImageRef->GetExtent();
-            const Extent3D dstExtent = GetExtent();
-
-            CopyImageBufferRegion(
-                GetMutableView(),
-                dstRegionOffset,
-                dstExtent.width,
-                dstExtent.width * dstExtent.height,
-                srcImageRef->GetView(),
-                srcRegionOffset,
-                srcExtent.width,
-                srcExtent.width * srcExtent.height,
-                srcRegionExtent
+        if (&srcImage == this)
+        {
+            /* Copy regions within this image immediately as their source and destination might overlap */
+            BitBlit(
+                bitBlitRegion.extent,
+                bpp,
+                bitBlitRegion.dst,
+                bitBlitRegion.dstRowStride,
+                bitBlitRegion.dstLayerStride,
+                bitBlitRegion.src,
+                bitBlitRegion.srcRowStride,
+                bitBlitRegion.srcLayerStride
             );
         }
+        else
+            bitBlitRegions.push_back(bitBlitRegion);
     }
+
+    BitBlitRegions(bitBlitRegions.data(), bitBlitRegions.size(), bpp, threadCount);
 }
 
 static std::size_t GetRequiredImageDataSize(const Extent3D& extent, const ImageFormat format, const DataType dataType)
@@ -369,13 +713,14 @@ void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const Im
         const std::uint32_t dstDepthStride  = dstRowStride * GetExtent().height;
         char*               dst             = data_.get() + GetDataPtrOffset(offset);
 
+        /* Get source image parameters; explicit strides of the image view take precedence over tightly packed rows */
+        const std::uint32_t srcBpp          = static_cast<std::uint32_t>(GetMemoryFootprint(imageView.format, imageView.dataType, 1));
+        const std::uint32_t srcRowStride    = (imageView.rowStride != 0 ? imageView.rowStride : srcBpp * extent.width);
+        const std::uint32_t srcDepthStride  = (imageView.layerStride != 0 ? imageView.layerStride : srcRowStride * extent.height);
+        const char*         src             = static_cast<const char*>(imageView.data);
+
         if (GetFormat() == imageView.format && GetDataType() == imageView.dataType)
         {
-            /* Get source image parameters */
-            const std::uint32_t srcRowStride    = bpp * extent.width;
-            const std::uint32_t srcDepthStride  = srcRowStride * extent.height;
-            const char*         src             = static_cast<const char*>(imageView.data);
-
             /* Blit source image into region */
             BitBlit(
                 extent, bpp,
@@ -385,9 +730,13 @@ void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const Im
         }
         else
         {
-            /* Copy input data into sub-image into */
+            /* Copy input data into sub-image */
             Image subImage{ extent, imageView.format, imageView.dataType };
-            ::memcpy(subImage.GetData(), imageView.data, imageView.dataSize);
+            BitBlit(
+                extent, srcBpp,
+                static_cast<char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride(),
+                src, srcRowStride, srcDepthStride
+            );
 
             /* Convert sub-image */
             subImage.Convert(GetFormat(), GetDataType(), threadCount);
@@ -502,6 +851,35 @@ void Image::ClampRegion(Offset3D& offset, Extent3D& extent) const
     extent.depth    = std::min(extent.depth, GetExtent().depth);
 }
 
+bool Image::ClampBlitRegion(Offset3D& dstRegionOffset, const Image& srcImage, Offset3D& srcRegionOffset, Extent3D& srcRegionExtent) const
+{
+    if (GetFormat() != srcImage.GetFormat() || GetDataType() != srcImage.GetDataType())
+        return false;
+
+    /* First clamp source region to source image dimension */
+    srcImage.ClampRegion(srcRegionOffset, srcRegionExtent);
+
+    const Extent3D& srcExtent = srcImage.GetExtent();
+    if (static_cast<std::uint32_t>(srcRegionOffset.x) >= srcExtent.width  ||
+        static_cast<std::uint32_t>(srcRegionOffset.y) >= srcExtent.height ||
+        static_cast<std::uint32_t>(srcRegionOffset.z) >= srcExtent.depth)
+    {
+        return false;
+    }
+
+    srcRegionExtent.width   = std::min(srcRegionExtent.width,  srcExtent.width  - static_cast<std::uint32_t>(srcRegionOffset.x));
+    srcRegionExtent.height  = std::min(srcRegionExtent.height, srcExtent.height - static_cast<std::uint32_t>(srcRegionOffset.y));
+    srcRegionExtent.depth   = std::min(srcRegionExtent.depth,  srcExtent.depth  - static_cast<std::uint32_t>(srcRegionOffset.z));
+
+    /* Then shift negative destination region */
+    return
+    (
+        ShiftNegative1DRegion(dstRegionOffset.x, GetExtent().width,  srcRegionOffset.x, srcRegionExtent.width ) &&
+        ShiftNegative1DRegion(dstRegionOffset.y, GetExtent().height, srcRegionOffset.y, srcRegionExtent.height) &&
+        ShiftNegative1DRegion(dstRegionOffset.z, GetExtent().depth,  srcRegionOffset.z, srcRegionExtent.depth )
+    );
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,365 @@
+/*
+ * ImageConverter.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "ImageConverter.h"
+#include "ImageUtils.h"
+#include "Float16Compressor.h"
+#include <LLGL/Utils/ForRange.h>
+#include <limits>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/* ----- Data type traits ----- */
+
+/*
+The read and write functions of these traits must match the generic variant conversion in ImageFlags.cpp exactly,
+i.e. ReadNormalizedTypedVariant() and WriteNormalizedTypedVariant(), so the results are bitwise identical.
+Min() and Max() denote the normalized minimum and maximum values, i.e. the default color components (0, 0, 0, 1).
+*/
+template <DataType T>
+struct DataTypeTraits;
+
+template <typename T>
+struct IntegralDataTypeTraits
+{
+    using Type = T;
+
+    static double Read(Type value)
+    {
+        return ReadNormalizedVariant(value);
+    }
+
+    static Type Write(double value)
+    {
+        Type result;
+        WriteNormalizedVariant(result, value);
+        return result;
+    }
+
+    static Type Min()
+    {
+        return std::numeric_limits<Type>::min();
+    }
+
+    static Type Max()
+    {
+        return std::numeric_limits<Type>::max();
+    }
+};
+
+template <>
+struct DataTypeTraits<DataType::UInt8> : IntegralDataTypeTraits<std::uint8_t> {};
+
+template <>
+struct DataTypeTraits<DataType::Float16>
+{
+    using Type = std::uint16_t;
+
+    static double Read(Type value)
+    {
+        return static_cast<double>(DecompressFloat16(value));
+    }
+
+    static Type Write(double value)
+    {
+        return CompressFloat16(static_cast<float>(value));
+    }
+
+    static Type Min()
+    {
+        return 0x0000; // 0.0 as half-float
+    }
+
+    static Type Max()
+    {
+        return 0x3C00; // 1.0 as half-float
+    }
+};
+
+template <>
+struct DataTypeTraits<DataType::Float32>
+{
+    using Type = float;
+
+    static double Read(Type value)
+    {
+        return static_cast<double>(value);
+    }
+
+    static Type Write(double value)
+    {
+        return static_cast<float>(value);
+    }
+
+    static Type Min()
+    {
+        return 0.0f;
+    }
+
+    static Type Max()
+    {
+        return 1.0f;
+    }
+};
+
+
+/* ----- Component converters ----- */
+
+// Converts a single color component from the source to the destination data type.
+template <DataType SrcType, DataType DstType>
+struct ComponentConverter
+{
+    using SrcTraits = DataTypeTraits<SrcType>;
+    using DstTraits = DataTypeTraits<DstType>;
+
+    typename DstTraits::Type operator () (typename SrcTraits::Type value) const
+    {
+        return DstTraits::Write(SrcTraits::Read(value));
+    }
+};
+
+// Passes color components through if source and destination data type are equal.
+template <DataType T>
+struct ComponentConverter<T, T>
+{
+    using Type = typename DataTypeTraits<T>::Type;
+
+    Type operator () (Type value) const
+    {
+        return value;
+    }
+};
+
+// Lookup table for all 256 values of an 8-bit source component.
+template <DataType DstType>
+struct UInt8ConversionTable
+{
+    using DstTraits = DataTypeTraits<DstType>;
+
+    UInt8ConversionTable()
+    {
+        for_range(i, 256u)
+            values[i] = DstTraits::Write(DataTypeTraits<DataType::UInt8>::Read(static_cast<std::uint8_t>(i)));
+    }
+
+    typename DstTraits::Type values[256];
+};
+
+// Converts 8-bit source components with a lookup table instead of a double-precision round-trip.
+template <DataType DstType>
+struct ComponentConverter<DataType::UInt8, DstType>
+{
+    using Table = UInt8ConversionTable<DstType>;
+
+    ComponentConverter() :
+        values { GetTable().values }
+    {
+    }
+
+    typename Table::DstTraits::Type operator () (std::uint8_t value) const
+    {
+        return values[value];
+    }
+
+    static const Table& GetTable()
+    {
+        static const Table table;
+        return table;
+    }
+
+    const typename Table::DstTraits::Type* values;
+};
+
+template <>
+struct ComponentConverter<DataType::UInt8, DataType::UInt8>
+{
+    std::uint8_t operator () (std::uint8_t value) const
+    {
+        return value;
+    }
+};
+
+
+/* ----- Image format traits ----- */
+
+/*
+Image format traits specify the number of components per pixel and the index of each RGBA component within a pixel.
+An index of -1 denotes that the component is not part of the image format.
+*/
+template <ImageFormat Format>
+struct ImageFormatTraits;
+
+#define LLGL_DECL_IMAGE_FORMAT_TRAITS(FORMAT, SIZE, R, G, B, A) \
+    template <>                                                 \
+    struct ImageFormatTraits<ImageFormat::FORMAT>               \
+    {                                                           \
+        enum { size = SIZE, r = R, g = G, b = B, a = A };      \
+    }
+
+LLGL_DECL_IMAGE_FORMAT_TRAITS( R,    1,  0, -1, -1, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( RG,   2,  0,  1, -1, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( RGB,  3,  0,  1,  2, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( BGR,  3,  2,  1,  0, -1 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( RGBA, 4,  0,  1,  2,  3 );
+LLGL_DECL_IMAGE_FORMAT_TRAITS( BGRA, 4,  2,  1,  0,  3 );
+
+#undef LLGL_DECL_IMAGE_FORMAT_TRAITS
+
+// Reads and writes a single pixel component at a compile-time index.
+template <int Index>
+struct PixelComponent
+{
+    template <typename TDst, typename TSrc, typename TConverter>
+    static TDst Read(const TSrc* src, const TConverter& converter, TDst /*defaultValue*/)
+    {
+        return converter(src[Index]);
+    }
+
+    template <typename TDst>
+    static void Write(TDst* dst, TDst value)
+    {
+        dst[Index] = value;
+    }
+};
+
+// Returns the default value for components that are not part of the source format and ignores components that are not part of the destination format.
+template <>
+struct PixelComponent<-1>
+{
+    template <typename TDst, typename TSrc, typename TConverter>
+    static TDst Read(const TSrc* /*src*/, const TConverter& /*converter*/, TDst defaultValue)
+    {
+        return defaultValue;
+    }
+
+    template <typename TDst>
+    static void Write(TDst* /*dst*/, TDst /*value*/)
+    {
+        // do nothing
+    }
+};
+
+
+/* ----- Pixel converters ----- */
+
+template <ImageFormat SrcFormat, DataType SrcType, ImageFormat DstFormat, DataType DstType>
+void ConvertImagePixels(void* dst, const void* src, std::size_t count)
+{
+    using SrcFormatTraits   = ImageFormatTraits<SrcFormat>;
+    using DstFormatTraits   = ImageFormatTraits<DstFormat>;
+    using TSrc              = typename DataTypeTraits<SrcType>::Type;
+    using TDst              = typename DataTypeTraits<DstType>::Type;
+
+    const ComponentConverter<SrcType, DstType> converter;
+
+    /* Missing source components are initialized with the default color (0, 0, 0, 1) */
+    const TDst defaultColor = DataTypeTraits<DstType>::Min();
+    const TDst defaultAlpha = DataTypeTraits<DstType>::Max();
+
+    const TSrc* srcPixel = static_cast<const TSrc*>(src);
+    TDst*       dstPixel = static_cast<TDst*>(dst);
+
+    for_range(i, count)
+    {
+        const TDst r = PixelComponent<SrcFormatTraits::r>::Read(srcPixel, converter, defaultColor);
+        const TDst g = PixelComponent<SrcFormatTraits::g>::Read(srcPixel, converter, defaultColor);
+        const TDst b = PixelComponent<SrcFormatTraits::b>::Read(srcPixel, converter, defaultColor);
+        const TDst a = PixelComponent<SrcFormatTraits::a>::Read(srcPixel, converter, defaultAlpha);
+
+        PixelComponent<DstFormatTraits::r>::Write(dstPixel, r);
+        PixelComponent<DstFormatTraits::g>::Write(dstPixel, g);
+        PixelComponent<DstFormatTraits::b>::Write(dstPixel, b);
+        PixelComponent<DstFormatTraits::a>::Write(dstPixel, a);
+
+        srcPixel += SrcFormatTraits::size;
+        dstPixel += DstFormatTraits::size;
+    }
+}
+
+
+/* ----- Converter lookup table ----- */
+
+/*
+The lookup table is keyed by (source format, source data type, destination format, destination data type)
+and is resolved by a cascade of switch statements, each one fixing another template parameter of ConvertImagePixels().
+*/
+
+template <ImageFormat SrcFormat, DataType SrcType, ImageFormat DstFormat>
+PFN_ConvertImagePixels SelectConverterForDstDataType(DataType dstDataType)
+{
+    switch (dstDataType)
+    {
+        case DataType::UInt8:   return ConvertImagePixels<SrcFormat, SrcType, DstFormat, DataType::UInt8>;
+        case DataType::Float16: return ConvertImagePixels<SrcFormat, SrcType, DstFormat, DataType::Float16>;
+        case DataType::Float32: return ConvertImagePixels<SrcFormat, SrcType, DstFormat, DataType::Float32>;
+        default:                return nullptr;
+    }
+}
+
+template <ImageFormat SrcFormat, DataType SrcType>
+PFN_ConvertImagePixels SelectConverterForDstFormat(ImageFormat dstFormat, DataType dstDataType)
+{
+    switch (dstFormat)
+    {
+        case ImageFormat::R:    return SelectConverterForDstDataType<SrcFormat, SrcType, ImageFormat::R   >(dstDataType);
+        case ImageFormat::RG:   return SelectConverterForDstDataType<SrcFormat, SrcType, ImageFormat::RG  >(dstDataType);
+        case ImageFormat::RGB:  return SelectConverterForDstDataType<SrcFormat, SrcType, ImageFormat::RGB >(dstDataType);
+        case ImageFormat::BGR:  return SelectConverterForDstDataType<SrcFormat, SrcType, ImageFormat::BGR >(dstDataType);
+        case ImageFormat::RGBA: return SelectConverterForDstDataType<SrcFormat, SrcType, ImageFormat::RGBA>(dstDataType);
+        case ImageFormat::BGRA: return SelectConverterForDstDataType<SrcFormat, SrcType, ImageFormat::BGRA>(dstDataType);
+        default:                return nullptr;
+    }
+}
+
+template <ImageFormat SrcFormat>
+PFN_ConvertImagePixels SelectConverterForSrcDataType(DataType srcDataType, ImageFormat dstFormat, DataType dstDataType)
+{
+    switch (srcDataType)
+    {
+        case DataType::UInt8:   return SelectConverterForDstFormat<SrcFormat, DataType::UInt8  >(dstFormat, dstDataType);
+        case DataType::Float16: return SelectConverterForDstFormat<SrcFormat, DataType::Float16>(dstFormat, dstDataType);
+        case DataType::Float32: return SelectConverterForDstFormat<SrcFormat, DataType::Float32>(dstFormat, dstDataType);
+        default:                return nullptr;
+    }
+}
+
+LLGL_EXPORT PFN_ConvertImagePixels FindImagePixelConverter(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    ImageFormat dstFormat,
+    DataType    dstDataType)
+{
+    /* Identical formats don't need a conversion but only a copy */
+    if (srcFormat == dstFormat && srcDataType == dstDataType)
+        return nullptr;
+
+    /* Prefer vectorized converters if the CPU supports them */
+    if (PFN_ConvertImagePixels converter = FindImagePixelConverterSIMD(srcFormat, srcDataType, dstFormat, dstDataType))
+        return converter;
+
+    switch (srcFormat)
+    {
+        case ImageFormat::R:    return SelectConverterForSrcDataType<ImageFormat::R   >(srcDataType, dstFormat, dstDataType);
+        case ImageFormat::RG:   return SelectConverterForSrcDataType<ImageFormat::RG  >(srcDataType, dstFormat, dstDataType);
+        case ImageFormat::RGB:  return SelectConverterForSrcDataType<ImageFormat::RGB >(srcDataType, dstFormat, dstDataType);
+        case ImageFormat::BGR:  return SelectConverterForSrcDataType<ImageFormat::BGR >(srcDataType, dstFormat, dstDataType);
+        case ImageFormat::RGBA: return SelectConverterForSrcDataType<ImageFormat::RGBA>(srcDataType, dstFormat, dstDataType);
+        case ImageFormat::BGRA: return SelectConverterForSrcDataType<ImageFormat::BGRA>(srcDataType, dstFormat, dstDataType);
+        default:                return nullptr;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
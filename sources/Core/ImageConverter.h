@@ -0,0 +1,63 @@
+/*
+ * ImageConverter.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_IMAGE_CONVERTER_H
+#define LLGL_IMAGE_CONVERTER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Format.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Types ----- */
+
+/*
+Function pointer type of a specialized pixel converter.
+Converts 'count' tightly packed pixels from 'src' into 'dst'. Source and destination must not overlap.
+*/
+typedef void (*PFN_ConvertImagePixels)(void* dst, const void* src, std::size_t count);
+
+
+/* ----- Functions ----- */
+
+/*
+Returns a specialized pixel converter for the specified source and destination image formats and data types,
+or null if there is no specialized converter for this combination and the generic conversion must be used instead.
+The results of the specialized converters are bitwise identical to the generic image conversion.
+*/
+LLGL_EXPORT PFN_ConvertImagePixels FindImagePixelConverter(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    ImageFormat dstFormat,
+    DataType    dstDataType
+);
+
+/*
+Returns a pixel converter that uses SIMD instructions supported by the host CPU,
+or null if there is no such converter for this combination. Used by FindImagePixelConverter().
+*/
+LLGL_EXPORT PFN_ConvertImagePixels FindImagePixelConverterSIMD(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    ImageFormat dstFormat,
+    DataType    dstDataType
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,549 @@
+/*
+ * ImageConverterSIMD.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "ImageConverter.h"
+#include "ImageUtils.h"
+#include "CPUFeatures.h"
+#include "CompilerExtensions.h"
+#include <LLGL/Platform/Platform.h>
+#include <LLGL/Utils/ForRange.h>
+#include <cstdint>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_IMAGE_CONVERTER_X86
+#   include <immintrin.h>
+#elif defined LLGL_ARCH_ARM64 || (defined LLGL_ARCH_ARM && defined __ARM_NEON)
+#   define LLGL_IMAGE_CONVERTER_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+All kernels in this file must produce bitwise identical results to the scalar converters in ImageConverter.cpp,
+which in turn match the generic variant conversion. Every kernel processes the bulk of its input with SIMD instructions
+and the remainder with the scalar equivalent below.
+*/
+
+/* ----- Scalar kernels ----- */
+
+template <bool SwapRB>
+void ExpandRGB8ToRGBA8Scalar(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    for_range(i, count)
+    {
+        dst[0] = src[SwapRB ? 2 : 0];
+        dst[1] = src[1];
+        dst[2] = src[SwapRB ? 0 : 2];
+        dst[3] = 0xFF;
+        dst += 4;
+        src += 3;
+    }
+}
+
+template <bool SwapRB>
+void ShrinkRGBA8ToRGB8Scalar(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    for_range(i, count)
+    {
+        dst[0] = src[SwapRB ? 2 : 0];
+        dst[1] = src[1];
+        dst[2] = src[SwapRB ? 0 : 2];
+        dst += 3;
+        src += 4;
+    }
+}
+
+static void SwizzleRGBA8ToBGRA8Scalar(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    for_range(i, count)
+    {
+        const std::uint8_t r = src[0];
+        dst[0] = src[2];
+        dst[1] = src[1];
+        dst[2] = r;
+        dst[3] = src[3];
+        dst += 4;
+        src += 4;
+    }
+}
+
+static void ConvertUInt8ToFloat32Scalar(float* dst, const std::uint8_t* src, std::size_t count)
+{
+    for_range(i, count)
+        dst[i] = static_cast<float>(ReadNormalizedVariant(src[i]));
+}
+
+static void ConvertFloat32ToUInt8Scalar(std::uint8_t* dst, const float* src, std::size_t count)
+{
+    for_range(i, count)
+        WriteNormalizedVariant(dst[i], static_cast<double>(src[i]));
+}
+
+
+
+#if defined LLGL_IMAGE_CONVERTER_X86
+
+/* ----- SSE2/SSSE3 kernels ----- */
+
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void SwizzleRGBA8ToBGRA8SSE2(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    /* Swap red and blue channel of 4 pixels at a time: (R | B << 16) becomes (B | R << 16) */
+    const __m128i maskAG = _mm_set1_epi32(static_cast<int>(0xFF00FF00));
+    const __m128i maskRB = _mm_set1_epi32(static_cast<int>(0x00FF00FF));
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i pixels    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        const __m128i ag        = _mm_and_si128(pixels, maskAG);
+        const __m128i rb        = _mm_and_si128(pixels, maskRB);
+        const __m128i br        = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(ag, br));
+    }
+    SwizzleRGBA8ToBGRA8Scalar(dst + i*4, src + i*4, count - i);
+}
+
+template <bool SwapRB>
+LLGL_TARGET_ATTRIBUTE("ssse3")
+void ExpandRGB8ToRGBA8SSSE3(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    const __m128i shuffle = (SwapRB
+        ? _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10,  9, -1)
+        : _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1,  9, 10, 11, -1)
+    );
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    /* Each iteration reads 16 bytes but only consumes 12, so stop while there are at least 6 pixels left */
+    std::size_t i = 0;
+    for (; i + 6 <= count; i += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*4), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha));
+    }
+    ExpandRGB8ToRGBA8Scalar<SwapRB>(dst + i*4, src + i*3, count - i);
+}
+
+template <bool SwapRB>
+LLGL_TARGET_ATTRIBUTE("ssse3")
+void ShrinkRGBA8ToRGB8SSSE3(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    const __m128i shuffle = (SwapRB
+        ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+        : _mm_setr_epi8(0, 1, 2, 4, 5, 6,  8, 9, 10, 12, 13, 14, -1, -1, -1, -1)
+    );
+
+    /* Each iteration writes 16 bytes but only produces 12, so stop while there are at least 6 pixels left */
+    std::size_t i = 0;
+    for (; i + 6 <= count; i += 4)
+    {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i*4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i*3), _mm_shuffle_epi8(pixels, shuffle));
+    }
+    ShrinkRGBA8ToRGB8Scalar<SwapRB>(dst + i*3, src + i*4, count - i);
+}
+
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void ConvertUInt8ToFloat32SSE2(float* dst, const std::uint8_t* src, std::size_t count)
+{
+    /* Division (instead of multiplication with the reciprocal) matches the double-precision conversion for all 256 values */
+    const __m128  scale = _mm_set1_ps(255.0f);
+    const __m128i zero  = _mm_setzero_si128();
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo16  = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi16  = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_ps(dst + i     , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero)), scale));
+        _mm_storeu_ps(dst + i +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero)), scale));
+        _mm_storeu_ps(dst + i +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero)), scale));
+        _mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero)), scale));
+    }
+    ConvertUInt8ToFloat32Scalar(dst + i, src + i, count - i);
+}
+
+// Scales four floats by 255 in double precision and truncates them to integers, just like WriteNormalizedVariant().
+LLGL_TARGET_ATTRIBUTE("sse2")
+static __m128i ScaleAndTruncateFloat32ToUNorm8SSE2(__m128 values, __m128d scale)
+{
+    const __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(values), scale));
+    const __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(values, values)), scale));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void ConvertFloat32ToUInt8SSE2(std::uint8_t* dst, const float* src, std::size_t count)
+{
+    const __m128d scale = _mm_set1_pd(255.0);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = ScaleAndTruncateFloat32ToUNorm8SSE2(_mm_loadu_ps(src + i     ), scale);
+        const __m128i v1 = ScaleAndTruncateFloat32ToUNorm8SSE2(_mm_loadu_ps(src + i +  4), scale);
+        const __m128i v2 = ScaleAndTruncateFloat32ToUNorm8SSE2(_mm_loadu_ps(src + i +  8), scale);
+        const __m128i v3 = ScaleAndTruncateFloat32ToUNorm8SSE2(_mm_loadu_ps(src + i + 12), scale);
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bytes);
+    }
+    ConvertFloat32ToUInt8Scalar(dst + i, src + i, count - i);
+}
+
+
+/* ----- AVX2 kernels ----- */
+
+LLGL_TARGET_ATTRIBUTE("avx2")
+static void SwizzleRGBA8ToBGRA8AVX2(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    const __m256i maskAG = _mm256_set1_epi32(static_cast<int>(0xFF00FF00));
+    const __m256i maskRB = _mm256_set1_epi32(static_cast<int>(0x00FF00FF));
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i pixels    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i*4));
+        const __m256i ag        = _mm256_and_si256(pixels, maskAG);
+        const __m256i rb        = _mm256_and_si256(pixels, maskRB);
+        const __m256i br        = _mm256_or_si256(_mm256_slli_epi32(rb, 16), _mm256_srli_epi32(rb, 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i*4), _mm256_or_si256(ag, br));
+    }
+    SwizzleRGBA8ToBGRA8Scalar(dst + i*4, src + i*4, count - i);
+}
+
+LLGL_TARGET_ATTRIBUTE("avx2")
+static void ConvertUInt8ToFloat32AVX2(float* dst, const std::uint8_t* src, std::size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(255.0f);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m256i lo32  = _mm256_cvtepu8_epi32(bytes);
+        const __m256i hi32  = _mm256_cvtepu8_epi32(_mm_unpackhi_epi64(bytes, bytes));
+        _mm256_storeu_ps(dst + i    , _mm256_div_ps(_mm256_cvtepi32_ps(lo32), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_div_ps(_mm256_cvtepi32_ps(hi32), scale));
+    }
+    ConvertUInt8ToFloat32Scalar(dst + i, src + i, count - i);
+}
+
+LLGL_TARGET_ATTRIBUTE("avx2")
+static __m128i ScaleAndTruncateFloat32ToUNorm8AVX2(__m128 values, __m256d scale)
+{
+    return _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(values), scale));
+}
+
+LLGL_TARGET_ATTRIBUTE("avx2")
+static void ConvertFloat32ToUInt8AVX2(std::uint8_t* dst, const float* src, std::size_t count)
+{
+    const __m256d scale = _mm256_set1_pd(255.0);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = ScaleAndTruncateFloat32ToUNorm8AVX2(_mm_loadu_ps(src + i     ), scale);
+        const __m128i v1 = ScaleAndTruncateFloat32ToUNorm8AVX2(_mm_loadu_ps(src + i +  4), scale);
+        const __m128i v2 = ScaleAndTruncateFloat32ToUNorm8AVX2(_mm_loadu_ps(src + i +  8), scale);
+        const __m128i v3 = ScaleAndTruncateFloat32ToUNorm8AVX2(_mm_loadu_ps(src + i + 12), scale);
+        const __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), bytes);
+    }
+    ConvertFloat32ToUInt8Scalar(dst + i, src + i, count - i);
+}
+
+#endif // /LLGL_IMAGE_CONVERTER_X86
+
+
+#if defined LLGL_IMAGE_CONVERTER_NEON
+
+/* ----- NEON kernels ----- */
+
+static void SwizzleRGBA8ToBGRA8NEON(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        uint8x16x4_t pixels = vld4q_u8(src + i*4);
+        const uint8x16_t r = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = r;
+        vst4q_u8(dst + i*4, pixels);
+    }
+    SwizzleRGBA8ToBGRA8Scalar(dst + i*4, src + i*4, count - i);
+}
+
+template <bool SwapRB>
+void ExpandRGB8ToRGBA8NEON(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16x3_t srcPixels = vld3q_u8(src + i*3);
+        uint8x16x4_t dstPixels;
+        dstPixels.val[0] = srcPixels.val[SwapRB ? 2 : 0];
+        dstPixels.val[1] = srcPixels.val[1];
+        dstPixels.val[2] = srcPixels.val[SwapRB ? 0 : 2];
+        dstPixels.val[3] = vdupq_n_u8(0xFF);
+        vst4q_u8(dst + i*4, dstPixels);
+    }
+    ExpandRGB8ToRGBA8Scalar<SwapRB>(dst + i*4, src + i*3, count - i);
+}
+
+template <bool SwapRB>
+void ShrinkRGBA8ToRGB8NEON(std::uint8_t* dst, const std::uint8_t* src, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const uint8x16x4_t srcPixels = vld4q_u8(src + i*4);
+        uint8x16x3_t dstPixels;
+        dstPixels.val[0] = srcPixels.val[SwapRB ? 2 : 0];
+        dstPixels.val[1] = srcPixels.val[1];
+        dstPixels.val[2] = srcPixels.val[SwapRB ? 0 : 2];
+        vst3q_u8(dst + i*3, dstPixels);
+    }
+    ShrinkRGBA8ToRGB8Scalar<SwapRB>(dst + i*3, src + i*4, count - i);
+}
+
+#if defined LLGL_ARCH_ARM64
+
+static void ConvertUInt8ToFloat32NEON(float* dst, const std::uint8_t* src, std::size_t count)
+{
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint16x8_t words = vmovl_u8(vld1_u8(src + i));
+        vst1q_f32(dst + i    , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(words))), scale));
+        vst1q_f32(dst + i + 4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(words))), scale));
+    }
+    ConvertUInt8ToFloat32Scalar(dst + i, src + i, count - i);
+}
+
+// Scales four floats by 255 in double precision and truncates them to integers, just like WriteNormalizedVariant().
+static uint32x4_t ScaleAndTruncateFloat32ToUNorm8NEON(float32x4_t values, float64x2_t scale)
+{
+    const uint64x2_t lo = vcvtq_u64_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(values)), scale));
+    const uint64x2_t hi = vcvtq_u64_f64(vmulq_f64(vcvt_high_f64_f32(values), scale));
+    return vcombine_u32(vmovn_u64(lo), vmovn_u64(hi));
+}
+
+static void ConvertFloat32ToUInt8NEON(std::uint8_t* dst, const float* src, std::size_t count)
+{
+    const float64x2_t scale = vdupq_n_f64(255.0);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint32x4_t lo = ScaleAndTruncateFloat32ToUNorm8NEON(vld1q_f32(src + i    ), scale);
+        const uint32x4_t hi = ScaleAndTruncateFloat32ToUNorm8NEON(vld1q_f32(src + i + 4), scale);
+        vst1_u8(dst + i, vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi))));
+    }
+    ConvertFloat32ToUInt8Scalar(dst + i, src + i, count - i);
+}
+
+#endif // /LLGL_ARCH_ARM64
+
+#endif // /LLGL_IMAGE_CONVERTER_NEON
+
+
+/* ----- Kernel selection ----- */
+
+// Adapts a kernel that converts a flat array of 8-bit pixel data to the pixel converter signature.
+template <void (*Kernel)(std::uint8_t*, const std::uint8_t*, std::size_t)>
+void ConvertPixelsWithKernel(void* dst, const void* src, std::size_t count)
+{
+    Kernel(static_cast<std::uint8_t*>(dst), static_cast<const std::uint8_t*>(src), count);
+}
+
+// Adapts a kernel that converts a flat array of color components to the pixel converter signature.
+template <typename TDst, typename TSrc, void (*Kernel)(TDst*, const TSrc*, std::size_t), std::size_t NumComponents>
+void ConvertComponentsWithKernel(void* dst, const void* src, std::size_t count)
+{
+    Kernel(static_cast<TDst*>(dst), static_cast<const TSrc*>(src), count * NumComponents);
+}
+
+template <typename TDst, typename TSrc, void (*Kernel)(TDst*, const TSrc*, std::size_t)>
+PFN_ConvertImagePixels SelectComponentKernel(std::uint32_t numComponents)
+{
+    switch (numComponents)
+    {
+        case 1: return ConvertComponentsWithKernel<TDst, TSrc, Kernel, 1>;
+        case 2: return ConvertComponentsWithKernel<TDst, TSrc, Kernel, 2>;
+        case 3: return ConvertComponentsWithKernel<TDst, TSrc, Kernel, 3>;
+        case 4: return ConvertComponentsWithKernel<TDst, TSrc, Kernel, 4>;
+        default: return nullptr;
+    }
+}
+
+enum class PixelSwizzle
+{
+    Unsupported,
+    SwapRB,         // RGBA <-> BGRA
+    Expand,         // RGB -> RGBA, BGR -> BGRA
+    ExpandSwapRB,   // RGB -> BGRA, BGR -> RGBA
+    Shrink,         // RGBA -> RGB, BGRA -> BGR
+    ShrinkSwapRB,   // RGBA -> BGR, BGRA -> RGB
+};
+
+static bool IsRGBOrBGR(ImageFormat format)
+{
+    return (format == ImageFormat::RGB || format == ImageFormat::BGR);
+}
+
+static bool IsRGBAOrBGRA(ImageFormat format)
+{
+    return (format == ImageFormat::RGBA || format == ImageFormat::BGRA);
+}
+
+// Returns true if the red and blue components have a different order in the two formats.
+static bool IsRBSwapped(ImageFormat srcFormat, ImageFormat dstFormat)
+{
+    const bool srcIsBGR = (srcFormat == ImageFormat::BGR || srcFormat == ImageFormat::BGRA);
+    const bool dstIsBGR = (dstFormat == ImageFormat::BGR || dstFormat == ImageFormat::BGRA);
+    return (srcIsBGR != dstIsBGR);
+}
+
+static PixelSwizzle GetPixelSwizzle(ImageFormat srcFormat, ImageFormat dstFormat)
+{
+    const bool swapRB = IsRBSwapped(srcFormat, dstFormat);
+    if (IsRGBAOrBGRA(srcFormat) && IsRGBAOrBGRA(dstFormat))
+        return (swapRB ? PixelSwizzle::SwapRB : PixelSwizzle::Unsupported);
+    if (IsRGBOrBGR(srcFormat) && IsRGBAOrBGRA(dstFormat))
+        return (swapRB ? PixelSwizzle::ExpandSwapRB : PixelSwizzle::Expand);
+    if (IsRGBAOrBGRA(srcFormat) && IsRGBOrBGR(dstFormat))
+        return (swapRB ? PixelSwizzle::ShrinkSwapRB : PixelSwizzle::Shrink);
+    return PixelSwizzle::Unsupported;
+}
+
+static PFN_ConvertImagePixels FindSwizzleKernel(PixelSwizzle swizzle, long cpuFeatures)
+{
+    #if defined LLGL_IMAGE_CONVERTER_X86
+
+    switch (swizzle)
+    {
+        case PixelSwizzle::SwapRB:
+            if ((cpuFeatures & CPUFeatureFlags::AVX2) != 0)
+                return ConvertPixelsWithKernel<SwizzleRGBA8ToBGRA8AVX2>;
+            if ((cpuFeatures & CPUFeatureFlags::SSE2) != 0)
+                return ConvertPixelsWithKernel<SwizzleRGBA8ToBGRA8SSE2>;
+            break;
+        case PixelSwizzle::Expand:
+            if ((cpuFeatures & CPUFeatureFlags::SSSE3) != 0)
+                return ConvertPixelsWithKernel<ExpandRGB8ToRGBA8SSSE3<false>>;
+            break;
+        case PixelSwizzle::ExpandSwapRB:
+            if ((cpuFeatures & CPUFeatureFlags::SSSE3) != 0)
+                return ConvertPixelsWithKernel<ExpandRGB8ToRGBA8SSSE3<true>>;
+            break;
+        case PixelSwizzle::Shrink:
+            if ((cpuFeatures & CPUFeatureFlags::SSSE3) != 0)
+                return ConvertPixelsWithKernel<ShrinkRGBA8ToRGB8SSSE3<false>>;
+            break;
+        case PixelSwizzle::ShrinkSwapRB:
+            if ((cpuFeatures & CPUFeatureFlags::SSSE3) != 0)
+                return ConvertPixelsWithKernel<ShrinkRGBA8ToRGB8SSSE3<true>>;
+            break;
+        default:
+            break;
+    }
+
+    #elif defined LLGL_IMAGE_CONVERTER_NEON
+
+    if ((cpuFeatures & CPUFeatureFlags::NEON) != 0)
+    {
+        switch (swizzle)
+        {
+            case PixelSwizzle::SwapRB:          return ConvertPixelsWithKernel<SwizzleRGBA8ToBGRA8NEON>;
+            case PixelSwizzle::Expand:          return ConvertPixelsWithKernel<ExpandRGB8ToRGBA8NEON<false>>;
+            case PixelSwizzle::ExpandSwapRB:    return ConvertPixelsWithKernel<ExpandRGB8ToRGBA8NEON<true>>;
+            case PixelSwizzle::Shrink:          return ConvertPixelsWithKernel<ShrinkRGBA8ToRGB8NEON<false>>;
+            case PixelSwizzle::ShrinkSwapRB:    return ConvertPixelsWithKernel<ShrinkRGBA8ToRGB8NEON<true>>;
+            default:                            break;
+        }
+    }
+
+    #endif
+
+    (void)swizzle;
+    (void)cpuFeatures;
+    return nullptr;
+}
+
+static PFN_ConvertImagePixels FindDataTypeKernel(DataType srcDataType, DataType dstDataType, std::uint32_t numComponents, long cpuFeatures)
+{
+    #if defined LLGL_IMAGE_CONVERTER_X86
+
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+    {
+        if ((cpuFeatures & CPUFeatureFlags::AVX2) != 0)
+            return SelectComponentKernel<float, std::uint8_t, ConvertUInt8ToFloat32AVX2>(numComponents);
+        if ((cpuFeatures & CPUFeatureFlags::SSE2) != 0)
+            return SelectComponentKernel<float, std::uint8_t, ConvertUInt8ToFloat32SSE2>(numComponents);
+    }
+    else if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+    {
+        if ((cpuFeatures & CPUFeatureFlags::AVX2) != 0)
+            return SelectComponentKernel<std::uint8_t, float, ConvertFloat32ToUInt8AVX2>(numComponents);
+        if ((cpuFeatures & CPUFeatureFlags::SSE2) != 0)
+            return SelectComponentKernel<std::uint8_t, float, ConvertFloat32ToUInt8SSE2>(numComponents);
+    }
+
+    #elif defined LLGL_IMAGE_CONVERTER_NEON && defined LLGL_ARCH_ARM64
+
+    if ((cpuFeatures & CPUFeatureFlags::NEON) != 0)
+    {
+        if (srcDataType == DataType::UInt8 && dstDataType == DataType::Float32)
+            return SelectComponentKernel<float, std::uint8_t, ConvertUInt8ToFloat32NEON>(numComponents);
+        if (srcDataType == DataType::Float32 && dstDataType == DataType::UInt8)
+            return SelectComponentKernel<std::uint8_t, float, ConvertFloat32ToUInt8NEON>(numComponents);
+    }
+
+    #endif
+
+    (void)srcDataType;
+    (void)dstDataType;
+    (void)numComponents;
+    (void)cpuFeatures;
+    return nullptr;
+}
+
+LLGL_EXPORT PFN_ConvertImagePixels FindImagePixelConverterSIMD(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    ImageFormat dstFormat,
+    DataType    dstDataType)
+{
+    const long cpuFeatures = GetCPUFeatures();
+
+    if (srcDataType == DataType::UInt8 && dstDataType == DataType::UInt8)
+    {
+        /* Swizzle 8-bit color components */
+        return FindSwizzleKernel(GetPixelSwizzle(srcFormat, dstFormat), cpuFeatures);
+    }
+    else if (srcFormat == dstFormat && srcFormat >= ImageFormat::Alpha && srcFormat <= ImageFormat::ABGR)
+    {
+        /* Convert data type of color components regardless of their order */
+        return FindDataTypeKernel(srcDataType, dstDataType, ImageFormatSize(srcFormat), cpuFeatures);
+    }
+
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
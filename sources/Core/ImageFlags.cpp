@@ -13,11 +13,13 @@
 #include <thread>
 #include <cstring>
 #include "ImageUtils.h"
+#include "ImageConverter.h"
 #include "../Core/CoreUtils.h"
 #include "../Core/Assertion.h"
 #include "../Core/Threading.h"
 #include "Float16Compressor.h"
 #include "BCDecompressor.h"
+#include "BCCompressor.h"
 #include <LLGL/Utils/ForRange.h>
 #include <LLGL/Utils/TypeNames.h>
 
@@ -193,24 +195,6 @@ static void AdvancePaddingOffsetAtEdge(
     }
 }
 
-// Reads the specified source variant and returns it to the normalized range [0, 1].
-template <typename T>
-double ReadNormalizedVariant(const T& src)
-{
-    constexpr double min = static_cast<double>(std::numeric_limits<T>::min());
-    constexpr double max = static_cast<double>(std::numeric_limits<T>::max());
-    return (static_cast<double>(src) - min) / (max - min);
-}
-
-// Writes the specified value from the range [0, 1] to the destination variant.
-template <typename T>
-void WriteNormalizedVariant(T& dst, double value)
-{
-    constexpr double min = static_cast<double>(std::numeric_limits<T>::min());
-    constexpr double max = static_cast<double>(std::numeric_limits<T>::max());
-    dst = static_cast<T>(value * (max - min) + min);
-}
-
 static double ReadNormalizedTypedVariant(DataType srcDataType, const VariantConstBuffer& srcBuffer, std::size_t idx)
 {
     switch (srcDataType)
@@ -596,6 +580,129 @@ static std::size_t ConvertImageBufferFormat(
     return memoryInfo.dstImageSize;
 }
 
+// Worker thread procedure for the "ConvertImageBufferWithConverter" function
+static void ConvertImageBufferWithConverterWorker(
+    const ImageView&                srcImageView,
+    const MutableImageView&         dstImageView,
+    const ImageMemoryInfo&          srcMemoryInfo,
+    const ImageMemoryInfo&          dstMemoryInfo,
+    const Extent3D&                 extent,
+    PFN_ConvertImagePixels          converter,
+    std::size_t                     begin,
+    std::size_t                     end)
+{
+    const std::size_t srcBpp = GetMemoryFootprint(srcImageView.format, srcImageView.dataType, 1);
+    const std::size_t dstBpp = GetMemoryFootprint(dstImageView.format, dstImageView.dataType, 1);
+
+    const char* srcBuffer = static_cast<const char*>(srcImageView.data);
+    char*       dstBuffer = static_cast<char*>(dstImageView.data);
+
+    /* Convert pixels in contiguous spans that never cross a row boundary */
+    for (std::size_t i = begin; i < end;)
+    {
+        const std::size_t row   = i / extent.width;
+        const std::size_t x     = i % extent.width;
+        const std::size_t y     = row % extent.height;
+        const std::size_t z     = row / extent.height;
+        const std::size_t count = std::min<std::size_t>(extent.width - x, end - i);
+
+        converter(
+            dstBuffer + (z * dstMemoryInfo.layerStride + y * dstMemoryInfo.rowStride + x * dstBpp),
+            srcBuffer + (z * srcMemoryInfo.layerStride + y * srcMemoryInfo.rowStride + x * srcBpp),
+            count
+        );
+
+        i += count;
+    }
+}
+
+static std::size_t ConvertImageBufferWithConverter(
+    const ImageView&        srcImageView,
+    const MutableImageView& dstImageView,
+    const Extent3D&         extent,
+    unsigned                threadCount,
+    PFN_ConvertImagePixels  converter)
+{
+    /* Validate destination buffer size */
+    const std::size_t numPixels = extent.width * extent.height * extent.depth;
+
+    ImageMemoryInfo srcMemoryInfo, dstMemoryInfo;
+    GetImageMemoryInfo(srcMemoryInfo, srcImageView, extent);
+    GetImageMemoryInfo(dstMemoryInfo, dstImageView, extent);
+
+    LLGL_ASSERT(
+        dstImageView.dataSize >= dstMemoryInfo.imageSize,
+        "destination image buffer is too small to convert image; expected %zu, but %zu was specified",
+        dstMemoryInfo.imageSize, dstImageView.dataSize
+    );
+
+    /* Convert format and data type in a single pass with specialized converter */
+    DoConcurrentRange(
+        std::bind(
+            ConvertImageBufferWithConverterWorker,
+            std::cref(srcImageView),
+            std::cref(dstImageView),
+            std::cref(srcMemoryInfo),
+            std::cref(dstMemoryInfo),
+            std::cref(extent),
+            converter,
+            std::placeholders::_1,
+            std::placeholders::_2
+        ),
+        numPixels,
+        threadCount
+    );
+
+    return dstMemoryInfo.imageSize;
+}
+
+template <std::uint32_t NumComponents>
+void CompressFloat16Pixels(void* dst, const void* src, std::size_t count)
+{
+    CompressFloat16Array(static_cast<std::uint16_t*>(dst), static_cast<const float*>(src), count * NumComponents);
+}
+
+template <std::uint32_t NumComponents>
+void DecompressFloat16Pixels(void* dst, const void* src, std::size_t count)
+{
+    DecompressFloat16Array(static_cast<float*>(dst), static_cast<const std::uint16_t*>(src), count * NumComponents);
+}
+
+// Returns a pixel converter between 16-bit and 32-bit floats of the same image format, or null if the images don't match that pattern.
+static PFN_ConvertImagePixels FindFloat16PixelConverter(
+    ImageFormat srcFormat,
+    DataType    srcDataType,
+    ImageFormat dstFormat,
+    DataType    dstDataType)
+{
+    /* Only color formats and depth-only format are considered, which precede the other depth-stencil formats */
+    if (srcFormat != dstFormat || srcFormat > ImageFormat::Depth)
+        return nullptr;
+
+    if (srcDataType == DataType::Float32 && dstDataType == DataType::Float16)
+    {
+        switch (ImageFormatSize(srcFormat))
+        {
+            case 1: return CompressFloat16Pixels<1>;
+            case 2: return CompressFloat16Pixels<2>;
+            case 3: return CompressFloat16Pixels<3>;
+            case 4: return CompressFloat16Pixels<4>;
+        }
+    }
+    else if (srcDataType == DataType::Float16 && dstDataType == DataType::Float32)
+    {
+        switch (ImageFormatSize(srcFormat))
+        {
+            case 1: return DecompressFloat16Pixels<1>;
+            case 2: return DecompressFloat16Pixels<2>;
+            case 3: return DecompressFloat16Pixels<3>;
+            case 4: return DecompressFloat16Pixels<4>;
+        }
+    }
+
+    return nullptr;
+}
+
 static float UnpackD24UNorm(std::uint32_t value)
 {
     return (static_cast<float>(value) / static_cast<float>(0x00FFFFFFu));
@@ -846,11 +953,25 @@ LLGL_EXPORT std::size_t ConvertImageBuffer(
     ValidateDestinationImageView(dstImageView);
     ValidateImageConversionParams(srcImageView, dstImageView.format, dstImageView.dataType);
 
-    if (IsDepthOrStencilFormat(srcImageView.format))
+    PFN_ConvertImagePixels float16Converter = nullptr;
+    if (depthMask == ~0u)
+        float16Converter = FindFloat16PixelConverter(srcImageView.format, srcImageView.dataType, dstImageView.format, dstImageView.dataType);
+
+    if (float16Converter != nullptr)
+    {
+        /* Convert between half-precision and single-precision floats in bulk */
+        return ConvertImageBufferWithConverter(srcImageView, dstImageView, extent, threadCount, float16Converter);
+    }
+    else if (IsDepthOrStencilFormat(srcImageView.format))
     {
         /* Convert depth-stencil image format */
         return ConvertDepthStencilImageBufferFormat(srcImageView, dstImageView, extent, depthMask, stencilMask, threadCount);
     }
+    else if (PFN_ConvertImagePixels converter = FindImagePixelConverter(srcImageView.format, srcImageView.dataType, dstImageView.format, dstImageView.dataType))
+    {
+        /* Convert image with specialized converter for common formats and data types */
+        return ConvertImageBufferWithConverter(srcImageView, dstImageView, extent, threadCount, converter);
+    }
     else if (srcImageView.dataType != dstImageView.dataType && srcImageView.format != dstImageView.format)
     {
         /* Convert image data type with intermediate buffer */
@@ -1015,12 +1136,55 @@ LLGL_EXPORT DynamicByteArray DecompressImageBufferToRGBA8UNorm(
     {
         case Format::BC1UNorm:
         case Format::BC1UNorm_sRGB:
-            return DecompressBC1ToRGBA8UNorm(extent, static_cast<const char*>(srcImageView.data), srcImageView.dataSize, threadCount);
+        case Format::BC2UNorm:
+        case Format::BC2UNorm_sRGB:
+        case Format::BC3UNorm:
+        case Format::BC3UNorm_sRGB:
+        case Format::BC4UNorm:
+        case Format::BC4SNorm:
+        case Format::BC5UNorm:
+        case Format::BC5SNorm:
+        case Format::BC6HUFloat:
+        case Format::BC6HSFloat:
+        case Format::BC7UNorm:
+        case Format::BC7UNorm_sRGB:
+            return DecompressBCToRGBA8UNorm(compressedFormat, extent, static_cast<const char*>(srcImageView.data), srcImageView.dataSize, threadCount);
         default:
             return nullptr;
     }
 }
 
+LLGL_EXPORT DynamicByteArray CompressImageBuffer(
+    Format              compressedFormat,
+    const ImageView&    srcImageView,
+    const Extent2D&     extent,
+    CompressionQuality  quality,
+    unsigned            threadCount)
+{
+    if (threadCount == LLGL_MAX_THREAD_COUNT)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Convert source image to tightly packed RGBA8UNorm first */
+    DynamicByteArray rgba8Image = ConvertImageBuffer(
+        srcImageView,
+        ImageFormat::RGBA,
+        DataType::UInt8,
+        Extent3D{ extent.width, extent.height, 1u },
+        threadCount
+    );
+
+    const char*         data        = static_cast<const char*>(srcImageView.data);
+    std::size_t         dataSize    = srcImageView.dataSize;
+
+    if (rgba8Image)
+    {
+        data        = rgba8Image.get();
+        dataSize    = rgba8Image.size();
+    }
+
+    return CompressRGBA8UNormToBC(compressedFormat, extent, data, dataSize, quality, threadCount);
+}
+
 // Returns the 1D flattened buffer position for a 3D image coordinate ('bpp' denotes the bytes per pixel)
 static std::size_t GetFlattenedImageBufferPos(
     std::uint32_t x,
@@ -0,0 +1,548 @@
+/*
+ * ImageResampler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "ImageResampler.h"
+#include "Threading.h"
+#include "CPUFeatures.h"
+#include "CompilerExtensions.h"
+#include <LLGL/Platform/Platform.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <string.h>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_IMAGE_RESAMPLER_X86
+#   include <immintrin.h>
+#elif defined LLGL_ARCH_ARM64 || (defined LLGL_ARCH_ARM && defined __ARM_NEON)
+#   define LLGL_IMAGE_RESAMPLER_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Filter kernels ----- */
+
+static constexpr double g_pi = 3.14159265358979323846;
+
+static double Sinc(double x)
+{
+    if (std::abs(x) < 1.0e-8)
+        return 1.0;
+    x *= g_pi;
+    return std::sin(x) / x;
+}
+
+// Modified Bessel function of the first kind of order zero.
+static double BesselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    const double xHalfSq = x * x * 0.25;
+    for (int k = 1; k < 64 && term > sum * 1.0e-12; ++k)
+    {
+        term *= xHalfSq / static_cast<double>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+static double BilinearFilter(double x)
+{
+    return std::max(0.0, 1.0 - std::abs(x));
+}
+
+// Catmull-Rom spline, i.e. Mitchell-Netravali filter with B = 0 and C = 1/2.
+static double BicubicFilter(double x)
+{
+    x = std::abs(x);
+    if (x < 1.0)
+        return (1.5*x - 2.5)*x*x + 1.0;
+    if (x < 2.0)
+        return ((-0.5*x + 2.5)*x - 4.0)*x + 2.0;
+    return 0.0;
+}
+
+static double KaiserFilter(double x)
+{
+    const double radius = 3.0, alpha = 4.0;
+    if (std::abs(x) >= radius)
+        return 0.0;
+    const double t = x / radius;
+    return Sinc(x) * BesselI0(alpha * std::sqrt(1.0 - t*t)) / BesselI0(alpha);
+}
+
+static double Lanczos3Filter(double x)
+{
+    if (std::abs(x) >= 3.0)
+        return 0.0;
+    return Sinc(x) * Sinc(x / 3.0);
+}
+
+struct ResamplingFilter
+{
+    double  radius;
+    double  (*evaluate)(double x);
+};
+
+static ResamplingFilter GetResamplingFilter(ImageFilter filter)
+{
+    switch (filter)
+    {
+        case ImageFilter::Bilinear: return ResamplingFilter{ 1.0, BilinearFilter };
+        case ImageFilter::Bicubic:  return ResamplingFilter{ 2.0, BicubicFilter  };
+        case ImageFilter::Kaiser:   return ResamplingFilter{ 3.0, KaiserFilter   };
+        case ImageFilter::Lanczos3: return ResamplingFilter{ 3.0, Lanczos3Filter };
+        default:                    return ResamplingFilter{ 0.5, nullptr        };
+    }
+}
+
+
+/* ----- Filter weights ----- */
+
+// Filter weights for each destination index along one axis. Each destination index reads 'numTaps' consecutive source indices.
+struct ResamplingWeights
+{
+    std::uint32_t               numTaps = 0;
+    std::vector<std::uint32_t>  firstTaps;
+    std::vector<float>          weights;
+};
+
+static void ComputeResamplingWeights(ImageFilter filter, std::uint32_t srcSize, std::uint32_t dstSize, ResamplingWeights& outWeights)
+{
+    const ResamplingFilter  resamplingFilter    = GetResamplingFilter(filter);
+    const double            scale               = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+
+    /* Widen the filter for downsampling, so each source pixel contributes to the destination */
+    const double filterScale    = std::max(1.0, scale);
+    const double support        = (resamplingFilter.evaluate != nullptr ? resamplingFilter.radius * filterScale : scale * 0.5);
+
+    outWeights.numTaps = std::min(srcSize, static_cast<std::uint32_t>(std::ceil(support * 2.0)) + 2u);
+    outWeights.firstTaps.resize(dstSize);
+    outWeights.weights.resize(static_cast<std::size_t>(dstSize) * outWeights.numTaps);
+
+    const std::int32_t maxFirstTap = static_cast<std::int32_t>(srcSize - outWeights.numTaps);
+
+    for_range(i, dstSize)
+    {
+        /* Pixel centers are at half-integer coordinates */
+        const double        center  = (static_cast<double>(i) + 0.5) * scale;
+        const std::int32_t  begin   = static_cast<std::int32_t>(std::floor(center - support));
+        const std::int32_t  end     = static_cast<std::int32_t>(std::ceil(center + support));
+
+        const std::int32_t  firstTap    = std::max(0, std::min(begin, maxFirstTap));
+        float*              weights     = &(outWeights.weights[static_cast<std::size_t>(i) * outWeights.numTaps]);
+
+        std::fill(weights, weights + outWeights.numTaps, 0.0f);
+        outWeights.firstTaps[i] = static_cast<std::uint32_t>(firstTap);
+
+        double weightSum = 0.0;
+
+        for (std::int32_t j = begin; j < end; ++j)
+        {
+            double weight = 0.0;
+            if (resamplingFilter.evaluate != nullptr)
+                weight = resamplingFilter.evaluate((static_cast<double>(j) + 0.5 - center) / filterScale);
+            else
+                weight = std::max(0.0, std::min(center + support, j + 1.0) - std::max(center - support, static_cast<double>(j)));
+
+            if (weight != 0.0)
+            {
+                /* Clamp source index to the edges of the image */
+                const std::int32_t tap = std::max(0, std::min(j, static_cast<std::int32_t>(srcSize) - 1)) - firstTap;
+                weights[tap] += static_cast<float>(weight);
+                weightSum += weight;
+            }
+        }
+
+        /* Normalize weights, so the filter preserves the average brightness */
+        if (std::abs(weightSum) > 1.0e-8)
+        {
+            const float invWeightSum = static_cast<float>(1.0 / weightSum);
+            for_range(k, outWeights.numTaps)
+                weights[k] *= invWeightSum;
+        }
+        else
+        {
+            const std::int32_t nearestTap = std::max(0, std::min(static_cast<std::int32_t>(center), static_cast<std::int32_t>(srcSize) - 1));
+            weights[nearestTap - firstTap] = 1.0f;
+        }
+    }
+}
+
+
+/* ----- Span kernels ----- */
+
+// Computes dst[c] = sum(weights[k] * src[k * srcStride + c]) for each component c; 'length' must be a multiple of 4.
+typedef void (*PFN_ResampleSpan)(float* dst, const float* src, std::size_t srcStride, const float* weights, std::uint32_t numTaps, std::size_t length);
+
+static void ResampleSpanScalar(float* dst, const float* src, std::size_t srcStride, const float* weights, std::uint32_t numTaps, std::size_t length)
+{
+    for (std::size_t c = 0; c < length; c += 4)
+    {
+        float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for_range(k, numTaps)
+        {
+            const float* srcPixel = src + k * srcStride + c;
+            sum[0] += weights[k] * srcPixel[0];
+            sum[1] += weights[k] * srcPixel[1];
+            sum[2] += weights[k] * srcPixel[2];
+            sum[3] += weights[k] * srcPixel[3];
+        }
+        dst[c    ] = sum[0];
+        dst[c + 1] = sum[1];
+        dst[c + 2] = sum[2];
+        dst[c + 3] = sum[3];
+    }
+}
+
+#if defined LLGL_IMAGE_RESAMPLER_X86
+
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void ResampleSpanSSE2(float* dst, const float* src, std::size_t srcStride, const float* weights, std::uint32_t numTaps, std::size_t length)
+{
+    std::size_t c = 0;
+    for (; c + 8 <= length; c += 8)
+    {
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+        for_range(k, numTaps)
+        {
+            const __m128 weight = _mm_set1_ps(weights[k]);
+            const float* srcPixels = src + k * srcStride + c;
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(weight, _mm_loadu_ps(srcPixels    )));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(weight, _mm_loadu_ps(srcPixels + 4)));
+        }
+        _mm_storeu_ps(dst + c    , sum0);
+        _mm_storeu_ps(dst + c + 4, sum1);
+    }
+    if (c < length)
+    {
+        __m128 sum = _mm_setzero_ps();
+        for_range(k, numTaps)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(src + k * srcStride + c)));
+        _mm_storeu_ps(dst + c, sum);
+    }
+}
+
+#endif // /LLGL_IMAGE_RESAMPLER_X86
+
+#if defined LLGL_IMAGE_RESAMPLER_NEON
+
+static void ResampleSpanNEON(float* dst, const float* src, std::size_t srcStride, const float* weights, std::uint32_t numTaps, std::size_t length)
+{
+    std::size_t c = 0;
+    for (; c + 8 <= length; c += 8)
+    {
+        float32x4_t sum0 = vdupq_n_f32(0.0f);
+        float32x4_t sum1 = vdupq_n_f32(0.0f);
+        for_range(k, numTaps)
+        {
+            const float* srcPixels = src + k * srcStride + c;
+            sum0 = vmlaq_n_f32(sum0, vld1q_f32(srcPixels    ), weights[k]);
+            sum1 = vmlaq_n_f32(sum1, vld1q_f32(srcPixels + 4), weights[k]);
+        }
+        vst1q_f32(dst + c    , sum0);
+        vst1q_f32(dst + c + 4, sum1);
+    }
+    if (c < length)
+    {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        for_range(k, numTaps)
+            sum = vmlaq_n_f32(sum, vld1q_f32(src + k * srcStride + c), weights[k]);
+        vst1q_f32(dst + c, sum);
+    }
+}
+
+#endif // /LLGL_IMAGE_RESAMPLER_NEON
+
+static PFN_ResampleSpan FindResampleSpanKernel()
+{
+    const long cpuFeatures = GetCPUFeatures();
+
+    #if defined LLGL_IMAGE_RESAMPLER_X86
+    if ((cpuFeatures & CPUFeatureFlags::SSE2) != 0)
+        return ResampleSpanSSE2;
+    #elif defined LLGL_IMAGE_RESAMPLER_NEON
+    if ((cpuFeatures & CPUFeatureFlags::NEON) != 0)
+        return ResampleSpanNEON;
+    #else
+    (void)cpuFeatures;
+    #endif
+
+    return ResampleSpanScalar;
+}
+
+
+/* ----- Resampling passes ----- */
+
+/*
+Resamples the axis of an image whose data is laid out as [outer][axis][inner] floats.
+Each destination span of 'innerLength' floats is a weighted sum of consecutive source spans.
+*/
+static void ResampleAxis(
+    const float*                src,
+    float*                      dst,
+    std::size_t                 numOuter,
+    std::uint32_t               srcSize,
+    std::uint32_t               dstSize,
+    std::size_t                 innerLength,
+    const ResamplingWeights&    weights,
+    unsigned                    threadCount)
+{
+    const PFN_ResampleSpan resampleSpan = FindResampleSpanKernel();
+
+    /* Each thread processes at least 16K multiply-add operations */
+    const std::size_t   costPerSpan         = std::max<std::size_t>(1, innerLength * weights.numTaps);
+    const unsigned      threadMinWorkSize   = static_cast<unsigned>(std::max<std::size_t>(1, 16384 / costPerSpan));
+
+    DoConcurrentRange(
+        [&](std::size_t begin, std::size_t end)
+        {
+            for_subrange(i, begin, end)
+            {
+                const std::size_t   outer       = i / dstSize;
+                const std::size_t   dstIndex    = i % dstSize;
+                const float*        srcSpan     = src + (outer * srcSize + weights.firstTaps[dstIndex]) * innerLength;
+                float*              dstSpan     = dst + (outer * dstSize + dstIndex) * innerLength;
+                resampleSpan(dstSpan, srcSpan, innerLength, &(weights.weights[dstIndex * weights.numTaps]), weights.numTaps, innerLength);
+            }
+        },
+        numOuter * dstSize,
+        threadCount,
+        threadMinWorkSize
+    );
+}
+
+LLGL_EXPORT void ResampleRGBA32Float(
+    ImageFilter     filter,
+    const float*    src,
+    const Extent3D& srcExtent,
+    float*          dst,
+    const Extent3D& dstExtent,
+    unsigned        threadCount)
+{
+    const bool resampleWidth    = (srcExtent.width  != dstExtent.width );
+    const bool resampleHeight   = (srcExtent.height != dstExtent.height);
+    const bool resampleDepth    = (srcExtent.depth  != dstExtent.depth );
+
+    if (!resampleWidth && !resampleHeight && !resampleDepth)
+    {
+        ::memcpy(dst, src, static_cast<std::size_t>(srcExtent.width) * srcExtent.height * srcExtent.depth * sizeof(float) * 4);
+        return;
+    }
+
+    /* Passes write into intermediate buffers except for the last pass, which writes into the destination */
+    std::vector<float>  intermediateBuffers[2];
+    int                 intermediateBufferIndex = 0;
+    const float*        passSrc                 = src;
+
+    auto GetPassOutput = [&](std::size_t size, bool isLastPass) -> float*
+    {
+        if (isLastPass)
+            return dst;
+        std::vector<float>& buffer = intermediateBuffers[intermediateBufferIndex];
+        intermediateBufferIndex = (intermediateBufferIndex + 1) % 2;
+        buffer.resize(size);
+        return buffer.data();
+    };
+
+    ResamplingWeights weights;
+
+    if (resampleWidth)
+    {
+        /* Resample rows: [layers * height][width][RGBA] */
+        const std::size_t numRows = static_cast<std::size_t>(srcExtent.height) * srcExtent.depth;
+        float* passDst = GetPassOutput(numRows * dstExtent.width * 4, !(resampleHeight || resampleDepth));
+        ComputeResamplingWeights(filter, srcExtent.width, dstExtent.width, weights);
+        ResampleAxis(passSrc, passDst, numRows, srcExtent.width, dstExtent.width, 4, weights, threadCount);
+        passSrc = passDst;
+    }
+
+    if (resampleHeight)
+    {
+        /* Resample columns: [layers][height][width * RGBA] */
+        float* passDst = GetPassOutput(static_cast<std::size_t>(srcExtent.depth) * dstExtent.height * dstExtent.width * 4, !resampleDepth);
+        ComputeResamplingWeights(filter, srcExtent.height, dstExtent.height, weights);
+        ResampleAxis(passSrc, passDst, srcExtent.depth, srcExtent.height, dstExtent.height, static_cast<std::size_t>(dstExtent.width) * 4, weights, threadCount);
+        passSrc = passDst;
+    }
+
+    if (resampleDepth)
+    {
+        /* Resample slices: [depth][height * width * RGBA] */
+        ComputeResamplingWeights(filter, srcExtent.depth, dstExtent.depth, weights);
+        ResampleAxis(passSrc, dst, 1, srcExtent.depth, dstExtent.depth, static_cast<std::size_t>(dstExtent.width) * dstExtent.height * 4, weights, threadCount);
+    }
+}
+
+LLGL_EXPORT void ResampleRowsRGBA32Float(
+    ImageFilter                     filter,
+    std::uint32_t                   srcWidth,
+    std::uint32_t                   dstWidth,
+    std::uint32_t                   numRows,
+    const ReadRGBA32FloatRowsFunc&  readRows,
+    float*                          dst,
+    unsigned                        threadCount)
+{
+    const std::uint32_t numBandRows = std::max(1u, 16384u / std::max(srcWidth, dstWidth));
+    const std::size_t   numBands    = (numRows + numBandRows - 1) / numBandRows;
+
+    if (srcWidth == dstWidth)
+    {
+        /* Read rows directly into the destination */
+        DoConcurrentRange(
+            [&](std::size_t begin, std::size_t end)
+            {
+                for_subrange(band, begin, end)
+                {
+                    const std::uint32_t firstRow = static_cast<std::uint32_t>(band) * numBandRows;
+                    readRows(firstRow, std::min(numBandRows, numRows - firstRow), dst + static_cast<std::size_t>(firstRow) * dstWidth * 4);
+                }
+            },
+            numBands,
+            threadCount,
+            1
+        );
+        return;
+    }
+
+    ResamplingWeights weights;
+    ComputeResamplingWeights(filter, srcWidth, dstWidth, weights);
+
+    const PFN_ResampleSpan resampleSpan = FindResampleSpanKernel();
+
+    DoConcurrentRange(
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<float> bandPixels(static_cast<std::size_t>(numBandRows) * srcWidth * 4);
+            for_subrange(band, begin, end)
+            {
+                const std::uint32_t firstRow    = static_cast<std::uint32_t>(band) * numBandRows;
+                const std::uint32_t numRowsRead = std::min(numBandRows, numRows - firstRow);
+
+                readRows(firstRow, numRowsRead, bandPixels.data());
+
+                for_range(row, numRowsRead)
+                {
+                    const float*    srcRow = bandPixels.data() + static_cast<std::size_t>(row) * srcWidth * 4;
+                    float*          dstRow = dst + (static_cast<std::size_t>(firstRow) + row) * dstWidth * 4;
+                    for_range(x, dstWidth)
+                        resampleSpan(dstRow + x * 4, srcRow + weights.firstTaps[x] * 4, 4, &(weights.weights[x * weights.numTaps]), weights.numTaps, 4);
+                }
+            }
+        },
+        numBands,
+        threadCount,
+        1
+    );
+}
+
+
+/* ----- Color space and alpha coverage ----- */
+
+static float SRGBToLinear(float value)
+{
+    if (value <= 0.04045f)
+        return value / 12.92f;
+    else
+        return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float LinearToSRGB(float value)
+{
+    if (value <= 0.0031308f)
+        return std::max(0.0f, value * 12.92f);
+    else
+        return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+template <float (*Convert)(float)>
+void ConvertRGBA32FloatColorSpace(float* pixels, std::size_t numPixels, unsigned threadCount)
+{
+    DoConcurrentRange(
+        [pixels](std::size_t begin, std::size_t end)
+        {
+            for_subrange(i, begin, end)
+            {
+                float* pixel = pixels + i * 4;
+                pixel[0] = Convert(pixel[0]);
+                pixel[1] = Convert(pixel[1]);
+                pixel[2] = Convert(pixel[2]);
+            }
+        },
+        numPixels,
+        threadCount,
+        4096
+    );
+}
+
+LLGL_EXPORT void ConvertRGBA32FloatSRGBToLinear(float* pixels, std::size_t numPixels, unsigned threadCount)
+{
+    ConvertRGBA32FloatColorSpace<SRGBToLinear>(pixels, numPixels, threadCount);
+}
+
+LLGL_EXPORT void ConvertRGBA32FloatLinearToSRGB(float* pixels, std::size_t numPixels, unsigned threadCount)
+{
+    ConvertRGBA32FloatColorSpace<LinearToSRGB>(pixels, numPixels, threadCount);
+}
+
+LLGL_EXPORT float ComputeAlphaCoverage(const float* pixels, std::size_t numPixels, float alphaReference, float alphaScale)
+{
+    if (numPixels == 0)
+        return 0.0f;
+
+    std::size_t numCoveredPixels = 0;
+    for_range(i, numPixels)
+    {
+        if (pixels[i * 4 + 3] * alphaScale > alphaReference)
+            ++numCoveredPixels;
+    }
+
+    return static_cast<float>(numCoveredPixels) / static_cast<float>(numPixels);
+}
+
+LLGL_EXPORT void ScaleAlphaToCoverage(float* pixels, std::size_t numPixels, float alphaReference, float coverage)
+{
+    /* Binary search for the alpha scale whose coverage is closest to the specified coverage */
+    float minScale = 0.0f, maxScale = 4.0f, bestScale = 1.0f;
+    float bestError = std::abs(ComputeAlphaCoverage(pixels, numPixels, alphaReference) - coverage);
+
+    for (int i = 0; i < 16 && bestError > 0.0f; ++i)
+    {
+        const float scale           = (minScale + maxScale) * 0.5f;
+        const float currentCoverage = ComputeAlphaCoverage(pixels, numPixels, alphaReference, scale);
+        const float error           = std::abs(currentCoverage - coverage);
+
+        if (error < bestError)
+        {
+            bestScale = scale;
+            bestError = error;
+        }
+
+        if (currentCoverage < coverage)
+            minScale = scale;
+        else
+            maxScale = scale;
+    }
+
+    if (bestScale != 1.0f)
+    {
+        for_range(i, numPixels)
+            pixels[i * 4 + 3] = std::min(1.0f, pixels[i * 4 + 3] * bestScale);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
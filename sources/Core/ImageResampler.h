@@ -0,0 +1,83 @@
+/*
+ * ImageResampler.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_IMAGE_RESAMPLER_H
+#define LLGL_IMAGE_RESAMPLER_H
+
+
+#include <LLGL/Export.h>
+#include <LLGL/Types.h>
+#include <LLGL/ImageFlags.h>
+#include <functional>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Types ----- */
+
+// Callback to read the specified range of rows as tightly packed RGBA32Float pixels into the destination buffer.
+typedef std::function<void(std::uint32_t firstRow, std::uint32_t numRows, float* dst)> ReadRGBA32FloatRowsFunc;
+
+
+/* ----- Functions ----- */
+
+/*
+Resamples an image with RGBA32Float pixels from the source extent to the destination extent with separable filter passes.
+The filter weights are precomputed for each destination row and column, and rows are distributed over the specified number of threads.
+If source and destination have the same depth, each depth slice is resampled independently, e.g. for array layers.
+*/
+LLGL_EXPORT void ResampleRGBA32Float(
+    ImageFilter     filter,
+    const float*    src,
+    const Extent3D& srcExtent,
+    float*          dst,
+    const Extent3D& dstExtent,
+    unsigned        threadCount = 0
+);
+
+/*
+Resamples rows of RGBA32Float pixels horizontally from the source width to the destination width, and writes them tightly packed into the destination.
+The source rows are read in bands of ~256 KB by the specified callback into a temporary buffer, e.g. to convert them from another format on demand,
+so each band is resampled while it is still in the cache. The filter weights are computed once and the bands are distributed over the specified number of threads.
+*/
+LLGL_EXPORT void ResampleRowsRGBA32Float(
+    ImageFilter                     filter,
+    std::uint32_t                   srcWidth,
+    std::uint32_t                   dstWidth,
+    std::uint32_t                   numRows,
+    const ReadRGBA32FloatRowsFunc&  readRows,
+    float*                          dst,
+    unsigned                        threadCount = 0
+);
+
+// Converts the RGB components of the specified RGBA32Float pixels from non-linear sRGB to linear color space.
+LLGL_EXPORT void ConvertRGBA32FloatSRGBToLinear(float* pixels, std::size_t numPixels, unsigned threadCount = 0);
+
+// Converts the RGB components of the specified RGBA32Float pixels from linear to non-linear sRGB color space.
+LLGL_EXPORT void ConvertRGBA32FloatLinearToSRGB(float* pixels, std::size_t numPixels, unsigned threadCount = 0);
+
+// Returns the fraction of the specified RGBA32Float pixels whose alpha component multiplied by 'alphaScale' is greater than the reference value.
+LLGL_EXPORT float ComputeAlphaCoverage(const float* pixels, std::size_t numPixels, float alphaReference, float alphaScale = 1.0f);
+
+/*
+Scales the alpha component of the specified RGBA32Float pixels, so their alpha coverage matches the specified coverage.
+This is used to preserve the alpha-tested coverage of MIP-maps, e.g. for foliage textures.
+*/
+LLGL_EXPORT void ScaleAlphaToCoverage(float* pixels, std::size_t numPixels, float alphaReference, float coverage);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,10 +7,13 @@
 
 #include "ImageUtils.h"
 #include "Assertion.h"
+#include "Threading.h"
 #include <LLGL/Types.h>
 #include <LLGL/Utils/ForRange.h>
 #include <cstdint>
 #include <algorithm>
+#include <functional>
+#include <vector>
 #include <string.h>
 
 
@@ -18,6 +21,52 @@ namespace LLGL
 {
 
 
+// Returns the number of bytes between the first and the last byte of an image region.
+static std::size_t GetBitBlitRegionSpan(const Extent3D& extent, std::uint32_t rowLength, std::uint32_t rowStride, std::uint32_t layerStride)
+{
+    return
+    (
+        static_cast<std::size_t>(extent.depth  - 1) * layerStride +
+        static_cast<std::size_t>(extent.height - 1) * rowStride   +
+        rowLength
+    );
+}
+
+// Copies an image region where source and destination overlap within the same image buffer. Strides must be equal.
+static void BitBlitOverlapped(
+    const Extent3D& extent,
+    std::uint32_t   rowLength,
+    char*           dst,
+    const char*     src,
+    std::uint32_t   rowStride,
+    std::uint32_t   layerStride)
+{
+    if (dst > src)
+    {
+        /* Copy rows backwards to not overwrite source rows before they have been read */
+        for (std::uint32_t z = extent.depth; z-- > 0;)
+        {
+            for (std::uint32_t y = extent.height; y-- > 0;)
+            {
+                const std::size_t offset = static_cast<std::size_t>(z) * layerStride + static_cast<std::size_t>(y) * rowStride;
+                ::memmove(dst + offset, src + offset, rowLength);
+            }
+        }
+    }
+    else if (dst < src)
+    {
+        /* Copy rows forwards */
+        for_range(z, extent.depth)
+        {
+            for_range(y, extent.height)
+            {
+                const std::size_t offset = static_cast<std::size_t>(z) * layerStride + static_cast<std::size_t>(y) * rowStride;
+                ::memmove(dst + offset, src + offset, rowLength);
+            }
+        }
+    }
+}
+
 LLGL_EXPORT void BitBlit(
     const Extent3D& extent,
     std::uint32_t   bpp,
@@ -50,6 +99,23 @@ LLGL_EXPORT void BitBlit(
     dstLayerStride = std::max(dstLayerLength, std::max(dstLayerStride, layerLength));
     srcLayerStride = std::max(srcLayerLength, std::max(srcLayerStride, layerLength));
 
+    if (rowLength == 0 || extent.height == 0 || extent.depth == 0)
+        return;
+
+    /* Check if source and destination overlap within the same image buffer */
+    const std::size_t dstSpan = GetBitBlitRegionSpan(extent, rowLength, dstRowStride, dstLayerStride);
+    const std::size_t srcSpan = GetBitBlitRegionSpan(extent, rowLength, srcRowStride, srcLayerStride);
+
+    if (dst < src + srcSpan && src < dst + dstSpan)
+    {
+        LLGL_ASSERT(
+            dstRowStride == srcRowStride && dstLayerStride == srcLayerStride,
+            "overlapping source and destination regions must have equal strides"
+        );
+        BitBlitOverlapped(extent, rowLength, dst, src, dstRowStride, dstLayerStride);
+        return;
+    }
+
     if (srcRowStride == dstRowStride && rowLength == dstRowStride)
     {
         if (srcLayerStride == dstLayerStride && layerLength == dstLayerStride)
@@ -98,6 +164,160 @@ LLGL_EXPORT void BitBlit(
     }
 }
 
+// Number of bytes each band of rows should cover when regions are distributed over multiple threads.
+static constexpr std::uint32_t g_bitBlitBandSize = 64 * 1024;
+
+static bool CanMergeBitBlitRegions(const BitBlitRegion& lhs, const BitBlitRegion& rhs, std::uint32_t bpp)
+{
+    const std::uint32_t rowLength = lhs.extent.width * bpp;
+    return
+    (
+        rhs.dst             == lhs.dst + rowLength      &&
+        rhs.src             == lhs.src + rowLength      &&
+        rhs.dstRowStride    == lhs.dstRowStride         &&
+        rhs.dstLayerStride  == lhs.dstLayerStride       &&
+        rhs.srcRowStride    == lhs.srcRowStride         &&
+        rhs.srcLayerStride  == lhs.srcLayerStride       &&
+        rhs.extent.height   == lhs.extent.height        &&
+        rhs.extent.depth    == lhs.extent.depth
+    );
+}
+
+// Sorts the regions by destination address, merges horizontally adjacent regions, and returns the new number of regions.
+static std::size_t CoalesceBitBlitRegions(BitBlitRegion* regions, std::size_t numRegions, std::uint32_t bpp)
+{
+    /* Clamp strides to tightly packed lengths, so adjacent regions can be compared by their strides */
+    std::size_t numNonEmptyRegions = 0;
+
+    for_range(i, numRegions)
+    {
+        BitBlitRegion& region = regions[i];
+        if (region.extent.width == 0 || region.extent.height == 0 || region.extent.depth == 0)
+            continue;
+
+        const std::uint32_t rowLength = region.extent.width * bpp;
+        region.dstRowStride     = std::max(region.dstRowStride, rowLength);
+        region.srcRowStride     = std::max(region.srcRowStride, rowLength);
+        region.dstLayerStride   = std::max(region.dstLayerStride, region.dstRowStride * region.extent.height);
+        region.srcLayerStride   = std::max(region.srcLayerStride, region.srcRowStride * region.extent.height);
+
+        regions[numNonEmptyRegions++] = region;
+    }
+
+    if (numNonEmptyRegions == 0)
+        return 0;
+
+    /* Sort regions by destination, so the destination buffer is written in order; regions of packed atlases are usually sorted already */
+    auto CompareDestinations = [](const BitBlitRegion& lhs, const BitBlitRegion& rhs) -> bool
+    {
+        return std::less<const char*>()(lhs.dst, rhs.dst);
+    };
+
+    if (!std::is_sorted(regions, regions + numNonEmptyRegions, CompareDestinations))
+        std::sort(regions, regions + numNonEmptyRegions, CompareDestinations);
+
+    /* Merge regions that continue their predecessor in both source and destination */
+    std::size_t numMergedRegions = 1;
+
+    for_subrange(i, 1, numNonEmptyRegions)
+    {
+        BitBlitRegion& prevRegion = regions[numMergedRegions - 1];
+        if (CanMergeBitBlitRegions(prevRegion, regions[i], bpp))
+            prevRegion.extent.width += regions[i].extent.width;
+        else
+            regions[numMergedRegions++] = regions[i];
+    }
+
+    return numMergedRegions;
+}
+
+// Band of rows within a single layer of a region.
+struct BitBlitBand
+{
+    std::uint32_t regionIndex;
+    std::uint32_t layer;
+    std::uint32_t rowBegin;
+    std::uint32_t rowEnd;
+};
+
+LLGL_EXPORT void BitBlitRegions(
+    BitBlitRegion*  regions,
+    std::size_t     numRegions,
+    std::uint32_t   bpp,
+    unsigned        threadCount)
+{
+    numRegions = CoalesceBitBlitRegions(regions, numRegions, bpp);
+
+    /* Split regions into bands of rows */
+    std::vector<BitBlitBand> bands;
+
+    if (threadCount > 1)
+    {
+        for_range(i, numRegions)
+        {
+            const BitBlitRegion& region = regions[i];
+            const std::uint32_t rowLength   = region.extent.width * bpp;
+            const std::uint32_t bandHeight  = std::max(1u, g_bitBlitBandSize / rowLength);
+
+            for_range(z, region.extent.depth)
+            {
+                for (std::uint32_t y = 0; y < region.extent.height; y += bandHeight)
+                    bands.push_back(BitBlitBand{ static_cast<std::uint32_t>(i), z, y, std::min(y + bandHeight, region.extent.height) });
+            }
+        }
+    }
+
+    if (bands.size() > 1)
+    {
+        /* Copy bands concurrently; each thread requires at least four bands */
+        DoConcurrentRange(
+            [regions, bpp, &bands](std::size_t begin, std::size_t end)
+            {
+                for_subrange(i, begin, end)
+                {
+                    const BitBlitBand&      band    = bands[i];
+                    const BitBlitRegion&    region  = regions[band.regionIndex];
+
+                    const std::size_t dstOffset = static_cast<std::size_t>(band.layer) * region.dstLayerStride + static_cast<std::size_t>(band.rowBegin) * region.dstRowStride;
+                    const std::size_t srcOffset = static_cast<std::size_t>(band.layer) * region.srcLayerStride + static_cast<std::size_t>(band.rowBegin) * region.srcRowStride;
+
+                    BitBlit(
+                        Extent3D{ region.extent.width, band.rowEnd - band.rowBegin, 1 },
+                        bpp,
+                        region.dst + dstOffset,
+                        region.dstRowStride,
+                        0,
+                        region.src + srcOffset,
+                        region.srcRowStride,
+                        0
+                    );
+                }
+            },
+            bands.size(),
+            threadCount,
+            4
+        );
+    }
+    else
+    {
+        /* Copy regions on the calling thread */
+        for_range(i, numRegions)
+        {
+            const BitBlitRegion& region = regions[i];
+            BitBlit(
+                region.extent,
+                bpp,
+                region.dst,
+                region.dstRowStride,
+                region.dstLayerStride,
+                region.src,
+                region.srcRowStride,
+                region.srcLayerStride
+            );
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -10,18 +10,37 @@
 
 
 #include <LLGL/Export.h>
+#include <LLGL/Types.h>
 #include <cstdint>
+#include <cstddef>
+#include <limits>
 
 
 namespace LLGL
 {
 
 
-struct Extent3D;
+/* ----- Structures ----- */
+
+// Region for BitBlitRegions(). Strides are specified in bytes.
+struct BitBlitRegion
+{
+    char*           dst             = nullptr;
+    std::uint32_t   dstRowStride    = 0;
+    std::uint32_t   dstLayerStride  = 0;
+    const char*     src             = nullptr;
+    std::uint32_t   srcRowStride    = 0;
+    std::uint32_t   srcLayerStride  = 0;
+    Extent3D        extent;
+};
+
 
 /* ----- Functions ----- */
 
-// Copies the specified extent from the source image to the destination image buffer.
+/*
+Copies the specified extent from the source image to the destination image buffer.
+Source and destination may overlap if they refer to the same image buffer with equal strides.
+*/
 LLGL_EXPORT void BitBlit(
     const Extent3D& extent,
     std::uint32_t   bpp,
@@ -33,6 +52,37 @@ LLGL_EXPORT void BitBlit(
     std::uint32_t   srcLayerStride
 );
 
+/*
+Copies all specified regions with the same number of bytes per pixel.
+Regions are sorted by destination address and horizontally adjacent regions are merged to copy their rows with a single memcpy.
+Large workloads are split into bands of rows that are distributed over the specified number of threads.
+The destination regions must not overlap with each other or with the source regions. The input array is modified.
+*/
+LLGL_EXPORT void BitBlitRegions(
+    BitBlitRegion*  regions,
+    std::size_t     numRegions,
+    std::uint32_t   bpp,
+    unsigned        threadCount = 0
+);
+
+// Reads the specified source variant and returns it to the normalized range [0, 1].
+template <typename T>
+double ReadNormalizedVariant(const T& src)
+{
+    constexpr double min = static_cast<double>(std::numeric_limits<T>::min());
+    constexpr double max = static_cast<double>(std::numeric_limits<T>::max());
+    return (static_cast<double>(src) - min) / (max - min);
+}
+
+// Writes the specified value from the range [0, 1] to the destination variant.
+template <typename T>
+void WriteNormalizedVariant(T& dst, double value)
+{
+    constexpr double min = static_cast<double>(std::numeric_limits<T>::min());
+    constexpr double max = static_cast<double>(std::numeric_limits<T>::max());
+    dst = static_cast<T>(value * (max - min) + min);
+}
+
 
 } // /namespace LLGL
 
@@ -0,0 +1,228 @@
+/*
+ * TaskScheduler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/Utils/TaskScheduler.h>
+#include "Threading.h"
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <utility>
+
+
+namespace LLGL
+{
+
+
+/*
+Shared state of a scheduled task. This is reference counted by all task handles, by each task it is a continuation of, and while it is enqueued.
+The number of pending dependencies is initialized with 1 to prevent the task from being enqueued before all dependencies have been registered.
+*/
+struct TaskHandle::Pimpl
+{
+    std::atomic<unsigned>   refCount                { 1 };
+    std::function<void()>   task;
+    std::atomic<unsigned>   numPendingDependencies  { 1 };
+    std::mutex              mutex;
+    std::vector<Pimpl*>     continuations;
+    std::atomic<bool>       completed               { false };
+};
+
+// Internal functions for the shared state of task handles.
+struct TaskSchedulerFriend
+{
+    using Pimpl = TaskHandle::Pimpl;
+
+    static TaskHandle MakeHandle(Pimpl* pimpl)
+    {
+        return TaskHandle{ pimpl };
+    }
+
+    static Pimpl* GetPimpl(const TaskHandle& handle)
+    {
+        return handle.pimpl_;
+    }
+
+    static void AddRef(Pimpl* pimpl)
+    {
+        ++pimpl->refCount;
+    }
+
+    static void Release(Pimpl* pimpl)
+    {
+        if (--pimpl->refCount == 0)
+            delete pimpl;
+    }
+
+    static void Execute(Pimpl* pimpl)
+    {
+        pimpl->task();
+        pimpl->task = nullptr;
+
+        /* Mark task as completed and take continuations, so no more continuations can be registered */
+        std::vector<Pimpl*> continuations;
+        {
+            std::lock_guard<std::mutex> guard{ pimpl->mutex };
+            pimpl->completed = true;
+            continuations.swap(pimpl->continuations);
+        }
+
+        NotifyConcurrentConditionChanged();
+
+        for (Pimpl* continuation : continuations)
+        {
+            ReleaseDependency(continuation);
+            Release(continuation);
+        }
+
+        /* Release reference that was held while the task was enqueued */
+        Release(pimpl);
+    }
+
+    // Decrements the number of pending dependencies and enqueues the task once there are no more dependencies left.
+    static void ReleaseDependency(Pimpl* pimpl)
+    {
+        if (--pimpl->numPendingDependencies == 0)
+        {
+            AddRef(pimpl);
+            EnqueueConcurrentTask([pimpl]() { Execute(pimpl); });
+        }
+    }
+
+    // Registers the continuation task with the specified dependency unless the dependency has already completed.
+    static void RegisterContinuation(Pimpl* dependency, Pimpl* continuation)
+    {
+        std::lock_guard<std::mutex> guard{ dependency->mutex };
+        if (!dependency->completed)
+        {
+            ++continuation->numPendingDependencies;
+            AddRef(continuation);
+            dependency->continuations.push_back(continuation);
+        }
+    }
+};
+
+
+/* ----- TaskHandle class ----- */
+
+TaskHandle::TaskHandle(Pimpl* pimpl) :
+    pimpl_ { pimpl }
+{
+}
+
+TaskHandle::TaskHandle(const TaskHandle& rhs) :
+    pimpl_ { rhs.pimpl_ }
+{
+    if (pimpl_ != nullptr)
+        TaskSchedulerFriend::AddRef(pimpl_);
+}
+
+TaskHandle::TaskHandle(TaskHandle&& rhs) noexcept :
+    pimpl_ { rhs.pimpl_ }
+{
+    rhs.pimpl_ = nullptr;
+}
+
+TaskHandle& TaskHandle::operator = (const TaskHandle& rhs)
+{
+    if (pimpl_ != rhs.pimpl_)
+    {
+        if (rhs.pimpl_ != nullptr)
+            TaskSchedulerFriend::AddRef(rhs.pimpl_);
+        if (pimpl_ != nullptr)
+            TaskSchedulerFriend::Release(pimpl_);
+        pimpl_ = rhs.pimpl_;
+    }
+    return *this;
+}
+
+TaskHandle& TaskHandle::operator = (TaskHandle&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        if (pimpl_ != nullptr)
+            TaskSchedulerFriend::Release(pimpl_);
+        pimpl_ = rhs.pimpl_;
+        rhs.pimpl_ = nullptr;
+    }
+    return *this;
+}
+
+TaskHandle::~TaskHandle()
+{
+    if (pimpl_ != nullptr)
+        TaskSchedulerFriend::Release(pimpl_);
+}
+
+bool TaskHandle::IsValid() const
+{
+    return (pimpl_ != nullptr);
+}
+
+bool TaskHandle::IsCompleted() const
+{
+    return (pimpl_ == nullptr || pimpl_->completed);
+}
+
+void TaskHandle::Wait() const
+{
+    if (!IsCompleted())
+        WaitForConcurrentCondition([this]() { return IsCompleted(); });
+}
+
+TaskHandle TaskHandle::Then(const std::function<void()>& task) const
+{
+    return TaskScheduler::Schedule(task, { *this });
+}
+
+
+/* ----- TaskScheduler namespace ----- */
+
+namespace TaskScheduler
+{
+
+
+LLGL_EXPORT TaskHandle Schedule(const std::function<void()>& task, const ArrayView<TaskHandle>& dependencies)
+{
+    auto* pimpl = new TaskSchedulerFriend::Pimpl{};
+    pimpl->task = task;
+
+    for (const TaskHandle& dependency : dependencies)
+    {
+        if (TaskSchedulerFriend::Pimpl* dependencyPimpl = TaskSchedulerFriend::GetPimpl(dependency))
+            TaskSchedulerFriend::RegisterContinuation(dependencyPimpl, pimpl);
+    }
+
+    /* Construct handle before the task might be executed and released */
+    TaskHandle handle = TaskSchedulerFriend::MakeHandle(pimpl);
+    TaskSchedulerFriend::ReleaseDependency(pimpl);
+    return handle;
+}
+
+LLGL_EXPORT void WaitAll(const ArrayView<TaskHandle>& tasks)
+{
+    WaitForConcurrentCondition(
+        [&tasks]() -> bool
+        {
+            for (const TaskHandle& task : tasks)
+            {
+                if (!task.IsCompleted())
+                    return false;
+            }
+            return true;
+        }
+    );
+}
+
+
+} // /namespace TaskScheduler
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
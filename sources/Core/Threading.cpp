@@ -6,9 +6,15 @@
  */
 
 #include "Threading.h"
+#include <LLGL/ThreadPool.h>
 #include <LLGL/Utils/ForRange.h>
 #include <thread>
 #include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <algorithm>
 
 
@@ -16,6 +22,291 @@ namespace LLGL
 {
 
 
+/* ----- Worker thread pool ----- */
+
+/*
+Pool of persistent worker threads with work-stealing task queues.
+Each worker pushes and pops its own tasks at the back of its queue (LIFO) for cache locality,
+while idle workers steal tasks from the front of other queues (FIFO). Tasks from other threads are enqueued into a shared queue.
+*/
+class WorkerThreadPool
+{
+
+    public:
+
+        WorkerThreadPool(const WorkerThreadPool&) = delete;
+        WorkerThreadPool& operator = (const WorkerThreadPool&) = delete;
+
+        explicit WorkerThreadPool(unsigned workerCount) :
+            workerQueues_ { new TaskQueue[workerCount] }
+        {
+            workers_.reserve(workerCount);
+            for_range(i, workerCount)
+                workers_.emplace_back(&WorkerThreadPool::WorkerThreadProc, this, i);
+        }
+
+        // Waits for all pending tasks to complete and joins the worker threads.
+        ~WorkerThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> guard{ wakeUpMutex_ };
+                stop_ = true;
+            }
+            workerWakeUp_.notify_all();
+            for (std::thread& worker : workers_)
+                worker.join();
+        }
+
+        void Enqueue(const std::function<void()>& task)
+        {
+            TaskQueue& queue = (t_workerPool == this ? workerQueues_[t_workerIndex] : sharedQueue_);
+            {
+                std::lock_guard<std::mutex> guard{ queue.mutex };
+                queue.tasks.push_back(task);
+            }
+            ++numPendingTasks_;
+            {
+                std::lock_guard<std::mutex> guard{ wakeUpMutex_ };
+            }
+            workerWakeUp_.notify_one();
+            if (numWaiters_ > 0)
+                waiterWakeUp_.notify_all();
+        }
+
+        // Executes one pending task on the calling thread. Returns false if there was no pending task.
+        bool ExecutePendingTask()
+        {
+            std::function<void()> task;
+            if (PopTask(task))
+            {
+                task();
+                return true;
+            }
+            return false;
+        }
+
+        // Executes pending tasks on the calling thread until the specified condition is met.
+        void WaitUntil(const std::function<bool()>& condition)
+        {
+            while (!condition())
+            {
+                if (ExecutePendingTask())
+                    continue;
+
+                std::unique_lock<std::mutex> lock{ wakeUpMutex_ };
+                ++numWaiters_;
+                waiterWakeUp_.wait(lock, [this, &condition]() { return (numPendingTasks_ > 0 || condition()); });
+                --numWaiters_;
+            }
+        }
+
+        // Wakes up all threads in WaitUntil() to re-evaluate their condition.
+        void NotifyWaiters()
+        {
+            if (numWaiters_ > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> guard{ wakeUpMutex_ };
+                }
+                waiterWakeUp_.notify_all();
+            }
+        }
+
+        unsigned GetWorkerCount() const
+        {
+            return static_cast<unsigned>(workers_.size());
+        }
+
+        // Returns the thread pool the calling thread is a worker of, or null if the calling thread is not a worker thread.
+        static WorkerThreadPool* GetCurrentThreadPool()
+        {
+            return t_workerPool;
+        }
+
+    private:
+
+        struct TaskQueue
+        {
+            std::mutex                          mutex;
+            std::deque<std::function<void()>>   tasks;
+        };
+
+    private:
+
+        static bool PopTaskFromBack(TaskQueue& queue, std::function<void()>& outTask)
+        {
+            std::lock_guard<std::mutex> guard{ queue.mutex };
+            if (queue.tasks.empty())
+                return false;
+            outTask = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            return true;
+        }
+
+        static bool PopTaskFromFront(TaskQueue& queue, std::function<void()>& outTask)
+        {
+            std::lock_guard<std::mutex> guard{ queue.mutex };
+            if (queue.tasks.empty())
+                return false;
+            outTask = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+
+        // Pops the next task from the worker's own queue, the shared queue, or steals it from another worker's queue.
+        bool PopTask(std::function<void()>& outTask)
+        {
+            if (numPendingTasks_ == 0)
+                return false;
+
+            const unsigned workerCount  = GetWorkerCount();
+            const bool     isWorker     = (t_workerPool == this);
+            const unsigned workerIndex  = (isWorker ? t_workerIndex : 0);
+
+            bool hasTask = (isWorker && PopTaskFromBack(workerQueues_[workerIndex], outTask));
+
+            if (!hasTask)
+                hasTask = PopTaskFromFront(sharedQueue_, outTask);
+
+            for (unsigned i = 0; i < workerCount && !hasTask; ++i)
+            {
+                const unsigned victimIndex = (workerIndex + i + 1) % workerCount;
+                if (!(isWorker && victimIndex == workerIndex))
+                    hasTask = PopTaskFromFront(workerQueues_[victimIndex], outTask);
+            }
+
+            if (hasTask)
+                --numPendingTasks_;
+
+            return hasTask;
+        }
+
+        void WorkerThreadProc(unsigned workerIndex)
+        {
+            t_workerPool    = this;
+            t_workerIndex   = workerIndex;
+
+            for (;;)
+            {
+                if (ExecutePendingTask())
+                    continue;
+
+                std::unique_lock<std::mutex> lock{ wakeUpMutex_ };
+                workerWakeUp_.wait(lock, [this]() { return (stop_ || numPendingTasks_ > 0); });
+                if (stop_ && numPendingTasks_ == 0)
+                    break;
+            }
+
+            t_workerPool = nullptr;
+        }
+
+    private:
+
+        static thread_local WorkerThreadPool*   t_workerPool;
+        static thread_local unsigned            t_workerIndex;
+
+        std::vector<std::thread>                workers_;
+        std::unique_ptr<TaskQueue[]>            workerQueues_;
+        TaskQueue                               sharedQueue_;
+        std::atomic<std::size_t>                numPendingTasks_    { 0 };
+        std::atomic<unsigned>                   numWaiters_         { 0 };
+        std::mutex                              wakeUpMutex_;
+        std::condition_variable                 workerWakeUp_;
+        std::condition_variable                 waiterWakeUp_;
+        bool                                    stop_               = false;
+
+};
+
+thread_local WorkerThreadPool*  WorkerThreadPool::t_workerPool  = nullptr;
+thread_local unsigned           WorkerThreadPool::t_workerIndex = 0;
+
+static std::mutex                           g_threadPoolMutex;
+static std::unique_ptr<WorkerThreadPool>    g_threadPool;
+static unsigned                             g_threadPoolWorkerCount = LLGL_MAX_THREAD_COUNT;
+
+static unsigned ResolveThreadPoolWorkerCount(unsigned workerCount)
+{
+    if (workerCount == LLGL_MAX_THREAD_COUNT)
+        return std::max(1u, std::thread::hardware_concurrency());
+    else
+        return workerCount;
+}
+
+// Returns the process-wide thread pool and creates it on first use, or null if the thread pool is disabled.
+static WorkerThreadPool* GetOrCreateThreadPool()
+{
+    std::lock_guard<std::mutex> guard{ g_threadPoolMutex };
+    if (!g_threadPool)
+    {
+        const unsigned workerCount = ResolveThreadPoolWorkerCount(g_threadPoolWorkerCount);
+        if (workerCount == 0)
+            return nullptr;
+        g_threadPool = std::unique_ptr<WorkerThreadPool>(new WorkerThreadPool{ workerCount });
+    }
+    return g_threadPool.get();
+}
+
+// Shared state of a range of work that is split into chunks. This is shared with the worker threads that may start after the range has been completed.
+struct ConcurrentRangeJob
+{
+    const std::function<void(std::size_t begin, std::size_t end)>*  task                = nullptr;
+    std::size_t                                                     count               = 0;
+    std::size_t                                                     numChunks           = 0;
+    std::atomic<std::size_t>                                        nextChunk;
+    std::atomic<std::size_t>                                        numChunksCompleted;
+};
+
+// Processes chunks of the specified job until there are no more chunks left.
+static void RunConcurrentRangeJobChunks(WorkerThreadPool& threadPool, ConcurrentRangeJob& job)
+{
+    std::size_t numChunksProcessed = 0;
+
+    for (std::size_t chunk = job.nextChunk++; chunk < job.numChunks; chunk = job.nextChunk++)
+    {
+        const std::size_t begin = chunk * job.count / job.numChunks;
+        const std::size_t end   = (chunk + 1) * job.count / job.numChunks;
+        (*job.task)(begin, end);
+        ++numChunksProcessed;
+    }
+
+    if (numChunksProcessed > 0 && (job.numChunksCompleted += numChunksProcessed) == job.numChunks)
+        threadPool.NotifyWaiters();
+}
+
+/*
+Distributes the range into chunks that are processed by the worker threads of the pool and the calling thread.
+While chunks are still in progress, the calling thread executes other pending tasks, so this can be called from within a pool task.
+*/
+static void DoConcurrentRangeInThreadPool(
+    WorkerThreadPool&                                               threadPool,
+    const std::function<void(std::size_t begin, std::size_t end)>&  task,
+    std::size_t                                                     count,
+    unsigned                                                        threadCount)
+{
+    auto job = std::make_shared<ConcurrentRangeJob>();
+    {
+        job->task               = &task;
+        job->count              = count;
+        job->numChunks          = threadCount;
+        job->nextChunk          = 0;
+        job->numChunksCompleted = 0;
+    }
+
+    /* Enqueue helper tasks for all chunks except the one the calling thread will process */
+    WorkerThreadPool* threadPoolRef = &threadPool;
+    const unsigned numHelpers = std::min(threadCount - 1, threadPool.GetWorkerCount());
+    for_range(i, numHelpers)
+        threadPool.Enqueue([threadPoolRef, job]() { RunConcurrentRangeJobChunks(*threadPoolRef, *job); });
+
+    RunConcurrentRangeJobChunks(threadPool, *job);
+
+    /* Wait for chunks that are still processed by worker threads */
+    threadPool.WaitUntil([&job]() { return (job->numChunksCompleted == job->numChunks); });
+}
+
+
+/* ----- Concurrent range functions ----- */
+
 static constexpr unsigned g_maxThreadCountStaticArray = 64;
 
 static void DoConcurrentRangeInWorkerContainer(
@@ -90,6 +381,11 @@ LLGL_EXPORT void DoConcurrentRange(
         /* Run single-threaded */
         task(0, count);
     }
+    else if (WorkerThreadPool* threadPool = GetOrCreateThreadPool())
+    {
+        /* Dispatch work onto persistent worker threads */
+        DoConcurrentRangeInThreadPool(*threadPool, task, count, threadCount);
+    }
     else if (threadCount <= g_maxThreadCountStaticArray)
     {
         /* Launch worker threads in static array */
@@ -123,6 +419,84 @@ LLGL_EXPORT void DoConcurrent(
 }
 
 
+
+LLGL_EXPORT void EnqueueConcurrentTask(const std::function<void()>& task)
+{
+    if (WorkerThreadPool* threadPool = GetOrCreateThreadPool())
+        threadPool->Enqueue(task);
+    else
+        task();
+}
+
+LLGL_EXPORT void WaitForConcurrentCondition(const std::function<bool()>& condition)
+{
+    if (WorkerThreadPool* threadPool = GetOrCreateThreadPool())
+        threadPool->WaitUntil(condition);
+    else
+    {
+        while (!condition())
+            std::this_thread::yield();
+    }
+}
+
+LLGL_EXPORT void NotifyConcurrentConditionChanged()
+{
+    /* Prefer the pool of the calling worker thread, so waiters are also notified while the worker count is being changed */
+    if (WorkerThreadPool* threadPool = WorkerThreadPool::GetCurrentThreadPool())
+        threadPool->NotifyWaiters();
+    else
+    {
+        std::lock_guard<std::mutex> guard{ g_threadPoolMutex };
+        if (g_threadPool)
+            g_threadPool->NotifyWaiters();
+    }
+}
+
+
+
+/* ----- ThreadPool namespace ----- */
+
+namespace ThreadPool
+{
+
+
+LLGL_EXPORT void SetWorkerCount(unsigned workerCount)
+{
+    std::unique_ptr<WorkerThreadPool> prevThreadPool;
+    {
+        std::lock_guard<std::mutex> guard{ g_threadPoolMutex };
+        if (g_threadPoolWorkerCount == workerCount)
+            return;
+        g_threadPoolWorkerCount = workerCount;
+        prevThreadPool = std::move(g_threadPool);
+    }
+    /* Previous thread pool completes its pending tasks outside the lock as they might use the thread pool themselves */
+}
+
+LLGL_EXPORT unsigned GetWorkerCount()
+{
+    std::lock_guard<std::mutex> guard{ g_threadPoolMutex };
+    return (g_threadPool ? g_threadPool->GetWorkerCount() : ResolveThreadPoolWorkerCount(g_threadPoolWorkerCount));
+}
+
+LLGL_EXPORT void Submit(const std::function<void()>& task)
+{
+    EnqueueConcurrentTask(task);
+}
+
+LLGL_EXPORT void ParallelFor(
+    const std::function<void(std::size_t begin, std::size_t end)>&  task,
+    std::size_t                                                     count,
+    unsigned                                                        threadCount,
+    unsigned                                                        threadMinWorkSize)
+{
+    DoConcurrentRange(task, count, threadCount, threadMinWorkSize);
+}
+
+
+} // /namespace ThreadPool
+
+
 } // /namespace LLGL
 
 
@@ -33,6 +33,15 @@ LLGL_EXPORT void DoConcurrent(
     unsigned                                        threadMinWorkSize   = 64
 );
 
+// Enqueues the specified task into the process-wide thread pool. If the thread pool is disabled, the task is executed immediately.
+LLGL_EXPORT void EnqueueConcurrentTask(const std::function<void()>& task);
+
+// Waits until the specified condition is met. The calling thread executes pending tasks of the thread pool in the meantime.
+LLGL_EXPORT void WaitForConcurrentCondition(const std::function<bool()>& condition);
+
+// Wakes up all threads in WaitForConcurrentCondition() to re-evaluate their condition.
+LLGL_EXPORT void NotifyConcurrentConditionChanged();
+
 
 } // /namespace LLGL
 
@@ -2840,7 +2840,9 @@ DbgPipelineState* DbgCommandBuffer::AssertAndGetGraphicsPSO()
 {
     if (bindings_.pipelineState == nullptr)
     {
-        LLGL_DBG_ERROR(ErrorType::InvalidState, "no graphics pipeline is bound; missing call to <LLGL::CommandBuffer::SetPipelineState>");
+        /* Secondary command buffers can inherit the pipeline state from their primary command buffer */
+        if (!IsSecondaryCmdBuffer())
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "no graphics pipeline is bound; missing call to <LLGL::CommandBuffer::SetPipelineState>");
         return nullptr;
     }
     else if (!bindings_.pipelineState->isGraphicsPSO)
@@ -2855,7 +2857,9 @@ DbgPipelineState* DbgCommandBuffer::AssertAndGetComputePSO()
 {
     if (bindings_.pipelineState == nullptr)
     {
-        LLGL_DBG_ERROR(ErrorType::InvalidState, "no compute pipeline is bound; missing call to <LLGL::CommandBuffer::SetPipelineState>");
+        /* Secondary command buffers can inherit the pipeline state from their primary command buffer */
+        if (!IsSecondaryCmdBuffer())
+            LLGL_DBG_ERROR(ErrorType::InvalidState, "no compute pipeline is bound; missing call to <LLGL::CommandBuffer::SetPipelineState>");
         return nullptr;
     }
     else if (bindings_.pipelineState->isGraphicsPSO)
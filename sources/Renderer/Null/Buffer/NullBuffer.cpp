@@ -8,6 +8,8 @@
 #include "NullBuffer.h"
 #include "../../ResourceUtils.h"
 #include "../../../Core/CoreUtils.h"
+#include <LLGL/Constants.h>
+#include <LLGL/Log.h>
 #include <algorithm>
 #include <string.h>
 
@@ -18,18 +20,21 @@ namespace LLGL
 
 constexpr NullBuffer::WordType g_uninitializedBufferWord = 0xDEADBEEF;
 
-NullBuffer::NullBuffer(const BufferDescriptor& desc, const void* initialData) :
-    Buffer { desc.bindFlags },
-    desc   { desc           }
+static std::uint32_t GetNullBufferVertexStride(const BufferDescriptor& desc)
+{
+    return (desc.vertexAttribs.empty() ? 0 : desc.vertexAttribs.front().stride);
+}
+
+NullBuffer::NullBuffer(const BufferDescriptor& desc, const void* initialData, bool copyOnMap) :
+    Buffer        { desc.bindFlags                  },
+    desc          { desc                            },
+    copyOnMap_    { copyOnMap                       },
+    vertexStride_ { GetNullBufferVertexStride(desc) }
 {
     /* Allocate word-aligned buffer and initialize with hex code as debug information */
     const std::size_t wordAlignedSize = GetAlignedSize(static_cast<std::size_t>(desc.size), sizeof(WordType));
     data_.resize(wordAlignedSize, g_uninitializedBufferWord);
 
-    /* Allocate mapped buffer if CPU access flags are specified */
-    if (desc.cpuAccessFlags != 0)
-        mappedData_.resize(wordAlignedSize, g_uninitializedBufferWord);
-
     /* Initialize buffer with initial data */
     if (initialData != nullptr)
         Write(0, initialData, static_cast<std::size_t>(desc.size));
@@ -92,6 +97,25 @@ bool NullBuffer::CopyFromBuffer(std::uint64_t dstOffset, const NullBuffer& srcBu
     return false;
 }
 
+bool NullBuffer::Fill(std::uint64_t offset, std::uint32_t value, std::uint64_t size)
+{
+    if (size == LLGL_WHOLE_SIZE)
+    {
+        /* Fill entire buffer; the word-aligned storage may cover trailing bytes beyond the buffer size */
+        offset  = 0;
+        size    = desc.size - desc.size % sizeof(WordType);
+    }
+
+    if (offset % sizeof(WordType) != 0 || size % sizeof(WordType) != 0 || !IsRangeInsideBuffer(*this, offset, size))
+        return false;
+
+    const std::size_t firstWord = static_cast<std::size_t>(offset / sizeof(WordType));
+    const std::size_t numWords  = static_cast<std::size_t>(size / sizeof(WordType));
+    std::fill_n(data_.begin() + firstWord, numWords, value);
+
+    return true;
+}
+
 bool NullBuffer::CpuAccessRead(std::uint64_t offset, void* data, std::uint64_t size)
 {
     if ((desc.cpuAccessFlags & CPUAccessFlags::Read) != 0)
@@ -128,22 +152,35 @@ void* NullBuffer::Map(const CPUAccess access, std::uint64_t offset, std::uint64_
         return nullptr;
     }
 
+    mapAccess_ = access;
+    mapOffset_ = static_cast<std::size_t>(offset);
+    mapLength_ = static_cast<std::size_t>(length);
+
+    /* Map internal buffer directly unless mapped ranges are validated with a temporary copy */
+    if (!copyOnMap_)
+        return GetBytesAt(mapOffset_);
+
     if (access == CPUAccess::WriteDiscard)
     {
         /* Discard all buffer content by filling buffer with uninitialized word */
         std::fill(data_.begin(), data_.end(), g_uninitializedBufferWord);
     }
 
-    /* Map internal buffer to output data */
-    mapAccess_ = access;
-    mapOffset_ = static_cast<std::size_t>(offset);
-    mapLength_ = static_cast<std::size_t>(length);
+    /* Allocate temporary copy of the mapped range; this is retained for subsequent mappings */
+    const std::size_t numMappedWords = GetAlignedSize(mapLength_, sizeof(WordType)) / sizeof(WordType);
+    if (mappedData_.size() < numMappedWords)
+        mappedData_.resize(numMappedWords);
 
     if (isReadAccess)
     {
         /* Map buffer for reading */
         ::memcpy(GetMappedBytes(), GetBytesAt(mapOffset_), mapLength_);
     }
+    else
+    {
+        /* Map buffer for writing only; bytes that are not written will show up as uninitialized word */
+        std::fill(mappedData_.begin(), mappedData_.begin() + numMappedWords, g_uninitializedBufferWord);
+    }
 
     return GetMappedBytes();
 }
@@ -152,10 +189,21 @@ void NullBuffer::Unmap()
 {
     if (mapLength_ > 0)
     {
-        if (HasWriteAccess(mapAccess_))
+        if (copyOnMap_)
         {
-            /* Map buffer for writing */
-            ::memcpy(GetBytesAt(mapOffset_), GetMappedBytes(), mapLength_);
+            if (HasWriteAccess(mapAccess_))
+            {
+                /* Map buffer for writing */
+                ::memcpy(GetBytesAt(mapOffset_), GetMappedBytes(), mapLength_);
+            }
+            else if (::memcmp(GetBytesAt(mapOffset_), GetMappedBytes(), mapLength_) != 0)
+            {
+                /* Buffer range was mapped for reading only, but modified by the client */
+                Log::Errorf(
+                    "buffer '%s' was modified in range [%zu, %zu) while mapped with read-only access\n",
+                    label_.c_str(), mapOffset_, mapOffset_ + mapLength_
+                );
+            }
         }
         mapLength_ = 0;
     }
@@ -31,7 +31,11 @@ class NullBuffer final : public Buffer
 
     public:
 
-        NullBuffer(const BufferDescriptor& desc, const void* initialData);
+        /*
+        Initializes the buffer with optional initial data. If 'copyOnMap' is true, Map() returns a temporary copy of the buffer range
+        that is written back on Unmap() and unmapped read-only ranges are validated to be unmodified. Otherwise, the buffer is mapped directly.
+        */
+        NullBuffer(const BufferDescriptor& desc, const void* initialData, bool copyOnMap = false);
 
         bool Read(std::uint64_t offset, void* data, std::uint64_t size);
         bool Write(std::uint64_t offset, const void* data, std::uint64_t size);
@@ -41,9 +45,30 @@ class NullBuffer final : public Buffer
 
         bool CopyFromBuffer(std::uint64_t dstOffset, const NullBuffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size);
 
+        // Fills the range with the 32-bit value. Offset and size must be a multiple of 4. LLGL_WHOLE_SIZE fills the entire buffer.
+        bool Fill(std::uint64_t offset, std::uint32_t value, std::uint64_t size);
+
         void* Map(const CPUAccess access, std::uint64_t offset, std::uint64_t length);
         void Unmap();
 
+        // Returns the vertex stride (in bytes) of this buffer or 0 if it was not created with vertex attributes.
+        inline std::uint32_t GetVertexStride() const
+        {
+            return vertexStride_;
+        }
+
+        // Returns the internal buffer data, e.g. to fetch vertices and indices.
+        inline const void* GetData() const
+        {
+            return data_.data();
+        }
+
+        // Returns the internal buffer data, e.g. for shader storage access.
+        inline void* GetData()
+        {
+            return data_.data();
+        }
+
     public:
 
         // Data type for the internal buffer data.
@@ -75,22 +100,24 @@ class NullBuffer final : public Buffer
 
         inline char* GetMappedBytes()
         {
-            return (reinterpret_cast<char*>(mappedData_.data()) + mapOffset_);
+            return reinterpret_cast<char*>(mappedData_.data());
         }
 
         inline const char* GetMappedBytes() const
         {
-            return (reinterpret_cast<const char*>(mappedData_.data()) + mapOffset_);
+            return reinterpret_cast<const char*>(mappedData_.data());
         }
 
     private:
 
         std::string             label_;
         std::vector<WordType>   data_;
-        std::vector<WordType>   mappedData_;
-        std::size_t             mapOffset_  = 0;
-        std::size_t             mapLength_  = 0;
-        CPUAccess               mapAccess_  = CPUAccess::ReadOnly;
+        std::vector<WordType>   mappedData_;            // Temporary copy of the mapped range; only used if copyOnMap_ is true.
+        std::size_t             mapOffset_      = 0;
+        std::size_t             mapLength_      = 0;
+        CPUAccess               mapAccess_      = CPUAccess::ReadOnly;
+        const bool              copyOnMap_      = false;
+        const std::uint32_t     vertexStride_   = 0;
 
 };
 
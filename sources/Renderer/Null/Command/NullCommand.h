@@ -10,6 +10,9 @@
 
 
 #include <LLGL/IndirectArguments.h>
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/TextureFlags.h>
 #include <cstddef>
 #include <cstdint>
 
@@ -18,10 +21,27 @@ namespace LLGL
 {
 
 
+class Resource;
+class RenderTarget;
 class NullBuffer;
 class NullTexture;
+class NullRenderPass;
+class NullPipelineState;
+class NullResourceHeap;
+class NullQueryHeap;
+class NullCommandBuffer;
 
 
+struct NullCmdExecute
+{
+    const NullCommandBuffer*    commandBuffer;
+    const NullBuffer*           indexBuffer;
+    Format                      indexBufferFormat;
+    std::uint64_t               indexBufferOffset;
+    std::size_t                 numVertexBuffers;
+//  NullVertexBufferBinding     vertexBuffers[numVertexBuffers];
+};
+
 struct NullCmdBufferWrite
 {
     NullBuffer* buffer;
@@ -30,6 +50,14 @@ struct NullCmdBufferWrite
 //  std::int8_t data[dataSize];
 };
 
+struct NullCmdBufferFill
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+    std::uint64_t   size;
+    std::uint32_t   value;
+};
+
 struct NullCmdCopySubresource
 {
     Resource*       srcResource;
@@ -49,6 +77,13 @@ struct NullCmdCopySubresource
     std::uint32_t   layerStride;
 };
 
+struct NullCmdCopyFramebuffer
+{
+    NullTexture*    texture;
+    TextureRegion   region;
+    Offset2D        srcOffset;
+};
+
 struct NullCmdGenerateMips
 {
     NullTexture*    texture;
@@ -58,13 +93,81 @@ struct NullCmdGenerateMips
     std::uint32_t   numMipLevels;
 };
 
-//TODO...
+struct NullCmdSetViewports
+{
+    std::uint32_t   numViewports;
+//  Viewport        viewports[numViewports];
+};
+
+struct NullCmdSetScissors
+{
+    std::uint32_t   numScissors;
+//  Scissor         scissors[numScissors];
+};
+
+struct NullCmdBeginRenderPass
+{
+    RenderTarget*           renderTarget;
+    bool                    isSwapChain;
+    const NullRenderPass*   renderPass;
+    std::uint32_t           numClearValues;
+//  ClearValue              clearValues[numClearValues];
+};
+
+//struct NullCmdEndRenderPass {};
+
+struct NullCmdClear
+{
+    long        flags;
+    ClearValue  clearValue;
+};
+
+struct NullCmdClearAttachments
+{
+    std::uint32_t   numAttachments;
+//  AttachmentClear attachments[numAttachments];
+};
+
+struct NullCmdBindPipelineState
+{
+    const NullPipelineState* pipelineState;
+};
+
+struct NullCmdSetBlendFactor
+{
+    float color[4];
+};
+
+struct NullCmdSetStencilReference
+{
+    std::uint32_t   reference;
+    StencilFace     stencilFace;
+};
+
+struct NullCmdSetResourceHeap
+{
+    const NullResourceHeap* resourceHeap;
+    std::uint32_t           descriptorSet;
+};
+
+struct NullCmdSetResource
+{
+    std::uint32_t   descriptor;
+    Resource*       resource;
+};
+
+struct NullCmdSetUniforms
+{
+    std::uint32_t   first;
+    std::uint16_t   size;
+//  char            data[size];
+};
 
 struct NullCmdDraw
 {
     DrawIndirectArguments   args;
-    std::size_t             numVertexBuffers;
-//  const NullBuffer*       vertexBuffers[numVertexBuffers];
+    std::size_t                 numVertexBuffers;
+//  NullVertexBufferBinding     vertexBuffers[numVertexBuffers];
 };
 
 struct NullCmdDrawIndexed
@@ -74,9 +177,35 @@ struct NullCmdDrawIndexed
     Format                          indexBufferFormat;
     std::uint64_t                   indexBufferOffset;
     std::size_t                     numVertexBuffers;
-//  const NullBuffer*               vertexBuffers[numVertexBuffers];
+//  NullVertexBufferBinding         vertexBuffers[numVertexBuffers];
+};
+
+struct NullCmdDispatch
+{
+    std::uint32_t numWorkGroups[3];
+};
+
+struct NullCmdDispatchIndirect
+{
+    const NullBuffer*   buffer;
+    std::uint64_t       offset;
 };
 
+struct NullCmdQuery
+{
+    NullQueryHeap*  queryHeap;
+    std::uint32_t   query;
+};
+
+struct NullCmdBeginRenderCondition
+{
+    const NullQueryHeap*    queryHeap;
+    std::uint32_t           query;
+    RenderConditionMode     mode;
+};
+
+//struct NullCmdEndRenderCondition {};
+
 struct NullCmdPushDebugGroup
 {
     std::size_t length;
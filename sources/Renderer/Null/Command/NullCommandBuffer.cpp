@@ -6,6 +6,7 @@
  */
 
 #include "NullCommandBuffer.h"
+#include "NullCommandQueue.h"
 #include "NullCommandExecutor.h"
 #include "NullCommand.h"
 #include "../../CheckedCast.h"
@@ -18,19 +19,23 @@
 #include "../RenderState/NullQueryHeap.h"
 #include "../RenderState/NullPipelineState.h"
 #include "../RenderState/NullResourceHeap.h"
+#include "../RenderState/NullRenderPass.h"
 #include "../Texture/NullTexture.h"
 #include "../Texture/NullRenderTarget.h"
 
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/IndirectArguments.h>
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
-    desc { desc }
+NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc, NullCommandQueue* commandQueue, bool compileCommands) :
+    desc                { desc                                                                      },
+    commandQueue_       { commandQueue                                                              },
+    compileCommands_    { compileCommands && (desc.flags & CommandBufferFlags::MultiSubmit) != 0    }
 {
 }
 
@@ -38,20 +43,40 @@ NullCommandBuffer::NullCommandBuffer(const CommandBufferDescriptor& desc) :
 
 void NullCommandBuffer::Begin()
 {
+    /* Wait until the command queue no longer reads the virtual commands of the previous submission */
+    commandQueue_->WaitForSubmission(lastSubmission_);
     buffer_.Clear();
+    compiledBuffer_.clear();
+    secondaryCommandBuffers_.clear();
 }
 
 void NullCommandBuffer::End()
 {
+    /* Pre-decode commands of command buffers that are submitted multiple times */
+    if (compileCommands_)
+        CompileNullVirtualCommandBuffer(buffer_, compiledBuffer_);
+
     if ((desc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
-        ExecuteVirtualCommands();
+        commandQueue_->SubmitCommandBuffer(*this);
 }
 
 void NullCommandBuffer::Execute(CommandBuffer& secondaryCommandBuffer)
 {
     auto& secondaryCommandBufferNull = LLGL_CAST(NullCommandBuffer&, secondaryCommandBuffer);
     if ((secondaryCommandBufferNull.desc.flags & CommandBufferFlags::Secondary) != 0)
-        secondaryCommandBufferNull.ExecuteVirtualCommands();
+    {
+        /* Defer execution of secondary command buffer until this command buffer is submitted and pass the inherited vertex and index buffers */
+        auto cmd = AllocCommand<NullCmdExecute>(NullOpcodeExecute, sizeof(NullVertexBufferBinding) * renderState_.vertexBuffers.size());
+        {
+            cmd->commandBuffer      = &secondaryCommandBufferNull;
+            cmd->indexBuffer        = renderState_.indexBuffer;
+            cmd->indexBufferFormat  = renderState_.indexBufferFormat;
+            cmd->indexBufferOffset  = renderState_.indexBufferOffset;
+            cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
+            ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(NullVertexBufferBinding) * renderState_.vertexBuffers.size());
+        }
+        secondaryCommandBuffers_.push_back(&secondaryCommandBufferNull);
+    }
 }
 
 /* ----- Blitting ----- */
@@ -107,6 +132,7 @@ static Extent3D GetSubresourceExtent(TextureType type, const Extent3D& extent, s
         case TextureType::Texture1DArray:
             return Extent3D{ extent.width, numArrayLayers, 1 };
         case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
         case TextureType::TextureCubeArray:
         case TextureType::Texture2DMSArray:
             return Extent3D{ extent.width, extent.height, numArrayLayers };
@@ -151,8 +177,14 @@ void NullCommandBuffer::FillBuffer(
     std::uint32_t   value,
     std::uint64_t   fillSize)
 {
-    //auto& dstBufferNull = LLGL_CAST(NullBuffer&, dstBuffer);
-    //todo
+    auto& dstBufferNull = LLGL_CAST(NullBuffer&, dstBuffer);
+    auto cmd = AllocCommand<NullCmdBufferFill>(NullOpcodeBufferFill);
+    {
+        cmd->buffer = &dstBufferNull;
+        cmd->offset = dstOffset;
+        cmd->size   = fillSize;
+        cmd->value  = value;
+    }
 }
 
 void NullCommandBuffer::CopyTexture(
@@ -172,7 +204,7 @@ void NullCommandBuffer::CopyTexture(
         cmd->srcY           = srcLocation.offset.y;
         cmd->srcZ           = srcLocation.offset.z;
         cmd->dstResource    = &dstTextureNull;
-        cmd->dstSubresource = dstTextureNull.PackSubresourceIndex(srcLocation.mipLevel, srcLocation.arrayLayer);
+        cmd->dstSubresource = dstTextureNull.PackSubresourceIndex(dstLocation.mipLevel, dstLocation.arrayLayer);
         cmd->dstX           = dstLocation.offset.x;
         cmd->dstY           = dstLocation.offset.y;
         cmd->dstZ           = dstLocation.offset.z;
@@ -219,7 +251,13 @@ void NullCommandBuffer::CopyTextureFromFramebuffer(
     const TextureRegion&    dstRegion,
     const Offset2D&         srcOffset)
 {
-    //todo
+    auto& dstTextureNull = LLGL_CAST(NullTexture&, dstTexture);
+    auto cmd = AllocCommand<NullCmdCopyFramebuffer>(NullOpcodeCopyFramebuffer);
+    {
+        cmd->texture    = &dstTextureNull;
+        cmd->region     = dstRegion;
+        cmd->srcOffset  = srcOffset;
+    }
 }
 
 void NullCommandBuffer::GenerateMips(Texture& texture)
@@ -252,22 +290,30 @@ void NullCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
 
 void NullCommandBuffer::SetViewport(const Viewport& viewport)
 {
-    renderState_.viewports = { viewport };
+    SetViewports(1, &viewport);
 }
 
 void NullCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
 {
-    renderState_.viewports = SmallVector<Viewport>(viewports, viewports + numViewports);
+    auto cmd = AllocCommand<NullCmdSetViewports>(NullOpcodeSetViewports, sizeof(Viewport) * numViewports);
+    {
+        cmd->numViewports = numViewports;
+        ::memcpy(cmd + 1, viewports, sizeof(Viewport) * numViewports);
+    }
 }
 
 void NullCommandBuffer::SetScissor(const Scissor& scissor)
 {
-    renderState_.scissors = { scissor };
+    SetScissors(1, &scissor);
 }
 
 void NullCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
 {
-    renderState_.scissors = SmallVector<Scissor>(scissors, scissors + numScissors);
+    auto cmd = AllocCommand<NullCmdSetScissors>(NullOpcodeSetScissors, sizeof(Scissor) * numScissors);
+    {
+        cmd->numScissors = numScissors;
+        ::memcpy(cmd + 1, scissors, sizeof(Scissor) * numScissors);
+    }
 }
 
 /* ----- Buffers ------ */
@@ -275,20 +321,23 @@ void NullCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* sc
 void NullCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    renderState_.vertexBuffers = { &bufferNull };
+    renderState_.vertexBuffers = { NullVertexBufferBinding{ &bufferNull, bufferNull.GetVertexStride() } };
 }
 
 void NullCommandBuffer::SetVertexBuffer(Buffer& buffer, std::uint32_t numVertexAttribs, const VertexAttribute* vertexAttribs)
 {
+    /* Bind buffer with the stride of the specified vertex format, which overrides the format of the buffer */
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
-    //TODO: update format
-    renderState_.vertexBuffers = { &bufferNull };
+    const std::uint32_t stride = (numVertexAttribs > 0 ? vertexAttribs[0].stride : bufferNull.GetVertexStride());
+    renderState_.vertexBuffers = { NullVertexBufferBinding{ &bufferNull, stride } };
 }
 
 void NullCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 {
     auto& bufferArrayNull = LLGL_CAST(NullBufferArray&, bufferArray);
-    renderState_.vertexBuffers = SmallVector<const NullBuffer*>(bufferArrayNull.buffers.begin(), bufferArrayNull.buffers.end());
+    renderState_.vertexBuffers.clear();
+    for (NullBuffer* buffer : bufferArrayNull.buffers)
+        renderState_.vertexBuffers.push_back(NullVertexBufferBinding{ buffer, buffer->GetVertexStride() });
 }
 
 void NullCommandBuffer::SetIndexBuffer(Buffer& buffer)
@@ -311,13 +360,21 @@ void NullCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std:
 
 void NullCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::uint32_t descriptorSet)
 {
-    //auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
-    //todo
+    auto& resourceHeapNull = LLGL_CAST(NullResourceHeap&, resourceHeap);
+    auto cmd = AllocCommand<NullCmdSetResourceHeap>(NullOpcodeSetResourceHeap);
+    {
+        cmd->resourceHeap   = &resourceHeapNull;
+        cmd->descriptorSet  = descriptorSet;
+    }
 }
 
 void NullCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetResource>(NullOpcodeSetResource);
+    {
+        cmd->descriptor = descriptor;
+        cmd->resource   = &resource;
+    }
 }
 
 void NullCommandBuffer::ResourceBarrier(
@@ -338,79 +395,115 @@ void NullCommandBuffer::BeginRenderPass(
     const ClearValue*   clearValues,
     std::uint32_t       /*swapBufferIndex*/)
 {
-    if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
+    /* Attachments are resolved when the command is executed, so swap-chain resizes between recording and submission are respected */
+    auto cmd = AllocCommand<NullCmdBeginRenderPass>(NullOpcodeBeginRenderPass, sizeof(ClearValue) * numClearValues);
     {
-        //auto& swapChainNull = LLGL_CAST(NullSwapChain&, renderTarget);
-        //todo
-    }
-    else
-    {
-        //auto& renderTargetNull = LLGL_CAST(NullRenderTarget&, renderTarget);
-        //todo
+        cmd->renderTarget   = &renderTarget;
+        cmd->isSwapChain    = LLGL::IsInstanceOf<SwapChain>(renderTarget);
+        cmd->renderPass     = LLGL_CAST(const NullRenderPass*, renderPass);
+        cmd->numClearValues = numClearValues;
+        if (numClearValues > 0)
+            ::memcpy(cmd + 1, clearValues, sizeof(ClearValue) * numClearValues);
     }
 }
 
 void NullCommandBuffer::EndRenderPass()
 {
-    //todo
+    AllocOpcode(NullOpcodeEndRenderPass);
 }
 
 void NullCommandBuffer::Clear(long flags, const ClearValue& clearValue)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdClear>(NullOpcodeClear);
+    {
+        cmd->flags      = flags;
+        cmd->clearValue = clearValue;
+    }
 }
 
 void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdClearAttachments>(NullOpcodeClearAttachments, sizeof(AttachmentClear) * numAttachments);
+    {
+        cmd->numAttachments = numAttachments;
+        ::memcpy(cmd + 1, attachments, sizeof(AttachmentClear) * numAttachments);
+    }
 }
 
 /* ----- Pipeline States ----- */
 
 void NullCommandBuffer::SetPipelineState(PipelineState& pipelineState)
 {
-    //auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
-    //todo
+    auto& pipelineStateNull = LLGL_CAST(NullPipelineState&, pipelineState);
+    auto cmd = AllocCommand<NullCmdBindPipelineState>(NullOpcodeBindPipelineState);
+    {
+        cmd->pipelineState = &pipelineStateNull;
+    }
 }
 
 void NullCommandBuffer::SetBlendFactor(const float color[4])
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetBlendFactor>(NullOpcodeSetBlendFactor);
+    {
+        ::memcpy(cmd->color, color, sizeof(cmd->color));
+    }
 }
 
 void NullCommandBuffer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetStencilReference>(NullOpcodeSetStencilReference);
+    {
+        cmd->reference      = reference;
+        cmd->stencilFace    = stencilFace;
+    }
 }
 
 void NullCommandBuffer::SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize)
 {
-    //todo
+    auto cmd = AllocCommand<NullCmdSetUniforms>(NullOpcodeSetUniforms, dataSize);
+    {
+        cmd->first  = first;
+        cmd->size   = dataSize;
+        ::memcpy(cmd + 1, data, dataSize);
+    }
 }
 
 /* ----- Queries ----- */
 
 void NullCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeBeginQuery);
+    {
+        cmd->queryHeap  = &queryHeapNull;
+        cmd->query      = query;
+    }
 }
 
 void NullCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeEndQuery);
+    {
+        cmd->queryHeap  = &queryHeapNull;
+        cmd->query      = query;
+    }
 }
 
 void NullCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+    auto cmd = AllocCommand<NullCmdBeginRenderCondition>(NullOpcodeBeginRenderCondition);
+    {
+        cmd->queryHeap  = &queryHeapNull;
+        cmd->query      = query;
+        cmd->mode       = mode;
+    }
 }
 
 void NullCommandBuffer::EndRenderCondition()
 {
-    //todo
+    AllocOpcode(NullOpcodeEndRenderCondition);
 }
 
 /* ----- Stream Output ------ */
@@ -577,12 +670,22 @@ void NullCommandBuffer::DrawStreamOutput()
 
 void NullCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
-    // dummy
+    auto cmd = AllocCommand<NullCmdDispatch>(NullOpcodeDispatch);
+    {
+        cmd->numWorkGroups[0] = numWorkGroupsX;
+        cmd->numWorkGroups[1] = numWorkGroupsY;
+        cmd->numWorkGroups[2] = numWorkGroupsZ;
+    }
 }
 
 void NullCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
-    // dummy
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    auto cmd = AllocCommand<NullCmdDispatchIndirect>(NullOpcodeDispatchIndirect);
+    {
+        cmd->buffer = &bufferNull;
+        cmd->offset = offset;
+    }
 }
 
 /* ----- Debugging ----- */
@@ -592,6 +695,7 @@ void NullCommandBuffer::PushDebugGroup(const char* name)
     const std::size_t length = ::strlen(name);
     auto cmd = AllocCommand<NullCmdPushDebugGroup>(NullOpcodePushDebugGroup, length + 1);
     {
+        cmd->length = length;
         ::memcpy(cmd + 1, name, length + 1);
     }
 }
@@ -620,11 +724,28 @@ bool NullCommandBuffer::GetNativeHandle(void* nativeHandle, std::size_t nativeHa
 
 void NullCommandBuffer::ExecuteVirtualCommands()
 {
-    ExecuteNullVirtualCommandBuffer(buffer_);
+    ExecuteVirtualCommands(context_);
     if ((desc.flags & CommandBufferFlags::MultiSubmit) == 0)
         buffer_.Clear();
 }
 
+void NullCommandBuffer::ExecuteVirtualCommands(NullCommandContext& context) const
+{
+    if (compileCommands_)
+        ExecuteNullCompiledCommandBuffer(compiledBuffer_, context);
+    else
+        ExecuteNullVirtualCommandBuffer(buffer_, context);
+}
+
+void NullCommandBuffer::SetLastSubmission(std::uint64_t submission)
+{
+    lastSubmission_ = submission;
+
+    /* Secondary command buffers must not be encoded again until this submission has been executed */
+    for (NullCommandBuffer* secondaryCommandBuffer : secondaryCommandBuffers_)
+        secondaryCommandBuffer->lastSubmission_ = std::max(secondaryCommandBuffer->lastSubmission_, submission);
+}
+
 
 /*
  * ======= Private: =======
@@ -643,24 +764,24 @@ TCommand* NullCommandBuffer::AllocCommand(const NullOpcode opcode, std::size_t p
 
 void NullCommandBuffer::AllocDrawCommand(const DrawIndirectArguments& args)
 {
-    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw, sizeof(NullVertexBufferBinding) * renderState_.vertexBuffers.size());
     {
         cmd->args               = args;
         cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
-        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(NullVertexBufferBinding) * renderState_.vertexBuffers.size());
     }
 }
 
 void NullCommandBuffer::AllocDrawIndexedCommand(const DrawIndexedIndirectArguments& args)
 {
-    auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed, sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+    auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed, sizeof(NullVertexBufferBinding) * renderState_.vertexBuffers.size());
     {
         cmd->args               = args;
         cmd->indexBuffer        = renderState_.indexBuffer;
         cmd->indexBufferFormat  = renderState_.indexBufferFormat;
         cmd->indexBufferOffset  = renderState_.indexBufferOffset;
         cmd->numVertexBuffers   = renderState_.vertexBuffers.size();
-        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(const NullBuffer*) * renderState_.vertexBuffers.size());
+        ::memcpy(cmd + 1, renderState_.vertexBuffers.data(), sizeof(NullVertexBufferBinding) * renderState_.vertexBuffers.size());
     }
 }
 
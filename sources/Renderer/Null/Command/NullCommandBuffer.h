@@ -12,7 +12,9 @@
 #include <LLGL/CommandBuffer.h>
 #include <LLGL/Container/SmallVector.h>
 #include "NullCommandOpcode.h"
+#include "NullCommandContext.h"
 #include "../../VirtualCommandBuffer.h"
+#include <vector>
 
 
 namespace LLGL
@@ -20,9 +22,23 @@ namespace LLGL
 
 
 class NullBuffer;
+class NullCommandQueue;
 
 using NullVirtualCommandBuffer = VirtualCommandBuffer<NullOpcode>;
 
+// Function to execute a single command with its payload. Returns the size (in bytes) of the payload.
+using NullCommandFunc = std::size_t (*)(const void* pc, NullCommandContext& context);
+
+// Pre-decoded command, i.e. the function that executes the command and a pointer to its payload.
+struct NullCompiledCommand
+{
+    NullCommandFunc func;
+    const void*     pc;
+};
+
+// Compiled command buffer, which refers to the commands of a virtual command buffer and is only valid until that buffer is modified.
+using NullCompiledCommandBuffer = std::vector<NullCompiledCommand>;
+
 class NullCommandBuffer final : public CommandBuffer
 {
 
@@ -32,13 +48,20 @@ class NullCommandBuffer final : public CommandBuffer
 
     public:
 
-        NullCommandBuffer(const CommandBufferDescriptor& desc);
+        NullCommandBuffer(const CommandBufferDescriptor& desc, NullCommandQueue* commandQueue, bool compileCommands = false);
 
     public:
 
         // Executes the internal virtual command buffer.
         void ExecuteVirtualCommands();
 
+        // Executes the internal virtual command buffer with the state of the specified command context, e.g. of a primary command buffer.
+        void ExecuteVirtualCommands(NullCommandContext& context) const;
+
+        // Stores the ID of the last submission of this command buffer, which must be executed before the command buffer is encoded again.
+        // This is also propagated to all secondary command buffers that are executed by this command buffer.
+        void SetLastSubmission(std::uint64_t submission);
+
     public:
 
         const CommandBufferDescriptor desc;
@@ -47,12 +70,10 @@ class NullCommandBuffer final : public CommandBuffer
 
         struct RenderState
         {
-            SmallVector<Viewport>           viewports;
-            SmallVector<Scissor>            scissors;
-            SmallVector<const NullBuffer*>  vertexBuffers;
-            const NullBuffer*               indexBuffer         = nullptr;
-            Format                          indexBufferFormat   = Format::Undefined;
-            std::uint64_t                   indexBufferOffset   = 0;
+            SmallVector<NullVertexBufferBinding>    vertexBuffers;
+            const NullBuffer*                       indexBuffer         = nullptr;
+            Format                                  indexBufferFormat   = Format::Undefined;
+            std::uint64_t                           indexBufferOffset   = 0;
         };
 
     private:
@@ -69,8 +90,15 @@ class NullCommandBuffer final : public CommandBuffer
 
     private:
 
-        NullVirtualCommandBuffer    buffer_;
-        RenderState                 renderState_;
+        NullCommandQueue*               commandQueue_       = nullptr;
+        std::uint64_t                   lastSubmission_     = 0;
+
+        NullVirtualCommandBuffer        buffer_;
+        NullCompiledCommandBuffer       compiledBuffer_;
+        bool                            compileCommands_    = false;
+        RenderState                     renderState_;
+        std::vector<NullCommandBuffer*> secondaryCommandBuffers_;
+        NullCommandContext              context_;
 
 };
 
@@ -0,0 +1,1243 @@
+/*
+ * NullCommandContext.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullCommandContext.h"
+#include "../NullSwapChain.h"
+#include "../Buffer/NullBuffer.h"
+#include "../Shader/NullShader.h"
+#include "../Texture/NullTexture.h"
+#include "../Texture/NullRenderTarget.h"
+#include "../RenderState/NullRenderPass.h"
+#include "../RenderState/NullPipelineState.h"
+#include "../RenderState/NullPipelineLayout.h"
+#include "../Raster/NullPrimitiveAssembler.h"
+#include "../Raster/NullVertexFetch.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Threading.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+#include <thread>
+
+
+namespace LLGL
+{
+
+
+/* ----- Render passes ----- */
+
+void NullCommandContext::BeginRenderPass(
+    RenderTarget&           renderTarget,
+    bool                    isSwapChain,
+    const NullRenderPass*   renderPass,
+    std::uint32_t           numClearValues,
+    const ClearValue*       clearValues)
+{
+    if (framebuffer_.IsActive())
+        framebuffer_.End();
+
+    const NullFramebufferDescriptor& framebufferDesc =
+    (
+        isSwapChain
+            ? LLGL_CAST(NullSwapChain&, renderTarget).GetFramebufferDesc()
+            : LLGL_CAST(NullRenderTarget&, renderTarget).GetFramebufferDesc()
+    );
+
+    /* Load all attachments without a render pass, otherwise only those with a load operation */
+    std::uint32_t   colorLoadMask   = ~0u;
+    bool            loadDepth       = true;
+    bool            loadStencil     = true;
+
+    if (renderPass != nullptr)
+    {
+        colorLoadMask = 0;
+        for_range(i, framebufferDesc.numColorAttachments)
+        {
+            if (renderPass->desc.colorAttachments[i].loadOp == AttachmentLoadOp::Load)
+                colorLoadMask |= (1u << i);
+        }
+        loadDepth   = (renderPass->desc.depthAttachment.loadOp == AttachmentLoadOp::Load);
+        loadStencil = (renderPass->desc.stencilAttachment.loadOp == AttachmentLoadOp::Load);
+    }
+
+    framebuffer_.Begin(framebufferDesc, colorLoadMask, loadDepth, loadStencil);
+
+    if (renderPass == nullptr)
+        return;
+
+    /* Clear attachments with the clear values in order of the attachments; missing values fall back to the defaults */
+    const ClearValue defaultClearValue;
+    std::uint32_t clearValueIndex = 0;
+
+    auto NextClearValue = [&]() -> const ClearValue&
+    {
+        return (clearValueIndex < numClearValues ? clearValues[clearValueIndex++] : defaultClearValue);
+    };
+
+    for_range(i, framebufferDesc.numColorAttachments)
+    {
+        if (renderPass->desc.colorAttachments[i].loadOp == AttachmentLoadOp::Clear)
+            framebuffer_.ClearColor(i, NextClearValue().color);
+    }
+
+    const bool clearDepth   = (renderPass->desc.depthAttachment.loadOp == AttachmentLoadOp::Clear);
+    const bool clearStencil = (renderPass->desc.stencilAttachment.loadOp == AttachmentLoadOp::Clear);
+
+    if (clearDepth || clearStencil)
+    {
+        const ClearValue& clearValue = NextClearValue();
+        if (clearDepth)
+            framebuffer_.ClearDepth(clearValue.depth);
+        if (clearStencil)
+            framebuffer_.ClearStencil(clearValue.stencil);
+    }
+}
+
+void NullCommandContext::EndRenderPass()
+{
+    if (framebuffer_.IsActive())
+        framebuffer_.End();
+}
+
+void NullCommandContext::Clear(long flags, const ClearValue& clearValue)
+{
+    if (!framebuffer_.IsActive())
+        return;
+
+    if ((flags & ClearFlags::Color) != 0)
+    {
+        for_range(i, framebuffer_.GetNumColorBuffers())
+            framebuffer_.ClearColor(i, clearValue.color);
+    }
+    if ((flags & ClearFlags::Depth) != 0)
+        framebuffer_.ClearDepth(clearValue.depth);
+    if ((flags & ClearFlags::Stencil) != 0)
+        framebuffer_.ClearStencil(clearValue.stencil);
+}
+
+void NullCommandContext::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    if (!framebuffer_.IsActive())
+        return;
+
+    for_range(i, numAttachments)
+    {
+        const AttachmentClear& attachment = attachments[i];
+        if ((attachment.flags & ClearFlags::Color) != 0)
+        {
+            if (attachment.colorAttachment < framebuffer_.GetNumColorBuffers())
+                framebuffer_.ClearColor(attachment.colorAttachment, attachment.clearValue.color);
+        }
+        else
+        {
+            if ((attachment.flags & ClearFlags::Depth) != 0)
+                framebuffer_.ClearDepth(attachment.clearValue.depth);
+            if ((attachment.flags & ClearFlags::Stencil) != 0)
+                framebuffer_.ClearStencil(attachment.clearValue.stencil);
+        }
+    }
+}
+
+
+/* ----- Dynamic states ----- */
+
+void NullCommandContext::CopyTextureFromFramebuffer(NullTexture* texture, const TextureRegion& dstRegion, const Offset2D& srcOffset)
+{
+    if (texture == nullptr || !framebuffer_.IsActive())
+        return;
+
+    /* Read framebuffer region in the native format of the destination texture */
+    const Image&        mipMap      = texture->GetMipImage(dstRegion.subresource.baseMipLevel);
+    const Extent2D      extent      = { dstRegion.extent.width, dstRegion.extent.height };
+    const std::size_t   dataSize    = GetMemoryFootprint(mipMap.GetFormat(), mipMap.GetDataType(), static_cast<std::size_t>(extent.width) * extent.height);
+
+    if (dataSize == 0)
+        return;
+
+    std::vector<char> pixels(dataSize);
+    if (framebuffer_.ReadColorBuffer(0, srcOffset, extent, MutableImageView{ mipMap.GetFormat(), mipMap.GetDataType(), pixels.data(), pixels.size() }))
+    {
+        const TextureLocation dstLocation{ dstRegion.offset, dstRegion.subresource.baseArrayLayer, dstRegion.subresource.baseMipLevel };
+        texture->CopyFromMemory(dstLocation, Extent3D{ extent.width, extent.height, 1 }, pixels.data(), pixels.size(), 0, 0);
+    }
+}
+
+void NullCommandContext::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
+{
+    viewports_.assign(viewports, viewports + numViewports);
+}
+
+void NullCommandContext::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
+{
+    scissors_.assign(scissors, scissors + numScissors);
+}
+
+void NullCommandContext::SetPipelineState(const NullPipelineState* pipelineState)
+{
+    if (pipelineState == nullptr)
+        return;
+
+    boundPipelineState_ = pipelineState;
+
+    /* Uniform data persists across PSOs, so it only grows to the largest push constant block */
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    if (bindings_.uniforms.size() < pipelineState->GetUniformDataSize())
+        bindings_.uniforms.resize(pipelineState->GetUniformDataSize(), 0);
+    #endif
+
+    if (!pipelineState->isGraphicsPSO)
+    {
+        computePipelineState_ = pipelineState;
+        #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+        const Shader* computeShader = pipelineState->computeDesc.computeShader;
+        computeStage_.Reset(computeShader != nullptr ? LLGL_CAST(const NullShader*, computeShader) : nullptr);
+        #endif
+        return;
+    }
+
+    pipelineState_ = pipelineState;
+
+    const GraphicsPipelineDescriptor& desc = pipelineState->graphicsDesc;
+
+    /* Use vertex attributes of the PSO and fall back to the input attributes of the vertex shader */
+    vertexAttribs_      = nullptr;
+    numVertexAttribs_   = 0;
+    positionAttrib_     = 0;
+
+    if (!desc.inputVertexAttribs.empty())
+    {
+        vertexAttribs_      = desc.inputVertexAttribs.data();
+        numVertexAttribs_   = desc.inputVertexAttribs.size();
+    }
+    else if (desc.vertexShader != nullptr)
+    {
+        const NullShader* vertexShaderNull = LLGL_CAST(const NullShader*, desc.vertexShader);
+        vertexAttribs_      = vertexShaderNull->desc.vertex.inputAttribs.data();
+        numVertexAttribs_   = vertexShaderNull->desc.vertex.inputAttribs.size();
+    }
+
+    for_range(i, numVertexAttribs_)
+    {
+        if (vertexAttribs_[i].systemValue == SystemValue::Position)
+        {
+            positionAttrib_ = i;
+            break;
+        }
+    }
+
+    /* Copy pipeline states into rasterizer state */
+    rasterState_.cullMode           = desc.rasterizer.cullMode;
+    rasterState_.frontCCW           = desc.rasterizer.frontCCW;
+    rasterState_.depthClampEnabled  = desc.rasterizer.depthClampEnabled;
+    rasterState_.scissorTestEnabled = desc.rasterizer.scissorTestEnabled;
+    rasterState_.depthBias          = desc.rasterizer.depthBias;
+    rasterState_.depth              = desc.depth;
+    rasterState_.stencil            = desc.stencil;
+    rasterState_.blend              = desc.blend;
+    rasterState_.numVaryings        = static_cast<std::uint32_t>(std::min<std::size_t>(numVertexAttribs_ > 0 ? numVertexAttribs_ - 1 : 0, g_nullMaxVaryings));
+    rasterState_.flatVaryingMask    = 0;
+    rasterState_.earlyFragmentTests = true;
+
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    const bool hasShaderStages = SetupShaderStages(desc);
+    #else
+    const bool hasShaderStages = false;
+    #endif
+
+    /*
+    Without executable shaders, vertex attributes are passed through: The position attribute is interpreted in clip space
+    and the first remaining attribute is written to all color outputs (or white if there is none).
+    Without a fragment shader, fragments only contribute to the depth-stencil attachment.
+    */
+    if (desc.fragmentShader == nullptr)
+    {
+        rasterState_.fragmentShader                     = nullptr;
+        rasterState_.blend.independentBlendEnabled      = false;
+        rasterState_.blend.targets[0].colorMask         = 0;
+    }
+    else if (!hasShaderStages)
+    {
+        const std::uint32_t numVaryings = rasterState_.numVaryings;
+        const NullFramebuffer* framebuffer = &framebuffer_;
+        rasterState_.fragmentShader = [numVaryings, framebuffer](NullFragmentQuad& quad)
+        {
+            for_range(target, framebuffer->GetNumColorBuffers())
+            {
+                for_range(component, 4)
+                {
+                    for_range(lane, 4)
+                        quad.colors[target][component][lane] = (numVaryings > 0 ? quad.varyings[0][component][lane] : 1.0f);
+                }
+            }
+        };
+    }
+}
+
+void NullCommandContext::SetBlendFactor(const float color[4])
+{
+    for_range(i, 4)
+        blendFactor_[i] = color[i];
+}
+
+void NullCommandContext::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
+{
+    if (stencilFace != StencilFace::Back)
+        stencilReference_[0] = reference;
+    if (stencilFace != StencilFace::Front)
+        stencilReference_[1] = reference;
+}
+
+
+/* ----- Resources ----- */
+
+void NullCommandContext::SetResourceHeap(const NullResourceHeap* resourceHeap, std::uint32_t descriptorSet)
+{
+    bindings_.resourceHeap  = resourceHeap;
+    bindings_.descriptorSet = descriptorSet;
+}
+
+void NullCommandContext::SetResource(std::uint32_t descriptor, Resource* resource)
+{
+    if (descriptor >= bindings_.resources.size())
+        bindings_.resources.resize(descriptor + 1, nullptr);
+    bindings_.resources[descriptor] = resource;
+}
+
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+void NullCommandContext::SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize)
+{
+    if (boundPipelineState_ == nullptr)
+        return;
+
+    /* Copy consecutive uniforms into their ranges of the push constant block until the input data is exhausted */
+    const std::vector<NullUniformRange>& uniformRanges = boundPipelineState_->GetUniformRanges();
+    const char* src = static_cast<const char*>(data);
+
+    for (; first < uniformRanges.size(); ++first)
+    {
+        const NullUniformRange& range = uniformRanges[first];
+        if (dataSize < range.size)
+            break;
+
+        if (range.offset + range.size <= bindings_.uniforms.size())
+            ::memcpy(bindings_.uniforms.data() + range.offset, src, range.size);
+
+        src         += range.size;
+        dataSize    -= static_cast<std::uint16_t>(range.size);
+    }
+}
+
+#else // LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+void NullCommandContext::SetUniforms(std::uint32_t /*first*/, const void* /*data*/, std::uint16_t /*dataSize*/)
+{
+    // dummy
+}
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+
+/* ----- Drawing ----- */
+
+void NullCommandContext::Draw(
+    const DrawIndirectArguments&    args,
+    const NullVertexBufferBinding*  vertexBuffers,
+    std::size_t                     numVertexBuffers)
+{
+    if (args.numVertices == 0 || !renderConditionPassed_ || !UpdateRasterState())
+        return;
+
+    /* Secondary command buffers inherit the vertex buffers of their primary command buffer if they have not bound their own */
+    if (numVertexBuffers == 0)
+    {
+        vertexBuffers       = inheritedBuffers_.vertexBuffers;
+        numVertexBuffers    = inheritedBuffers_.numVertexBuffers;
+    }
+
+    indices_.resize(args.numVertices);
+    for_range(i, args.numVertices)
+        indices_[i] = i;
+
+    for_range(instance, args.numInstances)
+    {
+        TransformVertices(nullptr, args.numVertices, args.firstVertex, args.firstInstance + instance, vertexBuffers, numVertexBuffers);
+        DrawPrimitives(indices_.data(), indices_.size());
+    }
+}
+
+template <typename TIndex>
+static void ReadIndices(
+    const TIndex*               srcIndices,
+    std::size_t                 numIndices,
+    std::uint32_t               restartIndex,
+    std::vector<std::uint32_t>& outIndices,
+    std::uint32_t&              outMinIndex,
+    std::uint32_t&              outMaxIndex)
+{
+    outIndices.resize(numIndices);
+    outMinIndex = ~0u;
+    outMaxIndex = 0;
+    for_range(i, numIndices)
+    {
+        const std::uint32_t index = srcIndices[i];
+        if (index == restartIndex)
+            outIndices[i] = g_nullRestartIndex;
+        else
+        {
+            outIndices[i] = index;
+            outMinIndex = std::min(outMinIndex, index);
+            outMaxIndex = std::max(outMaxIndex, index);
+        }
+    }
+}
+
+void NullCommandContext::DrawIndexed(
+    const DrawIndexedIndirectArguments& args,
+    const NullBuffer*                   indexBuffer,
+    Format                              indexFormat,
+    std::uint64_t                       indexBufferOffset,
+    const NullVertexBufferBinding*      vertexBuffers,
+    std::size_t                         numVertexBuffers)
+{
+    /* Secondary command buffers inherit the index and vertex buffers of their primary command buffer if they have not bound their own */
+    if (indexBuffer == nullptr)
+    {
+        indexBuffer         = inheritedBuffers_.indexBuffer;
+        indexFormat         = inheritedBuffers_.indexFormat;
+        indexBufferOffset   = inheritedBuffers_.indexBufferOffset;
+    }
+    if (numVertexBuffers == 0)
+    {
+        vertexBuffers       = inheritedBuffers_.vertexBuffers;
+        numVertexBuffers    = inheritedBuffers_.numVertexBuffers;
+    }
+
+    if (args.numIndices == 0 || indexBuffer == nullptr || !renderConditionPassed_ || !UpdateRasterState())
+        return;
+
+    /* Read indices within the bounds of the index buffer */
+    const std::uint64_t indexSize = (indexFormat == Format::R16UInt ? 2 : 4);
+    const std::uint64_t indexOffset = indexBufferOffset + indexSize * args.firstIndex;
+    if (indexOffset >= indexBuffer->desc.size)
+        return;
+
+    const std::size_t numIndices = static_cast<std::size_t>(std::min<std::uint64_t>(args.numIndices, (indexBuffer->desc.size - indexOffset) / indexSize));
+    const char* indexData = static_cast<const char*>(indexBuffer->GetData()) + indexOffset;
+
+    std::uint32_t minIndex = 0, maxIndex = 0;
+    if (indexSize == 2)
+        ReadIndices(reinterpret_cast<const std::uint16_t*>(indexData), numIndices, 0xFFFFu, indices_, minIndex, maxIndex);
+    else
+        ReadIndices(reinterpret_cast<const std::uint32_t*>(indexData), numIndices, 0xFFFFFFFFu, indices_, minIndex, maxIndex);
+
+    if (minIndex > maxIndex)
+        return;
+
+    /*
+    Transform the referenced index range once, unless it is sparse, in which case only the unique vertices are transformed.
+    Indices are then remapped into the post-transform vertex cache, so vertices that are shared between primitives are transformed once.
+    */
+    const std::size_t numRangeVertices = static_cast<std::size_t>(maxIndex - minIndex) + 1;
+    const bool isSparse = (numRangeVertices > numIndices);
+
+    if (isSparse)
+    {
+        vertexIDs_.clear();
+        vertexIDs_.reserve(numIndices);
+        for (std::uint32_t index : indices_)
+        {
+            if (index != g_nullRestartIndex)
+                vertexIDs_.push_back(index);
+        }
+
+        std::sort(vertexIDs_.begin(), vertexIDs_.end());
+        vertexIDs_.erase(std::unique(vertexIDs_.begin(), vertexIDs_.end()), vertexIDs_.end());
+
+        for (std::uint32_t& index : indices_)
+        {
+            if (index != g_nullRestartIndex)
+                index = static_cast<std::uint32_t>(std::lower_bound(vertexIDs_.begin(), vertexIDs_.end(), index) - vertexIDs_.begin());
+        }
+
+        for (std::uint32_t& vertexID : vertexIDs_)
+            vertexID = static_cast<std::uint32_t>(static_cast<std::int32_t>(vertexID) + args.vertexOffset);
+    }
+    else
+    {
+        for (std::uint32_t& index : indices_)
+        {
+            if (index != g_nullRestartIndex)
+                index -= minIndex;
+        }
+    }
+
+    for_range(instance, args.numInstances)
+    {
+        if (isSparse)
+            TransformVertices(vertexIDs_.data(), vertexIDs_.size(), 0, args.firstInstance + instance, vertexBuffers, numVertexBuffers);
+        else
+            TransformVertices(nullptr, numRangeVertices, static_cast<std::uint32_t>(static_cast<std::int32_t>(minIndex) + args.vertexOffset), args.firstInstance + instance, vertexBuffers, numVertexBuffers);
+        DrawPrimitives(indices_.data(), indices_.size());
+    }
+}
+
+
+
+/* ----- Compute ----- */
+
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+// Input slots for the built-in variables of compute shaders.
+struct NullComputeBuiltins
+{
+    const SpirvProgram::InterfaceSlot* localInvocationID    = nullptr;
+    const SpirvProgram::InterfaceSlot* localInvocationIndex = nullptr;
+    const SpirvProgram::InterfaceSlot* globalInvocationID   = nullptr;
+    const SpirvProgram::InterfaceSlot* workGroupID          = nullptr;
+    const SpirvProgram::InterfaceSlot* numWorkGroups        = nullptr;
+};
+
+static void WriteComputeBuiltin(SpirvInterpreter& interpreter, const SpirvProgram::InterfaceSlot* slot, std::uint32_t lane, const std::uint32_t* values)
+{
+    if (slot != nullptr)
+    {
+        if (SpirvValue* dst = interpreter.GetSlotData(*slot, lane))
+        {
+            for_range(c, std::min(slot->numComponents, 3u))
+                dst[c].u = values[c];
+        }
+    }
+}
+
+// Dispatch arguments that are shared by all workgroups.
+struct NullComputeDispatch
+{
+    const SpirvProgram*     program;
+    NullComputeBuiltins     builtins;
+    std::uint32_t           numWorkGroups[3];
+    std::uint32_t           localSize[3];
+    std::uint32_t           numInvocations;     // Number of invocations per workgroup.
+    std::uint32_t           numBatches;         // Number of lane batches per workgroup.
+};
+
+/*
+Executes a single workgroup. Without barriers, all batches of the workgroup run one after another on the same interpreter.
+With barriers, each batch has its own interpreter and all batches are resumed in turns until they have finished.
+*/
+static void ExecuteWorkGroup(
+    const NullComputeDispatch&              dispatch,
+    const std::uint32_t                     (&workGroupID)[3],
+    const std::vector<SpirvInterpreter*>&   interpreters,
+    std::vector<SpirvInterpreter::Status>&  statuses)
+{
+    const bool hasBarriers = (interpreters.size() > 1);
+
+    for_range(batch, dispatch.numBatches)
+    {
+        SpirvInterpreter& interpreter = *interpreters[hasBarriers ? batch : 0];
+
+        const std::uint32_t firstInvocation = batch * g_spirvNumLanes;
+        const std::uint32_t numLanes        = std::min(g_spirvNumLanes, dispatch.numInvocations - firstInvocation);
+
+        for_range(lane, numLanes)
+        {
+            const std::uint32_t localIndex = firstInvocation + lane;
+            const std::uint32_t localID[3] =
+            {
+                localIndex % dispatch.localSize[0],
+                (localIndex / dispatch.localSize[0]) % dispatch.localSize[1],
+                localIndex / (dispatch.localSize[0] * dispatch.localSize[1]),
+            };
+            const std::uint32_t globalID[3] =
+            {
+                workGroupID[0] * dispatch.localSize[0] + localID[0],
+                workGroupID[1] * dispatch.localSize[1] + localID[1],
+                workGroupID[2] * dispatch.localSize[2] + localID[2],
+            };
+
+            WriteComputeBuiltin(interpreter, dispatch.builtins.localInvocationID, lane, localID);
+            WriteComputeBuiltin(interpreter, dispatch.builtins.localInvocationIndex, lane, &localIndex);
+            WriteComputeBuiltin(interpreter, dispatch.builtins.globalInvocationID, lane, globalID);
+            WriteComputeBuiltin(interpreter, dispatch.builtins.workGroupID, lane, workGroupID);
+            WriteComputeBuiltin(interpreter, dispatch.builtins.numWorkGroups, lane, dispatch.numWorkGroups);
+        }
+
+        statuses[batch] = interpreter.Execute((1u << numLanes) - 1u);
+    }
+
+    if (hasBarriers)
+    {
+        /* All batches have arrived at the barrier when each one has been executed, so resume them in turns */
+        for (bool isWaiting = true; isWaiting;)
+        {
+            isWaiting = false;
+            for_range(batch, dispatch.numBatches)
+            {
+                if (statuses[batch] == SpirvInterpreter::Status::Barrier)
+                {
+                    statuses[batch] = interpreters[batch]->Resume();
+                    isWaiting = true;
+                }
+            }
+        }
+    }
+}
+
+void NullCommandContext::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    const SpirvProgram* program = computeStage_.GetProgram();
+    if (computePipelineState_ == nullptr || program == nullptr || !renderConditionPassed_)
+        return;
+
+    const std::size_t numWorkGroupsTotal = static_cast<std::size_t>(numWorkGroupsX) * numWorkGroupsY * numWorkGroupsZ;
+    if (numWorkGroupsTotal == 0)
+        return;
+
+    bindings_.pipelineLayout = LLGL_CAST(const NullPipelineLayout*, computePipelineState_->computeDesc.pipelineLayout);
+    computeStage_.UpdateBindings(bindings_);
+
+    /* Gather dispatch arguments and built-in input slots */
+    NullComputeDispatch dispatch;
+    dispatch.program            = program;
+    dispatch.numWorkGroups[0]   = numWorkGroupsX;
+    dispatch.numWorkGroups[1]   = numWorkGroupsY;
+    dispatch.numWorkGroups[2]   = numWorkGroupsZ;
+
+    for_range(i, 3u)
+        dispatch.localSize[i] = std::max(1u, program->GetExecutionModes().localSize[i]);
+
+    dispatch.numInvocations = dispatch.localSize[0] * dispatch.localSize[1] * dispatch.localSize[2];
+    dispatch.numBatches     = (dispatch.numInvocations + g_spirvNumLanes - 1) / g_spirvNumLanes;
+
+    counters_.statistics.computeShaderInvocations += numWorkGroupsTotal * dispatch.numInvocations;
+
+    for (const SpirvProgram::InterfaceSlot& slot : program->GetInputs())
+    {
+        switch (slot.builtin)
+        {
+            case spv::BuiltInLocalInvocationId:     dispatch.builtins.localInvocationID     = &slot; break;
+            case spv::BuiltInLocalInvocationIndex:  dispatch.builtins.localInvocationIndex  = &slot; break;
+            case spv::BuiltInGlobalInvocationId:    dispatch.builtins.globalInvocationID    = &slot; break;
+            case spv::BuiltInWorkgroupId:           dispatch.builtins.workGroupID           = &slot; break;
+            case spv::BuiltInNumWorkgroups:         dispatch.builtins.numWorkGroups         = &slot; break;
+            default:                                                                                 break;
+        }
+    }
+
+    /*
+    Distribute workgroups across the worker threads. The range is split into more chunks than threads,
+    so threads that finish early pick up remaining chunks. Each chunk shares its interpreters and workgroup memory across its workgroups.
+    */
+    const unsigned      maxThreadCount  = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned      numChunks       = static_cast<unsigned>(std::min<std::size_t>(numWorkGroupsTotal, maxThreadCount * 4u));
+    const std::size_t   numInterpreters = (program->HasBarriers() ? dispatch.numBatches : 1u);
+    const std::size_t   sharedMemSize   = program->GetWorkgroupStorageSize();
+
+    DoConcurrentRange(
+        [this, &dispatch, numInterpreters, sharedMemSize](std::size_t begin, std::size_t end)
+        {
+            std::vector<SpirvInterpreter*> interpreters(numInterpreters, nullptr);
+            std::vector<SpirvInterpreter::Status> statuses(dispatch.numBatches, SpirvInterpreter::Status::Finished);
+            std::vector<SpirvValue> sharedMemory(sharedMemSize);
+
+            for (SpirvInterpreter*& interpreter : interpreters)
+            {
+                interpreter = computeStage_.AcquireInterpreter();
+                interpreter->SetWorkgroupMemory(sharedMemory.data());
+            }
+
+            for_subrange(i, begin, end)
+            {
+                /* Workgroup memory is undefined at the start of a workgroup, but is cleared for deterministic results */
+                if (sharedMemSize > 0)
+                    ::memset(sharedMemory.data(), 0, sharedMemSize * sizeof(SpirvValue));
+
+                const std::uint32_t index = static_cast<std::uint32_t>(i);
+                const std::uint32_t workGroupID[3] =
+                {
+                    index % dispatch.numWorkGroups[0],
+                    (index / dispatch.numWorkGroups[0]) % dispatch.numWorkGroups[1],
+                    index / (dispatch.numWorkGroups[0] * dispatch.numWorkGroups[1]),
+                };
+                ExecuteWorkGroup(dispatch, workGroupID, interpreters, statuses);
+            }
+
+            for (SpirvInterpreter* interpreter : interpreters)
+            {
+                interpreter->SetWorkgroupMemory(nullptr);
+                computeStage_.ReleaseInterpreter(interpreter);
+            }
+        },
+        numWorkGroupsTotal,
+        numChunks,
+        1
+    );
+}
+
+void NullCommandContext::DispatchIndirect(const NullBuffer* buffer, std::uint64_t offset)
+{
+    /* Out-of-bounds arguments are ignored */
+    DispatchIndirectArguments args;
+    if (buffer != nullptr && offset + sizeof(args) <= buffer->desc.size)
+    {
+        ::memcpy(&args, static_cast<const char*>(buffer->GetData()) + offset, sizeof(args));
+        Dispatch(args.numThreadGroups[0], args.numThreadGroups[1], args.numThreadGroups[2]);
+    }
+}
+
+#else // LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+void NullCommandContext::Dispatch(std::uint32_t /*numWorkGroupsX*/, std::uint32_t /*numWorkGroupsY*/, std::uint32_t /*numWorkGroupsZ*/)
+{
+    // dummy
+}
+
+void NullCommandContext::DispatchIndirect(const NullBuffer* /*buffer*/, std::uint64_t /*offset*/)
+{
+    // dummy
+}
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+
+/* ----- Queries ----- */
+
+void NullCommandContext::BeginQuery(NullQueryHeap* queryHeap, std::uint32_t query)
+{
+    queryHeap->Begin(query, counters_);
+}
+
+void NullCommandContext::EndQuery(NullQueryHeap* queryHeap, std::uint32_t query)
+{
+    queryHeap->End(query, counters_);
+}
+
+void NullCommandContext::BeginRenderCondition(const NullQueryHeap* queryHeap, std::uint32_t query, const RenderConditionMode mode)
+{
+    /* Commands are executed in order, so results of ended queries are always available; otherwise, rendering is not discarded */
+    std::uint64_t result = 0;
+    if (queryHeap->GetResult(query, result))
+    {
+        switch (mode)
+        {
+            case RenderConditionMode::WaitInverted:
+            case RenderConditionMode::NoWaitInverted:
+            case RenderConditionMode::ByRegionWaitInverted:
+            case RenderConditionMode::ByRegionNoWaitInverted:
+                renderConditionPassed_ = (result == 0);
+                break;
+            default:
+                renderConditionPassed_ = (result != 0);
+                break;
+        }
+    }
+    else
+        renderConditionPassed_ = true;
+}
+
+void NullCommandContext::EndRenderCondition()
+{
+    renderConditionPassed_ = true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+// Resolves the source of the vertex attribute from the vertex buffer that is bound to the slot of the attribute.
+static void ResolveVertexAttribSource(
+    const VertexAttribute&          attrib,
+    const NullVertexBufferBinding*  vertexBuffers,
+    std::size_t                     numVertexBuffers,
+    NullVertexAttribSource&         outSource)
+{
+    outSource.data = nullptr;
+
+    if (attrib.slot < numVertexBuffers && vertexBuffers[attrib.slot].buffer != nullptr)
+    {
+        const NullVertexBufferBinding& binding = vertexBuffers[attrib.slot];
+        ResolveVertexAttribSource(attrib, binding.buffer->GetData(), binding.buffer->desc.size, binding.stride, outSource);
+    }
+}
+
+// Fetches a vertex attribute and converts it to float.
+static void FetchVertexAttribFloat(const NullVertexAttribSource& source, std::uint32_t vertexID, std::uint32_t instance, float outValue[4])
+{
+    NullVertexValue value[4];
+    FetchVertexAttrib(source, vertexID, instance, value);
+    ConvertVertexAttribToFloat(source, value, outValue);
+}
+
+void NullCommandContext::TransformVertices(
+    const std::uint32_t*            vertexIDs,
+    std::size_t                     numVertices,
+    std::uint32_t                   firstVertex,
+    std::uint32_t                   instance,
+    const NullVertexBufferBinding*  vertexBuffers,
+    std::size_t                     numVertexBuffers)
+{
+    counters_.statistics.vertexShaderInvocations += numVertices;
+
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    if (vertexStage_.GetProgram() != nullptr)
+    {
+        ExecuteVertexShader(vertexIDs, numVertices, firstVertex, instance, vertexBuffers, numVertexBuffers);
+        return;
+    }
+    #endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+    /* Resolve vertex attribute sources */
+    NullVertexAttribSource sources[g_nullMaxVaryings + 1];
+    const std::size_t numSources = std::min<std::size_t>(numVertexAttribs_, g_nullMaxVaryings + 1);
+
+    for_range(i, numSources)
+    {
+        /* Order attributes by position first, followed by all other attributes as varyings */
+        const std::size_t attribIndex = (i == 0 ? positionAttrib_ : (i <= positionAttrib_ ? i - 1 : i));
+        ResolveVertexAttribSource(vertexAttribs_[attribIndex], vertexBuffers, numVertexBuffers, sources[i]);
+    }
+
+    /* Fetch vertices concurrently */
+    vertices_.resize(numVertices);
+
+    DoConcurrentRange(
+        [this, vertexIDs, firstVertex, instance, &sources, numSources](std::size_t begin, std::size_t end)
+        {
+            for_subrange(i, begin, end)
+            {
+                const std::uint32_t vertexID = (vertexIDs != nullptr ? vertexIDs[i] : firstVertex + static_cast<std::uint32_t>(i));
+                NullVertex& vertex = vertices_[i];
+
+                if (numSources > 0)
+                    FetchVertexAttribFloat(sources[0], vertexID, instance, vertex.position);
+                else
+                {
+                    vertex.position[0] = 0.0f;
+                    vertex.position[1] = 0.0f;
+                    vertex.position[2] = 0.0f;
+                    vertex.position[3] = 1.0f;
+                }
+
+                for_subrange(j, 1, numSources)
+                    FetchVertexAttribFloat(sources[j], vertexID, instance, vertex.varyings[j - 1]);
+            }
+        },
+        numVertices,
+        LLGL_MAX_THREAD_COUNT,
+        256
+    );
+}
+
+void NullCommandContext::DrawPrimitives(const std::uint32_t* indices, std::size_t numIndices)
+{
+    const PrimitiveTopology topology = pipelineState_->graphicsDesc.primitiveTopology;
+    const std::size_t numPrimitives = AssemblePrimitives(topology, indices, numIndices, primitives_);
+
+    /* Expand lines and points into triangles, which are never culled */
+    const NullPrimitiveType primitiveType = GetPrimitiveType(topology);
+    const std::uint32_t* triangles = primitives_.data();
+    std::size_t numTriangles = numPrimitives;
+    const CullMode cullMode = rasterState_.cullMode;
+
+    if (primitiveType == NullPrimitiveType::Line || primitiveType == NullPrimitiveType::Point)
+    {
+        if (primitiveType == NullPrimitiveType::Line)
+            ExpandLinesToTriangles(rasterState_.viewport, pipelineState_->graphicsDesc.rasterizer.lineWidth, primitives_.data(), numPrimitives, vertices_, triangles_);
+        else
+            ExpandPointsToTriangles(rasterState_.viewport, 1.0f, primitives_.data(), numPrimitives, vertices_, triangles_);
+        triangles               = triangles_.data();
+        numTriangles            = triangles_.size() / 3;
+        rasterState_.cullMode   = CullMode::Disabled;
+    }
+
+    /* Count assembled vertices without restart indices */
+    QueryPipelineStatistics& statistics = counters_.statistics;
+    statistics.inputAssemblyVertices    += static_cast<std::uint64_t>(numIndices - std::count(indices, indices + numIndices, g_nullRestartIndex));
+    statistics.inputAssemblyPrimitives  += numPrimitives;
+
+    NullRasterStatistics rasterStatistics;
+    rasterizer_.DrawTriangles(framebuffer_, rasterState_, vertices_.data(), triangles, numTriangles, rasterStatistics);
+    rasterState_.cullMode = cullMode;
+
+    statistics.clippingInvocations          += rasterStatistics.clippingInvocations;
+    statistics.clippingPrimitives           += rasterStatistics.clippingPrimitives;
+    statistics.fragmentShaderInvocations    += rasterStatistics.fragmentShaderInvocations;
+    counters_.samplesPassed                 += rasterStatistics.samplesPassed;
+}
+
+bool NullCommandContext::UpdateRasterState()
+{
+    if (pipelineState_ == nullptr || !framebuffer_.IsActive())
+        return false;
+
+    const GraphicsPipelineDescriptor& desc = pipelineState_->graphicsDesc;
+
+    /* Static viewports and scissors of the PSO take precedence; without any, the entire framebuffer is used */
+    const float framebufferWidth    = static_cast<float>(framebuffer_.GetWidth());
+    const float framebufferHeight   = static_cast<float>(framebuffer_.GetHeight());
+
+    if (!desc.viewports.empty())
+        rasterState_.viewport = desc.viewports.front();
+    else if (!viewports_.empty())
+        rasterState_.viewport = viewports_.front();
+    else
+        rasterState_.viewport = Viewport{ 0.0f, 0.0f, framebufferWidth, framebufferHeight };
+
+    if (!desc.scissors.empty())
+        rasterState_.scissor = desc.scissors.front();
+    else if (!scissors_.empty())
+        rasterState_.scissor = scissors_.front();
+    else
+        rasterState_.scissor = Scissor{ 0, 0, static_cast<std::int32_t>(framebuffer_.GetWidth()), static_cast<std::int32_t>(framebuffer_.GetHeight()) };
+
+    /* Apply dynamic states */
+    if (desc.blend.blendFactorDynamic)
+    {
+        for_range(i, 4)
+            rasterState_.blend.blendFactor[i] = blendFactor_[i];
+    }
+
+    if (desc.stencil.referenceDynamic)
+    {
+        rasterState_.stencil.front.reference    = stencilReference_[0];
+        rasterState_.stencil.back.reference     = stencilReference_[1];
+    }
+
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    bindings_.pipelineLayout = LLGL_CAST(const NullPipelineLayout*, desc.pipelineLayout);
+    vertexStage_.UpdateBindings(bindings_);
+    fragmentStage_.UpdateBindings(bindings_);
+    #endif
+
+    return true;
+}
+
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+// Converts a shader interface value to a float, so integers can be passed through the rasterizer by value.
+static float InterfaceValueToFloat(SpirvValue value, SpirvScalarKind kind)
+{
+    switch (kind)
+    {
+        case SpirvScalarKind::SInt: return static_cast<float>(value.s);
+        case SpirvScalarKind::UInt: return static_cast<float>(value.u);
+        case SpirvScalarKind::Bool: return (value.u != 0 ? 1.0f : 0.0f);
+        default:                    return value.f;
+    }
+}
+
+static SpirvValue FloatToInterfaceValue(float f, SpirvScalarKind kind)
+{
+    SpirvValue value;
+    switch (kind)
+    {
+        case SpirvScalarKind::SInt: value.s = static_cast<std::int32_t>(std::floor(f + 0.5f));                          break;
+        case SpirvScalarKind::UInt: value.u = static_cast<std::uint32_t>(std::max(0.0f, std::floor(f + 0.5f)));        break;
+        case SpirvScalarKind::Bool: value.u = (f != 0.0f ? 1u : 0u);                                                    break;
+        default:                    value.f = f;                                                                        break;
+    }
+    return value;
+}
+
+static void ExecuteFragmentShader(const NullShaderStage& stage, NullFragmentQuad& quad)
+{
+    SpirvInterpreter* interpreter = stage.AcquireInterpreter();
+    if (interpreter == nullptr)
+        return;
+
+    const SpirvProgram& program = interpreter->GetProgram();
+    const bool pixelCenterInteger = program.GetExecutionModes().pixelCenterInteger;
+
+    /* Write fragment inputs; integer varyings are flat and have been passed through as float values */
+    for (const SpirvProgram::InterfaceSlot& slot : program.GetInputs())
+    {
+        for_range(lane, 4u)
+        {
+            SpirvValue* dst = interpreter->GetSlotData(slot, lane);
+            if (dst == nullptr)
+                continue;
+
+            switch (slot.builtin)
+            {
+                case spv::BuiltInFragCoord:
+                    for_range(c, std::min(slot.numComponents, 4u))
+                        dst[c].f = quad.fragCoord[c][lane] - (pixelCenterInteger && c < 2 ? 0.5f : 0.0f);
+                    break;
+
+                case spv::BuiltInFrontFacing:
+                    dst[0].u = (quad.frontFacing ? 1u : 0u);
+                    break;
+
+                case spv::BuiltInHelperInvocation:
+                    dst[0].u = (((quad.mask >> lane) & 1u) == 0 ? 1u : 0u);
+                    break;
+
+                case spv::BuiltInMax:
+                    if (slot.location < g_nullMaxVaryings)
+                    {
+                        for_range(c, std::min(slot.numComponents, 4u - std::min(slot.component, 4u)))
+                            dst[c] = FloatToInterfaceValue(quad.varyings[slot.location][slot.component + c][lane], slot.kind);
+                    }
+                    break;
+
+                default:
+                    for_range(c, slot.numComponents)
+                        dst[c].u = 0;
+                    break;
+            }
+        }
+    }
+
+    /* Execute all lanes of the quad; uncovered lanes are helper invocations for derivatives */
+    interpreter->Execute(g_spirvAllLanes, ~quad.mask & g_spirvAllLanes);
+    quad.mask &= interpreter->GetAliveMask();
+
+    /* Read fragment outputs */
+    for (const SpirvProgram::InterfaceSlot& slot : program.GetOutputs())
+    {
+        for_range(lane, 4u)
+        {
+            const SpirvValue* src = interpreter->GetSlotData(slot, lane);
+            if (src == nullptr)
+                continue;
+
+            if (slot.builtin == spv::BuiltInFragDepth)
+                quad.fragDepth[lane] = src[0].f;
+            else if (slot.builtin == spv::BuiltInMax && slot.location + slot.index < LLGL_MAX_NUM_COLOR_ATTACHMENTS)
+            {
+                /* Second output of dual-source blending (index 1) is passed to the blend stage in place of the next color attachment */
+                const std::uint32_t target = slot.location + slot.index;
+                for_range(c, std::min(slot.numComponents, 4u - std::min(slot.component, 4u)))
+                    quad.colors[target][slot.component + c][lane] = InterfaceValueToFloat(src[c], slot.kind);
+            }
+        }
+    }
+
+    stage.ReleaseInterpreter(interpreter);
+}
+
+bool NullCommandContext::SetupShaderStages(const GraphicsPipelineDescriptor& desc)
+{
+    vertexStage_.Reset(desc.vertexShader != nullptr ? LLGL_CAST(const NullShader*, desc.vertexShader) : nullptr);
+    fragmentStage_.Reset(desc.fragmentShader != nullptr ? LLGL_CAST(const NullShader*, desc.fragmentShader) : nullptr);
+
+    /* Without an executable vertex shader, the varyings of the fragment shader cannot be provided */
+    const SpirvProgram* vertexProgram = vertexStage_.GetProgram();
+    if (vertexProgram == nullptr)
+    {
+        fragmentStage_.Reset(nullptr);
+        return false;
+    }
+
+    /* Forward all vertex outputs by their location */
+    std::uint32_t numVaryings = 0;
+    for (const SpirvProgram::InterfaceSlot& slot : vertexProgram->GetOutputs())
+    {
+        if (slot.builtin == spv::BuiltInMax && slot.location < g_nullMaxVaryings)
+            numVaryings = std::max(numVaryings, slot.location + 1);
+    }
+    rasterState_.numVaryings = numVaryings;
+
+    if (const SpirvProgram* fragmentProgram = fragmentStage_.GetProgram())
+    {
+        /* Integer varyings are always flat */
+        for (const SpirvProgram::InterfaceSlot& slot : fragmentProgram->GetInputs())
+        {
+            if (slot.builtin == spv::BuiltInMax && slot.location < g_nullMaxVaryings && (slot.flat || slot.kind != SpirvScalarKind::Float))
+                rasterState_.flatVaryingMask |= (1u << slot.location);
+        }
+
+        /* Depth and stencil tests can only be performed early if the fragment shader neither discards fragments nor writes depth */
+        const SpirvProgram::ExecutionModes& modes = fragmentProgram->GetExecutionModes();
+        rasterState_.earlyFragmentTests = (modes.earlyFragmentTests || (!fragmentProgram->HasKill() && !modes.depthReplacing));
+
+        const NullShaderStage* stage = &fragmentStage_;
+        rasterState_.fragmentShader = [stage](NullFragmentQuad& quad)
+        {
+            ExecuteFragmentShader(*stage, quad);
+        };
+    }
+    else if (desc.fragmentShader != nullptr)
+    {
+        /* Fragment shader cannot be executed, so pass through the first varying */
+        return false;
+    }
+
+    return true;
+}
+
+// Vertex shader input with its resolved vertex attribute source.
+struct NullVertexShaderInput
+{
+    const SpirvProgram::InterfaceSlot*  slot;
+    NullVertexAttribSource              source;
+};
+
+void NullCommandContext::ExecuteVertexShader(
+    const std::uint32_t*            vertexIDs,
+    std::size_t                     numVertices,
+    std::uint32_t                   firstVertex,
+    std::uint32_t                   instance,
+    const NullVertexBufferBinding*  vertexBuffers,
+    std::size_t                     numVertexBuffers)
+{
+    const SpirvProgram& program = *vertexStage_.GetProgram();
+
+    /* Resolve vertex attribute sources by their location */
+    std::vector<NullVertexShaderInput> inputs;
+    inputs.reserve(program.GetInputs().size());
+
+    for (const SpirvProgram::InterfaceSlot& slot : program.GetInputs())
+    {
+        NullVertexShaderInput input;
+        input.slot          = &slot;
+        input.source.data   = nullptr;
+
+        if (slot.builtin == spv::BuiltInMax)
+        {
+            for_range(i, numVertexAttribs_)
+            {
+                if (vertexAttribs_[i].location == slot.location && vertexAttribs_[i].systemValue == SystemValue::Undefined)
+                {
+                    ResolveVertexAttribSource(vertexAttribs_[i], vertexBuffers, numVertexBuffers, input.source);
+                    break;
+                }
+            }
+        }
+
+        inputs.push_back(input);
+    }
+
+    /* Execute vertex shader concurrently in batches of g_spirvNumLanes vertices */
+    vertices_.resize(numVertices);
+
+    const std::uint32_t numVaryings = rasterState_.numVaryings;
+    const std::size_t numBatches = (numVertices + g_spirvNumLanes - 1) / g_spirvNumLanes;
+
+    DoConcurrentRange(
+        [this, &program, &inputs, vertexIDs, numVertices, firstVertex, instance, numVaryings](std::size_t begin, std::size_t end)
+        {
+            SpirvInterpreter* interpreter = vertexStage_.AcquireInterpreter();
+            if (interpreter == nullptr)
+                return;
+
+            for_subrange(batch, begin, end)
+            {
+                const std::size_t   firstLane   = batch * g_spirvNumLanes;
+                const std::uint32_t numLanes    = static_cast<std::uint32_t>(std::min<std::size_t>(g_spirvNumLanes, numVertices - firstLane));
+
+                /* Write vertex inputs */
+                for_range(lane, numLanes)
+                {
+                    const std::uint32_t vertexID = (vertexIDs != nullptr ? vertexIDs[firstLane + lane] : firstVertex + static_cast<std::uint32_t>(firstLane + lane));
+
+                    for (const NullVertexShaderInput& input : inputs)
+                    {
+                        const SpirvProgram::InterfaceSlot& slot = *input.slot;
+                        SpirvValue* dst = interpreter->GetSlotData(slot, lane);
+                        if (dst == nullptr)
+                            continue;
+
+                        switch (slot.builtin)
+                        {
+                            case spv::BuiltInVertexIndex:
+                            case spv::BuiltInVertexId:
+                                dst[0].u = vertexID;
+                                break;
+
+                            case spv::BuiltInInstanceIndex:
+                            case spv::BuiltInInstanceId:
+                                dst[0].u = instance;
+                                break;
+
+                            case spv::BuiltInMax:
+                            {
+                                /* Pass integer attributes to integer inputs by value, all others are converted from float */
+                                NullVertexValue value[4];
+                                FetchVertexAttrib(input.source, vertexID, instance, value);
+
+                                const std::uint32_t numComponents = std::min(slot.numComponents, 4u - std::min(slot.component, 4u));
+                                if (input.source.isInteger && (slot.kind == SpirvScalarKind::SInt || slot.kind == SpirvScalarKind::UInt))
+                                {
+                                    for_range(c, numComponents)
+                                        dst[c].u = value[slot.component + c].u;
+                                }
+                                else
+                                {
+                                    float valueFloat[4];
+                                    ConvertVertexAttribToFloat(input.source, value, valueFloat);
+                                    for_range(c, numComponents)
+                                        dst[c] = FloatToInterfaceValue(valueFloat[slot.component + c], slot.kind);
+                                }
+                            }
+                            break;
+
+                            default:
+                                for_range(c, slot.numComponents)
+                                    dst[c].u = 0;
+                                break;
+                        }
+                    }
+                }
+
+                interpreter->Execute((1u << numLanes) - 1u);
+
+                /* Read vertex outputs into post-transform vertex cache */
+                for_range(lane, numLanes)
+                {
+                    NullVertex& vertex = vertices_[firstLane + lane];
+
+                    vertex.position[0] = 0.0f;
+                    vertex.position[1] = 0.0f;
+                    vertex.position[2] = 0.0f;
+                    vertex.position[3] = 1.0f;
+
+                    for_range(varying, numVaryings)
+                    {
+                        for_range(c, 4u)
+                            vertex.varyings[varying][c] = 0.0f;
+                    }
+
+                    for (const SpirvProgram::InterfaceSlot& slot : program.GetOutputs())
+                    {
+                        const SpirvValue* src = interpreter->GetSlotData(slot, lane);
+                        if (src == nullptr)
+                            continue;
+
+                        if (slot.builtin == spv::BuiltInPosition)
+                        {
+                            for_range(c, std::min(slot.numComponents, 4u))
+                                vertex.position[c] = src[c].f;
+                        }
+                        else if (slot.builtin == spv::BuiltInMax && slot.location < numVaryings)
+                        {
+                            for_range(c, std::min(slot.numComponents, 4u - std::min(slot.component, 4u)))
+                                vertex.varyings[slot.location][slot.component + c] = InterfaceValueToFloat(src[c], slot.kind);
+                        }
+                    }
+                }
+            }
+
+            vertexStage_.ReleaseInterpreter(interpreter);
+        },
+        numBatches,
+        LLGL_MAX_THREAD_COUNT,
+        64
+    );
+}
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,200 @@
+/*
+ * NullCommandContext.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_COMMAND_CONTEXT_H
+#define LLGL_NULL_COMMAND_CONTEXT_H
+
+
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/IndirectArguments.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/VertexAttribute.h>
+#include <LLGL/TextureFlags.h>
+#include "../Raster/NullFramebuffer.h"
+#include "../Raster/NullRasterizer.h"
+#include "../RenderState/NullResourceBindings.h"
+#include "../RenderState/NullQueryHeap.h"
+#include <vector>
+
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+#   include "../Shader/NullShaderStage.h"
+#endif
+
+
+namespace LLGL
+{
+
+
+class RenderTarget;
+class NullBuffer;
+class NullTexture;
+class NullRenderPass;
+class NullPipelineState;
+
+// Vertex buffer with the stride it is bound with. A stride of 0 uses the stride of the vertex attributes of the bound PSO.
+struct NullVertexBufferBinding
+{
+    const NullBuffer*   buffer;
+    std::uint32_t       stride;
+};
+
+// Vertex and index buffers of a primary command buffer, which are inherited by draw commands of a secondary command buffer without their own bindings.
+struct NullInheritedBuffers
+{
+    const NullVertexBufferBinding*  vertexBuffers       = nullptr;
+    std::size_t                     numVertexBuffers    = 0;
+    const NullBuffer*               indexBuffer         = nullptr;
+    Format                          indexFormat         = Format::Undefined;
+    std::uint64_t                   indexBufferOffset   = 0;
+};
+
+// State of the Null command executor, i.e. the active render pass and the bound pipeline state.
+class NullCommandContext
+{
+
+    public:
+
+        void BeginRenderPass(
+            RenderTarget&           renderTarget,
+            bool                    isSwapChain,
+            const NullRenderPass*   renderPass,
+            std::uint32_t           numClearValues,
+            const ClearValue*       clearValues
+        );
+
+        void EndRenderPass();
+
+        void Clear(long flags, const ClearValue& clearValue);
+        void ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments);
+
+        // Copies a region of the first color attachment of the active render pass into the texture.
+        void CopyTextureFromFramebuffer(NullTexture* texture, const TextureRegion& dstRegion, const Offset2D& srcOffset);
+
+        void SetViewports(std::uint32_t numViewports, const Viewport* viewports);
+        void SetScissors(std::uint32_t numScissors, const Scissor* scissors);
+
+        void SetPipelineState(const NullPipelineState* pipelineState);
+        void SetBlendFactor(const float color[4]);
+        void SetStencilReference(std::uint32_t reference, const StencilFace stencilFace);
+
+        void SetResourceHeap(const NullResourceHeap* resourceHeap, std::uint32_t descriptorSet);
+        void SetResource(std::uint32_t descriptor, Resource* resource);
+        void SetUniforms(std::uint32_t first, const void* data, std::uint16_t dataSize);
+
+        // Sets the buffers that are inherited while a secondary command buffer is executed.
+        inline void SetInheritedBuffers(const NullInheritedBuffers& inheritedBuffers)
+        {
+            inheritedBuffers_ = inheritedBuffers;
+        }
+
+        void Draw(
+            const DrawIndirectArguments&    args,
+            const NullVertexBufferBinding*  vertexBuffers,
+            std::size_t                     numVertexBuffers
+        );
+
+        void DrawIndexed(
+            const DrawIndexedIndirectArguments& args,
+            const NullBuffer*                   indexBuffer,
+            Format                              indexFormat,
+            std::uint64_t                       indexBufferOffset,
+            const NullVertexBufferBinding*      vertexBuffers,
+            std::size_t                         numVertexBuffers
+        );
+
+        void Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ);
+        void DispatchIndirect(const NullBuffer* buffer, std::uint64_t offset);
+
+        void BeginQuery(NullQueryHeap* queryHeap, std::uint32_t query);
+        void EndQuery(NullQueryHeap* queryHeap, std::uint32_t query);
+
+        // Draw and dispatch commands are discarded until the end of the render condition if the query result does not meet the condition.
+        void BeginRenderCondition(const NullQueryHeap* queryHeap, std::uint32_t query, const RenderConditionMode mode);
+        void EndRenderCondition();
+
+    private:
+
+        // Fetches and transforms the vertices with the specified vertex IDs into the post-transform vertex cache.
+        void TransformVertices(
+            const std::uint32_t*            vertexIDs,
+            std::size_t                     numVertices,
+            std::uint32_t                   firstVertex,
+            std::uint32_t                   instance,
+            const NullVertexBufferBinding*  vertexBuffers,
+            std::size_t                     numVertexBuffers
+        );
+
+        // Assembles primitives from the indices into the post-transform vertex cache and rasterizes them.
+        void DrawPrimitives(const std::uint32_t* indices, std::size_t numIndices);
+
+        // Updates the rasterizer state for the bound pipeline and dynamic states.
+        bool UpdateRasterState();
+
+        #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+        // Sets up the shader stages for the bound graphics pipeline. Returns false if the vertex shader is not executable.
+        bool SetupShaderStages(const GraphicsPipelineDescriptor& desc);
+
+        // Executes the vertex shader for batches of vertices and writes them into the post-transform vertex cache.
+        void ExecuteVertexShader(
+            const std::uint32_t*            vertexIDs,
+            std::size_t                     numVertices,
+            std::uint32_t                   firstVertex,
+            std::uint32_t                   instance,
+            const NullVertexBufferBinding*  vertexBuffers,
+            std::size_t                     numVertexBuffers
+        );
+
+        #endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+    private:
+
+        NullFramebuffer                 framebuffer_;
+        NullRasterizer                  rasterizer_;
+        NullRasterState                 rasterState_;
+
+        const NullPipelineState*        pipelineState_          = nullptr;  // Bound graphics PSO.
+        const NullPipelineState*        computePipelineState_   = nullptr;  // Bound compute PSO.
+        const NullPipelineState*        boundPipelineState_     = nullptr;  // Last bound PSO of either kind, which uniforms are written for.
+        const VertexAttribute*          vertexAttribs_          = nullptr;
+        std::size_t                     numVertexAttribs_       = 0;
+        std::size_t                     positionAttrib_         = 0;
+
+        std::vector<Viewport>           viewports_;
+        std::vector<Scissor>            scissors_;
+        float                           blendFactor_[4]         = { 0.0f, 0.0f, 0.0f, 0.0f };
+        std::uint32_t                   stencilReference_[2]    = { 0, 0 }; // Front and back stencil reference values.
+
+        std::vector<NullVertex>         vertices_;
+        std::vector<std::uint32_t>      vertexIDs_;
+        std::vector<std::uint32_t>      indices_;
+        std::vector<std::uint32_t>      primitives_;
+        std::vector<std::uint32_t>      triangles_;
+
+        NullResourceBindings            bindings_;
+        NullInheritedBuffers            inheritedBuffers_;
+
+        NullQueryCounters               counters_;
+        bool                            renderConditionPassed_  = true;
+
+        #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+        NullShaderStage                 vertexStage_;
+        NullShaderStage                 fragmentStage_;
+        NullShaderStage                 computeStage_;
+        #endif
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -20,85 +20,481 @@
 #include "../RenderState/NullQueryHeap.h"
 
 #include "../../CheckedCast.h"
+#include "../../../Core/Assertion.h"
 
 
 namespace LLGL
 {
 
 
-static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
+static TextureLocation GetTextureLocation(const NullTexture& texture, std::uint32_t subresource, std::uint64_t x, std::uint32_t y, std::uint32_t z)
 {
-    switch (opcode)
+    TextureLocation location{ Offset3D{ static_cast<std::int32_t>(x), static_cast<std::int32_t>(y), static_cast<std::int32_t>(z) } };
+    texture.UnpackSubresourceIndex(subresource, location.mipLevel, location.arrayLayer);
+    return location;
+}
+
+static void CopyBufferFromTexture(NullBuffer& dstBuffer, const NullTexture& srcTexture, const NullCmdCopySubresource& cmd)
+{
+    if (cmd.dstX <= dstBuffer.desc.size)
     {
-        case NullOpcodeBufferWrite:
-        {
-            auto cmd = static_cast<const NullCmdBufferWrite*>(pc);
-            cmd->buffer->Write(cmd->offset, cmd + 1, cmd->size);
-            return (sizeof(*cmd) + cmd->size);
-        }
-        case NullOpcodeCopySubresource:
-        {
-            auto cmd = static_cast<const NullCmdCopySubresource*>(pc);
-            auto* dst = cmd->dstResource;
-            auto* src = cmd->srcResource;
-            if (dst->GetResourceType() == ResourceType::Buffer)
-            {
-                auto* dstBuffer = LLGL_CAST(NullBuffer*, dst);
-                if (src->GetResourceType() == ResourceType::Buffer)
-                {
-                    auto* srcBuffer = LLGL_CAST(const NullBuffer*, src);
-                    dstBuffer->CopyFromBuffer(cmd->dstX, *srcBuffer, cmd->srcX, cmd->width);
-                }
-                else if (src->GetResourceType() == ResourceType::Texture)
-                {
-                    //TODO
-                }
-            }
-            else if (dst->GetResourceType() == ResourceType::Texture)
-            {
-                //TODO
-            }
-            return sizeof(*cmd);
-        }
-        case NullOpcodeGenerateMips:
+        srcTexture.CopyToMemory(
+            GetTextureLocation(srcTexture, cmd.srcSubresource, cmd.srcX, cmd.srcY, cmd.srcZ),
+            Extent3D{ static_cast<std::uint32_t>(cmd.width), cmd.height, cmd.depth },
+            static_cast<char*>(dstBuffer.GetData()) + cmd.dstX,
+            static_cast<std::size_t>(dstBuffer.desc.size - cmd.dstX),
+            cmd.rowStride,
+            cmd.layerStride
+        );
+    }
+}
+
+static void CopyTextureFromBuffer(NullTexture& dstTexture, const NullBuffer& srcBuffer, const NullCmdCopySubresource& cmd)
+{
+    if (cmd.srcX <= srcBuffer.desc.size)
+    {
+        dstTexture.CopyFromMemory(
+            GetTextureLocation(dstTexture, cmd.dstSubresource, cmd.dstX, cmd.dstY, cmd.dstZ),
+            Extent3D{ static_cast<std::uint32_t>(cmd.width), cmd.height, cmd.depth },
+            static_cast<const char*>(srcBuffer.GetData()) + cmd.srcX,
+            static_cast<std::size_t>(srcBuffer.desc.size - cmd.srcX),
+            cmd.rowStride,
+            cmd.layerStride
+        );
+    }
+}
+
+static void CopyTextureFromTexture(NullTexture& dstTexture, const NullTexture& srcTexture, const NullCmdCopySubresource& cmd)
+{
+    dstTexture.CopyFromTexture(
+        GetTextureLocation(dstTexture, cmd.dstSubresource, cmd.dstX, cmd.dstY, cmd.dstZ),
+        srcTexture,
+        GetTextureLocation(srcTexture, cmd.srcSubresource, cmd.srcX, cmd.srcY, cmd.srcZ),
+        Extent3D{ static_cast<std::uint32_t>(cmd.width), cmd.height, cmd.depth }
+    );
+}
+
+static std::size_t ExecuteSecondaryCommandBuffer(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdExecute*>(pc);
+    NullInheritedBuffers inheritedBuffers;
+    {
+        inheritedBuffers.vertexBuffers      = reinterpret_cast<const NullVertexBufferBinding*>(cmd + 1);
+        inheritedBuffers.numVertexBuffers   = cmd->numVertexBuffers;
+        inheritedBuffers.indexBuffer        = cmd->indexBuffer;
+        inheritedBuffers.indexFormat        = cmd->indexBufferFormat;
+        inheritedBuffers.indexBufferOffset  = cmd->indexBufferOffset;
+    }
+    context.SetInheritedBuffers(inheritedBuffers);
+    cmd->commandBuffer->ExecuteVirtualCommands(context);
+    context.SetInheritedBuffers(NullInheritedBuffers{});
+    return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(NullVertexBufferBinding));
+}
+
+static std::size_t ExecuteBufferWrite(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdBufferWrite*>(pc);
+    cmd->buffer->Write(cmd->offset, cmd + 1, cmd->size);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t ExecuteBufferFill(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdBufferFill*>(pc);
+    cmd->buffer->Fill(cmd->offset, cmd->value, cmd->size);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteCopySubresource(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdCopySubresource*>(pc);
+    auto* dst = cmd->dstResource;
+    auto* src = cmd->srcResource;
+    if (dst->GetResourceType() == ResourceType::Buffer)
+    {
+        auto* dstBuffer = LLGL_CAST(NullBuffer*, dst);
+        if (src->GetResourceType() == ResourceType::Buffer)
         {
-            auto cmd = static_cast<const NullCmdGenerateMips*>(pc);
-            const TextureSubresource subresource{ cmd->baseArrayLayer, cmd->numArrayLayers, cmd->baseMipLevel, cmd->numMipLevels };
-            cmd->texture->GenerateMips(&subresource);
-            return sizeof(*cmd);
+            auto* srcBuffer = LLGL_CAST(const NullBuffer*, src);
+            dstBuffer->CopyFromBuffer(cmd->dstX, *srcBuffer, cmd->srcX, cmd->width);
         }
-        //TODO...
-        case NullOpcodeDraw:
+        else if (src->GetResourceType() == ResourceType::Texture)
         {
-            auto cmd = static_cast<const NullCmdDraw*>(pc);
-            //TODO
-            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+            auto* srcTexture = LLGL_CAST(const NullTexture*, src);
+            CopyBufferFromTexture(*dstBuffer, *srcTexture, *cmd);
         }
-        case NullOpcodeDrawIndexed:
+    }
+    else if (dst->GetResourceType() == ResourceType::Texture)
+    {
+        auto* dstTexture = LLGL_CAST(NullTexture*, dst);
+        if (src->GetResourceType() == ResourceType::Buffer)
         {
-            auto cmd = static_cast<const NullCmdDrawIndexed*>(pc);
-            //TODO
-            return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(const NullBuffer*));
+            auto* srcBuffer = LLGL_CAST(const NullBuffer*, src);
+            CopyTextureFromBuffer(*dstTexture, *srcBuffer, *cmd);
         }
-        case NullOpcodePushDebugGroup:
+        else if (src->GetResourceType() == ResourceType::Texture)
         {
-            auto cmd = static_cast<const NullCmdPushDebugGroup*>(pc);
-            //TODO
-            return (sizeof(*cmd) + cmd->length + 1);
+            auto* srcTexture = LLGL_CAST(const NullTexture*, src);
+            CopyTextureFromTexture(*dstTexture, *srcTexture, *cmd);
         }
-        case NullOpcodePopDebugGroup:
+    }
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteCopyFramebuffer(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdCopyFramebuffer*>(pc);
+    context.CopyTextureFromFramebuffer(cmd->texture, cmd->region, cmd->srcOffset);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGenerateMips(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdGenerateMips*>(pc);
+    const TextureSubresource subresource{ cmd->baseArrayLayer, cmd->numArrayLayers, cmd->baseMipLevel, cmd->numMipLevels };
+    cmd->texture->GenerateMips(&subresource);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetViewports(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdSetViewports*>(pc);
+    context.SetViewports(cmd->numViewports, reinterpret_cast<const Viewport*>(cmd + 1));
+    return (sizeof(*cmd) + cmd->numViewports * sizeof(Viewport));
+}
+
+static std::size_t ExecuteSetScissors(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdSetScissors*>(pc);
+    context.SetScissors(cmd->numScissors, reinterpret_cast<const Scissor*>(cmd + 1));
+    return (sizeof(*cmd) + cmd->numScissors * sizeof(Scissor));
+}
+
+static std::size_t ExecuteBeginRenderPass(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdBeginRenderPass*>(pc);
+    context.BeginRenderPass(*cmd->renderTarget, cmd->isSwapChain, cmd->renderPass, cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1));
+    return (sizeof(*cmd) + cmd->numClearValues * sizeof(ClearValue));
+}
+
+static std::size_t ExecuteEndRenderPass(const void* pc, NullCommandContext& context)
+{
+    context.EndRenderPass();
+    return 0;
+}
+
+static std::size_t ExecuteClear(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdClear*>(pc);
+    context.Clear(cmd->flags, cmd->clearValue);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteClearAttachments(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdClearAttachments*>(pc);
+    context.ClearAttachments(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
+    return (sizeof(*cmd) + cmd->numAttachments * sizeof(AttachmentClear));
+}
+
+static std::size_t ExecuteBindPipelineState(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdBindPipelineState*>(pc);
+    context.SetPipelineState(cmd->pipelineState);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetBlendFactor(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdSetBlendFactor*>(pc);
+    context.SetBlendFactor(cmd->color);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetStencilReference(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdSetStencilReference*>(pc);
+    context.SetStencilReference(cmd->reference, cmd->stencilFace);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetResourceHeap(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdSetResourceHeap*>(pc);
+    context.SetResourceHeap(cmd->resourceHeap, cmd->descriptorSet);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetResource(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdSetResource*>(pc);
+    context.SetResource(cmd->descriptor, cmd->resource);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetUniforms(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdSetUniforms*>(pc);
+    context.SetUniforms(cmd->first, cmd + 1, cmd->size);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t ExecuteDraw(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdDraw*>(pc);
+    context.Draw(cmd->args, reinterpret_cast<const NullVertexBufferBinding*>(cmd + 1), cmd->numVertexBuffers);
+    return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(NullVertexBufferBinding));
+}
+
+static std::size_t ExecuteDrawIndexed(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdDrawIndexed*>(pc);
+    context.DrawIndexed(
+        cmd->args, cmd->indexBuffer, cmd->indexBufferFormat, cmd->indexBufferOffset,
+        reinterpret_cast<const NullVertexBufferBinding*>(cmd + 1), cmd->numVertexBuffers
+    );
+    return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(NullVertexBufferBinding));
+}
+
+static std::size_t ExecuteDispatch(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdDispatch*>(pc);
+    context.Dispatch(cmd->numWorkGroups[0], cmd->numWorkGroups[1], cmd->numWorkGroups[2]);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDispatchIndirect(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdDispatchIndirect*>(pc);
+    context.DispatchIndirect(cmd->buffer, cmd->offset);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBeginQuery(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdQuery*>(pc);
+    context.BeginQuery(cmd->queryHeap, cmd->query);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteEndQuery(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdQuery*>(pc);
+    context.EndQuery(cmd->queryHeap, cmd->query);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBeginRenderCondition(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdBeginRenderCondition*>(pc);
+    context.BeginRenderCondition(cmd->queryHeap, cmd->query, cmd->mode);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteEndRenderCondition(const void* pc, NullCommandContext& context)
+{
+    context.EndRenderCondition();
+    return 0;
+}
+
+static std::size_t ExecutePushDebugGroup(const void* pc, NullCommandContext& context)
+{
+    auto cmd = static_cast<const NullCmdPushDebugGroup*>(pc);
+    //TODO
+    return (sizeof(*cmd) + cmd->length + 1);
+}
+
+static std::size_t ExecutePopDebugGroup(const void* pc, NullCommandContext& context)
+{
+    //TODO
+    return 0;
+}
+
+// Table of command functions indexed by NullOpcode.
+static const NullCommandFunc g_nullCommandFuncs[] =
+{
+    nullptr,                       // <invalid>
+    ExecuteSecondaryCommandBuffer, // NullOpcodeExecute
+    ExecuteBufferWrite,            // NullOpcodeBufferWrite
+    ExecuteBufferFill,             // NullOpcodeBufferFill
+    ExecuteCopySubresource,        // NullOpcodeCopySubresource
+    ExecuteCopyFramebuffer,        // NullOpcodeCopyFramebuffer
+    ExecuteGenerateMips,           // NullOpcodeGenerateMips
+    ExecuteSetViewports,           // NullOpcodeSetViewports
+    ExecuteSetScissors,            // NullOpcodeSetScissors
+    ExecuteBeginRenderPass,        // NullOpcodeBeginRenderPass
+    ExecuteEndRenderPass,          // NullOpcodeEndRenderPass
+    ExecuteClear,                  // NullOpcodeClear
+    ExecuteClearAttachments,       // NullOpcodeClearAttachments
+    ExecuteBindPipelineState,      // NullOpcodeBindPipelineState
+    ExecuteSetBlendFactor,         // NullOpcodeSetBlendFactor
+    ExecuteSetStencilReference,    // NullOpcodeSetStencilReference
+    ExecuteSetResourceHeap,        // NullOpcodeSetResourceHeap
+    ExecuteSetResource,            // NullOpcodeSetResource
+    ExecuteSetUniforms,            // NullOpcodeSetUniforms
+    ExecuteDraw,                   // NullOpcodeDraw
+    ExecuteDrawIndexed,            // NullOpcodeDrawIndexed
+    ExecuteDispatch,               // NullOpcodeDispatch
+    ExecuteDispatchIndirect,       // NullOpcodeDispatchIndirect
+    ExecuteBeginQuery,             // NullOpcodeBeginQuery
+    ExecuteEndQuery,               // NullOpcodeEndQuery
+    ExecuteBeginRenderCondition,   // NullOpcodeBeginRenderCondition
+    ExecuteEndRenderCondition,     // NullOpcodeEndRenderCondition
+    ExecutePushDebugGroup,         // NullOpcodePushDebugGroup
+    ExecutePopDebugGroup,          // NullOpcodePopDebugGroup
+};
+
+static_assert(
+    sizeof(g_nullCommandFuncs)/sizeof(g_nullCommandFuncs[0]) == NullOpcodePopDebugGroup + 1,
+    "g_nullCommandFuncs[] must have an entry for each NullOpcode"
+);
+
+template <typename TCommand>
+static std::size_t GetFixedNullCommandSize(const void* /*pc*/)
+{
+    return sizeof(TCommand);
+}
+
+static std::size_t GetEmptyNullCommandSize(const void* /*pc*/)
+{
+    return 0;
+}
+
+static std::size_t GetExecuteSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdExecute*>(pc);
+    return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(NullVertexBufferBinding));
+}
+
+static std::size_t GetBufferWriteSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdBufferWrite*>(pc);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t GetSetViewportsSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdSetViewports*>(pc);
+    return (sizeof(*cmd) + cmd->numViewports * sizeof(Viewport));
+}
+
+static std::size_t GetSetScissorsSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdSetScissors*>(pc);
+    return (sizeof(*cmd) + cmd->numScissors * sizeof(Scissor));
+}
+
+static std::size_t GetBeginRenderPassSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdBeginRenderPass*>(pc);
+    return (sizeof(*cmd) + cmd->numClearValues * sizeof(ClearValue));
+}
+
+static std::size_t GetClearAttachmentsSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdClearAttachments*>(pc);
+    return (sizeof(*cmd) + cmd->numAttachments * sizeof(AttachmentClear));
+}
+
+static std::size_t GetSetUniformsSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdSetUniforms*>(pc);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t GetDrawSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdDraw*>(pc);
+    return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(NullVertexBufferBinding));
+}
+
+static std::size_t GetDrawIndexedSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdDrawIndexed*>(pc);
+    return (sizeof(*cmd) + cmd->numVertexBuffers * sizeof(NullVertexBufferBinding));
+}
+
+static std::size_t GetPushDebugGroupSize(const void* pc)
+{
+    auto cmd = static_cast<const NullCmdPushDebugGroup*>(pc);
+    return (sizeof(*cmd) + cmd->length + 1);
+}
+
+typedef std::size_t (*NullCommandSizeFunc)(const void* pc);
+
+// Table of command size functions indexed by NullOpcode. This is the only place where the payload size of each command is defined.
+static const NullCommandSizeFunc g_nullCommandSizeFuncs[] =
+{
+    nullptr,                                              // <invalid>
+    GetExecuteSize,                                       // NullOpcodeExecute
+    GetBufferWriteSize,                                   // NullOpcodeBufferWrite
+    GetFixedNullCommandSize<NullCmdBufferFill>,           // NullOpcodeBufferFill
+    GetFixedNullCommandSize<NullCmdCopySubresource>,      // NullOpcodeCopySubresource
+    GetFixedNullCommandSize<NullCmdCopyFramebuffer>,      // NullOpcodeCopyFramebuffer
+    GetFixedNullCommandSize<NullCmdGenerateMips>,         // NullOpcodeGenerateMips
+    GetSetViewportsSize,                                  // NullOpcodeSetViewports
+    GetSetScissorsSize,                                   // NullOpcodeSetScissors
+    GetBeginRenderPassSize,                               // NullOpcodeBeginRenderPass
+    GetEmptyNullCommandSize,                              // NullOpcodeEndRenderPass
+    GetFixedNullCommandSize<NullCmdClear>,                // NullOpcodeClear
+    GetClearAttachmentsSize,                              // NullOpcodeClearAttachments
+    GetFixedNullCommandSize<NullCmdBindPipelineState>,    // NullOpcodeBindPipelineState
+    GetFixedNullCommandSize<NullCmdSetBlendFactor>,       // NullOpcodeSetBlendFactor
+    GetFixedNullCommandSize<NullCmdSetStencilReference>,  // NullOpcodeSetStencilReference
+    GetFixedNullCommandSize<NullCmdSetResourceHeap>,      // NullOpcodeSetResourceHeap
+    GetFixedNullCommandSize<NullCmdSetResource>,          // NullOpcodeSetResource
+    GetSetUniformsSize,                                   // NullOpcodeSetUniforms
+    GetDrawSize,                                          // NullOpcodeDraw
+    GetDrawIndexedSize,                                   // NullOpcodeDrawIndexed
+    GetFixedNullCommandSize<NullCmdDispatch>,             // NullOpcodeDispatch
+    GetFixedNullCommandSize<NullCmdDispatchIndirect>,     // NullOpcodeDispatchIndirect
+    GetFixedNullCommandSize<NullCmdQuery>,                // NullOpcodeBeginQuery
+    GetFixedNullCommandSize<NullCmdQuery>,                // NullOpcodeEndQuery
+    GetFixedNullCommandSize<NullCmdBeginRenderCondition>, // NullOpcodeBeginRenderCondition
+    GetEmptyNullCommandSize,                              // NullOpcodeEndRenderCondition
+    GetPushDebugGroupSize,                                // NullOpcodePushDebugGroup
+    GetEmptyNullCommandSize,                              // NullOpcodePopDebugGroup
+};
+
+static_assert(
+    sizeof(g_nullCommandSizeFuncs)/sizeof(g_nullCommandSizeFuncs[0]) == NullOpcodePopDebugGroup + 1,
+    "g_nullCommandSizeFuncs[] must have an entry for each NullOpcode"
+);
+
+// Returns the size (in bytes) of the payload of the specified command without executing it.
+static std::size_t GetNullCommandSize(const NullOpcode opcode, const void* pc)
+{
+    return g_nullCommandSizeFuncs[opcode](pc);
+}
+
+static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc, NullCommandContext& context)
+{
+    const std::size_t size = g_nullCommandFuncs[opcode](pc, context);
+    LLGL_DEBUG_ASSERT(size == GetNullCommandSize(opcode, pc), "mismatch between executed and declared payload size of Null command (opcode %d)", static_cast<int>(opcode));
+    return size;
+}
+
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandContext& context)
+{
+    virtualCmdBuffer.Run(ExecuteNullCommand, context);
+}
+
+void CompileNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCompiledCommandBuffer& outCompiledCmdBuffer)
+{
+    outCompiledCmdBuffer.clear();
+    virtualCmdBuffer.Run(
+        [&outCompiledCmdBuffer](const NullOpcode opcode, const char* pc) -> std::size_t
         {
-            //TODO
-            return 0;
+            outCompiledCmdBuffer.push_back(NullCompiledCommand{ g_nullCommandFuncs[opcode], pc });
+            return GetNullCommandSize(opcode, pc);
         }
-        default:
-            return 0;
-    }
+    );
 }
 
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer)
+void ExecuteNullCompiledCommandBuffer(const NullCompiledCommandBuffer& compiledCmdBuffer, NullCommandContext& context)
 {
-    virtualCmdBuffer.Run(ExecuteNullCommand);
+    for (const NullCompiledCommand& cmd : compiledCmdBuffer)
+        cmd.func(cmd.pc, context);
 }
 
 
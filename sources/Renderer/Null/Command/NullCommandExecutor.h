@@ -16,8 +16,17 @@ namespace LLGL
 {
 
 
-// Executes all virtual commands from the specified command buffer.
-void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer);
+// Executes all virtual commands from the specified command buffer with the state of the specified command context.
+void ExecuteNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCommandContext& context);
+
+/*
+Compiles the specified virtual command buffer into a list of pre-decoded commands.
+This resolves the opcodes and payload sizes once, so that replaying the compiled commands only has to call one function per command.
+*/
+void CompileNullVirtualCommandBuffer(const NullVirtualCommandBuffer& virtualCmdBuffer, NullCompiledCommandBuffer& outCompiledCmdBuffer);
+
+// Executes all pre-decoded commands with the state of the specified command context.
+void ExecuteNullCompiledCommandBuffer(const NullCompiledCommandBuffer& compiledCmdBuffer, NullCommandContext& context);
 
 
 } // /namespace LLGL
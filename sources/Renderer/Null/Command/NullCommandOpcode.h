@@ -18,12 +18,32 @@ namespace LLGL
 
 enum NullOpcode : std::uint8_t
 {
-    NullOpcodeBufferWrite = 1,
+    NullOpcodeExecute = 1,
+    NullOpcodeBufferWrite,
+    NullOpcodeBufferFill,
     NullOpcodeCopySubresource,
+    NullOpcodeCopyFramebuffer,
     NullOpcodeGenerateMips,
-    //TODO
+    NullOpcodeSetViewports,
+    NullOpcodeSetScissors,
+    NullOpcodeBeginRenderPass,
+    NullOpcodeEndRenderPass,
+    NullOpcodeClear,
+    NullOpcodeClearAttachments,
+    NullOpcodeBindPipelineState,
+    NullOpcodeSetBlendFactor,
+    NullOpcodeSetStencilReference,
+    NullOpcodeSetResourceHeap,
+    NullOpcodeSetResource,
+    NullOpcodeSetUniforms,
     NullOpcodeDraw,
     NullOpcodeDrawIndexed,
+    NullOpcodeDispatch,
+    NullOpcodeDispatchIndirect,
+    NullOpcodeBeginQuery,
+    NullOpcodeEndQuery,
+    NullOpcodeBeginRenderCondition,
+    NullOpcodeEndRenderCondition,
     NullOpcodePushDebugGroup,
     NullOpcodePopDebugGroup,
 };
@@ -9,46 +9,179 @@
 #include "NullCommandBuffer.h"
 #include "NullCommandExecutor.h"
 #include "../RenderState/NullQueryHeap.h"
+#include "../RenderState/NullFence.h"
 #include "../../CheckedCast.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+NullCommandQueue::NullCommandQueue(bool asyncSubmission) :
+    asyncSubmission_ { asyncSubmission }
+{
+    if (asyncSubmission_)
+        worker_ = std::thread{ &NullCommandQueue::WorkerThreadMain, this };
+}
+
+NullCommandQueue::~NullCommandQueue()
+{
+    if (worker_.joinable())
+    {
+        /* Finish all pending submissions before the worker thread is stopped */
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            quit_ = true;
+        }
+        submittedCond_.notify_one();
+        worker_.join();
+    }
+}
+
 /* ----- Command Buffers ----- */
 
 void NullCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferNull = LLGL_CAST(NullCommandBuffer&, commandBuffer);
     if ((commandBufferNull.desc.flags & (CommandBufferFlags::ImmediateSubmit | CommandBufferFlags::Secondary)) == 0)
-        commandBufferNull.ExecuteVirtualCommands();
+        SubmitCommandBuffer(commandBufferNull);
 }
 
 /* ----- Queries ----- */
 
 bool NullCommandQueue::QueryResult(QueryHeap& queryHeap, std::uint32_t firstQuery, std::uint32_t numQueries, void* data, std::size_t dataSize)
 {
-    //auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
-    //todo
-    return false;
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+
+    /* Results only become available once the command buffer that ends a query has been executed */
+    if (dataSize == numQueries * sizeof(std::uint32_t))
+    {
+        auto results = static_cast<std::uint32_t*>(data);
+        for_range(i, numQueries)
+        {
+            std::uint64_t result = 0;
+            if (!queryHeapNull.GetResult(firstQuery + i, result))
+                return false;
+            results[i] = static_cast<std::uint32_t>(std::min<std::uint64_t>(result, UINT32_MAX));
+        }
+    }
+    else if (dataSize == numQueries * sizeof(std::uint64_t))
+    {
+        auto results = static_cast<std::uint64_t*>(data);
+        for_range(i, numQueries)
+        {
+            if (!queryHeapNull.GetResult(firstQuery + i, results[i]))
+                return false;
+        }
+    }
+    else if (dataSize == numQueries * sizeof(QueryPipelineStatistics))
+    {
+        auto results = static_cast<QueryPipelineStatistics*>(data);
+        for_range(i, numQueries)
+        {
+            if (!queryHeapNull.GetResult(firstQuery + i, results[i]))
+                return false;
+        }
+    }
+    else
+        return false;
+
+    return true;
 }
 
 /* ----- Fences ----- */
 
 void NullCommandQueue::Submit(Fence& fence)
 {
-    //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    const std::uint64_t value = fenceNull.NextValue();
+    if (asyncSubmission_)
+        Enqueue(Submission{ nullptr, &fenceNull, value });
+    else
+        fenceNull.Signal(value);
 }
 
 bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
-    return false; //todo
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    return fenceNull.Wait(timeout);
 }
 
 void NullCommandQueue::WaitIdle()
 {
-    //todo
+    if (asyncSubmission_)
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        completedCond_.wait(lock, [this]() { return (numCompleted_ == numSubmitted_); });
+    }
+}
+
+/* ----- Internal ----- */
+
+void NullCommandQueue::SubmitCommandBuffer(NullCommandBuffer& commandBuffer)
+{
+    if (asyncSubmission_)
+        commandBuffer.SetLastSubmission(Enqueue(Submission{ &commandBuffer, nullptr, 0 }));
+    else
+        commandBuffer.ExecuteVirtualCommands();
+}
+
+void NullCommandQueue::WaitForSubmission(std::uint64_t submission)
+{
+    if (asyncSubmission_)
+    {
+        std::unique_lock<std::mutex> lock{ mutex_ };
+        completedCond_.wait(lock, [this, submission]() { return (numCompleted_ >= submission); });
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint64_t NullCommandQueue::Enqueue(const Submission& submission)
+{
+    std::uint64_t submissionID = 0;
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        submissions_.push_back(submission);
+        submissionID = ++numSubmitted_;
+    }
+    submittedCond_.notify_one();
+    return submissionID;
+}
+
+void NullCommandQueue::WorkerThreadMain()
+{
+    for (;;)
+    {
+        /* Wait for the next submission; remaining submissions are still executed when the queue is destroyed */
+        Submission submission;
+        {
+            std::unique_lock<std::mutex> lock{ mutex_ };
+            submittedCond_.wait(lock, [this]() { return (quit_ || !submissions_.empty()); });
+            if (submissions_.empty())
+                break;
+            submission = submissions_.front();
+            submissions_.pop_front();
+        }
+
+        /* Execute command buffer or signal fence, since all previous submissions have been completed */
+        if (submission.commandBuffer != nullptr)
+            submission.commandBuffer->ExecuteVirtualCommands();
+        if (submission.fence != nullptr)
+            submission.fence->Signal(submission.fenceValue);
+
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            ++numCompleted_;
+        }
+        completedCond_.notify_all();
+    }
 }
 
 
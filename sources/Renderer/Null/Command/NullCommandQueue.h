@@ -10,12 +10,24 @@
 
 
 #include <LLGL/CommandQueue.h>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+class NullCommandBuffer;
+class NullFence;
+
+/*
+Command queue of the Null renderer. By default, command buffers are executed synchronously on submission.
+With asynchronous submission, command buffers and fences are enqueued and executed in order on a worker thread.
+*/
 class NullCommandQueue final : public CommandQueue
 {
 
@@ -23,6 +35,47 @@ class NullCommandQueue final : public CommandQueue
 
         #include <LLGL/Backend/CommandQueue.inl>
 
+    public:
+
+        NullCommandQueue(bool asyncSubmission = false);
+        ~NullCommandQueue();
+
+        // Executes or enqueues the specified command buffer regardless of its flags.
+        void SubmitCommandBuffer(NullCommandBuffer& commandBuffer);
+
+        // Blocks until the specified submission has been executed. Submission IDs start at 1, so zero never blocks.
+        void WaitForSubmission(std::uint64_t submission);
+
+    private:
+
+        struct Submission
+        {
+            NullCommandBuffer*  commandBuffer;
+            NullFence*          fence;
+            std::uint64_t       fenceValue;
+        };
+
+    private:
+
+        // Enqueues the specified submission and returns its ID.
+        std::uint64_t Enqueue(const Submission& submission);
+
+        // Executes submissions on the worker thread until the queue is destroyed.
+        void WorkerThreadMain();
+
+    private:
+
+        const bool                  asyncSubmission_;
+
+        std::thread                 worker_;
+        std::mutex                  mutex_;
+        std::condition_variable     submittedCond_;     // Notifies the worker thread about new submissions.
+        std::condition_variable     completedCond_;     // Notifies waiting threads about completed submissions.
+        std::deque<Submission>      submissions_;
+        std::uint64_t               numSubmitted_       = 0;
+        std::uint64_t               numCompleted_       = 0;
+        bool                        quit_               = false;
+
 };
 
 
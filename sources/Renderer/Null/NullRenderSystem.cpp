@@ -6,6 +6,7 @@
  */
 
 #include "NullRenderSystem.h"
+#include "../RenderSystemUtils.h"
 #include "../../Core/CoreUtils.h"
 #include <LLGL/Utils/ForRange.h>
 #include <limits.h>
@@ -151,10 +152,24 @@ static void GetNullRendererInfo(RendererInfo& info)
     info.shadingLanguageName    = "Dummy";
 }
 
+static RendererConfigurationNull GetNullRendererConfig(const RenderSystemDescriptor& renderSystemDesc)
+{
+    if (auto* rendererConfigNull = GetRendererConfiguration<RendererConfigurationNull>(renderSystemDesc))
+        return *rendererConfigNull;
+    return RendererConfigurationNull{};
+}
+
 NullRenderSystem::NullRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
-    desc_         { renderSystemDesc               },
-    commandQueue_ { MakeUnique<NullCommandQueue>() }
+    desc_         { renderSystemDesc                                          },
+    config_       { GetNullRendererConfig(renderSystemDesc)                   },
+    commandQueue_ { MakeUnique<NullCommandQueue>(config_.asyncSubmission) }
+{
+}
+
+NullRenderSystem::~NullRenderSystem()
 {
+    /* Finish pending command buffers before any of the objects they refer to are released */
+    commandQueue_->WaitIdle();
 }
 
 /* ----- Swap-chain ----- */
@@ -166,6 +181,7 @@ SwapChain* NullRenderSystem::CreateSwapChain(const SwapChainDescriptor& swapChai
 
 void NullRenderSystem::Release(SwapChain& swapChain)
 {
+    commandQueue_->WaitIdle();
     swapChains_.erase(&swapChain);
 }
 
@@ -180,11 +196,12 @@ CommandQueue* NullRenderSystem::GetCommandQueue()
 
 CommandBuffer* NullRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& commandBufferDesc)
 {
-    return commandBuffers_.emplace<NullCommandBuffer>(commandBufferDesc);
+    return commandBuffers_.emplace<NullCommandBuffer>(commandBufferDesc, commandQueue_.get(), config_.compileCommandBuffers);
 }
 
 void NullRenderSystem::Release(CommandBuffer& commandBuffer)
 {
+    commandQueue_->WaitIdle();
     commandBuffers_.erase(&commandBuffer);
 }
 
@@ -193,7 +210,8 @@ void NullRenderSystem::Release(CommandBuffer& commandBuffer)
 Buffer* NullRenderSystem::CreateBuffer(const BufferDescriptor& bufferDesc, const void* initialData)
 {
     RenderSystem::AssertCreateBuffer(bufferDesc, GetRenderingCaps().limits.maxBufferSize);
-    return buffers_.emplace<NullBuffer>(bufferDesc, initialData);
+    const bool isDebugDevice = ((desc_.flags & RenderSystemFlags::DebugDevice) != 0);
+    return buffers_.emplace<NullBuffer>(bufferDesc, initialData, isDebugDevice);
 }
 
 BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
@@ -204,34 +222,40 @@ BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffe
 
 void NullRenderSystem::Release(Buffer& buffer)
 {
+    commandQueue_->WaitIdle();
     buffers_.erase(&buffer);
 }
 
 void NullRenderSystem::Release(BufferArray& bufferArray)
 {
+    commandQueue_->WaitIdle();
     bufferArrays_.erase(&bufferArray);
 }
 
 void NullRenderSystem::WriteBuffer(Buffer& buffer, std::uint64_t offset, const void* data, std::uint64_t dataSize)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     bufferNull.Write(offset, data, dataSize);
 }
 
 void NullRenderSystem::ReadBuffer(Buffer& buffer, std::uint64_t offset, void* data, std::uint64_t dataSize)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     bufferNull.Read(offset, data, dataSize);
 }
 
 void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     return bufferNull.Map(access, 0, bufferNull.desc.size);
 }
 
 void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access, std::uint64_t offset, std::uint64_t length)
 {
+    commandQueue_->WaitIdle();
     auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
     return bufferNull.Map(access, offset, length);
 }
@@ -246,22 +270,25 @@ void NullRenderSystem::UnmapBuffer(Buffer& buffer)
 
 Texture* NullRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const ImageView* initialImage)
 {
-    return textures_.emplace<NullTexture>(textureDesc, initialImage);
+    return textures_.emplace<NullTexture>(textureDesc, initialImage, config_.tiledTextures);
 }
 
 void NullRenderSystem::Release(Texture& texture)
 {
+    commandQueue_->WaitIdle();
     textures_.erase(&texture);
 }
 
 void NullRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const ImageView& srcImageDesc)
 {
+    commandQueue_->WaitIdle();
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     textureNull.Write(textureRegion, srcImageDesc);
 }
 
 void NullRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const MutableImageView& dstImageView)
 {
+    commandQueue_->WaitIdle();
     auto& textureNull = LLGL_CAST(NullTexture&, texture);
     textureNull.Read(textureRegion, dstImageView);
 }
@@ -275,6 +302,7 @@ Sampler* NullRenderSystem::CreateSampler(const SamplerDescriptor& samplerDesc)
 
 void NullRenderSystem::Release(Sampler& sampler)
 {
+    commandQueue_->WaitIdle();
     samplers_.erase(&sampler);
 }
 
@@ -287,6 +315,7 @@ ResourceHeap* NullRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
 
 void NullRenderSystem::Release(ResourceHeap& resourceHeap)
 {
+    commandQueue_->WaitIdle();
     resourceHeaps_.erase(&resourceHeap);
 }
 
@@ -305,6 +334,7 @@ RenderPass* NullRenderSystem::CreateRenderPass(const RenderPassDescriptor& rende
 
 void NullRenderSystem::Release(RenderPass& renderPass)
 {
+    commandQueue_->WaitIdle();
     renderPasses_.erase(&renderPass);
 }
 
@@ -317,6 +347,7 @@ RenderTarget* NullRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
 
 void NullRenderSystem::Release(RenderTarget& renderTarget)
 {
+    commandQueue_->WaitIdle();
     renderTargets_.erase(&renderTarget);
 }
 
@@ -329,6 +360,7 @@ Shader* NullRenderSystem::CreateShader(const ShaderDescriptor& shaderDesc)
 
 void NullRenderSystem::Release(Shader& shader)
 {
+    commandQueue_->WaitIdle();
     shaders_.erase(&shader);
 }
 
@@ -341,6 +373,7 @@ PipelineLayout* NullRenderSystem::CreatePipelineLayout(const PipelineLayoutDescr
 
 void NullRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    commandQueue_->WaitIdle();
     pipelineLayouts_.erase(&pipelineLayout);
 }
 
@@ -353,6 +386,7 @@ PipelineCache* NullRenderSystem::CreatePipelineCache(const Blob& /*initialBlob*/
 
 void NullRenderSystem::Release(PipelineCache& pipelineCache)
 {
+    commandQueue_->WaitIdle();
     ProxyPipelineCache::ReleaseInstance(pipelineCacheProxy_, pipelineCache);
 }
 
@@ -375,6 +409,7 @@ PipelineState* NullRenderSystem::CreatePipelineState(const MeshPipelineDescripto
 
 void NullRenderSystem::Release(PipelineState& pipelineState)
 {
+    commandQueue_->WaitIdle();
     pipelineStates_.erase(&pipelineState);
 }
 
@@ -387,6 +422,7 @@ QueryHeap* NullRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& queryHea
 
 void NullRenderSystem::Release(QueryHeap& queryHeap)
 {
+    commandQueue_->WaitIdle();
     queryHeaps_.erase(&queryHeap);
 }
 
@@ -399,6 +435,7 @@ Fence* NullRenderSystem::CreateFence()
 
 void NullRenderSystem::Release(Fence& fence)
 {
+    commandQueue_->WaitIdle();
     fences_.erase(&fence);
 }
 
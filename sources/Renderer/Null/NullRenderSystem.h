@@ -10,6 +10,7 @@
 
 
 #include <LLGL/RenderSystem.h>
+#include <LLGL/RendererConfiguration.h>
 #include "NullSwapChain.h"
 #include "Command/NullCommandBuffer.h"
 #include "Command/NullCommandQueue.h"
@@ -44,6 +45,7 @@ class NullRenderSystem final : public RenderSystem
     public:
 
         NullRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
+        ~NullRenderSystem();
 
     private:
 
@@ -54,6 +56,7 @@ class NullRenderSystem final : public RenderSystem
         /* ----- Common objects ----- */
 
         const RenderSystemDescriptor            desc_;
+        const RendererConfigurationNull         config_;
 
         /* ----- Hardware object containers ----- */
 
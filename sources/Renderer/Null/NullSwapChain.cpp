@@ -6,6 +6,7 @@
  */
 
 #include "NullSwapChain.h"
+#include "../../Core/CoreUtils.h"
 
 
 namespace LLGL
@@ -54,6 +55,7 @@ NullSwapChain::NullSwapChain(
     depthStencilFormat_ { ChooseDepthStencilFormat(desc)                             }
 {
     SetOrCreateSurface(surface, SwapChain::BuildDefaultSurfaceTitle(rendererInfo), desc);
+    CreateBackBuffers(GetResolution());
 
     if (desc.debugName != nullptr)
         SetDebugName(desc.debugName);
@@ -119,10 +121,45 @@ const RenderPass* NullSwapChain::GetRenderPass() const
 
 Extent2D NullSwapChain::ResizeBuffersPrimary(const Extent2D& resolution)
 {
+    CreateBackBuffers(resolution);
     return resolution;
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+static std::unique_ptr<NullTexture> MakeBackBuffer(const Extent2D& resolution, const Format format, long bindFlags)
+{
+    TextureDescriptor textureDesc;
+    {
+        textureDesc.type            = TextureType::Texture2D;
+        textureDesc.bindFlags       = bindFlags;
+        textureDesc.format          = format;
+        textureDesc.extent.width    = resolution.width;
+        textureDesc.extent.height   = resolution.height;
+        textureDesc.mipLevels       = 1;
+    }
+    return MakeUnique<NullTexture>(textureDesc);
+}
+
+void NullSwapChain::CreateBackBuffers(const Extent2D& resolution)
+{
+    /* Back buffers are only rendered into by the software rasterizer; there is no surface to present them on */
+    colorBuffer_ = MakeBackBuffer(resolution, colorFormat_, BindFlags::ColorAttachment | BindFlags::CopySrc);
+
+    if (depthStencilFormat_ != Format::Undefined)
+        depthStencilBuffer_ = MakeBackBuffer(resolution, depthStencilFormat_, BindFlags::DepthStencilAttachment);
+
+    framebufferDesc_ = NullFramebufferDescriptor{};
+    framebufferDesc_.resolution                     = resolution;
+    framebufferDesc_.numColorAttachments            = 1;
+    framebufferDesc_.colorAttachments[0].texture    = colorBuffer_.get();
+    framebufferDesc_.depthStencilAttachment.texture = depthStencilBuffer_.get();
+}
+
+
 } // /namespace LLGL
 
 
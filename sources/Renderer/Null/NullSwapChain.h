@@ -10,6 +10,9 @@
 
 
 #include <LLGL/SwapChain.h>
+#include "Texture/NullTexture.h"
+#include "Raster/NullFramebuffer.h"
+#include <memory>
 #include <string>
 
 
@@ -36,10 +39,18 @@ class NullSwapChain final : public SwapChain
             const RendererInfo&             rendererInfo
         );
 
+        // Returns the attachment views of the back buffers for the framebuffer of a render pass.
+        inline const NullFramebufferDescriptor& GetFramebufferDesc() const
+        {
+            return framebufferDesc_;
+        }
+
     private:
 
         Extent2D ResizeBuffersPrimary(const Extent2D& resolution) override;
 
+        void CreateBackBuffers(const Extent2D& resolution);
+
     private:
 
         std::string         label_;
@@ -49,6 +60,10 @@ class NullSwapChain final : public SwapChain
         std::uint32_t       vsyncInterval_      = 0;
         const RenderPass*   renderPass_         = nullptr;
 
+        std::unique_ptr<NullTexture>    colorBuffer_;
+        std::unique_ptr<NullTexture>    depthStencilBuffer_;
+        NullFramebufferDescriptor       framebufferDesc_;
+
 };
 
 
@@ -0,0 +1,383 @@
+/*
+ * NullFramebuffer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullFramebuffer.h"
+#include "../Texture/NullTexture.h"
+#include "../../../Core/ImageResampler.h"
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace LLGL
+{
+
+
+// 2D slice of an attachment's MIP-map image, i.e. a single array layer or volume slice.
+struct NullAttachmentSlice
+{
+    char*           data        = nullptr;
+    std::uint32_t   width       = 0;
+    std::uint32_t   height      = 0;
+    std::uint32_t   rowStride   = 0;
+    ImageFormat     format      = ImageFormat::RGBA;
+    DataType        dataType    = DataType::UInt8;
+};
+
+static NullAttachmentSlice GetAttachmentSlice(const NullAttachmentView& view)
+{
+    Image&          image   = view.texture->GetMipImage(view.mipLevel);
+    const Extent3D& extent  = image.GetExtent();
+
+    /* Array layers of 1D array textures are stored in the image height, all others in the image depth */
+    const bool          is1DArray   = (view.texture->GetType() == TextureType::Texture1DArray);
+    const std::uint32_t numLayers   = (is1DArray ? extent.height : extent.depth);
+    const std::uint32_t layer       = std::min(view.arrayLayer, numLayers - 1);
+
+    NullAttachmentSlice slice;
+    {
+        slice.width     = extent.width;
+        slice.height    = (is1DArray ? 1u : extent.height);
+        slice.rowStride = static_cast<std::uint32_t>(GetMemoryFootprint(image.GetFormat(), image.GetDataType(), extent.width));
+        slice.data      = static_cast<char*>(image.GetData()) + static_cast<std::size_t>(layer) * slice.height * slice.rowStride;
+        slice.format    = image.GetFormat();
+        slice.dataType  = image.GetDataType();
+    }
+    return slice;
+}
+
+// Converts the region of the framebuffer between a tightly packed buffer and an attachment slice whose rows may be wider than the framebuffer.
+static void ConvertAttachmentSlice(
+    const NullAttachmentSlice&  slice,
+    bool                        toSlice,
+    ImageFormat                 format,
+    DataType                    dataType,
+    void*                       data,
+    std::uint32_t               width,
+    std::uint32_t               height,
+    std::uint32_t               depthMask   = ~0u,
+    std::uint32_t               stencilMask = ~0u)
+{
+    const std::uint32_t dataRowStride   = static_cast<std::uint32_t>(GetMemoryFootprint(format, dataType, width));
+    const std::uint32_t sliceRowSize    = static_cast<std::uint32_t>(GetMemoryFootprint(slice.format, slice.dataType, width));
+
+    if (!toSlice)
+    {
+        /* Source row stride is supported by image conversion, so read the slice with a single conversion */
+        ConvertImageBuffer(
+            ImageView{ slice.format, slice.dataType, slice.data, static_cast<std::size_t>(slice.rowStride) * height, slice.rowStride },
+            MutableImageView{ format, dataType, data, static_cast<std::size_t>(dataRowStride) * height },
+            Extent3D{ width, height, 1 },
+            LLGL_MAX_THREAD_COUNT,
+            true,
+            depthMask,
+            stencilMask
+        );
+    }
+    else if (sliceRowSize == slice.rowStride)
+    {
+        /* Write tightly packed rows with a single conversion */
+        ConvertImageBuffer(
+            ImageView{ format, dataType, data, static_cast<std::size_t>(dataRowStride) * height },
+            MutableImageView{ slice.format, slice.dataType, slice.data, static_cast<std::size_t>(slice.rowStride) * height },
+            Extent3D{ width, height, 1 },
+            LLGL_MAX_THREAD_COUNT,
+            true,
+            depthMask,
+            stencilMask
+        );
+    }
+    else
+    {
+        /* Write each row separately, because the destination of image conversions must be tightly packed */
+        for_range(y, height)
+        {
+            ConvertImageBuffer(
+                ImageView{ format, dataType, static_cast<const char*>(data) + static_cast<std::size_t>(y) * dataRowStride, dataRowStride },
+                MutableImageView{ slice.format, slice.dataType, slice.data + static_cast<std::size_t>(y) * slice.rowStride, sliceRowSize },
+                Extent3D{ width, 1, 1 },
+                0,
+                true,
+                depthMask,
+                stencilMask
+            );
+        }
+    }
+}
+
+// Returns the bias that is added to normalized values before they are truncated to unsigned integers, so they are rounded to the nearest integer.
+static float GetUNormRoundingBias(DataType dataType)
+{
+    switch (dataType)
+    {
+        case DataType::UInt8:   return 0.5f / 255.0f;
+        case DataType::UInt16:  return 0.5f / 65535.0f;
+        default:                return 0.0f;
+    }
+}
+
+// Converts linear colors into the color space and value range of the color attachment, so they can be converted into the specified data type.
+static void EncodeColorPixels(std::vector<float>& pixels, bool sRGB, const NullColorBuffer& attachment, DataType dataType)
+{
+    if (sRGB)
+        ConvertRGBA32FloatLinearToSRGB(pixels.data(), pixels.size() / 4, LLGL_MAX_THREAD_COUNT);
+
+    if (!IsFloatDataType(dataType))
+    {
+        const float roundingBias = GetUNormRoundingBias(dataType);
+        for (float& value : pixels)
+            value = std::max(attachment.minValue, std::min(value, attachment.maxValue)) + roundingBias;
+    }
+}
+
+void NullFramebuffer::Begin(const NullFramebufferDescriptor& desc, std::uint32_t colorLoadMask, bool loadDepth, bool loadStencil)
+{
+    /* Determine framebuffer size by the smallest attachment */
+    width_  = desc.resolution.width;
+    height_ = desc.resolution.height;
+
+    auto ClampToAttachment = [this](const NullAttachmentView& view)
+    {
+        if (view.texture != nullptr)
+        {
+            const NullAttachmentSlice slice = GetAttachmentSlice(view);
+            width_  = std::min(width_, slice.width);
+            height_ = std::min(height_, slice.height);
+        }
+    };
+
+    numColorBuffers_ = std::min(desc.numColorAttachments, LLGL_MAX_NUM_COLOR_ATTACHMENTS);
+    for_range(i, numColorBuffers_)
+    {
+        ClampToAttachment(desc.colorAttachments[i]);
+        ClampToAttachment(desc.resolveAttachments[i]);
+    }
+    ClampToAttachment(desc.depthStencilAttachment);
+
+    /* Load color attachments */
+    for_range(i, numColorBuffers_)
+    {
+        ColorBuffer& colorBuffer = colorBuffers_[i];
+        colorBuffer.view        = desc.colorAttachments[i];
+        colorBuffer.resolveView = desc.resolveAttachments[i];
+        LoadColorBuffer(colorBuffer);
+        if (colorBuffer.attachment.pixels != nullptr && ((colorLoadMask >> i) & 0x1) != 0)
+        {
+            ConvertAttachmentSlice(
+                GetAttachmentSlice(colorBuffer.view), false, ImageFormat::RGBA, DataType::Float32,
+                colorBuffer.pixels.data(), width_, height_
+            );
+            if (colorBuffer.sRGB)
+                ConvertRGBA32FloatSRGBToLinear(colorBuffer.pixels.data(), colorBuffer.pixels.size() / 4, LLGL_MAX_THREAD_COUNT);
+        }
+    }
+
+    /* Load depth-stencil attachment */
+    depthStencilView_ = desc.depthStencilAttachment;
+    LoadDepthStencilBuffer(loadDepth, loadStencil);
+
+    active_ = true;
+}
+
+void NullFramebuffer::End()
+{
+    if (!active_)
+        return;
+
+    for_range(i, numColorBuffers_)
+        StoreColorBuffer(colorBuffers_[i]);
+
+    StoreDepthStencilBuffer();
+
+    active_ = false;
+}
+
+void NullFramebuffer::ClearColor(std::uint32_t colorAttachment, const float color[4])
+{
+    if (colorAttachment < numColorBuffers_)
+    {
+        ColorBuffer& colorBuffer = colorBuffers_[colorAttachment];
+        for (std::size_t i = 0, n = colorBuffer.pixels.size(); i < n; i += 4)
+        {
+            colorBuffer.pixels[i    ] = color[0];
+            colorBuffer.pixels[i + 1] = color[1];
+            colorBuffer.pixels[i + 2] = color[2];
+            colorBuffer.pixels[i + 3] = color[3];
+        }
+    }
+}
+
+void NullFramebuffer::ClearDepth(float depth)
+{
+    std::fill(depthBuffer_.begin(), depthBuffer_.end(), depth);
+}
+
+void NullFramebuffer::ClearStencil(std::uint32_t stencil)
+{
+    std::fill(stencilBuffer_.begin(), stencilBuffer_.end(), static_cast<std::uint8_t>(stencil & 0xFF));
+}
+
+bool NullFramebuffer::ReadColorBuffer(std::uint32_t colorAttachment, const Offset2D& offset, const Extent2D& extent, const MutableImageView& dstImageView)
+{
+    if (colorAttachment >= numColorBuffers_ || colorBuffers_[colorAttachment].attachment.pixels == nullptr)
+        return false;
+
+    if (offset.x < 0 || offset.y < 0 ||
+        static_cast<std::uint32_t>(offset.x) + extent.width  > width_ ||
+        static_cast<std::uint32_t>(offset.y) + extent.height > height_)
+    {
+        return false;
+    }
+
+    /* Copy region of the working copy row by row */
+    const ColorBuffer& colorBuffer = colorBuffers_[colorAttachment];
+    storePixels_.resize(static_cast<std::size_t>(extent.width) * extent.height * 4);
+
+    for_range(y, extent.height)
+    {
+        const std::size_t srcPos = (static_cast<std::size_t>(offset.y + y) * width_ + static_cast<std::size_t>(offset.x)) * 4;
+        const std::size_t dstPos = static_cast<std::size_t>(y) * extent.width * 4;
+        std::copy_n(colorBuffer.pixels.begin() + srcPos, extent.width * 4, storePixels_.begin() + dstPos);
+    }
+
+    /* Convert region like it is stored into the attachment */
+    EncodeColorPixels(storePixels_, colorBuffer.sRGB, colorBuffer.attachment, dstImageView.dataType);
+
+    ConvertImageBuffer(
+        ImageView{ ImageFormat::RGBA, DataType::Float32, storePixels_.data(), storePixels_.size() * sizeof(float) },
+        dstImageView,
+        Extent3D{ extent.width, extent.height, 1 },
+        LLGL_MAX_THREAD_COUNT,
+        true
+    );
+
+    return true;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullFramebuffer::LoadColorBuffer(ColorBuffer& colorBuffer)
+{
+    colorBuffer.attachment = NullColorBuffer{};
+
+    if (colorBuffer.view.texture == nullptr)
+        return;
+
+    /* Only render into formats that can be converted to and from RGBA32Float */
+    const FormatAttributes& formatAttribs = GetFormatAttribs(colorBuffer.view.texture->GetFormat());
+    if ((formatAttribs.flags & (FormatFlags::IsCompressed | FormatFlags::IsPacked | FormatFlags::HasDepth | FormatFlags::HasStencil)) != 0)
+        return;
+
+    colorBuffer.sRGB = ((formatAttribs.flags & FormatFlags::IsColorSpace_sRGB) != 0);
+    colorBuffer.pixels.resize(static_cast<std::size_t>(width_) * height_ * 4);
+
+    /* Fragment outputs are clamped to the range of normalized formats */
+    if ((formatAttribs.flags & FormatFlags::IsNormalized) != 0)
+    {
+        colorBuffer.attachment.minValue = ((formatAttribs.flags & FormatFlags::IsUnsigned) != 0 ? 0.0f : -1.0f);
+        colorBuffer.attachment.maxValue = 1.0f;
+    }
+    else
+    {
+        colorBuffer.attachment.minValue = std::numeric_limits<float>::lowest();
+        colorBuffer.attachment.maxValue = std::numeric_limits<float>::max();
+    }
+
+    colorBuffer.attachment.pixels = colorBuffer.pixels.data();
+}
+
+void NullFramebuffer::StoreColorBuffer(ColorBuffer& colorBuffer)
+{
+    if (colorBuffer.attachment.pixels == nullptr)
+        return;
+
+    /* Convert linear colors back into the color space and value range of the attachment format */
+    storePixels_ = colorBuffer.pixels;
+
+    const NullAttachmentSlice slice = GetAttachmentSlice(colorBuffer.view);
+    EncodeColorPixels(storePixels_, colorBuffer.sRGB, colorBuffer.attachment, slice.dataType);
+
+    ConvertAttachmentSlice(slice, true, ImageFormat::RGBA, DataType::Float32, storePixels_.data(), width_, height_);
+
+    /* Resolve into single-sampled attachment; the rasterizer only renders single-sampled images */
+    if (colorBuffer.resolveView.texture != nullptr)
+        ConvertAttachmentSlice(GetAttachmentSlice(colorBuffer.resolveView), true, ImageFormat::RGBA, DataType::Float32, storePixels_.data(), width_, height_);
+}
+
+void NullFramebuffer::LoadDepthStencilBuffer(bool loadDepth, bool loadStencil)
+{
+    hasDepth_   = false;
+    hasStencil_ = false;
+
+    if (depthStencilView_.texture == nullptr)
+        return;
+
+    const FormatAttributes& formatAttribs = GetFormatAttribs(depthStencilView_.texture->GetFormat());
+    const std::size_t numPixels = static_cast<std::size_t>(width_) * height_;
+
+    hasDepth_   = ((formatAttribs.flags & FormatFlags::HasDepth  ) != 0);
+    hasStencil_ = ((formatAttribs.flags & FormatFlags::HasStencil) != 0);
+
+    switch (depthStencilView_.texture->GetFormat())
+    {
+        case Format::D16UNorm:          depthUNormBits_ = 16; break;
+        case Format::D24UNormS8UInt:    depthUNormBits_ = 24; break;
+        default:                        depthUNormBits_ = 0;  break;
+    }
+
+    if (hasDepth_)
+    {
+        depthBuffer_.assign(numPixels, 0.0f);
+        if (loadDepth)
+            ConvertAttachmentSlice(GetAttachmentSlice(depthStencilView_), false, ImageFormat::Depth, DataType::Float32, depthBuffer_.data(), width_, height_);
+    }
+
+    if (hasStencil_)
+    {
+        stencilBuffer_.assign(numPixels, 0);
+        if (loadStencil)
+            ConvertAttachmentSlice(GetAttachmentSlice(depthStencilView_), false, ImageFormat::Stencil, DataType::UInt8, stencilBuffer_.data(), width_, height_);
+    }
+}
+
+float NullFramebuffer::GetDepthResolution(float depth) const
+{
+    if (depthUNormBits_ > 0)
+        return std::ldexp(1.0f, -static_cast<int>(depthUNormBits_));
+
+    /* Floating-point formats resolve one unit in the last place of the 23-bit mantissa */
+    int exponent = 0;
+    (void)std::frexp(depth, &exponent);
+    return std::ldexp(1.0f, exponent - 24);
+}
+
+void NullFramebuffer::StoreDepthStencilBuffer()
+{
+    if (depthStencilView_.texture == nullptr)
+        return;
+
+    /* Merge depth and stencil values into the attachment separately, so each one preserves the other */
+    const NullAttachmentSlice slice = GetAttachmentSlice(depthStencilView_);
+
+    if (hasDepth_)
+        ConvertAttachmentSlice(slice, true, ImageFormat::Depth, DataType::Float32, depthBuffer_.data(), width_, height_, ~0u, 0u);
+
+    if (hasStencil_)
+        ConvertAttachmentSlice(slice, true, ImageFormat::Stencil, DataType::UInt8, stencilBuffer_.data(), width_, height_, 0u, ~0u);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,161 @@
+/*
+ * NullFramebuffer.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_FRAMEBUFFER_H
+#define LLGL_NULL_FRAMEBUFFER_H
+
+
+#include <LLGL/Types.h>
+#include <LLGL/Format.h>
+#include <LLGL/Constants.h>
+#include <LLGL/ImageFlags.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class NullTexture;
+
+// Subresource of a texture that is used as framebuffer attachment.
+struct NullAttachmentView
+{
+    NullTexture*    texture     = nullptr;
+    std::uint32_t   mipLevel    = 0;
+    std::uint32_t   arrayLayer  = 0;
+};
+
+struct NullFramebufferDescriptor
+{
+    Extent2D            resolution;
+    std::uint32_t       numColorAttachments = 0;
+    NullAttachmentView  colorAttachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    NullAttachmentView  resolveAttachments[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+    NullAttachmentView  depthStencilAttachment;
+};
+
+// Color buffer with linear RGBA32Float pixels the rasterizer operates on.
+struct NullColorBuffer
+{
+    float*  pixels      = nullptr;
+    float   minValue    = 0.0f; // Lower bound for color outputs, e.g. 0 for UNorm formats.
+    float   maxValue    = 0.0f; // Upper bound for color outputs, e.g. 1 for UNorm formats.
+};
+
+/*
+Working copy of the attachments of a render pass.
+Color attachments are loaded into linear RGBA32Float buffers and depth-stencil attachments into separate depth and stencil buffers,
+so the rasterizer does not have to deal with texture formats. The attachments are stored back when the render pass ends.
+*/
+class NullFramebuffer
+{
+
+    public:
+
+        // Loads the specified attachments. Only the color attachments in 'colorLoadMask' are loaded, all others are left uninitialized.
+        void Begin(const NullFramebufferDescriptor& desc, std::uint32_t colorLoadMask, bool loadDepth, bool loadStencil);
+
+        // Stores all attachments back into their textures.
+        void End();
+
+        void ClearColor(std::uint32_t colorAttachment, const float color[4]);
+        void ClearDepth(float depth);
+        void ClearStencil(std::uint32_t stencil);
+
+        // Reads a region of the specified color buffer into the destination image as it would be stored in the attachment. Returns false if the region cannot be read.
+        bool ReadColorBuffer(std::uint32_t colorAttachment, const Offset2D& offset, const Extent2D& extent, const MutableImageView& dstImageView);
+
+        inline bool IsActive() const
+        {
+            return active_;
+        }
+
+        inline std::uint32_t GetWidth() const
+        {
+            return width_;
+        }
+
+        inline std::uint32_t GetHeight() const
+        {
+            return height_;
+        }
+
+        inline std::uint32_t GetNumColorBuffers() const
+        {
+            return numColorBuffers_;
+        }
+
+        // Returns the specified color buffer or null if its attachment format cannot be rendered into.
+        inline const NullColorBuffer* GetColorBuffer(std::uint32_t colorAttachment) const
+        {
+            return (colorBuffers_[colorAttachment].attachment.pixels != nullptr ? &(colorBuffers_[colorAttachment].attachment) : nullptr);
+        }
+
+        // Returns the depth buffer or null if there is no depth attachment.
+        inline float* GetDepthBuffer()
+        {
+            return (hasDepth_ ? depthBuffer_.data() : nullptr);
+        }
+
+        // Returns the minimum resolvable difference of the depth attachment around the specified depth value, i.e. the unit of the constant depth bias.
+        float GetDepthResolution(float depth) const;
+
+        // Returns the stencil buffer or null if there is no stencil attachment.
+        inline std::uint8_t* GetStencilBuffer()
+        {
+            return (hasStencil_ ? stencilBuffer_.data() : nullptr);
+        }
+
+    private:
+
+        struct ColorBuffer
+        {
+            NullAttachmentView  view;
+            NullAttachmentView  resolveView;
+            bool                sRGB        = false;
+            std::vector<float>  pixels;
+            NullColorBuffer     attachment;
+        };
+
+    private:
+
+        void LoadColorBuffer(ColorBuffer& colorBuffer);
+        void StoreColorBuffer(ColorBuffer& colorBuffer);
+
+        void LoadDepthStencilBuffer(bool loadDepth, bool loadStencil);
+        void StoreDepthStencilBuffer();
+
+    private:
+
+        bool                        active_             = false;
+        std::uint32_t               width_              = 0;
+        std::uint32_t               height_             = 0;
+
+        std::uint32_t               numColorBuffers_    = 0;
+        ColorBuffer                 colorBuffers_[LLGL_MAX_NUM_COLOR_ATTACHMENTS];
+        std::vector<float>          storePixels_;
+
+        NullAttachmentView          depthStencilView_;
+        bool                        hasDepth_           = false;
+        std::uint32_t               depthUNormBits_     = 0;    // Number of bits of UNorm depth formats or 0 for floating-point depth formats.
+        bool                        hasStencil_         = false;
+        std::vector<float>          depthBuffer_;
+        std::vector<std::uint8_t>   stencilBuffer_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
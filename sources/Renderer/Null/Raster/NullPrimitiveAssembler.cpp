@@ -0,0 +1,279 @@
+/*
+ * NullPrimitiveAssembler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullPrimitiveAssembler.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+
+
+namespace LLGL
+{
+
+
+// Minimum W coordinate of vertices that are projected to expand lines and points.
+static constexpr float g_nullMinClipW = 1.0e-5f;
+
+NullPrimitiveType GetPrimitiveType(const PrimitiveTopology topology)
+{
+    switch (topology)
+    {
+        case PrimitiveTopology::PointList:
+            return NullPrimitiveType::Point;
+
+        case PrimitiveTopology::LineList:
+        case PrimitiveTopology::LineStrip:
+        case PrimitiveTopology::LineListAdjacency:
+        case PrimitiveTopology::LineStripAdjacency:
+            return NullPrimitiveType::Line;
+
+        case PrimitiveTopology::TriangleList:
+        case PrimitiveTopology::TriangleStrip:
+        case PrimitiveTopology::TriangleListAdjacency:
+        case PrimitiveTopology::TriangleStripAdjacency:
+            return NullPrimitiveType::Triangle;
+
+        default:
+            return NullPrimitiveType::Undefined;
+    }
+}
+
+std::uint32_t GetPrimitiveSize(const NullPrimitiveType type)
+{
+    switch (type)
+    {
+        case NullPrimitiveType::Point:      return 1;
+        case NullPrimitiveType::Line:       return 2;
+        case NullPrimitiveType::Triangle:   return 3;
+        default:                            return 0;
+    }
+}
+
+std::size_t AssemblePrimitives(
+    const PrimitiveTopology     topology,
+    const std::uint32_t*        indices,
+    std::size_t                 numIndices,
+    std::vector<std::uint32_t>& outIndices)
+{
+    outIndices.clear();
+
+    const std::uint32_t primitiveSize = GetPrimitiveSize(GetPrimitiveType(topology));
+    if (primitiveSize == 0)
+        return 0;
+
+    /* Collect each run of indices between restart indices; lists start a new run after each complete primitive */
+    std::size_t runBegin = 0;
+
+    for_range(i, numIndices)
+    {
+        if (indices[i] == g_nullRestartIndex)
+        {
+            runBegin = i + 1;
+            continue;
+        }
+
+        const std::uint32_t*    run     = indices + runBegin;
+        const std::size_t       runSize = i - runBegin + 1;
+
+        switch (topology)
+        {
+            case PrimitiveTopology::PointList:
+                outIndices.push_back(run[0]);
+                runBegin = i + 1;
+                break;
+
+            case PrimitiveTopology::LineList:
+                if (runSize == 2)
+                {
+                    outIndices.insert(outIndices.end(), { run[0], run[1] });
+                    runBegin = i + 1;
+                }
+                break;
+
+            case PrimitiveTopology::LineStrip:
+                if (runSize >= 2)
+                    outIndices.insert(outIndices.end(), { run[runSize - 2], run[runSize - 1] });
+                break;
+
+            case PrimitiveTopology::LineListAdjacency:
+                if (runSize == 4)
+                {
+                    outIndices.insert(outIndices.end(), { run[1], run[2] });
+                    runBegin = i + 1;
+                }
+                break;
+
+            case PrimitiveTopology::LineStripAdjacency:
+                if (runSize >= 4)
+                    outIndices.insert(outIndices.end(), { run[runSize - 3], run[runSize - 2] });
+                break;
+
+            case PrimitiveTopology::TriangleList:
+                if (runSize == 3)
+                {
+                    outIndices.insert(outIndices.end(), { run[0], run[1], run[2] });
+                    runBegin = i + 1;
+                }
+                break;
+
+            case PrimitiveTopology::TriangleStrip:
+                if (runSize >= 3)
+                {
+                    if ((runSize & 1) == 0)
+                        outIndices.insert(outIndices.end(), { run[runSize - 3], run[runSize - 1], run[runSize - 2] });
+                    else
+                        outIndices.insert(outIndices.end(), { run[runSize - 3], run[runSize - 2], run[runSize - 1] });
+                }
+                break;
+
+            case PrimitiveTopology::TriangleListAdjacency:
+                if (runSize == 6)
+                {
+                    outIndices.insert(outIndices.end(), { run[0], run[2], run[4] });
+                    runBegin = i + 1;
+                }
+                break;
+
+            case PrimitiveTopology::TriangleStripAdjacency:
+                /* Triangle N of the strip consists of the vertices 2N, 2N+2, and 2N+4 and is complete with its adjacent vertex 2N+5 */
+                if (runSize >= 6 && (runSize & 1) == 0)
+                {
+                    const std::size_t first = runSize - 6;
+                    if ((first & 2) != 0)
+                        outIndices.insert(outIndices.end(), { run[first], run[first + 4], run[first + 2] });
+                    else
+                        outIndices.insert(outIndices.end(), { run[first], run[first + 2], run[first + 4] });
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return (outIndices.size() / primitiveSize);
+}
+
+static void LerpVertex(NullVertex& outVertex, const NullVertex& from, const NullVertex& to, float t)
+{
+    for_range(c, 4)
+        outVertex.position[c] = from.position[c] + (to.position[c] - from.position[c]) * t;
+    for_range(varying, g_nullMaxVaryings)
+    {
+        for_range(c, 4)
+            outVertex.varyings[varying][c] = from.varyings[varying][c] + (to.varyings[varying][c] - from.varyings[varying][c]) * t;
+    }
+}
+
+// Appends a copy of the vertex that is offset by the specified vector in normalized device coordinates.
+static std::uint32_t AppendOffsetVertex(std::vector<NullVertex>& vertices, const NullVertex& vertex, float offsetX, float offsetY)
+{
+    const std::uint32_t index = static_cast<std::uint32_t>(vertices.size());
+    vertices.push_back(vertex);
+    NullVertex& offsetVertex = vertices.back();
+    offsetVertex.position[0] += offsetX * vertex.position[3];
+    offsetVertex.position[1] += offsetY * vertex.position[3];
+    return index;
+}
+
+void ExpandLinesToTriangles(
+    const Viewport&             viewport,
+    float                       lineWidth,
+    const std::uint32_t*        lineIndices,
+    std::size_t                 numLines,
+    std::vector<NullVertex>&    vertices,
+    std::vector<std::uint32_t>& outTriangles)
+{
+    const float halfWidth   = std::max(viewport.width, 1.0f) * 0.5f;
+    const float halfHeight  = std::max(viewport.height, 1.0f) * 0.5f;
+    const float halfLine    = std::max(lineWidth, 1.0f) * 0.5f;
+
+    outTriangles.clear();
+    vertices.reserve(vertices.size() + numLines * 4);
+
+    for_range(line, numLines)
+    {
+        NullVertex v0 = vertices[lineIndices[line * 2    ]];
+        NullVertex v1 = vertices[lineIndices[line * 2 + 1]];
+
+        /* Clip line against the w=0 plane, so both end points can be projected */
+        const float w0 = v0.position[3];
+        const float w1 = v1.position[3];
+
+        if (w0 < g_nullMinClipW && w1 < g_nullMinClipW)
+            continue;
+        if (w0 < g_nullMinClipW)
+            LerpVertex(v0, v0, v1, (g_nullMinClipW - w0) / (w1 - w0));
+        else if (w1 < g_nullMinClipW)
+            LerpVertex(v1, v1, v0, (g_nullMinClipW - w1) / (w0 - w1));
+
+        /* Determine line direction in screen space; degenerated lines are expanded horizontally */
+        float dirX = (v1.position[0] / v1.position[3] - v0.position[0] / v0.position[3]) * halfWidth;
+        float dirY = (v1.position[1] / v1.position[3] - v0.position[1] / v0.position[3]) * halfHeight;
+
+        const float length = std::sqrt(dirX*dirX + dirY*dirY);
+        if (length > 0.0f)
+        {
+            dirX /= length;
+            dirY /= length;
+        }
+        else
+        {
+            dirX = 1.0f;
+            dirY = 0.0f;
+        }
+
+        /* Offset end points perpendicular to the line by half of the line width, converted back to normalized device coordinates */
+        const float offsetX = -dirY * halfLine / halfWidth;
+        const float offsetY =  dirX * halfLine / halfHeight;
+
+        const std::uint32_t i0 = AppendOffsetVertex(vertices, v0,  offsetX,  offsetY);
+        const std::uint32_t i1 = AppendOffsetVertex(vertices, v0, -offsetX, -offsetY);
+        const std::uint32_t i2 = AppendOffsetVertex(vertices, v1, -offsetX, -offsetY);
+        const std::uint32_t i3 = AppendOffsetVertex(vertices, v1,  offsetX,  offsetY);
+
+        /* Both triangles start with a copy of the first end point, which is the provoking vertex of the line */
+        outTriangles.insert(outTriangles.end(), { i0, i1, i2, i0, i2, i3 });
+    }
+}
+
+void ExpandPointsToTriangles(
+    const Viewport&             viewport,
+    float                       pointSize,
+    const std::uint32_t*        pointIndices,
+    std::size_t                 numPoints,
+    std::vector<NullVertex>&    vertices,
+    std::vector<std::uint32_t>& outTriangles)
+{
+    const float halfPoint   = std::max(pointSize, 1.0f) * 0.5f;
+    const float offsetX     = halfPoint / (std::max(viewport.width, 1.0f) * 0.5f);
+    const float offsetY     = halfPoint / (std::max(viewport.height, 1.0f) * 0.5f);
+
+    outTriangles.clear();
+    vertices.reserve(vertices.size() + numPoints * 4);
+
+    for_range(point, numPoints)
+    {
+        const NullVertex v = vertices[pointIndices[point]];
+        if (v.position[3] < g_nullMinClipW)
+            continue;
+
+        const std::uint32_t i0 = AppendOffsetVertex(vertices, v, -offsetX, -offsetY);
+        const std::uint32_t i1 = AppendOffsetVertex(vertices, v,  offsetX, -offsetY);
+        const std::uint32_t i2 = AppendOffsetVertex(vertices, v,  offsetX,  offsetY);
+        const std::uint32_t i3 = AppendOffsetVertex(vertices, v, -offsetX,  offsetY);
+
+        outTriangles.insert(outTriangles.end(), { i0, i1, i2, i0, i2, i3 });
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
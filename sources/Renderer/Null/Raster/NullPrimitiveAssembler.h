@@ -0,0 +1,87 @@
+/*
+ * NullPrimitiveAssembler.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_PRIMITIVE_ASSEMBLER_H
+#define LLGL_NULL_PRIMITIVE_ASSEMBLER_H
+
+
+#include <LLGL/PipelineStateFlags.h>
+#include "NullRasterizer.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Index value that restarts strips. Indices are remapped to 32 bits, so this is also used for 16-bit index buffers.
+static constexpr std::uint32_t g_nullRestartIndex = 0xFFFFFFFFu;
+
+// Basic primitive type the assembler outputs for a primitive topology.
+enum class NullPrimitiveType
+{
+    Undefined,  // Patches, which cannot be drawn without tessellation.
+    Point,
+    Line,
+    Triangle,
+};
+
+// Returns the primitive type for the specified topology. Adjacency topologies output lines and triangles without their adjacent vertices.
+NullPrimitiveType GetPrimitiveType(const PrimitiveTopology topology);
+
+// Returns the number of vertices per primitive of the specified type, i.e. 1 for points, 2 for lines, and 3 for triangles.
+std::uint32_t GetPrimitiveSize(const NullPrimitiveType type);
+
+/*
+Assembles the primitives of the specified topology from a stream of indices and writes GetPrimitiveSize() indices per primitive into 'outIndices'.
+The restart index g_nullRestartIndex starts a new strip or discards an incomplete primitive of a list.
+Odd triangles of strips keep the winding of the strip, but start with the first vertex of the triangle, so it remains the provoking vertex.
+Returns the number of assembled primitives.
+*/
+std::size_t AssemblePrimitives(
+    const PrimitiveTopology     topology,
+    const std::uint32_t*        indices,
+    std::size_t                 numIndices,
+    std::vector<std::uint32_t>& outIndices
+);
+
+/*
+Expands lines into screen-aligned quads of the specified width (in pixels), because the rasterizer only accepts triangles.
+The quad vertices are appended to 'vertices' and their triangles are written into 'outTriangles'. Lines are clipped against the w=0 plane beforehand.
+*/
+void ExpandLinesToTriangles(
+    const Viewport&             viewport,
+    float                       lineWidth,
+    const std::uint32_t*        lineIndices,
+    std::size_t                 numLines,
+    std::vector<NullVertex>&    vertices,
+    std::vector<std::uint32_t>& outTriangles
+);
+
+/*
+Expands points into screen-aligned quads of the specified size (in pixels).
+The quad vertices are appended to 'vertices' and their triangles are written into 'outTriangles'. Points behind the w=0 plane are discarded.
+*/
+void ExpandPointsToTriangles(
+    const Viewport&             viewport,
+    float                       pointSize,
+    const std::uint32_t*        pointIndices,
+    std::size_t                 numPoints,
+    std::vector<NullVertex>&    vertices,
+    std::vector<std::uint32_t>& outTriangles
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
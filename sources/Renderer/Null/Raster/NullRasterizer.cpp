@@ -0,0 +1,1005 @@
+/*
+ * NullRasterizer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullRasterizer.h"
+#include "../../../Core/Threading.h"
+#include "../../../Core/CPUFeatures.h"
+#include "../../../Core/CompilerExtensions.h"
+#include <LLGL/Platform/Platform.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_NULL_RASTERIZER_X86
+#   include <emmintrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Constants ----- */
+
+static constexpr std::int64_t   g_subPixelBits      = 4;
+static constexpr std::int64_t   g_subPixelScale     = (1 << g_subPixelBits);
+static constexpr std::int64_t   g_subPixelHalf      = (g_subPixelScale / 2);
+static constexpr std::int32_t   g_tileSizeBits      = 6;
+static constexpr std::int32_t   g_tileSize          = (1 << g_tileSizeBits);
+static constexpr std::size_t    g_setupChunkSize    = 1024;
+
+/*
+Maximum distance (in pixels) of vertices from the viewport center before primitives are clipped against the guard band.
+This bounds the edge function values within a tile, so partially covered tiles can be rasterized with 32-bit integers.
+*/
+static constexpr float          g_guardBandSize     = 8192.0f;
+
+// Minimum W component of clip-space positions to avoid a division by zero.
+static constexpr float          g_minClipW          = 1.0e-6f;
+
+
+/* ----- Internal structures ----- */
+
+struct NullRasterizer::SetupContext
+{
+    NullFramebuffer*        framebuffer;
+    const NullRasterState*  state;
+    const NullVertex*       vertices;
+    const std::uint32_t*    indices;
+    std::int32_t            renderArea[4];      // Render area (x0, y0, x1, y1) in pixels, i.e. the intersection of framebuffer, viewport, and scissor.
+    float                   viewportScale[3];
+    float                   viewportOffset[3];
+    float                   guardBand[2];       // Guard band in normalized device coordinates.
+    std::uint32_t           clipPlaneMask;
+    std::uint32_t           numPlanes;
+    std::uint32_t           numTilesX;
+};
+
+// Clip-space vertex with barycentric coordinates relative to the original triangle, so varyings are only interpolated for the final triangles.
+struct NullClipVertex
+{
+    float position[4];
+    float barycentric[3];
+};
+
+
+/* ----- Clipping ----- */
+
+enum NullClipPlane
+{
+    NullClipPlaneW = 0,
+    NullClipPlaneNear,
+    NullClipPlaneFar,
+    NullClipPlaneRight,
+    NullClipPlaneLeft,
+    NullClipPlaneBottom,
+    NullClipPlaneTop,
+
+    NullClipPlaneCount,
+};
+
+// Returns the signed distance of the clip-space position to the specified plane. Positive values are inside.
+static float GetClipDistance(const float position[4], int plane, const float guardBand[2])
+{
+    switch (plane)
+    {
+        case NullClipPlaneW:        return position[3] - g_minClipW;
+        case NullClipPlaneNear:     return position[2];
+        case NullClipPlaneFar:      return position[3] - position[2];
+        case NullClipPlaneRight:    return guardBand[0] * position[3] - position[0];
+        case NullClipPlaneLeft:     return guardBand[0] * position[3] + position[0];
+        case NullClipPlaneBottom:   return guardBand[1] * position[3] - position[1];
+        default:                    return guardBand[1] * position[3] + position[1];
+    }
+}
+
+static std::uint32_t GetClipOutcode(const float position[4], std::uint32_t clipPlaneMask, const float guardBand[2])
+{
+    std::uint32_t outcode = 0;
+    for_range(plane, NullClipPlaneCount)
+    {
+        if (((clipPlaneMask >> plane) & 0x1) != 0 && GetClipDistance(position, plane, guardBand) < 0.0f)
+            outcode |= (1u << plane);
+    }
+    return outcode;
+}
+
+static void LerpClipVertex(NullClipVertex& dst, const NullClipVertex& a, const NullClipVertex& b, float t)
+{
+    for_range(i, 4)
+        dst.position[i] = a.position[i] + (b.position[i] - a.position[i]) * t;
+    for_range(i, 3)
+        dst.barycentric[i] = a.barycentric[i] + (b.barycentric[i] - a.barycentric[i]) * t;
+}
+
+// Clips the convex polygon against the specified plane (Sutherland-Hodgman) and returns the number of output vertices.
+static std::uint32_t ClipPolygon(const NullClipVertex* src, std::uint32_t numVertices, NullClipVertex* dst, int plane, const float guardBand[2])
+{
+    std::uint32_t numOutput = 0;
+    for_range(i, numVertices)
+    {
+        const NullClipVertex& a = src[i];
+        const NullClipVertex& b = src[(i + 1) % numVertices];
+        const float distA = GetClipDistance(a.position, plane, guardBand);
+        const float distB = GetClipDistance(b.position, plane, guardBand);
+
+        if (distA >= 0.0f)
+            dst[numOutput++] = a;
+        if ((distA >= 0.0f) != (distB >= 0.0f))
+            LerpClipVertex(dst[numOutput++], a, b, distA / (distA - distB));
+    }
+    return numOutput;
+}
+
+
+/* ----- Triangle setup ----- */
+
+// Returns floor(a / 2^bits) for signed integers.
+static std::int64_t FloorShift(std::int64_t a, std::int64_t bits)
+{
+    return (a >= 0 ? (a >> bits) : -((-a + (1ll << bits) - 1) >> bits));
+}
+
+static void SetupScreenTriangle(
+    const NullRasterizer::SetupContext& context,
+    NullRasterizer::SetupChunk&         chunk,
+    const NullClipVertex* const         clipVertices[3],
+    const NullVertex* const             vertices[3])
+{
+    const NullRasterState& state = *context.state;
+
+    /* Project vertices into screen space and snap them to the fixed-point grid */
+    float           screenPos[3][3];
+    float           invW[3];
+    std::int64_t    fixedPos[3][2];
+
+    for_range(i, 3)
+    {
+        const float* position = clipVertices[i]->position;
+        invW[i] = 1.0f / position[3];
+        for_range(j, 3)
+            screenPos[i][j] = position[j] * invW[i] * context.viewportScale[j] + context.viewportOffset[j];
+        fixedPos[i][0] = static_cast<std::int64_t>(std::floor(screenPos[i][0] * static_cast<float>(g_subPixelScale) + 0.5f));
+        fixedPos[i][1] = static_cast<std::int64_t>(std::floor(screenPos[i][1] * static_cast<float>(g_subPixelScale) + 0.5f));
+    }
+
+    /* Determine facing; counter-clockwise triangles on screen have a negative area, because the Y-axis points downwards */
+    const std::int64_t area =
+    (
+        (fixedPos[1][0] - fixedPos[0][0]) * (fixedPos[2][1] - fixedPos[0][1]) -
+        (fixedPos[1][1] - fixedPos[0][1]) * (fixedPos[2][0] - fixedPos[0][0])
+    );
+
+    if (area == 0)
+        return;
+
+    const bool frontFacing = ((area < 0) == state.frontCCW);
+    if ((state.cullMode == CullMode::Front && frontFacing) || (state.cullMode == CullMode::Back && !frontFacing))
+        return;
+
+    /* Compute bounding box of pixel centers covered by the triangle */
+    const std::int64_t minX = std::min({ fixedPos[0][0], fixedPos[1][0], fixedPos[2][0] });
+    const std::int64_t minY = std::min({ fixedPos[0][1], fixedPos[1][1], fixedPos[2][1] });
+    const std::int64_t maxX = std::max({ fixedPos[0][0], fixedPos[1][0], fixedPos[2][0] });
+    const std::int64_t maxY = std::max({ fixedPos[0][1], fixedPos[1][1], fixedPos[2][1] });
+
+    NullRasterizer::Triangle triangle;
+    triangle.minX = static_cast<std::int32_t>(std::max<std::int64_t>(context.renderArea[0], FloorShift(minX - g_subPixelHalf + g_subPixelScale - 1, g_subPixelBits)));
+    triangle.minY = static_cast<std::int32_t>(std::max<std::int64_t>(context.renderArea[1], FloorShift(minY - g_subPixelHalf + g_subPixelScale - 1, g_subPixelBits)));
+    triangle.maxX = static_cast<std::int32_t>(std::min<std::int64_t>(context.renderArea[2], FloorShift(maxX - g_subPixelHalf, g_subPixelBits) + 1));
+    triangle.maxY = static_cast<std::int32_t>(std::min<std::int64_t>(context.renderArea[3], FloorShift(maxY - g_subPixelHalf, g_subPixelBits) + 1));
+
+    if (triangle.minX >= triangle.maxX || triangle.minY >= triangle.maxY)
+        return;
+
+    /* Setup edge functions with positive values inside by swapping the winding of triangles with negative area */
+    const int order[3] = { 0, (area > 0 ? 1 : 2), (area > 0 ? 2 : 1) };
+
+    for_range(i, 3)
+    {
+        const std::int64_t* a = fixedPos[order[i]];
+        const std::int64_t* b = fixedPos[order[(i + 1) % 3]];
+
+        const std::int64_t  edgeA   = a[1] - b[1];
+        const std::int64_t  edgeB   = b[0] - a[0];
+        const std::int64_t  edgeC   = -(edgeA * a[0] + edgeB * a[1]);
+
+        /* Top-left fill rule: Pixel centers exactly on an edge are only covered by left edges and horizontal top edges */
+        const bool isTopLeft = (edgeA > 0 || (edgeA == 0 && edgeB > 0));
+
+        triangle.edges[i]       = edgeA * g_subPixelHalf + edgeB * g_subPixelHalf + edgeC - (isTopLeft ? 0 : 1);
+        triangle.edgeStepsX[i]  = edgeA * g_subPixelScale;
+        triangle.edgeStepsY[i]  = edgeB * g_subPixelScale;
+    }
+
+    triangle.frontFacing = frontFacing;
+
+    /* Setup plane equations relative to the first snapped vertex */
+    const double x0 = static_cast<double>(fixedPos[0][0]) / g_subPixelScale;
+    const double y0 = static_cast<double>(fixedPos[0][1]) / g_subPixelScale;
+    const double x1 = static_cast<double>(fixedPos[1][0]) / g_subPixelScale - x0;
+    const double y1 = static_cast<double>(fixedPos[1][1]) / g_subPixelScale - y0;
+    const double x2 = static_cast<double>(fixedPos[2][0]) / g_subPixelScale - x0;
+    const double y2 = static_cast<double>(fixedPos[2][1]) / g_subPixelScale - y0;
+
+    const double invDet = 1.0 / (x1 * y2 - x2 * y1);
+
+    triangle.originX        = static_cast<float>(x0);
+    triangle.originY        = static_cast<float>(y0);
+    triangle.planeOffset    = chunk.planes.size();
+    triangle.planes         = nullptr;
+
+    auto AddPlane = [&chunk, x1, y1, x2, y2, invDet](double a0, double a1, double a2)
+    {
+        a1 -= a0;
+        a2 -= a0;
+        chunk.planes.push_back(static_cast<float>((a1 * y2 - a2 * y1) * invDet));
+        chunk.planes.push_back(static_cast<float>((a2 * x1 - a1 * x2) * invDet));
+        chunk.planes.push_back(static_cast<float>(a0));
+    };
+
+    /* Depth and 1/w are affine in screen space, so are varyings divided by w for perspective-correct interpolation */
+    AddPlane(screenPos[0][2], screenPos[1][2], screenPos[2][2]);
+    AddPlane(invW[0], invW[1], invW[2]);
+
+    /* Offset depth plane by constant and slope-scaled depth bias; the result is clamped to the depth range per fragment */
+    const DepthBiasDescriptor& depthBias = state.depthBias;
+    if (depthBias.constantFactor != 0.0f || depthBias.slopeFactor != 0.0f)
+    {
+        float* depthPlane = &(chunk.planes[triangle.planeOffset]);
+        const float maxDepth = std::max({ std::abs(screenPos[0][2]), std::abs(screenPos[1][2]), std::abs(screenPos[2][2]) });
+        const float maxSlope = std::max(std::abs(depthPlane[0]), std::abs(depthPlane[1]));
+        float bias = depthBias.constantFactor * context.framebuffer->GetDepthResolution(maxDepth) + depthBias.slopeFactor * maxSlope;
+        if (depthBias.clamp > 0.0f)
+            bias = std::min(bias, depthBias.clamp);
+        else if (depthBias.clamp < 0.0f)
+            bias = std::max(bias, depthBias.clamp);
+        depthPlane[2] += bias;
+    }
+
+    for_range(varying, state.numVaryings)
+    {
+        const bool isFlat = (((state.flatVaryingMask >> varying) & 1u) != 0);
+        for_range(component, 4)
+        {
+            double values[3];
+            for_range(i, 3)
+            {
+                const float* barycentric = clipVertices[i]->barycentric;
+                if (isFlat)
+                    values[i] = vertices[0]->varyings[varying][component] * invW[i];
+                else
+                {
+                    values[i] =
+                    (
+                        barycentric[0] * vertices[0]->varyings[varying][component] +
+                        barycentric[1] * vertices[1]->varyings[varying][component] +
+                        barycentric[2] * vertices[2]->varyings[varying][component]
+                    ) * invW[i];
+                }
+            }
+            AddPlane(values[0], values[1], values[2]);
+        }
+    }
+
+    chunk.triangles.push_back(triangle);
+}
+
+void NullRasterizer::SetupTriangles(const SetupContext& context, SetupChunk& chunk, std::size_t firstTriangle, std::size_t numTriangles)
+{
+    chunk.triangles.clear();
+    chunk.planes.clear();
+    chunk.numClippedTriangles = 0;
+
+    for_subrange(triangleIndex, firstTriangle, firstTriangle + numTriangles)
+    {
+        const std::uint32_t* indices = &(context.indices[triangleIndex * 3]);
+        const NullVertex* vertices[3] =
+        {
+            &(context.vertices[indices[0]]),
+            &(context.vertices[indices[1]]),
+            &(context.vertices[indices[2]]),
+        };
+
+        /* Initialize clip vertices with barycentric coordinates of the triangle corners */
+        NullClipVertex polygon[2][NullClipPlaneCount + 3];
+        std::uint32_t outcodes[3];
+
+        for_range(i, 3)
+        {
+            NullClipVertex& clipVertex = polygon[0][i];
+            ::memcpy(clipVertex.position, vertices[i]->position, sizeof(clipVertex.position));
+            clipVertex.barycentric[0] = (i == 0 ? 1.0f : 0.0f);
+            clipVertex.barycentric[1] = (i == 1 ? 1.0f : 0.0f);
+            clipVertex.barycentric[2] = (i == 2 ? 1.0f : 0.0f);
+            outcodes[i] = GetClipOutcode(clipVertex.position, context.clipPlaneMask, context.guardBand);
+        }
+
+        /* Reject triangles that are entirely outside of any clip plane */
+        if ((outcodes[0] & outcodes[1] & outcodes[2]) != 0)
+            continue;
+
+        /* Clip triangle against each plane it intersects */
+        std::uint32_t numVertices = 3;
+        int polygonIndex = 0;
+
+        if (const std::uint32_t clipPlanes = (outcodes[0] | outcodes[1] | outcodes[2]))
+        {
+            for_range(plane, NullClipPlaneCount)
+            {
+                if (((clipPlanes >> plane) & 0x1) != 0)
+                {
+                    numVertices = ClipPolygon(polygon[polygonIndex], numVertices, polygon[1 - polygonIndex], plane, context.guardBand);
+                    polygonIndex = 1 - polygonIndex;
+                    if (numVertices < 3)
+                        break;
+                }
+            }
+        }
+
+        /* Setup clipped polygon as triangle fan */
+        if (numVertices >= 3)
+            chunk.numClippedTriangles += numVertices - 2;
+
+        const NullClipVertex* clipVertices = polygon[polygonIndex];
+        for (std::uint32_t i = 2; i < numVertices; ++i)
+        {
+            const NullClipVertex* fan[3] = { &clipVertices[0], &clipVertices[i - 1], &clipVertices[i] };
+            SetupScreenTriangle(context, chunk, fan, vertices);
+        }
+    }
+
+    /* Resolve plane pointers once the plane array no longer grows */
+    for (Triangle& triangle : chunk.triangles)
+        triangle.planes = chunk.planes.data() + triangle.planeOffset;
+}
+
+
+/* ----- Coverage kernels ----- */
+
+/*
+Computes the coverage masks for a row of 2x2 quads from three edge functions.
+The edge values are specified for the first lane of the first quad; a fragment is covered if all edge values are non-negative.
+*/
+typedef void (*PFN_ComputeQuadRowCoverage)(
+    const std::int32_t  edges[3],
+    const std::int32_t  edgeStepsX[3],
+    const std::int32_t  edgeStepsY[3],
+    std::int32_t        numQuads,
+    std::uint8_t*       outMasks
+);
+
+static void ComputeQuadRowCoverageScalar(
+    const std::int32_t  edges[3],
+    const std::int32_t  edgeStepsX[3],
+    const std::int32_t  edgeStepsY[3],
+    std::int32_t        numQuads,
+    std::uint8_t*       outMasks)
+{
+    for_range(quad, numQuads)
+    {
+        std::uint8_t mask = 0;
+        for_range(lane, 4)
+        {
+            const std::int32_t x = quad * 2 + static_cast<std::int32_t>(lane & 1);
+            const std::int32_t y = static_cast<std::int32_t>(lane >> 1);
+            bool inside = true;
+            for_range(i, 3)
+                inside = inside && (edges[i] + edgeStepsX[i] * x + edgeStepsY[i] * y >= 0);
+            if (inside)
+                mask |= (1u << lane);
+        }
+        outMasks[quad] = mask;
+    }
+}
+
+#if defined LLGL_NULL_RASTERIZER_X86
+
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void ComputeQuadRowCoverageSSE2(
+    const std::int32_t  edges[3],
+    const std::int32_t  edgeStepsX[3],
+    const std::int32_t  edgeStepsY[3],
+    std::int32_t        numQuads,
+    std::uint8_t*       outMasks)
+{
+    __m128i edgeValues[3], quadSteps[3];
+    for_range(i, 3)
+    {
+        edgeValues[i]   = _mm_add_epi32(_mm_set1_epi32(edges[i]), _mm_set_epi32(edgeStepsX[i] + edgeStepsY[i], edgeStepsY[i], edgeStepsX[i], 0));
+        quadSteps[i]    = _mm_set1_epi32(edgeStepsX[i] * 2);
+    }
+
+    for_range(quad, numQuads)
+    {
+        /* Sign bit of the combined edge values is set if any edge function is negative */
+        const __m128i outside = _mm_or_si128(_mm_or_si128(edgeValues[0], edgeValues[1]), edgeValues[2]);
+        outMasks[quad] = static_cast<std::uint8_t>(~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF);
+
+        edgeValues[0] = _mm_add_epi32(edgeValues[0], quadSteps[0]);
+        edgeValues[1] = _mm_add_epi32(edgeValues[1], quadSteps[1]);
+        edgeValues[2] = _mm_add_epi32(edgeValues[2], quadSteps[2]);
+    }
+}
+
+#endif // /LLGL_NULL_RASTERIZER_X86
+
+static PFN_ComputeQuadRowCoverage FindQuadRowCoverageKernel()
+{
+    #if defined LLGL_NULL_RASTERIZER_X86
+    if ((GetCPUFeatures() & CPUFeatureFlags::SSE2) != 0)
+        return ComputeQuadRowCoverageSSE2;
+    #endif
+    return ComputeQuadRowCoverageScalar;
+}
+
+
+/* ----- Per-fragment operations ----- */
+
+template <typename T>
+static bool CompareValues(CompareOp compareOp, T src, T dst)
+{
+    switch (compareOp)
+    {
+        case CompareOp::NeverPass:      return false;
+        case CompareOp::Less:           return (src <  dst);
+        case CompareOp::Equal:          return (src == dst);
+        case CompareOp::LessEqual:      return (src <= dst);
+        case CompareOp::Greater:        return (src >  dst);
+        case CompareOp::NotEqual:       return (src != dst);
+        case CompareOp::GreaterEqual:   return (src >= dst);
+        default:                        return true;
+    }
+}
+
+static std::uint32_t ApplyStencilOp(StencilOp stencilOp, std::uint32_t value, std::uint32_t reference)
+{
+    switch (stencilOp)
+    {
+        case StencilOp::Keep:       return value;
+        case StencilOp::Zero:       return 0;
+        case StencilOp::Replace:    return reference;
+        case StencilOp::IncClamp:   return std::min(value + 1, 0xFFu);
+        case StencilOp::DecClamp:   return (value > 0 ? value - 1 : 0);
+        case StencilOp::Invert:     return ~value;
+        case StencilOp::IncWrap:    return value + 1;
+        case StencilOp::DecWrap:    return value - 1;
+        default:                    return value;
+    }
+}
+
+// Performs the depth and stencil tests for the covered fragments of the quad and returns the mask of fragments that passed.
+static std::uint32_t TestDepthStencil(const NullRasterizer::SetupContext& context, const NullFragmentQuad& quad, std::uint32_t mask)
+{
+    const NullRasterState&  state           = *context.state;
+    NullFramebuffer&        framebuffer     = *context.framebuffer;
+    float*                  depthBuffer     = framebuffer.GetDepthBuffer();
+    std::uint8_t*           stencilBuffer   = framebuffer.GetStencilBuffer();
+
+    const bool depthTest    = (state.depth.testEnabled && depthBuffer != nullptr);
+    const bool depthWrite   = (depthTest && state.depth.writeEnabled);
+    const bool stencilTest  = (state.stencil.testEnabled && stencilBuffer != nullptr);
+
+    if (!depthTest && !stencilTest)
+        return mask;
+
+    const StencilFaceDescriptor& stencilFace = (quad.frontFacing ? state.stencil.front : state.stencil.back);
+    const std::uint32_t stencilRef = (stencilFace.reference & stencilFace.readMask & 0xFF);
+
+    for_range(lane, 4)
+    {
+        if (((mask >> lane) & 0x1) == 0)
+            continue;
+
+        const std::size_t index = static_cast<std::size_t>(quad.y + static_cast<std::int32_t>(lane >> 1)) * framebuffer.GetWidth() + static_cast<std::size_t>(quad.x + static_cast<std::int32_t>(lane & 1));
+        bool passed = true;
+
+        StencilOp stencilOp = StencilOp::Keep;
+        if (stencilTest)
+        {
+            const std::uint32_t stencilValue = (stencilBuffer[index] & stencilFace.readMask);
+            if (!CompareValues(stencilFace.compareOp, stencilRef, stencilValue))
+            {
+                stencilOp   = stencilFace.stencilFailOp;
+                passed      = false;
+            }
+            else
+                stencilOp   = stencilFace.depthPassOp;
+        }
+
+        if (passed && depthTest)
+        {
+            if (!CompareValues(state.depth.compareOp, quad.fragDepth[lane], depthBuffer[index]))
+            {
+                stencilOp   = stencilFace.depthFailOp;
+                passed      = false;
+            }
+            else if (depthWrite)
+                depthBuffer[index] = quad.fragDepth[lane];
+        }
+
+        if (stencilTest && stencilOp != StencilOp::Keep)
+        {
+            const std::uint32_t oldValue = stencilBuffer[index];
+            const std::uint32_t newValue = ApplyStencilOp(stencilOp, oldValue, stencilFace.reference & 0xFF);
+            stencilBuffer[index] = static_cast<std::uint8_t>(((oldValue & ~stencilFace.writeMask) | (newValue & stencilFace.writeMask)) & 0xFF);
+        }
+
+        if (!passed)
+            mask &= ~(1u << lane);
+    }
+
+    return mask;
+}
+
+static void GetBlendFactor(BlendOp blendOp, const float src[4], const float src1[4], const float dst[4], const float blendFactor[4], float outFactor[4])
+{
+    switch (blendOp)
+    {
+        case BlendOp::Zero:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 0.0f;
+            break;
+        case BlendOp::One:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 1.0f;
+            break;
+        case BlendOp::SrcColor:
+            for_range(i, 4) { outFactor[i] = src[i]; }
+            break;
+        case BlendOp::InvSrcColor:
+            for_range(i, 4) { outFactor[i] = 1.0f - src[i]; }
+            break;
+        case BlendOp::SrcAlpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = src[3];
+            break;
+        case BlendOp::InvSrcAlpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 1.0f - src[3];
+            break;
+        case BlendOp::DstColor:
+            for_range(i, 4) { outFactor[i] = dst[i]; }
+            break;
+        case BlendOp::InvDstColor:
+            for_range(i, 4) { outFactor[i] = 1.0f - dst[i]; }
+            break;
+        case BlendOp::DstAlpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = dst[3];
+            break;
+        case BlendOp::InvDstAlpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 1.0f - dst[3];
+            break;
+        case BlendOp::SrcAlphaSaturate:
+            outFactor[0] = outFactor[1] = outFactor[2] = std::min(src[3], 1.0f - dst[3]);
+            outFactor[3] = 1.0f;
+            break;
+        case BlendOp::BlendFactor:
+            for_range(i, 4) { outFactor[i] = blendFactor[i]; }
+            break;
+        case BlendOp::InvBlendFactor:
+            for_range(i, 4) { outFactor[i] = 1.0f - blendFactor[i]; }
+            break;
+        case BlendOp::Src1Color:
+            for_range(i, 4) { outFactor[i] = src1[i]; }
+            break;
+        case BlendOp::InvSrc1Color:
+            for_range(i, 4) { outFactor[i] = 1.0f - src1[i]; }
+            break;
+        case BlendOp::Src1Alpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = src1[3];
+            break;
+        case BlendOp::InvSrc1Alpha:
+            outFactor[0] = outFactor[1] = outFactor[2] = outFactor[3] = 1.0f - src1[3];
+            break;
+    }
+}
+
+static float BlendValues(BlendArithmetic arithmetic, float src, float srcFactor, float dst, float dstFactor)
+{
+    switch (arithmetic)
+    {
+        case BlendArithmetic::Add:          return (src * srcFactor + dst * dstFactor);
+        case BlendArithmetic::Subtract:     return (src * srcFactor - dst * dstFactor);
+        case BlendArithmetic::RevSubtract:  return (dst * dstFactor - src * srcFactor);
+        case BlendArithmetic::Min:          return std::min(src, dst);
+        case BlendArithmetic::Max:          return std::max(src, dst);
+        default:                            return src;
+    }
+}
+
+// Blends the color outputs of the covered fragments into the color buffers.
+static void WriteColorOutputs(const NullRasterizer::SetupContext& context, const NullFragmentQuad& quad, std::uint32_t mask)
+{
+    const NullRasterState&  state       = *context.state;
+    const NullFramebuffer&  framebuffer = *context.framebuffer;
+
+    for_range(target, framebuffer.GetNumColorBuffers())
+    {
+        const NullColorBuffer* colorBuffer = framebuffer.GetColorBuffer(target);
+        if (colorBuffer == nullptr)
+            continue;
+
+        const BlendTargetDescriptor& blendTarget = state.blend.targets[state.blend.independentBlendEnabled ? target : 0];
+        if (blendTarget.colorMask == 0)
+            continue;
+
+        for_range(lane, 4)
+        {
+            if (((mask >> lane) & 0x1) == 0)
+                continue;
+
+            const std::size_t index = static_cast<std::size_t>(quad.y + static_cast<std::int32_t>(lane >> 1)) * framebuffer.GetWidth() + static_cast<std::size_t>(quad.x + static_cast<std::int32_t>(lane & 1));
+            float* dst = colorBuffer->pixels + index * 4;
+
+            float src[4];
+            for_range(i, 4)
+                src[i] = std::max(colorBuffer->minValue, std::min(quad.colors[target][i][lane], colorBuffer->maxValue));
+
+            if (blendTarget.blendEnabled)
+            {
+                /* Second color output is the source for dual-source blending */
+                float src1[4];
+                for_range(i, 4)
+                    src1[i] = quad.colors[1][i][lane];
+
+                float srcColorFactor[4], dstColorFactor[4], srcAlphaFactor[4], dstAlphaFactor[4];
+                GetBlendFactor(blendTarget.srcColor, src, src1, dst, state.blend.blendFactor, srcColorFactor);
+                GetBlendFactor(blendTarget.dstColor, src, src1, dst, state.blend.blendFactor, dstColorFactor);
+                GetBlendFactor(blendTarget.srcAlpha, src, src1, dst, state.blend.blendFactor, srcAlphaFactor);
+                GetBlendFactor(blendTarget.dstAlpha, src, src1, dst, state.blend.blendFactor, dstAlphaFactor);
+
+                float result[4];
+                for_range(i, 3)
+                    result[i] = BlendValues(blendTarget.colorArithmetic, src[i], srcColorFactor[i], dst[i], dstColorFactor[i]);
+                result[3] = BlendValues(blendTarget.alphaArithmetic, src[3], srcAlphaFactor[3], dst[3], dstAlphaFactor[3]);
+
+                for_range(i, 4)
+                    src[i] = std::max(colorBuffer->minValue, std::min(result[i], colorBuffer->maxValue));
+            }
+
+            for_range(i, 4)
+            {
+                if (((blendTarget.colorMask >> i) & 0x1) != 0)
+                    dst[i] = src[i];
+            }
+        }
+    }
+}
+
+// Returns the number of lanes in the specified 4-bit quad mask.
+static std::uint64_t CountQuadLanes(std::uint32_t mask)
+{
+    return ((mask & 0x1) + ((mask >> 1) & 0x1) + ((mask >> 2) & 0x1) + ((mask >> 3) & 0x1));
+}
+
+static void ShadeQuad(
+    const NullRasterizer::SetupContext& context,
+    const NullRasterizer::Triangle&     triangle,
+    NullFragmentQuad&                   quad,
+    std::uint32_t                       mask,
+    NullRasterStatistics&               statistics)
+{
+    const NullRasterState& state = *context.state;
+
+    /* Interpolate window coordinates for all lanes, so derivatives are also available for uncovered fragments */
+    const float minDepth = std::min(state.viewport.minDepth, state.viewport.maxDepth);
+    const float maxDepth = std::max(state.viewport.minDepth, state.viewport.maxDepth);
+
+    float dx[4], dy[4];
+    for_range(lane, 4)
+    {
+        const float x = static_cast<float>(quad.x + static_cast<std::int32_t>(lane & 1)) + 0.5f;
+        const float y = static_cast<float>(quad.y + static_cast<std::int32_t>(lane >> 1)) + 0.5f;
+
+        dx[lane] = x - triangle.originX;
+        dy[lane] = y - triangle.originY;
+
+        const float* planes = triangle.planes;
+        const float z = std::max(minDepth, std::min(planes[0] * dx[lane] + planes[1] * dy[lane] + planes[2], maxDepth));
+
+        quad.fragCoord[0][lane] = x;
+        quad.fragCoord[1][lane] = y;
+        quad.fragCoord[2][lane] = z;
+        quad.fragCoord[3][lane] = planes[3] * dx[lane] + planes[4] * dy[lane] + planes[5];
+        quad.fragDepth[lane]    = z;
+    }
+
+    if (state.earlyFragmentTests)
+    {
+        mask = TestDepthStencil(context, quad, mask);
+        if (mask == 0)
+            return;
+    }
+
+    /* Interpolate varyings perspective-correct */
+    float w[4];
+    for_range(lane, 4)
+        w[lane] = 1.0f / quad.fragCoord[3][lane];
+
+    const float* planes = triangle.planes + 6;
+    for_range(varying, state.numVaryings)
+    {
+        for_range(component, 4)
+        {
+            for_range(lane, 4)
+                quad.varyings[varying][component][lane] = (planes[0] * dx[lane] + planes[1] * dy[lane] + planes[2]) * w[lane];
+            planes += 3;
+        }
+    }
+
+    /* Invoke fragment shader */
+    quad.mask = mask;
+    if (state.fragmentShader)
+    {
+        statistics.fragmentShaderInvocations += CountQuadLanes(mask);
+        state.fragmentShader(quad);
+        mask &= quad.mask;
+    }
+
+    if (!state.earlyFragmentTests)
+        mask = TestDepthStencil(context, quad, mask);
+
+    if (mask != 0)
+    {
+        statistics.samplesPassed += CountQuadLanes(mask);
+        WriteColorOutputs(context, quad, mask);
+    }
+}
+
+
+/* ----- Tile rasterization ----- */
+
+void NullRasterizer::RasterizeTile(const SetupContext& context, std::uint32_t tileIndex, NullRasterStatistics& statistics)
+{
+    static const PFN_ComputeQuadRowCoverage computeQuadRowCoverage = FindQuadRowCoverageKernel();
+
+    const std::int32_t tileX = static_cast<std::int32_t>(tileIndex % context.numTilesX) * g_tileSize;
+    const std::int32_t tileY = static_cast<std::int32_t>(tileIndex / context.numTilesX) * g_tileSize;
+
+    const std::int32_t tileMinX = std::max(tileX, context.renderArea[0]);
+    const std::int32_t tileMinY = std::max(tileY, context.renderArea[1]);
+    const std::int32_t tileMaxX = std::min(tileX + g_tileSize, context.renderArea[2]);
+    const std::int32_t tileMaxY = std::min(tileY + g_tileSize, context.renderArea[3]);
+
+    NullFragmentQuad    quad;
+    std::uint8_t        quadMasks[g_tileSize / 2 + 1];
+
+    for (const Triangle* triangle : bins_[tileIndex])
+    {
+        /* Intersect tile with bounding box of triangle */
+        const std::int32_t minX = std::max(tileMinX, triangle->minX);
+        const std::int32_t minY = std::max(tileMinY, triangle->minY);
+        const std::int32_t maxX = std::min(tileMaxX, triangle->maxX);
+        const std::int32_t maxY = std::min(tileMaxY, triangle->maxY);
+
+        if (minX >= maxX || minY >= maxY)
+            continue;
+
+        /* Align region to quads */
+        const std::int32_t quadMinX = (minX & ~1);
+        const std::int32_t quadMinY = (minY & ~1);
+        const std::int32_t numQuads = (maxX - quadMinX + 1) / 2;
+
+        /*
+        Classify edges by the corners of the region: Edges that are negative at all corners reject the triangle,
+        and edges that are non-negative at all corners don't need to be evaluated. Partial edges cross the region,
+        which bounds their values, so they can be evaluated with 32-bit integers.
+        */
+        std::int32_t edges[3], edgeStepsX[3], edgeStepsY[3];
+        bool rejected = false;
+
+        for_range(i, 3)
+        {
+            const std::int64_t edge00   = triangle->edges[i] + triangle->edgeStepsX[i] * minX + triangle->edgeStepsY[i] * minY;
+            const std::int64_t stepX    = triangle->edgeStepsX[i] * (maxX - 1 - minX);
+            const std::int64_t stepY    = triangle->edgeStepsY[i] * (maxY - 1 - minY);
+            const std::int64_t minEdge  = edge00 + std::min<std::int64_t>(stepX, 0) + std::min<std::int64_t>(stepY, 0);
+            const std::int64_t maxEdge  = edge00 + std::max<std::int64_t>(stepX, 0) + std::max<std::int64_t>(stepY, 0);
+
+            if (maxEdge < 0)
+            {
+                rejected = true;
+                break;
+            }
+
+            if (minEdge >= 0)
+            {
+                edges[i]        = 0;
+                edgeStepsX[i]   = 0;
+                edgeStepsY[i]   = 0;
+            }
+            else
+            {
+                edges[i]        = static_cast<std::int32_t>(triangle->edges[i] + triangle->edgeStepsX[i] * quadMinX + triangle->edgeStepsY[i] * quadMinY);
+                edgeStepsX[i]   = static_cast<std::int32_t>(triangle->edgeStepsX[i]);
+                edgeStepsY[i]   = static_cast<std::int32_t>(triangle->edgeStepsY[i]);
+            }
+        }
+
+        if (rejected)
+            continue;
+
+        quad.frontFacing = triangle->frontFacing;
+
+        for (std::int32_t y = quadMinY; y < maxY; y += 2)
+        {
+            computeQuadRowCoverage(edges, edgeStepsX, edgeStepsY, numQuads, quadMasks);
+
+            /* Mask out lanes of quads that lie outside the region */
+            std::uint32_t rowMask = 0xF;
+            if (y < minY)
+                rowMask &= 0xC;
+            if (y + 1 >= maxY)
+                rowMask &= 0x3;
+
+            for_range(i, numQuads)
+            {
+                const std::int32_t x = quadMinX + i * 2;
+
+                std::uint32_t mask = quadMasks[i] & rowMask;
+                if (x < minX)
+                    mask &= 0xA;
+                if (x + 1 >= maxX)
+                    mask &= 0x5;
+
+                if (mask != 0)
+                {
+                    quad.x = x;
+                    quad.y = y;
+                    ShadeQuad(context, *triangle, quad, mask, statistics);
+                }
+            }
+
+            for_range(i, 3)
+                edges[i] += edgeStepsY[i] * 2;
+        }
+    }
+}
+
+
+/* ----- Drawing ----- */
+
+void NullRasterizer::DrawTriangles(
+    NullFramebuffer&        framebuffer,
+    const NullRasterState&  state,
+    const NullVertex*       vertices,
+    const std::uint32_t*    indices,
+    std::size_t             numTriangles,
+    NullRasterStatistics&   statistics)
+{
+    if (!framebuffer.IsActive() || numTriangles == 0)
+        return;
+
+    statistics.clippingInvocations += numTriangles;
+
+    const Viewport& viewport = state.viewport;
+    if (!(viewport.width > 0.0f && viewport.height > 0.0f))
+        return;
+
+    SetupContext context;
+    {
+        context.framebuffer = &framebuffer;
+        context.state       = &state;
+        context.vertices    = vertices;
+        context.indices     = indices;
+
+        /* Limit render area to framebuffer, viewport, and scissor rectangle */
+        context.renderArea[0] = std::max(0, static_cast<std::int32_t>(std::floor(viewport.x)));
+        context.renderArea[1] = std::max(0, static_cast<std::int32_t>(std::floor(viewport.y)));
+        context.renderArea[2] = std::min(static_cast<std::int32_t>(framebuffer.GetWidth()), static_cast<std::int32_t>(std::ceil(viewport.x + viewport.width)));
+        context.renderArea[3] = std::min(static_cast<std::int32_t>(framebuffer.GetHeight()), static_cast<std::int32_t>(std::ceil(viewport.y + viewport.height)));
+
+        if (state.scissorTestEnabled)
+        {
+            context.renderArea[0] = std::max(context.renderArea[0], state.scissor.x);
+            context.renderArea[1] = std::max(context.renderArea[1], state.scissor.y);
+            context.renderArea[2] = std::min(context.renderArea[2], state.scissor.x + state.scissor.width);
+            context.renderArea[3] = std::min(context.renderArea[3], state.scissor.y + state.scissor.height);
+        }
+
+        /* Map normalized device coordinates to window coordinates with the origin at the upper-left corner */
+        context.viewportScale[0]    = viewport.width * 0.5f;
+        context.viewportScale[1]    = viewport.height * -0.5f;
+        context.viewportScale[2]    = viewport.maxDepth - viewport.minDepth;
+        context.viewportOffset[0]   = viewport.x + viewport.width * 0.5f;
+        context.viewportOffset[1]   = viewport.y + viewport.height * 0.5f;
+        context.viewportOffset[2]   = viewport.minDepth;
+
+        context.guardBand[0]        = std::max(1.0f, g_guardBandSize / context.viewportScale[0]);
+        context.guardBand[1]        = std::max(1.0f, g_guardBandSize / -context.viewportScale[1]);
+
+        /* Depth clamping disables clipping against near and far planes */
+        context.clipPlaneMask       = (1u << NullClipPlaneCount) - 1u;
+        if (state.depthClampEnabled)
+            context.clipPlaneMask &= ~((1u << NullClipPlaneNear) | (1u << NullClipPlaneFar));
+
+        context.numPlanes           = 2 + std::min(state.numVaryings, g_nullMaxVaryings) * 4;
+        context.numTilesX           = (framebuffer.GetWidth() + g_tileSize - 1) / g_tileSize;
+    }
+
+    if (context.renderArea[0] >= context.renderArea[2] || context.renderArea[1] >= context.renderArea[3])
+        return;
+
+    /* Setup triangles in chunks concurrently */
+    const std::size_t numChunks = (numTriangles + g_setupChunkSize - 1) / g_setupChunkSize;
+    if (chunks_.size() < numChunks)
+        chunks_.resize(numChunks);
+
+    DoConcurrent(
+        [this, &context, numTriangles](std::size_t chunkIndex)
+        {
+            const std::size_t firstTriangle = chunkIndex * g_setupChunkSize;
+            SetupTriangles(context, chunks_[chunkIndex], firstTriangle, std::min(g_setupChunkSize, numTriangles - firstTriangle));
+        },
+        numChunks,
+        LLGL_MAX_THREAD_COUNT,
+        1
+    );
+
+    /* Bin triangles into tiles in submission order */
+    const std::uint32_t numTilesY = (framebuffer.GetHeight() + g_tileSize - 1) / g_tileSize;
+    bins_.resize(static_cast<std::size_t>(context.numTilesX) * numTilesY);
+    for (std::vector<const Triangle*>& bin : bins_)
+        bin.clear();
+
+    for_range(chunkIndex, numChunks)
+    {
+        statistics.clippingPrimitives += chunks_[chunkIndex].numClippedTriangles;
+        for (const Triangle& triangle : chunks_[chunkIndex].triangles)
+        {
+            const std::int32_t tileMinX = (triangle.minX >> g_tileSizeBits);
+            const std::int32_t tileMinY = (triangle.minY >> g_tileSizeBits);
+            const std::int32_t tileMaxX = ((triangle.maxX - 1) >> g_tileSizeBits);
+            const std::int32_t tileMaxY = ((triangle.maxY - 1) >> g_tileSizeBits);
+
+            for (std::int32_t tileY = tileMinY; tileY <= tileMaxY; ++tileY)
+            {
+                for (std::int32_t tileX = tileMinX; tileX <= tileMaxX; ++tileX)
+                    bins_[static_cast<std::size_t>(tileY) * context.numTilesX + static_cast<std::size_t>(tileX)].push_back(&triangle);
+            }
+        }
+    }
+
+    activeTiles_.clear();
+    for_range(tileIndex, bins_.size())
+    {
+        if (!bins_[tileIndex].empty())
+            activeTiles_.push_back(static_cast<std::uint32_t>(tileIndex));
+    }
+
+    /*
+    Rasterize tiles concurrently; workers fetch the next tile on demand, because the workload per tile varies.
+    Each worker counts fragments locally and adds them to the shared counters once it has finished.
+    */
+    std::atomic<std::size_t>    nextTile{ 0 };
+    std::atomic<std::uint64_t>  fragmentShaderInvocations{ 0 };
+    std::atomic<std::uint64_t>  samplesPassed{ 0 };
+    const std::size_t numActiveTiles = activeTiles_.size();
+
+    DoConcurrentRange(
+        [this, &context, &nextTile, &fragmentShaderInvocations, &samplesPassed, numActiveTiles](std::size_t /*begin*/, std::size_t /*end*/)
+        {
+            NullRasterStatistics tileStatistics;
+            for (std::size_t i = nextTile++; i < numActiveTiles; i = nextTile++)
+                RasterizeTile(context, activeTiles_[i], tileStatistics);
+            fragmentShaderInvocations   += tileStatistics.fragmentShaderInvocations;
+            samplesPassed               += tileStatistics.samplesPassed;
+        },
+        numActiveTiles,
+        LLGL_MAX_THREAD_COUNT,
+        1
+    );
+
+    statistics.fragmentShaderInvocations    += fragmentShaderInvocations;
+    statistics.samplesPassed                += samplesPassed;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,153 @@
+/*
+ * NullRasterizer.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_RASTERIZER_H
+#define LLGL_NULL_RASTERIZER_H
+
+
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/Constants.h>
+#include "NullFramebuffer.h"
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Maximum number of 4-component vertex outputs that are interpolated across primitives.
+static constexpr std::uint32_t g_nullMaxVaryings = 16;
+
+// Post-transform vertex with its clip-space position and the vertex outputs that are interpolated for each fragment.
+struct NullVertex
+{
+    float position[4];
+    float varyings[g_nullMaxVaryings][4];
+};
+
+/*
+Quad of 2x2 fragments that are shaded together, so derivatives can be computed from neighboring lanes.
+Lanes are ordered (x, y), (x + 1, y), (x, y + 1), (x + 1, y + 1) and all attributes are stored as [component][lane].
+*/
+struct NullFragmentQuad
+{
+    std::int32_t    x;
+    std::int32_t    y;
+    std::uint32_t   mask;                                           // Coverage mask with one bit per lane. Fragment shaders clear bits to discard fragments.
+    bool            frontFacing;
+    float           fragCoord[4][4];                                // Window coordinates (x, y, z, 1/w) of the fragments.
+    float           fragDepth[4];                                   // Depth output, initialized with the interpolated depth.
+    float           varyings[g_nullMaxVaryings][4][4];
+    float           colors[LLGL_MAX_NUM_COLOR_ATTACHMENTS][4][4];   // Color outputs for each color attachment.
+};
+
+// Fragment shader callback that computes the color outputs of a quad. This is invoked concurrently for different tiles.
+typedef std::function<void(NullFragmentQuad& quad)> NullFragmentShaderFunc;
+
+// Pipeline and dynamic states for the rasterizer.
+struct NullRasterState
+{
+    Viewport                viewport;
+    Scissor                 scissor;
+    bool                    scissorTestEnabled  = false;
+    CullMode                cullMode            = CullMode::Disabled;
+    bool                    frontCCW            = false;
+    bool                    depthClampEnabled   = false;
+    DepthBiasDescriptor     depthBias;
+    DepthDescriptor         depth;
+    StencilDescriptor       stencil;
+    BlendDescriptor         blend;
+    std::uint32_t           numVaryings         = 0;
+    std::uint32_t           flatVaryingMask     = 0;        // Bit mask of varyings that are not interpolated but take the value of the first vertex.
+    bool                    earlyFragmentTests  = true;     // Depth and stencil tests are performed before the fragment shader if it neither discards fragments nor writes depth.
+    NullFragmentShaderFunc  fragmentShader;
+};
+
+// Counters of the rasterizer stages for pipeline statistics and occlusion queries.
+struct NullRasterStatistics
+{
+    std::uint64_t clippingInvocations       = 0;    // Number of triangles that entered the clipping stage.
+    std::uint64_t clippingPrimitives        = 0;    // Number of triangles that were output by the clipping stage.
+    std::uint64_t fragmentShaderInvocations = 0;
+    std::uint64_t samplesPassed             = 0;    // Number of samples that passed the depth and stencil tests.
+};
+
+/*
+Tile-based software rasterizer for triangles.
+Triangles are clipped in homogeneous space, snapped to a fixed-point grid with 4 sub-pixel bits, and binned into screen tiles.
+The tiles are then rasterized concurrently with integer edge functions in quads of 2x2 pixels, which keeps the order of triangles within each pixel.
+*/
+class NullRasterizer
+{
+
+    public:
+
+        /*
+        Rasterizes the specified triangles into the framebuffer. Each triangle is specified by three consecutive indices into the vertex array.
+        The counters of this draw call are added to 'statistics'.
+        */
+        void DrawTriangles(
+            NullFramebuffer&        framebuffer,
+            const NullRasterState&  state,
+            const NullVertex*       vertices,
+            const std::uint32_t*    indices,
+            std::size_t             numTriangles,
+            NullRasterStatistics&   statistics
+        );
+
+    public:
+
+        // Triangle after clipping and setup in screen space.
+        struct Triangle
+        {
+            std::int32_t    minX;           // Bounding box in pixels, clipped to the render area. The maximum is exclusive.
+            std::int32_t    minY;
+            std::int32_t    maxX;
+            std::int32_t    maxY;
+            std::int64_t    edges[3];       // Edge functions at the center of pixel (0, 0), biased by the top-left fill rule.
+            std::int64_t    edgeStepsX[3];  // Edge function increments per pixel in X direction.
+            std::int64_t    edgeStepsY[3];  // Edge function increments per pixel in Y direction.
+            bool            frontFacing;
+            float           originX;        // Screen position of the first vertex, which the plane equations are relative to.
+            float           originY;
+            std::size_t     planeOffset;
+            const float*    planes;         // Plane equations (dx, dy, origin) for depth, 1/w, and each varying component divided by w.
+        };
+
+        struct SetupContext;
+
+        struct SetupChunk
+        {
+            std::vector<Triangle>   triangles;
+            std::vector<float>      planes;
+            std::uint64_t           numClippedTriangles = 0;
+        };
+
+    private:
+
+        void SetupTriangles(const SetupContext& context, SetupChunk& chunk, std::size_t firstTriangle, std::size_t numTriangles);
+        void RasterizeTile(const SetupContext& context, std::uint32_t tileIndex, NullRasterStatistics& statistics);
+
+    private:
+
+        std::vector<SetupChunk>                         chunks_;
+        std::vector<std::vector<const Triangle*>>       bins_;
+        std::vector<std::uint32_t>                      activeTiles_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,381 @@
+/*
+ * NullVertexFetch.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "NullVertexFetch.h"
+#include "../../../Core/CPUFeatures.h"
+#include "../../../Core/CompilerExtensions.h"
+#include "../../../Core/Float16Compressor.h"
+#include <LLGL/Platform/Platform.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <limits>
+#include <string.h>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_NULL_VERTEX_FETCH_X86
+#   include <emmintrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Scalar decoders ----- */
+
+enum class NullDecodeKind
+{
+    Float,      // Floating-point components, i.e. 32-bit and 64-bit floats.
+    Half,       // 16-bit floating-point components.
+    UNorm,
+    SNorm,
+    Integer,    // Non-normalized integer components, which keep their integer values.
+};
+
+template <NullDecodeKind Kind>
+struct NullComponentDecoder;
+
+template <>
+struct NullComponentDecoder<NullDecodeKind::Float>
+{
+    template <typename T>
+    static void Decode(T value, NullVertexValue& outValue)
+    {
+        outValue.f = static_cast<float>(value);
+    }
+};
+
+template <>
+struct NullComponentDecoder<NullDecodeKind::Half>
+{
+    static void Decode(std::uint16_t value, NullVertexValue& outValue)
+    {
+        outValue.f = DecompressFloat16(value);
+    }
+};
+
+template <>
+struct NullComponentDecoder<NullDecodeKind::UNorm>
+{
+    template <typename T>
+    static void Decode(T value, NullVertexValue& outValue)
+    {
+        outValue.f = static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max());
+    }
+};
+
+template <>
+struct NullComponentDecoder<NullDecodeKind::SNorm>
+{
+    template <typename T>
+    static void Decode(T value, NullVertexValue& outValue)
+    {
+        outValue.f = std::max(-1.0f, static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max()));
+    }
+};
+
+template <>
+struct NullComponentDecoder<NullDecodeKind::Integer>
+{
+    template <typename T>
+    static void Decode(T value, NullVertexValue& outValue)
+    {
+        /* Sign-extend signed integers and zero-extend unsigned integers */
+        outValue.u = static_cast<std::uint32_t>(static_cast<std::int64_t>(value));
+    }
+};
+
+static void FillDefaultComponents(NullVertexValue outValue[4], std::uint32_t first, bool isInteger)
+{
+    for_subrange(i, first, 3u)
+        outValue[i].u = 0;
+    if (first < 4)
+    {
+        if (isInteger)
+            outValue[3].u = 1;
+        else
+            outValue[3].f = 1.0f;
+    }
+}
+
+template <typename T, std::uint32_t N, NullDecodeKind Kind, bool SwizzleBGRA>
+static void DecodeVertexAttrib(const char* data, NullVertexValue outValue[4])
+{
+    T components[N];
+    ::memcpy(components, data, sizeof(components));
+
+    for_range(i, N)
+        NullComponentDecoder<Kind>::Decode(components[i], outValue[i]);
+
+    FillDefaultComponents(outValue, N, (Kind == NullDecodeKind::Integer));
+
+    if (SwizzleBGRA)
+        std::swap(outValue[0], outValue[2]);
+}
+
+
+/* ----- SIMD decoders ----- */
+
+#if defined LLGL_NULL_VERTEX_FETCH_X86
+
+// Loads four 8-bit components and extends them to 32-bit integers, either with zero or sign extension.
+template <bool Signed>
+LLGL_TARGET_ATTRIBUTE("sse2")
+static __m128i LoadComponents8x4(const char* data)
+{
+    std::int32_t bits;
+    ::memcpy(&bits, data, sizeof(bits));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_cvtsi32_si128(bits);
+    if (Signed)
+        return _mm_srai_epi32(_mm_unpacklo_epi16(zero, _mm_unpacklo_epi8(zero, bytes)), 24);
+    else
+        return _mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero);
+}
+
+// Loads four 16-bit components and extends them to 32-bit integers, either with zero or sign extension.
+template <bool Signed>
+LLGL_TARGET_ATTRIBUTE("sse2")
+static __m128i LoadComponents16x4(const char* data)
+{
+    std::int64_t bits;
+    ::memcpy(&bits, data, sizeof(bits));
+    const __m128i words = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&bits));
+    if (Signed)
+        return _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), words), 16);
+    else
+        return _mm_unpacklo_epi16(words, _mm_setzero_si128());
+}
+
+template <bool Signed, bool SwizzleBGRA>
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void DecodeVertexAttribNorm8x4SSE2(const char* data, NullVertexValue outValue[4])
+{
+    __m128 values = _mm_mul_ps(_mm_cvtepi32_ps(LoadComponents8x4<Signed>(data)), _mm_set1_ps(1.0f / (Signed ? 127.0f : 255.0f)));
+    if (Signed)
+        values = _mm_max_ps(values, _mm_set1_ps(-1.0f));
+    if (SwizzleBGRA)
+        values = _mm_shuffle_ps(values, values, _MM_SHUFFLE(3, 0, 1, 2));
+    _mm_storeu_ps(&(outValue[0].f), values);
+}
+
+template <bool Signed>
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void DecodeVertexAttribNorm16x4SSE2(const char* data, NullVertexValue outValue[4])
+{
+    __m128 values = _mm_mul_ps(_mm_cvtepi32_ps(LoadComponents16x4<Signed>(data)), _mm_set1_ps(1.0f / (Signed ? 32767.0f : 65535.0f)));
+    if (Signed)
+        values = _mm_max_ps(values, _mm_set1_ps(-1.0f));
+    _mm_storeu_ps(&(outValue[0].f), values);
+}
+
+template <bool Signed, bool SwizzleBGRA>
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void DecodeVertexAttribInt8x4SSE2(const char* data, NullVertexValue outValue[4])
+{
+    __m128i values = LoadComponents8x4<Signed>(data);
+    if (SwizzleBGRA)
+        values = _mm_shuffle_epi32(values, _MM_SHUFFLE(3, 0, 1, 2));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outValue), values);
+}
+
+template <bool Signed>
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void DecodeVertexAttribInt16x4SSE2(const char* data, NullVertexValue outValue[4])
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(outValue), LoadComponents16x4<Signed>(data));
+}
+
+// Returns the SSE2 decoder for 4-component vertex formats with 8-bit or 16-bit integer components, or null if there is none.
+static PFN_NullDecodeVertexAttrib FindVertexAttribDecoderSSE2(const Format format)
+{
+    switch (format)
+    {
+        case Format::RGBA8UNorm:    return DecodeVertexAttribNorm8x4SSE2<false, false>;
+        case Format::RGBA8SNorm:    return DecodeVertexAttribNorm8x4SSE2<true, false>;
+        case Format::RGBA8UInt:     return DecodeVertexAttribInt8x4SSE2<false, false>;
+        case Format::RGBA8SInt:     return DecodeVertexAttribInt8x4SSE2<true, false>;
+        case Format::BGRA8UNorm:    return DecodeVertexAttribNorm8x4SSE2<false, true>;
+        case Format::BGRA8SNorm:    return DecodeVertexAttribNorm8x4SSE2<true, true>;
+        case Format::BGRA8UInt:     return DecodeVertexAttribInt8x4SSE2<false, true>;
+        case Format::BGRA8SInt:     return DecodeVertexAttribInt8x4SSE2<true, true>;
+        case Format::RGBA16UNorm:   return DecodeVertexAttribNorm16x4SSE2<false>;
+        case Format::RGBA16SNorm:   return DecodeVertexAttribNorm16x4SSE2<true>;
+        case Format::RGBA16UInt:    return DecodeVertexAttribInt16x4SSE2<false>;
+        case Format::RGBA16SInt:    return DecodeVertexAttribInt16x4SSE2<true>;
+        default:                    return nullptr;
+    }
+}
+
+#endif // /LLGL_NULL_VERTEX_FETCH_X86
+
+#define LLGL_NULL_DECODER(TYPE, COMPONENTS, KIND) \
+    DecodeVertexAttrib<TYPE, COMPONENTS, NullDecodeKind::KIND, false>
+
+#define LLGL_NULL_DECODER_BGRA(TYPE, KIND) \
+    DecodeVertexAttrib<TYPE, 4, NullDecodeKind::KIND, true>
+
+static PFN_NullDecodeVertexAttrib FindVertexAttribDecoderScalar(const Format format)
+{
+    switch (format)
+    {
+        case Format::R8UNorm:       return LLGL_NULL_DECODER(std::uint8_t,  1, UNorm);
+        case Format::R8SNorm:       return LLGL_NULL_DECODER(std::int8_t,   1, SNorm);
+        case Format::R8UInt:        return LLGL_NULL_DECODER(std::uint8_t,  1, Integer);
+        case Format::R8SInt:        return LLGL_NULL_DECODER(std::int8_t,   1, Integer);
+        case Format::R16UNorm:      return LLGL_NULL_DECODER(std::uint16_t, 1, UNorm);
+        case Format::R16SNorm:      return LLGL_NULL_DECODER(std::int16_t,  1, SNorm);
+        case Format::R16UInt:       return LLGL_NULL_DECODER(std::uint16_t, 1, Integer);
+        case Format::R16SInt:       return LLGL_NULL_DECODER(std::int16_t,  1, Integer);
+        case Format::R16Float:      return LLGL_NULL_DECODER(std::uint16_t, 1, Half);
+        case Format::R32UInt:       return LLGL_NULL_DECODER(std::uint32_t, 1, Integer);
+        case Format::R32SInt:       return LLGL_NULL_DECODER(std::int32_t,  1, Integer);
+        case Format::R32Float:      return LLGL_NULL_DECODER(float,         1, Float);
+        case Format::R64Float:      return LLGL_NULL_DECODER(double,        1, Float);
+
+        case Format::RG8UNorm:      return LLGL_NULL_DECODER(std::uint8_t,  2, UNorm);
+        case Format::RG8SNorm:      return LLGL_NULL_DECODER(std::int8_t,   2, SNorm);
+        case Format::RG8UInt:       return LLGL_NULL_DECODER(std::uint8_t,  2, Integer);
+        case Format::RG8SInt:       return LLGL_NULL_DECODER(std::int8_t,   2, Integer);
+        case Format::RG16UNorm:     return LLGL_NULL_DECODER(std::uint16_t, 2, UNorm);
+        case Format::RG16SNorm:     return LLGL_NULL_DECODER(std::int16_t,  2, SNorm);
+        case Format::RG16UInt:      return LLGL_NULL_DECODER(std::uint16_t, 2, Integer);
+        case Format::RG16SInt:      return LLGL_NULL_DECODER(std::int16_t,  2, Integer);
+        case Format::RG16Float:     return LLGL_NULL_DECODER(std::uint16_t, 2, Half);
+        case Format::RG32UInt:      return LLGL_NULL_DECODER(std::uint32_t, 2, Integer);
+        case Format::RG32SInt:      return LLGL_NULL_DECODER(std::int32_t,  2, Integer);
+        case Format::RG32Float:     return LLGL_NULL_DECODER(float,         2, Float);
+        case Format::RG64Float:     return LLGL_NULL_DECODER(double,        2, Float);
+
+        case Format::RGB8UNorm:     return LLGL_NULL_DECODER(std::uint8_t,  3, UNorm);
+        case Format::RGB8SNorm:     return LLGL_NULL_DECODER(std::int8_t,   3, SNorm);
+        case Format::RGB8UInt:      return LLGL_NULL_DECODER(std::uint8_t,  3, Integer);
+        case Format::RGB8SInt:      return LLGL_NULL_DECODER(std::int8_t,   3, Integer);
+        case Format::RGB16UNorm:    return LLGL_NULL_DECODER(std::uint16_t, 3, UNorm);
+        case Format::RGB16SNorm:    return LLGL_NULL_DECODER(std::int16_t,  3, SNorm);
+        case Format::RGB16UInt:     return LLGL_NULL_DECODER(std::uint16_t, 3, Integer);
+        case Format::RGB16SInt:     return LLGL_NULL_DECODER(std::int16_t,  3, Integer);
+        case Format::RGB16Float:    return LLGL_NULL_DECODER(std::uint16_t, 3, Half);
+        case Format::RGB32UInt:     return LLGL_NULL_DECODER(std::uint32_t, 3, Integer);
+        case Format::RGB32SInt:     return LLGL_NULL_DECODER(std::int32_t,  3, Integer);
+        case Format::RGB32Float:    return LLGL_NULL_DECODER(float,         3, Float);
+        case Format::RGB64Float:    return LLGL_NULL_DECODER(double,        3, Float);
+
+        case Format::RGBA8UNorm:    return LLGL_NULL_DECODER(std::uint8_t,  4, UNorm);
+        case Format::RGBA8SNorm:    return LLGL_NULL_DECODER(std::int8_t,   4, SNorm);
+        case Format::RGBA8UInt:     return LLGL_NULL_DECODER(std::uint8_t,  4, Integer);
+        case Format::RGBA8SInt:     return LLGL_NULL_DECODER(std::int8_t,   4, Integer);
+        case Format::RGBA16UNorm:   return LLGL_NULL_DECODER(std::uint16_t, 4, UNorm);
+        case Format::RGBA16SNorm:   return LLGL_NULL_DECODER(std::int16_t,  4, SNorm);
+        case Format::RGBA16UInt:    return LLGL_NULL_DECODER(std::uint16_t, 4, Integer);
+        case Format::RGBA16SInt:    return LLGL_NULL_DECODER(std::int16_t,  4, Integer);
+        case Format::RGBA16Float:   return LLGL_NULL_DECODER(std::uint16_t, 4, Half);
+        case Format::RGBA32UInt:    return LLGL_NULL_DECODER(std::uint32_t, 4, Integer);
+        case Format::RGBA32SInt:    return LLGL_NULL_DECODER(std::int32_t,  4, Integer);
+        case Format::RGBA32Float:   return LLGL_NULL_DECODER(float,         4, Float);
+        case Format::RGBA64Float:   return LLGL_NULL_DECODER(double,        4, Float);
+
+        case Format::BGRA8UNorm:    return LLGL_NULL_DECODER_BGRA(std::uint8_t, UNorm);
+        case Format::BGRA8SNorm:    return LLGL_NULL_DECODER_BGRA(std::int8_t,  SNorm);
+        case Format::BGRA8UInt:     return LLGL_NULL_DECODER_BGRA(std::uint8_t, Integer);
+        case Format::BGRA8SInt:     return LLGL_NULL_DECODER_BGRA(std::int8_t,  Integer);
+
+        default:                    return nullptr;
+    }
+}
+
+#undef LLGL_NULL_DECODER
+#undef LLGL_NULL_DECODER_BGRA
+
+static PFN_NullDecodeVertexAttrib FindVertexAttribDecoder(const Format format)
+{
+    #if defined LLGL_NULL_VERTEX_FETCH_X86
+    if ((GetCPUFeatures() & CPUFeatureFlags::SSE2) != 0)
+    {
+        if (PFN_NullDecodeVertexAttrib decoder = FindVertexAttribDecoderSSE2(format))
+            return decoder;
+    }
+    #endif
+    return FindVertexAttribDecoderScalar(format);
+}
+
+
+/* ----- Global functions ----- */
+
+bool ResolveVertexAttribSource(
+    const VertexAttribute&  attrib,
+    const void*             data,
+    std::uint64_t           size,
+    std::uint32_t           bindingStride,
+    NullVertexAttribSource& outSource)
+{
+    outSource.data = nullptr;
+
+    if (data == nullptr)
+        return false;
+
+    const FormatAttributes& formatAttribs = GetFormatAttribs(attrib.format);
+    PFN_NullDecodeVertexAttrib decoder = FindVertexAttribDecoder(attrib.format);
+    if (decoder == nullptr)
+        return false;
+
+    const long integerFlags = (formatAttribs.flags & (FormatFlags::IsInteger | FormatFlags::IsNormalized));
+
+    outSource.data              = static_cast<const char*>(data);
+    outSource.size              = size;
+    outSource.offset            = attrib.offset;
+    outSource.stride            = (bindingStride != 0 ? bindingStride : attrib.stride);
+    outSource.instanceDivisor   = attrib.instanceDivisor;
+    outSource.elementSize       = formatAttribs.bitSize / 8;
+    outSource.isInteger         = (integerFlags == FormatFlags::IsInteger);
+    outSource.isSigned          = ((formatAttribs.flags & FormatFlags::IsUnsigned) == 0);
+    outSource.decode            = decoder;
+
+    return true;
+}
+
+void FetchVertexAttrib(const NullVertexAttribSource& source, std::uint32_t vertexID, std::uint32_t instance, NullVertexValue outValue[4])
+{
+    if (source.data != nullptr)
+    {
+        /* Out-of-bounds reads return the default value */
+        const std::uint64_t element = (source.instanceDivisor > 0 ? instance / source.instanceDivisor : vertexID);
+        const std::uint64_t offset  = source.offset + element * source.stride;
+        if (offset + source.elementSize <= source.size)
+        {
+            source.decode(source.data + offset, outValue);
+            return;
+        }
+    }
+    FillDefaultComponents(outValue, 0, source.isInteger);
+}
+
+void ConvertVertexAttribToFloat(const NullVertexAttribSource& source, const NullVertexValue value[4], float outValue[4])
+{
+    if (!source.isInteger)
+    {
+        for_range(i, 4)
+            outValue[i] = value[i].f;
+    }
+    else if (source.isSigned)
+    {
+        for_range(i, 4)
+            outValue[i] = static_cast<float>(value[i].s);
+    }
+    else
+    {
+        for_range(i, 4)
+            outValue[i] = static_cast<float>(value[i].u);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
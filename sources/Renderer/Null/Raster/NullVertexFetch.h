@@ -0,0 +1,77 @@
+/*
+ * NullVertexFetch.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_VERTEX_FETCH_H
+#define LLGL_NULL_VERTEX_FETCH_H
+
+
+#include <LLGL/VertexAttribute.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Decoded component of a vertex attribute. Integer formats keep their integer values, all other formats are converted to float.
+union NullVertexValue
+{
+    float           f;
+    std::int32_t    s;
+    std::uint32_t   u;
+};
+
+static_assert(sizeof(NullVertexValue) == sizeof(float), "NullVertexValue must be 4 bytes, so four values can be stored as SIMD vector");
+
+// Decodes a single element of a vertex attribute into four components. Missing components are filled with (0, 0, 0, 1).
+typedef void (*PFN_NullDecodeVertexAttrib)(const char* data, NullVertexValue outValue[4]);
+
+// Vertex attribute with its resolved source memory and the decoder for its format.
+struct NullVertexAttribSource
+{
+    const char*                 data            = nullptr;
+    std::uint64_t               size            = 0;
+    std::uint32_t               offset          = 0;
+    std::uint32_t               stride          = 0;
+    std::uint32_t               instanceDivisor = 0;
+    std::uint32_t               elementSize     = 0;        // Size (in bytes) of one element of the attribute format.
+    bool                        isInteger       = false;    // Non-normalized integer formats are decoded as integers.
+    bool                        isSigned        = false;
+    PFN_NullDecodeVertexAttrib  decode          = nullptr;
+};
+
+/*
+Resolves the source of the specified vertex attribute within the buffer memory.
+The stride of the buffer binding takes precedence over the stride of the attribute if it is non-zero.
+Returns false and leaves the source unbound if the data is null or the attribute format cannot be used for vertices.
+*/
+bool ResolveVertexAttribSource(
+    const VertexAttribute&  attrib,
+    const void*             data,
+    std::uint64_t           size,
+    std::uint32_t           bindingStride,
+    NullVertexAttribSource& outSource
+);
+
+/*
+Fetches the vertex attribute for the specified vertex ID and instance.
+Instanced attributes advance once every 'instanceDivisor' instances. Unbound attributes and out-of-bounds reads return (0, 0, 0, 1).
+*/
+void FetchVertexAttrib(const NullVertexAttribSource& source, std::uint32_t vertexID, std::uint32_t instance, NullVertexValue outValue[4]);
+
+// Converts the decoded components of the specified source to float.
+void ConvertVertexAttribToFloat(const NullVertexAttribSource& source, const NullVertexValue value[4], float outValue[4]);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,7 @@
  */
 
 #include "NullFence.h"
-#include <thread>
+#include <algorithm>
 #include <chrono>
 
 
@@ -14,6 +14,10 @@ namespace LLGL
 {
 
 
+// Timeouts of more than a century are treated as infinite, since the deadline would overflow the clock.
+static constexpr std::uint64_t g_nullInfiniteTimeout = (1ull << 62);
+
+
 void NullFence::SetDebugName(const char* name)
 {
     if (name != nullptr)
@@ -22,20 +26,50 @@ void NullFence::SetDebugName(const char* name)
         label_.clear();
 }
 
-void NullFence::Signal(std::uint64_t signal)
+NullFence::NullFence(std::uint64_t initialValue) :
+    value_          { initialValue },
+    completedValue_ { initialValue }
+{
+}
+
+std::uint64_t NullFence::NextValue()
 {
-    signal_ = signal;
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    return ++value_;
 }
 
-void NullFence::WaitForSignal(std::uint64_t signal)
+void NullFence::Signal(std::uint64_t value)
 {
-    while (signal_ != signal)
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    {
+        std::lock_guard<std::mutex> guard{ mutex_ };
+        completedValue_ = std::max(completedValue_, value);
+    }
+    completedCond_.notify_all();
+}
+
+bool NullFence::Wait(std::uint64_t timeout)
+{
+    std::unique_lock<std::mutex> lock{ mutex_ };
+    const std::uint64_t value = value_;
+
+    auto IsCompleted = [this, value]() -> bool
+    {
+        return (completedValue_ >= value);
+    };
+
+    if (timeout >= g_nullInfiniteTimeout)
+    {
+        completedCond_.wait(lock, IsCompleted);
+        return true;
+    }
+
+    return completedCond_.wait_for(lock, std::chrono::nanoseconds(static_cast<std::int64_t>(timeout)), IsCompleted);
 }
 
-NullFence::NullFence(std::uint64_t initialSignal) :
-    signal_ { initialSignal }
+std::uint64_t NullFence::GetSignaledValue() const
 {
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    return value_;
 }
 
 
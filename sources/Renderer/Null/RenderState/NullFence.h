@@ -11,7 +11,8 @@
 
 #include <LLGL/Fence.h>
 #include <string>
-#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <cstdint>
 
 
@@ -28,16 +29,27 @@ class NullFence final : public Fence
 
     public:
 
-        NullFence(std::uint64_t initialSignal = 0);
+        NullFence(std::uint64_t initialValue = 0);
 
-        void Signal(std::uint64_t signal);
+        // Increments the value this fence will be signaled with and returns it. Must be called by the submitting thread.
+        std::uint64_t NextValue();
 
-        void WaitForSignal(std::uint64_t signal);
+        // Completes the specified value and wakes up all waiting threads.
+        void Signal(std::uint64_t value);
+
+        // Waits until the last value from NextValue() has been completed. Returns false if the timeout (in nanoseconds) expired.
+        bool Wait(std::uint64_t timeout);
+
+        // Returns the last value this fence will be signaled with.
+        std::uint64_t GetSignaledValue() const;
 
     private:
 
         std::string             label_;
-        std::atomic_uint64_t    signal_;
+        std::uint64_t           value_          = 0; // Guarded by mutex_, since Wait() can be called from other threads than NextValue()
+        std::uint64_t           completedValue_ = 0;
+        mutable std::mutex      mutex_;
+        std::condition_variable completedCond_;
 
 };
 
@@ -17,6 +17,11 @@ NullPipelineLayout::NullPipelineLayout(const PipelineLayoutDescriptor& desc) :
 {
     if (desc.debugName != nullptr)
         SetDebugName(desc.debugName);
+
+    /* Create samplers for static sampler states, so shaders can sample with them like with sampler bindings */
+    staticSamplers_.reserve(desc.staticSamplers.size());
+    for (const StaticSamplerDescriptor& staticSamplerDesc : desc.staticSamplers)
+        staticSamplers_.emplace_back(new NullSampler{ staticSamplerDesc.sampler });
 }
 
 void NullPipelineLayout::SetDebugName(const char* name)
@@ -11,7 +11,10 @@
 
 #include <LLGL/PipelineLayout.h>
 #include <LLGL/PipelineLayoutFlags.h>
+#include "../Texture/NullSampler.h"
 #include <string>
+#include <vector>
+#include <memory>
 
 
 namespace LLGL
@@ -33,13 +36,20 @@ class NullPipelineLayout final : public PipelineLayout
 
         NullPipelineLayout(const PipelineLayoutDescriptor& desc);
 
+        // Returns the sampler of the specified static sampler in PipelineLayoutDescriptor::staticSamplers.
+        inline const NullSampler& GetStaticSampler(std::size_t index) const
+        {
+            return *staticSamplers_[index];
+        }
+
     public:
 
         const PipelineLayoutDescriptor desc;
 
     private:
 
-        std::string label_;
+        std::string                                 label_;
+        std::vector<std::unique_ptr<NullSampler>>   staticSamplers_;
 
 };
 
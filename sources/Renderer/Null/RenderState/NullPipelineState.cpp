@@ -7,6 +7,17 @@
 
 #include "NullPipelineState.h"
 
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+#   include "NullPipelineLayout.h"
+#   include "../Shader/NullShader.h"
+#   include "../../CheckedCast.h"
+#   include "../../PipelineStateUtils.h"
+#   include "../../SPIRV/SpirvReflect.h"
+#   include <LLGL/Utils/ForRange.h>
+#   include <algorithm>
+#   include <string.h>
+#endif
+
 namespace LLGL
 {
 
@@ -15,6 +26,9 @@ NullPipelineState::NullPipelineState(const GraphicsPipelineDescriptor& desc) :
     isGraphicsPSO { true },
     graphicsDesc  { desc }
 {
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    BuildUniformRanges(desc.pipelineLayout, { desc.vertexShader, desc.fragmentShader });
+    #endif
     if (desc.debugName != nullptr)
         SetDebugName(desc.debugName);
 }
@@ -23,6 +37,9 @@ NullPipelineState::NullPipelineState(const ComputePipelineDescriptor& desc) :
     isGraphicsPSO { false },
     computeDesc   { desc  }
 {
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    BuildUniformRanges(desc.pipelineLayout, { desc.computeShader });
+    #endif
     if (desc.debugName != nullptr)
         SetDebugName(desc.debugName);
 }
@@ -41,6 +58,60 @@ const Report* NullPipelineState::GetReport() const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+void NullPipelineState::BuildUniformRanges(const PipelineLayout* pipelineLayout, std::initializer_list<const Shader*> shaders)
+{
+    if (pipelineLayout == nullptr)
+        return;
+
+    const std::vector<UniformDescriptor>& uniformDescs = LLGL_CAST(const NullPipelineLayout*, pipelineLayout)->desc.uniforms;
+    if (uniformDescs.empty())
+        return;
+
+    uniformRanges_.resize(uniformDescs.size());
+
+    /* Find uniforms by name in the push constant block of each shader; all stages share the same block */
+    for (const Shader* shader : shaders)
+    {
+        if (shader == nullptr)
+            continue;
+
+        const NullShader* shaderNull = LLGL_CAST(const NullShader*, shader);
+        if (shaderNull->GetShaderCode().empty())
+            continue;
+
+        SpirvReflect::SpvBlock block;
+        if (SpirvReflectPushConstants(SpirvModuleView{ shaderNull->GetShaderCode() }, block) != SpirvResult::NoError)
+            continue;
+
+        for_range(i, uniformDescs.size())
+        {
+            const UniformDescriptor& uniformDesc = uniformDescs[i];
+            for (const SpirvReflect::SpvBlockField& field : block.fields)
+            {
+                if (field.name != nullptr && ::strcmp(field.name, uniformDesc.name.c_str()) == 0)
+                {
+                    NullUniformRange& range = uniformRanges_[i];
+                    {
+                        range.offset    = field.offset;
+                        range.size      = GetUniformTypeSize(uniformDesc.type, uniformDesc.arraySize);
+                    }
+                    uniformDataSize_ = std::max(uniformDataSize_, range.offset + range.size);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+
 } // /namespace LLGL
 
 
@@ -13,11 +13,26 @@
 #include <LLGL/PipelineStateFlags.h>
 #include <string>
 
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+#   include <vector>
+#endif
+
 
 namespace LLGL
 {
 
 
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+// Byte range of a uniform within the push constant block of the shaders.
+struct NullUniformRange
+{
+    std::uint32_t offset    = 0;
+    std::uint32_t size      = 0;
+};
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
 class NullPipelineState final : public PipelineState
 {
 
@@ -31,6 +46,22 @@ class NullPipelineState final : public PipelineState
         NullPipelineState(const GraphicsPipelineDescriptor& desc);
         NullPipelineState(const ComputePipelineDescriptor& desc);
 
+        #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+        // Returns the push constant range for each uniform of the pipeline layout.
+        inline const std::vector<NullUniformRange>& GetUniformRanges() const
+        {
+            return uniformRanges_;
+        }
+
+        // Returns the size of the push constant block in bytes.
+        inline std::uint32_t GetUniformDataSize() const
+        {
+            return uniformDataSize_;
+        }
+
+        #endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
     public:
 
         const bool                          isGraphicsPSO;
@@ -39,7 +70,19 @@ class NullPipelineState final : public PipelineState
 
     private:
 
-        std::string label_;
+        #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+        void BuildUniformRanges(const PipelineLayout* pipelineLayout, std::initializer_list<const Shader*> shaders);
+        #endif
+
+    private:
+
+        std::string                     label_;
+
+        #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+        std::vector<NullUniformRange>   uniformRanges_;
+        std::uint32_t                   uniformDataSize_    = 0;
+        #endif
+
 };
 
 
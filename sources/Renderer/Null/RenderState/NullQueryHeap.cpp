@@ -6,6 +6,7 @@
  */
 
 #include "NullQueryHeap.h"
+#include <LLGL/Timer.h>
 
 
 namespace LLGL
@@ -13,8 +14,9 @@ namespace LLGL
 
 
 NullQueryHeap::NullQueryHeap(const QueryHeapDescriptor& desc) :
-    QueryHeap { desc.type },
-    desc      { desc      }
+    QueryHeap { desc.type                },
+    desc      { desc                     },
+    queries_  ( desc.numQueries          )
 {
     if (desc.debugName != nullptr)
         SetDebugName(desc.debugName);
@@ -28,6 +30,81 @@ void NullQueryHeap::SetDebugName(const char* name)
         label_.clear();
 }
 
+void NullQueryHeap::Begin(std::uint32_t query, const NullQueryCounters& counters)
+{
+    if (query < queries_.size())
+    {
+        Query& entry = queries_[query];
+        entry.available = false;
+        entry.counters  = counters;
+        if (desc.type == QueryType::TimeElapsed)
+            entry.beginTick = Timer::Tick();
+    }
+}
+
+void NullQueryHeap::End(std::uint32_t query, const NullQueryCounters& counters)
+{
+    if (query < queries_.size())
+    {
+        Query& entry = queries_[query];
+        if (desc.type == QueryType::TimeElapsed)
+        {
+            /* Convert elapsed ticks to nanoseconds */
+            const std::uint64_t elapsedTicks = Timer::Tick() - entry.beginTick;
+            entry.counters.samplesPassed = static_cast<std::uint64_t>(static_cast<double>(elapsedTicks) * 1.0e9 / static_cast<double>(Timer::Frequency()));
+        }
+        else
+        {
+            entry.counters.samplesPassed = counters.samplesPassed - entry.counters.samplesPassed;
+
+            QueryPipelineStatistics& result = entry.counters.statistics;
+            const QueryPipelineStatistics& statistics = counters.statistics;
+            result.inputAssemblyVertices            = statistics.inputAssemblyVertices              - result.inputAssemblyVertices;
+            result.inputAssemblyPrimitives          = statistics.inputAssemblyPrimitives            - result.inputAssemblyPrimitives;
+            result.vertexShaderInvocations          = statistics.vertexShaderInvocations            - result.vertexShaderInvocations;
+            result.geometryShaderInvocations        = statistics.geometryShaderInvocations          - result.geometryShaderInvocations;
+            result.geometryShaderPrimitives         = statistics.geometryShaderPrimitives           - result.geometryShaderPrimitives;
+            result.clippingInvocations              = statistics.clippingInvocations                - result.clippingInvocations;
+            result.clippingPrimitives               = statistics.clippingPrimitives                 - result.clippingPrimitives;
+            result.fragmentShaderInvocations        = statistics.fragmentShaderInvocations          - result.fragmentShaderInvocations;
+            result.tessControlShaderInvocations     = statistics.tessControlShaderInvocations       - result.tessControlShaderInvocations;
+            result.tessEvaluationShaderInvocations  = statistics.tessEvaluationShaderInvocations    - result.tessEvaluationShaderInvocations;
+            result.computeShaderInvocations         = statistics.computeShaderInvocations           - result.computeShaderInvocations;
+        }
+        entry.available = true;
+    }
+}
+
+bool NullQueryHeap::GetResult(std::uint32_t query, std::uint64_t& outResult) const
+{
+    if (query < queries_.size() && queries_[query].available)
+    {
+        const std::uint64_t value = queries_[query].counters.samplesPassed;
+        switch (desc.type)
+        {
+            case QueryType::AnySamplesPassed:
+            case QueryType::AnySamplesPassedConservative:
+                outResult = (value != 0 ? 1 : 0);
+                break;
+            default:
+                outResult = value;
+                break;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool NullQueryHeap::GetResult(std::uint32_t query, QueryPipelineStatistics& outResult) const
+{
+    if (query < queries_.size() && queries_[query].available)
+    {
+        outResult = queries_[query].counters.statistics;
+        return true;
+    }
+    return false;
+}
+
 
 } // /namespace LLGL
 
@@ -12,12 +12,20 @@
 #include <LLGL/QueryHeap.h>
 #include <vector>
 #include <string>
+#include <atomic>
 
 
 namespace LLGL
 {
 
 
+// Running counters of the Null command executor. Queries store the difference of these counters between their begin and end.
+struct NullQueryCounters
+{
+    std::uint64_t           samplesPassed   = 0;
+    QueryPipelineStatistics statistics;
+};
+
 class NullQueryHeap final : public QueryHeap
 {
 
@@ -29,13 +37,35 @@ class NullQueryHeap final : public QueryHeap
 
         NullQueryHeap(const QueryHeapDescriptor& desc);
 
+        // Begins the specified query and invalidates its previous result.
+        void Begin(std::uint32_t query, const NullQueryCounters& counters);
+
+        // Ends the specified query and makes its result available.
+        void End(std::uint32_t query, const NullQueryCounters& counters);
+
+        // Returns the result of the specified query. Timer queries are in nanoseconds. Returns false if the result is not available.
+        bool GetResult(std::uint32_t query, std::uint64_t& outResult) const;
+
+        // Returns the pipeline statistics of the specified query. Returns false if the result is not available.
+        bool GetResult(std::uint32_t query, QueryPipelineStatistics& outResult) const;
+
     public:
 
         const QueryHeapDescriptor desc;
 
     private:
 
-        std::string label_;
+        struct Query
+        {
+            std::atomic<bool>   available   { false };  // Written by the thread that executes the command buffers.
+            std::uint64_t       beginTick   = 0;
+            NullQueryCounters   counters;           // Counters at the beginning of the query, or the results once the query has ended.
+        };
+
+    private:
+
+        std::string         label_;
+        std::vector<Query>  queries_;
 
 };
 
@@ -0,0 +1,43 @@
+/*
+ * NullResourceBindings.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_RESOURCE_BINDINGS_H
+#define LLGL_NULL_RESOURCE_BINDINGS_H
+
+
+#include <LLGL/PipelineLayoutFlags.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class Resource;
+class NullPipelineLayout;
+class NullResourceHeap;
+
+// Resources that are bound to the command context for shader execution.
+struct NullResourceBindings
+{
+    const NullPipelineLayout*       pipelineLayout  = nullptr;
+    const NullResourceHeap*         resourceHeap    = nullptr;
+    std::uint32_t                   descriptorSet   = 0;
+    std::vector<Resource*>          resources;                  // Individual resources for each entry in PipelineLayoutDescriptor::bindings.
+    std::vector<char>               uniforms;                   // Push constant data.
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -48,7 +48,7 @@ std::uint32_t NullResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor
 {
     /* Copy input resource views into resource heap via STL copy algorithm, since the descriptors are non-POD structs */
     std::uint32_t numWritten = 0;
-    if (resourceViews.size() + firstDescriptor < resourceViews_.size())
+    if (resourceViews.size() + firstDescriptor <= resourceViews_.size())
     {
         for_range(i, resourceViews.size())
         {
@@ -63,6 +63,14 @@ std::uint32_t NullResourceHeap::WriteResourceViews(std::uint32_t firstDescriptor
     return numWritten;
 }
 
+const ResourceViewDescriptor* NullResourceHeap::GetResourceView(std::uint32_t descriptorSet, std::uint32_t descriptor) const
+{
+    const std::size_t index = static_cast<std::size_t>(descriptorSet) * numBindings_ + descriptor;
+    if (descriptor < numBindings_ && index < resourceViews_.size())
+        return &(resourceViews_[index]);
+    return nullptr;
+}
+
 void NullResourceHeap::SetDebugName(const char* name)
 {
     if (name != nullptr)
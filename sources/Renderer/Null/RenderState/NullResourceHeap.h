@@ -35,6 +35,9 @@ class NullResourceHeap final : public ResourceHeap
 
         std::uint32_t WriteResourceViews(std::uint32_t firstDescriptor, const ArrayView<ResourceViewDescriptor>& resourceViews);
 
+        // Returns the resource view of the specified descriptor within a descriptor set or null if it is out of bounds.
+        const ResourceViewDescriptor* GetResourceView(std::uint32_t descriptorSet, std::uint32_t descriptor) const;
+
     private:
 
         std::string                         label_;
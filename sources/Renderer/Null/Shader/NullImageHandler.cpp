@@ -0,0 +1,866 @@
+/*
+ * NullImageHandler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+#include "NullImageHandler.h"
+#include "../Texture/NullTexture.h"
+#include "../Texture/NullSampler.h"
+#include "../../../Core/Float16Compressor.h"
+#include <LLGL/SamplerFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/* ----- Texel encoding ----- */
+
+// Returns the source component index for each RGBA component of the specified image format, or -1 for missing components.
+static const std::int8_t* GetComponentMapping(ImageFormat format)
+{
+    static const std::int8_t mappingR       [4] = {  0, -1, -1, -1 };
+    static const std::int8_t mappingRG      [4] = {  0,  1, -1, -1 };
+    static const std::int8_t mappingRGB     [4] = {  0,  1,  2, -1 };
+    static const std::int8_t mappingBGR     [4] = {  2,  1,  0, -1 };
+    static const std::int8_t mappingRGBA    [4] = {  0,  1,  2,  3 };
+    static const std::int8_t mappingBGRA    [4] = {  2,  1,  0,  3 };
+    static const std::int8_t mappingARGB    [4] = {  1,  2,  3,  0 };
+    static const std::int8_t mappingABGR    [4] = {  3,  2,  1,  0 };
+    static const std::int8_t mappingAlpha   [4] = { -1, -1, -1,  0 };
+
+    switch (format)
+    {
+        case ImageFormat::Alpha:    return mappingAlpha;
+        case ImageFormat::R:        return mappingR;
+        case ImageFormat::RG:       return mappingRG;
+        case ImageFormat::RGB:      return mappingRGB;
+        case ImageFormat::BGR:      return mappingBGR;
+        case ImageFormat::RGBA:     return mappingRGBA;
+        case ImageFormat::BGRA:     return mappingBGRA;
+        case ImageFormat::ARGB:     return mappingARGB;
+        case ImageFormat::ABGR:     return mappingABGR;
+        case ImageFormat::Depth:    return mappingR;
+        case ImageFormat::Stencil:  return mappingR;
+        default:                    return nullptr;
+    }
+}
+
+// Decodes a single component. Integer components are normalized for float texels since 32-bit integer formats are never normalized.
+static SpirvValue DecodeComponent(const char* data, DataType dataType, SpirvScalarKind kind)
+{
+    SpirvValue value;
+    const bool isFloat = (kind == SpirvScalarKind::Float);
+
+    switch (dataType)
+    {
+        case DataType::Int8:
+        {
+            const std::int8_t s = *reinterpret_cast<const std::int8_t*>(data);
+            if (isFloat)
+                value.f = std::max(-1.0f, static_cast<float>(s) / 127.0f);
+            else
+                value.s = s;
+        }
+        break;
+
+        case DataType::UInt8:
+        {
+            const std::uint8_t u = *reinterpret_cast<const std::uint8_t*>(data);
+            if (isFloat)
+                value.f = static_cast<float>(u) / 255.0f;
+            else
+                value.u = u;
+        }
+        break;
+
+        case DataType::Int16:
+        {
+            std::int16_t s;
+            ::memcpy(&s, data, sizeof(s));
+            if (isFloat)
+                value.f = std::max(-1.0f, static_cast<float>(s) / 32767.0f);
+            else
+                value.s = s;
+        }
+        break;
+
+        case DataType::UInt16:
+        {
+            std::uint16_t u;
+            ::memcpy(&u, data, sizeof(u));
+            if (isFloat)
+                value.f = static_cast<float>(u) / 65535.0f;
+            else
+                value.u = u;
+        }
+        break;
+
+        case DataType::Int32:
+        {
+            ::memcpy(&value.s, data, sizeof(value.s));
+            if (isFloat)
+                value.f = static_cast<float>(value.s);
+        }
+        break;
+
+        case DataType::UInt32:
+        {
+            ::memcpy(&value.u, data, sizeof(value.u));
+            if (isFloat)
+                value.f = static_cast<float>(value.u);
+        }
+        break;
+
+        case DataType::Float16:
+        {
+            std::uint16_t bits;
+            ::memcpy(&bits, data, sizeof(bits));
+            value.f = DecompressFloat16(bits);
+        }
+        break;
+
+        case DataType::Float32:
+        {
+            ::memcpy(&value.f, data, sizeof(value.f));
+        }
+        break;
+
+        case DataType::Float64:
+        {
+            double d;
+            ::memcpy(&d, data, sizeof(d));
+            value.f = static_cast<float>(d);
+        }
+        break;
+
+        default:
+        {
+            value.u = 0;
+        }
+        break;
+    }
+
+    /* Convert floating-point formats to integer texels */
+    if (!isFloat && (dataType == DataType::Float16 || dataType == DataType::Float32 || dataType == DataType::Float64))
+    {
+        if (kind == SpirvScalarKind::SInt)
+            value.s = static_cast<std::int32_t>(value.f);
+        else
+            value.u = static_cast<std::uint32_t>(std::max(0.0f, value.f));
+    }
+
+    return value;
+}
+
+static void EncodeComponent(char* data, DataType dataType, SpirvScalarKind kind, SpirvValue value)
+{
+    const bool isFloat = (kind == SpirvScalarKind::Float);
+
+    auto Normalize = [value](float scale, float minValue) -> float
+    {
+        return std::round(std::max(minValue, std::min(value.f, 1.0f)) * scale);
+    };
+
+    switch (dataType)
+    {
+        case DataType::Int8:
+        {
+            const std::int8_t s = (isFloat ? static_cast<std::int8_t>(Normalize(127.0f, -1.0f)) : static_cast<std::int8_t>(value.s));
+            ::memcpy(data, &s, sizeof(s));
+        }
+        break;
+
+        case DataType::UInt8:
+        {
+            const std::uint8_t u = (isFloat ? static_cast<std::uint8_t>(Normalize(255.0f, 0.0f)) : static_cast<std::uint8_t>(value.u));
+            ::memcpy(data, &u, sizeof(u));
+        }
+        break;
+
+        case DataType::Int16:
+        {
+            const std::int16_t s = (isFloat ? static_cast<std::int16_t>(Normalize(32767.0f, -1.0f)) : static_cast<std::int16_t>(value.s));
+            ::memcpy(data, &s, sizeof(s));
+        }
+        break;
+
+        case DataType::UInt16:
+        {
+            const std::uint16_t u = (isFloat ? static_cast<std::uint16_t>(Normalize(65535.0f, 0.0f)) : static_cast<std::uint16_t>(value.u));
+            ::memcpy(data, &u, sizeof(u));
+        }
+        break;
+
+        case DataType::Int32:
+        {
+            const std::int32_t s = (isFloat ? static_cast<std::int32_t>(value.f) : value.s);
+            ::memcpy(data, &s, sizeof(s));
+        }
+        break;
+
+        case DataType::UInt32:
+        {
+            const std::uint32_t u = (isFloat ? static_cast<std::uint32_t>(std::max(0.0f, value.f)) : value.u);
+            ::memcpy(data, &u, sizeof(u));
+        }
+        break;
+
+        case DataType::Float16:
+        {
+            const std::uint16_t bits = CompressFloat16(isFloat ? value.f : static_cast<float>(value.s));
+            ::memcpy(data, &bits, sizeof(bits));
+        }
+        break;
+
+        case DataType::Float32:
+        {
+            const float f = (isFloat ? value.f : static_cast<float>(value.s));
+            ::memcpy(data, &f, sizeof(f));
+        }
+        break;
+
+        case DataType::Float64:
+        {
+            const double d = (isFloat ? value.f : static_cast<double>(value.s));
+            ::memcpy(data, &d, sizeof(d));
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+static void SetDefaultTexel(SpirvScalarKind kind, SpirvValue outTexel[4])
+{
+    for_range(i, 4u)
+    {
+        if (kind == SpirvScalarKind::Float)
+            outTexel[i].f = (i == 3 ? 1.0f : 0.0f);
+        else
+            outTexel[i].u = (i == 3 ? 1u : 0u);
+    }
+}
+
+static void SetZeroTexel(SpirvValue outTexel[4])
+{
+    for_range(i, 4u)
+        outTexel[i].u = 0;
+}
+
+static bool IsTexelInside(const Image& image, const std::int32_t (&pos)[3])
+{
+    const Extent3D& extent = image.GetExtent();
+    return
+    (
+        pos[0] >= 0 && static_cast<std::uint32_t>(pos[0]) < extent.width   &&
+        pos[1] >= 0 && static_cast<std::uint32_t>(pos[1]) < extent.height  &&
+        pos[2] >= 0 && static_cast<std::uint32_t>(pos[2]) < extent.depth
+    );
+}
+
+static std::size_t GetTexelOffset(const Image& image, const std::int32_t (&pos)[3])
+{
+    const Extent3D& extent = image.GetExtent();
+    const std::size_t index = (static_cast<std::size_t>(pos[2]) * extent.height + static_cast<std::size_t>(pos[1])) * extent.width + static_cast<std::size_t>(pos[0]);
+    return index * image.GetBytesPerPixel();
+}
+
+// Reads the texel at the specified position, which must be inside the image, in the format of the texture view.
+static void ReadTexel(const NullTextureView& view, const Image& image, const std::int32_t (&pos)[3], SpirvScalarKind kind, SpirvValue outTexel[4])
+{
+    SetDefaultTexel(kind, outTexel);
+
+    const Offset3D offset{ pos[0], pos[1], pos[2] };
+    const ImageFormat format = view.format;
+
+    if (format == ImageFormat::DepthStencil)
+    {
+        /* Depth-stencil formats are packed, so let the image converter extract the depth component */
+        float depth = 0.0f;
+        image.ReadPixels(offset, Extent3D{ 1, 1, 1 }, MutableImageView{ ImageFormat::Depth, DataType::Float32, &depth, sizeof(depth) });
+        outTexel[0].f = depth;
+        return;
+    }
+
+    const std::int8_t* mapping = GetComponentMapping(format);
+    if (mapping == nullptr)
+        return;
+
+    const std::uint32_t componentSize = DataTypeSize(view.dataType);
+    const char* data = static_cast<const char*>(image.GetData()) + GetTexelOffset(image, pos);
+
+    for_range(i, 4u)
+    {
+        if (mapping[i] >= 0)
+            outTexel[i] = DecodeComponent(data + mapping[i] * componentSize, view.dataType, kind);
+    }
+}
+
+// Writes the texel at the specified position, which must be inside the image, in the format of the texture view.
+static void WriteTexel(const NullTextureView& view, Image& image, const std::int32_t (&pos)[3], SpirvScalarKind kind, const SpirvValue texel[4])
+{
+    const std::int8_t* mapping = GetComponentMapping(view.format);
+    if (mapping == nullptr)
+        return;
+
+    const std::uint32_t componentSize = DataTypeSize(view.dataType);
+    char* data = static_cast<char*>(image.GetData()) + GetTexelOffset(image, pos);
+
+    for_range(i, 4u)
+    {
+        if (mapping[i] >= 0)
+            EncodeComponent(data + mapping[i] * componentSize, view.dataType, kind, texel[i]);
+    }
+}
+
+// Replaces the components of the texel as specified by the swizzle of the texture view.
+static void SwizzleTexel(const TextureSwizzleRGBA& swizzle, SpirvScalarKind kind, SpirvValue texel[4])
+{
+    if (IsTextureSwizzleIdentity(swizzle))
+        return;
+
+    const SpirvValue        src[4]          = { texel[0], texel[1], texel[2], texel[3] };
+    const TextureSwizzle    components[4]   = { swizzle.r, swizzle.g, swizzle.b, swizzle.a };
+
+    for_range(i, 4u)
+    {
+        switch (components[i])
+        {
+            case TextureSwizzle::Zero:
+                texel[i].u = 0;
+                break;
+            case TextureSwizzle::One:
+                if (kind == SpirvScalarKind::Float)
+                    texel[i].f = 1.0f;
+                else
+                    texel[i].u = 1u;
+                break;
+            case TextureSwizzle::Red:   texel[i] = src[0]; break;
+            case TextureSwizzle::Green: texel[i] = src[1]; break;
+            case TextureSwizzle::Blue:  texel[i] = src[2]; break;
+            case TextureSwizzle::Alpha: texel[i] = src[3]; break;
+        }
+    }
+}
+
+// Maps the array layer of the texture view into the array layers of its texture. Returns false if the layer is outside of the view.
+static bool MapArrayLayer(const NullTextureView& view, std::int32_t& layer)
+{
+    if (layer < 0 || static_cast<std::uint32_t>(layer) >= view.numArrayLayers)
+        return false;
+    layer += static_cast<std::int32_t>(view.baseArrayLayer);
+    return true;
+}
+
+
+/* ----- Addressing ----- */
+
+static std::int32_t PositiveModulo(std::int32_t x, std::int32_t n)
+{
+    const std::int32_t r = x % n;
+    return (r < 0 ? r + n : r);
+}
+
+// Applies the address mode to the texel coordinate. Returns false if the coordinate refers to the border color.
+static bool ApplyAddressMode(SamplerAddressMode mode, std::int32_t& coord, std::int32_t size)
+{
+    switch (mode)
+    {
+        case SamplerAddressMode::Repeat:
+        {
+            coord = PositiveModulo(coord, size);
+        }
+        break;
+
+        case SamplerAddressMode::Mirror:
+        {
+            const std::int32_t m = PositiveModulo(coord, size * 2);
+            coord = (m < size ? m : size * 2 - 1 - m);
+        }
+        break;
+
+        case SamplerAddressMode::Clamp:
+        {
+            coord = std::max(0, std::min(coord, size - 1));
+        }
+        break;
+
+        case SamplerAddressMode::Border:
+        {
+            if (coord < 0 || coord >= size)
+                return false;
+        }
+        break;
+
+        case SamplerAddressMode::MirrorOnce:
+        {
+            coord = std::min(coord < 0 ? -1 - coord : coord, size - 1);
+        }
+        break;
+    }
+    return true;
+}
+
+// Projects the direction vector onto the specified cube face and returns the face coordinates in [0, 1] for directions that point towards that face.
+static void ProjectOntoCubeFace(std::int32_t face, const float dir[3], float& outU, float& outV)
+{
+    float sc, tc, ma;
+
+    switch (face)
+    {
+        case 0:     sc = -dir[2];   tc = -dir[1];   ma =  dir[0];   break;
+        case 1:     sc =  dir[2];   tc = -dir[1];   ma = -dir[0];   break;
+        case 2:     sc =  dir[0];   tc =  dir[2];   ma =  dir[1];   break;
+        case 3:     sc =  dir[0];   tc = -dir[2];   ma = -dir[1];   break;
+        case 4:     sc =  dir[0];   tc = -dir[1];   ma =  dir[2];   break;
+        default:    sc = -dir[0];   tc = -dir[1];   ma = -dir[2];   break;
+    }
+
+    if (ma > 0.0f)
+    {
+        outU = (sc / ma + 1.0f) * 0.5f;
+        outV = (tc / ma + 1.0f) * 0.5f;
+    }
+    else
+    {
+        outU = 0.5f;
+        outV = 0.5f;
+    }
+}
+
+// Selects the cube face for the direction vector and returns the face coordinates in [0, 1].
+static std::int32_t SelectCubeFace(const float dir[3], float& outU, float& outV)
+{
+    const float ax = std::abs(dir[0]);
+    const float ay = std::abs(dir[1]);
+    const float az = std::abs(dir[2]);
+
+    std::int32_t face;
+
+    if (ax >= ay && ax >= az)
+        face = (dir[0] >= 0.0f ? 0 : 1);
+    else if (ay >= az)
+        face = (dir[1] >= 0.0f ? 2 : 3);
+    else
+        face = (dir[2] >= 0.0f ? 4 : 5);
+
+    ProjectOntoCubeFace(face, dir, outU, outV);
+
+    return face;
+}
+
+static bool CompareDepth(CompareOp compareOp, float ref, float depth)
+{
+    switch (compareOp)
+    {
+        case CompareOp::NeverPass:      return false;
+        case CompareOp::Less:           return (ref <  depth);
+        case CompareOp::Equal:          return (ref == depth);
+        case CompareOp::LessEqual:      return (ref <= depth);
+        case CompareOp::Greater:        return (ref >  depth);
+        case CompareOp::NotEqual:       return (ref != depth);
+        case CompareOp::GreaterEqual:   return (ref >= depth);
+        case CompareOp::AlwaysPass:     return true;
+    }
+    return false;
+}
+
+// Returns the number of coordinates that address the image, excluding the array layer.
+static std::uint32_t GetNumImageCoords(spv::Dim dim)
+{
+    switch (dim)
+    {
+        case spv::Dim1D:        return 1;
+        case spv::Dim3D:        return 3;
+        case spv::DimCube:      return 3;
+        default:                return 2;
+    }
+}
+
+
+/* ----- Sampling ----- */
+
+// Returns the sampler for the opaque sampler pointer. Unbound samplers use the default sampler state.
+static const NullSampler& GetSamplerOrDefault(const void* sampler)
+{
+    static const NullSampler defaultSampler{ SamplerDescriptor{} };
+    return (sampler != nullptr ? *static_cast<const NullSampler*>(sampler) : defaultSampler);
+}
+
+/*
+Point-samples the texture at the base MIP-map level or at the nearest explicit level of detail.
+This is used for integer textures, which cannot be filtered.
+*/
+static void SampleNearest(const NullTextureView& view, const SamplerDescriptor& samplerDesc, const SpirvImageArgs& args, SpirvValue outTexel[4])
+{
+    /* Select MIP-map level: Only explicit levels of detail are considered, otherwise the base level is sampled */
+    std::uint32_t level = 0;
+    if ((args.flags & SpirvImageFlags::Lod) != 0 && samplerDesc.mipMapEnabled)
+    {
+        const float lod = std::max(samplerDesc.minLOD, std::min(args.lod + samplerDesc.mipMapLODBias, samplerDesc.maxLOD));
+        level = static_cast<std::uint32_t>(std::max(0.0f, std::floor(lod + 0.5f)));
+    }
+
+    const NullTexture& textureNull = *view.texture;
+    const Image& mipImage = textureNull.GetMipImage(view.baseMipLevel + std::min(level, view.numMipLevels - 1));
+    const Extent3D& extent = mipImage.GetExtent();
+
+    /* Determine normalized coordinates and array layer */
+    const std::uint32_t numImageCoords = GetNumImageCoords(args.dim);
+
+    float           coords[3]       = { 0.0f, 0.0f, 0.0f };
+    std::int32_t    layer           = 0;
+    std::uint32_t   numAddressed    = numImageCoords;
+    bool            isCube          = false;
+
+    if (args.dim == spv::DimCube)
+    {
+        const std::int32_t face = SelectCubeFace(args.coords, coords[0], coords[1]);
+        if (args.arrayed)
+            layer = static_cast<std::int32_t>(std::floor(args.coords[3] + 0.5f)) * 6;
+        layer += face;
+        numAddressed    = 2;
+        isCube          = true;
+    }
+    else
+    {
+        for_range(i, numImageCoords)
+            coords[i] = args.coords[i];
+        if (args.arrayed)
+            layer = static_cast<std::int32_t>(std::floor(args.coords[numImageCoords] + 0.5f));
+    }
+
+    if ((args.flags & SpirvImageFlags::Proj) != 0 && args.numCoords > numImageCoords)
+    {
+        const float q = args.coords[args.numCoords - 1];
+        if (q != 0.0f)
+        {
+            for_range(i, numImageCoords)
+                coords[i] /= q;
+        }
+    }
+
+    /* Map coordinates to texels and apply address modes */
+    const std::int32_t sizes[3] =
+    {
+        static_cast<std::int32_t>(extent.width),
+        static_cast<std::int32_t>(extent.height),
+        static_cast<std::int32_t>(extent.depth),
+    };
+    const SamplerAddressMode addressModes[3] = { samplerDesc.addressModeU, samplerDesc.addressModeV, samplerDesc.addressModeW };
+
+    std::int32_t pos[3] = { 0, 0, 0 };
+    bool isBorder = false;
+
+    for_range(i, numAddressed)
+    {
+        pos[i] = static_cast<std::int32_t>(std::floor(coords[i] * static_cast<float>(sizes[i])));
+        if ((args.flags & SpirvImageFlags::Offset) != 0)
+            pos[i] += args.offset[i];
+        if (!ApplyAddressMode(isCube ? SamplerAddressMode::Clamp : addressModes[i], pos[i], sizes[i]))
+            isBorder = true;
+    }
+
+    /* Array layers are stored in the image height for 1D arrays and in the image depth otherwise */
+    if (args.arrayed || isCube)
+    {
+        const std::uint32_t layerCoord = (args.dim == spv::Dim1D ? 1 : 2);
+        layer = std::max(0, std::min(layer, static_cast<std::int32_t>(view.numArrayLayers) - 1)) + static_cast<std::int32_t>(view.baseArrayLayer);
+        pos[layerCoord] = std::max(0, std::min(layer, sizes[layerCoord] - 1));
+    }
+
+    SpirvValue texel[4];
+    if (isBorder)
+    {
+        for_range(i, 4u)
+        {
+            if (args.kind == SpirvScalarKind::Float)
+                texel[i].f = samplerDesc.borderColor[i];
+            else
+                texel[i].u = static_cast<std::uint32_t>(samplerDesc.borderColor[i]);
+        }
+    }
+    else if (IsTexelInside(mipImage, pos))
+        ReadTexel(view, mipImage, pos, args.kind, texel);
+    else
+        SetZeroTexel(texel);
+
+    /* Compare depth value with the reference value */
+    if ((args.flags & SpirvImageFlags::Dref) != 0)
+    {
+        const CompareOp compareOp = (samplerDesc.compareEnabled ? samplerDesc.compareOp : CompareOp::LessEqual);
+        outTexel[0].f = (CompareDepth(compareOp, args.dref, texel[0].f) ? 1.0f : 0.0f);
+        outTexel[1].f = 0.0f;
+        outTexel[2].f = 0.0f;
+        outTexel[3].f = 1.0f;
+    }
+    else
+    {
+        for_range(i, 4u)
+            outTexel[i] = texel[i];
+    }
+}
+
+static_assert(g_spirvNumLanes == 4, "NullSampleQuad requires four SPIR-V lanes");
+
+// Converts the image arguments of all active lanes into a sample quad for NullSampler. Cube map directions are projected onto their faces.
+static void ConvertToSampleQuad(const SpirvImageArgs (&args)[g_spirvNumLanes], std::uint32_t mask, const SpirvImageArgs& baseArgs, NullSampleQuad& outQuad)
+{
+    const bool          isCube          = (baseArgs.dim == spv::DimCube);
+    const std::uint32_t numImageCoords  = GetNumImageCoords(baseArgs.dim);
+    const std::uint32_t flags           = baseArgs.flags;
+
+    outQuad.mask        = mask;
+    outQuad.numCoords   = (isCube ? 2 : numImageCoords);
+    outQuad.isCube      = isCube;
+    outQuad.explicitLod = ((flags & SpirvImageFlags::Lod) != 0);
+    outQuad.compare     = ((flags & SpirvImageFlags::Dref) != 0);
+
+    for_range(lane, g_spirvNumLanes)
+    {
+        if ((mask & (1u << lane)) == 0)
+            continue;
+
+        const SpirvImageArgs& laneArgs = args[lane];
+
+        if (isCube)
+        {
+            /* Gradients are the differences of the neighboring directions projected onto the same face */
+            float u, v;
+            const std::int32_t face = SelectCubeFace(laneArgs.coords, u, v);
+
+            const float dirX[3] = { laneArgs.coords[0] + laneArgs.ddx[0], laneArgs.coords[1] + laneArgs.ddx[1], laneArgs.coords[2] + laneArgs.ddx[2] };
+            const float dirY[3] = { laneArgs.coords[0] + laneArgs.ddy[0], laneArgs.coords[1] + laneArgs.ddy[1], laneArgs.coords[2] + laneArgs.ddy[2] };
+
+            float ux, vx, uy, vy;
+            ProjectOntoCubeFace(face, dirX, ux, vx);
+            ProjectOntoCubeFace(face, dirY, uy, vy);
+
+            outQuad.coords[0][lane] = u;
+            outQuad.coords[1][lane] = v;
+            outQuad.ddx[0][lane]    = ux - u;
+            outQuad.ddx[1][lane]    = vx - v;
+            outQuad.ddy[0][lane]    = uy - u;
+            outQuad.ddy[1][lane]    = vy - v;
+            outQuad.layer[lane]     = face + (baseArgs.arrayed ? static_cast<std::int32_t>(std::floor(laneArgs.coords[3] + 0.5f)) * 6 : 0);
+        }
+        else
+        {
+            for_range(i, numImageCoords)
+            {
+                outQuad.coords[i][lane] = laneArgs.coords[i];
+                outQuad.ddx[i][lane]    = laneArgs.ddx[i];
+                outQuad.ddy[i][lane]    = laneArgs.ddy[i];
+            }
+            if (baseArgs.arrayed)
+                outQuad.layer[lane] = static_cast<std::int32_t>(std::floor(laneArgs.coords[numImageCoords] + 0.5f));
+        }
+
+        if ((flags & SpirvImageFlags::Offset) != 0)
+        {
+            for_range(i, outQuad.numCoords)
+                outQuad.offset[i][lane] = laneArgs.offset[i];
+        }
+
+        if ((flags & (SpirvImageFlags::Lod | SpirvImageFlags::Bias)) != 0)
+            outQuad.lod[lane] = laneArgs.lod;
+        if ((flags & SpirvImageFlags::MinLod) != 0)
+            outQuad.minLod[lane] = laneArgs.minLod;
+
+        outQuad.dref[lane] = laneArgs.dref;
+    }
+}
+
+
+/* ----- NullImageHandler ----- */
+
+void NullImageHandler::Sample(const void* image, const void* sampler, const SpirvImageArgs& args, SpirvValue outTexel[4])
+{
+    SpirvImageArgs laneArgs[g_spirvNumLanes];
+    laneArgs[0] = args;
+
+    SpirvValue texels[g_spirvNumLanes][4];
+    SampleQuad(image, sampler, laneArgs, 1u, texels);
+
+    for_range(i, 4u)
+        outTexel[i] = texels[0][i];
+}
+
+void NullImageHandler::SampleQuad(
+    const void*             image,
+    const void*             sampler,
+    const SpirvImageArgs    (&args)[g_spirvNumLanes],
+    std::uint32_t           mask,
+    SpirvValue              outTexels[g_spirvNumLanes][4])
+{
+    if (mask == 0)
+        return;
+
+    /* All lanes execute the same instruction, so they share the image type and operands */
+    std::uint32_t firstLane = 0;
+    while ((mask & (1u << firstLane)) == 0)
+        ++firstLane;
+
+    const SpirvImageArgs& baseArgs = args[firstLane];
+
+    const NullTextureView* textureView = static_cast<const NullTextureView*>(image);
+    if (textureView == nullptr || baseArgs.dim == spv::DimBuffer)
+    {
+        for_range(lane, g_spirvNumLanes)
+            SetZeroTexel(outTexels[lane]);
+        return;
+    }
+
+    const NullSampler& samplerNull = GetSamplerOrDefault(sampler);
+
+    /* Integer textures cannot be filtered */
+    if (baseArgs.kind != SpirvScalarKind::Float)
+    {
+        for_range(lane, g_spirvNumLanes)
+        {
+            if ((mask & (1u << lane)) != 0)
+            {
+                SampleNearest(*textureView, samplerNull.desc, args[lane], outTexels[lane]);
+                SwizzleTexel(textureView->swizzle, baseArgs.kind, outTexels[lane]);
+            }
+        }
+        return;
+    }
+
+    NullSampleQuad quad;
+    ConvertToSampleQuad(args, mask, baseArgs, quad);
+
+    float texels[4][4];
+    samplerNull.SampleQuad(*textureView, quad, texels);
+
+    for_range(lane, g_spirvNumLanes)
+    {
+        if ((mask & (1u << lane)) == 0)
+            continue;
+        for_range(i, 4u)
+            outTexels[lane][i].f = texels[lane][i];
+        SwizzleTexel(textureView->swizzle, baseArgs.kind, outTexels[lane]);
+    }
+}
+
+void NullImageHandler::Fetch(const void* image, const SpirvImageArgs& args, SpirvValue outTexel[4])
+{
+    SetZeroTexel(outTexel);
+
+    const NullTextureView* textureView = static_cast<const NullTextureView*>(image);
+    if (textureView == nullptr || args.level < 0 || static_cast<std::uint32_t>(args.level) >= textureView->numMipLevels)
+        return;
+
+    const NullTexture& textureNull = *textureView->texture;
+    const Image& mipImage = textureNull.GetMipImage(textureView->baseMipLevel + static_cast<std::uint32_t>(args.level));
+
+    std::int32_t pos[3] = { 0, 0, 0 };
+    for_range(i, std::min(args.numCoords, 3u))
+    {
+        pos[i] = args.texel[i];
+        if ((args.flags & SpirvImageFlags::Offset) != 0)
+            pos[i] += args.offset[i];
+    }
+
+    /* Out-of-bounds reads return zero like robust buffer access */
+    if (args.arrayed && !MapArrayLayer(*textureView, pos[args.dim == spv::Dim1D ? 1 : 2]))
+        return;
+
+    if (IsTexelInside(mipImage, pos))
+    {
+        ReadTexel(*textureView, mipImage, pos, args.kind, outTexel);
+        SwizzleTexel(textureView->swizzle, args.kind, outTexel);
+    }
+}
+
+void NullImageHandler::Write(void* image, const SpirvImageArgs& args, const SpirvValue texel[4])
+{
+    const NullTextureView* textureView = static_cast<const NullTextureView*>(image);
+    if (textureView == nullptr)
+        return;
+
+    Image& mipImage = textureView->texture->GetMipImage(textureView->baseMipLevel);
+
+    std::int32_t pos[3] = { 0, 0, 0 };
+    for_range(i, std::min(args.numCoords, 3u))
+        pos[i] = args.texel[i];
+
+    /* Out-of-bounds writes are discarded */
+    if (args.arrayed && !MapArrayLayer(*textureView, pos[args.dim == spv::Dim1D ? 1 : 2]))
+        return;
+
+    if (IsTexelInside(mipImage, pos))
+        WriteTexel(*textureView, mipImage, pos, args.kind, texel);
+}
+
+void NullImageHandler::QuerySize(const void* image, std::int32_t level, std::uint32_t outSize[4])
+{
+    for_range(i, 4u)
+        outSize[i] = 0;
+
+    const NullTextureView* textureView = static_cast<const NullTextureView*>(image);
+    if (textureView == nullptr)
+        return;
+
+    const NullTexture& textureNull = *textureView->texture;
+    const std::uint32_t mipLevel = std::min(static_cast<std::uint32_t>(std::max(0, level)), textureView->numMipLevels - 1);
+    const Extent3D& extent = textureNull.GetMipImage(textureView->baseMipLevel + mipLevel).GetExtent();
+
+    outSize[0] = extent.width;
+    outSize[1] = extent.height;
+    outSize[2] = extent.depth;
+
+    /* Array layers are limited to the texture view; array layers of cube maps are specified in multiples of 6 faces */
+    switch (textureNull.desc.type)
+    {
+        case TextureType::Texture1DArray:
+            outSize[1] = textureView->numArrayLayers;
+            break;
+        case TextureType::Texture2DArray:
+        case TextureType::Texture2DMSArray:
+            outSize[2] = textureView->numArrayLayers;
+            break;
+        case TextureType::TextureCubeArray:
+            outSize[2] = textureView->numArrayLayers / 6;
+            break;
+        default:
+            break;
+    }
+}
+
+std::uint32_t NullImageHandler::QueryLevels(const void* image)
+{
+    const NullTextureView* textureView = static_cast<const NullTextureView*>(image);
+    return (textureView != nullptr ? textureView->numMipLevels : 0);
+}
+
+std::uint32_t NullImageHandler::QuerySamples(const void* image)
+{
+    const NullTextureView* textureView = static_cast<const NullTextureView*>(image);
+    return (textureView != nullptr ? std::max(1u, textureView->texture->desc.samples) : 0);
+}
+
+NullImageHandler* NullImageHandler::Get()
+{
+    static NullImageHandler instance;
+    return &instance;
+}
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+
+// ================================================================================
@@ -0,0 +1,58 @@
+/*
+ * NullImageHandler.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_IMAGE_HANDLER_H
+#define LLGL_NULL_IMAGE_HANDLER_H
+
+
+#include "../../SPIRV/SpirvInterpreter.h"
+
+
+namespace LLGL
+{
+
+
+/*
+Image access for SPIR-V shaders on NullTexture objects.
+Images are bound as NullTextureView pointers and samplers as NullSampler pointers.
+Float textures are sampled with the filters of the sampler for an entire quad at once; integer textures are point-sampled.
+*/
+class NullImageHandler final : public SpirvImageHandler
+{
+
+    public:
+
+        void Sample(const void* image, const void* sampler, const SpirvImageArgs& args, SpirvValue outTexel[4]) override;
+        void SampleQuad(
+            const void*             image,
+            const void*             sampler,
+            const SpirvImageArgs    (&args)[g_spirvNumLanes],
+            std::uint32_t           mask,
+            SpirvValue              outTexels[g_spirvNumLanes][4]
+        ) override;
+        void Fetch(const void* image, const SpirvImageArgs& args, SpirvValue outTexel[4]) override;
+        void Write(void* image, const SpirvImageArgs& args, const SpirvValue texel[4]) override;
+        void QuerySize(const void* image, std::int32_t level, std::uint32_t outSize[4]) override;
+        std::uint32_t QueryLevels(const void* image) override;
+        std::uint32_t QuerySamples(const void* image) override;
+
+    public:
+
+        // Returns the image handler that is shared by all shader stages. It is stateless and can be used concurrently.
+        static NullImageHandler* Get();
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,13 @@
 
 #include "NullShader.h"
 
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+#   include "../../../Core/StringUtils.h"
+#   include "../../../Core/CoreUtils.h"
+#   include <LLGL/ShaderFlags.h>
+#   include <string.h>
+#endif
+
 
 namespace LLGL
 {
@@ -18,6 +25,9 @@ NullShader::NullShader(const ShaderDescriptor& desc) :
 {
     if (desc.debugName != nullptr)
         SetDebugName(desc.debugName);
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    BuildProgram(desc);
+    #endif
 }
 
 void NullShader::SetDebugName(const char* name)
@@ -30,7 +40,11 @@ void NullShader::SetDebugName(const char* name)
 
 const Report* NullShader::GetReport() const
 {
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+    return (report_ ? &report_ : nullptr);
+    #else
     return nullptr; // dummy
+    #endif
 }
 
 bool NullShader::Reflect(ShaderReflection& reflection) const
@@ -52,6 +66,87 @@ bool NullShader::Reflect(ShaderReflection& reflection) const
     return true;
 }
 
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+SpirvInterpreter* NullShader::AcquireInterpreter() const
+{
+    if (program_)
+    {
+        {
+            std::lock_guard<std::mutex> guard{ interpreterPoolMutex_ };
+            if (!interpreterPool_.empty())
+            {
+                SpirvInterpreter* interpreter = interpreterPool_.back().release();
+                interpreterPool_.pop_back();
+                return interpreter;
+            }
+        }
+        return new SpirvInterpreter{ *program_ };
+    }
+    return nullptr;
+}
+
+void NullShader::ReleaseInterpreter(SpirvInterpreter* interpreter) const
+{
+    if (interpreter != nullptr)
+    {
+        std::lock_guard<std::mutex> guard{ interpreterPoolMutex_ };
+        interpreterPool_.emplace_back(interpreter);
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+static bool GetSpirvExecutionModel(const ShaderType type, spv::ExecutionModel& outModel)
+{
+    switch (type)
+    {
+        case ShaderType::Vertex:    outModel = spv::ExecutionModelVertex;       return true;
+        case ShaderType::Fragment:  outModel = spv::ExecutionModelFragment;     return true;
+        case ShaderType::Compute:   outModel = spv::ExecutionModelGLCompute;    return true;
+        default:                    return false;
+    }
+}
+
+void NullShader::BuildProgram(const ShaderDescriptor& shaderDesc)
+{
+    /* Only SPIR-V binaries can be executed */
+    if (!IsShaderSourceBinary(shaderDesc.sourceType) || shaderDesc.source == nullptr)
+        return;
+
+    spv::ExecutionModel executionModel = spv::ExecutionModelMax;
+    if (!GetSpirvExecutionModel(shaderDesc.type, executionModel))
+        return;
+
+    /* Load SPIR-V module words; they must outlive the program as reflection refers to their strings */
+    if (shaderDesc.sourceType == ShaderSourceType::BinaryFile)
+    {
+        std::vector<char> fileContent = ReadFileBuffer(shaderDesc.source);
+        shaderCode_.resize(fileContent.size() / 4);
+        ::memcpy(shaderCode_.data(), fileContent.data(), shaderCode_.size() * 4);
+    }
+    else
+    {
+        shaderCode_.resize(shaderDesc.sourceSize / 4);
+        ::memcpy(shaderCode_.data(), shaderDesc.source, shaderCode_.size() * 4);
+    }
+
+    /* Compile entry point for the SPIR-V interpreter */
+    const char* entryPoint = (shaderDesc.entryPoint != nullptr && *shaderDesc.entryPoint != '\0' ? shaderDesc.entryPoint : "main");
+
+    program_ = MakeUnique<SpirvProgram>();
+    if (!program_->Compile(SpirvModuleView{ shaderCode_.data(), shaderCode_.size() * 4 }, executionModel, entryPoint))
+    {
+        report_.Errorf("failed to compile SPIR-V shader for CPU execution: %s\n", program_->GetErrorMessage().c_str());
+        program_.reset();
+    }
+}
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
 
 } // /namespace LLGL
 
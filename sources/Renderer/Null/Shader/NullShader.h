@@ -10,8 +10,16 @@
 
 
 #include <LLGL/Shader.h>
+#include <LLGL/Report.h>
 #include <string>
 
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+#   include "../../SPIRV/SpirvInterpreter.h"
+#   include <memory>
+#   include <mutex>
+#   include <vector>
+#endif
+
 
 namespace LLGL
 {
@@ -32,6 +40,28 @@ class NullShader final : public Shader
 
         NullShader(const ShaderDescriptor& desc);
 
+        #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+        // Returns the compiled SPIR-V program or null if the shader is not executable.
+        inline const SpirvProgram* GetProgram() const
+        {
+            return program_.get();
+        }
+
+        // Returns the SPIR-V module words this shader was created with.
+        inline const std::vector<std::uint32_t>& GetShaderCode() const
+        {
+            return shaderCode_;
+        }
+
+        // Takes an interpreter from the pool of this shader or creates a new one. This is thread-safe.
+        SpirvInterpreter* AcquireInterpreter() const;
+
+        // Returns an interpreter to the pool of this shader. This is thread-safe.
+        void ReleaseInterpreter(SpirvInterpreter* interpreter) const;
+
+        #endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
     public:
 
         const ShaderDescriptor desc;
@@ -40,6 +70,23 @@ class NullShader final : public Shader
 
         std::string label_;
 
+    #ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+    private:
+
+        void BuildProgram(const ShaderDescriptor& shaderDesc);
+
+    private:
+
+        Report                                                  report_;
+        std::vector<std::uint32_t>                              shaderCode_;
+        std::unique_ptr<SpirvProgram>                           program_;
+
+        mutable std::mutex                                      interpreterPoolMutex_;
+        mutable std::vector<std::unique_ptr<SpirvInterpreter>>  interpreterPool_;
+
+    #endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
 };
 
 
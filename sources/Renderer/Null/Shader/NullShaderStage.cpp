@@ -0,0 +1,230 @@
+/*
+ * NullShaderStage.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifdef LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+#include "NullShaderStage.h"
+#include "NullShader.h"
+#include "NullImageHandler.h"
+#include "../Buffer/NullBuffer.h"
+#include "../Texture/NullTexture.h"
+#include "../Texture/NullSampler.h"
+#include "../RenderState/NullResourceHeap.h"
+#include "../RenderState/NullPipelineLayout.h"
+#include "../../CheckedCast.h"
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+void NullShaderStage::Reset(const NullShader* shader)
+{
+    shader_     = shader;
+    program_    = (shader != nullptr ? shader->GetProgram() : nullptr);
+    buffers_.clear();
+    images_.clear();
+}
+
+// Returns true if the layout binding can provide the resource of the specified SPIR-V type.
+static bool IsBindingCompatible(const BindingDescriptor& binding, SpirvResourceType type)
+{
+    switch (type)
+    {
+        case SpirvResourceType::UniformBuffer:
+            return (binding.type == ResourceType::Buffer && (binding.bindFlags & BindFlags::ConstantBuffer) != 0);
+        case SpirvResourceType::StorageBuffer:
+            return (binding.type == ResourceType::Buffer && (binding.bindFlags & (BindFlags::Storage | BindFlags::Sampled)) != 0);
+        case SpirvResourceType::SampledImage:
+        case SpirvResourceType::StorageImage:
+        case SpirvResourceType::CombinedImageSampler:
+            return (binding.type == ResourceType::Texture);
+        case SpirvResourceType::Sampler:
+            return (binding.type == ResourceType::Sampler);
+        default:
+            return false;
+    }
+}
+
+// Finds the resource view for the specified element of a SPIR-V resource in the resource heap or the individual bindings.
+static bool FindResourceView(
+    const NullResourceBindings& bindings,
+    SpirvResourceType           type,
+    std::uint32_t               binding,
+    std::uint32_t               element,
+    ResourceViewDescriptor&     outResourceView)
+{
+    const PipelineLayoutDescriptor& layoutDesc = bindings.pipelineLayout->desc;
+
+    /* Search heap bindings; array bindings occupy one descriptor for each element */
+    if (bindings.resourceHeap != nullptr)
+    {
+        std::uint32_t descriptor = 0;
+        for (const BindingDescriptor& bindingDesc : layoutDesc.heapBindings)
+        {
+            const std::uint32_t arraySize = std::max(1u, bindingDesc.arraySize);
+            if (bindingDesc.slot.index == binding && element < arraySize && IsBindingCompatible(bindingDesc, type))
+            {
+                if (const ResourceViewDescriptor* resourceView = bindings.resourceHeap->GetResourceView(bindings.descriptorSet, descriptor + element))
+                {
+                    if (resourceView->resource != nullptr)
+                    {
+                        outResourceView = *resourceView;
+                        return true;
+                    }
+                }
+            }
+            descriptor += arraySize;
+        }
+    }
+
+    /* Search individual bindings, which cannot be arrays */
+    if (element == 0)
+    {
+        for_range(i, std::min(layoutDesc.bindings.size(), bindings.resources.size()))
+        {
+            const BindingDescriptor& bindingDesc = layoutDesc.bindings[i];
+            if (bindingDesc.slot.index == binding && bindings.resources[i] != nullptr && IsBindingCompatible(bindingDesc, type))
+            {
+                outResourceView = ResourceViewDescriptor{ bindings.resources[i] };
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Returns the sampler state for the specified binding from the sampler bindings or static samplers.
+static const NullSampler* FindSampler(const NullResourceBindings& bindings, std::uint32_t binding, std::uint32_t element)
+{
+    ResourceViewDescriptor resourceView;
+    if (FindResourceView(bindings, SpirvResourceType::Sampler, binding, element, resourceView) &&
+        resourceView.resource->GetResourceType() == ResourceType::Sampler)
+    {
+        return LLGL_CAST(const NullSampler*, resourceView.resource);
+    }
+
+    const std::vector<StaticSamplerDescriptor>& staticSamplers = bindings.pipelineLayout->desc.staticSamplers;
+    for_range(i, staticSamplers.size())
+    {
+        if (staticSamplers[i].slot.index == binding)
+            return &(bindings.pipelineLayout->GetStaticSampler(i));
+    }
+
+    return nullptr;
+}
+
+void NullShaderStage::UpdateBindings(const NullResourceBindings& bindings)
+{
+    if (program_ == nullptr)
+        return;
+
+    const std::vector<SpirvProgram::Resource>& resources = program_->GetResources();
+
+    buffers_.clear();
+    buffers_.resize(resources.size());
+    images_.clear();
+    images_.resize(program_->GetNumHandles());
+
+    for_range(resourceIndex, resources.size())
+    {
+        const SpirvProgram::Resource& resource = resources[resourceIndex];
+
+        /* Push constants are backed by the uniform data of the command context */
+        if (resource.type == SpirvResourceType::PushConstants)
+        {
+            buffers_[resourceIndex].data = const_cast<char*>(bindings.uniforms.data());
+            buffers_[resourceIndex].size = bindings.uniforms.size();
+            continue;
+        }
+
+        if (bindings.pipelineLayout == nullptr)
+            continue;
+
+        if (resource.type == SpirvResourceType::UniformBuffer || resource.type == SpirvResourceType::StorageBuffer)
+        {
+            /* Resolve buffer range; buffer arrays are not supported */
+            ResourceViewDescriptor resourceView;
+            if (!FindResourceView(bindings, resource.type, resource.binding, 0, resourceView) ||
+                resourceView.resource->GetResourceType() != ResourceType::Buffer)
+            {
+                continue;
+            }
+
+            NullBuffer* bufferNull = LLGL_CAST(NullBuffer*, resourceView.resource);
+            const std::uint64_t offset = std::min(resourceView.bufferView.offset, bufferNull->desc.size);
+            const std::uint64_t size = std::min(resourceView.bufferView.size, bufferNull->desc.size - offset);
+
+            buffers_[resourceIndex].data = static_cast<char*>(bufferNull->GetData()) + offset;
+            buffers_[resourceIndex].size = size;
+        }
+        else
+        {
+            /* Resolve textures and samplers for each array element */
+            for_range(element, resource.arraySize)
+            {
+                const std::uint32_t handle = resource.firstHandle + element;
+                if (handle >= images_.size())
+                    break;
+
+                ImageBinding& imageBinding = images_[handle];
+
+                if (resource.type != SpirvResourceType::Sampler)
+                {
+                    ResourceViewDescriptor resourceView;
+                    if (FindResourceView(bindings, resource.type, resource.binding, element, resourceView) &&
+                        resourceView.resource->GetResourceType() == ResourceType::Texture)
+                    {
+                        imageBinding.view = LLGL_CAST(NullTexture*, resourceView.resource)->MakeView(resourceView.textureView);
+                    }
+                }
+
+                if (resource.type == SpirvResourceType::Sampler || resource.type == SpirvResourceType::CombinedImageSampler)
+                    imageBinding.sampler = FindSampler(bindings, resource.binding, element);
+            }
+        }
+    }
+}
+
+SpirvInterpreter* NullShaderStage::AcquireInterpreter() const
+{
+    if (shader_ == nullptr)
+        return nullptr;
+
+    SpirvInterpreter* interpreter = shader_->AcquireInterpreter();
+    if (interpreter != nullptr)
+    {
+        interpreter->SetImageHandler(NullImageHandler::Get());
+        for_range(i, buffers_.size())
+            interpreter->SetBuffer(static_cast<std::uint32_t>(i), buffers_[i].data, buffers_[i].size);
+        for_range(i, images_.size())
+        {
+            void* image = (images_[i].view.texture != nullptr ? const_cast<NullTextureView*>(&(images_[i].view)) : nullptr);
+            interpreter->SetImage(static_cast<std::uint32_t>(i), image, images_[i].sampler);
+        }
+    }
+    return interpreter;
+}
+
+void NullShaderStage::ReleaseInterpreter(SpirvInterpreter* interpreter) const
+{
+    if (shader_ != nullptr)
+        shader_->ReleaseInterpreter(interpreter);
+}
+
+
+} // /namespace LLGL
+
+
+#endif // /LLGL_NULL_ENABLE_SPIRV_EXECUTION
+
+
+// ================================================================================
@@ -0,0 +1,82 @@
+/*
+ * NullShaderStage.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_NULL_SHADER_STAGE_H
+#define LLGL_NULL_SHADER_STAGE_H
+
+
+#include "../RenderState/NullResourceBindings.h"
+#include "../Texture/NullTexture.h"
+#include "../../SPIRV/SpirvInterpreter.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class NullShader;
+
+/*
+Shader stage of a pipeline with the resources of the compiled SPIR-V program resolved to the bound resources.
+Resources are matched by their binding number against heap bindings first, then individual bindings and static samplers.
+*/
+class NullShaderStage
+{
+
+    public:
+
+        // Resets this stage to the specified shader. Null or non-executable shaders disable this stage.
+        void Reset(const NullShader* shader);
+
+        // Resolves the resources of the program to the specified bindings. Must be called before any interpreter is acquired.
+        void UpdateBindings(const NullResourceBindings& bindings);
+
+        // Acquires an interpreter with all resources of this stage bound. This is thread-safe.
+        SpirvInterpreter* AcquireInterpreter() const;
+
+        // Releases an interpreter that was acquired from this stage. This is thread-safe.
+        void ReleaseInterpreter(SpirvInterpreter* interpreter) const;
+
+        // Returns the program of this stage or null if this stage is not executable.
+        inline const SpirvProgram* GetProgram() const
+        {
+            return program_;
+        }
+
+    private:
+
+        struct BufferBinding
+        {
+            void*           data    = nullptr;
+            std::uint64_t   size    = 0;
+        };
+
+        struct ImageBinding
+        {
+            NullTextureView view;               // Image is bound as pointer to this view if it refers to a texture.
+            const void*     sampler = nullptr;
+        };
+
+    private:
+
+        const NullShader*           shader_     = nullptr;
+        const SpirvProgram*         program_    = nullptr;
+        std::vector<BufferBinding>  buffers_;   // Buffer bindings for each resource of the program.
+        std::vector<ImageBinding>   images_;    // Image bindings for each handle of the program.
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -10,6 +10,7 @@
 #include "../../CheckedCast.h"
 #include "../../RenderTargetUtils.h"
 #include "../../../Core/CoreUtils.h"
+#include <LLGL/Utils/ForRange.h>
 
 
 namespace LLGL
@@ -44,7 +45,7 @@ std::uint32_t NullRenderTarget::GetSamples() const
 
 std::uint32_t NullRenderTarget::GetNumColorAttachments() const
 {
-    return static_cast<std::uint32_t>(colorAttachments_.size());
+    return framebufferDesc_.numColorAttachments;
 }
 
 bool NullRenderTarget::HasDepthAttachment() const
@@ -69,56 +70,48 @@ const RenderPass* NullRenderTarget::GetRenderPass() const
 
 void NullRenderTarget::BuildAttachmentArray()
 {
-    /* Cache color attachments */
-    for (const auto& attachment : desc.colorAttachments)
-    {
-        if (IsAttachmentEnabled(attachment))
-        {
-            if (auto texture = attachment.texture)
-            {
-                auto textureNull = LLGL_CAST(NullTexture*, texture);
-                colorAttachments_.push_back(textureNull);
-            }
-            else
-                colorAttachments_.push_back(MakeIntermediateAttachment(attachment.format, desc.samples));
-        }
-    }
+    framebufferDesc_.resolution = desc.resolution;
 
-    /* Cache resolve attachments */
-    for (const auto& attachment : desc.resolveAttachments)
+    /* Cache color and resolve attachments */
+    for_range(i, LLGL_MAX_NUM_COLOR_ATTACHMENTS)
     {
-        if (IsAttachmentEnabled(attachment))
+        if (IsAttachmentEnabled(desc.colorAttachments[i]))
         {
-            if (auto texture = attachment.texture)
-            {
-                auto textureNull = LLGL_CAST(NullTexture*, texture);
-                resolveAttachments_.push_back(textureNull);
-            }
-            else
-                resolveAttachments_.push_back(MakeIntermediateAttachment(attachment.format));
+            const std::uint32_t index = framebufferDesc_.numColorAttachments++;
+            framebufferDesc_.colorAttachments[index] = MakeAttachmentView(desc.colorAttachments[i], desc.samples);
+            if (IsAttachmentEnabled(desc.resolveAttachments[i]))
+                framebufferDesc_.resolveAttachments[index] = MakeAttachmentView(desc.resolveAttachments[i]);
         }
     }
 
     /* Cache depth-stencil attachment */
     if (IsAttachmentEnabled(desc.depthStencilAttachment))
     {
-        if (auto* texture = desc.depthStencilAttachment.texture)
-        {
-            auto* textureNull = LLGL_CAST(NullTexture*, texture);
-            depthStencilAttachment_ = textureNull;
-            depthStencilFormat_     = textureNull->desc.format;
-        }
-        else
-            depthStencilFormat_ = desc.depthStencilAttachment.format;
+        framebufferDesc_.depthStencilAttachment = MakeAttachmentView(desc.depthStencilAttachment, desc.samples);
+        depthStencilFormat_ = framebufferDesc_.depthStencilAttachment.texture->desc.format;
     }
 }
 
+NullAttachmentView NullRenderTarget::MakeAttachmentView(const AttachmentDescriptor& attachment, std::uint32_t samples)
+{
+    NullAttachmentView view;
+    if (auto* texture = attachment.texture)
+    {
+        view.texture    = LLGL_CAST(NullTexture*, texture);
+        view.mipLevel   = attachment.mipLevel;
+        view.arrayLayer = attachment.arrayLayer;
+    }
+    else
+        view.texture    = MakeIntermediateAttachment(attachment.format, samples);
+    return view;
+}
+
 NullTexture* NullRenderTarget::MakeIntermediateAttachment(const Format format, std::uint32_t samples)
 {
     TextureDescriptor textureDesc;
     {
         textureDesc.type            = (samples > 1 ? TextureType::Texture2DMS : TextureType::Texture2D);
-        textureDesc.bindFlags       = BindFlags::ColorAttachment;
+        textureDesc.bindFlags       = (IsDepthOrStencilFormat(format) ? BindFlags::DepthStencilAttachment : BindFlags::ColorAttachment);
         textureDesc.miscFlags       = MiscFlags::FixedSamples;
         textureDesc.format          = format;
         textureDesc.extent.width    = desc.resolution.width;
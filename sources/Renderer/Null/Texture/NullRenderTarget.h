@@ -11,6 +11,7 @@
 
 #include <LLGL/RenderTarget.h>
 #include "NullTexture.h"
+#include "../Raster/NullFramebuffer.h"
 #include <string>
 #include <vector>
 
@@ -34,6 +35,12 @@ class NullRenderTarget final : public RenderTarget
 
         NullRenderTarget(const RenderTargetDescriptor& desc);
 
+        // Returns the attachment views for the framebuffer of a render pass.
+        inline const NullFramebufferDescriptor& GetFramebufferDesc() const
+        {
+            return framebufferDesc_;
+        }
+
     public:
 
         const RenderTargetDescriptor desc;
@@ -42,14 +49,13 @@ class NullRenderTarget final : public RenderTarget
 
         void BuildAttachmentArray();
 
+        NullAttachmentView MakeAttachmentView(const AttachmentDescriptor& attachment, std::uint32_t samples = 1);
         NullTexture* MakeIntermediateAttachment(const Format format, std::uint32_t samples = 1);
 
     private:
 
         std::string                                 label_;
-        std::vector<NullTexture*>                   colorAttachments_;
-        std::vector<NullTexture*>                   resolveAttachments_;
-        NullTexture*                                depthStencilAttachment_     = nullptr;
+        NullFramebufferDescriptor                   framebufferDesc_;
         Format                                      depthStencilFormat_         = Format::Undefined;
         std::vector<std::unique_ptr<NullTexture>>   intermediateAttachments_;
 
@@ -6,14 +6,32 @@
  */
 
 #include "NullSampler.h"
+#include "NullTexture.h"
+#include "../../../Core/CPUFeatures.h"
+#include "../../../Core/CompilerExtensions.h"
+#include "../../../Core/Float16Compressor.h"
+#include <LLGL/Platform/Platform.h>
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_NULL_SAMPLER_X86
+#   include <emmintrin.h>
+#endif
 
 
 namespace LLGL
 {
 
 
+// Maximum number of anisotropic taps, which is the limit of all other backends.
+static constexpr std::uint32_t g_nullMaxAnisotropy = 16;
+
 NullSampler::NullSampler(const SamplerDescriptor& desc) :
-    desc { desc }
+    desc            { desc                                                                  },
+    maxAnisotropy_  { std::max(1u, std::min(desc.maxAnisotropy, g_nullMaxAnisotropy))      }
 {
     if (desc.debugName != nullptr)
         SetDebugName(desc.debugName);
@@ -33,6 +51,643 @@ bool NullSampler::GetNativeHandle(void* /*nativeHandle*/, std::size_t /*nativeHa
 }
 
 
+/* ----- Texel decoding ----- */
+
+// Decodes a single texel into RGBA components. Missing components are filled with (0, 0, 0, 1).
+typedef void (*PFN_NullDecodeTexel)(const char* data, float outTexel[4]);
+
+template <typename T>
+static T LoadComponent(const char* data)
+{
+    T value;
+    ::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+template <DataType Type>
+struct NullTexelComponent;
+
+template <>
+struct NullTexelComponent<DataType::Int8>
+{
+    static constexpr int size = 1;
+    static float Decode(const char* data) { return std::max(-1.0f, static_cast<float>(LoadComponent<std::int8_t>(data)) / 127.0f); }
+};
+
+template <>
+struct NullTexelComponent<DataType::UInt8>
+{
+    static constexpr int size = 1;
+    static float Decode(const char* data) { return static_cast<float>(LoadComponent<std::uint8_t>(data)) / 255.0f; }
+};
+
+template <>
+struct NullTexelComponent<DataType::Int16>
+{
+    static constexpr int size = 2;
+    static float Decode(const char* data) { return std::max(-1.0f, static_cast<float>(LoadComponent<std::int16_t>(data)) / 32767.0f); }
+};
+
+template <>
+struct NullTexelComponent<DataType::UInt16>
+{
+    static constexpr int size = 2;
+    static float Decode(const char* data) { return static_cast<float>(LoadComponent<std::uint16_t>(data)) / 65535.0f; }
+};
+
+template <>
+struct NullTexelComponent<DataType::Int32>
+{
+    static constexpr int size = 4;
+    static float Decode(const char* data) { return static_cast<float>(LoadComponent<std::int32_t>(data)); }
+};
+
+template <>
+struct NullTexelComponent<DataType::UInt32>
+{
+    static constexpr int size = 4;
+    static float Decode(const char* data) { return static_cast<float>(LoadComponent<std::uint32_t>(data)); }
+};
+
+template <>
+struct NullTexelComponent<DataType::Float16>
+{
+    static constexpr int size = 2;
+    static float Decode(const char* data) { return DecompressFloat16(LoadComponent<std::uint16_t>(data)); }
+};
+
+template <>
+struct NullTexelComponent<DataType::Float32>
+{
+    static constexpr int size = 4;
+    static float Decode(const char* data) { return LoadComponent<float>(data); }
+};
+
+template <>
+struct NullTexelComponent<DataType::Float64>
+{
+    static constexpr int size = 8;
+    static float Decode(const char* data) { return static_cast<float>(LoadComponent<double>(data)); }
+};
+
+// Decodes a texel with the source component index for each RGBA component, or -1 for missing components.
+template <DataType Type, int R, int G, int B, int A>
+static void DecodeTexel(const char* data, float outTexel[4])
+{
+    typedef NullTexelComponent<Type> Component;
+    outTexel[0] = (R >= 0 ? Component::Decode(data + R * Component::size) : 0.0f);
+    outTexel[1] = (G >= 0 ? Component::Decode(data + G * Component::size) : 0.0f);
+    outTexel[2] = (B >= 0 ? Component::Decode(data + B * Component::size) : 0.0f);
+    outTexel[3] = (A >= 0 ? Component::Decode(data + A * Component::size) : 1.0f);
+}
+
+// Decodes the depth component of the D24UNormS8UInt format, which is stored in the lower 24 bits.
+static void DecodeTexelD24S8(const char* data, float outTexel[4])
+{
+    outTexel[0] = static_cast<float>(LoadComponent<std::uint32_t>(data) & 0x00FFFFFFu) / static_cast<float>(0x00FFFFFFu);
+    outTexel[1] = 0.0f;
+    outTexel[2] = 0.0f;
+    outTexel[3] = 1.0f;
+}
+
+// Decodes the depth component of the D32FloatS8X24UInt format, which is stored in the second 32-bit word like the image converter expects.
+static void DecodeTexelD32S8X24(const char* data, float outTexel[4])
+{
+    outTexel[0] = LoadComponent<float>(data + sizeof(float));
+    outTexel[1] = 0.0f;
+    outTexel[2] = 0.0f;
+    outTexel[3] = 1.0f;
+}
+
+template <DataType Type>
+static PFN_NullDecodeTexel FindTexelDecoderForType(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::Alpha:    return DecodeTexel<Type, -1, -1, -1,  0>;
+        case ImageFormat::R:        return DecodeTexel<Type,  0, -1, -1, -1>;
+        case ImageFormat::RG:       return DecodeTexel<Type,  0,  1, -1, -1>;
+        case ImageFormat::RGB:      return DecodeTexel<Type,  0,  1,  2, -1>;
+        case ImageFormat::BGR:      return DecodeTexel<Type,  2,  1,  0, -1>;
+        case ImageFormat::RGBA:     return DecodeTexel<Type,  0,  1,  2,  3>;
+        case ImageFormat::BGRA:     return DecodeTexel<Type,  2,  1,  0,  3>;
+        case ImageFormat::ARGB:     return DecodeTexel<Type,  1,  2,  3,  0>;
+        case ImageFormat::ABGR:     return DecodeTexel<Type,  3,  2,  1,  0>;
+        case ImageFormat::Depth:    return DecodeTexel<Type,  0, -1, -1, -1>;
+        case ImageFormat::Stencil:  return DecodeTexel<Type,  0, -1, -1, -1>;
+        default:                    return nullptr;
+    }
+}
+
+#ifdef LLGL_NULL_SAMPLER_X86
+
+template <bool SwapRB>
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void DecodeTexelRGBA8UNormSSE2(const char* data, float outTexel[4])
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_cvtsi32_si128(LoadComponent<std::int32_t>(data));
+    v = _mm_unpacklo_epi8(v, zero);
+    v = _mm_unpacklo_epi16(v, zero);
+    if (SwapRB)
+        v = _mm_shuffle_epi32(v, _MM_SHUFFLE(3, 0, 1, 2));
+    _mm_storeu_ps(outTexel, _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(1.0f / 255.0f)));
+}
+
+#endif // /LLGL_NULL_SAMPLER_X86
+
+// Returns the texel decoder for the image format and data type of a texture, or null if the texels cannot be sampled, e.g. for compressed formats.
+static PFN_NullDecodeTexel FindTexelDecoder(const ImageFormat format, const DataType dataType)
+{
+    if (format == ImageFormat::DepthStencil)
+    {
+        switch (dataType)
+        {
+            case DataType::UInt32:  return DecodeTexelD24S8;
+            case DataType::Float32: return DecodeTexelD32S8X24;
+            default:                return nullptr;
+        }
+    }
+
+    #ifdef LLGL_NULL_SAMPLER_X86
+    if ((GetCPUFeatures() & CPUFeatureFlags::SSE2) != 0 && dataType == DataType::UInt8)
+    {
+        if (format == ImageFormat::RGBA)
+            return DecodeTexelRGBA8UNormSSE2<false>;
+        if (format == ImageFormat::BGRA)
+            return DecodeTexelRGBA8UNormSSE2<true>;
+    }
+    #endif
+
+    switch (dataType)
+    {
+        case DataType::Int8:    return FindTexelDecoderForType<DataType::Int8   >(format);
+        case DataType::UInt8:   return FindTexelDecoderForType<DataType::UInt8  >(format);
+        case DataType::Int16:   return FindTexelDecoderForType<DataType::Int16  >(format);
+        case DataType::UInt16:  return FindTexelDecoderForType<DataType::UInt16 >(format);
+        case DataType::Int32:   return FindTexelDecoderForType<DataType::Int32  >(format);
+        case DataType::UInt32:  return FindTexelDecoderForType<DataType::UInt32 >(format);
+        case DataType::Float16: return FindTexelDecoderForType<DataType::Float16>(format);
+        case DataType::Float32: return FindTexelDecoderForType<DataType::Float32>(format);
+        case DataType::Float64: return FindTexelDecoderForType<DataType::Float64>(format);
+        default:                return nullptr;
+    }
+}
+
+static float LinearizeSRGB(float value)
+{
+    return (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f));
+}
+
+
+/* ----- Filtering ----- */
+
+// Accumulates the weighted sum of the texels into 'accum'.
+typedef void (*PFN_NullFilterTexels)(const float (*texels)[4], const float* weights, std::uint32_t numTexels, float accum[4]);
+
+static void FilterTexels(const float (*texels)[4], const float* weights, std::uint32_t numTexels, float accum[4])
+{
+    for_range(i, numTexels)
+    {
+        for_range(c, 4)
+            accum[c] += texels[i][c] * weights[i];
+    }
+}
+
+#ifdef LLGL_NULL_SAMPLER_X86
+
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void FilterTexelsSSE2(const float (*texels)[4], const float* weights, std::uint32_t numTexels, float accum[4])
+{
+    __m128 sum = _mm_loadu_ps(accum);
+    for_range(i, numTexels)
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(texels[i]), _mm_set1_ps(weights[i])));
+    _mm_storeu_ps(accum, sum);
+}
+
+#endif // /LLGL_NULL_SAMPLER_X86
+
+// Level of detail for each lane of a sample quad. All attributes are stored as [component][lane].
+struct NullQuadFootprint
+{
+    float   lengthSq[4];        // Squared length of the major axis of the footprint in texels.
+    float   ratio[4];           // Ratio between the major and minor axis of the footprint; infinite if the minor axis is degenerated.
+    float   majorAxis[3][4];    // Major axis of the footprint in normalized coordinates.
+};
+
+/*
+Computes the footprint of each lane from the gradients scaled to the texture extent.
+The major axis is the longer one of the X and Y gradients, since the footprint is approximated by the parallelogram they span.
+*/
+static void ComputeQuadFootprint(const NullSampleQuad& quad, std::uint32_t numCoords, const float extent[3], NullQuadFootprint& outFootprint)
+{
+    for_range(lane, 4)
+    {
+        float lengthX = 0.0f, lengthY = 0.0f;
+        for_range(i, numCoords)
+        {
+            const float dx = quad.ddx[i][lane] * extent[i];
+            const float dy = quad.ddy[i][lane] * extent[i];
+            lengthX += dx*dx;
+            lengthY += dy*dy;
+        }
+
+        const bool          majorX  = (lengthX >= lengthY);
+        const float         major   = (majorX ? lengthX : lengthY);
+        const float         minor   = (majorX ? lengthY : lengthX);
+        const float (&axis)[3][4]   = (majorX ? quad.ddx : quad.ddy);
+
+        outFootprint.lengthSq[lane] = major;
+        outFootprint.ratio[lane]    = (minor > 0.0f ? std::sqrt(major / minor) : (major > 0.0f ? HUGE_VALF : 1.0f));
+        for_range(i, 3)
+            outFootprint.majorAxis[i][lane] = axis[i][lane];
+    }
+}
+
+#ifdef LLGL_NULL_SAMPLER_X86
+
+LLGL_TARGET_ATTRIBUTE("sse2")
+static void ComputeQuadFootprintSSE2(const NullSampleQuad& quad, std::uint32_t numCoords, const float extent[3], NullQuadFootprint& outFootprint)
+{
+    /* Compute squared gradient lengths of all four lanes at once */
+    __m128 lengthX = _mm_setzero_ps();
+    __m128 lengthY = _mm_setzero_ps();
+
+    for_range(i, numCoords)
+    {
+        const __m128 scale  = _mm_set1_ps(extent[i]);
+        const __m128 dx     = _mm_mul_ps(_mm_loadu_ps(quad.ddx[i]), scale);
+        const __m128 dy     = _mm_mul_ps(_mm_loadu_ps(quad.ddy[i]), scale);
+        lengthX = _mm_add_ps(lengthX, _mm_mul_ps(dx, dx));
+        lengthY = _mm_add_ps(lengthY, _mm_mul_ps(dy, dy));
+    }
+
+    const __m128 majorX = _mm_cmpge_ps(lengthX, lengthY);
+    const __m128 major  = _mm_max_ps(lengthX, lengthY);
+    const __m128 minor  = _mm_min_ps(lengthX, lengthY);
+
+    /* Degenerated minor axes result in an infinite ratio; a degenerated footprint has a ratio of 1 */
+    const __m128 zero       = _mm_setzero_ps();
+    const __m128 one        = _mm_set1_ps(1.0f);
+    const __m128 infinity   = _mm_set1_ps(HUGE_VALF);
+    const __m128 minorZero  = _mm_cmple_ps(minor, zero);
+    const __m128 majorZero  = _mm_cmple_ps(major, zero);
+    const __m128 safeMinor  = _mm_or_ps(_mm_and_ps(minorZero, one), _mm_andnot_ps(minorZero, minor));
+    __m128 ratio = _mm_sqrt_ps(_mm_div_ps(major, safeMinor));
+    ratio = _mm_or_ps(_mm_and_ps(minorZero, infinity), _mm_andnot_ps(minorZero, ratio));
+    ratio = _mm_or_ps(_mm_and_ps(majorZero, one), _mm_andnot_ps(majorZero, ratio));
+
+    _mm_storeu_ps(outFootprint.lengthSq, major);
+    _mm_storeu_ps(outFootprint.ratio, ratio);
+
+    for_range(i, 3)
+    {
+        const __m128 axis = _mm_or_ps(_mm_and_ps(majorX, _mm_loadu_ps(quad.ddx[i])), _mm_andnot_ps(majorX, _mm_loadu_ps(quad.ddy[i])));
+        _mm_storeu_ps(outFootprint.majorAxis[i], axis);
+    }
+}
+
+#endif // /LLGL_NULL_SAMPLER_X86
+
+
+/* ----- Addressing ----- */
+
+static std::int32_t PositiveModulo(std::int32_t x, std::int32_t n)
+{
+    const std::int32_t r = x % n;
+    return (r < 0 ? r + n : r);
+}
+
+// Applies the address mode to the texel coordinate. Returns false if the coordinate refers to the border color.
+static bool ApplyAddressMode(SamplerAddressMode mode, std::int32_t& coord, std::int32_t size)
+{
+    switch (mode)
+    {
+        case SamplerAddressMode::Repeat:
+        {
+            coord = PositiveModulo(coord, size);
+        }
+        break;
+
+        case SamplerAddressMode::Mirror:
+        {
+            const std::int32_t m = PositiveModulo(coord, size * 2);
+            coord = (m < size ? m : size * 2 - 1 - m);
+        }
+        break;
+
+        case SamplerAddressMode::Clamp:
+        {
+            coord = std::max(0, std::min(coord, size - 1));
+        }
+        break;
+
+        case SamplerAddressMode::Border:
+        {
+            if (coord < 0 || coord >= size)
+                return false;
+        }
+        break;
+
+        case SamplerAddressMode::MirrorOnce:
+        {
+            coord = std::min(coord < 0 ? -1 - coord : coord, size - 1);
+        }
+        break;
+    }
+    return true;
+}
+
+// Converts the coordinate to an integer, clamped to a range where texel coordinates cannot overflow.
+static std::int32_t FloorToInt(float x)
+{
+    return static_cast<std::int32_t>(std::floor(std::max(-16777216.0f, std::min(x, 16777216.0f))));
+}
+
+static bool CompareDepth(CompareOp compareOp, float ref, float depth)
+{
+    switch (compareOp)
+    {
+        case CompareOp::NeverPass:      return false;
+        case CompareOp::Less:           return (ref <  depth);
+        case CompareOp::Equal:          return (ref == depth);
+        case CompareOp::LessEqual:      return (ref <= depth);
+        case CompareOp::Greater:        return (ref >  depth);
+        case CompareOp::NotEqual:       return (ref != depth);
+        case CompareOp::GreaterEqual:   return (ref >= depth);
+        case CompareOp::AlwaysPass:     return true;
+    }
+    return false;
+}
+
+
+/* ----- Sampling ----- */
+
+// Sampler and texture state that is shared by all taps of a sample quad.
+struct NullSampleState
+{
+    const NullTexture*      texture         = nullptr;
+    std::uint32_t           baseLevel       = 0;
+    std::uint32_t           numLevels       = 1;
+    std::int32_t            baseLayer       = 0;
+    std::int32_t            numLayers       = 1;
+    std::uint32_t           numCoords       = 2;
+    SamplerAddressMode      addressModes[3] = {};
+    const float*            borderColor     = nullptr;
+    bool                    compare         = false;
+    CompareOp               compareOp       = CompareOp::LessEqual;
+    bool                    srgb            = false;
+    PFN_NullDecodeTexel     decode          = nullptr;
+    PFN_NullFilterTexels    filter          = nullptr;
+};
+
+// Reads the texel at the specified coordinates after applying the address modes. Depth comparisons are performed before filtering.
+static void FetchTexel(const NullSampleState& state, const NullSampledImage& image, std::int32_t (&pos)[3], float dref, float outTexel[4])
+{
+    bool isBorder = false;
+    for_range(i, state.numCoords)
+    {
+        if (!ApplyAddressMode(state.addressModes[i], pos[i], image.extent[i]))
+            isBorder = true;
+    }
+
+    if (isBorder)
+    {
+        for_range(c, 4)
+            outTexel[c] = state.borderColor[c];
+    }
+    else
+    {
+        state.decode(image.data + GetSampledTexelOffset(image, pos[0], pos[1], pos[2]), outTexel);
+        if (state.srgb)
+        {
+            for_range(c, 3)
+                outTexel[c] = LinearizeSRGB(outTexel[c]);
+        }
+    }
+
+    if (state.compare)
+        outTexel[0] = (CompareDepth(state.compareOp, dref, outTexel[0]) ? 1.0f : 0.0f);
+}
+
+/*
+Samples a single MIP-map level at the normalized coordinates and accumulates the result with the specified weight.
+Linear filtering blends 2, 4, or 8 texels for 1D, 2D, and 3D images respectively.
+*/
+static void SampleLevel(
+    const NullSampleState&  state,
+    std::uint32_t           level,
+    SamplerFilter           filter,
+    const float             (&coords)[3],
+    const std::int32_t      (&offset)[3],
+    std::int32_t            layer,
+    float                   dref,
+    float                   weight,
+    float                   accum[4])
+{
+    const NullSampledImage image = state.texture->GetSampledImage(state.baseLevel + level);
+    if (image.data == nullptr || image.bytesPerTexel == 0)
+        return;
+
+    const bool isLinear = (filter == SamplerFilter::Linear);
+
+    std::int32_t    base[3] = { 0, 0, 0 };
+    float           frac[3] = { 0.0f, 0.0f, 0.0f };
+
+    for_range(i, state.numCoords)
+    {
+        const float x = coords[i] * static_cast<float>(image.extent[i]) - (isLinear ? 0.5f : 0.0f);
+        base[i] = FloorToInt(x);
+        frac[i] = x - static_cast<float>(base[i]);
+        base[i] += offset[i];
+    }
+
+    /* Array layers are stored in the next coordinate after the spatial coordinates */
+    if (state.numCoords < 3)
+    {
+        layer = std::max(0, std::min(layer, state.numLayers - 1)) + state.baseLayer;
+        base[state.numCoords] = std::max(0, std::min(layer, image.extent[state.numCoords] - 1));
+    }
+
+    float           texels[8][4];
+    float           weights[8];
+    const std::uint32_t numTexels = (isLinear ? (1u << state.numCoords) : 1u);
+
+    for_range(texel, numTexels)
+    {
+        std::int32_t pos[3] = { base[0], base[1], base[2] };
+        weights[texel] = weight;
+
+        if (isLinear)
+        {
+            for_range(i, state.numCoords)
+            {
+                if ((texel & (1u << i)) != 0)
+                {
+                    ++pos[i];
+                    weights[texel] *= frac[i];
+                }
+                else
+                    weights[texel] *= 1.0f - frac[i];
+            }
+        }
+
+        FetchTexel(state, image, pos, dref, texels[texel]);
+    }
+
+    state.filter(texels, weights, numTexels, accum);
+}
+
+// Samples the MIP-map levels that are selected by the level of detail and accumulates the result with the specified weight.
+static void SampleMipLevels(
+    const NullSampleState&      state,
+    const SamplerDescriptor&    desc,
+    float                       lambda,
+    const float                 (&coords)[3],
+    const std::int32_t          (&offset)[3],
+    std::int32_t                layer,
+    float                       dref,
+    float                       weight,
+    float                       accum[4])
+{
+    /* Textures are magnified if the level of detail is less than or equal to zero */
+    const SamplerFilter filter = (lambda <= 0.0f ? desc.magFilter : desc.minFilter);
+
+    if (!desc.mipMapEnabled || state.numLevels <= 1)
+    {
+        SampleLevel(state, 0, filter, coords, offset, layer, dref, weight, accum);
+        return;
+    }
+
+    const float maxLevel    = static_cast<float>(state.numLevels - 1);
+    const float d           = std::max(0.0f, std::min(lambda, maxLevel));
+
+    if (desc.mipMapFilter == SamplerFilter::Nearest)
+    {
+        const std::uint32_t level = (d <= 0.5f ? 0u : static_cast<std::uint32_t>(std::ceil(d + 0.5f)) - 1u);
+        SampleLevel(state, level, filter, coords, offset, layer, dref, weight, accum);
+    }
+    else
+    {
+        const float         levelFloor  = std::floor(d);
+        const std::uint32_t level       = static_cast<std::uint32_t>(levelFloor);
+        const float         levelFrac   = d - levelFloor;
+
+        SampleLevel(state, level, filter, coords, offset, layer, dref, weight * (1.0f - levelFrac), accum);
+        if (levelFrac > 0.0f)
+            SampleLevel(state, level + 1, filter, coords, offset, layer, dref, weight * levelFrac, accum);
+    }
+}
+
+void NullSampler::SampleQuad(const NullTextureView& textureView, const NullSampleQuad& quad, float outTexels[4][4]) const
+{
+    for_range(lane, 4)
+    {
+        for_range(c, 4)
+            outTexels[lane][c] = 0.0f;
+    }
+
+    /* Resolve sampler and texture view state */
+    const NullTexture& texture = *textureView.texture;
+    const Image& baseImage = texture.GetMipImage(textureView.baseMipLevel);
+
+    NullSampleState state;
+    {
+        state.texture           = &texture;
+        state.baseLevel         = textureView.baseMipLevel;
+        state.numLevels         = textureView.numMipLevels;
+        state.baseLayer         = static_cast<std::int32_t>(textureView.baseArrayLayer);
+        state.numLayers         = static_cast<std::int32_t>(textureView.numArrayLayers);
+        state.numCoords         = std::max(1u, std::min(quad.numCoords, 3u));
+        state.addressModes[0]   = (quad.isCube ? SamplerAddressMode::Clamp : desc.addressModeU);
+        state.addressModes[1]   = (quad.isCube ? SamplerAddressMode::Clamp : desc.addressModeV);
+        state.addressModes[2]   = (quad.isCube ? SamplerAddressMode::Clamp : desc.addressModeW);
+        state.borderColor       = desc.borderColor;
+        state.compare           = quad.compare;
+        state.compareOp         = (desc.compareEnabled ? desc.compareOp : CompareOp::LessEqual);
+        state.srgb              = textureView.sRGB;
+        state.decode            = FindTexelDecoder(textureView.format, textureView.dataType);
+        state.filter            = FilterTexels;
+    }
+
+    if (state.decode == nullptr)
+        return;
+
+    const Extent3D& baseExtent = baseImage.GetExtent();
+    const float extent[3] =
+    {
+        static_cast<float>(baseExtent.width),
+        static_cast<float>(baseExtent.height),
+        static_cast<float>(baseExtent.depth),
+    };
+
+    /* Compute footprints of all lanes at once */
+    NullQuadFootprint footprint;
+
+    #ifdef LLGL_NULL_SAMPLER_X86
+    if ((GetCPUFeatures() & CPUFeatureFlags::SSE2) != 0)
+    {
+        state.filter = FilterTexelsSSE2;
+        if (!quad.explicitLod)
+            ComputeQuadFootprintSSE2(quad, state.numCoords, extent, footprint);
+    }
+    else
+    #endif
+    {
+        if (!quad.explicitLod)
+            ComputeQuadFootprint(quad, state.numCoords, extent, footprint);
+    }
+
+    for_range(lane, 4)
+    {
+        if ((quad.mask & (1u << lane)) == 0)
+            continue;
+
+        /* Select level of detail and number of anisotropic taps along the major axis of the footprint */
+        float           lambda  = quad.lod[lane];
+        std::uint32_t   numTaps = 1;
+
+        if (!quad.explicitLod)
+        {
+            const float ratio = footprint.ratio[lane];
+            if (maxAnisotropy_ > 1 && ratio > 1.0f)
+                numTaps = (ratio < static_cast<float>(maxAnisotropy_) ? static_cast<std::uint32_t>(std::ceil(ratio)) : maxAnisotropy_);
+
+            /* Implicit level of detail is relative to the minor axis for anisotropic filtering; 'lod' is the bias */
+            lambda += 0.5f * std::log2(footprint.lengthSq[lane]) - std::log2(static_cast<float>(numTaps));
+        }
+
+        lambda += desc.mipMapLODBias;
+        lambda = std::max(std::max(desc.minLOD, quad.minLod[lane]), std::min(lambda, desc.maxLOD));
+
+        float coords[3] = { quad.coords[0][lane], quad.coords[1][lane], quad.coords[2][lane] };
+        const std::int32_t offset[3] = { quad.offset[0][lane], quad.offset[1][lane], quad.offset[2][lane] };
+
+        /* Distribute taps evenly along the major axis */
+        const float tapWeight = 1.0f / static_cast<float>(numTaps);
+
+        for_range(tap, numTaps)
+        {
+            if (numTaps > 1)
+            {
+                const float t = (static_cast<float>(tap) + 0.5f) * tapWeight - 0.5f;
+                for_range(i, state.numCoords)
+                    coords[i] = quad.coords[i][lane] + footprint.majorAxis[i][lane] * t;
+            }
+            SampleMipLevels(state, desc, lambda, coords, offset, quad.layer[lane], quad.dref[lane], tapWeight, outTexels[lane]);
+        }
+
+        /* Depth comparisons only return the filtered result in the first component */
+        if (quad.compare)
+        {
+            outTexels[lane][1] = 0.0f;
+            outTexels[lane][2] = 0.0f;
+            outTexels[lane][3] = 1.0f;
+        }
+    }
+}
+
+
 } // /namespace LLGL
 
 
@@ -10,13 +10,38 @@
 
 
 #include <LLGL/Sampler.h>
+#include <LLGL/SamplerFlags.h>
 #include <string>
+#include <cstdint>
 
 
 namespace LLGL
 {
 
 
+struct NullTextureView;
+
+/*
+Sample locations of a 2x2 quad of lanes. All attributes are stored as [component][lane], so they can be processed for all lanes at once.
+Lanes are ordered (x, y), (x + 1, y), (x, y + 1), (x + 1, y + 1) like fragment quads.
+*/
+struct NullSampleQuad
+{
+    std::uint32_t   mask            = 0;        // Bit mask of active lanes.
+    std::uint32_t   numCoords       = 2;        // Number of spatial coordinates: 1 for 1D, 2 for 2D and cube faces, and 3 for 3D textures.
+    bool            isCube          = false;    // Cube faces are always clamped to their edges.
+    bool            explicitLod     = false;    // Level of detail is specified by 'lod' instead of the gradients.
+    bool            compare         = false;    // Texels are compared against 'dref' before they are filtered.
+    float           coords[3][4]    = {};       // Normalized texture coordinates.
+    float           ddx[3][4]       = {};       // Gradients of the normalized texture coordinates in X and Y direction.
+    float           ddy[3][4]       = {};
+    std::int32_t    offset[3][4]    = {};       // Texel offsets.
+    std::int32_t    layer[4]        = {};       // Array layer, which is stored in the image height for 1D textures and the image depth otherwise.
+    float           lod[4]          = {};       // Explicit level of detail or bias for implicit level of detail.
+    float           minLod[4]       = { -1000.0f, -1000.0f, -1000.0f, -1000.0f };   // Minimum level of detail in addition to SamplerDescriptor::minLOD.
+    float           dref[4]         = {};       // Reference values for depth comparison.
+};
+
 class NullSampler final : public Sampler
 {
 
@@ -32,13 +57,20 @@ class NullSampler final : public Sampler
 
         NullSampler(const SamplerDescriptor& desc);
 
+        /*
+        Samples the texture view for all active lanes of the quad and writes the filtered RGBA values into 'outTexels' as [lane][component].
+        With depth comparison, the filtered results of the comparisons are written into the first component. The swizzle of the texture view is not applied.
+        */
+        void SampleQuad(const NullTextureView& textureView, const NullSampleQuad& quad, float outTexels[4][4]) const;
+
     public:
 
         const SamplerDescriptor desc;
 
     private:
 
-        std::string label_;
+        std::string     label_;
+        std::uint32_t   maxAnisotropy_  = 1;
 
 };
 
@@ -7,9 +7,12 @@
 
 #include "NullTexture.h"
 #include "../../TextureUtils.h"
+#include "../../../Core/Threading.h"
 #include <LLGL/TextureFlags.h>
 #include <LLGL/Utils/ForRange.h>
 #include <algorithm>
+#include <string.h>
+#include <limits.h>
 
 
 namespace LLGL
@@ -23,16 +26,18 @@ static TextureDescriptor MakeNullTextureDesc(const TextureDescriptor& inDesc)
     return outDesc;
 }
 
-NullTexture::NullTexture(const TextureDescriptor& desc, const ImageView* initialImage) :
+NullTexture::NullTexture(const TextureDescriptor& desc, const ImageView* initialImage, bool tiledLayout) :
     Texture       { desc.type, desc.bindFlags },
     desc          { MakeNullTextureDesc(desc) },
-    extent_       { LLGL::GetMipExtent(desc)  }
+    extent_       { LLGL::GetMipExtent(desc)  },
+    tiledLayout_  { tiledLayout               }
 {
     AllocImages();
 
     if (initialImage != nullptr)
     {
-        Write(TextureRegion{ Offset3D{}, extent_ }, *initialImage);
+        /* Initial image covers all array layers of the first MIP-map */
+        Write(TextureRegion{ TextureSubresource{ 0, desc.arrayLayers, 0, 1 }, Offset3D{}, desc.extent }, *initialImage);
         if ((desc.miscFlags & MiscFlags::GenerateMips) != 0)
             GenerateMips();
     }
@@ -84,6 +89,7 @@ void NullTexture::Write(const TextureRegion& textureRegion, const ImageView& src
     if (textureRegion.subresource.baseMipLevel < images_.size() && textureRegion.subresource.numMipLevels == 1)
     {
         /* Write pixels to selected destination MIP-map image */
+        InvalidateTiledImages();
         Image& mipMap = images_[textureRegion.subresource.baseMipLevel];
         const Offset3D offset = CalcTextureOffset(GetType(), textureRegion.offset, textureRegion.subresource.baseArrayLayer);
         const Extent3D extent = CalcTextureExtent(GetType(), textureRegion.extent, textureRegion.subresource.numArrayLayers);
@@ -103,20 +109,373 @@ void NullTexture::Read(const TextureRegion& textureRegion, const MutableImageVie
     }
 }
 
+// Linear memory of an image region with strides in bytes, starting at the first pixel of the region.
+struct NullImageRegion
+{
+    char*           data        = nullptr;
+    std::uint32_t   rowStride   = 0;
+    std::uint32_t   layerStride = 0;
+};
+
+// Minimum number of bytes that is copied per worker thread.
+static constexpr std::size_t g_minConcurrentCopySize = 64 * 1024;
+
+// Returns the region of the specified MIP-map image or false if it is out of bounds.
+static bool GetImageRegion(const Image& image, const Offset3D& offset, const Extent3D& extent, NullImageRegion& outRegion)
+{
+    if (!image.IsRegionInside(offset, extent))
+        return false;
+
+    const std::size_t bpp = image.GetBytesPerPixel();
+    const std::size_t x   = static_cast<std::size_t>(offset.x);
+    const std::size_t y   = static_cast<std::size_t>(offset.y);
+    const std::size_t z   = static_cast<std::size_t>(offset.z);
+
+    outRegion.rowStride     = image.GetRowStride();
+    outRegion.layerStride   = image.GetDepthStride();
+    outRegion.data          = static_cast<char*>(const_cast<void*>(image.GetData())) + z * outRegion.layerStride + y * outRegion.rowStride + x * bpp;
+
+    return true;
+}
+
+// Returns the region of the specified linear memory or false if the strides are invalid or the region exceeds the memory.
+static bool GetMemoryRegion(void* data, std::size_t dataSize, std::uint32_t bpp, const Extent3D& extent, std::uint32_t rowStride, std::uint32_t layerStride, NullImageRegion& outRegion)
+{
+    const std::uint32_t rowSize = bpp * extent.width;
+
+    outRegion.data          = static_cast<char*>(data);
+    outRegion.rowStride     = (rowStride != 0 ? rowStride : rowSize);
+    outRegion.layerStride   = (layerStride != 0 ? layerStride : outRegion.rowStride * extent.height);
+
+    if (outRegion.rowStride < rowSize || outRegion.layerStride < outRegion.rowStride * extent.height)
+        return false;
+
+    const std::size_t requiredSize =
+    (
+        static_cast<std::size_t>(extent.depth - 1) * outRegion.layerStride +
+        static_cast<std::size_t>(extent.height - 1) * outRegion.rowStride +
+        rowSize
+    );
+
+    return (requiredSize <= dataSize);
+}
+
+// Copies rows of an image region, which are enumerated across all layers, by as few calls to CopyImageBufferRegion as possible.
+static void CopyImageRegionRows(
+    ImageFormat             format,
+    DataType                dataType,
+    std::uint32_t           bpp,
+    const NullImageRegion&  dst,
+    const NullImageRegion&  src,
+    const Extent3D&         extent,
+    std::size_t             firstRow,
+    std::size_t             numRows)
+{
+    /* Copy each row separately if the strides cannot be expressed in pixels */
+    const bool isStrideAligned =
+    (
+        dst.rowStride   % bpp == 0 &&
+        dst.layerStride % bpp == 0 &&
+        src.rowStride   % bpp == 0 &&
+        src.layerStride % bpp == 0
+    );
+
+    const std::size_t rowSize = static_cast<std::size_t>(bpp) * extent.width;
+
+    while (numRows > 0)
+    {
+        /* Copy rows up to the end of the current layer at once */
+        const std::size_t   y           = firstRow % extent.height;
+        const std::size_t   z           = firstRow / extent.height;
+        const std::size_t   numCopyRows = (isStrideAligned ? std::min<std::size_t>(numRows, extent.height - y) : 1u);
+        const std::size_t   dstPos      = z * dst.layerStride + y * dst.rowStride;
+        const std::size_t   srcPos      = z * src.layerStride + y * src.rowStride;
+
+        CopyImageBufferRegion(
+            MutableImageView{ format, dataType, dst.data + dstPos, (numCopyRows - 1) * dst.rowStride + rowSize },
+            Offset3D{},
+            dst.rowStride / bpp,
+            dst.layerStride / bpp,
+            ImageView{ format, dataType, src.data + srcPos, (numCopyRows - 1) * src.rowStride + rowSize },
+            Offset3D{},
+            src.rowStride / bpp,
+            src.layerStride / bpp,
+            Extent3D{ extent.width, static_cast<std::uint32_t>(numCopyRows), 1u }
+        );
+
+        firstRow    += numCopyRows;
+        numRows     -= numCopyRows;
+    }
+}
+
+// Copies an image region between two memory regions of the same format. Large regions are distributed across worker threads.
+static void CopyImageRegion(
+    ImageFormat             format,
+    DataType                dataType,
+    const NullImageRegion&  dst,
+    const NullImageRegion&  src,
+    const Extent3D&         extent,
+    bool                    isSameImage = false)
+{
+    const std::uint32_t bpp     = static_cast<std::uint32_t>(GetMemoryFootprint(format, dataType, 1));
+    const std::size_t   rowSize = static_cast<std::size_t>(bpp) * extent.width;
+    const std::size_t   numRows = static_cast<std::size_t>(extent.height) * extent.depth;
+
+    if (bpp == 0 || numRows == 0 || extent.width == 0)
+        return;
+
+    if (isSameImage)
+    {
+        /* Copy within the same image with a single call, so overlapping regions are handled by the copy itself */
+        const std::size_t regionSize = (extent.depth - 1) * static_cast<std::size_t>(dst.layerStride) + (extent.height - 1) * static_cast<std::size_t>(dst.rowStride) + rowSize;
+        CopyImageBufferRegion(
+            MutableImageView{ format, dataType, dst.data, regionSize },
+            Offset3D{},
+            dst.rowStride / bpp,
+            dst.layerStride / bpp,
+            ImageView{ format, dataType, src.data, regionSize },
+            Offset3D{},
+            src.rowStride / bpp,
+            src.layerStride / bpp,
+            extent
+        );
+        return;
+    }
+
+    if (rowSize * numRows < g_minConcurrentCopySize * 2)
+    {
+        CopyImageRegionRows(format, dataType, bpp, dst, src, extent, 0, numRows);
+        return;
+    }
+
+    const std::size_t minRowsPerThread = std::max<std::size_t>(1u, g_minConcurrentCopySize / rowSize);
+    DoConcurrentRange(
+        [format, dataType, bpp, &dst, &src, &extent](std::size_t begin, std::size_t end)
+        {
+            CopyImageRegionRows(format, dataType, bpp, dst, src, extent, begin, end - begin);
+        },
+        numRows,
+        LLGL_MAX_THREAD_COUNT,
+        static_cast<unsigned>(std::min<std::size_t>(minRowsPerThread, UINT_MAX))
+    );
+}
+
+void NullTexture::CopyToMemory(
+    const TextureLocation&  location,
+    const Extent3D&         extent,
+    void*                   data,
+    std::size_t             dataSize,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride) const
+{
+    if (location.mipLevel >= images_.size() || data == nullptr)
+        return;
+
+    const Image& mipMap = images_[location.mipLevel];
+    const Offset3D offset = CalcTextureOffset(GetType(), location.offset, location.arrayLayer);
+
+    NullImageRegion srcRegion, dstRegion;
+    if (GetImageRegion(mipMap, offset, extent, srcRegion) &&
+        GetMemoryRegion(data, dataSize, mipMap.GetBytesPerPixel(), extent, rowStride, layerStride, dstRegion))
+    {
+        CopyImageRegion(mipMap.GetFormat(), mipMap.GetDataType(), dstRegion, srcRegion, extent);
+    }
+}
+
+void NullTexture::CopyFromMemory(
+    const TextureLocation&  location,
+    const Extent3D&         extent,
+    const void*             data,
+    std::size_t             dataSize,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride)
+{
+    if (location.mipLevel >= images_.size() || data == nullptr)
+        return;
+
+    InvalidateTiledImages();
+
+    const Image& mipMap = images_[location.mipLevel];
+    const Offset3D offset = CalcTextureOffset(GetType(), location.offset, location.arrayLayer);
+
+    /* Source memory is only read from */
+    NullImageRegion srcRegion, dstRegion;
+    if (GetImageRegion(mipMap, offset, extent, dstRegion) &&
+        GetMemoryRegion(const_cast<void*>(data), dataSize, mipMap.GetBytesPerPixel(), extent, rowStride, layerStride, srcRegion))
+    {
+        CopyImageRegion(mipMap.GetFormat(), mipMap.GetDataType(), dstRegion, srcRegion, extent);
+    }
+}
+
+void NullTexture::CopyFromTexture(const TextureLocation& dstLocation, const NullTexture& srcTexture, const TextureLocation& srcLocation, const Extent3D& extent)
+{
+    if (dstLocation.mipLevel >= images_.size() || srcLocation.mipLevel >= srcTexture.images_.size())
+        return;
+
+    InvalidateTiledImages();
+
+    const Image& dstMipMap = images_[dstLocation.mipLevel];
+    const Image& srcMipMap = srcTexture.images_[srcLocation.mipLevel];
+
+    if (dstMipMap.GetFormat() != srcMipMap.GetFormat() || dstMipMap.GetDataType() != srcMipMap.GetDataType())
+        return;
+
+    const Offset3D dstOffset = CalcTextureOffset(GetType(), dstLocation.offset, dstLocation.arrayLayer);
+    const Offset3D srcOffset = CalcTextureOffset(srcTexture.GetType(), srcLocation.offset, srcLocation.arrayLayer);
+
+    NullImageRegion srcRegion, dstRegion;
+    if (GetImageRegion(dstMipMap, dstOffset, extent, dstRegion) &&
+        GetImageRegion(srcMipMap, srcOffset, extent, srcRegion))
+    {
+        CopyImageRegion(dstMipMap.GetFormat(), dstMipMap.GetDataType(), dstRegion, srcRegion, extent, (&dstMipMap == &srcMipMap));
+    }
+}
+
 void NullTexture::GenerateMips(const TextureSubresource* subresource)
 {
-    //todo
+    const TextureType   type            = GetType();
+    const std::uint32_t baseMipLevel    = (subresource != nullptr ? subresource->baseMipLevel : 0u);
+    const std::uint32_t numMipLevels    = (subresource != nullptr ? subresource->numMipLevels : desc.mipLevels);
+    const std::uint32_t mipLevelEnd     = std::min(baseMipLevel + numMipLevels, desc.mipLevels);
+
+    /* Array layers of 1D array textures are stored in the image height, all others in the image depth */
+    const bool          is1DArray       = (type == TextureType::Texture1DArray);
+    const std::uint32_t numLayers       = (is1DArray ? extent_.height : (type == TextureType::Texture3D ? 1u : extent_.depth));
+    const std::uint32_t baseArrayLayer  = (subresource != nullptr ? std::min(subresource->baseArrayLayer, numLayers) : 0u);
+    const std::uint32_t numArrayLayers  = (subresource != nullptr ? std::min(subresource->numArrayLayers, numLayers - baseArrayLayer) : numLayers);
+
+    InvalidateTiledImages();
+
+    MipChainDescriptor mipChainDesc;
+    {
+        mipChainDesc.numMipLevels       = 1;
+        mipChainDesc.sRGB               = ((GetFormatAttribs(desc.format).flags & FormatFlags::IsColorSpace_sRGB) != 0);
+        mipChainDesc.downsampleDepth    = (type == TextureType::Texture3D);
+    }
+
+    for (std::uint32_t mipLevel = baseMipLevel + 1; mipLevel < mipLevelEnd; ++mipLevel)
+    {
+        const Image& prevMipMap = images_[mipLevel - 1];
+        Image& mipMap = images_[mipLevel];
+
+        /* Generate next MIP-map from its predecessor; 1D array layers are moved into the depth to not downsample them */
+        DynamicVector<Image> nextMipMaps;
+        if (is1DArray)
+        {
+            const Extent3D& prevExtent = prevMipMap.GetExtent();
+            Image layeredMipMap{ Extent3D{ prevExtent.width, 1, prevExtent.height }, prevMipMap.GetFormat(), prevMipMap.GetDataType() };
+            ::memcpy(layeredMipMap.GetData(), prevMipMap.GetData(), prevMipMap.GetDataSize());
+            nextMipMaps = layeredMipMap.GenerateMipChain(mipChainDesc);
+        }
+        else
+            nextMipMaps = prevMipMap.GenerateMipChain(mipChainDesc);
+
+        if (nextMipMaps.empty() || nextMipMaps.front().GetDataSize() != mipMap.GetDataSize())
+            break;
+
+        /* Copy selected array layers into the MIP-map, each of which is stored contiguously */
+        const Image&        nextMipMap  = nextMipMaps.front();
+        const std::size_t   layerSize   = mipMap.GetDataSize() / numLayers;
+        const std::size_t   layerOffset = layerSize * baseArrayLayer;
+
+        ::memcpy(
+            static_cast<char*>(mipMap.GetData()) + layerOffset,
+            static_cast<const char*>(nextMipMap.GetData()) + layerOffset,
+            layerSize * numArrayLayers
+        );
+    }
+}
+
+// Returns the number of bits that are required to store any value in the range [0, n), i.e. the logarithm of n rounded up.
+static std::uint32_t Log2Uint(std::uint32_t n)
+{
+    std::uint32_t bits = 0;
+    while ((1u << bits) < n)
+        ++bits;
+    return bits;
+}
+
+NullSampledImage NullTexture::GetSampledImage(std::uint32_t mipLevel) const
+{
+    const Image& mipMap = images_[ClampMipLevel(mipLevel)];
+    const Extent3D& extent = mipMap.GetExtent();
+
+    NullSampledImage sampledImage;
+    {
+        sampledImage.data           = static_cast<const char*>(mipMap.GetData());
+        sampledImage.extent[0]      = static_cast<std::int32_t>(extent.width);
+        sampledImage.extent[1]      = static_cast<std::int32_t>(extent.height);
+        sampledImage.extent[2]      = static_cast<std::int32_t>(extent.depth);
+        sampledImage.bytesPerTexel  = mipMap.GetBytesPerPixel();
+        sampledImage.sliceStride    = mipMap.GetDepthStride();
+        sampledImage.rowStride      = mipMap.GetRowStride();
+    }
+
+    if (tiledLayout_ && sampledImage.bytesPerTexel > 0)
+    {
+        if (tiledRevision_.load(std::memory_order_acquire) != revision_.load(std::memory_order_acquire))
+            UpdateTiledImages();
+
+        const std::vector<char>& tiledImage = tiledImages_[ClampMipLevel(mipLevel)];
+        sampledImage.data           = tiledImage.data();
+        sampledImage.tiled          = true;
+        sampledImage.mortonBits[0]  = Log2Uint(extent.width);
+        sampledImage.mortonBits[1]  = Log2Uint(extent.height);
+        sampledImage.sliceStride    = (static_cast<std::size_t>(sampledImage.bytesPerTexel) << (sampledImage.mortonBits[0] + sampledImage.mortonBits[1]));
+    }
+
+    return sampledImage;
+}
+
+NullTextureView NullTexture::MakeView(const TextureViewDescriptor& textureViewDesc)
+{
+    const FormatAttributes& formatAttribs = GetFormatAttribs(desc.format);
+
+    NullTextureView view;
+    {
+        view.texture        = this;
+        view.numMipLevels   = GetNumMipLevels();
+        view.numArrayLayers = std::max(1u, desc.arrayLayers);
+        view.format         = formatAttribs.format;
+        view.dataType       = formatAttribs.dataType;
+        view.sRGB           = ((formatAttribs.flags & FormatFlags::IsColorSpace_sRGB) != 0);
+    }
+
+    if (IsTextureViewEnabled(textureViewDesc))
+    {
+        const TextureSubresource& subresource = textureViewDesc.subresource;
+
+        view.baseMipLevel   = std::min(subresource.baseMipLevel, view.numMipLevels - 1);
+        view.numMipLevels   = std::min(subresource.numMipLevels, view.numMipLevels - view.baseMipLevel);
+        view.baseArrayLayer = std::min(subresource.baseArrayLayer, view.numArrayLayers - 1);
+        view.numArrayLayers = std::min(subresource.numArrayLayers, view.numArrayLayers - view.baseArrayLayer);
+        view.swizzle        = textureViewDesc.swizzle;
+
+        /* Texels can only be reinterpreted with uncompressed formats of the same size */
+        const FormatAttributes& viewFormatAttribs = GetFormatAttribs(textureViewDesc.format);
+        const long invalidFlags = (FormatFlags::HasDepth | FormatFlags::HasStencil | FormatFlags::IsCompressed | FormatFlags::IsPacked);
+        if (viewFormatAttribs.bitSize == formatAttribs.bitSize &&
+            (viewFormatAttribs.flags & invalidFlags) == 0 &&
+            (formatAttribs.flags & invalidFlags) == 0)
+        {
+            view.format     = viewFormatAttribs.format;
+            view.dataType   = viewFormatAttribs.dataType;
+            view.sRGB       = ((viewFormatAttribs.flags & FormatFlags::IsColorSpace_sRGB) != 0);
+        }
+    }
+
+    return view;
 }
 
 std::uint32_t NullTexture::PackSubresourceIndex(std::uint32_t mipLevel, std::uint32_t arrayLayer) const
 {
-    return (mipLevel * desc.mipLevels + arrayLayer);
+    return (mipLevel * desc.arrayLayers + arrayLayer);
 }
 
 void NullTexture::UnpackSubresourceIndex(std::uint32_t subresource, std::uint32_t& outMipLevel, std::uint32_t& outArrayLayer) const
 {
-    outMipLevel     = subresource / desc.mipLevels;
-    outArrayLayer   = subresource % desc.mipLevels;
+    outMipLevel     = subresource / desc.arrayLayers;
+    outArrayLayer   = subresource % desc.arrayLayers;
 }
 
 
@@ -136,6 +495,54 @@ void NullTexture::AllocImages()
 }
 
 
+void NullTexture::UpdateTiledImages() const
+{
+    std::lock_guard<std::mutex> guard{ tiledMutex_ };
+
+    /* Another thread might have updated the tiled images in the meantime */
+    const std::uint64_t revision = revision_.load(std::memory_order_acquire);
+    if (tiledRevision_.load(std::memory_order_relaxed) == revision)
+        return;
+
+    tiledImages_.resize(images_.size());
+
+    for_range(mipLevel, images_.size())
+    {
+        const Image&        mipMap      = images_[mipLevel];
+        const Extent3D&     extent      = mipMap.GetExtent();
+        const std::size_t   bpp         = mipMap.GetBytesPerPixel();
+        const std::uint32_t bitsX       = Log2Uint(extent.width);
+        const std::uint32_t bitsY       = Log2Uint(extent.height);
+        const std::size_t   sliceStride = (bpp << (bitsX + bitsY));
+        const char*         src         = static_cast<const char*>(mipMap.GetData());
+
+        std::vector<char>& tiledImage = tiledImages_[mipLevel];
+        tiledImage.resize(sliceStride * extent.depth);
+        char* dst = tiledImage.data();
+
+        /* Reorder each row of texels concurrently */
+        DoConcurrentRange(
+            [&extent, bpp, bitsX, bitsY, sliceStride, src, dst](std::size_t begin, std::size_t end)
+            {
+                for_subrange(row, begin, end)
+                {
+                    const std::uint32_t y = static_cast<std::uint32_t>(row % extent.height);
+                    const std::size_t   z = row / extent.height;
+                    const char* srcRow = src + row * extent.width * bpp;
+                    for_range(x, extent.width)
+                        ::memcpy(dst + z * sliceStride + GetMortonIndex(x, y, bitsX, bitsY) * bpp, srcRow + x * bpp, bpp);
+                }
+            },
+            static_cast<std::size_t>(extent.height) * extent.depth,
+            LLGL_MAX_THREAD_COUNT,
+            64
+        );
+    }
+
+    tiledRevision_.store(revision, std::memory_order_release);
+}
+
+
 } // /namespace LLGL
 
 
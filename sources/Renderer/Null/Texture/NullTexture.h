@@ -13,12 +13,78 @@
 #include <LLGL/Utils/Image.h>
 #include <string>
 #include <vector>
+#include <atomic>
+#include <mutex>
 
 
 namespace LLGL
 {
 
 
+// Texel memory of a MIP-map level for sampling. Texels are either stored in linear order or in Morton order within each slice of the image depth.
+struct NullSampledImage
+{
+    const char*     data            = nullptr;
+    std::int32_t    extent[3]       = { 0, 0, 0 };
+    std::uint32_t   bytesPerTexel   = 0;
+    bool            tiled           = false;
+    std::uint32_t   mortonBits[2]   = { 0, 0 };     // Number of bits of the X and Y coordinates that are interleaved in Morton order.
+    std::size_t     sliceStride     = 0;            // Size (in bytes) of each slice.
+    std::size_t     rowStride       = 0;            // Size (in bytes) of each row; only used for linear order.
+};
+
+// Spreads the lower 16 bits of the specified value to every other bit, i.e. 0b1011 becomes 0b1000101.
+inline std::uint32_t SpreadMortonBits(std::uint32_t value)
+{
+    value &= 0x0000FFFFu;
+    value = (value | (value << 8)) & 0x00FF00FFu;
+    value = (value | (value << 4)) & 0x0F0F0F0Fu;
+    value = (value | (value << 2)) & 0x33333333u;
+    value = (value | (value << 1)) & 0x55555555u;
+    return value;
+}
+
+/*
+Returns the Morton index of the specified coordinates with 'bitsX' and 'bitsY' bits.
+The common lower bits are interleaved and the remaining upper bits of the larger dimension are appended.
+*/
+inline std::uint32_t GetMortonIndex(std::uint32_t x, std::uint32_t y, std::uint32_t bitsX, std::uint32_t bitsY)
+{
+    const std::uint32_t commonBits  = (bitsX < bitsY ? bitsX : bitsY);
+    const std::uint32_t commonMask  = (1u << commonBits) - 1u;
+    return (SpreadMortonBits(x & commonMask) | (SpreadMortonBits(y & commonMask) << 1) | (((x | y) >> commonBits) << (commonBits * 2)));
+}
+
+// Returns the byte offset of the specified texel, which must be inside the image.
+inline std::size_t GetSampledTexelOffset(const NullSampledImage& image, std::int32_t x, std::int32_t y, std::int32_t z)
+{
+    if (image.tiled)
+    {
+        const std::uint32_t index = GetMortonIndex(static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y), image.mortonBits[0], image.mortonBits[1]);
+        return (static_cast<std::size_t>(z) * image.sliceStride + static_cast<std::size_t>(index) * image.bytesPerTexel);
+    }
+    return (static_cast<std::size_t>(z) * image.sliceStride + static_cast<std::size_t>(y) * image.rowStride + static_cast<std::size_t>(x) * image.bytesPerTexel);
+}
+
+class NullTexture;
+
+/*
+Shader view of a texture with a range of MIP-map levels and array layers, and the format and swizzle its texels are read with.
+Texels are reinterpreted in the view format if it has the same size per texel as the texture format.
+*/
+struct NullTextureView
+{
+    NullTexture*        texture         = nullptr;
+    std::uint32_t       baseMipLevel    = 0;
+    std::uint32_t       numMipLevels    = 1;
+    std::uint32_t       baseArrayLayer  = 0;    // First array layer, which is stored in the image height for 1D array textures and in the image depth otherwise.
+    std::uint32_t       numArrayLayers  = 1;
+    ImageFormat         format          = ImageFormat::RGBA;
+    DataType            dataType        = DataType::UInt8;
+    bool                sRGB            = false;
+    TextureSwizzleRGBA  swizzle;
+};
+
 class NullTexture final : public Texture
 {
 
@@ -32,7 +98,8 @@ class NullTexture final : public Texture
 
     public:
 
-        NullTexture(const TextureDescriptor& desc, const ImageView* initialImage = nullptr);
+        // Initializes the texture with an optional initial image. If 'tiledLayout' is true, texels are sampled from a copy in Morton order.
+        NullTexture(const TextureDescriptor& desc, const ImageView* initialImage = nullptr, bool tiledLayout = false);
 
         // Returns the MIP-map level clamped to the number of MIP-map levels in this texture.
         std::uint32_t ClampMipLevel(std::uint32_t mipLevel) const;
@@ -40,12 +107,52 @@ class NullTexture final : public Texture
         void Write(const TextureRegion& textureRegion, const ImageView& srcImageView);
         void Read(const TextureRegion& textureRegion, const MutableImageView& dstImageView);
 
+        /*
+        Copies a region between this texture and linear memory in the texture's native format.
+        Row and layer strides are in bytes where zero denotes tightly packed rows and layers. Out-of-bounds regions are ignored.
+        */
+        void CopyToMemory(const TextureLocation& location, const Extent3D& extent, void* data, std::size_t dataSize, std::uint32_t rowStride, std::uint32_t layerStride) const;
+        void CopyFromMemory(const TextureLocation& location, const Extent3D& extent, const void* data, std::size_t dataSize, std::uint32_t rowStride, std::uint32_t layerStride);
+
+        // Copies a region from the source texture, which must have the same format as this texture.
+        void CopyFromTexture(const TextureLocation& dstLocation, const NullTexture& srcTexture, const TextureLocation& srcLocation, const Extent3D& extent);
+
         // Generates the MIP-map images for either the entire resource or a rubresource.
         void GenerateMips(const TextureSubresource* subresource = nullptr);
 
+        // Returns a shader view of this texture. If the texture view is disabled (see IsTextureViewEnabled), the view refers to the entire texture.
+        NullTextureView MakeView(const TextureViewDescriptor& textureViewDesc);
+
         std::uint32_t PackSubresourceIndex(std::uint32_t mipLevel, std::uint32_t arrayLayer) const;
         void UnpackSubresourceIndex(std::uint32_t subresource, std::uint32_t& outMipLevel, std::uint32_t& outArrayLayer) const;
 
+        /*
+        Returns the texel memory of the specified MIP-map level for sampling. This can be called concurrently.
+        With tiled layout, the tiled images are updated first if the texture has been modified since the last call.
+        */
+        NullSampledImage GetSampledImage(std::uint32_t mipLevel) const;
+
+        /*
+        Returns the image of the specified MIP-map level. Array layers are stored in the image depth or in the image height for 1D array textures.
+        Access to the mutable image invalidates the tiled images.
+        */
+        inline Image& GetMipImage(std::uint32_t mipLevel)
+        {
+            InvalidateTiledImages();
+            return images_[ClampMipLevel(mipLevel)];
+        }
+
+        inline const Image& GetMipImage(std::uint32_t mipLevel) const
+        {
+            return images_[ClampMipLevel(mipLevel)];
+        }
+
+        // Returns the number of MIP-map levels.
+        inline std::uint32_t GetNumMipLevels() const
+        {
+            return static_cast<std::uint32_t>(images_.size());
+        }
+
     public:
 
         const TextureDescriptor desc;
@@ -54,11 +161,25 @@ class NullTexture final : public Texture
 
         void AllocImages();
 
+        inline void InvalidateTiledImages()
+        {
+            if (tiledLayout_)
+                revision_.fetch_add(1, std::memory_order_release);
+        }
+
+        void UpdateTiledImages() const;
+
     private:
 
-        std::string         label_;
-        Extent3D            extent_;
-        std::vector<Image>  images_; // MIP-map images
+        std::string                             label_;
+        Extent3D                                extent_;
+        std::vector<Image>                      images_;                    // MIP-map images
+
+        const bool                              tiledLayout_    = false;
+        std::atomic<std::uint64_t>              revision_       { 1 };      // Incremented whenever the images are modified.
+        mutable std::atomic<std::uint64_t>      tiledRevision_  { 0 };      // Revision of the images the tiled images have been generated from.
+        mutable std::mutex                      tiledMutex_;
+        mutable std::vector<std::vector<char>>  tiledImages_;               // MIP-map images in Morton order.
 
 };
 
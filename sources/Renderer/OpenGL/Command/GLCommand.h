@@ -199,8 +199,9 @@ struct GLCmdBuildVertexArray
 
 struct GLCmdBindElementArrayBufferToVAO
 {
-    GLuint id;
-    bool   indexType16Bits;
+    GLuint      id;
+    bool        indexType16Bits;
+    GLsizeiptr  offset;
 };
 
 struct GLCmdBindBufferBase
@@ -295,6 +296,11 @@ struct GLCmdBeginConditionalRender
 
 //struct GLCmdEndConditionalRender {};
 
+/*
+Indexed draw commands with 'type' equal to GL_NONE inherit the index buffer from the primary command buffer.
+The index format is then resolved at execution time and 'indices' specifies the first index instead of a byte offset.
+*/
+
 struct GLCmdDrawArrays
 {
     GLenum  mode;
@@ -469,8 +475,8 @@ struct GLCmdPushDebugGroup
 {
     GLenum      source;
     GLuint      id;
-    GLsizei     length;
-//  GLchar      name[length];
+    GLsizei     length; // Uncropped length; cropped to GL_MAX_LABEL_LENGTH at execution time
+//  GLchar      name[length + 1];
 };
 
 //struct GLCmdPopDebugGroup {};
@@ -40,7 +40,42 @@ void GLCommandBuffer::SetIndexFormat(bool indexType16Bits, std::uint64_t offset)
         renderState_.indexBufferDataType    = GL_UNSIGNED_INT;
         renderState_.indexBufferStride      = 4;
     }
-    renderState_.indexBufferOffset = static_cast<GLsizeiptr>(offset);
+    renderState_.indexBufferOffset      = static_cast<GLsizeiptr>(offset);
+    renderState_.indexFormatInherited   = false;
+}
+
+void GLCommandBuffer::InheritIndexFormat()
+{
+    renderState_.indexFormatInherited = true;
+}
+
+void GLCommandBuffer::MergeRenderState(const GLCommandBuffer& secondaryCmdBuffer)
+{
+    const GLRenderState& secondaryState = secondaryCmdBuffer.renderState_;
+
+    /* Take over pipeline state and its draw modes if the secondary command buffer has bound one */
+    if (secondaryState.boundPipelineState != nullptr)
+    {
+        renderState_.drawMode               = secondaryState.drawMode;
+        renderState_.primitiveMode          = secondaryState.primitiveMode;
+        renderState_.boundPipelineLayout    = secondaryState.boundPipelineLayout;
+        renderState_.boundPipelineState     = secondaryState.boundPipelineState;
+        renderState_.implicitBarriers       = secondaryState.implicitBarriers;
+    }
+
+    /* Take over index format if the secondary command buffer has bound its own index buffer */
+    if (!secondaryState.indexFormatInherited)
+    {
+        renderState_.indexBufferDataType    = secondaryState.indexBufferDataType;
+        renderState_.indexBufferStride      = secondaryState.indexBufferStride;
+        renderState_.indexBufferOffset      = secondaryState.indexBufferOffset;
+    }
+
+    if (secondaryState.boundBufferWithFxb != nullptr)
+        renderState_.boundBufferWithFxb = secondaryState.boundBufferWithFxb;
+
+    /* Memory barriers that are still pending at the end of the secondary command buffer must be flushed by this command buffer */
+    renderState_.dirtyBarriers |= secondaryState.dirtyBarriers;
 }
 
 void GLCommandBuffer::SetPipelineRenderState(const GLPipelineState& pipelineStateGL)
@@ -44,6 +44,18 @@ class GLCommandBuffer : public CommandBuffer
         // Configures the attributes of 'renderState' for the type of index buffers.
         void SetIndexFormat(bool indexType16Bits, std::uint64_t offset);
 
+        /*
+        Specifies that indexed draw commands inherit the index buffer at execution time until SetIndexFormat() is called.
+        This is used by secondary command buffers whose primary command buffer is unknown at encoding time.
+        */
+        void InheritIndexFormat();
+
+        /*
+        Merges the render state the specified secondary command buffer leaves behind into this command buffer,
+        i.e. the bound pipeline state and index format if they were set by the secondary command buffer.
+        */
+        void MergeRenderState(const GLCommandBuffer& secondaryCmdBuffer);
+
         // Stores the render states for the specified PSO: Draw mode, primitive mode, binding layout.
         void SetPipelineRenderState(const GLPipelineState& pipelineStateGL);
 
@@ -85,15 +97,17 @@ class GLCommandBuffer : public CommandBuffer
             return renderState_.primitiveMode;
         }
 
-        // Returns the index data type for the glDraw* commands.
+        // Returns the index data type for the glDraw* commands or GL_NONE if the index format is inherited.
         inline GLenum GetIndexType() const
         {
-            return renderState_.indexBufferDataType;
+            return (renderState_.indexFormatInherited ? GL_NONE : renderState_.indexBufferDataType);
         }
 
-        // Returns the indices offset as GLvoid pointer for the glDrawElements* commands.
+        // Returns the indices offset as GLvoid pointer for the glDrawElements* commands or the first index if the index format is inherited.
         inline const GLvoid* GetIndicesOffset(std::uint32_t firstIndex) const
         {
+            if (renderState_.indexFormatInherited)
+                return reinterpret_cast<const GLvoid*>(static_cast<GLintptr>(firstIndex));
             const GLintptr indices = (renderState_.indexBufferOffset + firstIndex * renderState_.indexBufferStride);
             return reinterpret_cast<const GLvoid*>(indices);
         }
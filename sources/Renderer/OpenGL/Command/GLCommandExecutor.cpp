@@ -8,6 +8,7 @@
 #include "GLCommandExecutor.h"
 #include "GLCommand.h"
 #include "GLDeferredCommandBuffer.h"
+#include "GLCommandOptimizer.h"
 
 #include "../GLSwapChain.h"
 #include "../GLTypes.h"
@@ -46,488 +47,836 @@ namespace LLGL
 {
 
 
-static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager*& stateMngr)
+static std::size_t ExecuteBufferSubData(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBufferSubData*>(pc);
+    cmd->buffer->BufferSubData(cmd->offset, cmd->size, cmd + 1);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t ExecuteCopyBufferSubData(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdCopyBufferSubData*>(pc);
+    cmd->writeBuffer->CopyBufferSubData(*(cmd->readBuffer), cmd->readOffset, cmd->writeOffset, cmd->size);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteClearBufferData(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClearBufferData*>(pc);
+    cmd->buffer->ClearBufferData(cmd->data);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteClearBufferSubData(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClearBufferSubData*>(pc);
+    cmd->buffer->ClearBufferSubData(cmd->offset, cmd->size, cmd->data);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteCopyImageSubData(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdCopyImageSubData*>(pc);
+    cmd->dstTexture->CopyImageSubData(cmd->dstLevel, cmd->dstOffset, *(cmd->srcTexture), cmd->srcLevel, cmd->srcOffset, cmd->extent);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteCopyImageToBuffer(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdCopyImageBuffer*>(pc);
+    cmd->texture->CopyImageToBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteCopyImageFromBuffer(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdCopyImageBuffer*>(pc);
+    cmd->texture->CopyImageFromBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteCopyFramebufferSubData(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdCopyFramebufferSubData*>(pc);
+    GLFramebufferCapture::Get().CaptureFramebuffer(*stateMngr, *(cmd->dstTexture), cmd->dstLevel, cmd->dstOffset, cmd->srcOffset, cmd->extent);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGenerateMipmap(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdGenerateMipmap*>(pc);
+    GLMipGenerator::Get().GenerateMipsForTexture(*stateMngr, *(cmd->texture));
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGenerateMipmapSubresource(const void* pc, GLStateManager*& stateMngr)
 {
-    switch (opcode)
+    auto cmd = static_cast<const GLCmdGenerateMipmapSubresource*>(pc);
+    GLMipGenerator::Get().GenerateMipsRangeForTexture(*stateMngr, *(cmd->texture), cmd->baseMipLevel, cmd->numMipLevels, cmd->baseArrayLayer, cmd->numArrayLayers);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSecondaryCommandBuffer(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdExecute*>(pc);
+    ExecuteGLDeferredCommandBuffer(*(cmd->commandBuffer), *stateMngr);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteViewport(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdViewport*>(pc);
     {
-        case GLOpcodeBufferSubData:
-        {
-            auto cmd = static_cast<const GLCmdBufferSubData*>(pc);
-            cmd->buffer->BufferSubData(cmd->offset, cmd->size, cmd + 1);
-            return (sizeof(*cmd) + cmd->size);
-        }
-        case GLOpcodeCopyBufferSubData:
-        {
-            auto cmd = static_cast<const GLCmdCopyBufferSubData*>(pc);
-            cmd->writeBuffer->CopyBufferSubData(*(cmd->readBuffer), cmd->readOffset, cmd->writeOffset, cmd->size);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearBufferData:
-        {
-            auto cmd = static_cast<const GLCmdClearBufferData*>(pc);
-            cmd->buffer->ClearBufferData(cmd->data);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearBufferSubData:
-        {
-            auto cmd = static_cast<const GLCmdClearBufferSubData*>(pc);
-            cmd->buffer->ClearBufferSubData(cmd->offset, cmd->size, cmd->data);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeCopyImageSubData:
-        {
-            auto cmd = static_cast<const GLCmdCopyImageSubData*>(pc);
-            cmd->dstTexture->CopyImageSubData(cmd->dstLevel, cmd->dstOffset, *(cmd->srcTexture), cmd->srcLevel, cmd->srcOffset, cmd->extent);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeCopyImageToBuffer:
-        {
-            auto cmd = static_cast<const GLCmdCopyImageBuffer*>(pc);
-            cmd->texture->CopyImageToBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeCopyImageFromBuffer:
-        {
-            auto cmd = static_cast<const GLCmdCopyImageBuffer*>(pc);
-            cmd->texture->CopyImageFromBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeCopyFramebufferSubData:
-        {
-            auto cmd = static_cast<const GLCmdCopyFramebufferSubData*>(pc);
-            GLFramebufferCapture::Get().CaptureFramebuffer(*stateMngr, *(cmd->dstTexture), cmd->dstLevel, cmd->dstOffset, cmd->srcOffset, cmd->extent);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeGenerateMipmap:
-        {
-            auto cmd = static_cast<const GLCmdGenerateMipmap*>(pc);
-            GLMipGenerator::Get().GenerateMipsForTexture(*stateMngr, *(cmd->texture));
-            return sizeof(*cmd);
-        }
-        case GLOpcodeGenerateMipmapSubresource:
-        {
-            auto cmd = static_cast<const GLCmdGenerateMipmapSubresource*>(pc);
-            GLMipGenerator::Get().GenerateMipsRangeForTexture(*stateMngr, *(cmd->texture), cmd->baseMipLevel, cmd->numMipLevels, cmd->baseArrayLayer, cmd->numArrayLayers);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeExecute:
-        {
-            auto cmd = static_cast<const GLCmdExecute*>(pc);
-            ExecuteGLDeferredCommandBuffer(*(cmd->commandBuffer), *stateMngr);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeViewport:
-        {
-            auto cmd = static_cast<const GLCmdViewport*>(pc);
-            {
-                stateMngr->SetViewport(cmd->viewport);
-                stateMngr->SetDepthRange(cmd->depthRange);
-            }
-            return sizeof(*cmd);
-        }
-        case GLOpcodeViewportArray:
-        {
-            auto cmd = static_cast<const GLCmdViewportArray*>(pc);
-            auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
-            {
-                stateMngr->SetViewportArray(cmd->first, cmd->count, reinterpret_cast<const GLViewport*>(cmdData));
-                stateMngr->SetDepthRangeArray(cmd->first, cmd->count, reinterpret_cast<const GLDepthRange*>(cmdData + sizeof(GLViewport)*cmd->count));
-            }
-            return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
-        }
-        case GLOpcodeScissor:
-        {
-            auto cmd = static_cast<const GLCmdScissor*>(pc);
-            {
-                stateMngr->SetScissor(cmd->scissor);
-            }
-            return sizeof(*cmd);
-        }
-        case GLOpcodeScissorArray:
-        {
-            auto cmd = static_cast<const GLCmdScissorArray*>(pc);
-            auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
-            {
-                stateMngr->SetScissorArray(cmd->first, cmd->count, reinterpret_cast<const GLScissor*>(cmdData));
-            }
-            return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
-        }
-        case GLOpcodeClearColor:
-        {
-            auto cmd = static_cast<const GLCmdClearColor*>(pc);
-            glClearColor(cmd->color[0], cmd->color[1], cmd->color[2], cmd->color[3]);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearDepth:
-        {
-            auto cmd = static_cast<const GLCmdClearDepth*>(pc);
-            GLProfile::ClearDepth(cmd->depth);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearStencil:
-        {
-            auto cmd = static_cast<const GLCmdClearStencil*>(pc);
-            glClearStencil(cmd->stencil);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClear:
-        {
-            auto cmd = static_cast<const GLCmdClear*>(pc);
-            stateMngr->Clear(cmd->flags);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearAttachmentsWithRenderPass:
-        {
-            auto cmd = static_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
-            if (cmd->renderPass != nullptr)
-                stateMngr->ClearAttachmentsWithRenderPass(*(cmd->renderPass), cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1));
-            return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
-        }
-        case GLOpcodeClearBuffers:
-        {
-            auto cmd = static_cast<const GLCmdClearBuffers*>(pc);
-            stateMngr->ClearBuffers(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
-            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
-        }
-        case GLOpcodeResolveRenderTarget:
-        {
-            auto cmd = static_cast<const GLCmdResolveRenderTarget*>(pc);
-            cmd->renderTarget->ResolveMultisampled(*stateMngr);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindVertexArray:
-        {
-            auto cmd = static_cast<const GLCmdBindVertexArray*>(pc);
-            cmd->vertexArray->Bind(*stateMngr);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBuildVertexArray:
-        {
-            auto cmd = static_cast<const GLCmdBuildVertexArray*>(pc);
-            cmd->bufferWithVAO->BuildVertexArray(ArrayView<GLVertexAttribute>{ reinterpret_cast<const GLVertexAttribute*>(cmd + 1), cmd->numVertexAttribs });
-            return (sizeof(*cmd) + sizeof(GLVertexAttribute)*cmd->numVertexAttribs);
-        }
-        case GLOpcodeBindElementArrayBufferToVAO:
-        {
-            auto cmd = static_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
-            stateMngr->BindElementArrayBufferToVAO(cmd->id, cmd->indexType16Bits);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindBufferBase:
-        {
-            auto cmd = static_cast<const GLCmdBindBufferBase*>(pc);
-            stateMngr->BindBufferBase(cmd->target, cmd->index, cmd->id);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindBuffersBase:
-        {
-            auto cmd = static_cast<const GLCmdBindBuffersBase*>(pc);
-            stateMngr->BindBuffersBase(cmd->target, cmd->first, cmd->count, reinterpret_cast<const GLuint*>(cmd + 1));
-            return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
-        }
-        case GLOpcodeBeginBufferXfb:
-        {
-            auto cmd = static_cast<const GLCmdBeginBufferXfb*>(pc);
-            GLBufferWithXFB::BeginTransformFeedback(*stateMngr, *(cmd->bufferWithXfb), cmd->primitiveMode);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeEndBufferXfb:
-        {
-            GLBufferWithXFB::EndTransformFeedback(*stateMngr);
-            return 0;
-        }
-        case GLOpcodeBeginTransformFeedback:
-        {
-            auto cmd = static_cast<const GLCmdBeginTransformFeedback*>(pc);
-            #if defined(__APPLE__) && LLGL_GL_ENABLE_OPENGL2X
-            glBeginTransformFeedbackEXT(cmd->primitiveMove);
-            #else
-            glBeginTransformFeedback(cmd->primitiveMove);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBeginTransformFeedbackNV:
-        {
-            auto cmd = static_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
-            #if GL_NV_transform_feedback
-            glBeginTransformFeedbackNV(cmd->primitiveMove);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeEndTransformFeedback:
-        {
-            #if defined(__APPLE__) && LLGL_GL_ENABLE_OPENGL2X
-            glEndTransformFeedbackEXT();
-            #else
-            glEndTransformFeedback();
-            #endif
-            return 0;
-        }
-        case GLOpcodeEndTransformFeedbackNV:
-        {
-            #if GL_NV_transform_feedback
-            glEndTransformFeedbackNV();
-            #endif
-            return 0;
-        }
-        case GLOpcodeBindResourceHeap:
-        {
-            auto cmd = static_cast<const GLCmdBindResourceHeap*>(pc);
-            cmd->resourceHeap->Bind(*stateMngr, cmd->descriptorSet, cmd->bufferInterfaceMap);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindRenderTarget:
-        {
-            auto cmd = static_cast<const GLCmdBindRenderTarget*>(pc);
-            GLStateManager* nextStateMngr = stateMngr;
-            stateMngr->BindRenderTarget(*(cmd->renderTarget), &nextStateMngr);
-            stateMngr = nextStateMngr;
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindPipelineState:
-        {
-            auto cmd = static_cast<const GLCmdBindPipelineState*>(pc);
-            cmd->pipelineState->Bind(*stateMngr);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeSetBlendColor:
-        {
-            auto cmd = static_cast<const GLCmdSetBlendColor*>(pc);
-            stateMngr->SetBlendColor(cmd->color);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeSetStencilRef:
-        {
-            auto cmd = static_cast<const GLCmdSetStencilRef*>(pc);
-            stateMngr->SetStencilRef(cmd->ref, cmd->face);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeSetUniform:
-        {
-            auto cmd = static_cast<const GLCmdSetUniform*>(pc);
-            GLSetUniform(cmd->type, cmd->location, cmd->count, (cmd + 1));
-            return (sizeof(*cmd) + cmd->size);
-        }
-        case GLOpcodeBeginQuery:
-        {
-            auto cmd = static_cast<const GLCmdBeginQuery*>(pc);
-            cmd->queryHeap->Begin(cmd->query);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeEndQuery:
-        {
-            auto cmd = static_cast<const GLCmdEndQuery*>(pc);
-            cmd->queryHeap->End();
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBeginConditionalRender:
-        {
-            auto cmd = static_cast<const GLCmdBeginConditionalRender*>(pc);
-            #if LLGL_GLEXT_CONDITIONAL_RENDER
-            glBeginConditionalRender(cmd->id, cmd->mode);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeEndConditionalRender:
-        {
-            #if LLGL_GLEXT_CONDITIONAL_RENDER
-            glEndConditionalRender();
-            #endif
-            return 0;
-        }
-        case GLOpcodeDrawArrays:
-        {
-            auto cmd = static_cast<const GLCmdDrawArrays*>(pc);
-            glDrawArrays(cmd->mode, cmd->first, cmd->count);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawArraysInstanced:
-        {
-            auto cmd = static_cast<const GLCmdDrawArraysInstanced*>(pc);
-            #if LLGL_GLEXT_DRAW_INSTANCED
-            glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawArraysInstancedBaseInstance:
-        {
-            auto cmd = static_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
-            #if LLGL_GLEXT_BASE_INSTANCE
-            glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawArraysIndirect:
-        {
-            auto cmd = static_cast<const GLCmdDrawArraysIndirect*>(pc);
-            #if LLGL_GLEXT_DRAW_INDIRECT
-            stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
-            GLintptr offset = cmd->indirect;
-            for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
-            {
-                glDrawArraysIndirect(cmd->mode, reinterpret_cast<const GLvoid*>(offset));
-                offset += cmd->stride;
-            }
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElements:
-        {
-            auto cmd = static_cast<const GLCmdDrawElements*>(pc);
-            glDrawElements(cmd->mode, cmd->count, cmd->type, cmd->indices);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsBaseVertex:
-        {
-            auto cmd = static_cast<const GLCmdDrawElementsBaseVertex*>(pc);
-            #if LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
-            glDrawElementsBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsInstanced:
-        {
-            auto cmd = static_cast<const GLCmdDrawElementsInstanced*>(pc);
-            #if LLGL_GLEXT_DRAW_INSTANCED
-            glDrawElementsInstanced(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsInstancedBaseVertex:
-        {
-            auto cmd = static_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
-            #if LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
-            glDrawElementsInstancedBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
-        {
-            auto cmd = static_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
-            #if LLGL_GLEXT_BASE_INSTANCE
-            glDrawElementsInstancedBaseVertexBaseInstance(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsIndirect:
-        {
-            auto cmd = static_cast<const GLCmdDrawElementsIndirect*>(pc);
-            #if LLGL_GLEXT_DRAW_INDIRECT
-            stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
-            GLintptr offset = cmd->indirect;
-            for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
-            {
-                glDrawElementsIndirect(cmd->mode, cmd->type, reinterpret_cast<const GLvoid*>(offset));
-                offset += cmd->stride;
-            }
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeMultiDrawArraysIndirect:
-        {
-            auto cmd = static_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
-            #if LLGL_GLEXT_MULTI_DRAW_INDIRECT
-            stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
-            glMultiDrawArraysIndirect(cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeMultiDrawElementsIndirect:
-        {
-            auto cmd = static_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
-            #if LLGL_GLEXT_MULTI_DRAW_INDIRECT
-            stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
-            glMultiDrawElementsIndirect(cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawTransformFeedback:
-        {
-            auto cmd = static_cast<const GLCmdDrawTransformFeedback*>(pc);
-            #if LLGL_GLEXT_TRANSFORM_FEEDBACK2
-            glDrawTransformFeedback(cmd->mode, cmd->xfbID);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawEmulatedTransformFeedback:
-        {
-            auto cmd = static_cast<const GLCmdDrawEmulatedTransformFeedback*>(pc);
-            glDrawArrays(cmd->mode, 0, cmd->bufferWithXfb->QueryVertexCount());
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDispatchCompute:
-        {
-            auto cmd = static_cast<const GLCmdDispatchCompute*>(pc);
-            #if LLGL_GLEXT_COMPUTE_SHADER
-            glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDispatchComputeIndirect:
-        {
-            auto cmd = static_cast<const GLCmdDispatchComputeIndirect*>(pc);
-            #if LLGL_GLEXT_COMPUTE_SHADER
-            stateMngr->BindBuffer(GLBufferTarget::DispatchIndirectBuffer, cmd->id);
-            glDispatchComputeIndirect(cmd->indirect);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindTexture:
-        {
-            auto cmd = static_cast<const GLCmdBindTexture*>(pc);
-            stateMngr->BindGLTexture(cmd->slot, *(cmd->texture));
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindTextureNative:
-        {
-            auto cmd = static_cast<const GLCmdBindTextureNative*>(pc);
-            stateMngr->BindTexture(cmd->slot, cmd->target, cmd->id);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindImageTexture:
-        {
-            auto cmd = static_cast<const GLCmdBindImageTexture*>(pc);
-            stateMngr->BindImageTexture(cmd->unit, cmd->level, cmd->format, cmd->texture);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindSampler:
-        {
-            auto cmd = static_cast<const GLCmdBindSampler*>(pc);
-            stateMngr->BindSampler(cmd->layer, cmd->sampler);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindEmulatedSampler:
-        {
-            auto cmd = static_cast<const GLCmdBindEmulatedSampler*>(pc);
-            stateMngr->BindEmulatedSampler(cmd->layer, *(cmd->sampler));
-            return sizeof(*cmd);
-        }
-        #if LLGL_GLEXT_MEMORY_BARRIERS
-        case GLOpcodeMemoryBarrier:
-        {
-            auto cmd = static_cast<const GLCmdMemoryBarrier*>(pc);
-            glMemoryBarrier(cmd->barriers);
-            return sizeof(*cmd);
-        }
-        #endif
-        case GLOpcodePushDebugGroup:
-        {
-            auto cmd = static_cast<const GLCmdPushDebugGroup*>(pc);
-            #ifdef LLGL_GLEXT_DEBUG
-            glPushDebugGroup(cmd->source, cmd->id, cmd->length, reinterpret_cast<const GLchar*>(cmd + 1));
-            #endif
-            return (sizeof(*cmd) + cmd->length + 1);
-        }
-        case GLOpcodePopDebugGroup:
-        {
-            #ifdef LLGL_GLEXT_DEBUG
-            glPopDebugGroup();
-            #endif
-            return 0;
-        }
-        default:
-            return 0;
+        stateMngr->SetViewport(cmd->viewport);
+        stateMngr->SetDepthRange(cmd->depthRange);
+    }
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteViewportArray(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdViewportArray*>(pc);
+    auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
+    {
+        stateMngr->SetViewportArray(cmd->first, cmd->count, reinterpret_cast<const GLViewport*>(cmdData));
+        stateMngr->SetDepthRangeArray(cmd->first, cmd->count, reinterpret_cast<const GLDepthRange*>(cmdData + sizeof(GLViewport)*cmd->count));
     }
+    return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
+}
+
+static std::size_t ExecuteScissor(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdScissor*>(pc);
+    {
+        stateMngr->SetScissor(cmd->scissor);
+    }
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteScissorArray(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdScissorArray*>(pc);
+    auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
+    {
+        stateMngr->SetScissorArray(cmd->first, cmd->count, reinterpret_cast<const GLScissor*>(cmdData));
+    }
+    return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+}
+
+static std::size_t ExecuteClearColor(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClearColor*>(pc);
+    glClearColor(cmd->color[0], cmd->color[1], cmd->color[2], cmd->color[3]);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteClearDepth(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClearDepth*>(pc);
+    GLProfile::ClearDepth(cmd->depth);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteClearStencil(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClearStencil*>(pc);
+    glClearStencil(cmd->stencil);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteClear(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClear*>(pc);
+    stateMngr->Clear(cmd->flags);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteClearAttachmentsWithRenderPass(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
+    if (cmd->renderPass != nullptr)
+        stateMngr->ClearAttachmentsWithRenderPass(*(cmd->renderPass), cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1));
+    return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+}
+
+static std::size_t ExecuteClearBuffers(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdClearBuffers*>(pc);
+    stateMngr->ClearBuffers(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
+    return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
+}
+
+static std::size_t ExecuteResolveRenderTarget(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdResolveRenderTarget*>(pc);
+    cmd->renderTarget->ResolveMultisampled(*stateMngr);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindVertexArray(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindVertexArray*>(pc);
+    cmd->vertexArray->Bind(*stateMngr);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBuildVertexArray(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBuildVertexArray*>(pc);
+    cmd->bufferWithVAO->BuildVertexArray(ArrayView<GLVertexAttribute>{ reinterpret_cast<const GLVertexAttribute*>(cmd + 1), cmd->numVertexAttribs });
+    return (sizeof(*cmd) + sizeof(GLVertexAttribute)*cmd->numVertexAttribs);
+}
+
+static std::size_t ExecuteBindElementArrayBufferToVAO(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
+    stateMngr->BindElementArrayBufferToVAO(cmd->id, cmd->indexType16Bits, cmd->offset);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindBufferBase(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindBufferBase*>(pc);
+    stateMngr->BindBufferBase(cmd->target, cmd->index, cmd->id);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindBuffersBase(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindBuffersBase*>(pc);
+    stateMngr->BindBuffersBase(cmd->target, cmd->first, cmd->count, reinterpret_cast<const GLuint*>(cmd + 1));
+    return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+}
+
+static std::size_t ExecuteBeginBufferXfb(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBeginBufferXfb*>(pc);
+    GLBufferWithXFB::BeginTransformFeedback(*stateMngr, *(cmd->bufferWithXfb), cmd->primitiveMode);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteEndBufferXfb(const void* pc, GLStateManager*& stateMngr)
+{
+    GLBufferWithXFB::EndTransformFeedback(*stateMngr);
+    return 0;
+}
+
+static std::size_t ExecuteBeginTransformFeedback(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBeginTransformFeedback*>(pc);
+    #if defined(__APPLE__) && LLGL_GL_ENABLE_OPENGL2X
+    glBeginTransformFeedbackEXT(cmd->primitiveMove);
+    #else
+    glBeginTransformFeedback(cmd->primitiveMove);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBeginTransformFeedbackNV(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
+    #if GL_NV_transform_feedback
+    glBeginTransformFeedbackNV(cmd->primitiveMove);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteEndTransformFeedback(const void* pc, GLStateManager*& stateMngr)
+{
+    #if defined(__APPLE__) && LLGL_GL_ENABLE_OPENGL2X
+    glEndTransformFeedbackEXT();
+    #else
+    glEndTransformFeedback();
+    #endif
+    return 0;
+}
+
+static std::size_t ExecuteEndTransformFeedbackNV(const void* pc, GLStateManager*& stateMngr)
+{
+    #if GL_NV_transform_feedback
+    glEndTransformFeedbackNV();
+    #endif
+    return 0;
+}
+
+static std::size_t ExecuteBindResourceHeap(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindResourceHeap*>(pc);
+
+    /* Resolve buffer interfaces from the currently bound PSO if none was bound at encoding time, e.g. in secondary command buffers that inherit the PSO */
+    const GLShaderBufferInterfaceMap* bufferInterfaceMap = cmd->bufferInterfaceMap;
+    if (bufferInterfaceMap == nullptr)
+    {
+        if (const GLPipelineState* boundPipelineState = stateMngr->GetBoundPipelineState())
+            bufferInterfaceMap = boundPipelineState->GetBufferInterfaceMap();
+    }
+
+    cmd->resourceHeap->Bind(*stateMngr, cmd->descriptorSet, bufferInterfaceMap);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindRenderTarget(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindRenderTarget*>(pc);
+    GLStateManager* nextStateMngr = stateMngr;
+    stateMngr->BindRenderTarget(*(cmd->renderTarget), &nextStateMngr);
+    stateMngr = nextStateMngr;
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindPipelineState(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindPipelineState*>(pc);
+    cmd->pipelineState->Bind(*stateMngr);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetBlendColor(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdSetBlendColor*>(pc);
+    stateMngr->SetBlendColor(cmd->color);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetStencilRef(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdSetStencilRef*>(pc);
+    stateMngr->SetStencilRef(cmd->ref, cmd->face);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteSetUniform(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdSetUniform*>(pc);
+    GLSetUniform(cmd->type, cmd->location, cmd->count, (cmd + 1));
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t ExecuteBeginQuery(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBeginQuery*>(pc);
+    cmd->queryHeap->Begin(cmd->query);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteEndQuery(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdEndQuery*>(pc);
+    cmd->queryHeap->End();
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBeginConditionalRender(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBeginConditionalRender*>(pc);
+    #if LLGL_GLEXT_CONDITIONAL_RENDER
+    glBeginConditionalRender(cmd->id, cmd->mode);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteEndConditionalRender(const void* pc, GLStateManager*& stateMngr)
+{
+    #if LLGL_GLEXT_CONDITIONAL_RENDER
+    glEndConditionalRender();
+    #endif
+    return 0;
+}
+
+static std::size_t ExecuteDrawArrays(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawArrays*>(pc);
+    glDrawArrays(cmd->mode, cmd->first, cmd->count);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawArraysInstanced(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawArraysInstanced*>(pc);
+    #if LLGL_GLEXT_DRAW_INSTANCED
+    glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawArraysInstancedBaseInstance(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
+    #if LLGL_GLEXT_BASE_INSTANCE
+    glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawArraysIndirect(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawArraysIndirect*>(pc);
+    #if LLGL_GLEXT_DRAW_INDIRECT
+    stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
+    GLintptr offset = cmd->indirect;
+    for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
+    {
+        glDrawArraysIndirect(cmd->mode, reinterpret_cast<const GLvoid*>(offset));
+        offset += cmd->stride;
+    }
+    #endif
+    return sizeof(*cmd);
+}
+
+// Returns the index type of an indexed draw command and resolves it from the bound index buffer if it is inherited (i.e. GL_NONE).
+static GLenum ResolveIndexType(GLenum type, const GLStateManager& stateMngr)
+{
+    return (type != GL_NONE ? type : stateMngr.GetIndexType());
+}
+
+// Returns the indices offset of an indexed draw command and resolves it from the bound index buffer if the index type is inherited.
+static const GLvoid* ResolveIndicesOffset(GLenum type, const GLvoid* indices, const GLStateManager& stateMngr)
+{
+    return (type != GL_NONE ? indices : stateMngr.GetIndicesOffset(reinterpret_cast<GLintptr>(indices)));
+}
+
+static std::size_t ExecuteDrawElements(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawElements*>(pc);
+    glDrawElements(
+        cmd->mode,
+        cmd->count,
+        ResolveIndexType(cmd->type, *stateMngr),
+        ResolveIndicesOffset(cmd->type, cmd->indices, *stateMngr)
+    );
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawElementsBaseVertex(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawElementsBaseVertex*>(pc);
+    #if LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+    glDrawElementsBaseVertex(
+        cmd->mode,
+        cmd->count,
+        ResolveIndexType(cmd->type, *stateMngr),
+        ResolveIndicesOffset(cmd->type, cmd->indices, *stateMngr),
+        cmd->basevertex
+    );
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawElementsInstanced(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawElementsInstanced*>(pc);
+    #if LLGL_GLEXT_DRAW_INSTANCED
+    glDrawElementsInstanced(
+        cmd->mode,
+        cmd->count,
+        ResolveIndexType(cmd->type, *stateMngr),
+        ResolveIndicesOffset(cmd->type, cmd->indices, *stateMngr),
+        cmd->instancecount
+    );
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawElementsInstancedBaseVertex(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
+    #if LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+    glDrawElementsInstancedBaseVertex(
+        cmd->mode,
+        cmd->count,
+        ResolveIndexType(cmd->type, *stateMngr),
+        ResolveIndicesOffset(cmd->type, cmd->indices, *stateMngr),
+        cmd->instancecount,
+        cmd->basevertex
+    );
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawElementsInstancedBaseVertexBaseInstance(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
+    #if LLGL_GLEXT_BASE_INSTANCE
+    glDrawElementsInstancedBaseVertexBaseInstance(
+        cmd->mode,
+        cmd->count,
+        ResolveIndexType(cmd->type, *stateMngr),
+        ResolveIndicesOffset(cmd->type, cmd->indices, *stateMngr),
+        cmd->instancecount,
+        cmd->basevertex,
+        cmd->baseinstance
+    );
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawElementsIndirect(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawElementsIndirect*>(pc);
+    #if LLGL_GLEXT_DRAW_INDIRECT
+    stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
+    const GLenum type = ResolveIndexType(cmd->type, *stateMngr);
+    GLintptr offset = cmd->indirect;
+    for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
+    {
+        glDrawElementsIndirect(cmd->mode, type, reinterpret_cast<const GLvoid*>(offset));
+        offset += cmd->stride;
+    }
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteMultiDrawArraysIndirect(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
+    #if LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
+    glMultiDrawArraysIndirect(cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteMultiDrawElementsIndirect(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
+    #if LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    stateMngr->BindBuffer(GLBufferTarget::DrawIndirectBuffer, cmd->id);
+    glMultiDrawElementsIndirect(cmd->mode, ResolveIndexType(cmd->type, *stateMngr), cmd->indirect, cmd->drawcount, cmd->stride);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawTransformFeedback(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawTransformFeedback*>(pc);
+    #if LLGL_GLEXT_TRANSFORM_FEEDBACK2
+    glDrawTransformFeedback(cmd->mode, cmd->xfbID);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDrawEmulatedTransformFeedback(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDrawEmulatedTransformFeedback*>(pc);
+    glDrawArrays(cmd->mode, 0, cmd->bufferWithXfb->QueryVertexCount());
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDispatchCompute(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDispatchCompute*>(pc);
+    #if LLGL_GLEXT_COMPUTE_SHADER
+    glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteDispatchComputeIndirect(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdDispatchComputeIndirect*>(pc);
+    #if LLGL_GLEXT_COMPUTE_SHADER
+    stateMngr->BindBuffer(GLBufferTarget::DispatchIndirectBuffer, cmd->id);
+    glDispatchComputeIndirect(cmd->indirect);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindTexture(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindTexture*>(pc);
+    stateMngr->BindGLTexture(cmd->slot, *(cmd->texture));
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindTextureNative(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindTextureNative*>(pc);
+    stateMngr->BindTexture(cmd->slot, cmd->target, cmd->id);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindImageTexture(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindImageTexture*>(pc);
+    stateMngr->BindImageTexture(cmd->unit, cmd->level, cmd->format, cmd->texture);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindSampler(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindSampler*>(pc);
+    stateMngr->BindSampler(cmd->layer, cmd->sampler);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteBindEmulatedSampler(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdBindEmulatedSampler*>(pc);
+    stateMngr->BindEmulatedSampler(cmd->layer, *(cmd->sampler));
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteMemoryBarrier(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdMemoryBarrier*>(pc);
+    #if LLGL_GLEXT_MEMORY_BARRIERS
+    glMemoryBarrier(cmd->barriers);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecutePushDebugGroup(const void* pc, GLStateManager*& stateMngr)
+{
+    auto cmd = static_cast<const GLCmdPushDebugGroup*>(pc);
+    #ifdef LLGL_GLEXT_DEBUG
+    const GLsizei length = std::min(cmd->length, static_cast<GLsizei>(stateMngr->GetLimits().maxDebugNameLength));
+    glPushDebugGroup(cmd->source, cmd->id, length, reinterpret_cast<const GLchar*>(cmd + 1));
+    #endif
+    return (sizeof(*cmd) + cmd->length + 1);
+}
+
+static std::size_t ExecutePopDebugGroup(const void* pc, GLStateManager*& stateMngr)
+{
+    #ifdef LLGL_GLEXT_DEBUG
+    glPopDebugGroup();
+    #endif
+    return 0;
+}
+
+// Table of command functions indexed by GLOpcode.
+static const GLCommandFunc g_glCommandFuncs[] =
+{
+    nullptr,                                            // <invalid>
+    ExecuteBufferSubData,                               // GLOpcodeBufferSubData
+    ExecuteCopyBufferSubData,                           // GLOpcodeCopyBufferSubData
+    ExecuteClearBufferData,                             // GLOpcodeClearBufferData
+    ExecuteClearBufferSubData,                          // GLOpcodeClearBufferSubData
+    ExecuteCopyImageSubData,                            // GLOpcodeCopyImageSubData
+    ExecuteCopyImageToBuffer,                           // GLOpcodeCopyImageToBuffer
+    ExecuteCopyImageFromBuffer,                         // GLOpcodeCopyImageFromBuffer
+    ExecuteCopyFramebufferSubData,                      // GLOpcodeCopyFramebufferSubData
+    ExecuteGenerateMipmap,                              // GLOpcodeGenerateMipmap
+    ExecuteGenerateMipmapSubresource,                   // GLOpcodeGenerateMipmapSubresource
+    ExecuteSecondaryCommandBuffer,                      // GLOpcodeExecute
+    ExecuteViewport,                                    // GLOpcodeViewport
+    ExecuteViewportArray,                               // GLOpcodeViewportArray
+    ExecuteScissor,                                     // GLOpcodeScissor
+    ExecuteScissorArray,                                // GLOpcodeScissorArray
+    ExecuteClearColor,                                  // GLOpcodeClearColor
+    ExecuteClearDepth,                                  // GLOpcodeClearDepth
+    ExecuteClearStencil,                                // GLOpcodeClearStencil
+    ExecuteClear,                                       // GLOpcodeClear
+    ExecuteClearAttachmentsWithRenderPass,              // GLOpcodeClearAttachmentsWithRenderPass
+    ExecuteClearBuffers,                                // GLOpcodeClearBuffers
+    ExecuteResolveRenderTarget,                         // GLOpcodeResolveRenderTarget
+    ExecuteBindVertexArray,                             // GLOpcodeBindVertexArray
+    ExecuteBuildVertexArray,                            // GLOpcodeBuildVertexArray
+    ExecuteBindElementArrayBufferToVAO,                 // GLOpcodeBindElementArrayBufferToVAO
+    ExecuteBindBufferBase,                              // GLOpcodeBindBufferBase
+    ExecuteBindBuffersBase,                             // GLOpcodeBindBuffersBase
+    ExecuteBeginBufferXfb,                              // GLOpcodeBeginBufferXfb
+    ExecuteEndBufferXfb,                                // GLOpcodeEndBufferXfb
+    ExecuteBeginTransformFeedback,                      // GLOpcodeBeginTransformFeedback
+    ExecuteBeginTransformFeedbackNV,                    // GLOpcodeBeginTransformFeedbackNV
+    ExecuteEndTransformFeedback,                        // GLOpcodeEndTransformFeedback
+    ExecuteEndTransformFeedbackNV,                      // GLOpcodeEndTransformFeedbackNV
+    ExecuteBindResourceHeap,                            // GLOpcodeBindResourceHeap
+    ExecuteBindRenderTarget,                            // GLOpcodeBindRenderTarget
+    ExecuteBindPipelineState,                           // GLOpcodeBindPipelineState
+    ExecuteSetBlendColor,                               // GLOpcodeSetBlendColor
+    ExecuteSetStencilRef,                               // GLOpcodeSetStencilRef
+    ExecuteSetUniform,                                  // GLOpcodeSetUniform
+    ExecuteBeginQuery,                                  // GLOpcodeBeginQuery
+    ExecuteEndQuery,                                    // GLOpcodeEndQuery
+    ExecuteBeginConditionalRender,                      // GLOpcodeBeginConditionalRender
+    ExecuteEndConditionalRender,                        // GLOpcodeEndConditionalRender
+    ExecuteDrawArrays,                                  // GLOpcodeDrawArrays
+    ExecuteDrawArraysInstanced,                         // GLOpcodeDrawArraysInstanced
+    ExecuteDrawArraysInstancedBaseInstance,             // GLOpcodeDrawArraysInstancedBaseInstance
+    ExecuteDrawArraysIndirect,                          // GLOpcodeDrawArraysIndirect
+    ExecuteDrawElements,                                // GLOpcodeDrawElements
+    ExecuteDrawElementsBaseVertex,                      // GLOpcodeDrawElementsBaseVertex
+    ExecuteDrawElementsInstanced,                       // GLOpcodeDrawElementsInstanced
+    ExecuteDrawElementsInstancedBaseVertex,             // GLOpcodeDrawElementsInstancedBaseVertex
+    ExecuteDrawElementsInstancedBaseVertexBaseInstance, // GLOpcodeDrawElementsInstancedBaseVertexBaseInstance
+    ExecuteDrawElementsIndirect,                        // GLOpcodeDrawElementsIndirect
+    ExecuteDrawTransformFeedback,                       // GLOpcodeDrawTransformFeedback
+    ExecuteDrawEmulatedTransformFeedback,               // GLOpcodeDrawEmulatedTransformFeedback
+    ExecuteMultiDrawArraysIndirect,                     // GLOpcodeMultiDrawArraysIndirect
+    ExecuteMultiDrawElementsIndirect,                   // GLOpcodeMultiDrawElementsIndirect
+    ExecuteDispatchCompute,                             // GLOpcodeDispatchCompute
+    ExecuteDispatchComputeIndirect,                     // GLOpcodeDispatchComputeIndirect
+    ExecuteBindTexture,                                 // GLOpcodeBindTexture
+    ExecuteBindTextureNative,                           // GLOpcodeBindTextureNative
+    ExecuteBindImageTexture,                            // GLOpcodeBindImageTexture
+    ExecuteBindSampler,                                 // GLOpcodeBindSampler
+    ExecuteBindEmulatedSampler,                         // GLOpcodeBindEmulatedSampler
+    ExecuteMemoryBarrier,                               // GLOpcodeMemoryBarrier
+    ExecutePushDebugGroup,                              // GLOpcodePushDebugGroup
+    ExecutePopDebugGroup,                               // GLOpcodePopDebugGroup
+};
+
+static_assert(
+    sizeof(g_glCommandFuncs)/sizeof(g_glCommandFuncs[0]) == GLOpcodePopDebugGroup + 1,
+    "g_glCommandFuncs[] must have an entry for each GLOpcode"
+);
+
+template <typename TCommand>
+static std::size_t GetFixedGLCommandSize(const void* /*pc*/)
+{
+    return sizeof(TCommand);
+}
+
+static std::size_t GetEmptyGLCommandSize(const void* /*pc*/)
+{
+    return 0;
+}
+
+static std::size_t GetBufferSubDataSize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdBufferSubData*>(pc);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t GetViewportArraySize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdViewportArray*>(pc);
+    return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
+}
+
+static std::size_t GetScissorArraySize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdScissorArray*>(pc);
+    return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+}
+
+static std::size_t GetClearAttachmentsWithRenderPassSize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
+    return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+}
+
+static std::size_t GetClearBuffersSize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdClearBuffers*>(pc);
+    return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
+}
+
+static std::size_t GetBuildVertexArraySize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdBuildVertexArray*>(pc);
+    return (sizeof(*cmd) + sizeof(GLVertexAttribute)*cmd->numVertexAttribs);
+}
+
+static std::size_t GetBindBuffersBaseSize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdBindBuffersBase*>(pc);
+    return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+}
+
+static std::size_t GetSetUniformSize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdSetUniform*>(pc);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t GetPushDebugGroupSize(const void* pc)
+{
+    auto cmd = static_cast<const GLCmdPushDebugGroup*>(pc);
+    return (sizeof(*cmd) + cmd->length + 1);
+}
+
+typedef std::size_t (*GLCommandSizeFunc)(const void* pc);
+
+// Table of command size functions indexed by GLOpcode. This is the only place where the payload size of each command is defined.
+static const GLCommandSizeFunc g_glCommandSizeFuncs[] =
+{
+    nullptr,                                                                 // <invalid>
+    GetBufferSubDataSize,                                                    // GLOpcodeBufferSubData
+    GetFixedGLCommandSize<GLCmdCopyBufferSubData>,                           // GLOpcodeCopyBufferSubData
+    GetFixedGLCommandSize<GLCmdClearBufferData>,                             // GLOpcodeClearBufferData
+    GetFixedGLCommandSize<GLCmdClearBufferSubData>,                          // GLOpcodeClearBufferSubData
+    GetFixedGLCommandSize<GLCmdCopyImageSubData>,                            // GLOpcodeCopyImageSubData
+    GetFixedGLCommandSize<GLCmdCopyImageBuffer>,                             // GLOpcodeCopyImageToBuffer
+    GetFixedGLCommandSize<GLCmdCopyImageBuffer>,                             // GLOpcodeCopyImageFromBuffer
+    GetFixedGLCommandSize<GLCmdCopyFramebufferSubData>,                      // GLOpcodeCopyFramebufferSubData
+    GetFixedGLCommandSize<GLCmdGenerateMipmap>,                              // GLOpcodeGenerateMipmap
+    GetFixedGLCommandSize<GLCmdGenerateMipmapSubresource>,                   // GLOpcodeGenerateMipmapSubresource
+    GetFixedGLCommandSize<GLCmdExecute>,                                     // GLOpcodeExecute
+    GetFixedGLCommandSize<GLCmdViewport>,                                    // GLOpcodeViewport
+    GetViewportArraySize,                                                    // GLOpcodeViewportArray
+    GetFixedGLCommandSize<GLCmdScissor>,                                     // GLOpcodeScissor
+    GetScissorArraySize,                                                     // GLOpcodeScissorArray
+    GetFixedGLCommandSize<GLCmdClearColor>,                                  // GLOpcodeClearColor
+    GetFixedGLCommandSize<GLCmdClearDepth>,                                  // GLOpcodeClearDepth
+    GetFixedGLCommandSize<GLCmdClearStencil>,                                // GLOpcodeClearStencil
+    GetFixedGLCommandSize<GLCmdClear>,                                       // GLOpcodeClear
+    GetClearAttachmentsWithRenderPassSize,                                   // GLOpcodeClearAttachmentsWithRenderPass
+    GetClearBuffersSize,                                                     // GLOpcodeClearBuffers
+    GetFixedGLCommandSize<GLCmdResolveRenderTarget>,                         // GLOpcodeResolveRenderTarget
+    GetFixedGLCommandSize<GLCmdBindVertexArray>,                             // GLOpcodeBindVertexArray
+    GetBuildVertexArraySize,                                                 // GLOpcodeBuildVertexArray
+    GetFixedGLCommandSize<GLCmdBindElementArrayBufferToVAO>,                 // GLOpcodeBindElementArrayBufferToVAO
+    GetFixedGLCommandSize<GLCmdBindBufferBase>,                              // GLOpcodeBindBufferBase
+    GetBindBuffersBaseSize,                                                  // GLOpcodeBindBuffersBase
+    GetFixedGLCommandSize<GLCmdBeginBufferXfb>,                              // GLOpcodeBeginBufferXfb
+    GetEmptyGLCommandSize,                                                   // GLOpcodeEndBufferXfb
+    GetFixedGLCommandSize<GLCmdBeginTransformFeedback>,                      // GLOpcodeBeginTransformFeedback
+    GetFixedGLCommandSize<GLCmdBeginTransformFeedbackNV>,                    // GLOpcodeBeginTransformFeedbackNV
+    GetEmptyGLCommandSize,                                                   // GLOpcodeEndTransformFeedback
+    GetEmptyGLCommandSize,                                                   // GLOpcodeEndTransformFeedbackNV
+    GetFixedGLCommandSize<GLCmdBindResourceHeap>,                            // GLOpcodeBindResourceHeap
+    GetFixedGLCommandSize<GLCmdBindRenderTarget>,                            // GLOpcodeBindRenderTarget
+    GetFixedGLCommandSize<GLCmdBindPipelineState>,                           // GLOpcodeBindPipelineState
+    GetFixedGLCommandSize<GLCmdSetBlendColor>,                               // GLOpcodeSetBlendColor
+    GetFixedGLCommandSize<GLCmdSetStencilRef>,                               // GLOpcodeSetStencilRef
+    GetSetUniformSize,                                                       // GLOpcodeSetUniform
+    GetFixedGLCommandSize<GLCmdBeginQuery>,                                  // GLOpcodeBeginQuery
+    GetFixedGLCommandSize<GLCmdEndQuery>,                                    // GLOpcodeEndQuery
+    GetFixedGLCommandSize<GLCmdBeginConditionalRender>,                      // GLOpcodeBeginConditionalRender
+    GetEmptyGLCommandSize,                                                   // GLOpcodeEndConditionalRender
+    GetFixedGLCommandSize<GLCmdDrawArrays>,                                  // GLOpcodeDrawArrays
+    GetFixedGLCommandSize<GLCmdDrawArraysInstanced>,                         // GLOpcodeDrawArraysInstanced
+    GetFixedGLCommandSize<GLCmdDrawArraysInstancedBaseInstance>,             // GLOpcodeDrawArraysInstancedBaseInstance
+    GetFixedGLCommandSize<GLCmdDrawArraysIndirect>,                          // GLOpcodeDrawArraysIndirect
+    GetFixedGLCommandSize<GLCmdDrawElements>,                                // GLOpcodeDrawElements
+    GetFixedGLCommandSize<GLCmdDrawElementsBaseVertex>,                      // GLOpcodeDrawElementsBaseVertex
+    GetFixedGLCommandSize<GLCmdDrawElementsInstanced>,                       // GLOpcodeDrawElementsInstanced
+    GetFixedGLCommandSize<GLCmdDrawElementsInstancedBaseVertex>,             // GLOpcodeDrawElementsInstancedBaseVertex
+    GetFixedGLCommandSize<GLCmdDrawElementsInstancedBaseVertexBaseInstance>, // GLOpcodeDrawElementsInstancedBaseVertexBaseInstance
+    GetFixedGLCommandSize<GLCmdDrawElementsIndirect>,                        // GLOpcodeDrawElementsIndirect
+    GetFixedGLCommandSize<GLCmdDrawTransformFeedback>,                       // GLOpcodeDrawTransformFeedback
+    GetFixedGLCommandSize<GLCmdDrawEmulatedTransformFeedback>,               // GLOpcodeDrawEmulatedTransformFeedback
+    GetFixedGLCommandSize<GLCmdMultiDrawArraysIndirect>,                     // GLOpcodeMultiDrawArraysIndirect
+    GetFixedGLCommandSize<GLCmdMultiDrawElementsIndirect>,                   // GLOpcodeMultiDrawElementsIndirect
+    GetFixedGLCommandSize<GLCmdDispatchCompute>,                             // GLOpcodeDispatchCompute
+    GetFixedGLCommandSize<GLCmdDispatchComputeIndirect>,                     // GLOpcodeDispatchComputeIndirect
+    GetFixedGLCommandSize<GLCmdBindTexture>,                                 // GLOpcodeBindTexture
+    GetFixedGLCommandSize<GLCmdBindTextureNative>,                           // GLOpcodeBindTextureNative
+    GetFixedGLCommandSize<GLCmdBindImageTexture>,                            // GLOpcodeBindImageTexture
+    GetFixedGLCommandSize<GLCmdBindSampler>,                                 // GLOpcodeBindSampler
+    GetFixedGLCommandSize<GLCmdBindEmulatedSampler>,                         // GLOpcodeBindEmulatedSampler
+    GetFixedGLCommandSize<GLCmdMemoryBarrier>,                               // GLOpcodeMemoryBarrier
+    GetPushDebugGroupSize,                                                   // GLOpcodePushDebugGroup
+    GetEmptyGLCommandSize,                                                   // GLOpcodePopDebugGroup
+};
+
+static_assert(
+    sizeof(g_glCommandSizeFuncs)/sizeof(g_glCommandSizeFuncs[0]) == GLOpcodePopDebugGroup + 1,
+    "g_glCommandSizeFuncs[] must have an entry for each GLOpcode"
+);
+
+std::size_t GetGLCommandSize(const GLOpcode opcode, const void* pc)
+{
+    return g_glCommandSizeFuncs[opcode](pc);
+}
+
+static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager*& stateMngr)
+{
+    const std::size_t size = g_glCommandFuncs[opcode](pc, stateMngr);
+    LLGL_DEBUG_ASSERT(size == GetGLCommandSize(opcode, pc), "mismatch between executed and declared payload size of GL command (opcode %d)", static_cast<int>(opcode));
+    return size;
 }
 
 static void ExecuteGLCommandsEmulated(const GLVirtualCommandBuffer& virtualCmdBuffer, GLStateManager* stateMngr)
@@ -535,10 +884,31 @@ static void ExecuteGLCommandsEmulated(const GLVirtualCommandBuffer& virtualCmdBu
     virtualCmdBuffer.Run(ExecuteGLCommand, stateMngr);
 }
 
+static void ExecuteGLCompiledCommands(const GLCompiledCommandBuffer& compiledCmdBuffer, GLStateManager* stateMngr)
+{
+    for (const GLCompiledCommand& cmd : compiledCmdBuffer)
+        cmd.func(cmd.pc, stateMngr);
+}
+
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
 {
-    /* Emulate execution of GL commands */
-    ExecuteGLCommandsEmulated(cmdBuffer.GetVirtualCommandBuffer(), &stateMngr);
+    /* Emulate execution of GL commands, either pre-decoded or directly from the virtual command buffer */
+    if (const GLCompiledCommandBuffer* compiledCmdBuffer = cmdBuffer.GetCompiledCommandBuffer())
+        ExecuteGLCompiledCommands(*compiledCmdBuffer, &stateMngr);
+    else
+        ExecuteGLCommandsEmulated(cmdBuffer.GetVirtualCommandBuffer(), &stateMngr);
+}
+
+void CompileGLVirtualCommandBuffer(const GLVirtualCommandBuffer& virtualCmdBuffer, GLCompiledCommandBuffer& outCompiledCmdBuffer)
+{
+    outCompiledCmdBuffer.clear();
+    virtualCmdBuffer.Run(
+        [&outCompiledCmdBuffer](const GLOpcode opcode, const char* pc) -> std::size_t
+        {
+            outCompiledCmdBuffer.push_back(GLCompiledCommand{ g_glCommandFuncs[opcode], pc });
+            return GetGLCommandSize(opcode, pc);
+        }
+    );
 }
 
 void ExecuteGLCommandBuffer(const GLCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
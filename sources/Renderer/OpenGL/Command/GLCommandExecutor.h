@@ -9,6 +9,9 @@
 #define LLGL_GL_COMMAND_EXECUTOR_H
 
 
+#include "GLDeferredCommandBuffer.h"
+
+
 namespace LLGL
 {
 
@@ -17,7 +20,6 @@ namespace OpenGL { struct NativeCommand; }
 
 class GLStateManager;
 class GLCommandBuffer;
-class GLDeferredCommandBuffer;
 
 /*
 Executes all GL commands that have been recorded in the specified command buffer.
@@ -26,6 +28,15 @@ GL render states are tracked with the specified state manager.
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 void ExecuteGLCommandBuffer(const GLCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 
+/*
+Compiles the specified virtual command buffer into a list of pre-decoded GL commands.
+This resolves the opcodes and payload sizes once, so that replaying the compiled commands only has to call one function per command.
+*/
+void CompileGLVirtualCommandBuffer(const GLVirtualCommandBuffer& virtualCmdBuffer, GLCompiledCommandBuffer& outCompiledCmdBuffer);
+
+// Returns the size (in bytes) of the payload of the specified command, i.e. the same size the command executor advances the program counter by.
+std::size_t GetGLCommandSize(const GLOpcode opcode, const void* pc);
+
 // Executes the specified native GL command.
 void ExecuteNativeGLCommand(const OpenGL::NativeCommand& cmd, GLStateManager& stateMngr);
 
@@ -0,0 +1,482 @@
+/*
+ * GLCommandOptimizer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "GLCommandOptimizer.h"
+#include "GLCommandExecutor.h"
+#include "GLCommand.h"
+#include "../OpenGL.h"
+#include "../RenderState/GLPipelineState.h"
+#include <LLGL/IndirectArguments.h>
+#include <LLGL/Utils/ForRange.h>
+#include <vector>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Commands are copied with the biggest alignment of pointers and depth ranges, which covers all command structures.
+static constexpr std::size_t g_commandAlignment = (alignof(GLCmdViewport) > alignof(GLCmdDrawElementsIndirect) ? alignof(GLCmdViewport) : alignof(GLCmdDrawElementsIndirect));
+
+// Merged indirect draw commands are written with any of the four indirect draw command structures.
+static constexpr std::size_t g_maxIndirectDrawCommandSize = sizeof(GLCmdDrawElementsIndirect);
+
+static_assert(sizeof(GLCmdDrawArraysIndirect)           <= g_maxIndirectDrawCommandSize, "GLCmdDrawArraysIndirect exceeds expected command size");
+static_assert(sizeof(GLCmdMultiDrawArraysIndirect)      <= g_maxIndirectDrawCommandSize, "GLCmdMultiDrawArraysIndirect exceeds expected command size");
+static_assert(sizeof(GLCmdMultiDrawElementsIndirect)    <= g_maxIndirectDrawCommandSize, "GLCmdMultiDrawElementsIndirect exceeds expected command size");
+
+static constexpr std::size_t g_invalidCommandIndex = ~static_cast<std::size_t>(0);
+
+// Range of indirect draw commands with contiguous arguments in the same buffer.
+struct GLIndirectDrawRange
+{
+    bool            indexed;
+    GLuint          id;
+    GLenum          mode;
+    GLenum          type;
+    GLintptr        indirect;
+    std::uint32_t   count;
+    std::uint32_t   stride; // Distance between arguments (in bytes). Only 0 if the range contains a single draw command.
+};
+
+struct GLCommandEntry
+{
+    GLOpcode            opcode;
+    const char*         data;
+    std::size_t         size;
+    bool                removed;
+    bool                merged;     // Command is replaced by the merged indirect draw range.
+    GLIndirectDrawRange drawRange;
+};
+
+// Returns true if the specified command is an indirect draw command and stores its argument range in 'outRange'.
+static bool GetIndirectDrawRange(const GLCommandEntry& entry, GLIndirectDrawRange& outRange)
+{
+    switch (entry.opcode)
+    {
+        case GLOpcodeDrawArraysIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(entry.data);
+            outRange = GLIndirectDrawRange{ false, cmd->id, cmd->mode, 0, cmd->indirect, cmd->numCommands, (cmd->numCommands > 1 ? cmd->stride : 0u) };
+            return (cmd->numCommands == 1 || cmd->stride > 0);
+        }
+        case GLOpcodeDrawElementsIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(entry.data);
+            outRange = GLIndirectDrawRange{ true, cmd->id, cmd->mode, cmd->type, cmd->indirect, cmd->numCommands, (cmd->numCommands > 1 ? cmd->stride : 0u) };
+            return (cmd->numCommands == 1 || cmd->stride > 0);
+        }
+        case GLOpcodeMultiDrawArraysIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(entry.data);
+            const std::uint32_t stride = (cmd->stride > 0 ? static_cast<std::uint32_t>(cmd->stride) : static_cast<std::uint32_t>(sizeof(DrawIndirectArguments)));
+            outRange = GLIndirectDrawRange{ false, cmd->id, cmd->mode, 0, reinterpret_cast<GLintptr>(cmd->indirect), static_cast<std::uint32_t>(cmd->drawcount), stride };
+            return (cmd->drawcount > 0);
+        }
+        case GLOpcodeMultiDrawElementsIndirect:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(entry.data);
+            const std::uint32_t stride = (cmd->stride > 0 ? static_cast<std::uint32_t>(cmd->stride) : static_cast<std::uint32_t>(sizeof(DrawIndexedIndirectArguments)));
+            outRange = GLIndirectDrawRange{ true, cmd->id, cmd->mode, cmd->type, reinterpret_cast<GLintptr>(cmd->indirect), static_cast<std::uint32_t>(cmd->drawcount), stride };
+            return (cmd->drawcount > 0);
+        }
+        default:
+            return false;
+    }
+}
+
+// Appends the indirect draw range 'next' to 'range' if they are compatible and their arguments are contiguous in the same buffer.
+static bool MergeIndirectDrawRanges(GLIndirectDrawRange& range, const GLIndirectDrawRange& next)
+{
+    if (range.indexed != next.indexed || range.id != next.id || range.mode != next.mode || range.type != next.type)
+        return false;
+
+    /* Determine distance between arguments; single draw commands take the distance to the next range */
+    std::uint32_t stride = range.stride;
+    if (stride == 0)
+    {
+        if (next.stride != 0)
+            stride = next.stride;
+        else if (next.indirect > range.indirect)
+            stride = static_cast<std::uint32_t>(next.indirect - range.indirect);
+        else
+            return false;
+    }
+    else if (next.stride != 0 && next.stride != stride)
+        return false;
+
+    /* Multi-draw commands require strides that are a multiple of 4 and don't overlap the arguments */
+    const std::uint32_t argumentsSize = static_cast<std::uint32_t>(range.indexed ? sizeof(DrawIndexedIndirectArguments) : sizeof(DrawIndirectArguments));
+    if (stride < argumentsSize || stride % 4 != 0)
+        return false;
+
+    if (next.indirect != range.indirect + static_cast<GLintptr>(range.count) * static_cast<GLintptr>(stride))
+        return false;
+
+    range.count += next.count;
+    range.stride = stride;
+    return true;
+}
+
+static bool IsDrawOrDispatchOpcode(const GLOpcode opcode)
+{
+    return (opcode >= GLOpcodeDrawArrays && opcode <= GLOpcodeDispatchComputeIndirect);
+}
+
+static bool IsEqualViewport(const GLCmdViewport& lhs, const GLCmdViewport& rhs)
+{
+    return
+    (
+        lhs.viewport.x              == rhs.viewport.x               &&
+        lhs.viewport.y              == rhs.viewport.y               &&
+        lhs.viewport.width          == rhs.viewport.width           &&
+        lhs.viewport.height         == rhs.viewport.height          &&
+        lhs.depthRange.minDepth     == rhs.depthRange.minDepth      &&
+        lhs.depthRange.maxDepth     == rhs.depthRange.maxDepth
+    );
+}
+
+static bool IsEqualScissor(const GLCmdScissor& lhs, const GLCmdScissor& rhs)
+{
+    return
+    (
+        lhs.scissor.x       == rhs.scissor.x        &&
+        lhs.scissor.y       == rhs.scissor.y        &&
+        lhs.scissor.width   == rhs.scissor.width    &&
+        lhs.scissor.height  == rhs.scissor.height
+    );
+}
+
+static bool IsEqualResourceHeap(const GLCmdBindResourceHeap& lhs, const GLCmdBindResourceHeap& rhs)
+{
+    return
+    (
+        lhs.resourceHeap        == rhs.resourceHeap     &&
+        lhs.descriptorSet       == rhs.descriptorSet    &&
+        lhs.bufferInterfaceMap  == rhs.bufferInterfaceMap
+    );
+}
+
+
+/*
+ * GLCommandPeepholeOptimizer class
+ */
+
+// Tracks the last setter of each optimized state: 'known' is the command whose value is currently set and 'pending' the setter that has not been used by any command yet.
+class GLCommandPeepholeOptimizer
+{
+
+    public:
+
+        GLCommandPeepholeOptimizer(std::vector<GLCommandEntry>& entries) :
+            entries_ { entries }
+        {
+        }
+
+        void Run()
+        {
+            for_range(i, entries_.size())
+                Process(i);
+        }
+
+    private:
+
+        template <typename TCommand>
+        const TCommand* GetCommand(std::size_t index) const
+        {
+            return reinterpret_cast<const TCommand*>(entries_[index].data);
+        }
+
+        // Removes the setter that was overwritten before it was used.
+        void RemovePending(std::size_t& pending)
+        {
+            if (pending != g_invalidCommandIndex)
+            {
+                entries_[pending].removed = true;
+                pending = g_invalidCommandIndex;
+            }
+        }
+
+        // Marks all pending setters as used.
+        void ConsumePending()
+        {
+            pendingViewport_    = g_invalidCommandIndex;
+            pendingScissor_     = g_invalidCommandIndex;
+            pendingPSO_         = g_invalidCommandIndex;
+            pendingVAO_         = g_invalidCommandIndex;
+        }
+
+        // Marks all pending setters as used and forgets the known state.
+        void Invalidate()
+        {
+            ConsumePending();
+            knownViewport_      = g_invalidCommandIndex;
+            knownScissor_       = g_invalidCommandIndex;
+            knownPSO_           = g_invalidCommandIndex;
+            knownVAO_           = g_invalidCommandIndex;
+            knownResourceHeap_  = g_invalidCommandIndex;
+        }
+
+        void Process(std::size_t index)
+        {
+            GLCommandEntry& entry = entries_[index];
+            switch (entry.opcode)
+            {
+                case GLOpcodeViewport:
+                {
+                    if (knownViewport_ != g_invalidCommandIndex && IsEqualViewport(*GetCommand<GLCmdViewport>(knownViewport_), *GetCommand<GLCmdViewport>(index)))
+                        entry.removed = true;
+                    else
+                    {
+                        RemovePending(pendingViewport_);
+                        pendingViewport_    = index;
+                        knownViewport_      = index;
+                    }
+                }
+                break;
+
+                case GLOpcodeScissor:
+                {
+                    if (knownScissor_ != g_invalidCommandIndex && IsEqualScissor(*GetCommand<GLCmdScissor>(knownScissor_), *GetCommand<GLCmdScissor>(index)))
+                        entry.removed = true;
+                    else
+                    {
+                        RemovePending(pendingScissor_);
+                        pendingScissor_ = index;
+                        knownScissor_   = index;
+                    }
+                }
+                break;
+
+                case GLOpcodeBindVertexArray:
+                {
+                    if (knownVAO_ != g_invalidCommandIndex && GetCommand<GLCmdBindVertexArray>(knownVAO_)->vertexArray == GetCommand<GLCmdBindVertexArray>(index)->vertexArray)
+                        entry.removed = true;
+                    else
+                    {
+                        RemovePending(pendingVAO_);
+                        pendingVAO_ = index;
+                        knownVAO_   = index;
+                    }
+                }
+                break;
+
+                case GLOpcodeBindPipelineState:
+                {
+                    /* Re-binding a PSO with static states is not redundant, because it re-applies its static viewports, scissors, and samplers */
+                    GLPipelineState* pipelineState = GetCommand<GLCmdBindPipelineState>(index)->pipelineState;
+                    if (knownPSO_ != g_invalidCommandIndex && GetCommand<GLCmdBindPipelineState>(knownPSO_)->pipelineState == pipelineState && !pipelineState->HasStaticState())
+                        entry.removed = true;
+                    else
+                    {
+                        /* Only remove overwritten PSO if the new PSO sets the same kind of states and the previous PSO has no side effects */
+                        if (pendingPSO_ != g_invalidCommandIndex)
+                        {
+                            GLPipelineState* pendingPipelineState = GetCommand<GLCmdBindPipelineState>(pendingPSO_)->pipelineState;
+                            if (pendingPipelineState->IsGraphicsPSO() == pipelineState->IsGraphicsPSO() && !pendingPipelineState->HasStaticState())
+                                RemovePending(pendingPSO_);
+                        }
+                        pendingPSO_ = index;
+                        knownPSO_   = index;
+
+                        /* Static states of the PSO overwrite viewports, scissors, and samplers of the resource heap */
+                        if (pipelineState->HasStaticState())
+                        {
+                            pendingViewport_    = g_invalidCommandIndex;
+                            pendingScissor_     = g_invalidCommandIndex;
+                            knownViewport_      = g_invalidCommandIndex;
+                            knownScissor_       = g_invalidCommandIndex;
+                            knownResourceHeap_  = g_invalidCommandIndex;
+                        }
+                    }
+                }
+                break;
+
+                case GLOpcodeBindResourceHeap:
+                {
+                    if (knownResourceHeap_ != g_invalidCommandIndex && IsEqualResourceHeap(*GetCommand<GLCmdBindResourceHeap>(knownResourceHeap_), *GetCommand<GLCmdBindResourceHeap>(index)))
+                        entry.removed = true;
+                    else
+                        knownResourceHeap_ = index;
+                }
+                break;
+
+                default:
+                {
+                    if (IsDrawOrDispatchOpcode(entry.opcode))
+                        ConsumePending();
+                    else
+                        Invalidate();
+                }
+                break;
+            }
+
+            /* Merge indirect draw command with the previous one if there is no other command in between */
+            if (!entry.removed)
+            {
+                GLIndirectDrawRange drawRange;
+                if (GetIndirectDrawRange(entry, drawRange))
+                {
+                    if (lastIndirectDraw_ != g_invalidCommandIndex)
+                    {
+                        GLCommandEntry& lastEntry = entries_[lastIndirectDraw_];
+                        if (MergeIndirectDrawRanges(lastEntry.drawRange, drawRange))
+                        {
+                            lastEntry.merged    = true;
+                            entry.removed       = true;
+                            return;
+                        }
+                    }
+                    entry.drawRange     = drawRange;
+                    lastIndirectDraw_   = index;
+                }
+                else
+                    lastIndirectDraw_ = g_invalidCommandIndex;
+            }
+        }
+
+    private:
+
+        std::vector<GLCommandEntry>&    entries_;
+
+        std::size_t                     knownViewport_      = g_invalidCommandIndex;
+        std::size_t                     knownScissor_       = g_invalidCommandIndex;
+        std::size_t                     knownPSO_           = g_invalidCommandIndex;
+        std::size_t                     knownVAO_           = g_invalidCommandIndex;
+        std::size_t                     knownResourceHeap_  = g_invalidCommandIndex;
+
+        std::size_t                     pendingViewport_    = g_invalidCommandIndex;
+        std::size_t                     pendingScissor_     = g_invalidCommandIndex;
+        std::size_t                     pendingPSO_         = g_invalidCommandIndex;
+        std::size_t                     pendingVAO_         = g_invalidCommandIndex;
+
+        std::size_t                     lastIndirectDraw_   = g_invalidCommandIndex;
+
+};
+
+
+/*
+ * Global functions
+ */
+
+// Writes the merged indirect draw range as a single command into the packed buffer.
+static void WriteIndirectDrawRange(GLVirtualCommandBuffer& buffer, const GLIndirectDrawRange& range, bool hasMultiDrawIndirect)
+{
+    if (hasMultiDrawIndirect)
+    {
+        if (range.indexed)
+        {
+            auto cmd = buffer.AllocCommand<GLCmdMultiDrawElementsIndirect>(GLOpcodeMultiDrawElementsIndirect);
+            {
+                cmd->id         = range.id;
+                cmd->mode       = range.mode;
+                cmd->type       = range.type;
+                cmd->indirect   = reinterpret_cast<const GLvoid*>(range.indirect);
+                cmd->drawcount  = static_cast<GLsizei>(range.count);
+                cmd->stride     = static_cast<GLsizei>(range.stride);
+            }
+        }
+        else
+        {
+            auto cmd = buffer.AllocCommand<GLCmdMultiDrawArraysIndirect>(GLOpcodeMultiDrawArraysIndirect);
+            {
+                cmd->id         = range.id;
+                cmd->mode       = range.mode;
+                cmd->indirect   = reinterpret_cast<const GLvoid*>(range.indirect);
+                cmd->drawcount  = static_cast<GLsizei>(range.count);
+                cmd->stride     = static_cast<GLsizei>(range.stride);
+            }
+        }
+    }
+    else
+    {
+        if (range.indexed)
+        {
+            auto cmd = buffer.AllocCommand<GLCmdDrawElementsIndirect>(GLOpcodeDrawElementsIndirect);
+            {
+                cmd->id             = range.id;
+                cmd->numCommands    = range.count;
+                cmd->mode           = range.mode;
+                cmd->type           = range.type;
+                cmd->indirect       = range.indirect;
+                cmd->stride         = range.stride;
+            }
+        }
+        else
+        {
+            auto cmd = buffer.AllocCommand<GLCmdDrawArraysIndirect>(GLOpcodeDrawArraysIndirect);
+            {
+                cmd->id             = range.id;
+                cmd->numCommands    = range.count;
+                cmd->mode           = range.mode;
+                cmd->indirect       = range.indirect;
+                cmd->stride         = range.stride;
+            }
+        }
+    }
+}
+
+void OptimizeGLCommandBuffer(GLVirtualCommandBuffer& buffer, bool hasMultiDrawIndirect)
+{
+    if (buffer.Empty())
+        return;
+
+    /* Gather all commands of the virtual command buffer */
+    std::vector<GLCommandEntry> entries;
+    buffer.Run(
+        [&entries](const GLOpcode opcode, const char* pc) -> std::size_t
+        {
+            const std::size_t size = GetGLCommandSize(opcode, pc);
+            entries.push_back(GLCommandEntry{ opcode, pc, size, false, false, GLIndirectDrawRange{} });
+            return size;
+        }
+    );
+
+    /* Remove redundant state changes and merge indirect draw commands */
+    GLCommandPeepholeOptimizer optimizer{ entries };
+    optimizer.Run();
+
+    /* Pack remaining commands into a single memory chunk */
+    std::size_t packedCapacity = 0;
+    for (const GLCommandEntry& entry : entries)
+    {
+        if (entry.merged)
+            packedCapacity += GLVirtualCommandBuffer::GetCommandCapacity(g_maxIndirectDrawCommandSize, g_commandAlignment);
+        else if (!entry.removed)
+            packedCapacity += GLVirtualCommandBuffer::GetCommandCapacity(entry.size, g_commandAlignment);
+    }
+
+    GLVirtualCommandBuffer packedBuffer{ packedCapacity };
+
+    for (const GLCommandEntry& entry : entries)
+    {
+        if (entry.removed)
+            continue;
+
+        if (entry.merged)
+            WriteIndirectDrawRange(packedBuffer, entry.drawRange, hasMultiDrawIndirect);
+        else
+        {
+            char* data = packedBuffer.AllocCommandData(entry.opcode, entry.size, g_commandAlignment);
+            ::memcpy(data, entry.data, entry.size);
+        }
+    }
+
+    buffer = std::move(packedBuffer);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,36 @@
+/*
+ * GLCommandOptimizer.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_GL_COMMAND_OPTIMIZER_H
+#define LLGL_GL_COMMAND_OPTIMIZER_H
+
+
+#include "GLDeferredCommandBuffer.h"
+
+
+namespace LLGL
+{
+
+
+/*
+Optimizes the specified virtual command buffer with a peephole pass and packs it into a single memory chunk:
+- Removes viewport, scissor, PSO, VAO, and resource heap bindings that are redundant or overwritten before they are used by a draw or dispatch command.
+- Merges consecutive indirect draw commands with contiguous arguments in the same buffer.
+  Merged draws are converted to multi-draw commands if 'hasMultiDrawIndirect' is true, in which case gl_DrawID enumerates the merged draws.
+All other commands act as barriers, i.e. the state they depend on or modify is never optimized across them.
+*/
+void OptimizeGLCommandBuffer(GLVirtualCommandBuffer& buffer, bool hasMultiDrawIndirect);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
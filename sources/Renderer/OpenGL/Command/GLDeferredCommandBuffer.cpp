@@ -7,6 +7,8 @@
 
 #include "GLDeferredCommandBuffer.h"
 #include "GLCommand.h"
+#include "GLCommandOptimizer.h"
+#include "GLCommandExecutor.h"
 #include <LLGL/Constants.h>
 #include <LLGL/TypeInfo.h>
 
@@ -45,9 +47,11 @@ namespace LLGL
 {
 
 
-GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t initialBufferSize) :
-    flags_  { flags             },
-    buffer_ { initialBufferSize }
+GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, bool optimizeCommands, bool compileCommands, std::size_t initialBufferSize) :
+    flags_              { flags                                                                 },
+    optimizeCommands_   { optimizeCommands && (flags & CommandBufferFlags::MultiSubmit) != 0    },
+    compileCommands_    { compileCommands && (flags & CommandBufferFlags::MultiSubmit) != 0     },
+    buffer_             { initialBufferSize                                                     }
 {
 }
 
@@ -57,12 +61,30 @@ void GLDeferredCommandBuffer::Begin()
 {
     /* Reset internal command buffer */
     buffer_.Clear();
+    compiledBuffer_.clear();
     ResetRenderState();
+
+    /* Secondary command buffers are encoded independently of their primary command buffers, so they inherit the index buffer at execution time */
+    if (!IsPrimary())
+        InheritIndexFormat();
 }
 
 void GLDeferredCommandBuffer::End()
 {
-    // dummy
+    /* Optimize command buffers that are submitted multiple times */
+    if (optimizeCommands_)
+    {
+        #ifndef __APPLE__
+        const bool hasMultiDrawIndirect = HasExtension(GLExt::ARB_multi_draw_indirect);
+        #else
+        const bool hasMultiDrawIndirect = false;
+        #endif
+        OptimizeGLCommandBuffer(buffer_, hasMultiDrawIndirect);
+    }
+
+    /* Pre-decode commands after they have been optimized */
+    if (compileCommands_)
+        CompileGLVirtualCommandBuffer(buffer_, compiledBuffer_);
 }
 
 void GLDeferredCommandBuffer::Execute(CommandBuffer& secondaryCommandBuffer)
@@ -76,9 +98,12 @@ void GLDeferredCommandBuffer::Execute(CommandBuffer& secondaryCommandBuffer)
             auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
             if (!deferredCmdBufferGL.IsPrimary())
             {
-                /* Encode GL command */
+                /* Encode GL command; the secondary command buffer is referenced, not copied */
                 auto cmd = AllocCommand<GLCmdExecute>(GLOpcodeExecute);
                 cmd->commandBuffer = &deferredCmdBufferGL;
+
+                /* Continue encoding with the states the secondary command buffer leaves behind */
+                MergeRenderState(deferredCmdBufferGL);
             }
         }
     }
@@ -372,6 +397,7 @@ void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer)
     auto cmd = AllocCommand<GLCmdBindElementArrayBufferToVAO>(GLOpcodeBindElementArrayBufferToVAO);
     cmd->id = bufferGL.GetID();
     cmd->indexType16Bits = bufferGL.IsIndexType16Bits();
+    cmd->offset = 0;
     SetIndexFormat(bufferGL.IsIndexType16Bits(), 0);
 }
 
@@ -382,6 +408,7 @@ void GLDeferredCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format
     auto cmd = AllocCommand<GLCmdBindElementArrayBufferToVAO>(GLOpcodeBindElementArrayBufferToVAO);
     cmd->id = bufferGL.GetID();
     cmd->indexType16Bits = indexType16Bits;
+    cmd->offset = static_cast<GLsizeiptr>(offset);
     SetIndexFormat(indexType16Bits, offset);
 }
 
@@ -393,7 +420,8 @@ void GLDeferredCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::u
     {
         cmd->resourceHeap       = LLGL_CAST(GLResourceHeap*, &resourceHeap);
         cmd->descriptorSet      = descriptorSet;
-        cmd->bufferInterfaceMap = GetBoundPipelineState()->GetBufferInterfaceMap();
+        /* Without a bound PSO, the buffer interfaces are resolved from the PSO that is bound when this command is executed */
+        cmd->bufferInterfaceMap = (GetBoundPipelineState() != nullptr ? GetBoundPipelineState()->GetBufferInterfaceMap() : nullptr);
     }
     #if LLGL_GLEXT_MEMORY_BARRIERS
     InvalidateMemoryBarriers(GL_SHADER_STORAGE_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT); //TODO: find optimal bitmask from resource heap
@@ -402,6 +430,10 @@ void GLDeferredCommandBuffer::SetResourceHeap(ResourceHeap& resourceHeap, std::u
 
 void GLDeferredCommandBuffer::SetResource(std::uint32_t descriptor, Resource& resource)
 {
+    /*
+    Individual resources are translated into GL binding commands at encoding time, so they cannot be resolved against a PSO
+    that is inherited from the primary command buffer. Secondary command buffers must bind their own PSO before this call.
+    */
     auto* pipelineLayoutGL = GetBoundPipelineLayout();
     if (pipelineLayoutGL == nullptr)
         return /*GL_INVALID_VALUE*/;
@@ -1095,18 +1127,19 @@ void GLDeferredCommandBuffer::PushDebugGroup(const char* name)
     #if LLGL_GLEXT_DEBUG
     if (HasExtension(GLExt::KHR_debug))
     {
-        /* Push debug group name into command stream with default ID no. */
-        const GLint         maxLength       = GLStateManager::Get().GetLimits().maxDebugNameLength;
-        const GLuint        id              = 0;
-        const std::size_t   actualLength    = std::strlen(name);
-        const std::size_t   croppedLength   = std::min(actualLength, static_cast<std::size_t>(maxLength));
+        /*
+        Push debug group name into command stream with default ID no.
+        The name is cropped at execution time, so encoding does not depend on the state of any GL context.
+        */
+        const GLuint        id      = 0;
+        const std::size_t   length  = std::strlen(name);
 
-        auto cmd = AllocCommand<GLCmdPushDebugGroup>(GLOpcodePushDebugGroup, croppedLength + 1);
+        auto cmd = AllocCommand<GLCmdPushDebugGroup>(GLOpcodePushDebugGroup, length + 1);
         {
             cmd->source = GL_DEBUG_SOURCE_APPLICATION;
             cmd->id     = id;
-            cmd->length = static_cast<GLsizei>(croppedLength);
-            ::memcpy(cmd + 1, name, croppedLength + 1);
+            cmd->length = static_cast<GLsizei>(length);
+            ::memcpy(cmd + 1, name, length + 1);
         }
     }
     #endif // /LLGL_GLEXT_DEBUG
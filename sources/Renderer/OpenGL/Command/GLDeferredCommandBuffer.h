@@ -33,6 +33,19 @@ class GLEmulatedSampler;
 
 using GLVirtualCommandBuffer = VirtualCommandBuffer<GLOpcode>;
 
+// Function to execute a single GL command with its payload. Returns the size (in bytes) of the payload.
+using GLCommandFunc = std::size_t (*)(const void* pc, GLStateManager*& stateMngr);
+
+// Pre-decoded GL command, i.e. the function that executes the command and a pointer to its payload.
+struct GLCompiledCommand
+{
+    GLCommandFunc   func;
+    const void*     pc;
+};
+
+// Compiled command buffer, which refers to the commands of a virtual command buffer and is only valid until that buffer is modified.
+using GLCompiledCommandBuffer = std::vector<GLCompiledCommand>;
+
 class GLDeferredCommandBuffer final : public GLCommandBuffer
 {
 
@@ -42,7 +55,7 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
     public:
 
-        GLDeferredCommandBuffer(long flags, std::size_t initialBufferSize = 1024);
+        GLDeferredCommandBuffer(long flags, bool optimizeCommands = false, bool compileCommands = false, std::size_t initialBufferSize = 1024);
 
     public:
 
@@ -58,6 +71,12 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             return buffer_;
         }
 
+        // Returns the pre-decoded commands if this command buffer is compiled when its encoding ends. Otherwise, null.
+        inline const GLCompiledCommandBuffer* GetCompiledCommandBuffer() const
+        {
+            return (compileCommands_ ? &compiledBuffer_ : nullptr);
+        }
+
         // Returns the flags this command buffer was created with (see CommandBufferDescriptor::flags).
         inline long GetFlags() const
         {
@@ -89,7 +108,10 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
     private:
 
         long                    flags_                  = 0;
+        bool                    optimizeCommands_       = false;
+        bool                    compileCommands_        = false;
         GLVirtualCommandBuffer  buffer_;
+        GLCompiledCommandBuffer compiledBuffer_;
         GLRenderTarget*         renderTargetToResolve_  = nullptr;
 
 };
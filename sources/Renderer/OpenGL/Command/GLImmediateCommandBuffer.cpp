@@ -72,6 +72,7 @@ void GLImmediateCommandBuffer::Execute(CommandBuffer& secondaryCommandBuffer)
 {
     auto& cmdBufferGL = LLGL_CAST(const GLCommandBuffer&, secondaryCommandBuffer);
     ExecuteGLCommandBuffer(cmdBufferGL, *stateMngr_);
+    MergeRenderState(cmdBufferGL);
 }
 
 /* ----- Blitting ----- */
@@ -335,7 +336,7 @@ void GLImmediateCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format forma
     /* Bind index buffer deferred (can only be bound to the active VAO) */
     auto& bufferGL = LLGL_CAST(GLBuffer&, buffer);
     const bool indexType16Bits = (format == Format::R16UInt);
-    stateMngr_->BindElementArrayBufferToVAO(bufferGL.GetID(), indexType16Bits);
+    stateMngr_->BindElementArrayBufferToVAO(bufferGL.GetID(), indexType16Bits, static_cast<GLsizeiptr>(offset));
     SetIndexFormat(indexType16Bits, offset);
 }
 
@@ -106,7 +106,10 @@ CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
     if ((commandBufferDesc.flags & CommandBufferFlags::ImmediateSubmit) != 0)
         return commandBuffers_.emplace<GLImmediateCommandBuffer>();
     else
-        return commandBuffers_.emplace<GLDeferredCommandBuffer>(commandBufferDesc.flags);
+    {
+        const RendererConfigurationOpenGL& profile = contextMngr_.GetProfile();
+        return commandBuffers_.emplace<GLDeferredCommandBuffer>(commandBufferDesc.flags, profile.optimizeCommandBuffers, profile.compileCommandBuffers);
+    }
 }
 
 void GLRenderSystem::Release(CommandBuffer& commandBuffer)
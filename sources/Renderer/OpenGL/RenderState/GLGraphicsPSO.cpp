@@ -123,6 +123,17 @@ void GLGraphicsPSO::Bind(GLStateManager& stateMngr)
     SetStaticViewportsAndScissors(stateMngr);
 }
 
+bool GLGraphicsPSO::HasStaticState() const
+{
+    return
+    (
+        GLPipelineState::HasStaticState()                   ||
+        patchVertices_ > 0                                  ||
+        staticStateBuffer_.GetNumViewports() > 0            ||
+        staticStateBuffer_.GetNumScissors() > 0
+    );
+}
+
 
 /*
  * ======= Private: =======
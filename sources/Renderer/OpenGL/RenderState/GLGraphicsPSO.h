@@ -38,6 +38,9 @@ class GLGraphicsPSO final : public GLPipelineState
         // Binds this graphics pipeline state with the specified GL state manager.
         void Bind(GLStateManager& stateMngr) override;
 
+        // Returns true if this PSO has static samplers, viewports, scissors, or a patch size.
+        bool HasStaticState() const override;
+
         // Returns the GL mode for drawing commands (GL_TRIANGLES, GL_TRIANGLE_STRIP, etc.).
         inline GLenum GetDrawMode() const
         {
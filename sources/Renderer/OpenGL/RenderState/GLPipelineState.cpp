@@ -95,6 +95,7 @@ GLPipelineState::~GLPipelineState()
     for (GLShaderPipelineSPtr& shaderPipeline : shaderPipelines_)
         GLStatePool::Get().ReleaseShaderPipeline(std::move(shaderPipeline));
     GLStatePool::Get().ReleaseShaderBindingLayout(std::move(shaderBindingLayout_));
+    GLStateManager::Get().NotifyPipelineStateRelease(this);
 }
 
 const Report* GLPipelineState::GetReport() const
@@ -124,6 +125,13 @@ void GLPipelineState::Bind(GLStateManager& stateMngr)
     /* Bind static samplers */
     if (pipelineLayout_ != nullptr)
         pipelineLayout_->BindStaticSamplers(stateMngr);
+
+    stateMngr.NotifyPipelineStateBind(this);
+}
+
+bool GLPipelineState::HasStaticState() const
+{
+    return (pipelineLayout_ != nullptr && !pipelineLayout_->GetStaticSamplerSlots().empty());
 }
 
 
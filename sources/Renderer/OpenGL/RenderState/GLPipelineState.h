@@ -60,6 +60,9 @@ class GLPipelineState : public PipelineState
         // Binds this pipeline state with the specified GL state manager.
         virtual void Bind(GLStateManager& stateMngr);
 
+        // Returns true if binding this PSO also modifies state that is otherwise set by individual commands, e.g. static samplers.
+        virtual bool HasStaticState() const;
+
         // Returns true if this is a graphics PSO.
         inline bool IsGraphicsPSO() const
         {
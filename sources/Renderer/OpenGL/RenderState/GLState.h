@@ -153,6 +153,7 @@ struct GLRenderState
     GLenum                  indexBufferDataType     = GL_UNSIGNED_INT;
     GLsizeiptr              indexBufferStride       = 4;
     GLsizeiptr              indexBufferOffset       = 0;
+    bool                    indexFormatInherited    = false;    // Index format is resolved at execution time (see GLCommandBuffer::InheritIndexFormat).
     const GLPipelineLayout* boundPipelineLayout     = nullptr;
     const GLPipelineState*  boundPipelineState      = nullptr;
     GLBufferWithXFB*        boundBufferWithFxb      = nullptr;
@@ -314,7 +314,9 @@ void GLStateManager::ClearCache()
     ::memset(boundGLEmulatedSamplers_, 0, sizeof(boundGLEmulatedSamplers_));
 
     boundRenderTarget_          = nullptr;
+    boundPipelineState_         = nullptr;
     indexType16Bits_            = false;
+    indexBufferOffset_          = 0;
     lastVertexAttribArray_      = 0;
     frontFaceInternal_          = GL_CCW;
     flipViewportYPos_           = false;
@@ -1062,13 +1064,16 @@ void GLStateManager::NotifyVertexArrayRelease(GLuint vertexArray)
     InvalidateBoundGLObject(contextState_.boundVertexArray, vertexArray);
 }
 
-void GLStateManager::BindElementArrayBufferToVAO(GLuint buffer, bool indexType16Bits)
+void GLStateManager::BindElementArrayBufferToVAO(GLuint buffer, bool indexType16Bits, GLsizeiptr offset)
 {
+    /* Store index format for draw commands of secondary command buffers that inherit the index buffer */
+    indexType16Bits_    = indexType16Bits;
+    indexBufferOffset_  = offset;
+
     #if LLGL_GLEXT_VERTEX_ARRAY_OBJECT
 
     /* Always store buffer ID to bind the index buffer the next time "BindVertexArray" is called */
-    contextState_.boundElementArrayBuffer   = buffer;
-    indexType16Bits_                        = indexType16Bits;
+    contextState_.boundElementArrayBuffer = buffer;
 
     /* If a valid VAO is currently being bound, bind the specified buffer directly */
     #if LLGL_PRIMITIVE_RESTART
@@ -1732,6 +1737,24 @@ GLuint GLStateManager::GetBoundProgramPipeline() const
 
 #endif // /LLGL_GLEXT_SEPARATE_SHADER_OBJECTS
 
+/* ----- Pipeline state ----- */
+
+void GLStateManager::NotifyPipelineStateBind(const GLPipelineState* pipelineState)
+{
+    boundPipelineState_ = pipelineState;
+}
+
+void GLStateManager::NotifyPipelineStateRelease(const GLPipelineState* pipelineState)
+{
+    if (boundPipelineState_ == pipelineState)
+        boundPipelineState_ = nullptr;
+}
+
+const GLPipelineState* GLStateManager::GetBoundPipelineState() const
+{
+    return boundPipelineState_;
+}
+
 /* ----- Render pass ----- */
 
 void GLStateManager::BindRenderTarget(RenderTarget& renderTarget, GLStateManager** nextStateManager)
@@ -37,6 +37,7 @@ class GLBlendState;
 class GLRenderPass;
 class GLProgramPipeline;
 class GLShaderProgram;
+class GLPipelineState;
 class GLEmulatedSampler;
 
 // OpenGL state machine manager that keeps track of certain GL states.
@@ -182,9 +183,24 @@ class GLStateManager
 
         /**
         \brief Binds the specified GL_ELEMENT_ARRAY_BUFFER (i.e. index buffer) to the next VAO (or the current one).
+        \param[in] offset Specifies the offset (in bytes) of the first index. This is only stored to resolve inherited index formats.
         \see BindVertexArray
+        \see GetIndicesOffset
         */
-        void BindElementArrayBufferToVAO(GLuint buffer, bool indexType16Bits);
+        void BindElementArrayBufferToVAO(GLuint buffer, bool indexType16Bits, GLsizeiptr offset = 0);
+
+        // Returns the index data type of the index buffer that was last bound via BindElementArrayBufferToVAO.
+        inline GLenum GetIndexType() const
+        {
+            return (indexType16Bits_ ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT);
+        }
+
+        // Returns the indices offset as GLvoid pointer of the index buffer that was last bound via BindElementArrayBufferToVAO.
+        inline const GLvoid* GetIndicesOffset(GLintptr firstIndex) const
+        {
+            const GLintptr indices = (indexBufferOffset_ + firstIndex * (indexType16Bits_ ? 2 : 4));
+            return reinterpret_cast<const GLvoid*>(indices);
+        }
 
         void PushBoundBuffer(GLBufferTarget target);
         void PopBoundBuffer();
@@ -274,6 +290,14 @@ class GLStateManager
 
         GLuint GetBoundProgramPipeline() const;
 
+        /* ----- Pipeline state ----- */
+
+        // Stores the pipeline state that was bound last, so commands recorded without a pipeline state can be resolved at execution time.
+        void NotifyPipelineStateBind(const GLPipelineState* pipelineState);
+        void NotifyPipelineStateRelease(const GLPipelineState* pipelineState);
+
+        const GLPipelineState* GetBoundPipelineState() const;
+
         /* ----- Render pass ----- */
 
         void BindRenderTarget(RenderTarget& renderTarget, GLStateManager** nextStateManager = nullptr);
@@ -410,8 +434,10 @@ class GLStateManager
         const GLEmulatedSampler*            boundGLEmulatedSamplers_[GLContextState::numTextureLayers]  = {};
 
         GLRenderTarget*                     boundRenderTarget_          = nullptr;
+        const GLPipelineState*              boundPipelineState_         = nullptr;
 
         bool                                indexType16Bits_            = false;
+        GLsizeiptr                          indexBufferOffset_          = 0;
         GLuint                              lastVertexAttribArray_      = 0;
 
         GLenum                              frontFaceInternal_          = GL_CCW; // actual front face input (without possible inversion)
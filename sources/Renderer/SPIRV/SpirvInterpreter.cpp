@@ -0,0 +1,2052 @@
+/*
+ * SpirvInterpreter.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "SpirvInterpreter.h"
+#include "../../Core/Float16Compressor.h"
+#include <LLGL/Utils/ForRange.h>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+using SpirvInstr = SpirvProgram::Instr;
+
+static constexpr float g_spirvPi = 3.14159265358979323846f;
+
+
+/*
+ * Internal functions
+ */
+
+static SpirvValue FloatValue(float f)
+{
+    SpirvValue value;
+    value.f = f;
+    return value;
+}
+
+static SpirvValue UIntValue(std::uint32_t u)
+{
+    SpirvValue value;
+    value.u = u;
+    return value;
+}
+
+static SpirvValue SIntValue(std::int32_t s)
+{
+    SpirvValue value;
+    value.s = s;
+    return value;
+}
+
+static SpirvValue BoolValue(bool b)
+{
+    return UIntValue(b ? 1u : 0u);
+}
+
+static bool IsLaneActive(std::uint32_t mask, std::uint32_t lane)
+{
+    return (((mask >> lane) & 1u) != 0);
+}
+
+static float Clamp(float x, float minVal, float maxVal)
+{
+    return std::min(std::max(x, minVal), maxVal);
+}
+
+static std::uint32_t FloatToUInt(float f)
+{
+    if (!(f > 0.0f))
+        return 0;
+    if (f >= 4294967296.0f)
+        return UINT_MAX;
+    return static_cast<std::uint32_t>(f);
+}
+
+static std::int32_t FloatToSInt(float f)
+{
+    if (std::isnan(f))
+        return 0;
+    if (f <= -2147483648.0f)
+        return INT_MIN;
+    if (f >= 2147483648.0f)
+        return INT_MAX;
+    return static_cast<std::int32_t>(f);
+}
+
+static std::uint32_t BitFieldMask(std::uint32_t offset, std::uint32_t count)
+{
+    if (count == 0 || offset >= 32)
+        return 0;
+    const std::uint32_t bits = (count >= 32 ? ~0u : ((1u << count) - 1u));
+    return (bits << offset);
+}
+
+static std::uint32_t BitCount(std::uint32_t x)
+{
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    return ((x * 0x01010101u) >> 24);
+}
+
+static std::uint32_t BitReverse(std::uint32_t x)
+{
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+    return ((x >> 16) | (x << 16));
+}
+
+static std::int32_t FindLsb(std::uint32_t x)
+{
+    if (x == 0)
+        return -1;
+    std::int32_t bit = 0;
+    while ((x & 1u) == 0)
+    {
+        x >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+static std::int32_t FindMsb(std::uint32_t x)
+{
+    std::int32_t bit = -1;
+    while (x != 0)
+    {
+        x >>= 1;
+        ++bit;
+    }
+    return bit;
+}
+
+static std::uint32_t PackSnorm(float x, float scale, std::uint32_t mask)
+{
+    return (static_cast<std::uint32_t>(static_cast<std::int32_t>(std::round(Clamp(x, -1.0f, 1.0f) * scale))) & mask);
+}
+
+static std::uint32_t PackUnorm(float x, float scale)
+{
+    return static_cast<std::uint32_t>(std::round(Clamp(x, 0.0f, 1.0f) * scale));
+}
+
+static float QuantizeToF16(float x)
+{
+    return DecompressFloat16(CompressFloat16(x));
+}
+
+// Computes the determinant of a column-major NxN matrix with Gaussian elimination.
+static float ComputeDeterminant(float* m, std::uint32_t n)
+{
+    float det = 1.0f;
+    for_range(c, n)
+    {
+        /* Find pivot row */
+        std::uint32_t pivot = c;
+        for_subrange(r, c + 1, n)
+        {
+            if (std::abs(m[c*n + r]) > std::abs(m[c*n + pivot]))
+                pivot = r;
+        }
+
+        if (m[c*n + pivot] == 0.0f)
+            return 0.0f;
+
+        if (pivot != c)
+        {
+            for_range(k, n)
+                std::swap(m[k*n + c], m[k*n + pivot]);
+            det = -det;
+        }
+
+        det *= m[c*n + c];
+
+        /* Eliminate rows below pivot */
+        for_subrange(r, c + 1, n)
+        {
+            const float f = m[c*n + r] / m[c*n + c];
+            for_subrange(k, c, n)
+                m[k*n + r] -= f * m[k*n + c];
+        }
+    }
+    return det;
+}
+
+// Computes the inverse of a column-major NxN matrix with Gauss-Jordan elimination.
+static void ComputeInverse(float* m, float* inv, std::uint32_t n)
+{
+    for_range(c, n)
+    {
+        for_range(r, n)
+            inv[c*n + r] = (c == r ? 1.0f : 0.0f);
+    }
+
+    for_range(c, n)
+    {
+        std::uint32_t pivot = c;
+        for_subrange(r, c + 1, n)
+        {
+            if (std::abs(m[c*n + r]) > std::abs(m[c*n + pivot]))
+                pivot = r;
+        }
+
+        if (pivot != c)
+        {
+            for_range(k, n)
+            {
+                std::swap(m[k*n + c], m[k*n + pivot]);
+                std::swap(inv[k*n + c], inv[k*n + pivot]);
+            }
+        }
+
+        const float invPivot = 1.0f / m[c*n + c];
+        for_range(k, n)
+        {
+            m[k*n + c] *= invPivot;
+            inv[k*n + c] *= invPivot;
+        }
+
+        for_range(r, n)
+        {
+            if (r != c)
+            {
+                const float f = m[c*n + r];
+                for_range(k, n)
+                {
+                    m[k*n + r] -= f * m[k*n + c];
+                    inv[k*n + r] -= f * inv[k*n + c];
+                }
+            }
+        }
+    }
+}
+
+template <typename TFunc>
+static void ExecUnary(SpirvValue* regs, const SpirvInstr& instr, std::uint32_t mask, TFunc func)
+{
+    for_range(c, instr.count)
+    {
+        SpirvValue*         dst = regs + instr.result  + c*g_spirvNumLanes;
+        const SpirvValue*   a   = regs + instr.args[0] + c*g_spirvNumLanes;
+        for_range(lane, g_spirvNumLanes)
+        {
+            if (IsLaneActive(mask, lane))
+                dst[lane] = func(a[lane]);
+        }
+    }
+}
+
+template <typename TFunc>
+static void ExecBinary(SpirvValue* regs, const SpirvInstr& instr, std::uint32_t mask, TFunc func)
+{
+    for_range(c, instr.count)
+    {
+        SpirvValue*         dst = regs + instr.result  + c*g_spirvNumLanes;
+        const SpirvValue*   a   = regs + instr.args[0] + c*g_spirvNumLanes;
+        const SpirvValue*   b   = regs + instr.args[1] + c*g_spirvNumLanes;
+        for_range(lane, g_spirvNumLanes)
+        {
+            if (IsLaneActive(mask, lane))
+                dst[lane] = func(a[lane], b[lane]);
+        }
+    }
+}
+
+template <typename TFunc>
+static void ExecTernary(SpirvValue* regs, const SpirvInstr& instr, std::uint32_t mask, TFunc func)
+{
+    for_range(c, instr.count)
+    {
+        SpirvValue*         dst = regs + instr.result  + c*g_spirvNumLanes;
+        const SpirvValue*   a   = regs + instr.args[0] + c*g_spirvNumLanes;
+        const SpirvValue*   b   = regs + instr.args[1] + c*g_spirvNumLanes;
+        const SpirvValue*   d   = regs + instr.args[2] + c*g_spirvNumLanes;
+        for_range(lane, g_spirvNumLanes)
+        {
+            if (IsLaneActive(mask, lane))
+                dst[lane] = func(a[lane], b[lane], d[lane]);
+        }
+    }
+}
+
+// Executes an operation whose arguments are vectors of 'instr.count' components for each lane.
+template <typename TFunc>
+static void ExecVector(SpirvValue* regs, const SpirvInstr& instr, std::uint32_t mask, TFunc func)
+{
+    for_range(lane, g_spirvNumLanes)
+    {
+        if (IsLaneActive(mask, lane))
+            func(lane, regs + instr.result + lane, regs + instr.args[0] + lane, regs + instr.args[1] + lane, regs + instr.args[2] + lane);
+    }
+}
+
+static float Dot(const SpirvValue* a, const SpirvValue* b, std::uint32_t n)
+{
+    float sum = 0.0f;
+    for_range(i, n)
+        sum += a[i*g_spirvNumLanes].f * b[i*g_spirvNumLanes].f;
+    return sum;
+}
+
+static void CopyMasked(SpirvValue* dst, const SpirvValue* src, std::uint32_t count, std::uint32_t mask)
+{
+    if (mask == g_spirvAllLanes)
+        std::memmove(dst, src, sizeof(SpirvValue) * count * g_spirvNumLanes);
+    else
+    {
+        for_range(c, count)
+        {
+            for_range(lane, g_spirvNumLanes)
+            {
+                if (IsLaneActive(mask, lane))
+                    dst[c*g_spirvNumLanes + lane] = src[c*g_spirvNumLanes + lane];
+            }
+        }
+    }
+}
+
+
+/*
+ * SpirvInterpreter class
+ */
+
+SpirvInterpreter::SpirvInterpreter(const SpirvProgram& program) :
+    program_            { program                                                       },
+    registers_          { program.GetRegisters()                                        },
+    laneMemory_         ( program.GetLaneStorageSize() * g_spirvNumLanes                ),
+    ownWorkgroupMemory_ ( program.GetWorkgroupStorageSize()                             ),
+    workgroupMemory_    { ownWorkgroupMemory_.data()                                    },
+    buffers_            ( program.GetResources().size()                                 ),
+    images_             ( program.GetNumHandles()                                       )
+{
+}
+
+void SpirvInterpreter::SetImageHandler(SpirvImageHandler* handler)
+{
+    imageHandler_ = handler;
+}
+
+void SpirvInterpreter::SetBuffer(std::uint32_t resource, void* data, std::uint64_t size)
+{
+    if (resource < buffers_.size())
+    {
+        buffers_[resource].data = reinterpret_cast<SpirvValue*>(data);
+        buffers_[resource].size = (data != nullptr ? static_cast<std::uint32_t>(std::min<std::uint64_t>(size / sizeof(SpirvValue), UINT32_MAX)) : 0);
+    }
+}
+
+void SpirvInterpreter::SetImage(std::uint32_t handle, void* image, const void* sampler)
+{
+    if (handle < images_.size())
+    {
+        images_[handle].image   = image;
+        images_[handle].sampler = sampler;
+    }
+}
+
+void SpirvInterpreter::SetWorkgroupMemory(SpirvValue* memory)
+{
+    workgroupMemory_ = (memory != nullptr ? memory : ownWorkgroupMemory_.data());
+}
+
+SpirvValue* SpirvInterpreter::GetSlotData(const SpirvProgram::InterfaceSlot& slot, std::uint32_t lane)
+{
+    const SpirvProgram::Variable& variable = program_.GetVariables()[slot.variable];
+    return laneMemory_.data() + lane * program_.GetLaneStorageSize() + variable.offset + slot.offset;
+}
+
+SpirvInterpreter::Status SpirvInterpreter::Execute(std::uint32_t laneMask, std::uint32_t helperMask)
+{
+    aliveMask_  = (laneMask & g_spirvAllLanes);
+    helperMask_ = (helperMask & aliveMask_);
+
+    frames_.clear();
+    if (aliveMask_ != 0)
+        PushFrame(program_.GetEntryFunction(), g_spirvInvalidIndex, aliveMask_);
+
+    return Run();
+}
+
+SpirvInterpreter::Status SpirvInterpreter::Resume()
+{
+    return Run();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+SpirvInterpreter::Status SpirvInterpreter::Run()
+{
+    const auto& instrs      = program_.GetInstrs();
+    const auto& blocks      = program_.GetBlocks();
+    const auto& operands    = program_.GetOperands();
+
+    while (!frames_.empty())
+    {
+        Frame& frame = frames_.back();
+
+        if (frame.pc == g_spirvInvalidIndex)
+        {
+            frame.pendingMask &= aliveMask_;
+            if (frame.pendingMask == 0)
+            {
+                /* Return to caller and continue after the call instruction */
+                frames_.pop_back();
+                if (!frames_.empty())
+                {
+                    Frame& caller = frames_.back();
+                    caller.execMask &= aliveMask_;
+                    if (caller.execMask == 0)
+                        caller.pc = g_spirvInvalidIndex;
+                    else
+                        ++caller.pc;
+                }
+                continue;
+            }
+
+            /* Schedule the lowest block any pending lane is waiting for, so lanes reconverge at merge blocks */
+            frame.block = g_spirvInvalidIndex;
+            for_range(lane, g_spirvNumLanes)
+            {
+                if (IsLaneActive(frame.pendingMask, lane))
+                    frame.block = std::min(frame.block, frame.laneBlocks[lane]);
+            }
+
+            frame.execMask = 0;
+            for_range(lane, g_spirvNumLanes)
+            {
+                if (IsLaneActive(frame.pendingMask, lane) && frame.laneBlocks[lane] == frame.block)
+                    frame.execMask |= (1u << lane);
+            }
+
+            frame.pc = blocks[frame.block].firstInstr;
+        }
+
+        /* Execute instructions until the end of the current block */
+        for (bool isBlockActive = true; isBlockActive;)
+        {
+            const SpirvInstr& instr = instrs[frame.pc];
+            const std::uint32_t mask = frame.execMask;
+
+            switch (instr.op)
+            {
+                case SpirvExecOp::Branch:
+                {
+                    for_range(lane, g_spirvNumLanes)
+                    {
+                        if (IsLaneActive(mask, lane))
+                        {
+                            frame.prevBlocks[lane] = frame.block;
+                            frame.laneBlocks[lane] = instr.args[0];
+                        }
+                    }
+                    frame.pc = g_spirvInvalidIndex;
+                    isBlockActive = false;
+                }
+                break;
+
+                case SpirvExecOp::BranchConditional:
+                {
+                    const SpirvValue* condition = Reg(instr.args[0]);
+                    for_range(lane, g_spirvNumLanes)
+                    {
+                        if (IsLaneActive(mask, lane))
+                        {
+                            frame.prevBlocks[lane] = frame.block;
+                            frame.laneBlocks[lane] = (condition[lane].u != 0 ? instr.args[1] : instr.args[2]);
+                        }
+                    }
+                    frame.pc = g_spirvInvalidIndex;
+                    isBlockActive = false;
+                }
+                break;
+
+                case SpirvExecOp::Switch:
+                {
+                    const SpirvValue* selector = Reg(instr.args[0]);
+                    for_range(lane, g_spirvNumLanes)
+                    {
+                        if (IsLaneActive(mask, lane))
+                        {
+                            std::uint32_t target = instr.args[1];
+                            for_range(i, instr.count)
+                            {
+                                if (operands[instr.args[2] + i*2] == selector[lane].u)
+                                {
+                                    target = operands[instr.args[2] + i*2 + 1];
+                                    break;
+                                }
+                            }
+                            frame.prevBlocks[lane] = frame.block;
+                            frame.laneBlocks[lane] = target;
+                        }
+                    }
+                    frame.pc = g_spirvInvalidIndex;
+                    isBlockActive = false;
+                }
+                break;
+
+                case SpirvExecOp::ReturnValue:
+                {
+                    if (frame.resultReg != g_spirvInvalidIndex)
+                        CopyMasked(Reg(frame.resultReg), Reg(instr.args[0]), instr.count, mask);
+                    frame.pendingMask &= ~mask;
+                    frame.pc = g_spirvInvalidIndex;
+                    isBlockActive = false;
+                }
+                break;
+
+                case SpirvExecOp::Return:
+                case SpirvExecOp::Unreachable:
+                {
+                    frame.pendingMask &= ~mask;
+                    frame.pc = g_spirvInvalidIndex;
+                    isBlockActive = false;
+                }
+                break;
+
+                case SpirvExecOp::Kill:
+                {
+                    aliveMask_ &= ~mask;
+                    frame.pendingMask &= ~mask;
+                    frame.pc = g_spirvInvalidIndex;
+                    isBlockActive = false;
+                }
+                break;
+
+                case SpirvExecOp::Call:
+                {
+                    /* Copy arguments into parameters of callee */
+                    for_range(i, instr.count)
+                    {
+                        const std::uint32_t* arg = operands.data() + instr.args[1] + i*3;
+                        CopyMasked(Reg(arg[1]), Reg(arg[0]), arg[2], mask);
+                    }
+
+                    /* Continue with callee; caller continues after the call once the callee returns */
+                    PushFrame(instr.args[0], instr.result, mask);
+                    isBlockActive = false;
+                }
+                break;
+
+                case SpirvExecOp::Barrier:
+                {
+                    ++frame.pc;
+                    return Status::Barrier;
+                }
+
+                default:
+                {
+                    ExecInstr(instr, frame);
+                    ++frame.pc;
+                }
+                break;
+            }
+        }
+    }
+
+    return Status::Finished;
+}
+
+void SpirvInterpreter::PushFrame(std::uint32_t function, std::uint32_t resultReg, std::uint32_t laneMask)
+{
+    const std::uint32_t firstBlock = program_.GetFunctions()[function].firstBlock;
+
+    Frame frame;
+    {
+        frame.function      = function;
+        frame.resultReg     = resultReg;
+        frame.pendingMask   = laneMask;
+        for_range(lane, g_spirvNumLanes)
+        {
+            frame.laneBlocks[lane] = firstBlock;
+            frame.prevBlocks[lane] = g_spirvInvalidIndex;
+        }
+    }
+    frames_.push_back(frame);
+}
+
+void SpirvInterpreter::ExecInstr(const SpirvInstr& instr, Frame& frame)
+{
+    SpirvValue* regs = registers_.data();
+    const std::uint32_t mask = frame.execMask;
+
+    switch (instr.op)
+    {
+        /* ----- Composites ----- */
+
+        case SpirvExecOp::Copy:
+            CopyMasked(Reg(instr.result), Reg(instr.args[0]), instr.count, mask);
+            break;
+
+        case SpirvExecOp::VectorExtractDynamic:
+        {
+            const SpirvValue* vec = Reg(instr.args[0]);
+            const SpirvValue* index = Reg(instr.args[1]);
+            SpirvValue* dst = Reg(instr.result);
+            for_range(lane, g_spirvNumLanes)
+            {
+                if (IsLaneActive(mask, lane))
+                    dst[lane] = (index[lane].u < instr.count ? vec[index[lane].u*g_spirvNumLanes + lane] : UIntValue(0));
+            }
+        }
+        break;
+
+        case SpirvExecOp::VectorInsertDynamic:
+        {
+            const SpirvValue* index = Reg(instr.args[0]);
+            const SpirvValue* component = Reg(instr.args[1]);
+            SpirvValue* dst = Reg(instr.result);
+            for_range(lane, g_spirvNumLanes)
+            {
+                if (IsLaneActive(mask, lane) && index[lane].u < instr.count)
+                    dst[index[lane].u*g_spirvNumLanes + lane] = component[lane];
+            }
+        }
+        break;
+
+        case SpirvExecOp::Select:
+        {
+            const SpirvValue* condition = Reg(instr.args[0]);
+            const SpirvValue* a = Reg(instr.args[1]);
+            const SpirvValue* b = Reg(instr.args[2]);
+            SpirvValue* dst = Reg(instr.result);
+            for_range(c, instr.count)
+            {
+                const std::uint32_t conditionOffset = (instr.args[3] != 0 ? c*g_spirvNumLanes : 0);
+                for_range(lane, g_spirvNumLanes)
+                {
+                    if (IsLaneActive(mask, lane))
+                    {
+                        const std::uint32_t i = c*g_spirvNumLanes + lane;
+                        dst[i] = (condition[conditionOffset + lane].u != 0 ? a[i] : b[i]);
+                    }
+                }
+            }
+        }
+        break;
+
+        /* ----- Float arithmetic ----- */
+
+        case SpirvExecOp::FNegate:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(-a.f); });
+            break;
+        case SpirvExecOp::FAdd:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(a.f + b.f); });
+            break;
+        case SpirvExecOp::FSub:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(a.f - b.f); });
+            break;
+        case SpirvExecOp::FMul:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(a.f * b.f); });
+            break;
+        case SpirvExecOp::FDiv:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(a.f / b.f); });
+            break;
+        case SpirvExecOp::FRem:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(std::fmod(a.f, b.f)); });
+            break;
+        case SpirvExecOp::FMod:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(a.f - b.f * std::floor(a.f / b.f)); });
+            break;
+        case SpirvExecOp::FAbs:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::abs(a.f)); });
+            break;
+        case SpirvExecOp::FSign:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(a.f > 0.0f ? 1.0f : (a.f < 0.0f ? -1.0f : 0.0f)); });
+            break;
+        case SpirvExecOp::FMin:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(b.f < a.f ? b.f : a.f); });
+            break;
+        case SpirvExecOp::FMax:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(a.f < b.f ? b.f : a.f); });
+            break;
+        case SpirvExecOp::FClamp:
+            ExecTernary(regs, instr, mask, [](SpirvValue x, SpirvValue lo, SpirvValue hi) { return FloatValue(std::min(std::max(x.f, lo.f), hi.f)); });
+            break;
+        case SpirvExecOp::FMix:
+            ExecTernary(regs, instr, mask, [](SpirvValue x, SpirvValue y, SpirvValue a) { return FloatValue(x.f * (1.0f - a.f) + y.f * a.f); });
+            break;
+        case SpirvExecOp::Step:
+            ExecBinary(regs, instr, mask, [](SpirvValue edge, SpirvValue x) { return FloatValue(x.f < edge.f ? 0.0f : 1.0f); });
+            break;
+        case SpirvExecOp::SmoothStep:
+            ExecTernary(
+                regs, instr, mask,
+                [](SpirvValue edge0, SpirvValue edge1, SpirvValue x)
+                {
+                    const float t = Clamp((x.f - edge0.f) / (edge1.f - edge0.f), 0.0f, 1.0f);
+                    return FloatValue(t * t * (3.0f - 2.0f * t));
+                }
+            );
+            break;
+        case SpirvExecOp::Fma:
+            ExecTernary(regs, instr, mask, [](SpirvValue a, SpirvValue b, SpirvValue c) { return FloatValue(a.f * b.f + c.f); });
+            break;
+        case SpirvExecOp::Floor:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::floor(a.f)); });
+            break;
+        case SpirvExecOp::Ceil:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::ceil(a.f)); });
+            break;
+        case SpirvExecOp::Round:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::round(a.f)); });
+            break;
+        case SpirvExecOp::RoundEven:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::nearbyint(a.f)); });
+            break;
+        case SpirvExecOp::Trunc:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::trunc(a.f)); });
+            break;
+        case SpirvExecOp::Fract:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(a.f - std::floor(a.f)); });
+            break;
+        case SpirvExecOp::Radians:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(a.f * (g_spirvPi / 180.0f)); });
+            break;
+        case SpirvExecOp::Degrees:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(a.f * (180.0f / g_spirvPi)); });
+            break;
+        case SpirvExecOp::Sin:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::sin(a.f)); });
+            break;
+        case SpirvExecOp::Cos:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::cos(a.f)); });
+            break;
+        case SpirvExecOp::Tan:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::tan(a.f)); });
+            break;
+        case SpirvExecOp::Asin:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::asin(a.f)); });
+            break;
+        case SpirvExecOp::Acos:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::acos(a.f)); });
+            break;
+        case SpirvExecOp::Atan:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::atan(a.f)); });
+            break;
+        case SpirvExecOp::Sinh:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::sinh(a.f)); });
+            break;
+        case SpirvExecOp::Cosh:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::cosh(a.f)); });
+            break;
+        case SpirvExecOp::Tanh:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::tanh(a.f)); });
+            break;
+        case SpirvExecOp::Asinh:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::asinh(a.f)); });
+            break;
+        case SpirvExecOp::Acosh:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::acosh(a.f)); });
+            break;
+        case SpirvExecOp::Atanh:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::atanh(a.f)); });
+            break;
+        case SpirvExecOp::Atan2:
+            ExecBinary(regs, instr, mask, [](SpirvValue y, SpirvValue x) { return FloatValue(std::atan2(y.f, x.f)); });
+            break;
+        case SpirvExecOp::Pow:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return FloatValue(std::pow(a.f, b.f)); });
+            break;
+        case SpirvExecOp::Exp:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::exp(a.f)); });
+            break;
+        case SpirvExecOp::Log:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::log(a.f)); });
+            break;
+        case SpirvExecOp::Exp2:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::exp2(a.f)); });
+            break;
+        case SpirvExecOp::Log2:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::log2(a.f)); });
+            break;
+        case SpirvExecOp::Sqrt:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(std::sqrt(a.f)); });
+            break;
+        case SpirvExecOp::InverseSqrt:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(1.0f / std::sqrt(a.f)); });
+            break;
+        case SpirvExecOp::Ldexp:
+            ExecBinary(regs, instr, mask, [](SpirvValue x, SpirvValue e) { return FloatValue(std::ldexp(x.f, e.s)); });
+            break;
+        case SpirvExecOp::QuantizeToF16:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(QuantizeToF16(a.f)); });
+            break;
+
+        case SpirvExecOp::Modf:
+        case SpirvExecOp::Frexp:
+        {
+            for_range(c, instr.count)
+            {
+                const SpirvValue* x = Reg(instr.args[0] + c*g_spirvNumLanes);
+                SpirvValue* dst0 = Reg(instr.result + c*g_spirvNumLanes);
+                SpirvValue* dst1 = Reg(instr.args[1] + c*g_spirvNumLanes);
+                for_range(lane, g_spirvNumLanes)
+                {
+                    if (IsLaneActive(mask, lane))
+                    {
+                        if (instr.op == SpirvExecOp::Modf)
+                        {
+                            const float whole = std::trunc(x[lane].f);
+                            dst0[lane] = FloatValue(x[lane].f - whole);
+                            dst1[lane] = FloatValue(whole);
+                        }
+                        else
+                        {
+                            int exponent = 0;
+                            dst0[lane] = FloatValue(std::frexp(x[lane].f, &exponent));
+                            dst1[lane] = SIntValue(exponent);
+                        }
+                    }
+                }
+            }
+        }
+        break;
+
+        /* ----- Integer arithmetic ----- */
+
+        case SpirvExecOp::SNegate:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return UIntValue(0u - a.u); });
+            break;
+        case SpirvExecOp::IAdd:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u + b.u); });
+            break;
+        case SpirvExecOp::ISub:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u - b.u); });
+            break;
+        case SpirvExecOp::IMul:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u * b.u); });
+            break;
+        case SpirvExecOp::UDiv:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(b.u != 0 ? a.u / b.u : 0u); });
+            break;
+        case SpirvExecOp::SDiv:
+            ExecBinary(
+                regs, instr, mask,
+                [](SpirvValue a, SpirvValue b)
+                {
+                    if (b.s == 0 || (a.s == INT_MIN && b.s == -1))
+                        return a;
+                    return SIntValue(a.s / b.s);
+                }
+            );
+            break;
+        case SpirvExecOp::UMod:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(b.u != 0 ? a.u % b.u : 0u); });
+            break;
+        case SpirvExecOp::SRem:
+            ExecBinary(
+                regs, instr, mask,
+                [](SpirvValue a, SpirvValue b)
+                {
+                    if (b.s == 0 || b.s == -1)
+                        return SIntValue(0);
+                    return SIntValue(a.s % b.s);
+                }
+            );
+            break;
+        case SpirvExecOp::SMod:
+            ExecBinary(
+                regs, instr, mask,
+                [](SpirvValue a, SpirvValue b)
+                {
+                    if (b.s == 0 || b.s == -1)
+                        return SIntValue(0);
+                    std::int32_t r = a.s % b.s;
+                    if (r != 0 && ((r < 0) != (b.s < 0)))
+                        r += b.s;
+                    return SIntValue(r);
+                }
+            );
+            break;
+        case SpirvExecOp::SAbs:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return UIntValue(a.s < 0 ? 0u - a.u : a.u); });
+            break;
+        case SpirvExecOp::SSign:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return SIntValue(a.s > 0 ? 1 : (a.s < 0 ? -1 : 0)); });
+            break;
+        case SpirvExecOp::UMin:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(std::min(a.u, b.u)); });
+            break;
+        case SpirvExecOp::SMin:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return SIntValue(std::min(a.s, b.s)); });
+            break;
+        case SpirvExecOp::UMax:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(std::max(a.u, b.u)); });
+            break;
+        case SpirvExecOp::SMax:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return SIntValue(std::max(a.s, b.s)); });
+            break;
+        case SpirvExecOp::UClamp:
+            ExecTernary(regs, instr, mask, [](SpirvValue x, SpirvValue lo, SpirvValue hi) { return UIntValue(std::min(std::max(x.u, lo.u), hi.u)); });
+            break;
+        case SpirvExecOp::SClamp:
+            ExecTernary(regs, instr, mask, [](SpirvValue x, SpirvValue lo, SpirvValue hi) { return SIntValue(std::min(std::max(x.s, lo.s), hi.s)); });
+            break;
+        case SpirvExecOp::ShiftRightLogical:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u >> (b.u & 31u)); });
+            break;
+        case SpirvExecOp::ShiftRightArithmetic:
+            ExecBinary(
+                regs, instr, mask,
+                [](SpirvValue a, SpirvValue b)
+                {
+                    const std::uint32_t shift = (b.u & 31u);
+                    const std::uint32_t sign = (a.s < 0 && shift > 0 ? ~(~0u >> shift) : 0u);
+                    return UIntValue((a.u >> shift) | sign);
+                }
+            );
+            break;
+        case SpirvExecOp::ShiftLeftLogical:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u << (b.u & 31u)); });
+            break;
+        case SpirvExecOp::BitwiseOr:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u | b.u); });
+            break;
+        case SpirvExecOp::BitwiseXor:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u ^ b.u); });
+            break;
+        case SpirvExecOp::BitwiseAnd:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return UIntValue(a.u & b.u); });
+            break;
+        case SpirvExecOp::Not:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return UIntValue(~a.u); });
+            break;
+
+        case SpirvExecOp::BitFieldInsert:
+        case SpirvExecOp::BitFieldSExtract:
+        case SpirvExecOp::BitFieldUExtract:
+        {
+            /* Offset and count are scalars */
+            const bool          isInsert    = (instr.op == SpirvExecOp::BitFieldInsert);
+            const SpirvValue*   offset      = Reg(isInsert ? instr.args[2] : instr.args[1]);
+            const SpirvValue*   count       = Reg(isInsert ? instr.args[3] : instr.args[2]);
+            for_range(c, instr.count)
+            {
+                const SpirvValue* base = Reg(instr.args[0] + c*g_spirvNumLanes);
+                const SpirvValue* insert = Reg(instr.args[1] + c*g_spirvNumLanes);
+                SpirvValue* dst = Reg(instr.result + c*g_spirvNumLanes);
+                for_range(lane, g_spirvNumLanes)
+                {
+                    if (!IsLaneActive(mask, lane))
+                        continue;
+
+                    const std::uint32_t bits = BitFieldMask(offset[lane].u, count[lane].u);
+                    if (isInsert)
+                        dst[lane] = UIntValue((base[lane].u & ~bits) | ((insert[lane].u << (offset[lane].u & 31u)) & bits));
+                    else if (bits == 0)
+                        dst[lane] = UIntValue(0);
+                    else
+                    {
+                        std::uint32_t value = ((base[lane].u & bits) >> offset[lane].u);
+                        const std::uint32_t signBit = (1u << (std::min(count[lane].u, 32u - offset[lane].u) - 1u));
+                        if (instr.op == SpirvExecOp::BitFieldSExtract && (value & signBit) != 0)
+                            value |= ~((signBit << 1) - 1u);
+                        dst[lane] = UIntValue(value);
+                    }
+                }
+            }
+        }
+        break;
+
+        case SpirvExecOp::BitReverse:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return UIntValue(BitReverse(a.u)); });
+            break;
+        case SpirvExecOp::BitCount:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return UIntValue(BitCount(a.u)); });
+            break;
+        case SpirvExecOp::FindILsb:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return SIntValue(FindLsb(a.u)); });
+            break;
+        case SpirvExecOp::FindSMsb:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return SIntValue(FindMsb(a.s < 0 ? ~a.u : a.u)); });
+            break;
+        case SpirvExecOp::FindUMsb:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return SIntValue(FindMsb(a.u)); });
+            break;
+
+        case SpirvExecOp::IAddCarry:
+        case SpirvExecOp::ISubBorrow:
+        case SpirvExecOp::UMulExtended:
+        case SpirvExecOp::SMulExtended:
+        {
+            for_range(c, instr.count)
+            {
+                const SpirvValue* a = Reg(instr.args[0] + c*g_spirvNumLanes);
+                const SpirvValue* b = Reg(instr.args[1] + c*g_spirvNumLanes);
+                SpirvValue* lo = Reg(instr.result + c*g_spirvNumLanes);
+                SpirvValue* hi = Reg(instr.result + (instr.count + c)*g_spirvNumLanes);
+                for_range(lane, g_spirvNumLanes)
+                {
+                    if (!IsLaneActive(mask, lane))
+                        continue;
+                    switch (instr.op)
+                    {
+                        case SpirvExecOp::IAddCarry:
+                            lo[lane] = UIntValue(a[lane].u + b[lane].u);
+                            hi[lane] = UIntValue(lo[lane].u < a[lane].u ? 1u : 0u);
+                            break;
+                        case SpirvExecOp::ISubBorrow:
+                            lo[lane] = UIntValue(a[lane].u - b[lane].u);
+                            hi[lane] = UIntValue(a[lane].u < b[lane].u ? 1u : 0u);
+                            break;
+                        case SpirvExecOp::UMulExtended:
+                        {
+                            const std::uint64_t product = static_cast<std::uint64_t>(a[lane].u) * b[lane].u;
+                            lo[lane] = UIntValue(static_cast<std::uint32_t>(product));
+                            hi[lane] = UIntValue(static_cast<std::uint32_t>(product >> 32));
+                        }
+                        break;
+                        default:
+                        {
+                            const std::uint64_t product = static_cast<std::uint64_t>(static_cast<std::int64_t>(a[lane].s) * b[lane].s);
+                            lo[lane] = UIntValue(static_cast<std::uint32_t>(product));
+                            hi[lane] = UIntValue(static_cast<std::uint32_t>(product >> 32));
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+        break;
+
+        /* ----- Relational and logical ----- */
+
+        case SpirvExecOp::IEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.u == b.u); });
+            break;
+        case SpirvExecOp::INotEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.u != b.u); });
+            break;
+        case SpirvExecOp::UGreaterThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.u > b.u); });
+            break;
+        case SpirvExecOp::SGreaterThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.s > b.s); });
+            break;
+        case SpirvExecOp::UGreaterThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.u >= b.u); });
+            break;
+        case SpirvExecOp::SGreaterThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.s >= b.s); });
+            break;
+        case SpirvExecOp::ULessThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.u < b.u); });
+            break;
+        case SpirvExecOp::SLessThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.s < b.s); });
+            break;
+        case SpirvExecOp::ULessThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.u <= b.u); });
+            break;
+        case SpirvExecOp::SLessThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.s <= b.s); });
+            break;
+        case SpirvExecOp::FOrdEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.f == b.f); });
+            break;
+        case SpirvExecOp::FUnordEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(!(a.f < b.f || a.f > b.f)); });
+            break;
+        case SpirvExecOp::FOrdNotEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.f < b.f || a.f > b.f); });
+            break;
+        case SpirvExecOp::FUnordNotEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.f != b.f); });
+            break;
+        case SpirvExecOp::FOrdLessThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.f < b.f); });
+            break;
+        case SpirvExecOp::FUnordLessThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(!(a.f >= b.f)); });
+            break;
+        case SpirvExecOp::FOrdGreaterThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.f > b.f); });
+            break;
+        case SpirvExecOp::FUnordGreaterThan:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(!(a.f <= b.f)); });
+            break;
+        case SpirvExecOp::FOrdLessThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.f <= b.f); });
+            break;
+        case SpirvExecOp::FUnordLessThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(!(a.f > b.f)); });
+            break;
+        case SpirvExecOp::FOrdGreaterThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(a.f >= b.f); });
+            break;
+        case SpirvExecOp::FUnordGreaterThanEqual:
+            ExecBinary(regs, instr, mask, [](SpirvValue a, SpirvValue b) { return BoolValue(!(a.f < b.f)); });
+            break;
+        case SpirvExecOp::LogicalNot:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return BoolValue(a.u == 0); });
+            break;
+        case SpirvExecOp::IsNan:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return BoolValue(std::isnan(a.f)); });
+            break;
+        case SpirvExecOp::IsInf:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return BoolValue(std::isinf(a.f)); });
+            break;
+
+        case SpirvExecOp::Any:
+        case SpirvExecOp::All:
+        {
+            const bool isAny = (instr.op == SpirvExecOp::Any);
+            ExecVector(
+                regs, instr, mask,
+                [&instr, isAny](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue*, const SpirvValue*)
+                {
+                    bool result = !isAny;
+                    for_range(i, instr.count)
+                    {
+                        if ((a[i*g_spirvNumLanes].u != 0) == isAny)
+                            result = isAny;
+                    }
+                    *dst = BoolValue(result);
+                }
+            );
+        }
+        break;
+
+        /* ----- Conversion ----- */
+
+        case SpirvExecOp::ConvertFToU:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return UIntValue(FloatToUInt(a.f)); });
+            break;
+        case SpirvExecOp::ConvertFToS:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return SIntValue(FloatToSInt(a.f)); });
+            break;
+        case SpirvExecOp::ConvertSToF:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(static_cast<float>(a.s)); });
+            break;
+        case SpirvExecOp::ConvertUToF:
+            ExecUnary(regs, instr, mask, [](SpirvValue a) { return FloatValue(static_cast<float>(a.u)); });
+            break;
+
+        /* ----- Vector and matrix ----- */
+
+        case SpirvExecOp::VectorTimesScalar:
+        {
+            const SpirvValue* scalar = Reg(instr.args[1]);
+            for_range(c, instr.count)
+            {
+                const SpirvValue* a = Reg(instr.args[0] + c*g_spirvNumLanes);
+                SpirvValue* dst = Reg(instr.result + c*g_spirvNumLanes);
+                for_range(lane, g_spirvNumLanes)
+                {
+                    if (IsLaneActive(mask, lane))
+                        dst[lane] = FloatValue(a[lane].f * scalar[lane].f);
+                }
+            }
+        }
+        break;
+
+        case SpirvExecOp::MatrixTimesVector:
+        {
+            /* count = rows, args[2] = columns */
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* m, const SpirvValue* v, const SpirvValue*)
+                {
+                    const std::uint32_t rows = instr.count, cols = instr.args[2];
+                    for_range(r, rows)
+                    {
+                        float sum = 0.0f;
+                        for_range(c, cols)
+                            sum += m[(c*rows + r)*g_spirvNumLanes].f * v[c*g_spirvNumLanes].f;
+                        dst[r*g_spirvNumLanes] = FloatValue(sum);
+                    }
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::VectorTimesMatrix:
+        {
+            /* count = columns, args[2] = rows */
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* v, const SpirvValue* m, const SpirvValue*)
+                {
+                    const std::uint32_t rows = instr.args[2], cols = instr.count;
+                    for_range(c, cols)
+                        dst[c*g_spirvNumLanes] = FloatValue(Dot(v, m + c*rows*g_spirvNumLanes, rows));
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::MatrixTimesMatrix:
+        {
+            /* count = columns * rows, args[2] = rows, args[3] = inner dimension */
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue* b, const SpirvValue*)
+                {
+                    const std::uint32_t rows = instr.args[2], inner = instr.args[3], cols = instr.count / rows;
+                    for_range(c, cols)
+                    {
+                        for_range(r, rows)
+                        {
+                            float sum = 0.0f;
+                            for_range(k, inner)
+                                sum += a[(k*rows + r)*g_spirvNumLanes].f * b[(c*inner + k)*g_spirvNumLanes].f;
+                            dst[(c*rows + r)*g_spirvNumLanes] = FloatValue(sum);
+                        }
+                    }
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::OuterProduct:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue* b, const SpirvValue*)
+                {
+                    const std::uint32_t rows = instr.args[2], cols = instr.count / rows;
+                    for_range(c, cols)
+                    {
+                        for_range(r, rows)
+                            dst[(c*rows + r)*g_spirvNumLanes] = FloatValue(a[r*g_spirvNumLanes].f * b[c*g_spirvNumLanes].f);
+                    }
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Transpose:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* m, const SpirvValue*, const SpirvValue*)
+                {
+                    const std::uint32_t rows = instr.args[2], cols = instr.count / rows;
+                    for_range(c, cols)
+                    {
+                        for_range(r, rows)
+                            dst[(r*cols + c)*g_spirvNumLanes] = m[(c*rows + r)*g_spirvNumLanes];
+                    }
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Determinant:
+        case SpirvExecOp::MatrixInverse:
+        {
+            const bool isInverse = (instr.op == SpirvExecOp::MatrixInverse);
+            ExecVector(
+                regs, instr, mask,
+                [&instr, isInverse](std::uint32_t, SpirvValue* dst, const SpirvValue* m, const SpirvValue*, const SpirvValue*)
+                {
+                    const std::uint32_t n = std::min(instr.args[2], 4u);
+                    float matrix[16], inverse[16];
+                    for_range(i, n*n)
+                        matrix[i] = m[i*g_spirvNumLanes].f;
+
+                    if (isInverse)
+                    {
+                        ComputeInverse(matrix, inverse, n);
+                        for_range(i, n*n)
+                            dst[i*g_spirvNumLanes] = FloatValue(inverse[i]);
+                    }
+                    else
+                        *dst = FloatValue(ComputeDeterminant(matrix, n));
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Dot:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue* b, const SpirvValue*)
+                {
+                    *dst = FloatValue(Dot(a, b, instr.count));
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Length:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue*, const SpirvValue*)
+                {
+                    *dst = FloatValue(std::sqrt(Dot(a, a, instr.count)));
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Distance:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue* b, const SpirvValue*)
+                {
+                    float sum = 0.0f;
+                    for_range(i, instr.count)
+                    {
+                        const float d = a[i*g_spirvNumLanes].f - b[i*g_spirvNumLanes].f;
+                        sum += d*d;
+                    }
+                    *dst = FloatValue(std::sqrt(sum));
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Normalize:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue*, const SpirvValue*)
+                {
+                    const float invLength = 1.0f / std::sqrt(Dot(a, a, instr.count));
+                    for_range(i, instr.count)
+                        dst[i*g_spirvNumLanes] = FloatValue(a[i*g_spirvNumLanes].f * invLength);
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Cross:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [](std::uint32_t, SpirvValue* dst, const SpirvValue* a, const SpirvValue* b, const SpirvValue*)
+                {
+                    const float a0 = a[0].f, a1 = a[g_spirvNumLanes].f, a2 = a[2*g_spirvNumLanes].f;
+                    const float b0 = b[0].f, b1 = b[g_spirvNumLanes].f, b2 = b[2*g_spirvNumLanes].f;
+                    dst[0                ] = FloatValue(a1*b2 - a2*b1);
+                    dst[g_spirvNumLanes  ] = FloatValue(a2*b0 - a0*b2);
+                    dst[g_spirvNumLanes*2] = FloatValue(a0*b1 - a1*b0);
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::FaceForward:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* n, const SpirvValue* i, const SpirvValue* nref)
+                {
+                    const float sign = (Dot(nref, i, instr.count) < 0.0f ? 1.0f : -1.0f);
+                    for_range(c, instr.count)
+                        dst[c*g_spirvNumLanes] = FloatValue(n[c*g_spirvNumLanes].f * sign);
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Reflect:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* i, const SpirvValue* n, const SpirvValue*)
+                {
+                    const float d = 2.0f * Dot(n, i, instr.count);
+                    for_range(c, instr.count)
+                        dst[c*g_spirvNumLanes] = FloatValue(i[c*g_spirvNumLanes].f - d * n[c*g_spirvNumLanes].f);
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::Refract:
+        {
+            ExecVector(
+                regs, instr, mask,
+                [&instr](std::uint32_t, SpirvValue* dst, const SpirvValue* i, const SpirvValue* n, const SpirvValue* eta)
+                {
+                    const float d = Dot(n, i, instr.count);
+                    const float k = 1.0f - eta->f * eta->f * (1.0f - d*d);
+                    for_range(c, instr.count)
+                    {
+                        if (k < 0.0f)
+                            dst[c*g_spirvNumLanes] = FloatValue(0.0f);
+                        else
+                            dst[c*g_spirvNumLanes] = FloatValue(eta->f * i[c*g_spirvNumLanes].f - (eta->f * d + std::sqrt(k)) * n[c*g_spirvNumLanes].f);
+                    }
+                }
+            );
+        }
+        break;
+
+        /* ----- Packing ----- */
+
+        case SpirvExecOp::PackSnorm4x8:
+        case SpirvExecOp::PackUnorm4x8:
+        case SpirvExecOp::PackSnorm2x16:
+        case SpirvExecOp::PackUnorm2x16:
+        case SpirvExecOp::PackHalf2x16:
+        {
+            const SpirvExecOp op = instr.op;
+            ExecVector(
+                regs, instr, mask,
+                [op](std::uint32_t, SpirvValue* dst, const SpirvValue* v, const SpirvValue*, const SpirvValue*)
+                {
+                    std::uint32_t packed = 0;
+                    switch (op)
+                    {
+                        case SpirvExecOp::PackSnorm4x8:
+                            for_range(i, 4u)
+                                packed |= PackSnorm(v[i*g_spirvNumLanes].f, 127.0f, 0xFFu) << (i*8);
+                            break;
+                        case SpirvExecOp::PackUnorm4x8:
+                            for_range(i, 4u)
+                                packed |= PackUnorm(v[i*g_spirvNumLanes].f, 255.0f) << (i*8);
+                            break;
+                        case SpirvExecOp::PackSnorm2x16:
+                            for_range(i, 2u)
+                                packed |= PackSnorm(v[i*g_spirvNumLanes].f, 32767.0f, 0xFFFFu) << (i*16);
+                            break;
+                        case SpirvExecOp::PackUnorm2x16:
+                            for_range(i, 2u)
+                                packed |= PackUnorm(v[i*g_spirvNumLanes].f, 65535.0f) << (i*16);
+                            break;
+                        default:
+                            for_range(i, 2u)
+                                packed |= static_cast<std::uint32_t>(CompressFloat16(v[i*g_spirvNumLanes].f)) << (i*16);
+                            break;
+                    }
+                    *dst = UIntValue(packed);
+                }
+            );
+        }
+        break;
+
+        case SpirvExecOp::UnpackSnorm4x8:
+        case SpirvExecOp::UnpackUnorm4x8:
+        case SpirvExecOp::UnpackSnorm2x16:
+        case SpirvExecOp::UnpackUnorm2x16:
+        case SpirvExecOp::UnpackHalf2x16:
+        {
+            const SpirvExecOp op = instr.op;
+            ExecVector(
+                regs, instr, mask,
+                [op](std::uint32_t, SpirvValue* dst, const SpirvValue* v, const SpirvValue*, const SpirvValue*)
+                {
+                    const std::uint32_t packed = v->u;
+                    switch (op)
+                    {
+                        case SpirvExecOp::UnpackSnorm4x8:
+                            for_range(i, 4u)
+                                dst[i*g_spirvNumLanes] = FloatValue(Clamp(static_cast<float>(static_cast<std::int8_t>((packed >> (i*8)) & 0xFFu)) / 127.0f, -1.0f, 1.0f));
+                            break;
+                        case SpirvExecOp::UnpackUnorm4x8:
+                            for_range(i, 4u)
+                                dst[i*g_spirvNumLanes] = FloatValue(static_cast<float>((packed >> (i*8)) & 0xFFu) / 255.0f);
+                            break;
+                        case SpirvExecOp::UnpackSnorm2x16:
+                            for_range(i, 2u)
+                                dst[i*g_spirvNumLanes] = FloatValue(Clamp(static_cast<float>(static_cast<std::int16_t>((packed >> (i*16)) & 0xFFFFu)) / 32767.0f, -1.0f, 1.0f));
+                            break;
+                        case SpirvExecOp::UnpackUnorm2x16:
+                            for_range(i, 2u)
+                                dst[i*g_spirvNumLanes] = FloatValue(static_cast<float>((packed >> (i*16)) & 0xFFFFu) / 65535.0f);
+                            break;
+                        default:
+                            for_range(i, 2u)
+                                dst[i*g_spirvNumLanes] = FloatValue(DecompressFloat16(static_cast<std::uint16_t>((packed >> (i*16)) & 0xFFFFu)));
+                            break;
+                    }
+                }
+            );
+        }
+        break;
+
+        /* ----- Derivatives ----- */
+
+        case SpirvExecOp::DPdxFine:
+        case SpirvExecOp::DPdyFine:
+        case SpirvExecOp::FwidthFine:
+        case SpirvExecOp::DPdxCoarse:
+        case SpirvExecOp::DPdyCoarse:
+        case SpirvExecOp::FwidthCoarse:
+            ExecDerivative(instr, mask);
+            break;
+
+        /* ----- Memory ----- */
+
+        case SpirvExecOp::Load:
+            ExecLoad(instr, mask);
+            break;
+
+        case SpirvExecOp::Store:
+            ExecStore(instr, mask);
+            break;
+
+        case SpirvExecOp::AccessChain:
+            ExecAccessChain(instr, mask);
+            break;
+
+        case SpirvExecOp::ArrayLength:
+        {
+            const SpirvValue* ptr = Reg(instr.args[0]);
+            SpirvValue* dst = Reg(instr.result);
+            for_range(lane, g_spirvNumLanes)
+            {
+                if (IsLaneActive(mask, lane))
+                {
+                    std::uint32_t size = 0;
+                    GetVariableMemory(ptr[lane].u, lane, size);
+                    const std::uint32_t offset = ptr[g_spirvNumLanes + lane].u + instr.args[1];
+                    dst[lane] = UIntValue(size > offset ? (size - offset) / instr.args[2] : 0u);
+                }
+            }
+        }
+        break;
+
+        case SpirvExecOp::AtomicLoad:
+        case SpirvExecOp::AtomicStore:
+        case SpirvExecOp::AtomicExchange:
+            ExecAtomic(instr, mask);
+            break;
+
+        case SpirvExecOp::Image:
+            ExecImage(program_.GetImageInstrs()[instr.args[0]], mask);
+            break;
+
+        /* ----- Control flow ----- */
+
+        case SpirvExecOp::Phi:
+            ExecPhi(instr, frame);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void SpirvInterpreter::ExecPhi(const SpirvInstr& instr, const Frame& frame)
+{
+    /* Select incoming value by the block each lane came from */
+    const std::uint32_t* incoming = program_.GetOperands().data() + instr.args[0];
+    for_range(lane, g_spirvNumLanes)
+    {
+        if (!IsLaneActive(frame.execMask, lane))
+            continue;
+
+        for_range(i, instr.args[1])
+        {
+            if (incoming[i*2 + 1] == frame.prevBlocks[lane])
+            {
+                const SpirvValue* src = Reg(incoming[i*2]);
+                SpirvValue* dst = Reg(instr.result);
+                for_range(c, instr.count)
+                    dst[c*g_spirvNumLanes + lane] = src[c*g_spirvNumLanes + lane];
+                break;
+            }
+        }
+    }
+}
+
+void SpirvInterpreter::ExecLoad(const SpirvInstr& instr, std::uint32_t mask)
+{
+    const SpirvProgram::Layout& layout  = program_.GetLayouts()[instr.args[1]];
+    const std::uint32_t         count   = static_cast<std::uint32_t>(layout.offsets.size());
+    const SpirvValue*           ptr     = Reg(instr.args[0]);
+    SpirvValue*                 dst     = Reg(instr.result);
+
+    for_range(lane, g_spirvNumLanes)
+    {
+        if (!IsLaneActive(mask, lane))
+            continue;
+
+        std::uint32_t size = 0;
+        const SpirvValue*   memory  = GetVariableMemory(ptr[lane].u, lane, size);
+        const std::uint32_t offset  = ptr[g_spirvNumLanes + lane].u;
+
+        if (memory != nullptr && layout.packed && offset <= size && count <= size - offset)
+        {
+            /* Fast path for tightly packed values within bounds */
+            for_range(c, count)
+                dst[c*g_spirvNumLanes + lane] = memory[offset + c];
+        }
+        else
+        {
+            /* Read each component with bounds check; out-of-bounds reads return zero */
+            for_range(c, count)
+            {
+                const std::uint32_t addr = offset + layout.offsets[c];
+                dst[c*g_spirvNumLanes + lane] = (memory != nullptr && addr < size ? memory[addr] : UIntValue(0));
+            }
+        }
+    }
+}
+
+void SpirvInterpreter::ExecStore(const SpirvInstr& instr, std::uint32_t mask)
+{
+    const auto&                 variables   = program_.GetVariables();
+    const SpirvProgram::Layout& layout      = program_.GetLayouts()[instr.args[2]];
+    const std::uint32_t         count       = static_cast<std::uint32_t>(layout.offsets.size());
+    const SpirvValue*           ptr         = Reg(instr.args[0]);
+    const SpirvValue*           src         = Reg(instr.args[1]);
+
+    for_range(lane, g_spirvNumLanes)
+    {
+        if (!IsLaneActive(mask, lane) || ptr[lane].u >= variables.size())
+            continue;
+
+        /* Helper invocations must not write to memory that is visible to other invocations */
+        const SpirvStorage storage = variables[ptr[lane].u].storage;
+        if (storage == SpirvStorage::Handle || (storage != SpirvStorage::Lane && IsLaneActive(helperMask_, lane)))
+            continue;
+
+        std::uint32_t size = 0;
+        SpirvValue* memory = GetVariableMemory(ptr[lane].u, lane, size);
+        if (memory == nullptr)
+            continue;
+
+        /* Write each component with bounds check; out-of-bounds writes are discarded */
+        const std::uint32_t offset = ptr[g_spirvNumLanes + lane].u;
+        for_range(c, count)
+        {
+            const std::uint32_t addr = offset + layout.offsets[c];
+            if (addr < size)
+                memory[addr] = src[c*g_spirvNumLanes + lane];
+        }
+    }
+}
+
+void SpirvInterpreter::ExecAccessChain(const SpirvInstr& instr, std::uint32_t mask)
+{
+    const std::uint32_t*    indices = program_.GetOperands().data() + instr.args[2];
+    const SpirvValue*       base    = Reg(instr.args[0]);
+    SpirvValue*             dst     = Reg(instr.result);
+
+    for_range(lane, g_spirvNumLanes)
+    {
+        if (!IsLaneActive(mask, lane))
+            continue;
+
+        std::uint32_t offset = base[g_spirvNumLanes + lane].u + instr.args[1];
+        for_range(i, instr.count)
+            offset += registers_[indices[i*2] + lane].u * indices[i*2 + 1];
+
+        dst[lane]                   = base[lane];
+        dst[g_spirvNumLanes + lane] = UIntValue(offset);
+    }
+}
+
+void SpirvInterpreter::ExecAtomic(const SpirvInstr& instr, std::uint32_t mask)
+{
+    const SpirvValue* ptr = Reg(instr.args[0]);
+
+    for_range(lane, g_spirvNumLanes)
+    {
+        /* Helper invocations do not perform atomic operations */
+        if (!IsLaneActive(mask & ~helperMask_, lane))
+            continue;
+
+        std::uint32_t size = 0;
+        SpirvValue* memory = GetVariableMemory(ptr[lane].u, lane, size);
+        const std::uint32_t offset = ptr[g_spirvNumLanes + lane].u;
+
+        if (memory == nullptr || offset >= size)
+        {
+            if (instr.op != SpirvExecOp::AtomicStore)
+                registers_[instr.result + lane] = UIntValue(0);
+            continue;
+        }
+
+        auto* atomic = reinterpret_cast<std::atomic<std::uint32_t>*>(&(memory[offset].u));
+
+        if (instr.op == SpirvExecOp::AtomicLoad)
+        {
+            registers_[instr.result + lane] = UIntValue(atomic->load());
+            continue;
+        }
+
+        const std::uint32_t value = registers_[instr.args[1] + lane].u;
+        if (instr.op == SpirvExecOp::AtomicStore)
+        {
+            atomic->store(value);
+            continue;
+        }
+
+        std::uint32_t prev = 0;
+        switch (static_cast<SpirvAtomicOp>(instr.args[3]))
+        {
+            case SpirvAtomicOp::Exchange:
+                prev = atomic->exchange(value);
+                break;
+            case SpirvAtomicOp::CompareExchange:
+                prev = registers_[instr.args[2] + lane].u;
+                atomic->compare_exchange_strong(prev, value);
+                break;
+            case SpirvAtomicOp::IIncrement:
+                prev = atomic->fetch_add(1u);
+                break;
+            case SpirvAtomicOp::IDecrement:
+                prev = atomic->fetch_sub(1u);
+                break;
+            case SpirvAtomicOp::IAdd:
+                prev = atomic->fetch_add(value);
+                break;
+            case SpirvAtomicOp::ISub:
+                prev = atomic->fetch_sub(value);
+                break;
+            case SpirvAtomicOp::And:
+                prev = atomic->fetch_and(value);
+                break;
+            case SpirvAtomicOp::Or:
+                prev = atomic->fetch_or(value);
+                break;
+            case SpirvAtomicOp::Xor:
+                prev = atomic->fetch_xor(value);
+                break;
+            default:
+            {
+                /* Min and max operations with compare-and-swap loop */
+                const SpirvAtomicOp op = static_cast<SpirvAtomicOp>(instr.args[3]);
+                prev = atomic->load();
+                for (;;)
+                {
+                    std::uint32_t next = prev;
+                    switch (op)
+                    {
+                        case SpirvAtomicOp::SMin:
+                            next = static_cast<std::uint32_t>(std::min(static_cast<std::int32_t>(prev), static_cast<std::int32_t>(value)));
+                            break;
+                        case SpirvAtomicOp::UMin:
+                            next = std::min(prev, value);
+                            break;
+                        case SpirvAtomicOp::SMax:
+                            next = static_cast<std::uint32_t>(std::max(static_cast<std::int32_t>(prev), static_cast<std::int32_t>(value)));
+                            break;
+                        default:
+                            next = std::max(prev, value);
+                            break;
+                    }
+                    if (next == prev || atomic->compare_exchange_weak(prev, next))
+                        break;
+                }
+            }
+            break;
+        }
+
+        registers_[instr.result + lane] = UIntValue(prev);
+    }
+}
+
+void SpirvInterpreter::ExecImage(const SpirvProgram::ImageInstr& image, std::uint32_t mask)
+{
+    const SpirvProgram::Type& type = program_.GetTypes()[image.type];
+
+    /* Image writes are side effects that helper invocations must not perform */
+    if (image.op == SpirvImageOp::Write)
+        mask &= ~helperMask_;
+
+    SpirvImageArgs baseArgs;
+    {
+        baseArgs.dim        = type.dim;
+        baseArgs.arrayed    = type.arrayed;
+        baseArgs.kind       = type.kind;
+        baseArgs.flags      = image.flags;
+        baseArgs.numCoords  = image.numCoords;
+    }
+
+    /* Gather coordinates of all lanes first, since implicit LOD requires derivatives across the quad */
+    float coords[g_spirvNumLanes][4] = {};
+    float dref[g_spirvNumLanes] = {};
+
+    if (image.op == SpirvImageOp::Sample)
+    {
+        for_range(lane, g_spirvNumLanes)
+        {
+            for_range(c, std::min(image.numCoords, 4u))
+                coords[lane][c] = registers_[image.coord + c*g_spirvNumLanes + lane].f;
+            if (image.dref != g_spirvInvalidIndex)
+                dref[lane] = registers_[image.dref + lane].f;
+
+            if ((image.flags & SpirvImageFlags::Proj) != 0 && image.numCoords > 1)
+            {
+                /* Divide coordinates and reference value by the last component */
+                const float q = coords[lane][image.numCoords - 1];
+                if (q != 0.0f)
+                {
+                    for_range(c, image.numCoords - 1)
+                        coords[lane][c] /= q;
+                    dref[lane] /= q;
+                }
+            }
+        }
+
+        if ((image.flags & SpirvImageFlags::Proj) != 0 && baseArgs.numCoords > 1)
+            --baseArgs.numCoords;
+    }
+
+    const std::uint32_t numSpatialCoords = std::min(3u, baseArgs.numCoords - (type.arrayed && baseArgs.numCoords > 0 ? 1u : 0u));
+
+    /* Sample operations are deferred, so all lanes with the same image and sampler can be sampled at once */
+    SpirvImageArgs  sampleArgs[g_spirvNumLanes];
+    const void*     sampleImages[g_spirvNumLanes]   = {};
+    const void*     samplers[g_spirvNumLanes]       = {};
+    std::uint32_t   sampleMask                      = 0;
+
+    for_range(lane, g_spirvNumLanes)
+    {
+        if (!IsLaneActive(mask, lane))
+            continue;
+
+        SpirvImageArgs args = baseArgs;
+        SpirvValue texel[4] = {};
+
+        /* Resolve image and sampler bindings; sampled images store the sampler handle in their second component */
+        const std::uint32_t imageHandle = registers_[image.image + lane].u;
+        const ImageBinding* binding = (imageHandle < images_.size() ? &images_[imageHandle] : nullptr);
+
+        const void* sampler = nullptr;
+        if (image.op == SpirvImageOp::Sample)
+        {
+            const std::uint32_t samplerHandle = registers_[image.image + g_spirvNumLanes + lane].u;
+            if (samplerHandle < images_.size())
+                sampler = images_[samplerHandle].sampler;
+        }
+
+        if (binding != nullptr && binding->image != nullptr && imageHandler_ != nullptr)
+        {
+            /* Fill arguments of current lane */
+            if (image.op == SpirvImageOp::Sample)
+            {
+                for_range(c, 4u)
+                    args.coords[c] = coords[lane][c];
+                args.dref = dref[lane];
+            }
+            else if (image.coord != g_spirvInvalidIndex)
+            {
+                for_range(c, std::min(image.numCoords, 4u))
+                    args.texel[c] = registers_[image.coord + c*g_spirvNumLanes + lane].s;
+            }
+
+            if (image.lod != g_spirvInvalidIndex)
+            {
+                if (image.op == SpirvImageOp::Sample)
+                    args.lod = registers_[image.lod + lane].f;
+                else
+                    args.level = registers_[image.lod + lane].s;
+            }
+
+            if (image.minLod != g_spirvInvalidIndex)
+                args.minLod = registers_[image.minLod + lane].f;
+            if (image.sample != g_spirvInvalidIndex)
+                args.sample = registers_[image.sample + lane].s;
+
+            if (image.offset != g_spirvInvalidIndex)
+            {
+                for_range(c, numSpatialCoords)
+                    args.offset[c] = registers_[image.offset + c*g_spirvNumLanes + lane].s;
+            }
+
+            if ((image.flags & SpirvImageFlags::Grad) != 0)
+            {
+                for_range(c, numSpatialCoords)
+                {
+                    args.ddx[c] = registers_[image.gradX + c*g_spirvNumLanes + lane].f;
+                    args.ddy[c] = registers_[image.gradY + c*g_spirvNumLanes + lane].f;
+                }
+            }
+            else if ((image.flags & SpirvImageFlags::ImplicitLod) != 0)
+            {
+                /* Fine derivatives within the 2x2 quad: lanes are ordered (x, y), (x+1, y), (x, y+1), (x+1, y+1) */
+                const std::uint32_t laneX0 = (lane & 2u), laneY0 = (lane & 1u);
+                for_range(c, numSpatialCoords)
+                {
+                    args.ddx[c] = coords[laneX0 + 1][c] - coords[laneX0][c];
+                    args.ddy[c] = coords[laneY0 + 2][c] - coords[laneY0][c];
+                }
+            }
+
+            switch (image.op)
+            {
+                case SpirvImageOp::Sample:
+                {
+                    sampleArgs[lane]    = args;
+                    sampleImages[lane]  = binding->image;
+                    samplers[lane]      = sampler;
+                    sampleMask |= (1u << lane);
+                }
+                continue;
+
+                case SpirvImageOp::Fetch:
+                case SpirvImageOp::Read:
+                    imageHandler_->Fetch(binding->image, args, texel);
+                    break;
+
+                case SpirvImageOp::Write:
+                {
+                    for_range(c, std::min(image.numResults, 4u))
+                        texel[c] = registers_[image.texel + c*g_spirvNumLanes + lane];
+                    imageHandler_->Write(binding->image, args, texel);
+                }
+                break;
+
+                case SpirvImageOp::QuerySize:
+                {
+                    std::uint32_t size[4] = {};
+                    imageHandler_->QuerySize(binding->image, args.level, size);
+                    for_range(c, 4u)
+                        texel[c] = UIntValue(size[c]);
+                }
+                break;
+
+                case SpirvImageOp::QueryLevels:
+                    texel[0] = UIntValue(imageHandler_->QueryLevels(binding->image));
+                    break;
+
+                case SpirvImageOp::QuerySamples:
+                    texel[0] = UIntValue(imageHandler_->QuerySamples(binding->image));
+                    break;
+            }
+        }
+
+        /* Write result components */
+        if (image.result == g_spirvInvalidIndex)
+            continue;
+
+        for_range(c, std::min(image.numResults, 4u))
+            registers_[image.result + c*g_spirvNumLanes + lane] = texel[c];
+    }
+
+    if (sampleMask != 0)
+    {
+        SpirvValue texels[g_spirvNumLanes][4] = {};
+
+        /* Group lanes by image and sampler; divergent bindings are sampled in separate groups */
+        for (std::uint32_t remainingMask = sampleMask; remainingMask != 0;)
+        {
+            std::uint32_t first = 0;
+            while (!IsLaneActive(remainingMask, first))
+                ++first;
+
+            std::uint32_t groupMask = 0;
+            for_subrange(lane, first, g_spirvNumLanes)
+            {
+                if (IsLaneActive(remainingMask, lane) && sampleImages[lane] == sampleImages[first] && samplers[lane] == samplers[first])
+                    groupMask |= (1u << lane);
+            }
+
+            imageHandler_->SampleQuad(sampleImages[first], samplers[first], sampleArgs, groupMask, texels);
+            remainingMask &= ~groupMask;
+        }
+
+        if (image.result != g_spirvInvalidIndex)
+        {
+            for_range(lane, g_spirvNumLanes)
+            {
+                if (!IsLaneActive(sampleMask, lane))
+                    continue;
+                for_range(c, std::min(image.numResults, 4u))
+                    registers_[image.result + c*g_spirvNumLanes + lane] = texels[lane][c];
+            }
+        }
+    }
+}
+
+void SpirvInterpreter::ExecDerivative(const SpirvInstr& instr, std::uint32_t mask)
+{
+    /* Derivatives are only defined for fragment shaders where lanes form a 2x2 quad */
+    const bool isFragment   = (program_.GetExecutionModel() == spv::ExecutionModelFragment);
+    const bool isCoarse     = (instr.op == SpirvExecOp::DPdxCoarse || instr.op == SpirvExecOp::DPdyCoarse || instr.op == SpirvExecOp::FwidthCoarse);
+
+    for_range(c, instr.count)
+    {
+        const SpirvValue* v = Reg(instr.args[0] + c*g_spirvNumLanes);
+        SpirvValue* dst = Reg(instr.result + c*g_spirvNumLanes);
+
+        for_range(lane, g_spirvNumLanes)
+        {
+            if (!IsLaneActive(mask, lane))
+                continue;
+
+            float dx = 0.0f, dy = 0.0f;
+            if (isFragment)
+            {
+                const std::uint32_t laneX0 = (isCoarse ? 0u : (lane & 2u));
+                const std::uint32_t laneY0 = (isCoarse ? 0u : (lane & 1u));
+                dx = v[laneX0 + 1].f - v[laneX0].f;
+                dy = v[laneY0 + 2].f - v[laneY0].f;
+            }
+
+            switch (instr.op)
+            {
+                case SpirvExecOp::DPdxFine:
+                case SpirvExecOp::DPdxCoarse:
+                    dst[lane] = FloatValue(dx);
+                    break;
+                case SpirvExecOp::DPdyFine:
+                case SpirvExecOp::DPdyCoarse:
+                    dst[lane] = FloatValue(dy);
+                    break;
+                default:
+                    dst[lane] = FloatValue(std::abs(dx) + std::abs(dy));
+                    break;
+            }
+        }
+    }
+}
+
+SpirvValue* SpirvInterpreter::GetVariableMemory(std::uint32_t variable, std::uint32_t lane, std::uint32_t& outSize)
+{
+    const auto& variables = program_.GetVariables();
+    if (variable < variables.size())
+    {
+        const SpirvProgram::Variable& var = variables[variable];
+        switch (var.storage)
+        {
+            case SpirvStorage::Lane:
+                outSize = var.size;
+                return laneMemory_.data() + lane * program_.GetLaneStorageSize() + var.offset;
+
+            case SpirvStorage::Workgroup:
+                if (workgroupMemory_ != nullptr)
+                {
+                    outSize = var.size;
+                    return workgroupMemory_ + var.offset;
+                }
+                break;
+
+            case SpirvStorage::Buffer:
+                outSize = buffers_[var.resource].size;
+                return buffers_[var.resource].data;
+
+            case SpirvStorage::Handle:
+                /* Handle storage is read-only; stores are rejected by ExecStore() */
+                outSize = var.size;
+                return const_cast<SpirvValue*>(reinterpret_cast<const SpirvValue*>(program_.GetHandleWords().data() + var.offset));
+        }
+    }
+    outSize = 0;
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
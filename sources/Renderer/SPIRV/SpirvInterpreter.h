@@ -0,0 +1,224 @@
+/*
+ * SpirvInterpreter.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_SPIRV_INTERPRETER_H
+#define LLGL_SPIRV_INTERPRETER_H
+
+
+#include "SpirvProgram.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Arguments of a single image access of one lane.
+struct SpirvImageArgs
+{
+    spv::Dim        dim         = spv::Dim2D;
+    bool            arrayed     = false;
+    SpirvScalarKind kind        = SpirvScalarKind::Float;   // Scalar kind of the texel the shader expects.
+    std::uint32_t   flags       = 0;                        // Bitwise OR combination of SpirvImageFlags.
+    std::uint32_t   numCoords   = 0;
+    float           coords[4]   = {};                       // Texture coordinates for sampling. Array layer is the last coordinate.
+    std::int32_t    texel[4]    = {};                       // Texel coordinates for fetch, read, and write access.
+    float           dref        = 0.0f;
+    float           lod         = 0.0f;                     // Explicit level of detail or bias.
+    float           minLod      = 0.0f;
+    float           ddx[3]      = {};                       // Gradients for implicit or explicit level of detail selection.
+    float           ddy[3]      = {};
+    std::int32_t    offset[3]   = {};
+    std::int32_t    level       = 0;                        // MIP-map level for fetch access and size queries.
+    std::int32_t    sample      = 0;
+};
+
+/*
+Interface the SPIR-V interpreter uses to access images and samplers.
+The image and sampler pointers are opaque objects the client binds with SpirvInterpreter::SetImage().
+*/
+class SpirvImageHandler
+{
+
+    public:
+
+        virtual ~SpirvImageHandler() = default;
+
+        // Samples the image with the specified sampler. Depth comparison results are written to the first component.
+        virtual void Sample(const void* image, const void* sampler, const SpirvImageArgs& args, SpirvValue outTexel[4]) = 0;
+
+        /*
+        Samples the image with the specified sampler for all active lanes in 'mask' at once. All lanes share the same image and sampler.
+        The default implementation calls Sample() for each active lane.
+        */
+        virtual void SampleQuad(
+            const void*             image,
+            const void*             sampler,
+            const SpirvImageArgs    (&args)[g_spirvNumLanes],
+            std::uint32_t           mask,
+            SpirvValue              outTexels[g_spirvNumLanes][4])
+        {
+            for (std::uint32_t lane = 0; lane < g_spirvNumLanes; ++lane)
+            {
+                if ((mask & (1u << lane)) != 0)
+                    Sample(image, sampler, args[lane], outTexels[lane]);
+            }
+        }
+
+        // Reads a single texel from the image without sampler.
+        virtual void Fetch(const void* image, const SpirvImageArgs& args, SpirvValue outTexel[4]) = 0;
+
+        // Writes a single texel into a storage image.
+        virtual void Write(void* image, const SpirvImageArgs& args, const SpirvValue texel[4]) = 0;
+
+        // Writes the size of the specified MIP-map level including the number of array layers into 'outSize'.
+        virtual void QuerySize(const void* image, std::int32_t level, std::uint32_t outSize[4]) = 0;
+
+        // Returns the number of MIP-map levels.
+        virtual std::uint32_t QueryLevels(const void* image) = 0;
+
+        // Returns the number of samples.
+        virtual std::uint32_t QuerySamples(const void* /*image*/)
+        {
+            return 1;
+        }
+
+};
+
+/*
+Executes a compiled SPIR-V program for batches of up to g_spirvNumLanes invocations.
+Each interpreter holds the registers and memory of one batch and must only be used by one thread at a time.
+*/
+class SpirvInterpreter
+{
+
+    public:
+
+        enum class Status
+        {
+            Finished,   // All lanes have finished execution.
+            Barrier,    // Execution stopped at a workgroup barrier; call Resume() to continue.
+        };
+
+    public:
+
+        SpirvInterpreter(const SpirvProgram& program);
+
+        SpirvInterpreter(const SpirvInterpreter&) = delete;
+        SpirvInterpreter& operator = (const SpirvInterpreter&) = delete;
+
+        // Sets the handler for image instructions.
+        void SetImageHandler(SpirvImageHandler* handler);
+
+        // Binds memory to the buffer resource with the specified index. Size is specified in bytes.
+        void SetBuffer(std::uint32_t resource, void* data, std::uint64_t size);
+
+        // Binds an image and sampler to the specified handle (see SpirvProgram::Resource::firstHandle).
+        void SetImage(std::uint32_t handle, void* image, const void* sampler);
+
+        // Sets the memory of Workgroup variables that is shared with other interpreters. Null resets to the interpreter's own memory.
+        void SetWorkgroupMemory(SpirvValue* memory);
+
+        // Returns the memory of the specified interface slot for the specified lane.
+        SpirvValue* GetSlotData(const SpirvProgram::InterfaceSlot& slot, std::uint32_t lane);
+
+        // Executes the entry point for all lanes in 'laneMask'. Lanes in 'helperMask' are helper invocations without side effects.
+        Status Execute(std::uint32_t laneMask, std::uint32_t helperMask = 0);
+
+        // Resumes execution after a workgroup barrier.
+        Status Resume();
+
+        // Returns the mask of lanes that have not been terminated by OpKill.
+        inline std::uint32_t GetAliveMask() const
+        {
+            return aliveMask_;
+        }
+
+        // Returns the program this interpreter executes.
+        inline const SpirvProgram& GetProgram() const
+        {
+            return program_;
+        }
+
+    private:
+
+        // Call frame of a function. Lanes of a frame are executed block by block, always choosing the lowest pending block.
+        struct Frame
+        {
+            std::uint32_t   function                    = 0;
+            std::uint32_t   resultReg                   = g_spirvInvalidIndex;
+            std::uint32_t   pendingMask                 = 0;
+            std::uint32_t   execMask                    = 0;
+            std::uint32_t   pc                          = g_spirvInvalidIndex;
+            std::uint32_t   block                       = g_spirvInvalidIndex;
+            std::uint32_t   laneBlocks[g_spirvNumLanes] = {};
+            std::uint32_t   prevBlocks[g_spirvNumLanes] = {};
+        };
+
+        struct BufferBinding
+        {
+            SpirvValue*     data    = nullptr;
+            std::uint32_t   size    = 0;        // Size in words.
+        };
+
+        struct ImageBinding
+        {
+            void*       image   = nullptr;
+            const void* sampler = nullptr;
+        };
+
+    private:
+
+        Status Run();
+
+        void PushFrame(std::uint32_t function, std::uint32_t resultReg, std::uint32_t laneMask);
+
+        void ExecInstr(const SpirvProgram::Instr& instr, Frame& frame);
+        void ExecPhi(const SpirvProgram::Instr& instr, const Frame& frame);
+        void ExecLoad(const SpirvProgram::Instr& instr, std::uint32_t mask);
+        void ExecStore(const SpirvProgram::Instr& instr, std::uint32_t mask);
+        void ExecAccessChain(const SpirvProgram::Instr& instr, std::uint32_t mask);
+        void ExecAtomic(const SpirvProgram::Instr& instr, std::uint32_t mask);
+        void ExecImage(const SpirvProgram::ImageInstr& image, std::uint32_t mask);
+        void ExecDerivative(const SpirvProgram::Instr& instr, std::uint32_t mask);
+
+        // Returns the memory of the specified variable for the specified lane and its size in words.
+        SpirvValue* GetVariableMemory(std::uint32_t variable, std::uint32_t lane, std::uint32_t& outSize);
+
+        inline SpirvValue* Reg(std::uint32_t reg)
+        {
+            return &registers_[reg];
+        }
+
+    private:
+
+        const SpirvProgram&         program_;
+        SpirvImageHandler*          imageHandler_       = nullptr;
+
+        std::vector<SpirvValue>     registers_;
+        std::vector<SpirvValue>     laneMemory_;
+        std::vector<SpirvValue>     ownWorkgroupMemory_;
+        SpirvValue*                 workgroupMemory_    = nullptr;
+        std::vector<BufferBinding>  buffers_;
+        std::vector<ImageBinding>   images_;
+
+        std::vector<Frame>          frames_;
+        std::uint32_t               aliveMask_          = 0;
+        std::uint32_t               helperMask_         = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
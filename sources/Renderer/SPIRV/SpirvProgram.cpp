@@ -0,0 +1,2199 @@
+/*
+ * SpirvProgram.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "SpirvProgram.h"
+#include "../../Core/Assertion.h"
+#include <LLGL/Utils/ForRange.h>
+#include <spirv/1.2/GLSL.std.450.h>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+static std::uint64_t GetMemberKey(spv::Id structId, std::uint32_t member)
+{
+    return ((static_cast<std::uint64_t>(structId) << 32) | member);
+}
+
+// Returns the internal opcode for SPIR-V instructions whose operands map one-to-one to the instruction arguments.
+static bool GetComponentwiseExecOp(spv::Op opcode, SpirvExecOp& outOp)
+{
+    switch (opcode)
+    {
+        case spv::OpFNegate:                outOp = SpirvExecOp::FNegate;                   return true;
+        case spv::OpFAdd:                   outOp = SpirvExecOp::FAdd;                      return true;
+        case spv::OpFSub:                   outOp = SpirvExecOp::FSub;                      return true;
+        case spv::OpFMul:                   outOp = SpirvExecOp::FMul;                      return true;
+        case spv::OpFDiv:                   outOp = SpirvExecOp::FDiv;                      return true;
+        case spv::OpFRem:                   outOp = SpirvExecOp::FRem;                      return true;
+        case spv::OpFMod:                   outOp = SpirvExecOp::FMod;                      return true;
+        case spv::OpQuantizeToF16:          outOp = SpirvExecOp::QuantizeToF16;             return true;
+        case spv::OpSNegate:                outOp = SpirvExecOp::SNegate;                   return true;
+        case spv::OpIAdd:                   outOp = SpirvExecOp::IAdd;                      return true;
+        case spv::OpISub:                   outOp = SpirvExecOp::ISub;                      return true;
+        case spv::OpIMul:                   outOp = SpirvExecOp::IMul;                      return true;
+        case spv::OpUDiv:                   outOp = SpirvExecOp::UDiv;                      return true;
+        case spv::OpSDiv:                   outOp = SpirvExecOp::SDiv;                      return true;
+        case spv::OpUMod:                   outOp = SpirvExecOp::UMod;                      return true;
+        case spv::OpSRem:                   outOp = SpirvExecOp::SRem;                      return true;
+        case spv::OpSMod:                   outOp = SpirvExecOp::SMod;                      return true;
+        case spv::OpShiftRightLogical:      outOp = SpirvExecOp::ShiftRightLogical;         return true;
+        case spv::OpShiftRightArithmetic:   outOp = SpirvExecOp::ShiftRightArithmetic;      return true;
+        case spv::OpShiftLeftLogical:       outOp = SpirvExecOp::ShiftLeftLogical;          return true;
+        case spv::OpBitwiseOr:              outOp = SpirvExecOp::BitwiseOr;                 return true;
+        case spv::OpBitwiseXor:             outOp = SpirvExecOp::BitwiseXor;                return true;
+        case spv::OpBitwiseAnd:             outOp = SpirvExecOp::BitwiseAnd;                return true;
+        case spv::OpNot:                    outOp = SpirvExecOp::Not;                       return true;
+        case spv::OpBitFieldInsert:         outOp = SpirvExecOp::BitFieldInsert;            return true;
+        case spv::OpBitFieldSExtract:       outOp = SpirvExecOp::BitFieldSExtract;          return true;
+        case spv::OpBitFieldUExtract:       outOp = SpirvExecOp::BitFieldUExtract;          return true;
+        case spv::OpBitReverse:             outOp = SpirvExecOp::BitReverse;                return true;
+        case spv::OpBitCount:               outOp = SpirvExecOp::BitCount;                  return true;
+        case spv::OpIEqual:                 outOp = SpirvExecOp::IEqual;                    return true;
+        case spv::OpINotEqual:              outOp = SpirvExecOp::INotEqual;                 return true;
+        case spv::OpUGreaterThan:           outOp = SpirvExecOp::UGreaterThan;              return true;
+        case spv::OpSGreaterThan:           outOp = SpirvExecOp::SGreaterThan;              return true;
+        case spv::OpUGreaterThanEqual:      outOp = SpirvExecOp::UGreaterThanEqual;         return true;
+        case spv::OpSGreaterThanEqual:      outOp = SpirvExecOp::SGreaterThanEqual;         return true;
+        case spv::OpULessThan:              outOp = SpirvExecOp::ULessThan;                 return true;
+        case spv::OpSLessThan:              outOp = SpirvExecOp::SLessThan;                 return true;
+        case spv::OpULessThanEqual:         outOp = SpirvExecOp::ULessThanEqual;            return true;
+        case spv::OpSLessThanEqual:         outOp = SpirvExecOp::SLessThanEqual;            return true;
+        case spv::OpFOrdEqual:              outOp = SpirvExecOp::FOrdEqual;                 return true;
+        case spv::OpFUnordEqual:            outOp = SpirvExecOp::FUnordEqual;               return true;
+        case spv::OpFOrdNotEqual:           outOp = SpirvExecOp::FOrdNotEqual;              return true;
+        case spv::OpFUnordNotEqual:         outOp = SpirvExecOp::FUnordNotEqual;            return true;
+        case spv::OpFOrdLessThan:           outOp = SpirvExecOp::FOrdLessThan;              return true;
+        case spv::OpFUnordLessThan:         outOp = SpirvExecOp::FUnordLessThan;            return true;
+        case spv::OpFOrdGreaterThan:        outOp = SpirvExecOp::FOrdGreaterThan;           return true;
+        case spv::OpFUnordGreaterThan:      outOp = SpirvExecOp::FUnordGreaterThan;         return true;
+        case spv::OpFOrdLessThanEqual:      outOp = SpirvExecOp::FOrdLessThanEqual;         return true;
+        case spv::OpFUnordLessThanEqual:    outOp = SpirvExecOp::FUnordLessThanEqual;       return true;
+        case spv::OpFOrdGreaterThanEqual:   outOp = SpirvExecOp::FOrdGreaterThanEqual;      return true;
+        case spv::OpFUnordGreaterThanEqual: outOp = SpirvExecOp::FUnordGreaterThanEqual;    return true;
+        case spv::OpLogicalEqual:           outOp = SpirvExecOp::IEqual;                    return true;
+        case spv::OpLogicalNotEqual:        outOp = SpirvExecOp::INotEqual;                 return true;
+        case spv::OpLogicalOr:              outOp = SpirvExecOp::BitwiseOr;                 return true;
+        case spv::OpLogicalAnd:             outOp = SpirvExecOp::BitwiseAnd;                return true;
+        case spv::OpLogicalNot:             outOp = SpirvExecOp::LogicalNot;                return true;
+        case spv::OpIsNan:                  outOp = SpirvExecOp::IsNan;                     return true;
+        case spv::OpIsInf:                  outOp = SpirvExecOp::IsInf;                     return true;
+        case spv::OpConvertFToU:            outOp = SpirvExecOp::ConvertFToU;               return true;
+        case spv::OpConvertFToS:            outOp = SpirvExecOp::ConvertFToS;               return true;
+        case spv::OpConvertSToF:            outOp = SpirvExecOp::ConvertSToF;               return true;
+        case spv::OpConvertUToF:            outOp = SpirvExecOp::ConvertUToF;               return true;
+        case spv::OpDPdx:                   outOp = SpirvExecOp::DPdxFine;                  return true;
+        case spv::OpDPdy:                   outOp = SpirvExecOp::DPdyFine;                  return true;
+        case spv::OpFwidth:                 outOp = SpirvExecOp::FwidthFine;                return true;
+        case spv::OpDPdxFine:               outOp = SpirvExecOp::DPdxFine;                  return true;
+        case spv::OpDPdyFine:               outOp = SpirvExecOp::DPdyFine;                  return true;
+        case spv::OpFwidthFine:             outOp = SpirvExecOp::FwidthFine;                return true;
+        case spv::OpDPdxCoarse:             outOp = SpirvExecOp::DPdxCoarse;                return true;
+        case spv::OpDPdyCoarse:             outOp = SpirvExecOp::DPdyCoarse;                return true;
+        case spv::OpFwidthCoarse:           outOp = SpirvExecOp::FwidthCoarse;              return true;
+        default:                                                                            return false;
+    }
+}
+
+// Returns the internal opcode for GLSL.std.450 instructions whose operands map one-to-one to the instruction arguments.
+static bool GetComponentwiseExecOp(GLSLstd450 inst, SpirvExecOp& outOp)
+{
+    switch (inst)
+    {
+        case GLSLstd450Round:           outOp = SpirvExecOp::Round;         return true;
+        case GLSLstd450RoundEven:       outOp = SpirvExecOp::RoundEven;     return true;
+        case GLSLstd450Trunc:           outOp = SpirvExecOp::Trunc;         return true;
+        case GLSLstd450FAbs:            outOp = SpirvExecOp::FAbs;          return true;
+        case GLSLstd450SAbs:            outOp = SpirvExecOp::SAbs;          return true;
+        case GLSLstd450FSign:           outOp = SpirvExecOp::FSign;         return true;
+        case GLSLstd450SSign:           outOp = SpirvExecOp::SSign;         return true;
+        case GLSLstd450Floor:           outOp = SpirvExecOp::Floor;         return true;
+        case GLSLstd450Ceil:            outOp = SpirvExecOp::Ceil;          return true;
+        case GLSLstd450Fract:           outOp = SpirvExecOp::Fract;         return true;
+        case GLSLstd450Radians:         outOp = SpirvExecOp::Radians;       return true;
+        case GLSLstd450Degrees:         outOp = SpirvExecOp::Degrees;       return true;
+        case GLSLstd450Sin:             outOp = SpirvExecOp::Sin;           return true;
+        case GLSLstd450Cos:             outOp = SpirvExecOp::Cos;           return true;
+        case GLSLstd450Tan:             outOp = SpirvExecOp::Tan;           return true;
+        case GLSLstd450Asin:            outOp = SpirvExecOp::Asin;          return true;
+        case GLSLstd450Acos:            outOp = SpirvExecOp::Acos;          return true;
+        case GLSLstd450Atan:            outOp = SpirvExecOp::Atan;          return true;
+        case GLSLstd450Sinh:            outOp = SpirvExecOp::Sinh;          return true;
+        case GLSLstd450Cosh:            outOp = SpirvExecOp::Cosh;          return true;
+        case GLSLstd450Tanh:            outOp = SpirvExecOp::Tanh;          return true;
+        case GLSLstd450Asinh:           outOp = SpirvExecOp::Asinh;         return true;
+        case GLSLstd450Acosh:           outOp = SpirvExecOp::Acosh;         return true;
+        case GLSLstd450Atanh:           outOp = SpirvExecOp::Atanh;         return true;
+        case GLSLstd450Atan2:           outOp = SpirvExecOp::Atan2;         return true;
+        case GLSLstd450Pow:             outOp = SpirvExecOp::Pow;           return true;
+        case GLSLstd450Exp:             outOp = SpirvExecOp::Exp;           return true;
+        case GLSLstd450Log:             outOp = SpirvExecOp::Log;           return true;
+        case GLSLstd450Exp2:            outOp = SpirvExecOp::Exp2;          return true;
+        case GLSLstd450Log2:            outOp = SpirvExecOp::Log2;          return true;
+        case GLSLstd450Sqrt:            outOp = SpirvExecOp::Sqrt;          return true;
+        case GLSLstd450InverseSqrt:     outOp = SpirvExecOp::InverseSqrt;   return true;
+        case GLSLstd450FMin:            outOp = SpirvExecOp::FMin;          return true;
+        case GLSLstd450NMin:            outOp = SpirvExecOp::FMin;          return true;
+        case GLSLstd450UMin:            outOp = SpirvExecOp::UMin;          return true;
+        case GLSLstd450SMin:            outOp = SpirvExecOp::SMin;          return true;
+        case GLSLstd450FMax:            outOp = SpirvExecOp::FMax;          return true;
+        case GLSLstd450NMax:            outOp = SpirvExecOp::FMax;          return true;
+        case GLSLstd450UMax:            outOp = SpirvExecOp::UMax;          return true;
+        case GLSLstd450SMax:            outOp = SpirvExecOp::SMax;          return true;
+        case GLSLstd450FClamp:          outOp = SpirvExecOp::FClamp;        return true;
+        case GLSLstd450NClamp:          outOp = SpirvExecOp::FClamp;        return true;
+        case GLSLstd450UClamp:          outOp = SpirvExecOp::UClamp;        return true;
+        case GLSLstd450SClamp:          outOp = SpirvExecOp::SClamp;        return true;
+        case GLSLstd450FMix:            outOp = SpirvExecOp::FMix;          return true;
+        case GLSLstd450Step:            outOp = SpirvExecOp::Step;          return true;
+        case GLSLstd450SmoothStep:      outOp = SpirvExecOp::SmoothStep;    return true;
+        case GLSLstd450Fma:             outOp = SpirvExecOp::Fma;           return true;
+        case GLSLstd450Ldexp:           outOp = SpirvExecOp::Ldexp;         return true;
+        case GLSLstd450Normalize:       outOp = SpirvExecOp::Normalize;     return true;
+        case GLSLstd450Cross:           outOp = SpirvExecOp::Cross;         return true;
+        case GLSLstd450FaceForward:     outOp = SpirvExecOp::FaceForward;   return true;
+        case GLSLstd450Reflect:         outOp = SpirvExecOp::Reflect;       return true;
+        case GLSLstd450Refract:         outOp = SpirvExecOp::Refract;       return true;
+        case GLSLstd450FindILsb:        outOp = SpirvExecOp::FindILsb;      return true;
+        case GLSLstd450FindSMsb:        outOp = SpirvExecOp::FindSMsb;      return true;
+        case GLSLstd450FindUMsb:        outOp = SpirvExecOp::FindUMsb;      return true;
+        case GLSLstd450PackSnorm4x8:    outOp = SpirvExecOp::PackSnorm4x8;  return true;
+        case GLSLstd450PackUnorm4x8:    outOp = SpirvExecOp::PackUnorm4x8;  return true;
+        case GLSLstd450PackSnorm2x16:   outOp = SpirvExecOp::PackSnorm2x16; return true;
+        case GLSLstd450PackUnorm2x16:   outOp = SpirvExecOp::PackUnorm2x16; return true;
+        case GLSLstd450PackHalf2x16:    outOp = SpirvExecOp::PackHalf2x16;  return true;
+        case GLSLstd450UnpackSnorm4x8:  outOp = SpirvExecOp::UnpackSnorm4x8;return true;
+        case GLSLstd450UnpackUnorm4x8:  outOp = SpirvExecOp::UnpackUnorm4x8;return true;
+        case GLSLstd450UnpackSnorm2x16: outOp = SpirvExecOp::UnpackSnorm2x16;return true;
+        case GLSLstd450UnpackUnorm2x16: outOp = SpirvExecOp::UnpackUnorm2x16;return true;
+        case GLSLstd450UnpackHalf2x16:  outOp = SpirvExecOp::UnpackHalf2x16;return true;
+        default:                                                            return false;
+    }
+}
+
+static bool GetAtomicOp(spv::Op opcode, SpirvAtomicOp& outOp)
+{
+    switch (opcode)
+    {
+        case spv::OpAtomicExchange:             outOp = SpirvAtomicOp::Exchange;        return true;
+        case spv::OpAtomicCompareExchange:      outOp = SpirvAtomicOp::CompareExchange; return true;
+        case spv::OpAtomicCompareExchangeWeak:  outOp = SpirvAtomicOp::CompareExchange; return true;
+        case spv::OpAtomicIIncrement:           outOp = SpirvAtomicOp::IIncrement;      return true;
+        case spv::OpAtomicIDecrement:           outOp = SpirvAtomicOp::IDecrement;      return true;
+        case spv::OpAtomicIAdd:                 outOp = SpirvAtomicOp::IAdd;            return true;
+        case spv::OpAtomicISub:                 outOp = SpirvAtomicOp::ISub;            return true;
+        case spv::OpAtomicSMin:                 outOp = SpirvAtomicOp::SMin;            return true;
+        case spv::OpAtomicUMin:                 outOp = SpirvAtomicOp::UMin;            return true;
+        case spv::OpAtomicSMax:                 outOp = SpirvAtomicOp::SMax;            return true;
+        case spv::OpAtomicUMax:                 outOp = SpirvAtomicOp::UMax;            return true;
+        case spv::OpAtomicAnd:                  outOp = SpirvAtomicOp::And;             return true;
+        case spv::OpAtomicOr:                   outOp = SpirvAtomicOp::Or;              return true;
+        case spv::OpAtomicXor:                  outOp = SpirvAtomicOp::Xor;             return true;
+        default:                                                                        return false;
+    }
+}
+
+
+/*
+ * SpirvProgram class
+ */
+
+bool SpirvProgram::LayoutKey::operator < (const LayoutKey& rhs) const
+{
+    if (type != rhs.type)
+        return (type < rhs.type);
+    if (matrixStride != rhs.matrixStride)
+        return (matrixStride < rhs.matrixStride);
+    if (isExplicit != rhs.isExplicit)
+        return rhs.isExplicit;
+    return (!rowMajor && rhs.rowMajor);
+}
+
+bool SpirvProgram::Compile(const SpirvModuleView& module, spv::ExecutionModel executionModel, const char* entryPoint)
+{
+    *this = SpirvProgram{};
+
+    /* Parse SPIR-V header */
+    SpirvHeader header;
+    if (module.ReadHeader(header) != SpirvResult::NoError)
+        return Error("invalid SPIR-V module header");
+
+    ids_.resize(header.idBound);
+    executionModel_ = executionModel;
+
+    /* Parse all declarations and allocate registers for all results */
+    if (!ParseDeclarations(module, entryPoint))
+        return false;
+
+    /* Compile entry point and all functions it calls */
+    if (!CompileFunctions())
+        return false;
+
+    /* Release compilation state */
+    ids_.clear();
+    decorations_.clear();
+    memberDecorations_.clear();
+    layoutCache_.clear();
+    functionDecls_.clear();
+    interfaceIds_.clear();
+    initializers_.clear();
+
+    return true;
+}
+
+bool SpirvProgram::Error(const char* format, ...)
+{
+    if (errorMessage_.empty())
+    {
+        char buffer[256];
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        errorMessage_ = buffer;
+    }
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool SpirvProgram::ParseDeclarations(const SpirvModuleView& module, const char* entryPoint)
+{
+    std::uint32_t currentDecl = g_spirvInvalidIndex;
+
+    for (auto it = module.begin(); it != module.end(); ++it)
+    {
+        /* Validate instruction word count before accessing its operands */
+        if (it.WordCount() == 0 || it.Ptr() + it.WordCount() > module.end().Ptr())
+            return Error("invalid SPIR-V instruction word count");
+
+        const SpirvInstruction instr = *it;
+        if (instr.result >= ids_.size() || instr.type >= ids_.size())
+            return Error("SPIR-V ID out of bounds: %u", std::max(instr.result, instr.type));
+
+        switch (instr.opcode)
+        {
+            case spv::OpExtInstImport:
+            {
+                const char* name = instr.GetString(0);
+                if (std::strcmp(name, "GLSL.std.450") == 0)
+                    glslStd450_ = instr.result;
+                else if (std::strncmp(name, "NonSemantic.", 12) == 0)
+                    ignoredExtInstSets_.push_back(instr.result);
+            }
+            break;
+
+            case spv::OpEntryPoint:
+            {
+                if (instr.numOperands >= 3 &&
+                    static_cast<spv::ExecutionModel>(instr.operands[0]) == executionModel_ &&
+                    std::strcmp(instr.GetString(2), entryPoint) == 0)
+                {
+                    entryPointId_ = instr.operands[1];
+                    const std::uint32_t firstInterface = instr.FindStringEndOperand(2);
+                    interfaceIds_.assign(instr.operands + firstInterface, instr.operands + instr.numOperands);
+                }
+            }
+            break;
+
+            case spv::OpExecutionMode:
+            {
+                if (entryPointId_ != 0 && instr.numOperands >= 2 && instr.operands[0] == entryPointId_)
+                    ParseExecutionMode(instr);
+            }
+            break;
+
+            case spv::OpDecorate:
+            {
+                if (instr.numOperands >= 2)
+                    ParseDecoration(instr, decorations_[instr.operands[0]], 1);
+            }
+            break;
+
+            case spv::OpMemberDecorate:
+            {
+                if (instr.numOperands >= 3)
+                    ParseDecoration(instr, memberDecorations_[GetMemberKey(instr.operands[0], instr.operands[1])], 2);
+            }
+            break;
+
+            case spv::OpTypeVoid:
+            case spv::OpTypeBool:
+            case spv::OpTypeInt:
+            case spv::OpTypeFloat:
+            case spv::OpTypeVector:
+            case spv::OpTypeMatrix:
+            case spv::OpTypeImage:
+            case spv::OpTypeSampler:
+            case spv::OpTypeSampledImage:
+            case spv::OpTypeArray:
+            case spv::OpTypeRuntimeArray:
+            case spv::OpTypeStruct:
+            case spv::OpTypePointer:
+            case spv::OpTypeFunction:
+            {
+                if (!ParseType(instr))
+                    return false;
+            }
+            break;
+
+            case spv::OpConstantTrue:
+            case spv::OpConstantFalse:
+            case spv::OpConstant:
+            case spv::OpConstantComposite:
+            case spv::OpConstantNull:
+            case spv::OpSpecConstantTrue:
+            case spv::OpSpecConstantFalse:
+            case spv::OpSpecConstant:
+            case spv::OpSpecConstantComposite:
+            {
+                if (!ParseConstant(instr))
+                    return false;
+            }
+            break;
+
+            case spv::OpConstantSampler:
+                return Error("literal sampler constants are not supported");
+
+            case spv::OpSpecConstantOp:
+                return Error("specialization constant operations are not supported");
+
+            case spv::OpFunction:
+            {
+                if (currentDecl != g_spirvInvalidIndex)
+                    return Error("nested SPIR-V function declaration");
+
+                currentDecl = static_cast<std::uint32_t>(functionDecls_.size());
+                ids_[instr.result].opcode   = spv::OpFunction;
+                ids_[instr.result].function = currentDecl;
+
+                FunctionDecl decl;
+                {
+                    decl.begin = it.Ptr() + it.WordCount();
+                }
+                functionDecls_.push_back(decl);
+            }
+            break;
+
+            case spv::OpFunctionEnd:
+            {
+                if (currentDecl == g_spirvInvalidIndex)
+                    return Error("SPIR-V function end without function declaration");
+                functionDecls_[currentDecl].end = it.Ptr();
+                currentDecl = g_spirvInvalidIndex;
+            }
+            break;
+
+            case spv::OpVariable:
+            {
+                if (currentDecl == g_spirvInvalidIndex)
+                {
+                    if (!ParseGlobalVariable(instr))
+                        return false;
+                }
+                else if (!ParseFunctionResult(instr, functionDecls_[currentDecl]))
+                    return false;
+            }
+            break;
+
+            case spv::OpUndef:
+            {
+                const Type* type = FindType(instr.type);
+                if (type == nullptr)
+                    return Error("invalid result type of SPIR-V ID %u", instr.result);
+                ids_[instr.result].opcode   = instr.opcode;
+                ids_[instr.result].type     = ids_[instr.type].typeIndex;
+                ids_[instr.result].reg      = AllocRegister(type->numComponents);
+            }
+            break;
+
+            case spv::OpTypeForwardPointer:
+            case spv::OpTypeOpaque:
+            case spv::OpTypeEvent:
+            case spv::OpTypeDeviceEvent:
+            case spv::OpTypeReserveId:
+            case spv::OpTypeQueue:
+            case spv::OpTypePipe:
+                return Error("unsupported SPIR-V type declaration (opcode %u)", static_cast<std::uint32_t>(instr.opcode));
+
+            default:
+            {
+                if (currentDecl != g_spirvInvalidIndex)
+                {
+                    if (!ParseFunctionResult(instr, functionDecls_[currentDecl]))
+                        return false;
+                }
+            }
+            break;
+        }
+    }
+
+    if (entryPointId_ == 0 || entryPointId_ >= ids_.size() || ids_[entryPointId_].function == g_spirvInvalidIndex)
+        return Error("entry point \"%s\" not found in SPIR-V module", entryPoint);
+
+    return true;
+}
+
+void SpirvProgram::ParseDecoration(const SpirvInstruction& instr, Decorations& decorations, std::uint32_t firstOperand)
+{
+    const spv::Decoration decoration = static_cast<spv::Decoration>(instr.operands[firstOperand]);
+    const std::uint32_t value = (firstOperand + 1 < instr.numOperands ? instr.operands[firstOperand + 1] : 0);
+
+    switch (decoration)
+    {
+        case spv::DecorationBuiltIn:        decorations.builtin         = static_cast<spv::BuiltIn>(value); break;
+        case spv::DecorationLocation:       decorations.location        = value;                            break;
+        case spv::DecorationComponent:      decorations.component       = value;                            break;
+        case spv::DecorationIndex:          decorations.index           = value;                            break;
+        case spv::DecorationBinding:        decorations.binding         = value;                            break;
+        case spv::DecorationDescriptorSet:  decorations.set             = value;                            break;
+        case spv::DecorationOffset:         decorations.offset          = value;                            break;
+        case spv::DecorationArrayStride:    decorations.arrayStride     = value;                            break;
+        case spv::DecorationMatrixStride:   decorations.matrixStride    = value;                            break;
+        case spv::DecorationRowMajor:       decorations.rowMajor        = true;                             break;
+        case spv::DecorationFlat:           decorations.flat            = true;                             break;
+        case spv::DecorationBlock:          decorations.block           = true;                             break;
+        case spv::DecorationBufferBlock:    decorations.bufferBlock     = true;                             break;
+        case spv::DecorationNonWritable:    decorations.nonWritable     = true;                             break;
+        default:                                                                                            break;
+    }
+}
+
+void SpirvProgram::ParseExecutionMode(const SpirvInstruction& instr)
+{
+    switch (static_cast<spv::ExecutionMode>(instr.operands[1]))
+    {
+        case spv::ExecutionModeOriginUpperLeft:
+            executionModes_.originUpperLeft = true;
+            break;
+        case spv::ExecutionModePixelCenterInteger:
+            executionModes_.pixelCenterInteger = true;
+            break;
+        case spv::ExecutionModeEarlyFragmentTests:
+            executionModes_.earlyFragmentTests = true;
+            break;
+        case spv::ExecutionModeDepthReplacing:
+            executionModes_.depthReplacing = true;
+            break;
+        case spv::ExecutionModeLocalSize:
+            for_range(i, 3u)
+            {
+                if (2 + i < instr.numOperands)
+                    executionModes_.localSize[i] = std::max(1u, instr.operands[2 + i]);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool SpirvProgram::ParseType(const SpirvInstruction& instr)
+{
+    Type type;
+    type.opcode = instr.opcode;
+    type.id     = instr.result;
+
+    switch (instr.opcode)
+    {
+        case spv::OpTypeVoid:
+        case spv::OpTypeFunction:
+            break;
+
+        case spv::OpTypeBool:
+            type.numComponents  = 1;
+            type.kind           = SpirvScalarKind::Bool;
+            break;
+
+        case spv::OpTypeInt:
+            if (instr.GetUInt32(0) != 32)
+                return Error("unsupported %u-bit integer type; only 32-bit types are supported", instr.GetUInt32(0));
+            type.numComponents  = 1;
+            type.kind           = (instr.GetUInt32(1) != 0 ? SpirvScalarKind::SInt : SpirvScalarKind::UInt);
+            break;
+
+        case spv::OpTypeFloat:
+            if (instr.GetUInt32(0) != 32)
+                return Error("unsupported %u-bit floating-point type; only 32-bit types are supported", instr.GetUInt32(0));
+            type.numComponents  = 1;
+            type.kind           = SpirvScalarKind::Float;
+            break;
+
+        case spv::OpTypeVector:
+        case spv::OpTypeMatrix:
+        case spv::OpTypeArray:
+        case spv::OpTypeRuntimeArray:
+        {
+            const Type* elementType = FindType(instr.GetUInt32(0));
+            if (elementType == nullptr)
+                return Error("invalid element type of SPIR-V type %u", instr.result);
+
+            type.elementType    = ids_[instr.GetUInt32(0)].typeIndex;
+            type.kind           = elementType->kind;
+
+            if (instr.opcode == spv::OpTypeArray)
+            {
+                if (!GetConstantUInt(instr.GetUInt32(1), type.length))
+                    return Error("invalid array length of SPIR-V type %u", instr.result);
+            }
+            else if (instr.opcode != spv::OpTypeRuntimeArray)
+                type.length = instr.GetUInt32(1);
+
+            type.numComponents = elementType->numComponents * type.length;
+        }
+        break;
+
+        case spv::OpTypeImage:
+        {
+            const Type* sampledType = FindType(instr.GetUInt32(0));
+            if (sampledType == nullptr)
+                return Error("invalid sampled type of SPIR-V image type %u", instr.result);
+
+            type.numComponents  = 1;
+            type.elementType    = ids_[instr.GetUInt32(0)].typeIndex;
+            type.kind           = sampledType->kind;
+            type.dim            = static_cast<spv::Dim>(instr.GetUInt32(1));
+            type.arrayed        = (instr.GetUInt32(3) != 0);
+            type.multisampled   = (instr.GetUInt32(4) != 0);
+            type.sampled        = instr.GetUInt32(5);
+            type.imageFormat    = static_cast<spv::ImageFormat>(instr.GetUInt32(6));
+        }
+        break;
+
+        case spv::OpTypeSampler:
+            type.numComponents = 1;
+            break;
+
+        case spv::OpTypeSampledImage:
+        {
+            const Type* imageType = FindType(instr.GetUInt32(0));
+            if (imageType == nullptr || imageType->opcode != spv::OpTypeImage)
+                return Error("invalid image type of SPIR-V sampled image type %u", instr.result);
+
+            type                = *imageType;
+            type.opcode         = spv::OpTypeSampledImage;
+            type.id             = instr.result;
+            type.numComponents  = 2;
+            type.elementType    = ids_[instr.GetUInt32(0)].typeIndex;
+        }
+        break;
+
+        case spv::OpTypeStruct:
+        {
+            for_range(i, instr.numOperands)
+            {
+                const Type* memberType = FindType(instr.operands[i]);
+                if (memberType == nullptr)
+                    return Error("invalid member type of SPIR-V structure type %u", instr.result);
+                type.members.push_back(ids_[instr.operands[i]].typeIndex);
+                type.numComponents += memberType->numComponents;
+            }
+        }
+        break;
+
+        case spv::OpTypePointer:
+        {
+            const Type* pointeeType = FindType(instr.GetUInt32(1));
+            if (pointeeType == nullptr)
+                return Error("invalid pointee type of SPIR-V pointer type %u", instr.result);
+
+            /* Pointers are stored as pair of variable index and word offset */
+            type.numComponents  = 2;
+            type.storage        = static_cast<spv::StorageClass>(instr.GetUInt32(0));
+            type.elementType    = ids_[instr.GetUInt32(1)].typeIndex;
+        }
+        break;
+
+        default:
+            return Error("unsupported SPIR-V type (opcode %u)", static_cast<std::uint32_t>(instr.opcode));
+    }
+
+    ids_[instr.result].opcode       = instr.opcode;
+    ids_[instr.result].typeIndex    = static_cast<std::uint32_t>(types_.size());
+    types_.push_back(std::move(type));
+
+    return true;
+}
+
+bool SpirvProgram::ParseConstant(const SpirvInstruction& instr)
+{
+    const Type* type = FindType(instr.type);
+    if (type == nullptr)
+        return Error("invalid result type of SPIR-V constant %u", instr.result);
+
+    const std::uint32_t reg = AllocRegister(type->numComponents);
+
+    Id& id = ids_[instr.result];
+    id.opcode   = instr.opcode;
+    id.type     = ids_[instr.type].typeIndex;
+    id.reg      = reg;
+
+    /* Writes the specified value into all lanes of the specified component */
+    auto WriteComponent = [this, reg](std::uint32_t component, SpirvValue value)
+    {
+        for_range(lane, g_spirvNumLanes)
+            registers_[reg + component*g_spirvNumLanes + lane] = value;
+    };
+
+    SpirvValue value;
+    value.u = 0;
+
+    switch (instr.opcode)
+    {
+        case spv::OpConstantTrue:
+        case spv::OpSpecConstantTrue:
+            value.u = 1;
+            WriteComponent(0, value);
+            break;
+
+        case spv::OpConstantFalse:
+        case spv::OpSpecConstantFalse:
+            WriteComponent(0, value);
+            break;
+
+        case spv::OpConstant:
+        case spv::OpSpecConstant:
+            value.u = instr.GetUInt32(0);
+            WriteComponent(0, value);
+            break;
+
+        case spv::OpConstantComposite:
+        case spv::OpSpecConstantComposite:
+        {
+            /* Concatenate the flattened components of all constituents */
+            std::uint32_t component = 0;
+            for_range(i, instr.numOperands)
+            {
+                const spv::Id constituent = instr.operands[i];
+                if (constituent >= ids_.size() || ids_[constituent].reg == g_spirvInvalidIndex)
+                    return Error("invalid constituent of SPIR-V constant %u", instr.result);
+
+                const std::uint32_t numComponents = GetNumComponents(constituent);
+                for_range(c, numComponents)
+                {
+                    if (component < type->numComponents)
+                        WriteComponent(component++, registers_[ids_[constituent].reg + c*g_spirvNumLanes]);
+                }
+            }
+        }
+        break;
+
+        default:
+            /* OpConstantNull is already initialized with zeros */
+            break;
+    }
+
+    return true;
+}
+
+bool SpirvProgram::ParseGlobalVariable(const SpirvInstruction& instr)
+{
+    const Type* pointerType = FindType(instr.type);
+    if (pointerType == nullptr || pointerType->opcode != spv::OpTypePointer)
+        return Error("invalid pointer type of SPIR-V variable %u", instr.result);
+
+    const spv::StorageClass storage     = static_cast<spv::StorageClass>(instr.GetUInt32(0));
+    const std::uint32_t     pointeeType = pointerType->elementType;
+
+    Decorations decorations;
+    {
+        auto it = decorations_.find(instr.result);
+        if (it != decorations_.end())
+            decorations = it->second;
+    }
+
+    std::uint32_t variable = 0;
+
+    switch (storage)
+    {
+        case spv::StorageClassInput:
+        case spv::StorageClassOutput:
+        case spv::StorageClassPrivate:
+            variable = AllocVariable(SpirvStorage::Lane, GetLayout(pointeeType, false));
+            break;
+
+        case spv::StorageClassWorkgroup:
+            variable = AllocVariable(SpirvStorage::Workgroup, GetLayout(pointeeType, false));
+            break;
+
+        case spv::StorageClassUniform:
+        case spv::StorageClassStorageBuffer:
+        case spv::StorageClassPushConstant:
+            variable = AllocVariable(SpirvStorage::Buffer, GetLayout(pointeeType, true));
+            if (!AddResource(variable, pointeeType, decorations, storage))
+                return false;
+            break;
+
+        case spv::StorageClassUniformConstant:
+            variable = AllocVariable(SpirvStorage::Handle, GetLayout(pointeeType, false));
+            if (!AddResource(variable, pointeeType, decorations, storage))
+                return false;
+            break;
+
+        default:
+            return Error("unsupported storage class of SPIR-V variable %u: %u", instr.result, static_cast<std::uint32_t>(storage));
+    }
+
+    Id& id = ids_[instr.result];
+    id.opcode   = spv::OpVariable;
+    id.type     = ids_[instr.type].typeIndex;
+    id.reg      = AllocPointer(variable);
+    id.layout   = variables_[variable].layout;
+
+    /* Store initializers of global variables when the entry point is invoked */
+    if (instr.numOperands >= 2)
+        initializers_.push_back({ instr.result, instr.operands[1] });
+
+    /* Add interface slots of input and output variables the entry point refers to */
+    if ((storage == spv::StorageClassInput || storage == spv::StorageClassOutput) &&
+        std::find(interfaceIds_.begin(), interfaceIds_.end(), instr.result) != interfaceIds_.end())
+    {
+        AddInterfaceSlots(storage == spv::StorageClassInput ? inputs_ : outputs_, variable, pointeeType, decorations);
+    }
+
+    return true;
+}
+
+bool SpirvProgram::ParseFunctionResult(const SpirvInstruction& instr, FunctionDecl& decl)
+{
+    switch (instr.opcode)
+    {
+        case spv::OpLabel:
+        {
+            ids_[instr.result].opcode = spv::OpLabel;
+        }
+        break;
+
+        case spv::OpVariable:
+        {
+            const Type* pointerType = FindType(instr.type);
+            if (pointerType == nullptr || pointerType->opcode != spv::OpTypePointer)
+                return Error("invalid pointer type of SPIR-V variable %u", instr.result);
+
+            const std::uint32_t variable = AllocVariable(SpirvStorage::Lane, GetLayout(pointerType->elementType, false));
+
+            Id& id = ids_[instr.result];
+            id.opcode   = spv::OpVariable;
+            id.type     = ids_[instr.type].typeIndex;
+            id.reg      = AllocPointer(variable);
+            id.layout   = variables_[variable].layout;
+        }
+        break;
+
+        default:
+        {
+            const SpirvInstructionInfo info = GetSpirvInstructionInfo(instr.opcode);
+            if (info.hasType && info.hasResult)
+            {
+                const Type* type = FindType(instr.type);
+                if (type == nullptr)
+                    return Error("invalid result type of SPIR-V ID %u", instr.result);
+
+                Id& id = ids_[instr.result];
+                id.opcode   = instr.opcode;
+                id.type     = ids_[instr.type].typeIndex;
+                id.reg      = AllocRegister(type->numComponents);
+
+                if (instr.opcode == spv::OpFunctionParameter)
+                {
+                    decl.params.push_back(instr.result);
+                    if (type->opcode == spv::OpTypePointer)
+                        id.layout = GetLayout(type->elementType, IsExplicitLayoutStorage(type->storage));
+                }
+            }
+        }
+        break;
+    }
+    return true;
+}
+
+bool SpirvProgram::CompileFunctions()
+{
+    /* Entry point is always the first function */
+    entryFunction_ = GetFunctionIndex(entryPointId_);
+
+    for (std::size_t i = 0; i < pendingFunctions_.size(); ++i)
+    {
+        if (!CompileFunction(pendingFunctions_[i]))
+            return false;
+    }
+
+    return true;
+}
+
+bool SpirvProgram::CompileFunction(std::uint32_t declIndex)
+{
+    const FunctionDecl& decl = functionDecls_[declIndex];
+    if (decl.begin == nullptr || decl.end == nullptr)
+        return Error("incomplete SPIR-V function declaration");
+
+    const SpirvConstForwardIterator begin{ decl.begin }, end{ decl.end };
+
+    /* Assign block indices to all labels of this function */
+    Function& function = functions_[decl.index];
+    function.firstBlock = static_cast<std::uint32_t>(blocks_.size());
+
+    for (auto it = begin; it != end; ++it)
+    {
+        if (it.WordCount() == 0)
+            return Error("invalid SPIR-V instruction word count");
+        if (it.Opcode() == spv::OpLabel)
+        {
+            const SpirvInstruction instr = *it;
+            ids_[instr.result].block = function.firstBlock + function.numBlocks++;
+        }
+    }
+
+    if (function.numBlocks == 0)
+        return Error("SPIR-V function without blocks");
+
+    blocks_.resize(function.firstBlock + function.numBlocks);
+
+    /* Compile all instructions */
+    const bool isEntryPoint = (decl.index == entryFunction_);
+    bool isFirstBlock = true;
+
+    for (auto it = begin; it != end; ++it)
+    {
+        const SpirvInstruction instr = *it;
+
+        if (instr.opcode == spv::OpLabel)
+        {
+            FlushPhis();
+            blocks_[ids_[instr.result].block].firstInstr = static_cast<std::uint32_t>(instrs_.size());
+
+            /* Initialize global variables at the beginning of the entry point */
+            if (isEntryPoint && isFirstBlock)
+            {
+                for (const auto& init : initializers_)
+                    EmitInstr(SpirvExecOp::Store, 0, 0, GetRegister(init.first), GetRegister(init.second), ids_[init.first].layout);
+            }
+            isFirstBlock = false;
+        }
+        else
+        {
+            if (instr.opcode != spv::OpPhi && instr.opcode != spv::OpLine && instr.opcode != spv::OpNoLine)
+                FlushPhis();
+            if (!CompileInstr(instr))
+                return false;
+        }
+
+        if (!errorMessage_.empty())
+            return false;
+    }
+
+    return true;
+}
+
+bool SpirvProgram::CompileInstr(const SpirvInstruction& instr)
+{
+    /* Compile component-wise instructions */
+    SpirvExecOp execOp = SpirvExecOp::Copy;
+    if (GetComponentwiseExecOp(instr.opcode, execOp))
+    {
+        std::uint32_t args[3] = { 0, 0, 0 };
+        for_range(i, std::min(3u, instr.numOperands))
+            args[i] = GetRegister(instr.operands[i]);
+        EmitInstr(execOp, GetNumComponents(instr.result), GetRegister(instr.result), args[0], args[1], args[2], (instr.numOperands > 3 ? GetRegister(instr.operands[3]) : 0));
+        return true;
+    }
+
+    switch (instr.opcode)
+    {
+        /* ----- Ignored instructions ----- */
+
+        case spv::OpNop:
+        case spv::OpLine:
+        case spv::OpNoLine:
+        case spv::OpUndef:
+        case spv::OpFunctionParameter:
+        case spv::OpSelectionMerge:
+        case spv::OpLoopMerge:
+        case spv::OpMemoryBarrier:
+        case spv::OpLifetimeStart:
+        case spv::OpLifetimeStop:
+            break;
+
+        /* ----- Memory ----- */
+
+        case spv::OpVariable:
+        {
+            /* Store initializer of function variable */
+            if (instr.numOperands >= 2)
+                EmitInstr(SpirvExecOp::Store, 0, 0, GetRegister(instr.result), GetRegister(instr.operands[1]), ids_[instr.result].layout);
+        }
+        break;
+
+        case spv::OpLoad:
+        {
+            const std::uint32_t layout = GetPointerLayout(instr.GetUInt32(0));
+            if (layouts_[layout].offsets.size() != GetNumComponents(instr.result))
+                return Error("cannot load SPIR-V ID %u with unsized type", instr.result);
+            EmitInstr(SpirvExecOp::Load, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), layout);
+        }
+        break;
+
+        case spv::OpStore:
+        {
+            const std::uint32_t layout = GetPointerLayout(instr.GetUInt32(0));
+            EmitInstr(SpirvExecOp::Store, 0, 0, GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)), layout);
+        }
+        break;
+
+        case spv::OpCopyMemory:
+        {
+            const std::uint32_t dstLayout   = GetPointerLayout(instr.GetUInt32(0));
+            const std::uint32_t srcLayout   = GetPointerLayout(instr.GetUInt32(1));
+            const std::uint32_t temp        = AllocRegister(static_cast<std::uint32_t>(layouts_[srcLayout].offsets.size()));
+            EmitInstr(SpirvExecOp::Load, static_cast<std::uint32_t>(layouts_[srcLayout].offsets.size()), temp, GetRegister(instr.GetUInt32(1)), srcLayout);
+            EmitInstr(SpirvExecOp::Store, 0, 0, GetRegister(instr.GetUInt32(0)), temp, dstLayout);
+        }
+        break;
+
+        case spv::OpAccessChain:
+        case spv::OpInBoundsAccessChain:
+            return CompileAccessChain(instr);
+
+        case spv::OpArrayLength:
+        {
+            const Layout& structLayout = layouts_[GetPointerLayout(instr.GetUInt32(0))];
+            const std::uint32_t member = instr.GetUInt32(1);
+            if (member >= structLayout.children.size())
+                return Error("invalid member index of SPIR-V array length instruction %u", instr.result);
+
+            const Layout& arrayLayout = layouts_[structLayout.children[member]];
+            EmitInstr(SpirvExecOp::ArrayLength, 1, GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), structLayout.memberOffsets[member], std::max(1u, arrayLayout.stride));
+        }
+        break;
+
+        /* ----- Composites ----- */
+
+        case spv::OpCopyObject:
+        case spv::OpBitcast:
+        case spv::OpUConvert:
+        case spv::OpSConvert:
+        case spv::OpFConvert:
+        {
+            /* All supported types are 32-bit wide, so these instructions only copy the value */
+            EmitCopy(GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)));
+            ids_[instr.result].layout = ids_[instr.GetUInt32(0)].layout;
+        }
+        break;
+
+        case spv::OpCompositeConstruct:
+        {
+            std::uint32_t component = 0;
+            for_range(i, instr.numOperands)
+            {
+                const std::uint32_t numComponents = GetNumComponents(instr.operands[i]);
+                EmitCopy(numComponents, GetRegister(instr.result) + component*g_spirvNumLanes, GetRegister(instr.operands[i]));
+                component += numComponents;
+            }
+        }
+        break;
+
+        case spv::OpCompositeExtract:
+            return CompileCompositeExtract(instr, false);
+
+        case spv::OpCompositeInsert:
+            return CompileCompositeExtract(instr, true);
+
+        case spv::OpVectorShuffle:
+        {
+            const std::uint32_t numComponents0 = GetNumComponents(instr.GetUInt32(0));
+            for_subrange(i, 2, instr.numOperands)
+            {
+                const std::uint32_t component = instr.operands[i];
+                if (component == 0xFFFFFFFFu)
+                    continue;
+
+                const std::uint32_t dst = GetRegister(instr.result) + (i - 2)*g_spirvNumLanes;
+                if (component < numComponents0)
+                    EmitCopy(1, dst, GetRegister(instr.GetUInt32(0)) + component*g_spirvNumLanes);
+                else
+                    EmitCopy(1, dst, GetRegister(instr.GetUInt32(1)) + (component - numComponents0)*g_spirvNumLanes);
+            }
+        }
+        break;
+
+        case spv::OpVectorExtractDynamic:
+        {
+            EmitInstr(SpirvExecOp::VectorExtractDynamic, GetNumComponents(instr.GetUInt32(0)), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)));
+        }
+        break;
+
+        case spv::OpVectorInsertDynamic:
+        {
+            const std::uint32_t numComponents = GetNumComponents(instr.result);
+            EmitCopy(numComponents, GetRegister(instr.result), GetRegister(instr.GetUInt32(0)));
+            EmitInstr(SpirvExecOp::VectorInsertDynamic, numComponents, GetRegister(instr.result), GetRegister(instr.GetUInt32(2)), GetRegister(instr.GetUInt32(1)));
+        }
+        break;
+
+        case spv::OpSelect:
+        {
+            const std::uint32_t isVectorCondition = (GetNumComponents(instr.GetUInt32(0)) > 1 ? 1 : 0);
+            EmitInstr(SpirvExecOp::Select, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)), GetRegister(instr.GetUInt32(2)), isVectorCondition);
+            ids_[instr.result].layout = ids_[instr.GetUInt32(1)].layout;
+        }
+        break;
+
+        /* ----- Arithmetic ----- */
+
+        case spv::OpIAddCarry:
+        case spv::OpISubBorrow:
+        case spv::OpUMulExtended:
+        case spv::OpSMulExtended:
+        {
+            const SpirvExecOp op =
+            (
+                instr.opcode == spv::OpIAddCarry    ? SpirvExecOp::IAddCarry    :
+                instr.opcode == spv::OpISubBorrow   ? SpirvExecOp::ISubBorrow   :
+                instr.opcode == spv::OpUMulExtended ? SpirvExecOp::UMulExtended :
+                                                      SpirvExecOp::SMulExtended
+            );
+            EmitInstr(op, GetNumComponents(instr.GetUInt32(0)), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)));
+        }
+        break;
+
+        case spv::OpAny:
+        case spv::OpAll:
+        {
+            const SpirvExecOp op = (instr.opcode == spv::OpAny ? SpirvExecOp::Any : SpirvExecOp::All);
+            EmitInstr(op, GetNumComponents(instr.GetUInt32(0)), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)));
+        }
+        break;
+
+        case spv::OpVectorTimesScalar:
+        case spv::OpMatrixTimesScalar:
+        {
+            EmitInstr(SpirvExecOp::VectorTimesScalar, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)));
+        }
+        break;
+
+        case spv::OpMatrixTimesVector:
+        {
+            const Type* matrixType = FindResultType(instr.GetUInt32(0));
+            EmitInstr(SpirvExecOp::MatrixTimesVector, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)), matrixType->length);
+        }
+        break;
+
+        case spv::OpVectorTimesMatrix:
+        {
+            EmitInstr(SpirvExecOp::VectorTimesMatrix, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)), GetNumComponents(instr.GetUInt32(0)));
+        }
+        break;
+
+        case spv::OpMatrixTimesMatrix:
+        {
+            const Type* lhsType = FindResultType(instr.GetUInt32(0));
+            const std::uint32_t rows = types_[lhsType->elementType].length;
+            EmitInstr(SpirvExecOp::MatrixTimesMatrix, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)), rows, lhsType->length);
+        }
+        break;
+
+        case spv::OpOuterProduct:
+        {
+            EmitInstr(SpirvExecOp::OuterProduct, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)), GetNumComponents(instr.GetUInt32(0)));
+        }
+        break;
+
+        case spv::OpTranspose:
+        {
+            const Type* matrixType = FindResultType(instr.GetUInt32(0));
+            EmitInstr(SpirvExecOp::Transpose, GetNumComponents(instr.result), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), 0, types_[matrixType->elementType].length);
+        }
+        break;
+
+        case spv::OpDot:
+        {
+            EmitInstr(SpirvExecOp::Dot, GetNumComponents(instr.GetUInt32(0)), GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(1)));
+        }
+        break;
+
+        case spv::OpExtInst:
+            return CompileExtInstr(instr);
+
+        /* ----- Atomics ----- */
+
+        case spv::OpAtomicLoad:
+        {
+            EmitInstr(SpirvExecOp::AtomicLoad, 1, GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), GetPointerLayout(instr.GetUInt32(0)));
+        }
+        break;
+
+        case spv::OpAtomicStore:
+        {
+            EmitInstr(SpirvExecOp::AtomicStore, 0, 0, GetRegister(instr.GetUInt32(0)), GetRegister(instr.GetUInt32(3)), GetPointerLayout(instr.GetUInt32(0)));
+        }
+        break;
+
+        case spv::OpAtomicExchange:
+        case spv::OpAtomicCompareExchange:
+        case spv::OpAtomicCompareExchangeWeak:
+        case spv::OpAtomicIIncrement:
+        case spv::OpAtomicIDecrement:
+        case spv::OpAtomicIAdd:
+        case spv::OpAtomicISub:
+        case spv::OpAtomicSMin:
+        case spv::OpAtomicUMin:
+        case spv::OpAtomicSMax:
+        case spv::OpAtomicUMax:
+        case spv::OpAtomicAnd:
+        case spv::OpAtomicOr:
+        case spv::OpAtomicXor:
+        {
+            SpirvAtomicOp atomicOp = SpirvAtomicOp::Exchange;
+            GetAtomicOp(instr.opcode, atomicOp);
+
+            std::uint32_t value = 0, comparator = 0;
+            if (atomicOp == SpirvAtomicOp::CompareExchange)
+            {
+                value       = GetRegister(instr.GetUInt32(5));
+                comparator  = GetRegister(instr.GetUInt32(6));
+            }
+            else if (atomicOp != SpirvAtomicOp::IIncrement && atomicOp != SpirvAtomicOp::IDecrement)
+                value = GetRegister(instr.GetUInt32(3));
+
+            EmitInstr(SpirvExecOp::AtomicExchange, 1, GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), value, comparator, static_cast<std::uint32_t>(atomicOp));
+        }
+        break;
+
+        /* ----- Images ----- */
+
+        case spv::OpSampledImage:
+        {
+            EmitCopy(1, GetRegister(instr.result), GetRegister(instr.GetUInt32(0)));
+            EmitCopy(1, GetRegister(instr.result) + g_spirvNumLanes, GetRegister(instr.GetUInt32(1)));
+        }
+        break;
+
+        case spv::OpImage:
+        {
+            EmitCopy(1, GetRegister(instr.result), GetRegister(instr.GetUInt32(0)));
+        }
+        break;
+
+        case spv::OpImageSampleImplicitLod:
+        case spv::OpImageSampleExplicitLod:
+        case spv::OpImageSampleDrefImplicitLod:
+        case spv::OpImageSampleDrefExplicitLod:
+        case spv::OpImageSampleProjImplicitLod:
+        case spv::OpImageSampleProjExplicitLod:
+        case spv::OpImageSampleProjDrefImplicitLod:
+        case spv::OpImageSampleProjDrefExplicitLod:
+        case spv::OpImageFetch:
+        case spv::OpImageRead:
+        case spv::OpImageWrite:
+        case spv::OpImageQuerySizeLod:
+        case spv::OpImageQuerySize:
+        case spv::OpImageQueryLevels:
+        case spv::OpImageQuerySamples:
+            return CompileImageInstr(instr);
+
+        /* ----- Control flow ----- */
+
+        case spv::OpPhi:
+        {
+            const std::uint32_t numComponents = GetNumComponents(instr.result);
+            const std::uint32_t firstOperand = static_cast<std::uint32_t>(operands_.size());
+            for (std::uint32_t i = 0; i + 1 < instr.numOperands; i += 2)
+            {
+                operands_.push_back(GetRegister(instr.operands[i]));
+                operands_.push_back(GetBlock(instr.operands[i + 1]));
+            }
+
+            /* Evaluate all phi instructions of a block before any of them is written to their result */
+            const std::uint32_t temp = AllocRegister(numComponents);
+            pendingPhis_.push_back({ static_cast<std::uint32_t>(instrs_.size()), GetRegister(instr.result) });
+            EmitInstr(SpirvExecOp::Phi, numComponents, temp, firstOperand, instr.numOperands / 2);
+            ids_[instr.result].layout = ids_[instr.GetUInt32(0)].layout;
+        }
+        break;
+
+        case spv::OpBranch:
+        {
+            EmitInstr(SpirvExecOp::Branch, 0, 0, GetBlock(instr.GetUInt32(0)));
+        }
+        break;
+
+        case spv::OpBranchConditional:
+        {
+            EmitInstr(SpirvExecOp::BranchConditional, 0, 0, GetRegister(instr.GetUInt32(0)), GetBlock(instr.GetUInt32(1)), GetBlock(instr.GetUInt32(2)));
+        }
+        break;
+
+        case spv::OpSwitch:
+        {
+            const std::uint32_t firstOperand = static_cast<std::uint32_t>(operands_.size());
+            for (std::uint32_t i = 2; i + 1 < instr.numOperands; i += 2)
+            {
+                operands_.push_back(instr.operands[i]);
+                operands_.push_back(GetBlock(instr.operands[i + 1]));
+            }
+            EmitInstr(SpirvExecOp::Switch, (instr.numOperands - 2) / 2, 0, GetRegister(instr.GetUInt32(0)), GetBlock(instr.GetUInt32(1)), firstOperand);
+        }
+        break;
+
+        case spv::OpFunctionCall:
+        {
+            const spv::Id functionId = instr.GetUInt32(0);
+            if (functionId >= ids_.size() || ids_[functionId].function == g_spirvInvalidIndex)
+                return Error("invalid function of SPIR-V call %u", instr.result);
+
+            const FunctionDecl& callee = functionDecls_[ids_[functionId].function];
+            if (callee.params.size() + 1 != instr.numOperands)
+                return Error("mismatch between number of arguments and parameters in SPIR-V call %u", instr.result);
+
+            /* Store triples of argument register, parameter register, and number of components */
+            const std::uint32_t firstOperand = static_cast<std::uint32_t>(operands_.size());
+            for_subrange(i, 1, instr.numOperands)
+            {
+                operands_.push_back(GetRegister(instr.operands[i]));
+                operands_.push_back(GetRegister(callee.params[i - 1]));
+                operands_.push_back(GetNumComponents(callee.params[i - 1]));
+            }
+
+            EmitInstr(SpirvExecOp::Call, instr.numOperands - 1, ids_[instr.result].reg, GetFunctionIndex(functionId), firstOperand);
+        }
+        break;
+
+        case spv::OpReturn:
+            EmitInstr(SpirvExecOp::Return, 0, 0);
+            break;
+
+        case spv::OpReturnValue:
+            EmitInstr(SpirvExecOp::ReturnValue, GetNumComponents(instr.GetUInt32(0)), 0, GetRegister(instr.GetUInt32(0)));
+            break;
+
+        case spv::OpKill:
+            if (executionModel_ != spv::ExecutionModelFragment)
+                return Error("OpKill is only allowed in fragment shaders");
+            EmitInstr(SpirvExecOp::Kill, 0, 0);
+            hasKill_ = true;
+            break;
+
+        case spv::OpUnreachable:
+            EmitInstr(SpirvExecOp::Unreachable, 0, 0);
+            break;
+
+        case spv::OpControlBarrier:
+        {
+            /* Only workgroup execution barriers in compute shaders need to synchronize invocations */
+            std::uint32_t scope = 0;
+            if (executionModel_ == spv::ExecutionModelGLCompute &&
+                GetConstantUInt(instr.GetUInt32(0), scope) &&
+                scope == static_cast<std::uint32_t>(spv::ScopeWorkgroup))
+            {
+                EmitInstr(SpirvExecOp::Barrier, 0, 0);
+                hasBarriers_ = true;
+            }
+        }
+        break;
+
+        default:
+            return Error("unsupported SPIR-V instruction (opcode %u)", static_cast<std::uint32_t>(instr.opcode));
+    }
+
+    return true;
+}
+
+bool SpirvProgram::CompileExtInstr(const SpirvInstruction& instr)
+{
+    const spv::Id set = instr.GetUInt32(0);
+
+    /* Ignore non-semantic instructions such as debug information */
+    if (std::find(ignoredExtInstSets_.begin(), ignoredExtInstSets_.end(), set) != ignoredExtInstSets_.end())
+        return true;
+
+    if (set != glslStd450_ || glslStd450_ == 0)
+        return Error("unsupported SPIR-V extended instruction set in instruction %u", instr.result);
+
+    const GLSLstd450    inst            = static_cast<GLSLstd450>(instr.GetUInt32(1));
+    const std::uint32_t numArgs         = instr.numOperands - 2;
+    const spv::Id*      args            = instr.operands + 2;
+    const std::uint32_t result          = GetRegister(instr.result);
+    const std::uint32_t numComponents   = GetNumComponents(instr.result);
+
+    SpirvExecOp execOp = SpirvExecOp::Copy;
+    if (GetComponentwiseExecOp(inst, execOp))
+    {
+        std::uint32_t argRegs[3] = { 0, 0, 0 };
+        for_range(i, std::min(3u, numArgs))
+            argRegs[i] = GetRegister(args[i]);
+
+        /* Packing and vector reductions specify the number of input components */
+        const bool isPacking = (execOp >= SpirvExecOp::PackSnorm4x8 && execOp <= SpirvExecOp::PackHalf2x16);
+        EmitInstr(execOp, (isPacking ? GetNumComponents(args[0]) : numComponents), result, argRegs[0], argRegs[1], argRegs[2]);
+        return true;
+    }
+
+    switch (inst)
+    {
+        case GLSLstd450Length:
+        case GLSLstd450Distance:
+        {
+            const SpirvExecOp op = (inst == GLSLstd450Length ? SpirvExecOp::Length : SpirvExecOp::Distance);
+            EmitInstr(op, GetNumComponents(args[0]), result, GetRegister(args[0]), (numArgs > 1 ? GetRegister(args[1]) : 0));
+        }
+        break;
+
+        case GLSLstd450Determinant:
+        {
+            EmitInstr(SpirvExecOp::Determinant, 1, result, GetRegister(args[0]), 0, FindResultType(args[0])->length);
+        }
+        break;
+
+        case GLSLstd450MatrixInverse:
+        {
+            EmitInstr(SpirvExecOp::MatrixInverse, numComponents, result, GetRegister(args[0]), 0, FindResultType(args[0])->length);
+        }
+        break;
+
+        case GLSLstd450Modf:
+        case GLSLstd450Frexp:
+        {
+            /* Write second output into temporary register, then store it to the output pointer */
+            const SpirvExecOp   op      = (inst == GLSLstd450Modf ? SpirvExecOp::Modf : SpirvExecOp::Frexp);
+            const std::uint32_t temp    = AllocRegister(numComponents);
+            EmitInstr(op, numComponents, result, GetRegister(args[0]), temp);
+            EmitInstr(SpirvExecOp::Store, 0, 0, GetRegister(args[1]), temp, GetPointerLayout(args[1]));
+        }
+        break;
+
+        case GLSLstd450ModfStruct:
+        case GLSLstd450FrexpStruct:
+        {
+            /* Write both outputs into the members of the result structure */
+            const SpirvExecOp   op          = (inst == GLSLstd450ModfStruct ? SpirvExecOp::Modf : SpirvExecOp::Frexp);
+            const std::uint32_t memberSize  = numComponents / 2;
+            EmitInstr(op, memberSize, result, GetRegister(args[0]), result + memberSize*g_spirvNumLanes);
+        }
+        break;
+
+        case GLSLstd450InterpolateAtCentroid:
+        case GLSLstd450InterpolateAtSample:
+        case GLSLstd450InterpolateAtOffset:
+        {
+            /* Fragment inputs are always interpolated at the pixel center */
+            EmitInstr(SpirvExecOp::Load, numComponents, result, GetRegister(args[0]), GetPointerLayout(args[0]));
+        }
+        break;
+
+        default:
+            return Error("unsupported GLSL.std.450 instruction: %u", static_cast<std::uint32_t>(inst));
+    }
+
+    return true;
+}
+
+bool SpirvProgram::CompileImageInstr(const SpirvInstruction& instr)
+{
+    ImageInstr image;
+    std::uint32_t nextOperand = 1;
+
+    switch (instr.opcode)
+    {
+        case spv::OpImageSampleImplicitLod:
+            image.flags = SpirvImageFlags::ImplicitLod;
+            break;
+        case spv::OpImageSampleExplicitLod:
+            break;
+        case spv::OpImageSampleDrefImplicitLod:
+            image.flags = SpirvImageFlags::ImplicitLod | SpirvImageFlags::Dref;
+            break;
+        case spv::OpImageSampleDrefExplicitLod:
+            image.flags = SpirvImageFlags::Dref;
+            break;
+        case spv::OpImageSampleProjImplicitLod:
+            image.flags = SpirvImageFlags::ImplicitLod | SpirvImageFlags::Proj;
+            break;
+        case spv::OpImageSampleProjExplicitLod:
+            image.flags = SpirvImageFlags::Proj;
+            break;
+        case spv::OpImageSampleProjDrefImplicitLod:
+            image.flags = SpirvImageFlags::ImplicitLod | SpirvImageFlags::Dref | SpirvImageFlags::Proj;
+            break;
+        case spv::OpImageSampleProjDrefExplicitLod:
+            image.flags = SpirvImageFlags::Dref | SpirvImageFlags::Proj;
+            break;
+        case spv::OpImageFetch:
+            image.op = SpirvImageOp::Fetch;
+            break;
+        case spv::OpImageRead:
+            image.op = SpirvImageOp::Read;
+            break;
+        case spv::OpImageWrite:
+            image.op = SpirvImageOp::Write;
+            break;
+        case spv::OpImageQuerySizeLod:
+        case spv::OpImageQuerySize:
+            image.op = SpirvImageOp::QuerySize;
+            break;
+        case spv::OpImageQueryLevels:
+            image.op = SpirvImageOp::QueryLevels;
+            break;
+        case spv::OpImageQuerySamples:
+            image.op = SpirvImageOp::QuerySamples;
+            break;
+        default:
+            return Error("unsupported SPIR-V image instruction (opcode %u)", static_cast<std::uint32_t>(instr.opcode));
+    }
+
+    /* Get image type from image operand */
+    const Type* imageType = FindResultType(instr.GetUInt32(0));
+    if (imageType == nullptr || (imageType->opcode != spv::OpTypeImage && imageType->opcode != spv::OpTypeSampledImage))
+        return Error("invalid image operand in SPIR-V image instruction");
+
+    image.type  = (imageType->opcode == spv::OpTypeSampledImage ? imageType->elementType : ids_[instr.GetUInt32(0)].type);
+    image.image = GetRegister(instr.GetUInt32(0));
+
+    switch (image.op)
+    {
+        case SpirvImageOp::Sample:
+        case SpirvImageOp::Fetch:
+        case SpirvImageOp::Read:
+        case SpirvImageOp::Write:
+        {
+            image.coord     = GetRegister(instr.GetUInt32(1));
+            image.numCoords = GetNumComponents(instr.GetUInt32(1));
+            nextOperand     = 2;
+
+            if ((image.flags & SpirvImageFlags::Dref) != 0)
+                image.dref = GetRegister(instr.GetUInt32(nextOperand++));
+            if (image.op == SpirvImageOp::Write)
+            {
+                image.texel         = GetRegister(instr.GetUInt32(nextOperand));
+                image.numResults    = GetNumComponents(instr.GetUInt32(nextOperand));
+                ++nextOperand;
+            }
+        }
+        break;
+
+        case SpirvImageOp::QuerySize:
+        {
+            if (instr.opcode == spv::OpImageQuerySizeLod)
+            {
+                image.lod   = GetRegister(instr.GetUInt32(1));
+                image.flags = SpirvImageFlags::Lod;
+            }
+            nextOperand = instr.numOperands;
+        }
+        break;
+
+        default:
+        {
+            nextOperand = instr.numOperands;
+        }
+        break;
+    }
+
+    /* Parse optional image operands */
+    if (nextOperand < instr.numOperands)
+    {
+        const std::uint32_t mask = instr.GetUInt32(nextOperand++);
+
+        if ((mask & spv::ImageOperandsBiasMask) != 0)
+        {
+            image.lod = GetRegister(instr.GetUInt32(nextOperand++));
+            image.flags |= SpirvImageFlags::Bias;
+        }
+        if ((mask & spv::ImageOperandsLodMask) != 0)
+        {
+            image.lod = GetRegister(instr.GetUInt32(nextOperand++));
+            image.flags = ((image.flags & ~SpirvImageFlags::ImplicitLod) | SpirvImageFlags::Lod);
+        }
+        if ((mask & spv::ImageOperandsGradMask) != 0)
+        {
+            image.gradX = GetRegister(instr.GetUInt32(nextOperand++));
+            image.gradY = GetRegister(instr.GetUInt32(nextOperand++));
+            image.flags = ((image.flags & ~SpirvImageFlags::ImplicitLod) | SpirvImageFlags::Grad);
+        }
+        if ((mask & (spv::ImageOperandsConstOffsetMask | spv::ImageOperandsOffsetMask)) != 0)
+        {
+            image.offset = GetRegister(instr.GetUInt32(nextOperand++));
+            image.flags |= SpirvImageFlags::Offset;
+        }
+        if ((mask & spv::ImageOperandsConstOffsetsMask) != 0)
+            return Error("constant offsets of image gather instructions are not supported");
+        if ((mask & spv::ImageOperandsSampleMask) != 0)
+        {
+            image.sample = GetRegister(instr.GetUInt32(nextOperand++));
+            image.flags |= SpirvImageFlags::Sample;
+        }
+        if ((mask & spv::ImageOperandsMinLodMask) != 0)
+        {
+            image.minLod = GetRegister(instr.GetUInt32(nextOperand++));
+            image.flags |= SpirvImageFlags::MinLod;
+        }
+    }
+
+    /* Implicit LOD is only available in fragment shaders */
+    if (executionModel_ != spv::ExecutionModelFragment)
+        image.flags &= ~SpirvImageFlags::ImplicitLod;
+
+    if (instr.result != 0)
+    {
+        image.result        = GetRegister(instr.result);
+        image.numResults    = GetNumComponents(instr.result);
+    }
+
+    EmitInstr(SpirvExecOp::Image, 0, 0, static_cast<std::uint32_t>(imageInstrs_.size()));
+    imageInstrs_.push_back(image);
+
+    return true;
+}
+
+bool SpirvProgram::CompileAccessChain(const SpirvInstruction& instr)
+{
+    std::uint32_t layout = GetPointerLayout(instr.GetUInt32(0));
+    if (layout == g_spirvInvalidIndex)
+        return false;
+
+    /* Accumulate constant indices into a single offset and store all dynamic indices with their stride */
+    std::uint32_t constOffset = 0, numDynamicIndices = 0;
+    const std::uint32_t firstOperand = static_cast<std::uint32_t>(operands_.size());
+
+    for_subrange(i, 1, instr.numOperands)
+    {
+        const spv::Id       index   = instr.operands[i];
+        const spv::Op       opcode  = types_[layouts_[layout].type].opcode;
+        std::uint32_t       child   = 0;
+        std::uint32_t       stride  = 0;
+
+        if (opcode == spv::OpTypeStruct)
+        {
+            std::uint32_t member = 0;
+            if (!GetConstantUInt(index, member) || member >= layouts_[layout].children.size())
+                return Error("invalid member index in SPIR-V access chain %u", instr.result);
+
+            constOffset += layouts_[layout].memberOffsets[member];
+            layout = layouts_[layout].children[member];
+            continue;
+        }
+        else if (opcode == spv::OpTypeVector)
+        {
+            child   = GetLayout(types_[layouts_[layout].type].elementType, false);
+            stride  = layouts_[layout].stride;
+        }
+        else if (opcode == spv::OpTypeMatrix || opcode == spv::OpTypeArray || opcode == spv::OpTypeRuntimeArray)
+        {
+            child   = layouts_[layout].children[0];
+            stride  = layouts_[layout].stride;
+        }
+        else
+            return Error("invalid base type in SPIR-V access chain %u", instr.result);
+
+        std::uint32_t constIndex = 0;
+        if (GetConstantUInt(index, constIndex))
+            constOffset += constIndex * stride;
+        else
+        {
+            operands_.push_back(GetRegister(index));
+            operands_.push_back(stride);
+            ++numDynamicIndices;
+        }
+
+        layout = child;
+    }
+
+    EmitInstr(SpirvExecOp::AccessChain, numDynamicIndices, GetRegister(instr.result), GetRegister(instr.GetUInt32(0)), constOffset, firstOperand);
+    ids_[instr.result].layout = layout;
+
+    return true;
+}
+
+bool SpirvProgram::CompileCompositeExtract(const SpirvInstruction& instr, bool isInsert)
+{
+    /* Determine flattened component offset of the indexed element */
+    const spv::Id       composite       = instr.GetUInt32(isInsert ? 1 : 0);
+    const std::uint32_t firstIndex      = (isInsert ? 2 : 1);
+    const Type*         type            = FindResultType(composite);
+    std::uint32_t       componentOffset = 0;
+
+    for_subrange(i, firstIndex, instr.numOperands)
+    {
+        if (type == nullptr)
+            return Error("invalid composite in SPIR-V instruction %u", instr.result);
+
+        const std::uint32_t index = instr.operands[i];
+        if (type->opcode == spv::OpTypeStruct)
+        {
+            if (index >= type->members.size())
+                return Error("invalid member index in SPIR-V instruction %u", instr.result);
+            for_range(m, index)
+                componentOffset += types_[type->members[m]].numComponents;
+            type = &types_[type->members[index]];
+        }
+        else
+        {
+            const Type& elementType = types_[type->elementType];
+            componentOffset += index * elementType.numComponents;
+            type = &elementType;
+        }
+    }
+
+    const std::uint32_t result = GetRegister(instr.result);
+    if (isInsert)
+    {
+        EmitCopy(GetNumComponents(instr.result), result, GetRegister(composite));
+        EmitCopy(GetNumComponents(instr.GetUInt32(0)), result + componentOffset*g_spirvNumLanes, GetRegister(instr.GetUInt32(0)));
+    }
+    else
+        EmitCopy(GetNumComponents(instr.result), result, GetRegister(composite) + componentOffset*g_spirvNumLanes);
+
+    return true;
+}
+
+void SpirvProgram::FlushPhis()
+{
+    if (pendingPhis_.size() == 1)
+    {
+        /* Single phi instruction can write directly into its result */
+        instrs_[pendingPhis_[0].first].result = pendingPhis_[0].second;
+    }
+    else
+    {
+        for (const auto& phi : pendingPhis_)
+        {
+            const Instr& instr = instrs_[phi.first];
+            EmitCopy(instr.count, phi.second, instr.result);
+        }
+    }
+    pendingPhis_.clear();
+}
+
+void SpirvProgram::AddInterfaceSlots(std::vector<InterfaceSlot>& slots, std::uint32_t variable, std::uint32_t type, const Decorations& decorations)
+{
+    const Type& varType = types_[type];
+
+    if (decorations.builtin != spv::BuiltInMax)
+    {
+        /* Add single slot for built-in variable */
+        InterfaceSlot slot;
+        {
+            slot.variable       = variable;
+            slot.numComponents  = varType.numComponents;
+            slot.builtin        = decorations.builtin;
+            slot.kind           = varType.kind;
+        }
+        slots.push_back(slot);
+    }
+    else if (varType.opcode == spv::OpTypeStruct)
+    {
+        /* Add slots for each member of interface blocks */
+        const Layout& layout = layouts_[variables_[variable].layout];
+        std::uint32_t location = (decorations.location != g_spirvInvalidIndex ? decorations.location : 0);
+
+        for_range(i, varType.members.size())
+        {
+            Decorations memberDecorations;
+            {
+                auto it = memberDecorations_.find(GetMemberKey(varType.id, i));
+                if (it != memberDecorations_.end())
+                    memberDecorations = it->second;
+            }
+
+            if (memberDecorations.builtin != spv::BuiltInMax)
+            {
+                InterfaceSlot slot;
+                {
+                    slot.variable       = variable;
+                    slot.offset         = layout.memberOffsets[i];
+                    slot.numComponents  = types_[varType.members[i]].numComponents;
+                    slot.builtin        = memberDecorations.builtin;
+                    slot.kind           = types_[varType.members[i]].kind;
+                }
+                slots.push_back(slot);
+            }
+            else
+            {
+                if (memberDecorations.location != g_spirvInvalidIndex)
+                    location = memberDecorations.location;
+                AddLocationSlots(slots, variable, varType.members[i], layout.memberOffsets[i], location, memberDecorations.component, (decorations.flat || memberDecorations.flat));
+            }
+        }
+    }
+    else
+    {
+        std::uint32_t location = (decorations.location != g_spirvInvalidIndex ? decorations.location : 0);
+        const std::size_t firstSlot = slots.size();
+        AddLocationSlots(slots, variable, type, 0, location, decorations.component, decorations.flat);
+
+        /* Index decoration is only valid for variables at the top level of fragment outputs */
+        for_subrange(i, firstSlot, slots.size())
+            slots[i].index = decorations.index;
+    }
+}
+
+void SpirvProgram::AddLocationSlots(
+    std::vector<InterfaceSlot>& slots,
+    std::uint32_t               variable,
+    std::uint32_t               type,
+    std::uint32_t               offset,
+    std::uint32_t&              location,
+    std::uint32_t               component,
+    bool                        flat)
+{
+    const Type& varType = types_[type];
+    switch (varType.opcode)
+    {
+        case spv::OpTypeArray:
+        {
+            /* Each array element occupies its own locations */
+            const std::uint32_t elementSize = types_[varType.elementType].numComponents;
+            for_range(i, varType.length)
+                AddLocationSlots(slots, variable, varType.elementType, offset + i*elementSize, location, component, flat);
+        }
+        break;
+
+        case spv::OpTypeMatrix:
+        {
+            /* Each matrix column occupies one location */
+            const std::uint32_t columnSize = types_[varType.elementType].numComponents;
+            for_range(i, varType.length)
+                AddLocationSlots(slots, variable, varType.elementType, offset + i*columnSize, location, 0, flat);
+        }
+        break;
+
+        case spv::OpTypeStruct:
+        {
+            for (std::uint32_t member : varType.members)
+            {
+                AddLocationSlots(slots, variable, member, offset, location, 0, flat);
+                offset += types_[member].numComponents;
+            }
+        }
+        break;
+
+        default:
+        {
+            InterfaceSlot slot;
+            {
+                slot.variable       = variable;
+                slot.offset         = offset;
+                slot.numComponents  = varType.numComponents;
+                slot.location       = location++;
+                slot.component      = component;
+                slot.kind           = varType.kind;
+                slot.flat           = (flat || varType.kind != SpirvScalarKind::Float);
+            }
+            slots.push_back(slot);
+        }
+        break;
+    }
+}
+
+bool SpirvProgram::AddResource(std::uint32_t variable, std::uint32_t type, const Decorations& decorations, spv::StorageClass storage)
+{
+    const Type* resourceType = &types_[type];
+
+    Resource resource;
+    {
+        resource.set        = decorations.set;
+        resource.binding    = decorations.binding;
+        resource.variable   = variable;
+    }
+
+    if (resourceType->opcode == spv::OpTypeArray || resourceType->opcode == spv::OpTypeRuntimeArray)
+    {
+        if (storage != spv::StorageClassUniformConstant)
+            return Error("arrays of buffer blocks are not supported");
+        if (resourceType->opcode == spv::OpTypeRuntimeArray)
+            return Error("runtime arrays of images and samplers are not supported");
+
+        resource.arraySize  = resourceType->length;
+        resourceType        = &types_[resourceType->elementType];
+    }
+
+    switch (storage)
+    {
+        case spv::StorageClassPushConstant:
+            resource.type = SpirvResourceType::PushConstants;
+            break;
+
+        case spv::StorageClassUniform:
+        case spv::StorageClassStorageBuffer:
+        {
+            auto it = decorations_.find(resourceType->id);
+            const bool isBufferBlock = (it != decorations_.end() && it->second.bufferBlock);
+            resource.type = (storage == spv::StorageClassStorageBuffer || isBufferBlock ? SpirvResourceType::StorageBuffer : SpirvResourceType::UniformBuffer);
+
+            /* Storage buffer is read-only if the variable or all of its members are non-writable */
+            resource.readonly = decorations.nonWritable;
+            if (!resource.readonly && resource.type == SpirvResourceType::StorageBuffer && !resourceType->members.empty())
+            {
+                resource.readonly = true;
+                for_range(i, resourceType->members.size())
+                {
+                    auto member = memberDecorations_.find(GetMemberKey(resourceType->id, i));
+                    if (member == memberDecorations_.end() || !member->second.nonWritable)
+                        resource.readonly = false;
+                }
+            }
+        }
+        break;
+
+        case spv::StorageClassUniformConstant:
+        {
+            switch (resourceType->opcode)
+            {
+                case spv::OpTypeImage:
+                    resource.type = (resourceType->sampled == 2 ? SpirvResourceType::StorageImage : SpirvResourceType::SampledImage);
+                    break;
+                case spv::OpTypeSampler:
+                    resource.type = SpirvResourceType::Sampler;
+                    break;
+                case spv::OpTypeSampledImage:
+                    resource.type = SpirvResourceType::CombinedImageSampler;
+                    break;
+                default:
+                    return Error("unsupported type of SPIR-V uniform constant");
+            }
+
+            resource.dim        = resourceType->dim;
+            resource.kind       = resourceType->kind;
+            resource.readonly   = (resource.type != SpirvResourceType::StorageImage || decorations.nonWritable);
+
+            /* Allocate one handle per array element; combined image samplers store their handle twice (image and sampler) */
+            resource.firstHandle = numHandles_;
+            for_range(i, resource.arraySize)
+            {
+                for_range(c, resourceType->numComponents)
+                    handleWords_.push_back(numHandles_);
+                ++numHandles_;
+            }
+        }
+        break;
+
+        default:
+            break;
+    }
+
+    variables_[variable].resource = static_cast<std::uint32_t>(resources_.size());
+    resources_.push_back(resource);
+
+    return true;
+}
+
+std::uint32_t SpirvProgram::GetLayout(std::uint32_t typeIndex, bool isExplicit, std::uint32_t matrixStride, bool rowMajor)
+{
+    const Type& type = types_[typeIndex];
+
+    /* Normalize layout key: Only explicit vectors, matrices, and arrays depend on matrix stride and majorness */
+    if (!isExplicit || (type.opcode != spv::OpTypeVector && type.opcode != spv::OpTypeMatrix && type.opcode != spv::OpTypeArray && type.opcode != spv::OpTypeRuntimeArray))
+    {
+        matrixStride    = 0;
+        rowMajor        = false;
+    }
+    if (type.opcode == spv::OpTypeVector && !rowMajor)
+        matrixStride = 0;
+    if (type.opcode != spv::OpTypeArray && type.opcode != spv::OpTypeRuntimeArray && type.opcode != spv::OpTypeStruct &&
+        type.opcode != spv::OpTypeMatrix && type.opcode != spv::OpTypeVector)
+    {
+        isExplicit = false;
+    }
+
+    const LayoutKey key{ typeIndex, matrixStride, isExplicit, rowMajor };
+    auto it = layoutCache_.find(key);
+    if (it != layoutCache_.end())
+        return it->second;
+
+    Layout layout;
+    layout.type = typeIndex;
+
+    switch (type.opcode)
+    {
+        case spv::OpTypeVector:
+        {
+            /* Vectors within row-major matrices are strided by the matrix stride */
+            layout.stride = (rowMajor && matrixStride > 0 ? matrixStride : 1);
+            for_range(i, type.length)
+                layout.offsets.push_back(i * layout.stride);
+            layout.span = (type.length - 1) * layout.stride + 1;
+        }
+        break;
+
+        case spv::OpTypeMatrix:
+        {
+            const std::uint32_t rows = types_[type.elementType].length;
+            const std::uint32_t cols = type.length;
+
+            std::uint32_t child = 0;
+            if (isExplicit)
+            {
+                if (matrixStride == 0)
+                    matrixStride = (rowMajor ? cols : rows);
+                layout.stride   = (rowMajor ? 1 : matrixStride);
+                layout.span     = (rowMajor ? rows : cols) * matrixStride;
+                child           = GetLayout(type.elementType, true, matrixStride, rowMajor);
+            }
+            else
+            {
+                layout.stride   = rows;
+                layout.span     = cols * rows;
+                child           = GetLayout(type.elementType, false);
+            }
+
+            layout.children = { child };
+            for_range(c, cols)
+            {
+                for (std::uint32_t offset : layouts_[child].offsets)
+                    layout.offsets.push_back(c * layout.stride + offset);
+            }
+        }
+        break;
+
+        case spv::OpTypeArray:
+        case spv::OpTypeRuntimeArray:
+        {
+            const std::uint32_t child = GetLayout(type.elementType, isExplicit, matrixStride, rowMajor);
+            layout.stride = layouts_[child].span;
+
+            if (isExplicit)
+            {
+                auto decoration = decorations_.find(type.id);
+                if (decoration != decorations_.end() && decoration->second.arrayStride > 0)
+                    layout.stride = decoration->second.arrayStride / 4;
+            }
+
+            layout.children = { child };
+            if (type.opcode == spv::OpTypeArray)
+            {
+                layout.span = type.length * layout.stride;
+                for_range(i, type.length)
+                {
+                    for (std::uint32_t offset : layouts_[child].offsets)
+                        layout.offsets.push_back(i * layout.stride + offset);
+                }
+            }
+        }
+        break;
+
+        case spv::OpTypeStruct:
+        {
+            std::uint32_t offset = 0;
+            for_range(i, type.members.size())
+            {
+                Decorations memberDecorations;
+                {
+                    auto decoration = memberDecorations_.find(GetMemberKey(type.id, i));
+                    if (decoration != memberDecorations_.end())
+                        memberDecorations = decoration->second;
+                }
+
+                const std::uint32_t child = GetLayout(type.members[i], isExplicit, memberDecorations.matrixStride / 4, memberDecorations.rowMajor);
+                if (isExplicit)
+                    offset = memberDecorations.offset / 4;
+
+                layout.children.push_back(child);
+                layout.memberOffsets.push_back(offset);
+                for (std::uint32_t childOffset : layouts_[child].offsets)
+                    layout.offsets.push_back(offset + childOffset);
+
+                layout.span = std::max(layout.span, offset + layouts_[child].span);
+                offset += layouts_[child].span;
+            }
+        }
+        break;
+
+        default:
+        {
+            layout.stride   = 1;
+            layout.span     = type.numComponents;
+            for_range(i, type.numComponents)
+                layout.offsets.push_back(i);
+        }
+        break;
+    }
+
+    for_range(i, layout.offsets.size())
+    {
+        if (layout.offsets[i] != i)
+        {
+            layout.packed = false;
+            break;
+        }
+    }
+
+    const std::uint32_t index = static_cast<std::uint32_t>(layouts_.size());
+    layouts_.push_back(std::move(layout));
+    layoutCache_[key] = index;
+
+    return index;
+}
+
+std::uint32_t SpirvProgram::AllocVariable(SpirvStorage storage, std::uint32_t layout)
+{
+    Variable variable;
+    {
+        variable.storage    = storage;
+        variable.layout     = layout;
+        variable.size       = layouts_[layout].span;
+    }
+
+    switch (storage)
+    {
+        case SpirvStorage::Lane:
+            variable.offset = laneStorageSize_;
+            laneStorageSize_ += variable.size;
+            break;
+        case SpirvStorage::Workgroup:
+            variable.offset = workgroupStorageSize_;
+            workgroupStorageSize_ += variable.size;
+            break;
+        case SpirvStorage::Handle:
+            variable.offset = static_cast<std::uint32_t>(handleWords_.size());
+            break;
+        default:
+            break;
+    }
+
+    const std::uint32_t index = static_cast<std::uint32_t>(variables_.size());
+    variables_.push_back(variable);
+    return index;
+}
+
+std::uint32_t SpirvProgram::AllocRegister(std::uint32_t numComponents)
+{
+    if (numComponents == 0)
+        return g_spirvInvalidIndex;
+
+    const std::uint32_t reg = static_cast<std::uint32_t>(registers_.size());
+    registers_.resize(registers_.size() + numComponents * g_spirvNumLanes);
+    return reg;
+}
+
+std::uint32_t SpirvProgram::AllocPointer(std::uint32_t variable)
+{
+    /* Pointer to variable with zero offset in all lanes */
+    const std::uint32_t reg = AllocRegister(2);
+    for_range(lane, g_spirvNumLanes)
+        registers_[reg + lane].u = variable;
+    return reg;
+}
+
+std::uint32_t SpirvProgram::GetFunctionIndex(spv::Id id)
+{
+    FunctionDecl& decl = functionDecls_[ids_[id].function];
+    if (decl.index == g_spirvInvalidIndex)
+    {
+        decl.index = static_cast<std::uint32_t>(functions_.size());
+        functions_.push_back(Function{});
+        pendingFunctions_.push_back(ids_[id].function);
+    }
+    return decl.index;
+}
+
+void SpirvProgram::EmitInstr(SpirvExecOp op, std::uint32_t count, std::uint32_t result, std::uint32_t arg0, std::uint32_t arg1, std::uint32_t arg2, std::uint32_t arg3)
+{
+    Instr instr;
+    {
+        instr.op        = op;
+        instr.count     = static_cast<std::uint16_t>(count);
+        instr.result    = result;
+        instr.args[0]   = arg0;
+        instr.args[1]   = arg1;
+        instr.args[2]   = arg2;
+        instr.args[3]   = arg3;
+    }
+    instrs_.push_back(instr);
+}
+
+void SpirvProgram::EmitCopy(std::uint32_t count, std::uint32_t dst, std::uint32_t src)
+{
+    if (count > 0 && dst != src)
+        EmitInstr(SpirvExecOp::Copy, count, dst, src);
+}
+
+const SpirvProgram::Type* SpirvProgram::FindType(spv::Id id) const
+{
+    if (id < ids_.size() && ids_[id].typeIndex != g_spirvInvalidIndex)
+        return &types_[ids_[id].typeIndex];
+    return nullptr;
+}
+
+const SpirvProgram::Type* SpirvProgram::FindResultType(spv::Id id) const
+{
+    if (id < ids_.size() && ids_[id].type != g_spirvInvalidIndex)
+        return &types_[ids_[id].type];
+    return nullptr;
+}
+
+std::uint32_t SpirvProgram::GetRegister(spv::Id id)
+{
+    if (id >= ids_.size() || ids_[id].reg == g_spirvInvalidIndex)
+    {
+        Error("invalid operand in SPIR-V module: ID %u has no value", id);
+        return 0;
+    }
+    return ids_[id].reg;
+}
+
+std::uint32_t SpirvProgram::GetBlock(spv::Id id)
+{
+    if (id >= ids_.size() || ids_[id].block == g_spirvInvalidIndex)
+    {
+        Error("invalid branch target in SPIR-V module: ID %u", id);
+        return 0;
+    }
+    return ids_[id].block;
+}
+
+std::uint32_t SpirvProgram::GetPointerLayout(spv::Id id)
+{
+    if (id >= ids_.size() || ids_[id].layout == g_spirvInvalidIndex)
+    {
+        Error("invalid pointer operand in SPIR-V module: ID %u", id);
+        return g_spirvInvalidIndex;
+    }
+    return ids_[id].layout;
+}
+
+std::uint32_t SpirvProgram::GetNumComponents(spv::Id id) const
+{
+    const Type* type = FindResultType(id);
+    return (type != nullptr ? type->numComponents : 0);
+}
+
+bool SpirvProgram::GetConstantUInt(spv::Id id, std::uint32_t& outValue) const
+{
+    if (id < ids_.size())
+    {
+        const Id& constant = ids_[id];
+        switch (constant.opcode)
+        {
+            case spv::OpConstant:
+            case spv::OpSpecConstant:
+            case spv::OpConstantNull:
+                outValue = registers_[constant.reg].u;
+                return true;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+bool SpirvProgram::IsExplicitLayoutStorage(spv::StorageClass storage) const
+{
+    return (storage == spv::StorageClassUniform || storage == spv::StorageClassStorageBuffer || storage == spv::StorageClassPushConstant);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
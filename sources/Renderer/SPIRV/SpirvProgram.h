@@ -0,0 +1,730 @@
+/*
+ * SpirvProgram.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_SPIRV_PROGRAM_H
+#define LLGL_SPIRV_PROGRAM_H
+
+
+#include "SpirvModule.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Number of shader invocations (lanes) the SPIR-V interpreter executes together as one batch.
+static constexpr std::uint32_t g_spirvNumLanes = 4;
+
+// Mask with all lanes of a batch enabled.
+static constexpr std::uint32_t g_spirvAllLanes = ((1u << g_spirvNumLanes) - 1u);
+
+// Invalid index for registers, blocks, variables, and layouts.
+static constexpr std::uint32_t g_spirvInvalidIndex = 0xFFFFFFFFu;
+
+// 32-bit value of the SPIR-V interpreter. Booleans are stored as 0 or 1.
+union SpirvValue
+{
+    std::uint32_t   u;
+    std::int32_t    s;
+    float           f;
+};
+
+// Scalar kind of shader interface variables and image texels.
+enum class SpirvScalarKind : std::uint8_t
+{
+    Float,
+    SInt,
+    UInt,
+    Bool,
+};
+
+// Memory a variable is stored in.
+enum class SpirvStorage : std::uint8_t
+{
+    Lane,       // One copy per invocation, i.e. Function, Private, Input, and Output variables.
+    Workgroup,  // One copy per workgroup, i.e. Workgroup variables.
+    Buffer,     // Memory of a bound buffer, i.e. Uniform, StorageBuffer, and PushConstant variables.
+    Handle,     // Image and sampler handles, i.e. UniformConstant variables.
+};
+
+// Resource types of the descriptors a SPIR-V program accesses.
+enum class SpirvResourceType : std::uint8_t
+{
+    UniformBuffer,
+    StorageBuffer,
+    PushConstants,
+    SampledImage,           // Texture without sampler, or uniform texel buffer (see SpirvResource::dim).
+    StorageImage,           // Read-write texture, or storage texel buffer (see SpirvResource::dim).
+    Sampler,
+    CombinedImageSampler,
+};
+
+// Internal opcodes of compiled SPIR-V instructions. Unless noted otherwise, 'count' specifies the number of components.
+enum class SpirvExecOp : std::uint16_t
+{
+    /* ----- Composites ----- */
+    Copy,                   // result = args[0]
+    VectorExtractDynamic,   // result = args[0][args[1]], count = vector size
+    VectorInsertDynamic,    // result[args[1]] = args[2], count = vector size (result must be initialized with a Copy first)
+    Select,                 // result = (args[0] ? args[1] : args[2]), args[3] = condition is a vector
+
+    /* ----- Float arithmetic ----- */
+    FNegate,
+    FAdd,
+    FSub,
+    FMul,
+    FDiv,
+    FRem,
+    FMod,
+    FAbs,
+    FSign,
+    FMin,
+    FMax,
+    FClamp,
+    FMix,
+    Step,
+    SmoothStep,
+    Fma,
+    Floor,
+    Ceil,
+    Round,
+    RoundEven,
+    Trunc,
+    Fract,
+    Radians,
+    Degrees,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Asinh,
+    Acosh,
+    Atanh,
+    Atan2,
+    Pow,
+    Exp,
+    Log,
+    Exp2,
+    Log2,
+    Sqrt,
+    InverseSqrt,
+    Ldexp,
+    Modf,                   // result = fract(args[0]), args[1] = register for whole part
+    Frexp,                  // result = significand(args[0]), args[1] = register for exponent
+    QuantizeToF16,
+
+    /* ----- Integer arithmetic ----- */
+    SNegate,
+    IAdd,
+    ISub,
+    IMul,
+    UDiv,
+    SDiv,
+    UMod,
+    SRem,
+    SMod,
+    SAbs,
+    SSign,
+    UMin,
+    SMin,
+    UMax,
+    SMax,
+    UClamp,
+    SClamp,
+    ShiftRightLogical,
+    ShiftRightArithmetic,
+    ShiftLeftLogical,
+    BitwiseOr,
+    BitwiseXor,
+    BitwiseAnd,
+    Not,
+    BitFieldInsert,         // result = insert(args[0], args[1], offset = args[2], count = args[3])
+    BitFieldSExtract,
+    BitFieldUExtract,
+    BitReverse,
+    BitCount,
+    FindILsb,
+    FindSMsb,
+    FindUMsb,
+    IAddCarry,              // result = { args[0] + args[1], carry }, count = number of components per member
+    ISubBorrow,             // result = { args[0] - args[1], borrow }, count = number of components per member
+    UMulExtended,           // result = { low bits, high bits }, count = number of components per member
+    SMulExtended,           // result = { low bits, high bits }, count = number of components per member
+
+    /* ----- Relational and logical ----- */
+    IEqual,
+    INotEqual,
+    UGreaterThan,
+    SGreaterThan,
+    UGreaterThanEqual,
+    SGreaterThanEqual,
+    ULessThan,
+    SLessThan,
+    ULessThanEqual,
+    SLessThanEqual,
+    FOrdEqual,
+    FUnordEqual,
+    FOrdNotEqual,
+    FUnordNotEqual,
+    FOrdLessThan,
+    FUnordLessThan,
+    FOrdGreaterThan,
+    FUnordGreaterThan,
+    FOrdLessThanEqual,
+    FUnordLessThanEqual,
+    FOrdGreaterThanEqual,
+    FUnordGreaterThanEqual,
+    LogicalNot,
+    IsNan,
+    IsInf,
+    Any,                    // result = any(args[0]), count = vector size
+    All,                    // result = all(args[0]), count = vector size
+
+    /* ----- Conversion ----- */
+    ConvertFToU,
+    ConvertFToS,
+    ConvertSToF,
+    ConvertUToF,
+
+    /* ----- Vector and matrix ----- */
+    VectorTimesScalar,      // result = args[0] * args[1] (scalar)
+    MatrixTimesVector,      // count = rows, args[2] = columns
+    VectorTimesMatrix,      // count = columns, args[2] = rows
+    MatrixTimesMatrix,      // count = columns * rows, args[2] = rows, args[3] = inner dimension
+    OuterProduct,           // count = columns * rows, args[2] = rows
+    Transpose,              // count = columns * rows, args[2] = rows of the input matrix
+    Determinant,            // args[2] = matrix dimension
+    MatrixInverse,          // count = dimension^2, args[2] = matrix dimension
+    Dot,                    // count = vector size
+    Length,                 // count = vector size
+    Distance,               // count = vector size
+    Normalize,
+    Cross,
+    FaceForward,
+    Reflect,
+    Refract,                // args[2] = eta (scalar)
+
+    /* ----- Packing ----- */
+    PackSnorm4x8,
+    PackUnorm4x8,
+    PackSnorm2x16,
+    PackUnorm2x16,
+    PackHalf2x16,
+    UnpackSnorm4x8,
+    UnpackUnorm4x8,
+    UnpackSnorm2x16,
+    UnpackUnorm2x16,
+    UnpackHalf2x16,
+
+    /* ----- Derivatives ----- */
+    DPdxFine,
+    DPdyFine,
+    FwidthFine,
+    DPdxCoarse,
+    DPdyCoarse,
+    FwidthCoarse,
+
+    /* ----- Memory ----- */
+    Load,                   // result = *args[0], args[1] = layout
+    Store,                  // *args[0] = args[1], args[2] = layout
+    AccessChain,            // result = args[0] + args[1] (constant offset) + dynamic offsets, args[2] = first operand, count = number of dynamic indices
+    ArrayLength,            // result = (size of args[0] - args[1]) / args[2]
+    AtomicLoad,             // Same as Load, but with atomic access to buffer memory
+    AtomicStore,            // Same as Store, but with atomic access to buffer memory
+    AtomicExchange,         // result = atomic(args[0], args[1], args[2]), args[3] = SpirvAtomicOp
+    Image,                  // args[0] = index into image instructions
+
+    /* ----- Control flow ----- */
+    Phi,                    // result = incoming value for previous block of each lane, args[0] = first operand, args[1] = number of incoming values
+    Branch,                 // args[0] = block
+    BranchConditional,      // args[0] = condition, args[1] = true block, args[2] = false block
+    Switch,                 // args[0] = selector, args[1] = default block, args[2] = first operand, count = number of cases
+    Call,                   // result = args[0](...), args[1] = first operand, count = number of arguments
+    Return,
+    ReturnValue,            // args[0] = return value
+    Kill,
+    Unreachable,
+    Barrier,                // Workgroup execution barrier
+};
+
+// Atomic operations for SpirvExecOp::AtomicExchange.
+enum class SpirvAtomicOp : std::uint32_t
+{
+    Exchange,
+    CompareExchange,
+    IIncrement,
+    IDecrement,
+    IAdd,
+    ISub,
+    SMin,
+    UMin,
+    SMax,
+    UMax,
+    And,
+    Or,
+    Xor,
+};
+
+// Image instructions for SpirvExecOp::Image.
+enum class SpirvImageOp : std::uint8_t
+{
+    Sample,
+    Fetch,
+    Read,
+    Write,
+    QuerySize,
+    QueryLevels,
+    QuerySamples,
+};
+
+// Flags for image instructions.
+struct SpirvImageFlags
+{
+    enum
+    {
+        ImplicitLod     = (1 << 0), // Level of detail is derived from the coordinate derivatives.
+        Lod             = (1 << 1), // Explicit level of detail.
+        Bias            = (1 << 2), // Level of detail bias.
+        Grad            = (1 << 3), // Explicit gradients.
+        Offset          = (1 << 4), // Texel offset.
+        MinLod          = (1 << 5), // Minimum level of detail.
+        Dref            = (1 << 6), // Depth comparison.
+        Proj            = (1 << 7), // Projective coordinates.
+        Sample          = (1 << 8), // Sample index of multi-sampled images.
+    };
+};
+
+/*
+Compiled entry point of a SPIR-V module for the SPIR-V interpreter.
+All result IDs are mapped to registers that store all components of a value as [component][lane].
+Only 32-bit scalar types are supported. The program is immutable after compilation and can be shared by multiple interpreters.
+*/
+class SpirvProgram
+{
+
+    public:
+
+        // Type information of a compiled program.
+        struct Type
+        {
+            spv::Op                     opcode          = spv::OpTypeVoid;
+            spv::Id                     id              = 0;
+            std::uint32_t               numComponents   = 0;                    // Number of 32-bit components of a value of this type.
+            std::uint32_t               elementType     = 0;                    // Element type of vectors, matrices, arrays, and pointers, or sampled type of images.
+            std::uint32_t               length          = 0;                    // Number of elements of vectors, matrices, and arrays.
+            std::vector<std::uint32_t>  members;                                // Member types of structures.
+            SpirvScalarKind             kind            = SpirvScalarKind::UInt;
+            spv::StorageClass           storage         = spv::StorageClassMax; // Storage class of pointers.
+            spv::Dim                    dim             = spv::DimMax;          // Dimension of images.
+            bool                        arrayed         = false;
+            bool                        multisampled    = false;
+            std::uint32_t               sampled         = 0;                    // 1 for sampled images, 2 for storage images.
+            spv::ImageFormat            imageFormat     = spv::ImageFormatMax;
+        };
+
+        /*
+        Memory layout of a type. All offsets are specified in 32-bit words.
+        Variables in lane and workgroup storage are tightly packed; buffers use the explicit layout decorations.
+        */
+        struct Layout
+        {
+            std::uint32_t               type        = 0;
+            std::uint32_t               span        = 0;    // Number of words this layout spans. Zero for runtime arrays.
+            std::uint32_t               stride      = 0;    // Stride between elements of vectors, matrices, and arrays.
+            std::vector<std::uint32_t>  children;           // Layouts of structure members or the element layout.
+            std::vector<std::uint32_t>  memberOffsets;      // Offsets of structure members.
+            std::vector<std::uint32_t>  offsets;            // Offsets of each component of a value.
+            bool                        packed      = true; // Components are stored contiguously, i.e. offsets[i] = i.
+        };
+
+        // Variable of a compiled program.
+        struct Variable
+        {
+            SpirvStorage    storage     = SpirvStorage::Lane;
+            std::uint32_t   size        = 0;                    // Size in words. For buffer storage, the size is determined by the bound buffer.
+            std::uint32_t   offset      = 0;                    // Offset within the memory of the interpreter for lane, workgroup, and handle storage.
+            std::uint32_t   layout      = 0;
+            std::uint32_t   resource    = g_spirvInvalidIndex;  // Index of the resource the variable is bound to.
+        };
+
+        // Descriptor a SPIR-V program accesses.
+        struct Resource
+        {
+            SpirvResourceType   type        = SpirvResourceType::UniformBuffer;
+            std::uint32_t       set         = 0;
+            std::uint32_t       binding     = 0;
+            std::uint32_t       arraySize   = 1;
+            std::uint32_t       variable    = 0;
+            std::uint32_t       firstHandle = 0;                        // First image handle for image and sampler resources.
+            spv::Dim            dim         = spv::DimMax;
+            SpirvScalarKind     kind        = SpirvScalarKind::Float;   // Sampled type of images.
+            bool                readonly    = false;
+        };
+
+        // Location or built-in of an input or output variable. Arrays, matrices, and structures occupy multiple slots.
+        struct InterfaceSlot
+        {
+            std::uint32_t   variable        = 0;
+            std::uint32_t   offset          = 0;                // Word offset within the variable.
+            std::uint32_t   numComponents   = 0;
+            std::uint32_t   location        = 0;
+            std::uint32_t   component       = 0;                // First component within the location.
+            std::uint32_t   index           = 0;                // Output index for dual-source blending.
+            spv::BuiltIn    builtin         = spv::BuiltInMax;  // Built-in or spv::BuiltInMax for user-defined locations.
+            SpirvScalarKind kind            = SpirvScalarKind::Float;
+            bool            flat            = false;
+        };
+
+        // Compiled instruction.
+        struct Instr
+        {
+            SpirvExecOp     op;
+            std::uint16_t   count;      // Number of components, or number of operands for variable-length instructions.
+            std::uint32_t   result;     // Register of the result.
+            std::uint32_t   args[4];    // Registers of operands or immediate values.
+        };
+
+        // Operands of compiled image instructions.
+        struct ImageInstr
+        {
+            SpirvImageOp    op          = SpirvImageOp::Sample;
+            std::uint32_t   flags       = 0;                    // Bitwise OR combination of SpirvImageFlags.
+            std::uint32_t   type        = 0;                    // Image type.
+            std::uint32_t   image       = 0;                    // Register of the image handle or sampled image handles.
+            std::uint32_t   coord       = g_spirvInvalidIndex;  // Register of coordinates or level of detail for size queries.
+            std::uint32_t   numCoords   = 0;
+            std::uint32_t   dref        = g_spirvInvalidIndex;
+            std::uint32_t   lod         = g_spirvInvalidIndex;  // Register of explicit level of detail or bias.
+            std::uint32_t   gradX       = g_spirvInvalidIndex;
+            std::uint32_t   gradY       = g_spirvInvalidIndex;
+            std::uint32_t   offset      = g_spirvInvalidIndex;
+            std::uint32_t   minLod      = g_spirvInvalidIndex;
+            std::uint32_t   sample      = g_spirvInvalidIndex;
+            std::uint32_t   texel       = g_spirvInvalidIndex;  // Register of the texel for image writes.
+            std::uint32_t   result      = g_spirvInvalidIndex;
+            std::uint32_t   numResults  = 0;                    // Number of result components or texel components for image writes.
+        };
+
+        // Basic block: Instructions of a block are executed together for all lanes that branch to it.
+        struct Block
+        {
+            std::uint32_t firstInstr = 0;
+        };
+
+        struct Function
+        {
+            std::uint32_t   firstBlock  = 0;
+            std::uint32_t   numBlocks   = 0;
+        };
+
+        // Execution modes of the entry point.
+        struct ExecutionModes
+        {
+            bool            originUpperLeft         = false;
+            bool            pixelCenterInteger      = false;
+            bool            earlyFragmentTests      = false;
+            bool            depthReplacing          = false;
+            std::uint32_t   localSize[3]            = { 1, 1, 1 };
+        };
+
+    public:
+
+        // Compiles the entry point with the specified execution model and name. Returns false on failure; see GetErrorMessage().
+        bool Compile(const SpirvModuleView& module, spv::ExecutionModel executionModel, const char* entryPoint = "main");
+
+        // Returns the error message of the last compilation.
+        inline const std::string& GetErrorMessage() const
+        {
+            return errorMessage_;
+        }
+
+        // Returns the execution model of the entry point.
+        inline spv::ExecutionModel GetExecutionModel() const
+        {
+            return executionModel_;
+        }
+
+        // Returns the execution modes of the entry point.
+        inline const ExecutionModes& GetExecutionModes() const
+        {
+            return executionModes_;
+        }
+
+        // Returns true if the program can discard fragments.
+        inline bool HasKill() const
+        {
+            return hasKill_;
+        }
+
+        // Returns true if the program contains workgroup execution barriers.
+        inline bool HasBarriers() const
+        {
+            return hasBarriers_;
+        }
+
+        // Returns the input slots of the entry point.
+        inline const std::vector<InterfaceSlot>& GetInputs() const
+        {
+            return inputs_;
+        }
+
+        // Returns the output slots of the entry point.
+        inline const std::vector<InterfaceSlot>& GetOutputs() const
+        {
+            return outputs_;
+        }
+
+        // Returns the descriptors the program accesses.
+        inline const std::vector<Resource>& GetResources() const
+        {
+            return resources_;
+        }
+
+    public:
+
+        // Returns the initial register values, i.e. constants and pointers to variables.
+        inline const std::vector<SpirvValue>& GetRegisters() const
+        {
+            return registers_;
+        }
+
+        inline const std::vector<Variable>& GetVariables() const
+        {
+            return variables_;
+        }
+
+        inline const std::vector<Layout>& GetLayouts() const
+        {
+            return layouts_;
+        }
+
+        inline const std::vector<Type>& GetTypes() const
+        {
+            return types_;
+        }
+
+        inline const std::vector<Instr>& GetInstrs() const
+        {
+            return instrs_;
+        }
+
+        inline const std::vector<ImageInstr>& GetImageInstrs() const
+        {
+            return imageInstrs_;
+        }
+
+        inline const std::vector<std::uint32_t>& GetOperands() const
+        {
+            return operands_;
+        }
+
+        inline const std::vector<Block>& GetBlocks() const
+        {
+            return blocks_;
+        }
+
+        inline const std::vector<Function>& GetFunctions() const
+        {
+            return functions_;
+        }
+
+        // Returns the function index of the entry point.
+        inline std::uint32_t GetEntryFunction() const
+        {
+            return entryFunction_;
+        }
+
+        // Returns the number of words each lane requires for its Function, Private, Input, and Output variables.
+        inline std::uint32_t GetLaneStorageSize() const
+        {
+            return laneStorageSize_;
+        }
+
+        // Returns the number of words a workgroup requires for its Workgroup variables.
+        inline std::uint32_t GetWorkgroupStorageSize() const
+        {
+            return workgroupStorageSize_;
+        }
+
+        // Returns the handle storage, i.e. the image binding index for each word of all UniformConstant variables.
+        inline const std::vector<std::uint32_t>& GetHandleWords() const
+        {
+            return handleWords_;
+        }
+
+        // Returns the number of image and sampler bindings.
+        inline std::uint32_t GetNumHandles() const
+        {
+            return numHandles_;
+        }
+
+    private:
+
+        // Decorations of an ID or a structure member.
+        struct Decorations
+        {
+            spv::BuiltIn    builtin         = spv::BuiltInMax;
+            std::uint32_t   location        = g_spirvInvalidIndex;
+            std::uint32_t   component       = 0;
+            std::uint32_t   index           = 0;
+            std::uint32_t   binding         = 0;
+            std::uint32_t   set             = 0;
+            std::uint32_t   offset          = 0;
+            std::uint32_t   arrayStride     = 0;
+            std::uint32_t   matrixStride    = 0;
+            bool            rowMajor        = false;
+            bool            flat            = false;
+            bool            block           = false;
+            bool            bufferBlock     = false;
+            bool            nonWritable     = false;
+        };
+
+        // Declaration of an ID within the module.
+        struct Id
+        {
+            spv::Op         opcode      = spv::OpNop;
+            std::uint32_t   type        = g_spirvInvalidIndex;  // Index into types_ of the result type.
+            std::uint32_t   reg         = g_spirvInvalidIndex;  // Register of the value.
+            std::uint32_t   typeIndex   = g_spirvInvalidIndex;  // Index into types_ if this ID declares a type.
+            std::uint32_t   layout      = g_spirvInvalidIndex;  // Layout the pointer refers to.
+            std::uint32_t   block       = g_spirvInvalidIndex;  // Block index of labels.
+            std::uint32_t   function    = g_spirvInvalidIndex;  // Index into functionDecls_ of functions.
+        };
+
+        struct FunctionDecl
+        {
+            const std::uint32_t*    begin   = nullptr;              // First instruction after OpFunction.
+            const std::uint32_t*    end     = nullptr;              // OpFunctionEnd instruction.
+            std::vector<spv::Id>    params;
+            std::uint32_t           index   = g_spirvInvalidIndex;  // Index into functions_ once the function is referenced.
+        };
+
+        struct LayoutKey
+        {
+            std::uint32_t   type;
+            std::uint32_t   matrixStride;
+            bool            isExplicit;
+            bool            rowMajor;
+
+            bool operator < (const LayoutKey& rhs) const;
+        };
+
+    private:
+
+        bool Error(const char* format, ...);
+
+        bool ParseDeclarations(const SpirvModuleView& module, const char* entryPoint);
+        void ParseDecoration(const SpirvInstruction& instr, Decorations& decorations, std::uint32_t firstOperand);
+        void ParseExecutionMode(const SpirvInstruction& instr);
+        bool ParseType(const SpirvInstruction& instr);
+        bool ParseConstant(const SpirvInstruction& instr);
+        bool ParseGlobalVariable(const SpirvInstruction& instr);
+        bool ParseFunctionResult(const SpirvInstruction& instr, FunctionDecl& decl);
+
+        bool CompileFunctions();
+        bool CompileFunction(std::uint32_t declIndex);
+        bool CompileInstr(const SpirvInstruction& instr);
+        bool CompileExtInstr(const SpirvInstruction& instr);
+        bool CompileImageInstr(const SpirvInstruction& instr);
+        bool CompileAccessChain(const SpirvInstruction& instr);
+        bool CompileCompositeExtract(const SpirvInstruction& instr, bool isInsert);
+        void FlushPhis();
+
+        void AddInterfaceSlots(std::vector<InterfaceSlot>& slots, std::uint32_t variable, std::uint32_t type, const Decorations& decorations);
+
+        void AddLocationSlots(
+            std::vector<InterfaceSlot>& slots,
+            std::uint32_t               variable,
+            std::uint32_t               type,
+            std::uint32_t               offset,
+            std::uint32_t&              location,
+            std::uint32_t               component,
+            bool                        flat
+        );
+
+        bool AddResource(std::uint32_t variable, std::uint32_t type, const Decorations& decorations, spv::StorageClass storage);
+
+        std::uint32_t GetLayout(std::uint32_t typeIndex, bool isExplicit, std::uint32_t matrixStride = 0, bool rowMajor = false);
+        std::uint32_t AllocVariable(SpirvStorage storage, std::uint32_t layout);
+        std::uint32_t AllocRegister(std::uint32_t numComponents);
+        std::uint32_t AllocPointer(std::uint32_t variable);
+        std::uint32_t GetFunctionIndex(spv::Id id);
+
+        void EmitInstr(SpirvExecOp op, std::uint32_t count, std::uint32_t result, std::uint32_t arg0 = 0, std::uint32_t arg1 = 0, std::uint32_t arg2 = 0, std::uint32_t arg3 = 0);
+        void EmitCopy(std::uint32_t count, std::uint32_t dst, std::uint32_t src);
+
+        const Type* FindType(spv::Id id) const;
+        const Type* FindResultType(spv::Id id) const;
+
+        std::uint32_t GetRegister(spv::Id id);
+        std::uint32_t GetBlock(spv::Id id);
+        std::uint32_t GetPointerLayout(spv::Id id);
+        std::uint32_t GetNumComponents(spv::Id id) const;
+        bool GetConstantUInt(spv::Id id, std::uint32_t& outValue) const;
+        bool IsExplicitLayoutStorage(spv::StorageClass storage) const;
+
+    private:
+
+        std::string                                     errorMessage_;
+        spv::ExecutionModel                             executionModel_         = spv::ExecutionModelMax;
+        ExecutionModes                                  executionModes_;
+        bool                                            hasKill_                = false;
+        bool                                            hasBarriers_            = false;
+
+        std::vector<InterfaceSlot>                      inputs_;
+        std::vector<InterfaceSlot>                      outputs_;
+        std::vector<Resource>                           resources_;
+
+        std::vector<SpirvValue>                         registers_;
+        std::vector<Variable>                           variables_;
+        std::vector<Layout>                             layouts_;
+        std::vector<Type>                               types_;
+        std::vector<Instr>                              instrs_;
+        std::vector<ImageInstr>                         imageInstrs_;
+        std::vector<std::uint32_t>                      operands_;
+        std::vector<Block>                              blocks_;
+        std::vector<Function>                           functions_;
+        std::uint32_t                                   entryFunction_          = 0;
+        std::uint32_t                                   laneStorageSize_        = 0;
+        std::uint32_t                                   workgroupStorageSize_   = 0;
+        std::vector<std::uint32_t>                      handleWords_;
+        std::uint32_t                                   numHandles_             = 0;
+
+        /* Compilation state */
+        std::vector<Id>                                 ids_;
+        std::map<spv::Id, Decorations>                  decorations_;
+        std::map<std::uint64_t, Decorations>            memberDecorations_;     // Key: (structure ID << 32 | member index)
+        std::map<LayoutKey, std::uint32_t>              layoutCache_;
+        std::vector<FunctionDecl>                       functionDecls_;
+        std::vector<std::uint32_t>                      pendingFunctions_;      // Indices into functionDecls_ that must be compiled.
+        std::vector<spv::Id>                            interfaceIds_;
+        std::vector<std::pair<spv::Id, spv::Id>>        initializers_;          // Global variables and their initializers.
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> pendingPhis_;      // Phi instructions and their result registers.
+        spv::Id                                         entryPointId_           = 0;
+        spv::Id                                         glslStd450_             = 0;
+        std::vector<spv::Id>                            ignoredExtInstSets_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
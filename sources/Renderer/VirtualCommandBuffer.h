@@ -11,6 +11,7 @@
 
 #include "../Core/Assertion.h"
 #include "../Core/CoreUtils.h"
+#include "VirtualCommandChunkPool.h"
 #include <cstddef>
 #include <algorithm>
 #include <iterator>
@@ -42,14 +43,8 @@ class VirtualCommandBuffer
 
     private:
 
-        // POD structure for the memory chunks. These chunks contain a payload at the end of the struct.
-        struct Chunk
-        {
-            std::size_t capacity;
-            std::size_t size;
-            Chunk*      next;
-            // <payload>
-        };
+        // Memory chunks are shared with all virtual command buffers through the chunk pool.
+        using Chunk = VirtualCommandChunk;
 
     public:
 
@@ -135,17 +130,13 @@ class VirtualCommandBuffer
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer(VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
         }
 
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer& operator = (VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
             return *this;
         }
 
@@ -191,7 +182,7 @@ class VirtualCommandBuffer
             }
         }
 
-        // Deletes all memory chunks.
+        // Returns all memory chunks to the chunk pool.
         void Release()
         {
             for (Chunk* c = first_, *next = nullptr; c != nullptr; c = next)
@@ -219,6 +210,18 @@ class VirtualCommandBuffer
             return reinterpret_cast<TCommand*>(AllocAlignedDataWithOpcode(opcode, sizeof(TCommand) + payloadSize, alignof(TCommand)));
         }
 
+        // Allocates a new command with the specified opcode and an untyped payload (in bytes), e.g. to copy commands from another virtual command buffer.
+        char* AllocCommandData(const TOpcode opcode, std::size_t payloadSize, std::size_t alignment)
+        {
+            return AllocAlignedDataWithOpcode(opcode, payloadSize, alignment);
+        }
+
+        // Returns the capacity (in bytes) that is required in the worst case to allocate a command with the specified payload size and alignment.
+        static std::size_t GetCommandCapacity(std::size_t payloadSize, std::size_t alignment)
+        {
+            return (sizeof(AlignOffsetType) + sizeof(TOpcode) + payloadSize + (alignment > 1 ? alignment - 1 : 0));
+        }
+
         // Runs the input function over every command in this virtual command buffer.
         // The function callback must return the size (in bytes) of the command being processed.
         template <typename Functor, typename... TArgs>
@@ -247,26 +250,32 @@ class VirtualCommandBuffer
 
     private:
 
-        // Allocates a new memory chunk of the specified capacity plus sizeof(Chunk).
+        // Swaps all memory chunks and the capacity policy with the specified virtual command buffer.
+        void Swap(VirtualCommandBuffer& rhs)
+        {
+            std::swap(first_, rhs.first_);
+            std::swap(current_, rhs.current_);
+            std::swap(biggest_, rhs.biggest_);
+            std::swap(capacity_, rhs.capacity_);
+            std::swap(size_, rhs.size_);
+            std::swap(initialCapacity_, rhs.initialCapacity_);
+        }
+
+        // Allocates a memory chunk with at least the specified capacity from the chunk pool.
         static Chunk* AllocChunk(std::size_t capacity, Chunk* next = nullptr)
         {
-            Chunk* chunk = reinterpret_cast<Chunk*>(::new char[sizeof(Chunk) + capacity]);
+            Chunk* chunk = AllocVirtualCommandChunk(capacity);
             {
-                chunk->capacity = capacity;
-                chunk->size     = 0;
-                chunk->next     = next;
+                chunk->size = 0;
+                chunk->next = next;
             }
             return chunk;
         }
 
-        // Deletes the specified memory chunk.
+        // Returns the specified memory chunk to the chunk pool.
         static void FreeChunk(Chunk* chunk)
         {
-            if (chunk != nullptr)
-            {
-                char* buf = reinterpret_cast<char*>(chunk);
-                delete [] buf;
-            }
+            FreeVirtualCommandChunk(chunk);
         }
 
         // Returns a raw pointer to the beginning of the chunk data.
@@ -320,8 +329,8 @@ class VirtualCommandBuffer
         {
             current_->next = VirtualCommandBuffer::AllocChunk(capacity, next);
             current_ = current_->next;
-            capacity_ += capacity;
-            if (biggest_ == nullptr || capacity > biggest_->capacity)
+            capacity_ += current_->capacity;
+            if (biggest_ == nullptr || current_->capacity > biggest_->capacity)
                 biggest_ = current_;
         }
 
@@ -345,6 +354,7 @@ class VirtualCommandBuffer
                         Chunk* secondNext = current_->next->next;
                         if (biggest_ == current_->next)
                             biggest_ = secondNext;
+                        capacity_ -= current_->next->capacity;
                         VirtualCommandBuffer::FreeChunk(current_->next);
                         AllocNextChunkAndMakeCurrent(capacity, secondNext);
                     }
@@ -361,7 +371,7 @@ class VirtualCommandBuffer
                 first_      = VirtualCommandBuffer::AllocChunk(capacity);
                 current_    = first_;
                 biggest_    = first_;
-                capacity_   = capacity;
+                capacity_   = first_->capacity;
             }
         }
 
@@ -0,0 +1,279 @@
+/*
+ * VirtualCommandChunkPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "VirtualCommandChunkPool.h"
+#include <LLGL/Utils/ForRange.h>
+#include <atomic>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+/*
+Chunk capacities of the size classes alternately grow by a factor of 1.5 and 4/3, i.e. 8K, 12K, 16K, 24K, ..., 1M,
+which matches the default grow policy of virtual command buffers. Bigger chunks bypass the pool.
+*/
+static constexpr std::size_t g_numChunkSizeClasses      = 15;
+static constexpr std::size_t g_minChunkClassCapacity    = 8192u;
+
+// Caches that exceed their high-water mark (in bytes) are trimmed down to half of it.
+static constexpr std::size_t g_threadCacheHighWaterMark = 2u * 1024u * 1024u;
+static constexpr std::size_t g_globalPoolHighWaterMark  = 32u * 1024u * 1024u;
+
+static std::size_t GetChunkClassCapacity(std::size_t sizeClass)
+{
+    return (((sizeClass & 1) != 0 ? 3u : 2u) * (g_minChunkClassCapacity / 2)) << (sizeClass / 2);
+}
+
+// Returns the smallest size class that fits the specified capacity or g_numChunkSizeClasses if the capacity exceeds all size classes.
+static std::size_t FindChunkSizeClass(std::size_t capacity)
+{
+    std::size_t sizeClass = 0;
+    while (sizeClass < g_numChunkSizeClasses && GetChunkClassCapacity(sizeClass) < capacity)
+        ++sizeClass;
+    return sizeClass;
+}
+
+static VirtualCommandChunk* NewChunk(std::size_t capacity)
+{
+    VirtualCommandChunk* chunk = reinterpret_cast<VirtualCommandChunk*>(::new char[sizeof(VirtualCommandChunk) + capacity]);
+    chunk->capacity = capacity;
+    return chunk;
+}
+
+static void DeleteChunk(VirtualCommandChunk* chunk)
+{
+    char* buf = reinterpret_cast<char*>(chunk);
+    delete [] buf;
+}
+
+
+/*
+ * VirtualCommandChunkCache class
+ */
+
+// Free lists of memory chunks for each size class. Cached chunks are deleted when the cache is destroyed.
+class VirtualCommandChunkCache
+{
+
+    public:
+
+        VirtualCommandChunkCache() = default;
+
+        VirtualCommandChunkCache(const VirtualCommandChunkCache&) = delete;
+        VirtualCommandChunkCache& operator = (const VirtualCommandChunkCache&) = delete;
+
+        ~VirtualCommandChunkCache()
+        {
+            for_range(sizeClass, g_numChunkSizeClasses)
+            {
+                while (VirtualCommandChunk* chunk = Pop(sizeClass))
+                    DeleteChunk(chunk);
+            }
+        }
+
+        VirtualCommandChunk* Pop(std::size_t sizeClass)
+        {
+            VirtualCommandChunk* chunk = freeLists_[sizeClass];
+            if (chunk != nullptr)
+            {
+                freeLists_[sizeClass] = chunk->next;
+                size_ -= chunk->capacity;
+            }
+            return chunk;
+        }
+
+        void Push(VirtualCommandChunk* chunk, std::size_t sizeClass)
+        {
+            chunk->next = freeLists_[sizeClass];
+            freeLists_[sizeClass] = chunk;
+            size_ += chunk->capacity;
+        }
+
+        // Moves chunks into the destination cache, starting with the biggest size class, until this cache does not exceed the specified size.
+        void TrimInto(VirtualCommandChunkCache& dst, std::size_t maxSize)
+        {
+            for (std::size_t sizeClass = g_numChunkSizeClasses; sizeClass-- > 0 && size_ > maxSize;)
+            {
+                while (size_ > maxSize)
+                {
+                    VirtualCommandChunk* chunk = Pop(sizeClass);
+                    if (chunk == nullptr)
+                        break;
+                    dst.Push(chunk, sizeClass);
+                }
+            }
+        }
+
+        // Returns the total capacity (in bytes) of all cached chunks.
+        std::size_t Size() const
+        {
+            return size_;
+        }
+
+    private:
+
+        VirtualCommandChunk*    freeLists_[g_numChunkSizeClasses]   = {};
+        std::size_t             size_                               = 0;
+
+};
+
+
+/*
+ * VirtualCommandChunkPool class
+ */
+
+// Set when the process-wide pool has been destroyed during static destruction; chunks are deleted directly after that.
+static std::atomic<bool> g_chunkPoolReleased{ false };
+
+// Process-wide pool to exchange chunks between the caches of all threads.
+class VirtualCommandChunkPool
+{
+
+    public:
+
+        ~VirtualCommandChunkPool()
+        {
+            g_chunkPoolReleased = true;
+        }
+
+        VirtualCommandChunk* Pop(std::size_t sizeClass)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            return cache_.Pop(sizeClass);
+        }
+
+        // Moves chunks from the specified thread cache into this pool until the thread cache does not exceed the specified size.
+        void Absorb(VirtualCommandChunkCache& threadCache, std::size_t maxThreadCacheSize)
+        {
+            VirtualCommandChunkCache overflow;
+            {
+                std::lock_guard<std::mutex> guard{ mutex_ };
+                threadCache.TrimInto(cache_, maxThreadCacheSize);
+                if (cache_.Size() > g_globalPoolHighWaterMark)
+                    cache_.TrimInto(overflow, g_globalPoolHighWaterMark / 2);
+            }
+            // Chunks that overflow the pool are deleted outside the lock
+        }
+
+    private:
+
+        std::mutex                  mutex_;
+        VirtualCommandChunkCache    cache_;
+
+};
+
+static VirtualCommandChunkPool& GetChunkPool()
+{
+    static VirtualCommandChunkPool chunkPool;
+    return chunkPool;
+}
+
+
+/*
+ * Thread cache
+ */
+
+// Cache of the calling thread, which returns its chunks to the process-wide pool when the thread terminates.
+struct ThreadChunkCache
+{
+    ~ThreadChunkCache();
+
+    VirtualCommandChunkCache cache;
+};
+
+static thread_local ThreadChunkCache    t_threadCache;
+static thread_local bool                t_threadCacheReleased   = false;
+
+ThreadChunkCache::~ThreadChunkCache()
+{
+    if (!g_chunkPoolReleased)
+        GetChunkPool().Absorb(cache, 0);
+    t_threadCacheReleased = true;
+}
+
+// Trims the cache of the calling thread to its low-water mark if it exceeds its high-water mark.
+static void TrimThreadCache(VirtualCommandChunkCache& threadCache)
+{
+    if (threadCache.Size() > g_threadCacheHighWaterMark)
+    {
+        if (!g_chunkPoolReleased)
+            GetChunkPool().Absorb(threadCache, g_threadCacheHighWaterMark / 2);
+        else
+        {
+            VirtualCommandChunkCache overflow;
+            threadCache.TrimInto(overflow, g_threadCacheHighWaterMark / 2);
+        }
+    }
+}
+
+
+/*
+ * Global functions
+ */
+
+LLGL_EXPORT VirtualCommandChunk* AllocVirtualCommandChunk(std::size_t minCapacity)
+{
+    const std::size_t sizeClass = FindChunkSizeClass(minCapacity);
+    if (sizeClass == g_numChunkSizeClasses)
+        return NewChunk(minCapacity);
+
+    /* Recycle chunk from thread cache first, then from the process-wide pool */
+    if (!t_threadCacheReleased)
+    {
+        if (VirtualCommandChunk* chunk = t_threadCache.cache.Pop(sizeClass))
+            return chunk;
+    }
+
+    if (!g_chunkPoolReleased)
+    {
+        if (VirtualCommandChunk* chunk = GetChunkPool().Pop(sizeClass))
+            return chunk;
+    }
+
+    return NewChunk(GetChunkClassCapacity(sizeClass));
+}
+
+LLGL_EXPORT void FreeVirtualCommandChunk(VirtualCommandChunk* chunk)
+{
+    if (chunk == nullptr)
+        return;
+
+    /* Delete chunks that don't belong to any size class right away */
+    const std::size_t sizeClass = FindChunkSizeClass(chunk->capacity);
+    if (sizeClass == g_numChunkSizeClasses || GetChunkClassCapacity(sizeClass) != chunk->capacity)
+    {
+        DeleteChunk(chunk);
+        return;
+    }
+
+    if (!t_threadCacheReleased)
+    {
+        /* Return chunk to thread cache without synchronization */
+        VirtualCommandChunkCache& threadCache = t_threadCache.cache;
+        threadCache.Push(chunk, sizeClass);
+        TrimThreadCache(threadCache);
+    }
+    else if (!g_chunkPoolReleased)
+    {
+        /* Return chunk to the process-wide pool directly while this thread terminates */
+        VirtualCommandChunkCache singleChunk;
+        singleChunk.Push(chunk, sizeClass);
+        GetChunkPool().Absorb(singleChunk, 0);
+    }
+    else
+        DeleteChunk(chunk);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,50 @@
+/*
+ * VirtualCommandChunkPool.h
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#ifndef LLGL_VIRTUAL_COMMAND_CHUNK_POOL_H
+#define LLGL_VIRTUAL_COMMAND_CHUNK_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// POD structure for the memory chunks of virtual command buffers. These chunks contain a payload at the end of the struct.
+struct VirtualCommandChunk
+{
+    std::size_t             capacity;
+    std::size_t             size;
+    VirtualCommandChunk*    next;
+    // <payload>
+};
+
+/*
+Allocates a memory chunk with at least the specified capacity (in bytes) for virtual command buffers.
+Chunks are recycled from a cache of the calling thread first, then from a process-wide pool, and only allocated from the heap if both are empty.
+The capacity is rounded up to the next size class, so the returned chunk can have a greater capacity than requested.
+*/
+LLGL_EXPORT VirtualCommandChunk* AllocVirtualCommandChunk(std::size_t minCapacity);
+
+/*
+Returns the specified memory chunk to the cache of the calling thread. Chunks can be freed by any thread.
+Caches that exceed their high-water mark are trimmed to their low-water mark by moving chunks into the process-wide pool or deleting them.
+*/
+LLGL_EXPORT void FreeVirtualCommandChunk(VirtualCommandChunk* chunk);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
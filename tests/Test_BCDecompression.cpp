@@ -0,0 +1,106 @@
+/*
+ * Test_BCDecompression.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Utils/TypeNames.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <string.h>
+
+
+static unsigned int g_seed;
+
+static std::uint8_t FastRandUInt8()
+{
+    g_seed = (214013 * g_seed + 2531011);
+    return static_cast<std::uint8_t>((g_seed >> 16) & 0xFF);
+}
+
+/*
+Runs the benchmark for a single compression format with random blocks and prints the throughput in MB/s of decompressed RGBA8 data.
+The result of the single-threaded decompression must match the multi-threaded decompression.
+*/
+static bool RunDecompressionBenchmark(LLGL::Format format, const LLGL::Extent2D& extent, unsigned numIterations)
+{
+    const LLGL::FormatAttributes& formatAttribs = LLGL::GetFormatAttribs(format);
+    const std::size_t numBlocks = ((extent.width + 3) / 4) * ((extent.height + 3) / 4);
+
+    std::vector<char> srcImage(numBlocks * formatAttribs.bitSize / 8);
+    for (char& byte : srcImage)
+        byte = static_cast<char>(FastRandUInt8());
+
+    const LLGL::ImageView srcView{ LLGL::ImageFormat::Compressed, LLGL::DataType::Undefined, srcImage.data(), srcImage.size() };
+
+    LLGL::DynamicByteArray dstImages[2];
+    const unsigned threadCounts[2] = { 0, LLGL_MAX_THREAD_COUNT };
+    double throughputs[2] = { 0.0, 0.0 };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        const std::uint64_t startTime = LLGL::Timer::Tick();
+        for (unsigned j = 0; j < numIterations; ++j)
+            dstImages[i] = LLGL::DecompressImageBufferToRGBA8UNorm(format, srcView, extent, threadCounts[i]);
+        const std::uint64_t endTime = LLGL::Timer::Tick();
+
+        const double seconds = static_cast<double>(endTime - startTime) / static_cast<double>(LLGL::Timer::Frequency());
+        const double megaBytes = static_cast<double>(extent.width * extent.height * 4) * numIterations / (1024.0 * 1024.0);
+        throughputs[i] = megaBytes / seconds;
+    }
+
+    const bool resultsValid =
+    (
+        dstImages[0] &&
+        dstImages[1] &&
+        dstImages[0].size() == dstImages[1].size() &&
+        ::memcmp(dstImages[0].get(), dstImages[1].get(), dstImages[0].size()) == 0
+    );
+
+    LLGL::Log::Printf(
+        "%s (%ux%u): 1 thread: %.1f MB/s, max threads: %.1f MB/s%s\n",
+        LLGL::ToString(format), extent.width, extent.height, throughputs[0], throughputs[1],
+        (resultsValid ? "" : "\n\tERROR: results mismatch")
+    );
+
+    return resultsValid;
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    const LLGL::Extent2D extent{ 2048, 2045 };
+    const unsigned numIterations = 4;
+
+    const LLGL::Format formats[] =
+    {
+        LLGL::Format::BC1UNorm,
+        LLGL::Format::BC2UNorm,
+        LLGL::Format::BC3UNorm,
+        LLGL::Format::BC4UNorm,
+        LLGL::Format::BC4SNorm,
+        LLGL::Format::BC5UNorm,
+        LLGL::Format::BC5SNorm,
+        LLGL::Format::BC6HUFloat,
+        LLGL::Format::BC6HSFloat,
+        LLGL::Format::BC7UNorm,
+    };
+
+    bool succeeded = true;
+
+    for (LLGL::Format format : formats)
+        succeeded &= RunDecompressionBenchmark(format, extent, numIterations);
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return (succeeded ? 0 : 1);
+}
+
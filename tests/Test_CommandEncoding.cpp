@@ -0,0 +1,490 @@
+/*
+ * Test_CommandEncoding.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <LLGL/Utils/Utility.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+
+/*
+ * Allocation counter
+ */
+
+// Number of heap allocations in this process. Allocations inside shared LLGL modules are only counted where
+// the global operator new is resolved process-wide (e.g. ELF), but not across DLL boundaries on Windows.
+static std::atomic<std::uint64_t> g_numAllocations{ 0 };
+
+void* operator new (std::size_t size)
+{
+    g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return operator new (size);
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+/*
+ * Benchmark
+ */
+
+// Bitmask of state that is changed between two consecutive draw calls.
+enum ChurnFlags
+{
+    ChurnPipeline       = (1 << 0),
+    ChurnResourceHeap   = (1 << 1),
+    ChurnVertexBuffer   = (1 << 2),
+    ChurnUniforms       = (1 << 3),
+    ChurnAll            = (ChurnPipeline | ChurnResourceHeap | ChurnVertexBuffer | ChurnUniforms),
+};
+
+struct Scenario
+{
+    const char* name;
+    int         churn;
+};
+
+static const Scenario g_scenarios[] =
+{
+    { "draws only",             0                   },
+    { "pipeline churn",         ChurnPipeline       },
+    { "resource heap churn",    ChurnResourceHeap   },
+    { "vertex buffer churn",    ChurnVertexBuffer   },
+    { "uniform churn",          ChurnUniforms       },
+    { "full churn",             ChurnAll            },
+};
+
+// Number of distinct objects per state the draw calls alternate between.
+static const std::size_t g_numStateVariants = 4;
+
+struct BenchmarkConfig
+{
+    std::vector<std::string>    rendererModules;
+    std::uint32_t               numDraws        = 10000;    // Number of draw calls per recording.
+    std::uint32_t               numRecordings   = 20;       // Number of times each scenario is recorded.
+};
+
+struct BenchmarkResult
+{
+    double  nsPerCommand        = 0.0;
+    double  allocsPerCommand    = 0.0;
+};
+
+class EncodingBenchmark
+{
+
+    private:
+
+        LLGL::RenderingDebugger             debugger;
+        LLGL::RenderSystemPtr               renderer;
+        LLGL::CommandBuffer*                commands        = nullptr;
+        LLGL::RenderTarget*                 renderTarget    = nullptr;
+
+        std::vector<LLGL::PipelineState*>   pipelines;
+        std::vector<LLGL::ResourceHeap*>    resourceHeaps;
+        std::vector<LLGL::Buffer*>          vertexBuffers;
+
+        int                                 supportedChurn  = ChurnAll;
+
+        const BenchmarkConfig&              config;
+
+    private:
+
+        // Returns true if the shaders were loaded from SPIR-V, false if they were loaded from GLSL.
+        bool CreateShaders(const LLGL::VertexFormat& vertexFormat, LLGL::Shader*& outVertShader, LLGL::Shader*& outFragShader)
+        {
+            const auto& languages = renderer->GetRenderingCaps().shadingLanguages;
+            const bool hasGLSL  = (std::find(languages.begin(), languages.end(), LLGL::ShadingLanguage::GLSL ) != languages.end());
+            const bool hasSPIRV = (std::find(languages.begin(), languages.end(), LLGL::ShadingLanguage::SPIRV) != languages.end());
+
+            // OpenGL only accepts SPIR-V without separate samplers, so prefer GLSL for this backend
+            const bool useSPIRV = (hasSPIRV && !(hasGLSL && renderer->GetRendererID() == LLGL::RendererID::OpenGL));
+
+            LLGL::ShaderDescriptor vertShaderDesc, fragShaderDesc;
+            if (useSPIRV)
+            {
+                vertShaderDesc = LLGL::ShaderDescFromFile(LLGL::ShaderType::Vertex,   "Shaders/Triangle.vert.spv");
+                fragShaderDesc = LLGL::ShaderDescFromFile(LLGL::ShaderType::Fragment, "Shaders/Triangle.frag.spv");
+            }
+            else
+            {
+                vertShaderDesc.type         = LLGL::ShaderType::Vertex;
+                vertShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+                vertShaderDesc.source       =
+                (
+                    "#version 330\n"
+                    "layout(std140) uniform Matrices {\n"
+                    "    mat4 projection;\n"
+                    "    mat4 modelView;\n"
+                    "};\n"
+                    "in vec2 coord;\n"
+                    "in vec2 texCoord;\n"
+                    "in vec3 color;\n"
+                    "out vec4 vColor;\n"
+                    "out vec2 vTexCoord;\n"
+                    "void main() {\n"
+                    "    gl_Position = projection * modelView * vec4(coord, 0, 1);\n"
+                    "    vTexCoord = texCoord;\n"
+                    "    vColor = vec4(color, 1);\n"
+                    "}\n"
+                );
+
+                fragShaderDesc.type         = LLGL::ShaderType::Fragment;
+                fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+                fragShaderDesc.source       =
+                (
+                    "#version 330\n"
+                    "layout(std140) uniform Colors {\n"
+                    "    vec4 diffuse;\n"
+                    "};\n"
+                    "uniform sampler2D tex;\n"
+                    "uniform vec4 tint;\n"
+                    "in vec4 vColor;\n"
+                    "in vec2 vTexCoord;\n"
+                    "out vec4 fColor;\n"
+                    "void main() {\n"
+                    "    fColor = tint * diffuse * vColor * texture(tex, vTexCoord);\n"
+                    "}\n"
+                );
+            }
+            vertShaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+            outVertShader = renderer->CreateShader(vertShaderDesc);
+            outFragShader = renderer->CreateShader(fragShaderDesc);
+
+            for (LLGL::Shader* shader : { outVertShader, outFragShader })
+            {
+                if (auto report = shader->GetReport())
+                {
+                    if (report->HasErrors())
+                        LLGL_THROW_RUNTIME_ERROR(report->GetText());
+                }
+            }
+
+            return useSPIRV;
+        }
+
+        void CreateResources()
+        {
+            // Create render target
+            LLGL::TextureDescriptor colorTexDesc;
+            {
+                colorTexDesc.type           = LLGL::TextureType::Texture2D;
+                colorTexDesc.bindFlags      = LLGL::BindFlags::ColorAttachment;
+                colorTexDesc.format         = LLGL::Format::RGBA8UNorm;
+                colorTexDesc.extent         = { 64, 64, 1 };
+                colorTexDesc.mipLevels      = 1;
+            }
+            LLGL::Texture* colorTex = renderer->CreateTexture(colorTexDesc);
+
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.resolution             = { 64, 64 };
+                renderTargetDesc.colorAttachments[0]    = colorTex;
+            }
+            renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+            // Create vertex buffers
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "coord",    LLGL::Format::RG32Float,  0 });
+            vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float,  1 });
+            vertexFormat.AppendAttribute({ "color",    LLGL::Format::RGB32Float, 2 });
+
+            const float vertices[] =
+            {
+                -1.0f,  1.0f,   0.0f, 1.0f,   1.0f, 1.0f, 1.0f,
+                -1.0f, -1.0f,   0.0f, 0.0f,   1.0f, 1.0f, 1.0f,
+                 1.0f,  1.0f,   1.0f, 1.0f,   1.0f, 1.0f, 1.0f,
+                 1.0f, -1.0f,   1.0f, 0.0f,   1.0f, 1.0f, 1.0f,
+            };
+
+            for (std::size_t i = 0; i < g_numStateVariants; ++i)
+                vertexBuffers.push_back(renderer->CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices));
+
+            // Create shaders
+            LLGL::Shader* vertShader = nullptr;
+            LLGL::Shader* fragShader = nullptr;
+            const bool isSPIRV = CreateShaders(vertexFormat, vertShader, fragShader);
+
+            // Precompiled SPIR-V shaders don't declare the 'tint' uniform
+            if (isSPIRV)
+                supportedChurn &= ~ChurnUniforms;
+
+            // Create pipeline layout; GLSL binds texture and sampler to the same texture unit
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            {
+                layoutDesc.heapBindings =
+                {
+                    LLGL::BindingDescriptor{ "Matrices",                            LLGL::ResourceType::Buffer,  LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::VertexStage,   2                   },
+                    LLGL::BindingDescriptor{ "Colors",                              LLGL::ResourceType::Buffer,  LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::FragmentStage, 5                   },
+                    LLGL::BindingDescriptor{ (isSPIRV ? "texSampler" : "tex"),      LLGL::ResourceType::Sampler, 0,                               LLGL::StageFlags::FragmentStage, (isSPIRV ? 3u : 0u) },
+                    LLGL::BindingDescriptor{ "tex",                                 LLGL::ResourceType::Texture, LLGL::BindFlags::Sampled,        LLGL::StageFlags::FragmentStage, (isSPIRV ? 4u : 0u) },
+                };
+                if ((supportedChurn & ChurnUniforms) != 0)
+                    layoutDesc.uniforms.push_back(LLGL::UniformDescriptor{ "tint", LLGL::UniformType::Float4 });
+            }
+            LLGL::PipelineLayout* pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+
+            // Create resource heaps
+            const float matrices[32] =
+            {
+                1.0f, 0.0f, 0.0f, 0.0f,   0.0f, 1.0f, 0.0f, 0.0f,   0.0f, 0.0f, 1.0f, 0.0f,   0.0f, 0.0f, 0.0f, 1.0f,
+                1.0f, 0.0f, 0.0f, 0.0f,   0.0f, 1.0f, 0.0f, 0.0f,   0.0f, 0.0f, 1.0f, 0.0f,   0.0f, 0.0f, 0.0f, 1.0f,
+            };
+            const float diffuse[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            const std::uint8_t texels[4] = { 255, 255, 255, 255 };
+
+            LLGL::ImageView imageView{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, texels, sizeof(texels) };
+
+            LLGL::Buffer*   matricesBuffer  = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(matrices)), matrices);
+            LLGL::Sampler*  sampler         = renderer->CreateSampler(LLGL::SamplerDescriptor{});
+
+            for (std::size_t i = 0; i < g_numStateVariants; ++i)
+            {
+                LLGL::Buffer*   colorsBuffer    = renderer->CreateBuffer(LLGL::ConstantBufferDesc(sizeof(diffuse)), diffuse);
+                LLGL::Texture*  texture         = renderer->CreateTexture(LLGL::Texture2DDesc(LLGL::Format::RGBA8UNorm, 1, 1), &imageView);
+                resourceHeaps.push_back(renderer->CreateResourceHeap(pipelineLayout, { matricesBuffer, colorsBuffer, sampler, texture }));
+            }
+
+            // Create pipeline states that differ in their blend and rasterizer states
+            for (std::size_t i = 0; i < g_numStateVariants; ++i)
+            {
+                LLGL::GraphicsPipelineDescriptor pipelineDesc;
+                {
+                    pipelineDesc.vertexShader                   = vertShader;
+                    pipelineDesc.fragmentShader                 = fragShader;
+                    pipelineDesc.pipelineLayout                 = pipelineLayout;
+                    pipelineDesc.renderPass                     = renderTarget->GetRenderPass();
+                    pipelineDesc.primitiveTopology              = LLGL::PrimitiveTopology::TriangleStrip;
+                    pipelineDesc.blend.targets[0].blendEnabled  = ((i & 1) != 0);
+                    pipelineDesc.rasterizer.cullMode            = ((i & 2) != 0 ? LLGL::CullMode::Back : LLGL::CullMode::Disabled);
+                }
+                LLGL::PipelineState* pipeline = renderer->CreatePipelineState(pipelineDesc);
+
+                if (auto report = pipeline->GetReport())
+                {
+                    if (report->HasErrors())
+                        LLGL_THROW_RUNTIME_ERROR(report->GetText());
+                }
+
+                pipelines.push_back(pipeline);
+            }
+
+            commands = renderer->CreateCommandBuffer();
+        }
+
+        // Records all draw calls of the specified scenario and returns the number of recorded commands.
+        std::uint64_t RecordScenario(int churn)
+        {
+            churn &= supportedChurn;
+
+            const float tints[g_numStateVariants][4] =
+            {
+                { 1.0f, 1.0f, 1.0f, 1.0f },
+                { 1.0f, 0.0f, 0.0f, 1.0f },
+                { 0.0f, 1.0f, 0.0f, 1.0f },
+                { 0.0f, 0.0f, 1.0f, 1.0f },
+            };
+
+            std::uint64_t numCommands = 0;
+
+            commands->Begin();
+            {
+                commands->BeginRenderPass(*renderTarget);
+                {
+                    commands->SetViewport(renderTarget->GetResolution());
+                    commands->SetPipelineState(*pipelines[0]);
+                    commands->SetResourceHeap(*resourceHeaps[0]);
+                    commands->SetVertexBuffer(*vertexBuffers[0]);
+                    numCommands += 4;
+
+                    if ((supportedChurn & ChurnUniforms) != 0)
+                    {
+                        commands->SetUniforms(0, tints[0], sizeof(tints[0]));
+                        ++numCommands;
+                    }
+
+                    for (std::uint32_t i = 0; i < config.numDraws; ++i)
+                    {
+                        const std::size_t variant = i % g_numStateVariants;
+
+                        if ((churn & ChurnPipeline) != 0)
+                        {
+                            commands->SetPipelineState(*pipelines[variant]);
+                            ++numCommands;
+                        }
+                        if ((churn & ChurnResourceHeap) != 0)
+                        {
+                            commands->SetResourceHeap(*resourceHeaps[variant]);
+                            ++numCommands;
+                        }
+                        if ((churn & ChurnVertexBuffer) != 0)
+                        {
+                            commands->SetVertexBuffer(*vertexBuffers[variant]);
+                            ++numCommands;
+                        }
+                        if ((churn & ChurnUniforms) != 0)
+                        {
+                            commands->SetUniforms(0, tints[variant], sizeof(tints[variant]));
+                            ++numCommands;
+                        }
+
+                        commands->Draw(4, 0);
+                        ++numCommands;
+                    }
+                }
+                commands->EndRenderPass();
+                numCommands += 2;
+            }
+            commands->End();
+
+            return numCommands;
+        }
+
+    public:
+
+        EncodingBenchmark(const std::string& rendererModule, bool debugLayer, const BenchmarkConfig& config) :
+            config { config }
+        {
+            LLGL::RenderSystemDescriptor rendererDesc = rendererModule;
+            {
+                if (debugLayer)
+                    rendererDesc.debugger = &debugger;
+            }
+            renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+            if (renderer)
+                CreateResources();
+        }
+
+        ~EncodingBenchmark()
+        {
+            if (renderer)
+                LLGL::RenderSystem::Unload(std::move(renderer));
+        }
+
+        bool IsLoaded() const
+        {
+            return (renderer != nullptr);
+        }
+
+        // Returns true if the specified scenario changes any state this renderer supports, or no state at all.
+        bool IsSupported(const Scenario& scenario) const
+        {
+            return (scenario.churn == 0 || (scenario.churn & supportedChurn) != 0);
+        }
+
+        BenchmarkResult Run(const Scenario& scenario)
+        {
+            // Record once to warm up caches and internal memory pools
+            RecordScenario(scenario.churn);
+
+            std::uint64_t numCommands = 0;
+
+            const std::uint64_t startAllocs = g_numAllocations.load();
+            const std::uint64_t startTime   = LLGL::Timer::Tick();
+            {
+                for (std::uint32_t i = 0; i < config.numRecordings; ++i)
+                    numCommands += RecordScenario(scenario.churn);
+            }
+            const std::uint64_t endTime     = LLGL::Timer::Tick();
+            const std::uint64_t endAllocs   = g_numAllocations.load();
+
+            const double elapsedNanoseconds = static_cast<double>(endTime - startTime) * 1.0e9 / static_cast<double>(LLGL::Timer::Frequency());
+
+            BenchmarkResult result;
+            {
+                result.nsPerCommand     = elapsedNanoseconds / static_cast<double>(numCommands);
+                result.allocsPerCommand = static_cast<double>(endAllocs - startAllocs) / static_cast<double>(numCommands);
+            }
+            return result;
+        }
+
+};
+
+// Runs all scenarios for the specified renderer and prints a row for each of them.
+static void RunBenchmark(const std::string& rendererModule, bool debugLayer, const BenchmarkConfig& config)
+{
+    const std::string rendererName = rendererModule + (debugLayer ? " (debug)" : "");
+
+    try
+    {
+        EncodingBenchmark benchmark{ rendererModule, debugLayer, config };
+        if (!benchmark.IsLoaded())
+        {
+            LLGL::Log::Printf("%-20s failed to load renderer\n", rendererName.c_str());
+            return;
+        }
+
+        for (const Scenario& scenario : g_scenarios)
+        {
+            if (!benchmark.IsSupported(scenario))
+            {
+                LLGL::Log::Printf("%-20s %-20s skipped\n", rendererName.c_str(), scenario.name);
+                continue;
+            }
+
+            const BenchmarkResult result = benchmark.Run(scenario);
+            LLGL::Log::Printf(
+                "%-20s %-20s %10.1f ns/command %10.4f allocs/command\n",
+                rendererName.c_str(), scenario.name, result.nsPerCommand, result.allocsPerCommand
+            );
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LLGL::Log::Errorf("%-20s %s\n", rendererName.c_str(), e.what());
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    // Parse arguments: [MODULE...]; benchmark all available modules by default
+    BenchmarkConfig config;
+    for (int i = 1; i < argc; ++i)
+        config.rendererModules.push_back(argv[i]);
+
+    if (config.rendererModules.empty())
+        config.rendererModules = LLGL::RenderSystem::FindModules();
+
+    LLGL::Log::Printf("record %u draws %u times per scenario\n", config.numDraws, config.numRecordings);
+
+    for (const std::string& rendererModule : config.rendererModules)
+    {
+        RunBenchmark(rendererModule, false, config);
+        RunBenchmark(rendererModule, true, config);
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
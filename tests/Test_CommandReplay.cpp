@@ -0,0 +1,282 @@
+/*
+ * Test_CommandReplay.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Utils/VertexFormat.h>
+#include <LLGL/Utils/Utility.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+
+// Number of commands that are recorded per iteration in RecordCommands().
+static const std::uint32_t g_numCommandsPerIteration = 6;
+
+// Number of distinct pipeline states and vertex buffers the draw calls alternate between.
+static const std::size_t g_numStateVariants = 2;
+
+struct ReplayConfig
+{
+    std::string     rendererModule  = "Null";
+    std::uint32_t   numIterations   = 2000;     // Number of iterations the command buffer is recorded with.
+    std::uint32_t   numReplays      = 20;       // Number of times the command buffer is submitted per run.
+    std::uint32_t   numRuns         = 9;        // Number of timed runs; the median of all runs is reported.
+};
+
+struct ReplayScene
+{
+    LLGL::RenderTarget*                 renderTarget    = nullptr;
+    LLGL::Buffer*                       indexBuffer     = nullptr;
+    std::vector<LLGL::Buffer*>          vertexBuffers;
+    std::vector<LLGL::PipelineState*>   pipelines;
+};
+
+// Creates a small render target, vertex and index buffers, and pipeline states that only differ in their blend states.
+static bool CreateScene(LLGL::RenderSystem& renderer, ReplayScene& outScene)
+{
+    LLGL::TextureDescriptor colorTexDesc;
+    {
+        colorTexDesc.bindFlags  = LLGL::BindFlags::ColorAttachment;
+        colorTexDesc.format     = LLGL::Format::RGBA8UNorm;
+        colorTexDesc.extent     = { 16, 16, 1 };
+        colorTexDesc.mipLevels  = 1;
+    }
+    LLGL::Texture* colorTex = renderer.CreateTexture(colorTexDesc);
+
+    LLGL::RenderTargetDescriptor renderTargetDesc;
+    {
+        renderTargetDesc.resolution             = { 16, 16 };
+        renderTargetDesc.colorAttachments[0]    = colorTex;
+    }
+    outScene.renderTarget = renderer.CreateRenderTarget(renderTargetDesc);
+
+    // Small triangles keep the rasterization cost low, so the measurement is dominated by the command dispatch
+    LLGL::VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "coord", LLGL::Format::RG32Float });
+
+    const float vertices[] = { -0.25f, -0.25f,   0.25f, -0.25f,   0.0f, 0.25f };
+    const std::uint16_t indices[] = { 0, 1, 2 };
+
+    for (std::size_t i = 0; i < g_numStateVariants; ++i)
+        outScene.vertexBuffers.push_back(renderer.CreateBuffer(LLGL::VertexBufferDesc(sizeof(vertices), vertexFormat), vertices));
+
+    outScene.indexBuffer = renderer.CreateBuffer(LLGL::IndexBufferDesc(sizeof(indices), LLGL::Format::R16UInt), indices);
+
+    LLGL::ShaderDescriptor vertShaderDesc, fragShaderDesc;
+    {
+        vertShaderDesc.type                 = LLGL::ShaderType::Vertex;
+        vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+        vertShaderDesc.source               = "#version 330\nin vec2 coord;\nvoid main() {\n    gl_Position = vec4(coord, 0, 1);\n}\n";
+        vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+
+        fragShaderDesc.type                 = LLGL::ShaderType::Fragment;
+        fragShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+        fragShaderDesc.source               = "#version 330\nout vec4 fColor;\nvoid main() {\n    fColor = vec4(1);\n}\n";
+    }
+    LLGL::Shader* vertShader = renderer.CreateShader(vertShaderDesc);
+    LLGL::Shader* fragShader = renderer.CreateShader(fragShaderDesc);
+
+    for (LLGL::Shader* shader : { vertShader, fragShader })
+    {
+        if (const LLGL::Report* report = shader->GetReport())
+        {
+            if (report->HasErrors())
+            {
+                LLGL::Log::Errorf("%s", report->GetText());
+                return false;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < g_numStateVariants; ++i)
+    {
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.vertexShader                   = vertShader;
+            pipelineDesc.fragmentShader                 = fragShader;
+            pipelineDesc.renderPass                     = outScene.renderTarget->GetRenderPass();
+            pipelineDesc.blend.targets[0].blendEnabled  = ((i & 1) != 0);
+        }
+        LLGL::PipelineState* pipeline = renderer.CreatePipelineState(pipelineDesc);
+
+        if (const LLGL::Report* report = pipeline->GetReport())
+        {
+            if (report->HasErrors())
+            {
+                LLGL::Log::Errorf("%s", report->GetText());
+                return false;
+            }
+        }
+
+        outScene.pipelines.push_back(pipeline);
+    }
+
+    return true;
+}
+
+// Records a command buffer with the bindings and draw calls of a typical scene, alternating between pipeline states and vertex buffers.
+static void RecordCommands(LLGL::CommandBuffer& commands, const ReplayScene& scene, std::uint32_t numIterations)
+{
+    const LLGL::Extent2D resolution = scene.renderTarget->GetResolution();
+
+    commands.Begin();
+    {
+        commands.BeginRenderPass(*scene.renderTarget);
+        {
+            for (std::uint32_t i = 0; i < numIterations; ++i)
+            {
+                const std::size_t variant = i % g_numStateVariants;
+                commands.SetPipelineState(*scene.pipelines[variant]);
+                commands.SetVertexBuffer(*scene.vertexBuffers[variant]);
+                commands.SetIndexBuffer(*scene.indexBuffer);
+                commands.SetViewport(resolution);
+                commands.Draw(3, 0);
+                commands.DrawIndexed(3, 0);
+            }
+        }
+        commands.EndRenderPass();
+    }
+    commands.End();
+}
+
+class ReplaySession
+{
+
+    public:
+
+        ReplaySession(const ReplayConfig& config, bool compileCommands) :
+            config { config }
+        {
+            LLGL::RenderSystemDescriptor rendererDesc = config.rendererModule;
+            {
+                if (config.rendererModule == "Null")
+                {
+                    rendererConfigNull.compileCommandBuffers    = compileCommands;
+                    rendererDesc.rendererConfig                 = &rendererConfigNull;
+                    rendererDesc.rendererConfigSize             = sizeof(rendererConfigNull);
+                }
+                else if (config.rendererModule == "OpenGL")
+                {
+                    rendererConfigGL.compileCommandBuffers      = compileCommands;
+                    rendererDesc.rendererConfig                 = &rendererConfigGL;
+                    rendererDesc.rendererConfigSize             = sizeof(rendererConfigGL);
+                }
+            }
+            renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+            if (renderer && CreateScene(*renderer, scene))
+            {
+                commandQueue    = renderer->GetCommandQueue();
+                commands        = renderer->CreateCommandBuffer(LLGL::CommandBufferFlags::MultiSubmit);
+
+                RecordCommands(*commands, scene, config.numIterations);
+
+                // Warm up caches before measuring the replay
+                commandQueue->Submit(*commands);
+                commandQueue->WaitIdle();
+            }
+        }
+
+        ~ReplaySession()
+        {
+            if (renderer)
+                LLGL::RenderSystem::Unload(std::move(renderer));
+        }
+
+        bool IsLoaded() const
+        {
+            return (commands != nullptr);
+        }
+
+        // Returns the number of commands per second for a single run of the replay.
+        double Run()
+        {
+            const std::uint64_t startTime = LLGL::Timer::Tick();
+            {
+                for (std::uint32_t i = 0; i < config.numReplays; ++i)
+                    commandQueue->Submit(*commands);
+                commandQueue->WaitIdle();
+            }
+            const std::uint64_t endTime = LLGL::Timer::Tick();
+
+            const double elapsedSeconds = static_cast<double>(endTime - startTime) / static_cast<double>(LLGL::Timer::Frequency());
+            const double numCommands    = static_cast<double>(config.numIterations) * g_numCommandsPerIteration * config.numReplays;
+
+            return (elapsedSeconds > 0.0 ? numCommands / elapsedSeconds : 0.0);
+        }
+
+    private:
+
+        LLGL::RendererConfigurationNull     rendererConfigNull;
+        LLGL::RendererConfigurationOpenGL   rendererConfigGL;
+        LLGL::RenderSystemPtr               renderer;
+        ReplayScene                         scene;
+        LLGL::CommandQueue*                 commandQueue    = nullptr;
+        LLGL::CommandBuffer*                commands        = nullptr;
+
+        const ReplayConfig&                 config;
+
+};
+
+static double GetMedian(std::vector<double> values)
+{
+    std::nth_element(values.begin(), values.begin() + values.size()/2, values.end());
+    return values[values.size()/2];
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    // Parse arguments: [MODULE] [ITERATIONS] [REPLAYS] [RUNS]
+    ReplayConfig config;
+    if (argc > 1)
+        config.rendererModule = argv[1];
+    if (argc > 2)
+        config.numIterations = static_cast<std::uint32_t>(std::atoi(argv[2]));
+    if (argc > 3)
+        config.numReplays = static_cast<std::uint32_t>(std::atoi(argv[3]));
+    if (argc > 4)
+        config.numRuns = std::max(1u, static_cast<std::uint32_t>(std::atoi(argv[4])));
+
+    LLGL::Log::Printf(
+        "replay %u commands %u times in %u runs with renderer: %s\n",
+        config.numIterations * g_numCommandsPerIteration, config.numReplays, config.numRuns, config.rendererModule.c_str()
+    );
+
+    ReplaySession interpreted{ config, false };
+    ReplaySession compiled{ config, true };
+
+    if (!interpreted.IsLoaded() || !compiled.IsLoaded())
+    {
+        LLGL::Log::Errorf("failed to load renderer: %s\n", config.rendererModule.c_str());
+        return EXIT_FAILURE;
+    }
+
+    // Alternate between both modes and take the median of all runs, so system noise affects both modes alike
+    std::vector<double> interpretedRates, compiledRates, speedups;
+
+    for (std::uint32_t run = 0; run < config.numRuns; ++run)
+    {
+        const double interpretedRate    = interpreted.Run();
+        const double compiledRate       = compiled.Run();
+        interpretedRates.push_back(interpretedRate);
+        compiledRates.push_back(compiledRate);
+        speedups.push_back(interpretedRate > 0.0 ? compiledRate / interpretedRate : 0.0);
+    }
+
+    LLGL::Log::Printf("interpreted: %.2f M commands/s (median)\n", GetMedian(interpretedRates) / 1.0e6);
+    LLGL::Log::Printf("compiled:    %.2f M commands/s (median, %.2fx)\n", GetMedian(compiledRates) / 1.0e6, GetMedian(speedups));
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,158 @@
+/*
+ * Test_ImageConversion.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Timer.h>
+#include <LLGL/Utils/TypeNames.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <string.h>
+
+
+static unsigned int g_seed;
+
+static std::uint8_t FastRandUInt8()
+{
+    g_seed = (214013 * g_seed + 2531011);
+    return static_cast<std::uint8_t>((g_seed >> 16) & 0xFF);
+}
+
+static const char* DataTypeToString(LLGL::DataType dataType)
+{
+    switch (dataType)
+    {
+        case LLGL::DataType::UInt8:     return "UInt8";
+        case LLGL::DataType::Float16:   return "Float16";
+        case LLGL::DataType::Float32:   return "Float32";
+        case LLGL::DataType::Float64:   return "Float64";
+        default:                        return "<other>";
+    }
+}
+
+struct ConversionBenchmark
+{
+    LLGL::ImageFormat   srcFormat;
+    LLGL::DataType      srcDataType;
+    LLGL::ImageFormat   dstFormat;
+    LLGL::DataType      dstDataType;
+};
+
+static double MeasureTime(const std::function<void()>& callback, unsigned numIterations)
+{
+    const std::uint64_t startTime = LLGL::Timer::Tick();
+    for (unsigned i = 0; i < numIterations; ++i)
+        callback();
+    const std::uint64_t endTime = LLGL::Timer::Tick();
+    return static_cast<double>(endTime - startTime) / static_cast<double>(LLGL::Timer::Frequency()) * 1000.0 / numIterations;
+}
+
+// Generates a random source image. Floating-point images are generated via the UInt8 conversion to keep them in the range [0, 1].
+static std::vector<char> GenerateSourceImage(LLGL::ImageFormat format, LLGL::DataType dataType, std::size_t numPixels)
+{
+    std::vector<char> image8Bit(LLGL::GetMemoryFootprint(format, LLGL::DataType::UInt8, numPixels));
+    for (char& byte : image8Bit)
+        byte = static_cast<char>(FastRandUInt8());
+
+    if (dataType == LLGL::DataType::UInt8)
+        return image8Bit;
+
+    std::vector<char> image(LLGL::GetMemoryFootprint(format, dataType, numPixels));
+    const LLGL::ImageView srcView{ format, LLGL::DataType::UInt8, image8Bit.data(), image8Bit.size() };
+    const LLGL::MutableImageView dstView{ format, dataType, image.data(), image.size() };
+    LLGL::ConvertImageBuffer(srcView, dstView, 0);
+    return image;
+}
+
+/*
+Runs the benchmark for a single conversion. The generic variant path is measured by converting through DataType::Float64,
+which is not covered by the specialized converters. Converting through Float64 is lossless, so both results must match bitwise.
+*/
+static bool RunConversionBenchmark(const ConversionBenchmark& bench, const LLGL::Extent2D& extent, unsigned numIterations, unsigned threadCount)
+{
+    const std::size_t numPixels = extent.width * extent.height;
+
+    std::vector<char> srcImage = GenerateSourceImage(bench.srcFormat, bench.srcDataType, numPixels);
+    std::vector<char> intermediateImage(LLGL::GetMemoryFootprint(bench.srcFormat, LLGL::DataType::Float64, numPixels));
+    std::vector<char> dstImageGeneric(LLGL::GetMemoryFootprint(bench.dstFormat, bench.dstDataType, numPixels));
+    std::vector<char> dstImageSpecialized(dstImageGeneric.size());
+
+    const LLGL::ImageView srcView{ bench.srcFormat, bench.srcDataType, srcImage.data(), srcImage.size() };
+    const LLGL::MutableImageView intermediateDstView{ bench.srcFormat, LLGL::DataType::Float64, intermediateImage.data(), intermediateImage.size() };
+    const LLGL::ImageView intermediateSrcView{ bench.srcFormat, LLGL::DataType::Float64, intermediateImage.data(), intermediateImage.size() };
+    const LLGL::MutableImageView dstViewGeneric{ bench.dstFormat, bench.dstDataType, dstImageGeneric.data(), dstImageGeneric.size() };
+    const LLGL::MutableImageView dstViewSpecialized{ bench.dstFormat, bench.dstDataType, dstImageSpecialized.data(), dstImageSpecialized.size() };
+
+    const double genericTime = MeasureTime(
+        [&]()
+        {
+            LLGL::ConvertImageBuffer(srcView, intermediateDstView, threadCount);
+            LLGL::ConvertImageBuffer(intermediateSrcView, dstViewGeneric, threadCount);
+        },
+        numIterations
+    );
+
+    const double specializedTime = MeasureTime(
+        [&]()
+        {
+            LLGL::ConvertImageBuffer(srcView, dstViewSpecialized, threadCount);
+        },
+        numIterations
+    );
+
+    const bool resultsMatch = (::memcmp(dstImageGeneric.data(), dstImageSpecialized.data(), dstImageGeneric.size()) == 0);
+
+    const std::string threadCountLabel = (threadCount == LLGL_MAX_THREAD_COUNT ? std::string("max") : std::to_string(std::max(1u, threadCount)));
+
+    LLGL::Log::Printf(
+        "%s/%s -> %s/%s (%ux%u, %s threads):\n\tgeneric: %.3f ms, specialized: %.3f ms, speedup: %.2fx%s\n",
+        LLGL::ToString(bench.srcFormat), DataTypeToString(bench.srcDataType),
+        LLGL::ToString(bench.dstFormat), DataTypeToString(bench.dstDataType),
+        extent.width, extent.height,
+        threadCountLabel.c_str(),
+        genericTime, specializedTime, (genericTime / specializedTime),
+        (resultsMatch ? "" : "\n\tERROR: results mismatch")
+    );
+
+    return resultsMatch;
+}
+
+int main(int argc, char* argv[])
+{
+    LLGL::Log::RegisterCallbackStd();
+
+    const LLGL::Extent2D extent{ 1024, 1024 };
+    const unsigned numIterations = 4;
+
+    const ConversionBenchmark benchmarks[] =
+    {
+        { LLGL::ImageFormat::RGB,  LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8   },
+        { LLGL::ImageFormat::BGRA, LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8   },
+        { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::Float16 },
+        { LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8   },
+        { LLGL::ImageFormat::RGB,  LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::Float32 },
+        { LLGL::ImageFormat::RGBA, LLGL::DataType::Float16, LLGL::ImageFormat::BGRA, LLGL::DataType::Float32 },
+        { LLGL::ImageFormat::RGBA, LLGL::DataType::Float16, LLGL::ImageFormat::RGBA, LLGL::DataType::Float32 },
+        { LLGL::ImageFormat::RGB,  LLGL::DataType::Float32, LLGL::ImageFormat::RGB,  LLGL::DataType::Float16 },
+    };
+
+    bool succeeded = true;
+
+    for (const ConversionBenchmark& bench : benchmarks)
+    {
+        succeeded &= RunConversionBenchmark(bench, extent, numIterations, 0);
+        succeeded &= RunConversionBenchmark(bench, extent, numIterations, LLGL_MAX_THREAD_COUNT);
+    }
+
+    #ifdef _WIN32
+    system("pause");
+    #endif
+
+    return (succeeded ? 0 : 1);
+}
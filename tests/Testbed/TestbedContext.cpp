@@ -8,9 +8,14 @@
 #include "Testbed.h"
 #include <LLGL/Utils/TypeNames.h>
 #include <LLGL/Utils/Parse.h>
+#include <LLGL/ThreadPool.h>
 #include <Gauss/ProjectionMatrix4.h>
 #include <string.h>
+#include <stdlib.h>
 #include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <cmath>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -138,6 +143,9 @@ static void ConfigureOpenGL(RendererConfigurationOpenGL& cfg, int version)
         cfg.majorVersion = (version / 100) % 10;
         cfg.minorVersion = (version /  10) % 10;
     }
+
+    // Optimize multi-submit command buffers, so the CommandBufferOptimizer test can compare them with command buffers that are not optimized
+    cfg.optimizeCommandBuffers = true;
 }
 
 static bool TestFailed(TestResult result)
@@ -153,6 +161,18 @@ TestbedContext::TestbedContext(const char* moduleName, int version, int argc, ch
     opt           { TestbedContext::ParseOptions(argc, argv) },
     reportHandle_ { Log::RegisterCallbackReport(report_)     }
 {
+    #if !LLGL_TESTBED_INCLUDE_NULL_SPIRV_TESTS
+    // Golden images of the Null module would all be empty if it cannot execute shaders, so fail before running any test
+    if (opt.golden && ::strcmp(moduleName, "Null") == 0)
+    {
+        Log::Errorf(
+            Log::ColorFlags::StdError,
+            "Golden mode requires the Null module to execute shaders, but LLGL was built with LLGL_NULL_ENABLE_SPIRV_EXECUTION=OFF\n"
+        );
+        return;
+    }
+    #endif
+
     // Check for debug options
     const char* debugValue              = "";
     const bool  isDebugMode             = (HasProgramArgument(argc, argv, "-d", &debugValue) || HasProgramArgument(argc, argv, "--debug", &debugValue));
@@ -253,6 +273,9 @@ TestbedContext::TestbedContext(const char* moduleName, int version, int argc, ch
 
 TestbedContext::~TestbedContext()
 {
+    // Golden image diffs must not outlive this context
+    WaitForGoldenDiffs();
+
     // Write output report file if specified
     const std::string reportFilename = opt.outputDir + moduleName + "/Report.txt";
     std::ofstream reportFile{ reportFilename };
@@ -368,27 +391,35 @@ unsigned TestbedContext::RunAllTests()
     #define RUN_TEST(TEST)                                                          \
         if (opt.ContainsTest(#TEST))                                                \
         {                                                                           \
+            const std::uint64_t t0 = Timer::Tick();                                 \
+            currentTest_ = #TEST;                                                   \
             const TestResult result = RunTest(                                      \
                 std::bind(&TestbedContext::Test##TEST, this, std::placeholders::_1) \
             );                                                                      \
+            testTimings_.push_back({ #TEST, ToMillisecs(t0, Timer::Tick()) });      \
             RecordTestResult(result, #TEST);                                        \
         }
 
-    #define RUN_C99_TEST(TEST)                          \
-        if (opt.ContainsTest(#TEST))                    \
-        {                                               \
-            const TestResult result = Test##TEST(0);    \
-            RecordTestResult(result, #TEST);            \
+    #define RUN_C99_TEST(TEST)                                                      \
+        if (opt.ContainsTest(#TEST))                                                \
+        {                                                                           \
+            const std::uint64_t t0 = Timer::Tick();                                 \
+            currentTest_ = #TEST;                                                   \
+            const TestResult result = Test##TEST(0);                                \
+            testTimings_.push_back({ #TEST, ToMillisecs(t0, Timer::Tick()) });      \
+            RecordTestResult(result, #TEST);                                        \
         }
 
     // Run all command buffer tests
     RUN_TEST( CommandBufferSubmit         );
     RUN_TEST( CommandBufferEncode         );
+    RUN_TEST( FenceAsyncSubmission        );
 
     // Run all resource tests (these don't render to the screen)
     RUN_TEST( NativeHandle                );
     RUN_TEST( BufferWriteAndRead          );
     RUN_TEST( BufferMap                   );
+    RUN_TEST( NullBufferMap               );
     RUN_TEST( BufferFill                  );
     RUN_TEST( BufferUpdate                );
     RUN_TEST( BufferCopy                  );
@@ -397,6 +428,7 @@ unsigned TestbedContext::RunAllTests()
     RUN_TEST( TextureCopy                 );
     RUN_TEST( TextureToBufferCopy         );
     RUN_TEST( BufferToTextureCopy         );
+    RUN_TEST( FramebufferCopy             );
     RUN_TEST( RenderTargetNoAttachments   );
     RUN_TEST( RenderTarget1Attachment     );
     RUN_TEST( RenderTargetNAttachments    );
@@ -404,6 +436,7 @@ unsigned TestbedContext::RunAllTests()
     RUN_TEST( PipelineCaching             );
     RUN_TEST( ShaderErrors                );
     RUN_TEST( SamplerBuffer               );
+    RUN_TEST( SpirvInterpreter            );
     RUN_TEST( ByteBuffer                  );
     RUN_TEST( BarrierReadAfterWrite       );
     RUN_TEST( Multiview                   );
@@ -419,7 +452,12 @@ unsigned TestbedContext::RunAllTests()
     RUN_TEST( AlphaOnlyTexture            );
     //RUN_TEST( CommandBufferMultiThreading ); //TODO: this must be rewritten as CommandBuffer constraints are violated in this test
     RUN_TEST( CommandBufferSecondary      );
+    RUN_TEST( CommandBufferSecondaryThreads );
     RUN_TEST( TriangleStripCutOff         );
+    RUN_TEST( Queries                     );
+    RUN_TEST( VertexFetch                 );
+    RUN_TEST( SamplerFiltering            );
+    RUN_TEST( CommandBufferOptimizer      );
     RUN_TEST( TextureViews                );
     RUN_TEST( TextureStrides              );
     RUN_TEST( Uniforms                    );
@@ -440,6 +478,16 @@ unsigned TestbedContext::RunAllTests()
     RUN_C99_TEST( OffscreenC99 );
 
     #undef RUN_TEST
+    #undef RUN_C99_TEST
+
+    currentTest_ = nullptr;
+
+    // Evaluate all image diffs that have been scheduled in golden mode
+    if (opt.golden)
+        EvaluateGoldenDiffs();
+
+    if (opt.showTiming || opt.golden)
+        PrintTestTimings();
 
     // Print summary
     PrintTestSummary(failures);
@@ -480,7 +528,15 @@ unsigned TestbedContext::RunRendererIndependentTests(int argc, char* argv[])
     RUN_TEST( ContainerStringLiteral );
     RUN_TEST( ContainerStringOperators );
     RUN_TEST( ParseUtil );
+    RUN_TEST( ThreadPool );
+    RUN_TEST( TaskScheduler );
+    RUN_TEST( VirtualCommandChunkPool );
     RUN_TEST( ImageConversions );
+    RUN_TEST( ImageCompression );
+    RUN_TEST( ImageBlit );
+    RUN_TEST( ImageMipChain );
+    RUN_TEST( ImageResize );
+    RUN_TEST( ImageDecompression );
     RUN_TEST( ImageStrides );
     RUN_TEST( FormatAttribs );
 
@@ -963,6 +1019,12 @@ TestbedContext::Options TestbedContext::ParseOptions(int argc, char* argv[])
     opt.showTiming      = (HasProgramArgument(argc, argv, "-t") || HasProgramArgument(argc, argv, "--timing"));
     opt.fastTest        = (HasProgramArgument(argc, argv, "-f") || HasProgramArgument(argc, argv, "--fast"));
     opt.updateRefs      = HasProgramArgument(argc, argv, "--update");
+
+    const char* minSSIM = nullptr;
+    opt.golden          = HasProgramArgument(argc, argv, "--golden", &minSSIM);
+    if (minSSIM != nullptr && *minSSIM != '\0')
+        opt.minSSIM = static_cast<float>(std::atof(minSSIM));
+
     opt.resolution      = { g_testbedWinSize[0], g_testbedWinSize[1] };
     opt.selectedTests   = FindSelectedTests(argc, argv);
     return opt;
@@ -1049,7 +1111,10 @@ bool TestbedContext::LoadShaders()
         ShaderMacro{ nullptr, nullptr }
     };
 
-    if (IsShadingLanguageSupported(ShadingLanguage::HLSL))
+    // Null renderer accepts all shading languages, but it can only execute SPIR-V
+    const bool preferSpirv = (renderer->GetRendererID() == RendererID::Null && IsShadingLanguageSupported(ShadingLanguage::SPIRV));
+
+    if (IsShadingLanguageSupported(ShadingLanguage::HLSL) && !preferSpirv)
     {
         shaders[VSSolid]            = LoadShaderFromFile("TriangleMesh.hlsl",          ShaderType::Vertex,          "VSMain",  "vs_5_0");
         shaders[PSSolid]            = LoadShaderFromFile("TriangleMesh.hlsl",          ShaderType::Fragment,        "PSMain",  "ps_5_0");
@@ -1101,7 +1166,7 @@ bool TestbedContext::LoadShaders()
             shaders[PSMeshlet]      = LoadShaderFromFile("Meshlet.hlsl",               ShaderType::Fragment,        "PSMain",  "ps_6_5");
         }
     }
-    else if (IsShadingLanguageSupported(ShadingLanguage::GLSL))
+    else if (IsShadingLanguageSupported(ShadingLanguage::GLSL) && !preferSpirv)
     {
         if (std::find(caps.shadingLanguages.begin(), caps.shadingLanguages.end(), LLGL::ShadingLanguage::GLSL_330) == caps.shadingLanguages.end())
         {
@@ -1158,7 +1223,7 @@ bool TestbedContext::LoadShaders()
         shaders[VSVertexFormat3]    = LoadShaderFromFile("VertexFormats.330core.vert",         ShaderType::Vertex,          nullptr, nullptr, nullptr, VertFmtLayout3);
         shaders[PSVertexFormat]     = LoadShaderFromFile("VertexFormats.330core.frag",         ShaderType::Fragment);
     }
-    else if (IsShadingLanguageSupported(ShadingLanguage::Metal))
+    else if (IsShadingLanguageSupported(ShadingLanguage::Metal) && !preferSpirv)
     {
         shaders[VSSolid]            = LoadShaderFromFile("TriangleMesh.metal",         ShaderType::Vertex,   "VSMain",  "1.1");
         shaders[PSSolid]            = LoadShaderFromFile("TriangleMesh.metal",         ShaderType::Fragment, "PSMain",  "1.1");
@@ -1538,6 +1603,26 @@ Shader* TestbedContext::LoadShaderFromFile(
     const ShaderMacro*  defines,
     VertFmt             vertFmt,
     VertFmt             vertOutFmt)
+{
+    return LoadShaderFromFile(
+        filename,
+        type,
+        entry,
+        profile,
+        defines,
+        vertexFormats[vertFmt].attributes,
+        (vertOutFmt != VertFmtCount ? vertexFormats[vertOutFmt].attributes : std::vector<VertexAttribute>{})
+    );
+}
+
+Shader* TestbedContext::LoadShaderFromFile(
+    const std::string&                  filename,
+    ShaderType                          type,
+    const char*                         entry,
+    const char*                         profile,
+    const ShaderMacro*                  defines,
+    const std::vector<VertexAttribute>& inputAttribs,
+    const std::vector<VertexAttribute>& outputAttribs)
 {
     auto StringEndsWith = [](const std::string& str, const std::string& suffix) -> bool
     {
@@ -1575,9 +1660,8 @@ Shader* TestbedContext::LoadShaderFromFile(
         shaderDesc.defines              = defines;
         shaderDesc.flags                = ShaderCompileFlags::PatchClippingOrigin;
         if (type == ShaderType::Vertex)
-            shaderDesc.vertex.inputAttribs  = vertexFormats[vertFmt].attributes;
-        if (vertOutFmt != VertFmtCount)
-            shaderDesc.vertex.outputAttribs = vertexFormats[vertOutFmt].attributes;
+            shaderDesc.vertex.inputAttribs  = inputAttribs;
+        shaderDesc.vertex.outputAttribs     = outputAttribs;
     }
     Shader* shader = renderer->CreateShader(shaderDesc);
 
@@ -1643,22 +1727,30 @@ void PrintLoadImageInfo(const std::string& filename)
     Log::Printf("Load PNG image: %s", filename.c_str());
 };
 
+// Copies an image that has been decoded with 3 components into the output pixels and releases the decoded image buffer.
+static bool TakeDecodedImage(std::vector<ColorRGBub>& pixels, Extent2D& extent, stbi_uc* imgBuf, int w, int h)
+{
+    if (imgBuf == nullptr)
+        return false;
+
+    extent.width = static_cast<std::uint32_t>(w);
+    extent.height = static_cast<std::uint32_t>(h);
+    pixels.resize(extent.width * extent.height);
+    for_range(i, pixels.size())
+        pixels[i] = ColorRGBub{ imgBuf[i*3], imgBuf[i*3+1], imgBuf[i*3+2] };
+    stbi_image_free(imgBuf);
+
+    return true;
+}
+
 static bool LoadImage(std::vector<ColorRGBub>& pixels, Extent2D& extent, const std::string& filename, bool verbose = false)
 {
     if (verbose)
         PrintLoadImageInfo(filename);
 
     int w = 0, h = 0, c = 0;
-    if (stbi_uc* imgBuf = stbi_load(filename.c_str(), &w, &h, &c, 3))
-    {
-        extent.width = static_cast<std::uint32_t>(w);
-        extent.height = static_cast<std::uint32_t>(h);
-        pixels.resize(extent.width * extent.height);
-        for_range(i, pixels.size())
-            pixels[i] = ColorRGBub{ imgBuf[i*3], imgBuf[i*3+1], imgBuf[i*3+2] };
-        stbi_image_free(imgBuf);
-    }
-    else
+    stbi_uc* imgBuf = stbi_load(filename.c_str(), &w, &h, &c, 3);
+    if (!TakeDecodedImage(pixels, extent, imgBuf, w, h))
     {
         if (!verbose)
             PrintLoadImageInfo(filename);
@@ -1923,6 +2015,10 @@ TestbedContext::DiffResult TestbedContext::DiffImages(const std::string& name, i
     if (opt.updateRefs)
         return DiffResult{};
 
+    // Defer analysis to worker threads in golden mode
+    if (opt.golden)
+        return ScheduleGoldenDiff(name, threshold, tolerance, scale);
+
     // Load input images and validate they have the same dimensions
     std::vector<ColorRGBub> pixelsA, pixelsB;
     std::vector<ColorRGBAub> pixelsDiff;
@@ -1942,11 +2038,31 @@ TestbedContext::DiffResult TestbedContext::DiffImages(const std::string& name, i
 
     // Generate heat-map image
     DiffResult result{ (opt.pedantic ? DiffResult{ 0 } : DiffResult{ threshold, tolerance }) };
-    pixelsDiff.resize(extentA.width * extentA.height);
 
     if (opt.verbose)
         result.ResetHistogram(&histogram_);
 
+    DiffPixels(pixelsA, pixelsB, pixelsDiff, result, scale);
+
+    if (result.Mismatch())
+    {
+        // Save diff inage and return highest difference value
+        if (!SaveImage(pixelsDiff, extentA, diffPath + name + ".Diff.png", opt.verbose))
+            return DiffErrorSaveDiffFailed;
+    }
+
+    return result;
+}
+
+void TestbedContext::DiffPixels(
+    const std::vector<ColorRGBub>&  pixelsA,
+    const std::vector<ColorRGBub>&  pixelsB,
+    std::vector<ColorRGBAub>&       pixelsDiff,
+    DiffResult&                     result,
+    int                             scale)
+{
+    pixelsDiff.resize(pixelsA.size());
+
     for_range(i, pixelsDiff.size())
     {
         const ColorRGBub& colorA = pixelsA[i];
@@ -1967,15 +2083,239 @@ TestbedContext::DiffResult TestbedContext::DiffImages(const std::string& name, i
 
         result.Add(maxDiff);
     }
+}
 
-    if (result.Mismatch())
+// Returns the peak signal-to-noise ratio (in dB) over the RGB components of two images with equal size. Identical images have an infinite PSNR.
+static double ComputePSNR(const std::vector<ColorRGBub>& pixelsA, const std::vector<ColorRGBub>& pixelsB)
+{
+    double sumSq = 0.0;
+    for_range(i, pixelsA.size())
     {
-        // Save diff inage and return highest difference value
-        if (!SaveImage(pixelsDiff, extentA, diffPath + name + ".Diff.png", opt.verbose))
-            return DiffErrorSaveDiffFailed;
+        const int diff[3] =
+        {
+            GetColorDiff(pixelsA[i].r, pixelsB[i].r),
+            GetColorDiff(pixelsA[i].g, pixelsB[i].g),
+            GetColorDiff(pixelsA[i].b, pixelsB[i].b),
+        };
+        sumSq += static_cast<double>(diff[0]*diff[0] + diff[1]*diff[1] + diff[2]*diff[2]);
     }
 
-    return result;
+    if (sumSq == 0.0 || pixelsA.empty())
+        return HUGE_VAL;
+
+    const double mse = sumSq / static_cast<double>(pixelsA.size() * 3);
+    return 10.0 * std::log10(255.0*255.0 / mse);
+}
+
+static double GetLuminance(const ColorRGBub& color)
+{
+    return (0.299 * color.r + 0.587 * color.g + 0.114 * color.b);
+}
+
+/*
+Returns the mean structural similarity (SSIM) of the luminance of two images with equal size over non-overlapping 8x8 windows.
+SSIM tolerates small shifts of edges and noise, which the CPU rasterizer of the Null backend produces in comparison to GPU references.
+*/
+static double ComputeSSIM(const std::vector<ColorRGBub>& pixelsA, const std::vector<ColorRGBub>& pixelsB, const Extent2D& extent)
+{
+    constexpr std::uint32_t windowSize = 8;
+    constexpr double        c1          = (0.01 * 255.0) * (0.01 * 255.0);
+    constexpr double        c2          = (0.03 * 255.0) * (0.03 * 255.0);
+
+    double          sumSSIM     = 0.0;
+    std::uint32_t   numWindows  = 0;
+
+    for (std::uint32_t y0 = 0; y0 < extent.height; y0 += windowSize)
+    {
+        for (std::uint32_t x0 = 0; x0 < extent.width; x0 += windowSize)
+        {
+            const std::uint32_t x1 = std::min(x0 + windowSize, extent.width);
+            const std::uint32_t y1 = std::min(y0 + windowSize, extent.height);
+
+            // Accumulate first and second moments of both windows
+            double sumA = 0.0, sumB = 0.0, sumAA = 0.0, sumBB = 0.0, sumAB = 0.0;
+            for (std::uint32_t y = y0; y < y1; ++y)
+            {
+                for (std::uint32_t x = x0; x < x1; ++x)
+                {
+                    const std::size_t i = static_cast<std::size_t>(y) * extent.width + x;
+                    const double a = GetLuminance(pixelsA[i]);
+                    const double b = GetLuminance(pixelsB[i]);
+                    sumA    += a;
+                    sumB    += b;
+                    sumAA   += a*a;
+                    sumBB   += b*b;
+                    sumAB   += a*b;
+                }
+            }
+
+            const double n          = static_cast<double>((x1 - x0) * (y1 - y0));
+            const double meanA      = sumA / n;
+            const double meanB      = sumB / n;
+            const double varA       = sumAA / n - meanA*meanA;
+            const double varB       = sumBB / n - meanB*meanB;
+            const double covariance = sumAB / n - meanA*meanB;
+
+            sumSSIM += ((2.0*meanA*meanB + c1) * (2.0*covariance + c2)) / ((meanA*meanA + meanB*meanB + c1) * (varA + varB + c2));
+            ++numWindows;
+        }
+    }
+
+    return (numWindows > 0 ? sumSSIM / numWindows : 1.0);
+}
+
+TestbedContext::DiffResult TestbedContext::ScheduleGoldenDiff(const std::string& name, int threshold, unsigned tolerance, int scale)
+{
+    std::unique_ptr<GoldenDiff> diff{ new GoldenDiff{} };
+    diff->name      = name;
+    diff->testName  = (currentTest_ != nullptr ? currentTest_ : "");
+    diff->scale     = scale;
+    diff->result    = (opt.pedantic ? DiffResult{ 0 } : DiffResult{ threshold, tolerance });
+
+    // Read encoded result image right away, since the test might overwrite it before the diff is processed
+    std::ifstream resultFile{ GetResultPath() + name + ".Result.png", std::ios::binary };
+    if (resultFile.good())
+        diff->resultFile.assign(std::istreambuf_iterator<char>(resultFile), std::istreambuf_iterator<char>());
+
+    GoldenDiff* diffRef = diff.get();
+    goldenDiffs_.push_back(std::move(diff));
+
+    if (diffRef->resultFile.empty())
+    {
+        diffRef->result = DiffErrorLoadResultFailed;
+        return DiffResult{};
+    }
+
+    {
+        std::lock_guard<std::mutex> guard{ goldenMutex_ };
+        ++goldenPending_;
+    }
+
+    ThreadPool::Submit(
+        [this, diffRef]()
+        {
+            RunGoldenDiff(*diffRef);
+            std::lock_guard<std::mutex> guard{ goldenMutex_ };
+            if (--goldenPending_ == 0)
+                goldenCondVar_.notify_all();
+        }
+    );
+
+    // Tests are evaluated at the end of all tests in golden mode, so always return an empty result here
+    return DiffResult{};
+}
+
+void TestbedContext::RunGoldenDiff(GoldenDiff& diff)
+{
+    const std::uint64_t t0 = Timer::Tick();
+
+    // Decode reference and result images without logging, since this runs on a worker thread
+    std::vector<ColorRGBub> pixelsA, pixelsB;
+    std::vector<ColorRGBAub> pixelsDiff;
+    Extent2D extentA, extentB;
+
+    int w = 0, h = 0, c = 0;
+    stbi_uc* imgBuf = stbi_load(("Reference/" + diff.name + ".Ref.png").c_str(), &w, &h, &c, 3);
+    if (!TakeDecodedImage(pixelsA, extentA, imgBuf, w, h))
+    {
+        diff.result = DiffErrorLoadRefFailed;
+        return;
+    }
+
+    imgBuf = stbi_load_from_memory(
+        reinterpret_cast<const stbi_uc*>(diff.resultFile.data()),
+        static_cast<int>(diff.resultFile.size()),
+        &w, &h, &c, 3
+    );
+    if (!TakeDecodedImage(pixelsB, extentB, imgBuf, w, h))
+    {
+        diff.result = DiffErrorLoadResultFailed;
+        return;
+    }
+
+    if (extentA != extentB)
+    {
+        diff.result = DiffErrorExtentMismatch;
+        return;
+    }
+
+    // Generate heat-map image and perceptual metrics
+    DiffPixels(pixelsA, pixelsB, pixelsDiff, diff.result, diff.scale);
+
+    diff.psnr = ComputePSNR(pixelsA, pixelsB);
+    diff.ssim = ComputeSSIM(pixelsA, pixelsB, extentA);
+
+    if (diff.result.Mismatch())
+    {
+        if (!SaveImage(pixelsDiff, extentA, opt.outputDir + moduleName + "/" + diff.name + ".Diff.png"))
+            diff.result = DiffErrorSaveDiffFailed;
+    }
+
+    diff.duration = ToMillisecs(t0, Timer::Tick());
+}
+
+void TestbedContext::WaitForGoldenDiffs()
+{
+    std::unique_lock<std::mutex> lock{ goldenMutex_ };
+    goldenCondVar_.wait(lock, [this]() { return (goldenPending_ == 0); });
+}
+
+void TestbedContext::EvaluateGoldenDiffs()
+{
+    WaitForGoldenDiffs();
+
+    if (goldenDiffs_.empty())
+        return;
+
+    Log::Printf("Golden images (SSIM >= %.4f):\n", opt.minSSIM);
+
+    for (const auto& diff : goldenDiffs_)
+    {
+        // Images that exceed the difference threshold still pass if they are perceptually similar, unless pedantic mode is enabled
+        const DiffResult& result = diff->result;
+        const bool failed = (result.value < 0 || (result.Mismatch() && (opt.pedantic || diff->ssim < opt.minSSIM)));
+
+        char psnr[32];
+        if (std::isinf(diff->psnr))
+            ::snprintf(psnr, sizeof(psnr), "inf");
+        else
+            ::snprintf(psnr, sizeof(psnr), "%.2f dB", diff->psnr);
+
+        Log::Printf(
+            " %s/%s (%s; PSNR = %s; SSIM = %.4f; %.1f ms)",
+            diff->testName, diff->name.c_str(), result.Print(), psnr, diff->ssim, diff->duration
+        );
+        PrintColoredResult(failed ? TestResult::FailedMismatch : TestResult::Passed);
+
+        if (failed)
+            ++failures;
+    }
+
+    goldenDiffs_.clear();
+}
+
+void TestbedContext::PrintTestTimings() const
+{
+    if (testTimings_.empty())
+        return;
+
+    // Print slowest tests first
+    std::vector<TestTiming> timings = testTimings_;
+    std::stable_sort(
+        timings.begin(), timings.end(),
+        [](const TestTiming& lhs, const TestTiming& rhs) -> bool
+        {
+            return (lhs.duration > rhs.duration);
+        }
+    );
+
+    double total = 0.0;
+    for (const TestTiming& timing : timings)
+        total += timing.duration;
+
+    Log::Printf("Test timings (total: %.1f ms):\n", total);
+    for (const TestTiming& timing : timings)
+        Log::Printf(" %-30s %10.1f ms\n", timing.name, timing.duration);
 }
 
 void TestbedContext::RecordTestResult(TestResult result, const char* name)
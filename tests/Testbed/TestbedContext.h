@@ -17,6 +17,9 @@
 #include <Gauss/Matrix.h>
 #include <Gauss/Vector4.h>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
 #include <functional>
 #include <initializer_list>
 
@@ -261,6 +264,8 @@ class TestbedContext
             bool                        showTiming  = false;
             bool                        fastTest    = false; // Skip slow buffer/texture creations to speed up test run
             bool                        updateRefs  = false; // Generate new reference images, this outputs images with the `.Ref.png` suffix instead of `.Result.png`.
+            bool                        golden      = false; // Diff result images asynchronously and evaluate them with perceptual metrics after all tests
+            float                       minSSIM     = 0.98f; // Minimum structural similarity for golden images that exceed the difference threshold
             LLGL::Extent2D              resolution;
             std::vector<std::string>    selectedTests;
 
@@ -355,6 +360,24 @@ class TestbedContext
             unsigned    count       = 0; // Number of different pixels;
         };
 
+        struct GoldenDiff
+        {
+            std::string         name;                   // Name of the result image.
+            const char*         testName    = nullptr;  // Name of the test that produced the result image.
+            std::vector<char>   resultFile;             // Encoded result image; read when the diff is scheduled since tests might overwrite it.
+            int                 scale       = 1;
+            DiffResult          result;
+            double              psnr        = 0.0;      // Peak signal-to-noise ratio in dB; infinite for identical images.
+            double              ssim        = 0.0;      // Mean structural similarity of the luminance.
+            double              duration    = 0.0;      // Time (in milliseconds) spent on decoding and diffing the images.
+        };
+
+        struct TestTiming
+        {
+            const char* name;
+            double      duration; // Time (in milliseconds) to run the test.
+        };
+
         struct SceneConstants
         {
             Gs::Matrix4f vpMatrix;
@@ -441,6 +464,16 @@ class TestbedContext
             VertFmt                     vertOutFmt  = VertFmtCount
         );
 
+        LLGL::Shader* LoadShaderFromFile(
+            const std::string&                          filename,
+            LLGL::ShaderType                            type,
+            const char*                                 entry,
+            const char*                                 profile,
+            const LLGL::ShaderMacro*                    defines,
+            const std::vector<LLGL::VertexAttribute>&   inputAttribs,
+            const std::vector<LLGL::VertexAttribute>&   outputAttribs = {}
+        );
+
         void SaveColorImage(const std::vector<LLGL::ColorRGBub>& image, const LLGL::Extent2D& extent, const std::string& name);
         void SaveDepthImage(const std::vector<float>& image, const LLGL::Extent2D& extent, const std::string& name);
         void SaveDepthImage(const std::vector<float>& image, const LLGL::Extent2D& extent, const std::string& name, float nearPlane, float farPlane);
@@ -452,6 +485,23 @@ class TestbedContext
         // Creates a heat-map image from the two input filenames and returns the highest difference pixel value. A negative value indicates an error.
         DiffResult DiffImages(const std::string& name, int threshold = 1, unsigned tolerance = 0, int scale = 1);
 
+        // Generates the heat-map image of the two input images and accumulates their per-pixel differences in 'result'.
+        static void DiffPixels(
+            const std::vector<LLGL::ColorRGBub>&    pixelsA,
+            const std::vector<LLGL::ColorRGBub>&    pixelsB,
+            std::vector<LLGL::ColorRGBAub>&         pixelsDiff,
+            DiffResult&                             result,
+            int                                     scale
+        );
+
+        // Schedules the diff of a result image for golden mode and returns an empty result. The diffs are evaluated by EvaluateGoldenDiffs().
+        DiffResult ScheduleGoldenDiff(const std::string& name, int threshold, unsigned tolerance, int scale);
+        void RunGoldenDiff(GoldenDiff& diff);
+        void WaitForGoldenDiffs();
+        void EvaluateGoldenDiffs();
+
+        void PrintTestTimings() const;
+
         void RecordTestResult(TestResult result, const char* name);
 
         bool QueryResultsWithTimeout(
@@ -467,10 +517,18 @@ class TestbedContext
 
     private:
 
-        bool                    loadingShadersFailed_ = false;
-        Histogram               histogram_;
-        LLGL::Report            report_;
-        LLGL::Log::LogHandle    reportHandle_;
+        bool                                        loadingShadersFailed_ = false;
+        Histogram                                   histogram_;
+        LLGL::Report                                report_;
+        LLGL::Log::LogHandle                        reportHandle_;
+
+        const char*                                 currentTest_    = nullptr;
+        std::vector<TestTiming>                     testTimings_;
+
+        std::vector<std::unique_ptr<GoldenDiff>>    goldenDiffs_;
+        std::mutex                                  goldenMutex_;
+        std::condition_variable                     goldenCondVar_;
+        std::size_t                                 goldenPending_  = 0;
 
 };
 
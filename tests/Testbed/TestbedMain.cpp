@@ -109,6 +109,7 @@ static void PrintHelpDocs()
     ListModuleIfAvailable("OpenGL",     "  gl, gl[VER], opengl, opengl[VER] ... OpenGL module with optional version, e.g. gl330\n");
     ListModuleIfAvailable("Metal",      "  mt, mtl, metal ..................... Metal module\n");
     ListModuleIfAvailable("Vulkan",     "  vk, vulkan ......................... Vulkan module\n");
+    ListModuleIfAvailable("Null",       "  null ............................... Null module (CPU only)\n");
 
     // Print help listing; NOTE: Also update 'k_knownSingleCharArgs' when adding new commands
     Log::Printf(
@@ -132,6 +133,7 @@ static void PrintHelpDocs()
         "  -t, --timing ....................... Print timing results\n"
         "  -v, --verbose ...................... Print more information\n"
         "  --amd .............................. Prefer AMD device\n"
+        "  --golden [=SSIM] ................... Diff images on worker threads with perceptual metrics; uses Null module by default\n"
         "  --intel ............................ Prefer Intel device\n"
         "  --nvidia ........................... Prefer NVIDIA device\n"
         "  --ref .............................. Use software device as reference\n"
@@ -177,6 +179,11 @@ static int GuardedMain(int argc, char* argv[])
             enabledModules.push_back(GetRendererModule(argv[i]));
     }
 
+    // Golden-image mode renders on the Null module by default, so image regressions can be checked without a GPU
+    const char* minSSIM = nullptr;
+    if (enabledModules.empty() && HasProgramArgument(argc, argv, "--golden", &minSSIM))
+        enabledModules.push_back("Null");
+
     if (enabledModules.empty())
     {
         std::vector<std::string> availableModules = RenderSystem::FindModules();
@@ -24,7 +24,15 @@ DECL_RITEST( ContainerUTF8String );
 DECL_RITEST( ContainerStringLiteral );
 DECL_RITEST( ContainerStringOperators );
 DECL_RITEST( ParseUtil );
+DECL_RITEST( ThreadPool );
+DECL_RITEST( TaskScheduler );
+DECL_RITEST( VirtualCommandChunkPool );
 DECL_RITEST( ImageConversions );
+DECL_RITEST( ImageCompression );
+DECL_RITEST( ImageBlit );
+DECL_RITEST( ImageMipChain );
+DECL_RITEST( ImageResize );
+DECL_RITEST( ImageDecompression );
 DECL_RITEST( ImageStrides );
 DECL_RITEST( FormatAttribs );
 
@@ -46,17 +54,21 @@ DECL_RITEST( FormatAttribs );
 DECL_TEST( CommandBufferSubmit );
 DECL_TEST( CommandBufferEncode );
 DECL_TEST( CommandBufferSecondary );
+DECL_TEST( CommandBufferSecondaryThreads );
 DECL_TEST( CommandBufferMultiThreading );
+DECL_TEST( FenceAsyncSubmission );
 
 // Resource tests
 DECL_TEST( BufferWriteAndRead );
 DECL_TEST( BufferMap );
+DECL_TEST( NullBufferMap );
 DECL_TEST( BufferFill );
 DECL_TEST( BufferUpdate );
 DECL_TEST( BufferCopy );
 DECL_TEST( BufferToTextureCopy );
 DECL_TEST( TextureCopy );
 DECL_TEST( TextureToBufferCopy );
+DECL_TEST( FramebufferCopy );
 DECL_TEST( TextureWriteAndRead );
 DECL_TEST( TextureTypes );
 DECL_TEST( RenderTargetNoAttachments );
@@ -66,6 +78,7 @@ DECL_TEST( MipMaps );
 DECL_TEST( PipelineCaching );
 DECL_TEST( ShaderErrors );
 DECL_TEST( SamplerBuffer );
+DECL_TEST( SpirvInterpreter );
 DECL_TEST( ByteBuffer );
 DECL_TEST( NativeHandle );
 DECL_TEST( BarrierReadAfterWrite );
@@ -79,6 +92,10 @@ DECL_TEST( BlendStates );
 DECL_TEST( DualSourceBlending );
 DECL_TEST( AlphaOnlyTexture );
 DECL_TEST( TriangleStripCutOff );
+DECL_TEST( Queries );
+DECL_TEST( VertexFetch );
+DECL_TEST( SamplerFiltering );
+DECL_TEST( CommandBufferOptimizer );
 DECL_TEST( TextureViews );
 DECL_TEST( TextureStrides );
 DECL_TEST( Uniforms );
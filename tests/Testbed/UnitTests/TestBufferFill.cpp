@@ -82,9 +82,51 @@ DEF_TEST( BufferFill )
         }
     }
 
+    // Create large buffer that exceeds the size at which backends might fill buffers with multiple threads
+    constexpr std::uint32_t buf3FillValue       = 0xA5A5A5A5;
+    constexpr std::uint64_t buf3SubRangeOffset  = 64*1024 + 16;
+    constexpr std::uint64_t buf3SubRangeSize    = 256*1024;
+
+    BufferDescriptor buf3Desc;
+    {
+        buf3Desc.size       = 1024*1024;
+        buf3Desc.bindFlags  = BindFlags::CopyDst;
+    }
+    CREATE_BUFFER(buf3, buf3Desc, "buf3{size=1MB}", nullptr);
+
+    // Fill entire buf3, then fill a sub-range with a different value
+    BEGIN();
+    {
+        cmdBuffer->FillBuffer(*buf3, 0, buf3FillValue);
+        cmdBuffer->FillBuffer(*buf3, buf3SubRangeOffset, fillData[3], buf3SubRangeSize);
+    }
+    END();
+
+    // Read buf3 feedback data and validate each word including the ones surrounding the sub-range
+    std::vector<std::uint32_t> buf3DataFeedback;
+    buf3DataFeedback.resize(static_cast<std::size_t>(buf3Desc.size / sizeof(std::uint32_t)));
+
+    renderer->ReadBuffer(*buf3, 0, buf3DataFeedback.data(), buf3Desc.size);
+
+    for_range(i, buf3DataFeedback.size())
+    {
+        const std::uint64_t buf3Off = i * sizeof(std::uint32_t);
+        const bool isInsideSubRange = (buf3Off >= buf3SubRangeOffset && buf3Off < buf3SubRangeOffset + buf3SubRangeSize);
+        const std::uint32_t expectedValue = (isInsideSubRange ? fillData[3] : buf3FillValue);
+        if (buf3DataFeedback[i] != expectedValue)
+        {
+            Log::Errorf(
+                "Mismatch between data of buffer 3 feedback data (offset = %" PRIu64 ") [0x%08X] and fill data [0x%08X]\n",
+                buf3Off, buf3DataFeedback[i], expectedValue
+            );
+            return TestResult::FailedMismatch;
+        }
+    }
+
     // Delete old buffers
     renderer->Release(*buf1);
     renderer->Release(*buf2);
+    renderer->Release(*buf3);
 
     return TestResult::Passed;
 }
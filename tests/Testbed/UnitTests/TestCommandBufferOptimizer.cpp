@@ -0,0 +1,541 @@
+/*
+ * TestCommandBufferOptimizer.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/IndirectArguments.h>
+#include <cstring>
+
+
+/*
+Records the same commands into a command buffer with the MultiSubmit flag and into one without it and compares their results.
+The Testbed enables RendererConfigurationOpenGL::optimizeCommandBuffers, so the OpenGL backend optimizes only the first command buffer.
+The commands contain redundant and overwritten viewports, scissors, and PSOs, indirect draws with contiguous arguments that can be merged,
+and indirect draws with gaps or different strides that must not be merged. Each draw covers its own cell with a solid color,
+and the arguments in each gap draw a forbidden cell, so every incorrectly removed or merged command changes the output.
+With OpenGL, a PSO with a static viewport is bound again after its viewport has been overridden by a dynamic one,
+which must not be removed as redundant since binding the PSO restores its static viewport.
+*/
+DEF_TEST( CommandBufferOptimizer )
+{
+    if (shaders[VSUnprojected] == nullptr || shaders[PSUnprojected] == nullptr)
+    {
+        Log::Errorf("Missing shaders for backend\n");
+        return TestResult::FailedErrors;
+    }
+
+    constexpr std::uint32_t cellSize    = 48;
+    constexpr std::uint32_t cellSpacing = 16;
+    constexpr std::uint32_t numColumns  = 10;
+    constexpr std::uint32_t numRows     = 3;
+
+    const Extent2D resolution = opt.resolution;
+    if (resolution.width < (cellSize + cellSpacing) * numColumns + cellSpacing ||
+        resolution.height < (cellSize + cellSpacing) * numRows + cellSpacing)
+    {
+        Log::Errorf("Resolution is too small to draw %ux%u cells of %ux%u pixels\n", numColumns, numRows, cellSize, cellSize);
+        return TestResult::FailedErrors;
+    }
+
+    const bool hasIndirectDrawing = caps.features.hasIndirectDrawing;
+
+    // Only OpenGL allows to override static viewports of a PSO with dynamic ones, e.g. Vulkan requires dynamic viewport states for SetViewport()
+    const int rendererID = renderer->GetRendererID();
+    const bool hasStaticViewportOverride = (rendererID == RendererID::OpenGL || rendererID == RendererID::OpenGLES);
+
+    // Rectangles that are drawn into the cells: Rows 0 to 2 test state commands, mergeable indirect draws, and non-mergeable indirect draws respectively
+    struct CellLocation
+    {
+        std::uint32_t column;
+        std::uint32_t row;
+    };
+
+    enum CellRect : std::uint32_t
+    {
+        RectInitialState = 0,
+        RectRedundantState,
+        RectOverwrittenState,
+        RectHalfScissor,
+        RectOverwrittenPSO,
+        RectMaskedPSO,
+        RectRestoredPSO,
+        RectShiftedViewport,
+        RectStaticViewport,
+        RectIndirect0,
+        RectIndirect1,
+        RectIndirect2,
+        RectMultiIndirect0,
+        RectMultiIndirect1,
+        RectMultiIndirect2,
+        RectIndexedIndirect0,
+        RectIndexedIndirect1,
+        RectIndexedIndirect2,
+        RectGap0,
+        RectGap1,
+        RectGap2,
+        RectStride32_0,
+        RectStride32_1,
+        RectStride16_0,
+        RectStride16_1,
+        RectForbidden,
+
+        NumRects,
+    };
+
+    const CellLocation rectLocations[NumRects] =
+    {
+        { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 7, 0 }, { 9, 0 },
+        { 0, 1 }, { 1, 1 }, { 2, 1 }, { 3, 1 }, { 4, 1 }, { 5, 1 }, { 6, 1 }, { 7, 1 }, { 8, 1 },
+        { 0, 2 }, { 1, 2 }, { 2, 2 }, { 3, 2 }, { 4, 2 }, { 5, 2 }, { 6, 2 },
+        { 9, 2 },
+    };
+
+    auto GetCellOrigin = [](const CellLocation& location) -> Offset2D
+    {
+        return Offset2D
+        {
+            static_cast<std::int32_t>(cellSpacing + location.column * (cellSize + cellSpacing)),
+            static_cast<std::int32_t>(cellSpacing + location.row    * (cellSize + cellSpacing)),
+        };
+    };
+
+    auto GetRectColor = [](std::uint32_t rect, std::uint8_t (&outColor)[4]) -> void
+    {
+        if (rect == RectForbidden)
+        {
+            outColor[0] = 255;
+            outColor[1] = 0;
+            outColor[2] = 255;
+        }
+        else
+        {
+            outColor[0] = static_cast<std::uint8_t>(64 + (rect *  53) % 192);
+            outColor[1] = static_cast<std::uint8_t>(64 + (rect *  97) % 192);
+            outColor[2] = static_cast<std::uint8_t>(64 + (rect * 151) % 192);
+        }
+        outColor[3] = 255;
+    };
+
+    // Generate pixel-aligned rectangles with 6 vertices each and a solid color
+    constexpr std::uint32_t numRectVertices = 6;
+
+    UnprojectedVertex vertices[NumRects * numRectVertices];
+
+    for_range(rect, NumRects)
+    {
+        const Offset2D origin = GetCellOrigin(rectLocations[rect]);
+
+        const float left    = static_cast<float>(origin.x           ) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float right   = static_cast<float>(origin.x + cellSize) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float top     = 1.0f - static_cast<float>(origin.y           ) / static_cast<float>(resolution.height) * 2.0f;
+        const float bottom  = 1.0f - static_cast<float>(origin.y + cellSize) / static_cast<float>(resolution.height) * 2.0f;
+
+        const float corners[numRectVertices][2] =
+        {
+            { left, top }, { right, top }, { left, bottom }, { left, bottom }, { right, top }, { right, bottom }
+        };
+
+        for_range(i, numRectVertices)
+        {
+            UnprojectedVertex& v = vertices[rect * numRectVertices + i];
+            v.position[0] = corners[i][0];
+            v.position[1] = corners[i][1];
+            GetRectColor(rect, v.color);
+        }
+    }
+
+    BufferDescriptor vertexBufDesc;
+    {
+        vertexBufDesc.size          = sizeof(vertices);
+        vertexBufDesc.bindFlags     = BindFlags::VertexBuffer;
+        vertexBufDesc.vertexAttribs = vertexFormats[VertFmtUnprojected].attributes;
+    }
+    CREATE_BUFFER(vertexBuf, vertexBufDesc, "optimizer.vertices", vertices);
+
+    // Create index buffer that maps each index to the same vertex for indexed indirect draws
+    std::uint32_t indices[NumRects * numRectVertices];
+    for_range(i, NumRects * numRectVertices)
+        indices[i] = i;
+
+    BufferDescriptor indexBufDesc;
+    {
+        indexBufDesc.size       = sizeof(indices);
+        indexBufDesc.bindFlags  = BindFlags::IndexBuffer;
+    }
+    CREATE_BUFFER(indexBuf, indexBufDesc, "optimizer.indices", indices);
+
+    // Create indirect arguments: Gaps between the arguments of non-mergeable draws are filled with the forbidden rectangle
+    auto MakeDrawArgs = [](std::uint32_t rect) -> DrawIndirectArguments
+    {
+        return DrawIndirectArguments{ numRectVertices, 1, rect * numRectVertices, 0 };
+    };
+
+    auto MakeDrawIndexedArgs = [](std::uint32_t rect) -> DrawIndexedIndirectArguments
+    {
+        return DrawIndexedIndirectArguments{ numRectVertices, 1, rect * numRectVertices, 0, 0 };
+    };
+
+    const DrawIndirectArguments drawArgs[] =
+    {
+        /*  0 */ MakeDrawArgs(RectIndirect0),
+        /*  1 */ MakeDrawArgs(RectIndirect1),
+        /*  2 */ MakeDrawArgs(RectIndirect2),
+        /*  3 */ MakeDrawArgs(RectMultiIndirect0),
+        /*  4 */ MakeDrawArgs(RectMultiIndirect1),
+        /*  5 */ MakeDrawArgs(RectMultiIndirect2),
+        /*  6 */ MakeDrawArgs(RectGap0),
+        /*  7 */ MakeDrawArgs(RectForbidden),
+        /*  8 */ MakeDrawArgs(RectGap1),
+        /*  9 */ MakeDrawArgs(RectGap2),
+        /* 10 */ MakeDrawArgs(RectForbidden),
+        /* 11 */ MakeDrawArgs(RectStride32_0),
+        /* 12 */ MakeDrawArgs(RectForbidden),
+        /* 13 */ MakeDrawArgs(RectStride32_1),
+        /* 14 */ MakeDrawArgs(RectForbidden),
+        /* 15 */ MakeDrawArgs(RectStride16_0),
+        /* 16 */ MakeDrawArgs(RectStride16_1),
+        /* 17 */ MakeDrawArgs(RectForbidden),
+        /* 18 */ MakeDrawArgs(RectForbidden),
+    };
+
+    const DrawIndexedIndirectArguments drawIndexedArgs[] =
+    {
+        /* 0 */ MakeDrawIndexedArgs(RectIndexedIndirect0),
+        /* 1 */ MakeDrawIndexedArgs(RectIndexedIndirect1),
+        /* 2 */ MakeDrawIndexedArgs(RectIndexedIndirect2),
+    };
+
+    constexpr std::uint32_t drawArgsStride          = sizeof(DrawIndirectArguments);
+    constexpr std::uint32_t drawIndexedArgsStride   = sizeof(DrawIndexedIndirectArguments);
+    constexpr std::uint64_t drawIndexedArgsOffset   = sizeof(drawArgs);
+
+    BufferDescriptor argsBufDesc;
+    {
+        argsBufDesc.size        = sizeof(drawArgs) + sizeof(drawIndexedArgs);
+        argsBufDesc.bindFlags   = BindFlags::IndirectBuffer;
+    }
+    CREATE_BUFFER_COND(hasIndirectDrawing, argsBuf, argsBufDesc, "optimizer.arguments", nullptr);
+
+    if (argsBuf != nullptr)
+    {
+        renderer->WriteBuffer(*argsBuf, 0, drawArgs, sizeof(drawArgs));
+        renderer->WriteBuffer(*argsBuf, drawIndexedArgsOffset, drawIndexedArgs, sizeof(drawIndexedArgs));
+    }
+
+    // Create PSOs with scissor test and one that only writes the red channel
+    GraphicsPipelineDescriptor psoDesc;
+    {
+        psoDesc.pipelineLayout                  = nullptr; // No resource bindings, therefore no pipeline layout
+        psoDesc.renderPass                      = swapChain->GetRenderPass();
+        psoDesc.vertexShader                    = shaders[VSUnprojected];
+        psoDesc.fragmentShader                  = shaders[PSUnprojected];
+        psoDesc.primitiveTopology               = PrimitiveTopology::TriangleList;
+        psoDesc.rasterizer.scissorTestEnabled   = true;
+    }
+    CREATE_GRAPHICS_PSO(pso, psoDesc, "psoOptimizer");
+    {
+        psoDesc.blend.targets[0].colorMask      = ColorMaskFlags::R;
+    }
+    CREATE_GRAPHICS_PSO(psoMasked, psoDesc, "psoOptimizerMasked");
+
+    // Create PSO with static viewport and scissor
+    const Viewport  fullViewport    = Viewport{ resolution };
+    const Scissor   fullScissor     = Scissor{ 0, 0, static_cast<std::int32_t>(resolution.width), static_cast<std::int32_t>(resolution.height) };
+
+    PipelineState* psoStatic = nullptr;
+    if (hasStaticViewportOverride)
+    {
+        psoDesc.blend.targets[0].colorMask  = ColorMaskFlags::All;
+        psoDesc.viewports                   = { fullViewport };
+        psoDesc.scissors                    = { fullScissor };
+        CREATE_GRAPHICS_PSO_EXT(psoStatic, psoDesc, "psoOptimizerStatic");
+    }
+
+    // Record the same commands into both command buffers; only the multi-submit command buffer is optimized
+    const Viewport  halfViewport    = Viewport{ 0.0f, 0.0f, static_cast<float>(resolution.width/2), static_cast<float>(resolution.height/2) };
+    const Viewport  shiftedViewport = Viewport{ static_cast<float>(cellSize + cellSpacing), 0.0f, static_cast<float>(resolution.width), static_cast<float>(resolution.height) };
+    const Offset2D  halfScissorPos  = GetCellOrigin(rectLocations[RectHalfScissor]);
+    const Scissor   halfScissor     = Scissor{ halfScissorPos.x, halfScissorPos.y, static_cast<std::int32_t>(cellSize/2), static_cast<std::int32_t>(cellSize) };
+
+    auto DrawRect = [](CommandBuffer& cmdBuf, std::uint32_t rect) -> void
+    {
+        cmdBuf.Draw(numRectVertices, rect * numRectVertices);
+    };
+
+    auto RecordCommands = [&](CommandBuffer& cmdBuf) -> Texture*
+    {
+        Texture* capture = nullptr;
+
+        cmdBuf.Begin();
+        {
+            cmdBuf.SetVertexBuffer(*vertexBuf);
+            cmdBuf.SetIndexBuffer(*indexBuf, Format::R32UInt);
+
+            cmdBuf.BeginRenderPass(*swapChain);
+            {
+                cmdBuf.Clear(ClearFlags::Color, bgColorDarkBlue);
+
+                // Initial state and the same state again, which is redundant
+                cmdBuf.SetPipelineState(*pso);
+                cmdBuf.SetViewport(fullViewport);
+                cmdBuf.SetScissor(fullScissor);
+                DrawRect(cmdBuf, RectInitialState);
+
+                cmdBuf.SetViewport(fullViewport);
+                cmdBuf.SetScissor(fullScissor);
+                cmdBuf.SetVertexBuffer(*vertexBuf);
+                DrawRect(cmdBuf, RectRedundantState);
+
+                // Viewport and scissor that are overwritten before the next draw
+                cmdBuf.SetScissor(halfScissor);
+                cmdBuf.SetViewport(halfViewport);
+                cmdBuf.SetScissor(fullScissor);
+                cmdBuf.SetViewport(fullViewport);
+                DrawRect(cmdBuf, RectOverwrittenState);
+
+                // Scissor that is different from the previous one must be kept
+                cmdBuf.SetScissor(halfScissor);
+                DrawRect(cmdBuf, RectHalfScissor);
+                cmdBuf.SetScissor(fullScissor);
+
+                // PSO that is overwritten without a draw in between, then a PSO that is used and replaced again
+                cmdBuf.SetPipelineState(*psoMasked);
+                cmdBuf.SetPipelineState(*pso);
+                DrawRect(cmdBuf, RectOverwrittenPSO);
+
+                cmdBuf.SetPipelineState(*psoMasked);
+                DrawRect(cmdBuf, RectMaskedPSO);
+
+                cmdBuf.SetPipelineState(*pso);
+                DrawRect(cmdBuf, RectRestoredPSO);
+
+                if (psoStatic != nullptr)
+                {
+                    // Dynamic viewport that shifts the rectangle into the next cell, then the same PSO again to restore its static viewport
+                    cmdBuf.SetPipelineState(*psoStatic);
+                    cmdBuf.SetViewport(shiftedViewport);
+                    DrawRect(cmdBuf, RectShiftedViewport);
+
+                    cmdBuf.SetPipelineState(*psoStatic);
+                    DrawRect(cmdBuf, RectStaticViewport);
+
+                    cmdBuf.SetPipelineState(*pso);
+                    cmdBuf.SetViewport(fullViewport);
+                }
+
+                if (argsBuf != nullptr)
+                {
+                    // Indirect draws with contiguous arguments that can be merged
+                    cmdBuf.DrawIndirect(*argsBuf, 0*drawArgsStride);
+                    cmdBuf.DrawIndirect(*argsBuf, 1*drawArgsStride);
+                    cmdBuf.DrawIndirect(*argsBuf, 2*drawArgsStride);
+
+                    cmdBuf.DrawIndirect(*argsBuf, 3*drawArgsStride, 2, drawArgsStride);
+                    cmdBuf.DrawIndirect(*argsBuf, 5*drawArgsStride);
+
+                    cmdBuf.DrawIndexedIndirect(*argsBuf, drawIndexedArgsOffset + 0*drawIndexedArgsStride);
+                    cmdBuf.DrawIndexedIndirect(*argsBuf, drawIndexedArgsOffset + 1*drawIndexedArgsStride);
+                    cmdBuf.DrawIndexedIndirect(*argsBuf, drawIndexedArgsOffset + 2*drawIndexedArgsStride);
+
+                    // Indirect draws with a gap between their arguments: The first two can be merged with a stride of two arguments, the third one cannot
+                    cmdBuf.DrawIndirect(*argsBuf, 6*drawArgsStride);
+                    cmdBuf.DrawIndirect(*argsBuf, 8*drawArgsStride);
+                    cmdBuf.DrawIndirect(*argsBuf, 9*drawArgsStride);
+
+                    // Indirect multi-draws whose arguments follow each other but with different strides
+                    cmdBuf.DrawIndirect(*argsBuf, 11*drawArgsStride, 2, 2*drawArgsStride);
+                    cmdBuf.DrawIndirect(*argsBuf, 15*drawArgsStride, 2, drawArgsStride);
+                }
+
+                capture = CaptureFramebuffer(cmdBuf, swapChain->GetColorFormat(), resolution);
+            }
+            cmdBuf.EndRenderPass();
+        }
+        cmdBuf.End();
+
+        return capture;
+    };
+
+    CommandBuffer* multiSubmitCmdBuffer = renderer->CreateCommandBuffer(CommandBufferFlags::MultiSubmit);
+    CommandBuffer* singleSubmitCmdBuffer = renderer->CreateCommandBuffer();
+
+    Texture* optimizedCapture   = RecordCommands(*multiSubmitCmdBuffer);
+    Texture* referenceCapture   = RecordCommands(*singleSubmitCmdBuffer);
+
+    // Submit the multi-submit command buffer twice to also replay the optimized commands
+    cmdQueue->Submit(*multiSubmitCmdBuffer);
+    cmdQueue->Submit(*singleSubmitCmdBuffer);
+    cmdQueue->Submit(*multiSubmitCmdBuffer);
+
+    // Read both captures
+    auto ReadCapture = [this, &resolution](Texture* capture) -> std::vector<std::uint8_t>
+    {
+        std::vector<std::uint8_t> image;
+        image.resize(resolution.width * resolution.height * 4);
+
+        MutableImageView dstImage;
+        {
+            dstImage.format     = ImageFormat::RGBA;
+            dstImage.dataType   = DataType::UInt8;
+            dstImage.data       = image.data();
+            dstImage.dataSize   = image.size();
+        }
+        renderer->ReadTexture(*capture, TextureRegion{ Offset3D{}, Extent3D{ resolution.width, resolution.height, 1 } }, dstImage);
+
+        return image;
+    };
+
+    const std::vector<std::uint8_t> optimizedImage = ReadCapture(optimizedCapture);
+    const std::vector<std::uint8_t> referenceImage = ReadCapture(referenceCapture);
+
+    // Evaluate expected colors in both images
+    TestResult result = TestResult::Passed;
+
+    auto EvaluatePixel = [&](const std::vector<std::uint8_t>& image, const char* imageName, const char* name, std::int32_t x, std::int32_t y, const std::uint8_t (&expectedColor)[4]) -> void
+    {
+        if (result != TestResult::Passed && !opt.greedy)
+            return;
+
+        const std::uint8_t* actualColor = &image[(y * resolution.width + x) * 4];
+        if (!IsRGBA8ubInThreshold(actualColor, expectedColor))
+        {
+            Log::Errorf(
+                "Mismatch between %s in %s image at (%d, %d) color [%02X %02X %02X %02X] and expected color [%02X %02X %02X %02X]\n",
+                name, imageName, x, y,
+                actualColor[0], actualColor[1], actualColor[2], actualColor[3],
+                expectedColor[0], expectedColor[1], expectedColor[2], expectedColor[3]
+            );
+            result = TestResult::FailedMismatch;
+        }
+    };
+
+    auto EncodeUNorm8 = [](float value) -> std::uint8_t
+    {
+        return static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+    };
+
+    const std::uint8_t clearColor[4] =
+    {
+        EncodeUNorm8(bgColorDarkBlue.color[0]),
+        EncodeUNorm8(bgColorDarkBlue.color[1]),
+        EncodeUNorm8(bgColorDarkBlue.color[2]),
+        EncodeUNorm8(bgColorDarkBlue.color[3]),
+    };
+
+    const char* rectNames[NumRects] =
+    {
+        "initial state",
+        "redundant viewport and scissor",
+        "overwritten viewport and scissor",
+        "half scissor",
+        "overwritten PSO",
+        "masked PSO",
+        "restored PSO",
+        "dynamic viewport after PSO with static viewport",
+        "PSO with static viewport bound again",
+        "indirect draw 0",
+        "indirect draw 1",
+        "indirect draw 2",
+        "indirect multi-draw 0",
+        "indirect multi-draw 1",
+        "indirect draw after multi-draw",
+        "indexed indirect draw 0",
+        "indexed indirect draw 1",
+        "indexed indirect draw 2",
+        "indirect draw before gap",
+        "indirect draw after gap",
+        "indirect draw after merged gap",
+        "indirect multi-draw with stride 32 [0]",
+        "indirect multi-draw with stride 32 [1]",
+        "indirect multi-draw with stride 16 [0]",
+        "indirect multi-draw with stride 16 [1]",
+        "forbidden indirect arguments",
+    };
+
+    auto EvaluateImage = [&](const std::vector<std::uint8_t>& image, const char* imageName) -> void
+    {
+        for_range(rect, NumRects)
+        {
+            const Offset2D origin = GetCellOrigin(rectLocations[rect]);
+            const std::int32_t centerX = origin.x + cellSize/2;
+            const std::int32_t centerY = origin.y + cellSize/2;
+
+            const bool isIndirect = (rect >= RectIndirect0 && rect <= RectStride16_1);
+            const bool isStaticViewport = (rect == RectShiftedViewport || rect == RectStaticViewport);
+            if (rect == RectForbidden || (isIndirect && argsBuf == nullptr) || (isStaticViewport && psoStatic == nullptr))
+            {
+                EvaluatePixel(image, imageName, rectNames[rect], centerX, centerY, clearColor);
+                continue;
+            }
+
+            std::uint8_t expectedColor[4];
+            GetRectColor(rect, expectedColor);
+
+            if (rect == RectHalfScissor)
+            {
+                // Right half of this cell is outside the scissor rectangle
+                EvaluatePixel(image, imageName, rectNames[rect], origin.x + cellSize/4, centerY, expectedColor);
+                EvaluatePixel(image, imageName, rectNames[rect], origin.x + cellSize*3/4, centerY, clearColor);
+            }
+            else if (rect == RectShiftedViewport)
+            {
+                // Dynamic viewport shifts this rectangle into the next cell, which is otherwise empty
+                EvaluatePixel(image, imageName, rectNames[rect], centerX, centerY, clearColor);
+                EvaluatePixel(image, imageName, rectNames[rect], centerX + static_cast<std::int32_t>(cellSize + cellSpacing), centerY, expectedColor);
+            }
+            else if (rect == RectMaskedPSO)
+            {
+                // Only the red channel is written by the masked PSO
+                const std::uint8_t maskedColor[4] = { expectedColor[0], clearColor[1], clearColor[2], clearColor[3] };
+                EvaluatePixel(image, imageName, rectNames[rect], centerX, centerY, maskedColor);
+            }
+            else
+                EvaluatePixel(image, imageName, rectNames[rect], centerX, centerY, expectedColor);
+        }
+    };
+
+    EvaluateImage(referenceImage, "reference");
+    EvaluateImage(optimizedImage, "multi-submit");
+
+    // Optimized commands must produce exactly the same image as the reference
+    std::uint32_t numDifferentPixels = 0;
+    std::uint32_t firstDifferentPixel = 0;
+
+    for_range(i, resolution.width * resolution.height)
+    {
+        if (::memcmp(&optimizedImage[i * 4], &referenceImage[i * 4], 4) != 0)
+        {
+            if (numDifferentPixels++ == 0)
+                firstDifferentPixel = i;
+        }
+    }
+
+    if (numDifferentPixels > 0)
+    {
+        Log::Errorf(
+            "Mismatch between multi-submit and reference image in %u pixels; first at (%u, %u)\n",
+            numDifferentPixels, firstDifferentPixel % resolution.width, firstDifferentPixel / resolution.width
+        );
+        result = TestResult::FailedMismatch;
+    }
+
+    // Delete old resources
+    renderer->Release(*referenceCapture);
+    renderer->Release(*optimizedCapture);
+    renderer->Release(*singleSubmitCmdBuffer);
+    renderer->Release(*multiSubmitCmdBuffer);
+    if (psoStatic != nullptr)
+        renderer->Release(*psoStatic);
+    renderer->Release(*psoMasked);
+    renderer->Release(*pso);
+    if (argsBuf != nullptr)
+        renderer->Release(*argsBuf);
+    renderer->Release(*indexBuf);
+    renderer->Release(*vertexBuf);
+
+    return result;
+}
+
@@ -0,0 +1,421 @@
+/*
+ * TestCommandBufferSecondaryThreads.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/Parse.h>
+
+
+/*
+Encodes secondary command buffers on worker threads while the main thread encodes the primary command buffer.
+The primary command buffer binds a 16-bit index buffer with a non-zero offset, and the secondary command buffers draw indexed
+without binding their own index buffer, i.e. they inherit the index buffer, its format, and its offset from the primary command buffer.
+The primary command buffer draws again after executing the secondary ones without re-binding its index buffer.
+All indices before the offset refer to a forbidden rectangle, so ignoring the offset or the index format draws into the wrong cell.
+If compute shaders are supported, another secondary command buffer binds a resource heap and dispatches with the compute PSO it inherits from
+the primary command buffer. The heap contains sampler and image buffers, which are only bound correctly with the buffer interfaces of that PSO.
+*/
+DEF_TEST( CommandBufferSecondaryThreads )
+{
+    if (shaders[VSUnprojected] == nullptr || shaders[PSUnprojected] == nullptr)
+    {
+        Log::Errorf("Missing shaders for backend\n");
+        return TestResult::FailedErrors;
+    }
+
+    // Vulkan secondary command buffers don't inherit any state from their primary command buffer (see TestCommandBufferSecondary.cpp)
+    if (renderer->GetRendererID() == RendererID::Vulkan)
+    {
+        if (opt.verbose)
+            Log::Printf("Secondary command buffers don't inherit index buffers\n");
+        return TestResult::Skipped;
+    }
+
+    constexpr std::uint32_t cellSize            = 64;
+    constexpr std::uint32_t cellSpacing         = 16;
+    constexpr std::uint32_t numSecondaryBuffers = 2;
+
+    // Rectangle 0 is drawn by the primary command buffer before the secondary ones, rectangles 1 to 4 by the secondary ones, and rectangle 5 after them
+    enum CellRect : std::uint32_t
+    {
+        RectPrimaryBefore = 0,
+        RectSecondary0A,
+        RectSecondary0B,
+        RectSecondary1A,
+        RectSecondary1B,
+        RectPrimaryAfter,
+        RectForbidden,
+
+        NumRects,
+    };
+
+    const Extent2D resolution = opt.resolution;
+    if (resolution.width < (cellSize + cellSpacing) * NumRects + cellSpacing || resolution.height < cellSize + cellSpacing * 2)
+    {
+        Log::Errorf("Resolution is too small to draw %u cells of %ux%u pixels\n", static_cast<unsigned>(NumRects), cellSize, cellSize);
+        return TestResult::FailedErrors;
+    }
+
+    const std::uint8_t rectColors[NumRects][4] =
+    {
+        { 255,  64,  64, 255 },
+        {  64, 255,  64, 255 },
+        {  64,  64, 255, 255 },
+        { 255, 255,  64, 255 },
+        {  64, 255, 255, 255 },
+        { 255, 160,  32, 255 },
+        { 255,   0, 255, 255 }, // Forbidden
+    };
+
+    auto GetCellOrigin = [](std::uint32_t rect) -> Offset2D
+    {
+        return Offset2D{ static_cast<std::int32_t>(cellSpacing + rect * (cellSize + cellSpacing)), static_cast<std::int32_t>(cellSpacing) };
+    };
+
+    // Generate pixel-aligned rectangles with 4 vertices each
+    constexpr std::uint32_t numRectVertices = 4;
+    constexpr std::uint32_t numRectIndices  = 6;
+
+    UnprojectedVertex vertices[NumRects * numRectVertices];
+
+    for_range(rect, NumRects)
+    {
+        const Offset2D origin = GetCellOrigin(rect);
+
+        const float left    = static_cast<float>(origin.x           ) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float right   = static_cast<float>(origin.x + cellSize) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float top     = 1.0f - static_cast<float>(origin.y           ) / static_cast<float>(resolution.height) * 2.0f;
+        const float bottom  = 1.0f - static_cast<float>(origin.y + cellSize) / static_cast<float>(resolution.height) * 2.0f;
+
+        const float corners[numRectVertices][2] = { { left, top }, { right, top }, { left, bottom }, { right, bottom } };
+
+        for_range(i, numRectVertices)
+        {
+            UnprojectedVertex& v = vertices[rect * numRectVertices + i];
+            v.position[0] = corners[i][0];
+            v.position[1] = corners[i][1];
+            for_range(c, 4)
+                v.color[c] = rectColors[rect][c];
+        }
+    }
+
+    BufferDescriptor vertexBufDesc;
+    {
+        vertexBufDesc.size          = sizeof(vertices);
+        vertexBufDesc.bindFlags     = BindFlags::VertexBuffer;
+        vertexBufDesc.vertexAttribs = vertexFormats[VertFmtUnprojected].attributes;
+    }
+    CREATE_BUFFER(vertexBuf, vertexBufDesc, "secondaryThreads.vertices", vertices);
+
+    // Generate 16-bit indices: The first block before the index buffer offset only refers to the forbidden rectangle
+    constexpr std::uint32_t numDrawnRects   = RectForbidden;
+    constexpr std::uint32_t numIndices      = numDrawnRects * numRectIndices * 2;
+    constexpr std::uint64_t indexOffset     = numDrawnRects * numRectIndices * sizeof(std::uint16_t);
+
+    const std::uint16_t rectIndices[numRectIndices] = { 0, 1, 2, 2, 1, 3 };
+
+    std::uint16_t indices[numIndices];
+    for_range(i, numIndices)
+    {
+        const std::uint32_t rect = (i < numIndices/2 ? static_cast<std::uint32_t>(RectForbidden) : (i - numIndices/2) / numRectIndices);
+        indices[i] = static_cast<std::uint16_t>(rect * numRectVertices + rectIndices[i % numRectIndices]);
+    }
+
+    BufferDescriptor indexBufDesc;
+    {
+        indexBufDesc.size       = sizeof(indices);
+        indexBufDesc.bindFlags  = BindFlags::IndexBuffer;
+    }
+    CREATE_BUFFER(indexBuf, indexBufDesc, "secondaryThreads.indices", indices);
+
+    GraphicsPipelineDescriptor psoDesc;
+    {
+        psoDesc.pipelineLayout      = nullptr; // No resource bindings, therefore no pipeline layout
+        psoDesc.renderPass          = swapChain->GetRenderPass();
+        psoDesc.vertexShader        = shaders[VSUnprojected];
+        psoDesc.fragmentShader      = shaders[PSUnprojected];
+        psoDesc.primitiveTopology   = PrimitiveTopology::TriangleList;
+    }
+    CREATE_GRAPHICS_PSO(pso, psoDesc, "psoSecondaryThreads");
+
+    // Create compute PSO and resource heap for the secondary command buffer that inherits the PSO (see TestSamplerBuffer.cpp)
+    const bool hasComputeCase =
+    (
+        caps.features.hasComputeShaders &&
+        shaders[CSSamplerBuffer] != nullptr &&
+        renderer->GetRendererID() != RendererID::Metal
+    );
+
+    constexpr std::uint32_t numEntries = 2;
+    const std::int32_t initialTypedValues[numEntries]       = { 42, 600 };
+    const std::int32_t initialStructValues[numEntries*2]    = { 60, -12, 99, 16 };
+    const std::int32_t multipliers[3]                       = { 2, 3, 4 };
+
+    PipelineLayout* computePSOLayout = nullptr;
+    PipelineState*  computePSO       = nullptr;
+    ResourceHeap*   computeResHeap   = nullptr;
+
+    if (hasComputeCase)
+    {
+        computePSOLayout = renderer->CreatePipelineLayout(
+            Parse(
+                "heap{"
+                "  cbuffer(Config@4):comp,"
+                "  tbuffer(inTypedBuffer@0):comp,"
+                "  rwtbuffer(outTypedBuffer@1):comp,"
+                "  buffer(inStructBuffer@2):comp,"
+                "  rwbuffer(outStructBuffer@3):comp,"
+                "},"
+            )
+        );
+
+        ComputePipelineDescriptor computePSODesc;
+        {
+            computePSODesc.computeShader    = shaders[CSSamplerBuffer];
+            computePSODesc.pipelineLayout   = computePSOLayout;
+        }
+        CREATE_COMPUTE_PSO_EXT(computePSO, computePSODesc, "psoSecondaryThreadsCompute");
+    }
+
+    BufferDescriptor typedBufDesc;
+    {
+        typedBufDesc.size       = sizeof(initialTypedValues);
+        typedBufDesc.bindFlags  = BindFlags::Sampled;
+        typedBufDesc.format     = Format::R32SInt;
+    }
+    CREATE_BUFFER_COND(hasComputeCase, inTypedBuffer, typedBufDesc, "secondaryThreads.inTypedBuffer", initialTypedValues);
+
+    typedBufDesc.bindFlags = BindFlags::Storage;
+    CREATE_BUFFER_COND(hasComputeCase, outTypedBuffer, typedBufDesc, "secondaryThreads.outTypedBuffer", nullptr);
+
+    BufferDescriptor structBufDesc;
+    {
+        structBufDesc.size      = sizeof(initialStructValues);
+        structBufDesc.bindFlags = BindFlags::Sampled;
+        structBufDesc.stride    = sizeof(std::int32_t)*2;
+    }
+    CREATE_BUFFER_COND(hasComputeCase, inStructBuffer, structBufDesc, "secondaryThreads.inStructBuffer", initialStructValues);
+
+    structBufDesc.bindFlags = BindFlags::Storage;
+    CREATE_BUFFER_COND(hasComputeCase, outStructBuffer, structBufDesc, "secondaryThreads.outStructBuffer", nullptr);
+
+    BufferDescriptor configBufDesc;
+    {
+        configBufDesc.size      = sizeof(multipliers);
+        configBufDesc.bindFlags = BindFlags::ConstantBuffer;
+    }
+    CREATE_BUFFER_COND(hasComputeCase, configBuffer, configBufDesc, "secondaryThreads.config", multipliers);
+
+    if (hasComputeCase)
+        computeResHeap = renderer->CreateResourceHeap(computePSOLayout, { configBuffer, inTypedBuffer, outTypedBuffer, inStructBuffer, outStructBuffer });
+
+    auto DrawRect = [](CommandBuffer& cmdBuf, std::uint32_t rect) -> void
+    {
+        cmdBuf.DrawIndexed(numRectIndices, rect * numRectIndices);
+    };
+
+    // Create secondary command buffers on the main thread, but encode them on worker threads
+    CommandBuffer* secondaryCmdBuffers[numSecondaryBuffers] = {};
+
+    for_range(i, numSecondaryBuffers)
+    {
+        CommandBufferDescriptor cmdBufferDesc;
+        {
+            cmdBufferDesc.flags             = CommandBufferFlags::Secondary;
+            cmdBufferDesc.numNativeBuffers  = 1;
+            cmdBufferDesc.renderPass        = swapChain->GetRenderPass(); // Continue rendering into render pass of primary command buffer
+        }
+        secondaryCmdBuffers[i] = renderer->CreateCommandBuffer(cmdBufferDesc);
+    }
+
+    CommandBuffer* computeCmdBuffer = nullptr;
+    if (hasComputeCase)
+        computeCmdBuffer = renderer->CreateCommandBuffer(CommandBufferFlags::Secondary);
+
+    std::thread workerThreads[numSecondaryBuffers];
+
+    for_range(i, numSecondaryBuffers)
+    {
+        workerThreads[i] = std::thread(
+            [pso, &DrawRect](CommandBuffer* secondaryCmdBuffer, std::uint32_t i)
+            {
+                secondaryCmdBuffer->Begin();
+                {
+                    // Draw indexed without binding an index buffer
+                    secondaryCmdBuffer->SetPipelineState(*pso);
+                    DrawRect(*secondaryCmdBuffer, RectSecondary0A + i*2);
+                    DrawRect(*secondaryCmdBuffer, RectSecondary0B + i*2);
+                }
+                secondaryCmdBuffer->End();
+            },
+            secondaryCmdBuffers[i],
+            static_cast<std::uint32_t>(i)
+        );
+    }
+
+    std::thread computeWorkerThread;
+    if (computeCmdBuffer != nullptr)
+    {
+        computeWorkerThread = std::thread(
+            [computeCmdBuffer, computeResHeap]()
+            {
+                computeCmdBuffer->Begin();
+                {
+                    // Bind resource heap and dispatch without binding a PSO
+                    computeCmdBuffer->SetResourceHeap(*computeResHeap);
+                    computeCmdBuffer->Dispatch(numEntries, 1, 1);
+                }
+                computeCmdBuffer->End();
+            }
+        );
+    }
+
+    // Encode primary command buffer concurrently to the secondary ones until they are executed
+    Texture* readbackTex = nullptr;
+
+    BEGIN();
+    {
+        cmdBuffer->SetVertexBuffer(*vertexBuf);
+        cmdBuffer->SetIndexBuffer(*indexBuf, Format::R16UInt, indexOffset);
+        cmdBuffer->BeginRenderPass(*swapChain);
+        {
+            cmdBuffer->Clear(ClearFlags::Color, bgColorDarkBlue);
+            cmdBuffer->SetViewport(resolution);
+            cmdBuffer->SetPipelineState(*pso);
+            DrawRect(*cmdBuffer, RectPrimaryBefore);
+
+            for (std::thread& t : workerThreads)
+                t.join();
+
+            for (CommandBuffer* secondaryCmdBuffer : secondaryCmdBuffers)
+                cmdBuffer->Execute(*secondaryCmdBuffer);
+
+            // Draw again with the index buffer of the primary command buffer
+            cmdBuffer->SetPipelineState(*pso);
+            DrawRect(*cmdBuffer, RectPrimaryAfter);
+
+            readbackTex = CaptureFramebuffer(*cmdBuffer, swapChain->GetColorFormat(), resolution);
+        }
+        cmdBuffer->EndRenderPass();
+
+        if (computeCmdBuffer != nullptr)
+        {
+            computeWorkerThread.join();
+            cmdBuffer->SetPipelineState(*computePSO);
+            cmdBuffer->Execute(*computeCmdBuffer);
+        }
+    }
+    END();
+
+    // Read entire framebuffer capture
+    std::vector<std::uint8_t> readbackImage;
+    readbackImage.resize(resolution.width * resolution.height * 4);
+
+    MutableImageView dstImage;
+    {
+        dstImage.format     = ImageFormat::RGBA;
+        dstImage.dataType   = DataType::UInt8;
+        dstImage.data       = readbackImage.data();
+        dstImage.dataSize   = readbackImage.size();
+    }
+    renderer->ReadTexture(*readbackTex, TextureRegion{ Offset3D{}, Extent3D{ resolution.width, resolution.height, 1 } }, dstImage);
+
+    // Evaluate center of each cell; the forbidden cell must keep the clear color
+    auto EncodeUNorm8 = [](float value) -> std::uint8_t
+    {
+        return static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+    };
+
+    const std::uint8_t clearColor[4] =
+    {
+        EncodeUNorm8(bgColorDarkBlue.color[0]),
+        EncodeUNorm8(bgColorDarkBlue.color[1]),
+        EncodeUNorm8(bgColorDarkBlue.color[2]),
+        EncodeUNorm8(bgColorDarkBlue.color[3]),
+    };
+
+    const char* rectNames[NumRects] =
+    {
+        "primary draw before secondary command buffers",
+        "first draw of secondary command buffer 0",
+        "second draw of secondary command buffer 0",
+        "first draw of secondary command buffer 1",
+        "second draw of secondary command buffer 1",
+        "primary draw after secondary command buffers",
+        "indices before index buffer offset",
+    };
+
+    TestResult result = TestResult::Passed;
+
+    for_range(rect, NumRects)
+    {
+        const Offset2D origin = GetCellOrigin(rect);
+        const std::int32_t x = origin.x + cellSize/2;
+        const std::int32_t y = origin.y + cellSize/2;
+
+        const std::uint8_t* expectedColor = (rect == RectForbidden ? clearColor : rectColors[rect]);
+        const std::uint8_t* actualColor = &readbackImage[(y * resolution.width + x) * 4];
+
+        if (!IsRGBA8ubInThreshold(actualColor, expectedColor))
+        {
+            Log::Errorf(
+                "Mismatch between %s at (%d, %d) color [%02X %02X %02X %02X] and expected color [%02X %02X %02X %02X]\n",
+                rectNames[rect], x, y,
+                actualColor[0], actualColor[1], actualColor[2], actualColor[3],
+                expectedColor[0], expectedColor[1], expectedColor[2], expectedColor[3]
+            );
+            result = TestResult::FailedMismatch;
+            if (!opt.greedy)
+                break;
+        }
+    }
+
+    // Evaluate compute results of the secondary command buffer that inherits the PSO
+    if (hasComputeCase && (result == TestResult::Passed || opt.greedy))
+    {
+        std::int32_t typedResults[numEntries] = {};
+        renderer->ReadBuffer(*outTypedBuffer, 0, typedResults, sizeof(typedResults));
+
+        std::int32_t structResults[numEntries*2] = {};
+        renderer->ReadBuffer(*outStructBuffer, 0, structResults, sizeof(structResults));
+
+        for_range(i, numEntries)
+        {
+            const std::int32_t expectedTypedValue   = initialTypedValues[i] * multipliers[0];
+            const std::int32_t expectedStructValueA = initialStructValues[i*2    ] * multipliers[1];
+            const std::int32_t expectedStructValueB = initialStructValues[i*2 + 1] * multipliers[2];
+            if (typedResults[i] != expectedTypedValue || structResults[i*2] != expectedStructValueA || structResults[i*2 + 1] != expectedStructValueB)
+            {
+                Log::Errorf(
+                    "Mismatch between compute results [%u] of secondary command buffer with inherited PSO (typed=%d, a=%d, b=%d) and expected values (typed=%d, a=%d, b=%d)\n",
+                    i, typedResults[i], structResults[i*2], structResults[i*2 + 1], expectedTypedValue, expectedStructValueA, expectedStructValueB
+                );
+                result = TestResult::FailedMismatch;
+                break;
+            }
+        }
+    }
+
+    // Delete old resources
+    SAFE_RELEASE(computeCmdBuffer);
+    SAFE_RELEASE(computeResHeap);
+    SAFE_RELEASE(configBuffer);
+    SAFE_RELEASE(outStructBuffer);
+    SAFE_RELEASE(inStructBuffer);
+    SAFE_RELEASE(outTypedBuffer);
+    SAFE_RELEASE(inTypedBuffer);
+    SAFE_RELEASE(computePSO);
+    SAFE_RELEASE(computePSOLayout);
+    renderer->Release(*readbackTex);
+    for (CommandBuffer* secondaryCmdBuffer : secondaryCmdBuffers)
+        renderer->Release(*secondaryCmdBuffer);
+    renderer->Release(*pso);
+    renderer->Release(*indexBuf);
+    renderer->Release(*vertexBuf);
+
+    return result;
+}
+
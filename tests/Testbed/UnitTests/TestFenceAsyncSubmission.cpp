@@ -0,0 +1,123 @@
+/*
+ * TestFenceAsyncSubmission.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <atomic>
+
+
+/*
+Tests fences of the Null renderer with asynchronous submission, i.e. command buffers are executed on a worker thread.
+The main thread submits command buffers and fences while another thread waits for the same fence with a timeout.
+*/
+DEF_TEST( FenceAsyncSubmission )
+{
+    if (renderer->GetRendererID() != RendererID::Null)
+        return TestResult::Skipped;
+
+    constexpr unsigned      numSubmissions  = 32;
+    constexpr std::uint64_t bufferSize      = 4*1024*1024;
+    constexpr std::uint64_t waitTimeout     = 1000000;      // 1 ms
+    constexpr std::uint64_t finalTimeout    = 10000000000;  // 10 s
+
+    // Load separate Null renderer that executes command buffers on a worker thread
+    RendererConfigurationNull cfgNull;
+    cfgNull.asyncSubmission = true;
+
+    RenderSystemDescriptor asyncRendererDesc;
+    {
+        asyncRendererDesc.moduleName            = "Null";
+        asyncRendererDesc.rendererConfig        = &cfgNull;
+        asyncRendererDesc.rendererConfigSize    = sizeof(cfgNull);
+    }
+    Report report;
+    RenderSystemPtr asyncRenderer = RenderSystem::Load(asyncRendererDesc, &report);
+    if (!asyncRenderer)
+    {
+        Log::Errorf("Failed to load Null renderer with asynchronous submission: %s", report.GetText());
+        return TestResult::FailedErrors;
+    }
+
+    CommandQueue* asyncCmdQueue = asyncRenderer->GetCommandQueue();
+
+    BufferDescriptor bufDesc;
+    {
+        bufDesc.size        = bufferSize;
+        bufDesc.bindFlags   = BindFlags::CopyDst;
+    }
+    Buffer* buf = asyncRenderer->CreateBuffer(bufDesc);
+
+    CommandBuffer* asyncCmdBuffer = asyncRenderer->CreateCommandBuffer();
+    Fence* fence = asyncRenderer->CreateFence();
+
+    // Wait for the fence on a separate thread while the main thread keeps submitting new fence values
+    std::atomic<bool> isSubmitting{ true };
+    std::atomic<unsigned> numCompletedWaits{ 0 };
+
+    std::thread waitThread{
+        [asyncCmdQueue, fence, &isSubmitting, &numCompletedWaits]()
+        {
+            while (isSubmitting.load())
+            {
+                if (asyncCmdQueue->WaitFence(*fence, waitTimeout))
+                    ++numCompletedWaits;
+            }
+        }
+    };
+
+    for_range(i, numSubmissions)
+    {
+        asyncCmdBuffer->Begin();
+        {
+            asyncCmdBuffer->FillBuffer(*buf, 0, i);
+        }
+        asyncCmdBuffer->End();
+
+        asyncCmdQueue->Submit(*asyncCmdBuffer);
+        asyncCmdQueue->Submit(*fence);
+    }
+
+    // Fence must be signaled for the last submission within the final timeout
+    const bool isFenceSignaled = asyncCmdQueue->WaitFence(*fence, finalTimeout);
+
+    isSubmitting = false;
+    waitThread.join();
+
+    if (opt.verbose)
+        Log::Printf("Completed %u fence waits on separate thread\n", numCompletedWaits.load());
+
+    TestResult result = TestResult::Passed;
+
+    if (!isFenceSignaled)
+    {
+        Log::Errorf("Fence was not signaled within %" PRIu64 " ns after %u submissions\n", finalTimeout, numSubmissions);
+        result = TestResult::FailedErrors;
+    }
+    else
+    {
+        // Buffer must contain the value of the last submission once its fence has been signaled
+        std::uint32_t feedback[2] = {};
+        asyncRenderer->ReadBuffer(*buf, bufferSize - sizeof(feedback), feedback, sizeof(feedback));
+
+        if (feedback[0] != numSubmissions - 1 || feedback[1] != numSubmissions - 1)
+        {
+            Log::Errorf(
+                "Mismatch between buffer feedback [%u, %u] and value of last submission [%u]\n",
+                feedback[0], feedback[1], numSubmissions - 1
+            );
+            result = TestResult::FailedMismatch;
+        }
+    }
+
+    // Release resources and unload separate renderer
+    asyncRenderer->Release(*fence);
+    asyncRenderer->Release(*asyncCmdBuffer);
+    asyncRenderer->Release(*buf);
+    RenderSystem::Unload(std::move(asyncRenderer));
+
+    return result;
+}
+
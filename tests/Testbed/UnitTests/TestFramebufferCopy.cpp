@@ -0,0 +1,122 @@
+/*
+ * TestFramebufferCopy.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/ForRange.h>
+
+
+/*
+Tests the CopyTextureFromFramebuffer() function by clearing the swap-chain twice within the same render pass
+and copying a large region of the framebuffer after each clear into the left and right half of a texture.
+There is no rendering except for the clear commands. The values are only validated via ReadTexture().
+*/
+DEF_TEST( FramebufferCopy )
+{
+    const ClearValue clearValues[2] =
+    {
+        ClearValue{ 0.2f, 0.4f, 0.8f, 1 }, // Blue
+        ClearValue{ 1.0f, 0.6f, 0.0f, 1 }, // Orange
+    };
+
+    // Create destination texture that is large enough to be copied with multiple threads
+    constexpr std::uint32_t halfWidth   = 256;
+    constexpr std::uint32_t height      = 256;
+
+    const Extent2D resolution = swapChain->GetResolution();
+    if (resolution.width < halfWidth + 16 || resolution.height < height + 8)
+    {
+        Log::Errorf("Swap-chain resolution is too small to copy %ux%u framebuffer region\n", halfWidth, height);
+        return TestResult::FailedErrors;
+    }
+
+    TextureDescriptor dstTexDesc;
+    {
+        dstTexDesc.bindFlags    = BindFlags::Sampled | BindFlags::CopyDst;
+        dstTexDesc.format       = swapChain->GetColorFormat();
+        dstTexDesc.extent       = Extent3D{ halfWidth * 2, height, 1 };
+        dstTexDesc.miscFlags    = MiscFlags::NoInitialData;
+        dstTexDesc.mipLevels    = 1;
+    }
+    CREATE_TEXTURE(dstTex, dstTexDesc, "dstTex{framebufferCopy}", nullptr);
+
+    // Copy framebuffer region with source offset into left half and without source offset into right half
+    const TextureRegion dstRegions[2] =
+    {
+        TextureRegion{ Offset3D{ 0,                       0, 0 }, Extent3D{ halfWidth, height, 1 } },
+        TextureRegion{ Offset3D{ std::int32_t(halfWidth), 0, 0 }, Extent3D{ halfWidth, height, 1 } },
+    };
+    const Offset2D srcOffsets[2] = { Offset2D{ 16, 8 }, Offset2D{ 0, 0 } };
+
+    BEGIN();
+    {
+        cmdBuffer->BeginRenderPass(*swapChain);
+        {
+            for_range(i, 2)
+            {
+                cmdBuffer->Clear(ClearFlags::Color, clearValues[i]);
+                cmdBuffer->CopyTextureFromFramebuffer(*dstTex, dstRegions[i], srcOffsets[i]);
+            }
+        }
+        cmdBuffer->EndRenderPass();
+    }
+    END();
+
+    // Read results from destination texture
+    std::vector<std::uint8_t> readbackImage;
+    readbackImage.resize(halfWidth * 2 * height * 4);
+
+    MutableImageView dstImage;
+    {
+        dstImage.format     = ImageFormat::RGBA;
+        dstImage.dataType   = DataType::UInt8;
+        dstImage.data       = readbackImage.data();
+        dstImage.dataSize   = readbackImage.size();
+    }
+    renderer->ReadTexture(*dstTex, TextureRegion{ Offset3D{}, dstTexDesc.extent }, dstImage);
+
+    // Evaluate results
+    TestResult result = TestResult::Passed;
+
+    for_range(i, 2)
+    {
+        const std::uint8_t expectedColor[4] =
+        {
+            static_cast<std::uint8_t>(clearValues[i].color[0] * 255.0f),
+            static_cast<std::uint8_t>(clearValues[i].color[1] * 255.0f),
+            static_cast<std::uint8_t>(clearValues[i].color[2] * 255.0f),
+            static_cast<std::uint8_t>(clearValues[i].color[3] * 255.0f),
+        };
+
+        for (std::uint32_t y = 0; y < height && result == TestResult::Passed; ++y)
+        {
+            for_range(x, halfWidth)
+            {
+                const std::uint8_t* actualColor = &readbackImage[((y * halfWidth * 2) + (i * halfWidth) + x) * 4];
+                if (!IsRGBA8ubInThreshold(actualColor, expectedColor))
+                {
+                    Log::Errorf(
+                        "Mismatch between framebuffer copy [%u] at (%u, %u) color [%02X %02X %02X %02X] and clear value [%02X %02X %02X %02X]\n",
+                        i, x, y,
+                        actualColor[0], actualColor[1], actualColor[2], actualColor[3],
+                        expectedColor[0], expectedColor[1], expectedColor[2], expectedColor[3]
+                    );
+                    result = TestResult::FailedMismatch;
+                    break;
+                }
+            }
+        }
+
+        if (result != TestResult::Passed && !opt.greedy)
+            break;
+    }
+
+    // Delete old resources
+    renderer->Release(*dstTex);
+
+    return result;
+}
+
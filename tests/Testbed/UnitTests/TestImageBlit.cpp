@@ -0,0 +1,146 @@
+/*
+ * TestImageBlit.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/Image.h>
+#include <LLGL/Timer.h>
+#include <vector>
+#include <string.h>
+
+
+// This test packs sprites into an atlas with batched and single blit operations and compares the results, including overlapping regions within the same image.
+DEF_RITEST( ImageBlit )
+{
+    // Generate sprites with distinct pixel values
+    const int numSprites = 600;
+    std::vector<Image> sprites;
+    sprites.reserve(numSprites);
+
+    for (int i = 0; i < numSprites; ++i)
+    {
+        const Extent3D extent{ 8u + static_cast<std::uint32_t>(i % 7) * 3u, 6u + static_cast<std::uint32_t>(i % 5) * 4u, 1u };
+        sprites.emplace_back(extent, ImageFormat::RGBA, DataType::UInt8);
+        std::uint8_t* pixels = static_cast<std::uint8_t*>(sprites.back().GetData());
+        for (std::uint32_t j = 0; j < sprites.back().GetDataSize(); ++j)
+            pixels[j] = static_cast<std::uint8_t>(i * 31 + j * 7);
+    }
+
+    // Arrange sprites in rows of the atlas; the last sprites exceed the atlas boundary and are clipped
+    const Extent3D atlasExtent{ 512, 512, 1 };
+    std::vector<ImageBlitRegion> regions;
+    regions.reserve(numSprites + 2);
+
+    auto AddRegion = [&regions](const Image& srcImage, const Offset3D& srcOffset, const Extent3D& srcExtent, const Offset3D& dstOffset)
+    {
+        ImageBlitRegion region;
+        {
+            region.srcImage         = &srcImage;
+            region.srcRegionOffset  = srcOffset;
+            region.srcRegionExtent  = srcExtent;
+            region.dstRegionOffset  = dstOffset;
+        }
+        regions.push_back(region);
+    };
+
+    std::int32_t x = 0, y = 0, rowHeight = 0;
+    for (const Image& sprite : sprites)
+    {
+        const Extent3D& extent = sprite.GetExtent();
+        if (x + static_cast<std::int32_t>(extent.width) > static_cast<std::int32_t>(atlasExtent.width))
+        {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        AddRegion(sprite, Offset3D{ 0, 0, 0 }, extent, Offset3D{ x, y, 0 });
+        x += static_cast<std::int32_t>(extent.width);
+        rowHeight = std::max(rowHeight, static_cast<std::int32_t>(extent.height));
+    }
+
+    // Add regions with negative offsets and horizontally adjacent parts of the same sprite, which are merged into a single region
+    const Image& largeSprite = sprites[numSprites - 1];
+    AddRegion(largeSprite, Offset3D{ 0, 0, 0 }, Extent3D{ 4, 8, 1 }, Offset3D{ -2, -3, 0 });
+    AddRegion(largeSprite, Offset3D{ 4, 0, 0 }, Extent3D{ 6, 8, 1 }, Offset3D{  2, -3, 0 });
+
+    const ColorRGBAf clearColor{ 0.0f, 0.0f, 0.0f, 0.0f };
+
+    Image expectedAtlas{ atlasExtent, ImageFormat::RGBA, DataType::UInt8, clearColor };
+    for (const ImageBlitRegion& region : regions)
+        expectedAtlas.Blit(region.dstRegionOffset, *region.srcImage, region.srcRegionOffset, region.srcRegionExtent);
+
+    auto TestBatchedBlit = [&](unsigned threadCount) -> TestResult
+    {
+        Image atlas{ atlasExtent, ImageFormat::RGBA, DataType::UInt8, clearColor };
+        atlas.Blit(regions, threadCount);
+
+        if (::memcmp(atlas.GetData(), expectedAtlas.GetData(), atlas.GetDataSize()) != 0)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Mismatch between batched blit (threads: %u) and single blits\n", threadCount);
+            return TestResult::FailedMismatch;
+        }
+
+        return TestResult::Passed;
+    };
+
+    for (unsigned threadCount : { 0u, 4u, LLGL_MAX_THREAD_COUNT })
+    {
+        const TestResult result = TestBatchedBlit(threadCount);
+        if (result != TestResult::Passed)
+            return result;
+    }
+
+    // Test overlapping blits within the same image in all directions
+    for (const Offset3D& shift : { Offset3D{ 3, 2, 0 }, Offset3D{ -3, -2, 0 }, Offset3D{ 5, -1, 0 }, Offset3D{ -1, 4, 0 } })
+    {
+        Image image = expectedAtlas;
+        Image reference = expectedAtlas;
+
+        const Offset3D srcOffset{ 100, 100, 0 };
+        const Offset3D dstOffset{ srcOffset.x + shift.x, srcOffset.y + shift.y, 0 };
+        const Extent3D extent{ 50, 40, 1 };
+
+        const Image copy = expectedAtlas;
+        reference.Blit(dstOffset, copy, srcOffset, extent);
+        image.Blit(dstOffset, image, srcOffset, extent);
+
+        if (::memcmp(image.GetData(), reference.GetData(), image.GetDataSize()) != 0)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Mismatch in overlapping blit with shift (%d, %d)\n", shift.x, shift.y);
+            return TestResult::FailedMismatch;
+        }
+    }
+
+    // Measure batched blits against single blits
+    if (opt.showTiming)
+    {
+        Image atlas{ atlasExtent, ImageFormat::RGBA, DataType::UInt8, clearColor };
+
+        const int numIterations = 100;
+
+        const std::uint64_t singleStartTime = Timer::Tick();
+        for (int i = 0; i < numIterations; ++i)
+        {
+            for (const ImageBlitRegion& region : regions)
+                atlas.Blit(region.dstRegionOffset, *region.srcImage, region.srcRegionOffset, region.srcRegionExtent);
+        }
+        const std::uint64_t batchedStartTime = Timer::Tick();
+        for (int i = 0; i < numIterations; ++i)
+            atlas.Blit(regions);
+        const std::uint64_t batchedEndTime = Timer::Tick();
+
+        const double ticksToMillisecs = 1000.0 / static_cast<double>(Timer::Frequency()) / numIterations;
+        Log::Printf(
+            "Blit %u sprites into atlas: single blits (%.4f ms), batched blit (%.4f ms)\n",
+            static_cast<unsigned>(regions.size()),
+            static_cast<double>(batchedStartTime - singleStartTime) * ticksToMillisecs,
+            static_cast<double>(batchedEndTime - batchedStartTime) * ticksToMillisecs
+        );
+    }
+
+    return TestResult::Passed;
+}
+
@@ -0,0 +1,131 @@
+/*
+ * TestImageCompression.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Utils/TypeNames.h>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <vector>
+
+
+// This test compresses a gradient image into BC formats and compares the decompressed image against the original image.
+DEF_RITEST( ImageCompression )
+{
+    const Extent2D extent{ 67, 35 };
+
+    // Generate gradient image with an extent that is not a multiple of the block size
+    std::vector<std::uint8_t> srcImage(extent.width * extent.height * 4);
+    for (std::uint32_t y = 0; y < extent.height; ++y)
+    {
+        for (std::uint32_t x = 0; x < extent.width; ++x)
+        {
+            std::uint8_t* pixel = &srcImage[(y * extent.width + x) * 4];
+            pixel[0] = static_cast<std::uint8_t>(x * 255 / (extent.width - 1));
+            pixel[1] = static_cast<std::uint8_t>(y * 255 / (extent.height - 1));
+            pixel[2] = static_cast<std::uint8_t>(255 - pixel[0] / 2);
+            pixel[3] = static_cast<std::uint8_t>((x + y) * 255 / (extent.width + extent.height - 2));
+        }
+    }
+
+    const ImageView srcImageView{ ImageFormat::RGBA, DataType::UInt8, srcImage.data(), srcImage.size() };
+
+    auto TestCompression = [&](Format format, CompressionQuality quality, int numComponents, bool isAlphaMask, int tolerance) -> TestResult
+    {
+        DynamicByteArray compressedImages[2] =
+        {
+            CompressImageBuffer(format, srcImageView, extent, quality, 0),
+            CompressImageBuffer(format, srcImageView, extent, quality, LLGL_MAX_THREAD_COUNT),
+        };
+
+        const FormatAttributes& formatAttribs = GetFormatAttribs(format);
+        const std::size_t expectedSize = ((extent.width + 3) / 4) * ((extent.height + 3) / 4) * formatAttribs.bitSize / 8;
+
+        if (!compressedImages[0] || compressedImages[0].size() != expectedSize)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Failed to compress image to LLGL::Format::%s\n", ToString(format));
+            return TestResult::FailedErrors;
+        }
+
+        if (!compressedImages[1] ||
+            compressedImages[1].size() != compressedImages[0].size() ||
+            ::memcmp(compressedImages[0].get(), compressedImages[1].get(), compressedImages[0].size()) != 0)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Mismatch between single- and multi-threaded compression to LLGL::Format::%s\n", ToString(format));
+            return TestResult::FailedMismatch;
+        }
+
+        const ImageView compressedImageView{ ImageFormat::Compressed, DataType::Undefined, compressedImages[0].get(), compressedImages[0].size() };
+        DynamicByteArray dstImage = DecompressImageBufferToRGBA8UNorm(format, compressedImageView, extent);
+        if (!dstImage)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Failed to decompress LLGL::Format::%s image\n", ToString(format));
+            return TestResult::FailedErrors;
+        }
+
+        // Compare all encoded components; BC1 encodes alpha as a 1-bit mask and skips the color of transparent pixels
+        int maxError = 0;
+        for (std::size_t i = 0; i < extent.width * extent.height; ++i)
+        {
+            const std::uint8_t* srcPixel = &srcImage[i * 4];
+            const std::uint8_t* dstPixel = reinterpret_cast<const std::uint8_t*>(&dstImage[i * 4]);
+
+            if (isAlphaMask)
+            {
+                const bool isTransparent = (srcPixel[3] < 128);
+                if (isTransparent != (dstPixel[3] == 0))
+                {
+                    Log::Errorf(
+                        Log::ColorFlags::StdError,
+                        "Mismatch between alpha mask of pixel [%u,%u] in LLGL::Format::%s image\n",
+                        static_cast<unsigned>(i % extent.width), static_cast<unsigned>(i / extent.width), ToString(format)
+                    );
+                    return TestResult::FailedMismatch;
+                }
+                if (isTransparent)
+                    continue;
+            }
+
+            for (int c = 0; c < numComponents; ++c)
+                maxError = std::max(maxError, std::abs(static_cast<int>(srcPixel[c]) - static_cast<int>(dstPixel[c])));
+        }
+
+        if (maxError > tolerance)
+        {
+            Log::Errorf(
+                Log::ColorFlags::StdError,
+                "Compression error of LLGL::Format::%s image (quality: %d) exceeds tolerance: %d > %d\n",
+                ToString(format), static_cast<int>(quality), maxError, tolerance
+            );
+            return TestResult::FailedMismatch;
+        }
+
+        if (opt.verbose)
+            Log::Printf("Compressed LLGL::Format::%s image (quality: %d) with max error %d\n", ToString(format), static_cast<int>(quality), maxError);
+
+        return TestResult::Passed;
+    };
+
+    #define TEST_COMPRESSION(FORMAT, COMPONENTS, ALPHAMASK, TOLERANCE)                                                          \
+        for (CompressionQuality quality : { CompressionQuality::Fast, CompressionQuality::Normal, CompressionQuality::High })  \
+        {                                                                                                                       \
+            const TestResult result = TestCompression((FORMAT), quality, (COMPONENTS), (ALPHAMASK), (TOLERANCE));               \
+            if (result != TestResult::Passed)                                                                                   \
+                return result;                                                                                                  \
+        }
+
+    TEST_COMPRESSION(Format::BC1UNorm, 3, true,  16);
+    TEST_COMPRESSION(Format::BC3UNorm, 4, false, 16);
+    TEST_COMPRESSION(Format::BC4UNorm, 1, false,  4);
+    TEST_COMPRESSION(Format::BC5UNorm, 2, false,  4);
+
+    #undef TEST_COMPRESSION
+
+    return TestResult::Passed;
+}
+
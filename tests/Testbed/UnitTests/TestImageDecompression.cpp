@@ -0,0 +1,185 @@
+/*
+ * TestImageDecompression.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Utils/TypeNames.h>
+#include <cstring>
+
+
+// This test decodes hand-crafted BC blocks and compares them against known RGBA8 colors.
+DEF_RITEST( ImageDecompression )
+{
+    struct ExpectedPixel
+    {
+        std::uint32_t x, y;
+        std::uint8_t  rgba[4];
+    };
+
+    // Writes a bit field into a 128-bit block, starting at the least significant bit of the first byte
+    auto WriteBits = [](std::uint8_t* block, unsigned& bitPos, std::uint32_t value, unsigned count)
+    {
+        for (unsigned i = 0; i < count; ++i, ++bitPos)
+        {
+            if (((value >> i) & 0x1) != 0)
+                block[bitPos / 8] |= static_cast<std::uint8_t>(1u << (bitPos % 8));
+        }
+    };
+
+    auto TestDecompression = [&opt](Format format, const void* data, std::size_t dataSize, const Extent2D& extent, std::initializer_list<ExpectedPixel> expectedPixels) -> TestResult
+    {
+        ImageView srcImageView;
+        {
+            srcImageView.data       = data;
+            srcImageView.dataSize   = dataSize;
+        }
+        DynamicByteArray dstImage = DecompressImageBufferToRGBA8UNorm(format, srcImageView, extent);
+        if (!dstImage || dstImage.size() != extent.width * extent.height * 4)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Failed to decompress LLGL::Format::%s image\n", ToString(format));
+            return TestResult::FailedErrors;
+        }
+
+        for (const ExpectedPixel& expected : expectedPixels)
+        {
+            const std::uint8_t* actual = reinterpret_cast<const std::uint8_t*>(dstImage.get()) + (expected.y * extent.width + expected.x) * 4;
+            if (::memcmp(actual, expected.rgba, 4) != 0)
+            {
+                Log::Errorf(
+                    Log::ColorFlags::StdError,
+                    "Mismatch between decompressed LLGL::Format::%s pixel [%u,%u] (%u, %u, %u, %u) and expected pixel (%u, %u, %u, %u)\n",
+                    ToString(format), expected.x, expected.y,
+                    actual[0], actual[1], actual[2], actual[3],
+                    expected.rgba[0], expected.rgba[1], expected.rgba[2], expected.rgba[3]
+                );
+                return TestResult::FailedMismatch;
+            }
+        }
+
+        if (opt.verbose)
+            Log::Printf("Decompressed LLGL::Format::%s image (%u x %u)\n", ToString(format), extent.width, extent.height);
+
+        return TestResult::Passed;
+    };
+
+    #define TEST_DECOMPRESSION(FORMAT, DATA, EXTENT, ...)                                               \
+        {                                                                                               \
+            const TestResult result = TestDecompression((FORMAT), (DATA), sizeof(DATA), (EXTENT), { __VA_ARGS__ });   \
+            if (result != TestResult::Passed)                                                           \
+                return result;                                                                          \
+        }
+
+    // BC1 in 4-color mode (color0 > color1): red and blue endpoints, interpolated at 1/3 and 2/3
+    const std::uint8_t bc1Block4Colors[8] = { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0x00, 0x00, 0x00 };
+    TEST_DECOMPRESSION(
+        Format::BC1UNorm, bc1Block4Colors, Extent2D(4, 4),
+        ExpectedPixel{ 0, 0, { 255,   0,   0, 255 } },
+        ExpectedPixel{ 1, 0, {   0,   0, 255, 255 } },
+        ExpectedPixel{ 2, 0, { 170,   0,  85, 255 } },
+        ExpectedPixel{ 3, 0, {  85,   0, 170, 255 } },
+        ExpectedPixel{ 3, 3, { 255,   0,   0, 255 } }
+    );
+
+    // BC1 in 3-color mode (color0 <= color1): halfway color and transparent black
+    const std::uint8_t bc1Block3Colors[8] = { 0x1F, 0x00, 0x00, 0xF8, 0xE4, 0x00, 0x00, 0x00 };
+    TEST_DECOMPRESSION(
+        Format::BC1UNorm, bc1Block3Colors, Extent2D(4, 4),
+        ExpectedPixel{ 2, 0, { 128,   0, 128, 255 } },
+        ExpectedPixel{ 3, 0, {   0,   0,   0,   0 } }
+    );
+
+    // BC1 with an extent that is not a multiple of 4: blocks at the right and bottom edges are clipped
+    const std::uint8_t bc1Blocks5x3[16] =
+    {
+        0x00, 0xF8, 0x00, 0xF8, 0x00, 0x00, 0x00, 0x00,
+        0xE0, 0x07, 0xE0, 0x07, 0x00, 0x00, 0x00, 0x00,
+    };
+    TEST_DECOMPRESSION(
+        Format::BC1UNorm, bc1Blocks5x3, Extent2D(5, 3),
+        ExpectedPixel{ 3, 2, { 255,   0,   0, 255 } },
+        ExpectedPixel{ 4, 0, {   0, 255,   0, 255 } },
+        ExpectedPixel{ 4, 2, {   0, 255,   0, 255 } }
+    );
+
+    // BC2 with explicit 4-bit alpha values
+    const std::uint8_t bc2Block[16] =
+    {
+        0xF0, 0x8F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00,
+    };
+    TEST_DECOMPRESSION(
+        Format::BC2UNorm, bc2Block, Extent2D(4, 4),
+        ExpectedPixel{ 0, 0, { 255, 255, 255,   0 } },
+        ExpectedPixel{ 1, 0, { 255, 255, 255, 255 } },
+        ExpectedPixel{ 2, 0, { 255, 255, 255, 255 } },
+        ExpectedPixel{ 3, 0, { 255, 255, 255, 136 } }
+    );
+
+    // BC4 in 8-value mode (value0 > value1)
+    const std::uint8_t bc4Block[8] = { 0xFF, 0x00, 0x88, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    TEST_DECOMPRESSION(
+        Format::BC4UNorm, bc4Block, Extent2D(4, 4),
+        ExpectedPixel{ 0, 0, { 255,   0,   0, 255 } },
+        ExpectedPixel{ 1, 0, {   0,   0,   0, 255 } },
+        ExpectedPixel{ 2, 0, { 219,   0,   0, 255 } }
+    );
+
+    // BC5 with signed endpoints: [-1, 1] is remapped to [0, 255]
+    const std::uint8_t bc5Block[16] =
+    {
+        0x7F, 0x81, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x81, 0x7F, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    TEST_DECOMPRESSION(
+        Format::BC5SNorm, bc5Block, Extent2D(4, 4),
+        ExpectedPixel{ 0, 0, { 255,   0,   0, 255 } },
+        ExpectedPixel{ 1, 0, {   0, 255,   0, 255 } }
+    );
+
+    // BC6H mode 11 with solid color: 10-bit endpoints (462, 0, 1023) decode to half-floats (0.5, 0.0, 65504.0)
+    std::uint8_t bc6hBlock[16] = {};
+    {
+        unsigned bitPos = 0;
+        WriteBits(bc6hBlock, bitPos, 0x03, 5);
+        for (std::uint32_t endpoint : { 462u, 0u, 1023u, 462u, 0u, 1023u })
+            WriteBits(bc6hBlock, bitPos, endpoint, 10);
+    }
+    TEST_DECOMPRESSION(
+        Format::BC6HUFloat, bc6hBlock, Extent2D(4, 4),
+        ExpectedPixel{ 0, 0, { 128,   0, 255, 255 } },
+        ExpectedPixel{ 3, 3, { 128,   0, 255, 255 } }
+    );
+
+    // BC7 mode 6 with 7-bit endpoints and unique P-bits: black to white with 4-bit indices
+    std::uint8_t bc7Block[16] = {};
+    {
+        unsigned bitPos = 0;
+        WriteBits(bc7Block, bitPos, 0x40, 7);
+        for (int i = 0; i < 4; ++i)
+        {
+            WriteBits(bc7Block, bitPos, 0x00, 7);
+            WriteBits(bc7Block, bitPos, 0x7F, 7);
+        }
+        WriteBits(bc7Block, bitPos, 0, 1);
+        WriteBits(bc7Block, bitPos, 1, 1);
+        WriteBits(bc7Block, bitPos, 0, 3);
+        WriteBits(bc7Block, bitPos, 8, 4);
+        for (int i = 2; i < 16; ++i)
+            WriteBits(bc7Block, bitPos, 15, 4);
+    }
+    TEST_DECOMPRESSION(
+        Format::BC7UNorm, bc7Block, Extent2D(4, 4),
+        ExpectedPixel{ 0, 0, {   0,   0,   0,   0 } },
+        ExpectedPixel{ 1, 0, { 135, 135, 135, 135 } },
+        ExpectedPixel{ 3, 3, { 255, 255, 255, 255 } }
+    );
+
+    #undef TEST_DECOMPRESSION
+
+    return TestResult::Passed;
+}
+
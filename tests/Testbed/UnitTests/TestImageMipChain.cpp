@@ -0,0 +1,312 @@
+/*
+ * TestImageMipChain.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/Image.h>
+#include <LLGL/Utils/TaskScheduler.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/Timer.h>
+#include <cstdlib>
+#include <string.h>
+
+
+// This test generates MIP-map chains on the CPU and compares them against known results for each filter and option.
+DEF_RITEST( ImageMipChain )
+{
+    auto GetPixel = [](const Image& image, std::uint32_t x, std::uint32_t y, std::uint32_t z = 0) -> const std::uint8_t*
+    {
+        const Extent3D& extent = image.GetExtent();
+        return static_cast<const std::uint8_t*>(image.GetData()) + ((z * extent.height + y) * extent.width + x) * 4;
+    };
+
+    // Test box filter against averages of 2x2 blocks
+    {
+        const std::uint8_t srcPixels[4 * 4 * 4] =
+        {
+              0,   0,   0, 255,  10,  20,  30, 255, 100, 100, 100, 255, 200, 200, 200, 255,
+             20,  40,  60, 255,  30,  60,  90, 255, 100, 100, 100, 255, 201, 201, 201, 255,
+            255,   0,   0,   0, 255,   0,   0,   0,   0,   0, 255, 255,   0,   0, 255, 255,
+            255,   0,   0,   0, 255,   0,   0,   0,   0,   0, 255, 255,   0,   0, 254, 255,
+        };
+        const std::uint8_t expectedPixels[2 * 2 * 4] =
+        {
+             15,  30,  45, 255, 150, 150, 150, 255,
+            255,   0,   0,   0,   0,   0, 255, 255,
+        };
+
+        Image image{ Extent3D{ 4, 4, 1 }, ImageFormat::RGBA, DataType::UInt8 };
+        ::memcpy(image.GetData(), srcPixels, sizeof(srcPixels));
+
+        DynamicVector<Image> mipChain = image.GenerateMipChain();
+        if (mipChain.size() != 2 || mipChain[0].GetExtent() != Extent3D{ 2, 2, 1 } || mipChain[1].GetExtent() != Extent3D{ 1, 1, 1 })
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Mismatch between number of generated MIP-maps for 4x4 image\n");
+            return TestResult::FailedMismatch;
+        }
+
+        for_range(i, sizeof(expectedPixels))
+        {
+            const int value = static_cast<const std::uint8_t*>(mipChain[0].GetData())[i];
+            if (std::abs(value - static_cast<int>(expectedPixels[i])) > 1)
+            {
+                Log::Errorf(Log::ColorFlags::StdError, "Mismatch in box-filtered MIP-map component [%u]: %d (expected %d)\n", static_cast<unsigned>(i), value, static_cast<int>(expectedPixels[i]));
+                return TestResult::FailedMismatch;
+            }
+        }
+    }
+
+    // Test that constant images stay constant with all filters, and that non-power-of-two layers are downsampled independently
+    const Extent3D layeredExtent{ 67, 35, 2 };
+    const ColorRGBAf layerColors[2] = { ColorRGBAf{ 0.2f, 0.4f, 0.6f, 0.8f }, ColorRGBAf{ 1.0f, 0.0f, 0.5f, 1.0f } };
+
+    Image layeredImage{ layeredExtent, ImageFormat::RGBA, DataType::UInt8 };
+    for_range(layer, 2)
+    {
+        const Image layerImage{ Extent3D{ layeredExtent.width, layeredExtent.height, 1 }, ImageFormat::RGBA, DataType::UInt8, layerColors[layer] };
+        layeredImage.Blit(Offset3D{ 0, 0, static_cast<std::int32_t>(layer) }, layerImage, Offset3D{}, layerImage.GetExtent());
+    }
+
+    for (ImageFilter filter : { ImageFilter::Box, ImageFilter::Kaiser, ImageFilter::Lanczos3 })
+    {
+        MipChainDescriptor mipChainDesc;
+        mipChainDesc.filter = filter;
+
+        DynamicVector<Image> mipChains[2] =
+        {
+            layeredImage.GenerateMipChain(mipChainDesc, 0),
+            layeredImage.GenerateMipChain(mipChainDesc, LLGL_MAX_THREAD_COUNT),
+        };
+
+        const std::uint32_t expectedNumMipLevels = NumMipLevels(layeredExtent.width, layeredExtent.height) - 1;
+        if (mipChains[0].size() != expectedNumMipLevels || mipChains[1].size() != expectedNumMipLevels)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Mismatch between number of MIP-maps (filter: %d)\n", static_cast<int>(filter));
+            return TestResult::FailedMismatch;
+        }
+
+        for_range(mipLevel, expectedNumMipLevels)
+        {
+            const Image& mipMap = mipChains[0][mipLevel];
+            const Extent3D expectedExtent{ std::max(1u, layeredExtent.width >> (mipLevel + 1)), std::max(1u, layeredExtent.height >> (mipLevel + 1)), 2 };
+
+            if (mipMap.GetExtent() != expectedExtent ||
+                mipChains[1][mipLevel].GetDataSize() != mipMap.GetDataSize() ||
+                ::memcmp(mipChains[1][mipLevel].GetData(), mipMap.GetData(), mipMap.GetDataSize()) != 0)
+            {
+                Log::Errorf(Log::ColorFlags::StdError, "Mismatch in MIP-map [%u] between single- and multi-threaded generation (filter: %d)\n", static_cast<unsigned>(mipLevel), static_cast<int>(filter));
+                return TestResult::FailedMismatch;
+            }
+
+            for_range(z, 2)
+            {
+                const std::uint8_t* pixel = GetPixel(mipMap, mipMap.GetExtent().width / 2, mipMap.GetExtent().height / 2, z);
+                for_range(c, 4)
+                {
+                    const int expected = static_cast<int>(layerColors[z][c] * 255.0f + 0.5f);
+                    if (std::abs(static_cast<int>(pixel[c]) - expected) > 1)
+                    {
+                        Log::Errorf(
+                            Log::ColorFlags::StdError,
+                            "Mismatch in MIP-map [%u] of constant layer [%u] (filter: %d): component [%u] is %d (expected %d)\n",
+                            static_cast<unsigned>(mipLevel), static_cast<unsigned>(z), static_cast<int>(filter), static_cast<unsigned>(c), static_cast<int>(pixel[c]), expected
+                        );
+                        return TestResult::FailedMismatch;
+                    }
+                }
+            }
+        }
+    }
+
+    // Test sRGB-correct averaging of black and white: linear average 0.5 is 188 in sRGB
+    {
+        const std::uint8_t srcPixels[2 * 4] = { 0, 0, 0, 0, 255, 255, 255, 255 };
+        Image image{ Extent3D{ 2, 1, 1 }, ImageFormat::RGBA, DataType::UInt8 };
+        ::memcpy(image.GetData(), srcPixels, sizeof(srcPixels));
+
+        MipChainDescriptor mipChainDesc;
+        mipChainDesc.sRGB = true;
+
+        DynamicVector<Image> mipChainLinear = image.GenerateMipChain();
+        DynamicVector<Image> mipChainSRGB   = image.GenerateMipChain(mipChainDesc);
+
+        const std::uint8_t* pixelLinear = GetPixel(mipChainLinear[0], 0, 0);
+        const std::uint8_t* pixelSRGB   = GetPixel(mipChainSRGB[0], 0, 0);
+
+        if (pixelLinear[0] != 128 || pixelSRGB[0] != 188 || pixelSRGB[3] != 128)
+        {
+            Log::Errorf(
+                Log::ColorFlags::StdError,
+                "Mismatch in sRGB MIP-map: linear (%d), sRGB (%d), sRGB alpha (%d); expected 128, 188, 128\n",
+                static_cast<int>(pixelLinear[0]), static_cast<int>(pixelSRGB[0]), static_cast<int>(pixelSRGB[3])
+            );
+            return TestResult::FailedMismatch;
+        }
+    }
+
+    // Test alpha coverage preservation with noisy alpha values that mostly fall below the reference value in MIP-maps without it
+    {
+        const Extent3D extent{ 64, 64, 1 };
+        Image image{ extent, ImageFormat::RGBA, DataType::UInt8 };
+        std::uint8_t* pixels = static_cast<std::uint8_t*>(image.GetData());
+        std::uint32_t seed = 1234;
+        for_range(i, image.GetNumPixels())
+        {
+            seed = seed * 1664525u + 1013904223u;
+            pixels[i * 4 + 0] = pixels[i * 4 + 1] = pixels[i * 4 + 2] = 255;
+            pixels[i * 4 + 3] = static_cast<std::uint8_t>((seed >> 24) * 180 / 255);
+        }
+
+        auto GetCoverage = [](const Image& image) -> float
+        {
+            const std::uint8_t* pixels = static_cast<const std::uint8_t*>(image.GetData());
+            std::uint32_t numCovered = 0;
+            for_range(i, image.GetNumPixels())
+            {
+                if (pixels[i * 4 + 3] > 127)
+                    ++numCovered;
+            }
+            return static_cast<float>(numCovered) / static_cast<float>(image.GetNumPixels());
+        };
+
+        MipChainDescriptor mipChainDesc;
+        mipChainDesc.numMipLevels       = 2;
+        mipChainDesc.alphaCoverageRef   = 0.5f;
+
+        DynamicVector<Image> mipChainFading     = image.GenerateMipChain();
+        DynamicVector<Image> mipChainCoverage   = image.GenerateMipChain(mipChainDesc);
+
+        const float baseCoverage    = GetCoverage(image);
+        const float fadingCoverage  = GetCoverage(mipChainFading[1]);
+        const float mipCoverage     = GetCoverage(mipChainCoverage[1]);
+
+        if (mipChainCoverage.size() != 2 || fadingCoverage > baseCoverage * 0.5f || std::abs(mipCoverage - baseCoverage) > 0.05f)
+        {
+            Log::Errorf(
+                Log::ColorFlags::StdError,
+                "Mismatch in alpha coverage of MIP-map: %.3f with preservation, %.3f without (expected %.3f)\n",
+                mipCoverage, fadingCoverage, baseCoverage
+            );
+            return TestResult::FailedMismatch;
+        }
+    }
+
+    // Test that MIP-chains of several images generated concurrently with tasks match the synchronously generated ones
+    {
+        const Extent3D noiseExtent{ 33, 17, 3 };
+        Image noiseImage{ noiseExtent, ImageFormat::RGBA, DataType::UInt8 };
+        std::uint8_t* pixels = static_cast<std::uint8_t*>(noiseImage.GetData());
+        std::uint32_t seed = 5678;
+        for_range(i, noiseImage.GetDataSize())
+        {
+            seed = seed * 1664525u + 1013904223u;
+            pixels[i] = static_cast<std::uint8_t>(seed >> 24);
+        }
+
+        MipChainDescriptor mipChainDescs[4];
+        {
+            mipChainDescs[0].filter             = ImageFilter::Box;
+            mipChainDescs[1].filter             = ImageFilter::Kaiser;
+            mipChainDescs[1].sRGB               = true;
+            mipChainDescs[2].filter             = ImageFilter::Lanczos3;
+            mipChainDescs[2].alphaCoverageRef   = 0.5f;
+            mipChainDescs[3].filter             = ImageFilter::Box;
+            mipChainDescs[3].downsampleDepth    = true;
+        }
+
+        constexpr std::size_t numMipChains = sizeof(mipChainDescs)/sizeof(mipChainDescs[0]);
+
+        // Schedule all MIP-chains first, so they are generated concurrently
+        const Image* images[numMipChains] = { &layeredImage, &noiseImage, &noiseImage, &noiseImage };
+        DynamicVector<Image> asyncMipChains[numMipChains];
+        TaskHandle tasks[numMipChains];
+
+        for_range(i, numMipChains)
+            tasks[i] = images[i]->GenerateMipChainAsync(asyncMipChains[i], mipChainDescs[i]);
+
+        TaskScheduler::WaitAll(tasks);
+
+        for_range(i, numMipChains)
+        {
+            const DynamicVector<Image> mipChain = images[i]->GenerateMipChain(mipChainDescs[i]);
+
+            if (!tasks[i].IsCompleted() || asyncMipChains[i].size() != mipChain.size())
+            {
+                Log::Errorf(Log::ColorFlags::StdError, "Mismatch between number of MIP-maps generated synchronously and with tasks [%u]\n", static_cast<unsigned>(i));
+                return TestResult::FailedMismatch;
+            }
+
+            for_range(mipLevel, mipChain.size())
+            {
+                const Image& mipMap = mipChain[mipLevel];
+                const Image& asyncMipMap = asyncMipChains[i][mipLevel];
+
+                if (asyncMipMap.GetExtent() != mipMap.GetExtent() || ::memcmp(asyncMipMap.GetData(), mipMap.GetData(), mipMap.GetDataSize()) != 0)
+                {
+                    Log::Errorf(
+                        Log::ColorFlags::StdError,
+                        "Mismatch in MIP-map [%u] between synchronous generation and generation with tasks [%u]\n",
+                        static_cast<unsigned>(mipLevel), static_cast<unsigned>(i)
+                    );
+                    return TestResult::FailedMismatch;
+                }
+            }
+        }
+    }
+
+    // Measure MIP-chain generation of a large image with each filter
+    if (opt.showTiming)
+    {
+        const Image image{ Extent3D{ 1024, 1024, 1 }, ImageFormat::RGBA, DataType::UInt8, ColorRGBAf{ 0.5f, 0.25f, 0.75f, 1.0f } };
+        for (ImageFilter filter : { ImageFilter::Box, ImageFilter::Kaiser, ImageFilter::Lanczos3 })
+        {
+            MipChainDescriptor mipChainDesc;
+            mipChainDesc.filter = filter;
+            mipChainDesc.sRGB   = true;
+
+            const std::uint64_t startTime = Timer::Tick();
+            image.GenerateMipChain(mipChainDesc, LLGL_MAX_THREAD_COUNT);
+            const std::uint64_t endTime = Timer::Tick();
+
+            Log::Printf(
+                "Generate sRGB MIP-chain of 1024x1024 image (filter: %d): %.2f ms\n",
+                static_cast<int>(filter), static_cast<double>(endTime - startTime) / static_cast<double>(Timer::Frequency()) * 1000.0
+            );
+        }
+
+        // Generate the MIP-chains of several images one after another and concurrently with tasks
+        constexpr std::uint32_t numImages = 8;
+        const Image smallImage{ Extent3D{ 256, 256, 1 }, ImageFormat::RGBA, DataType::UInt8, ColorRGBAf{ 0.5f, 0.25f, 0.75f, 1.0f } };
+
+        MipChainDescriptor mipChainDesc;
+        mipChainDesc.filter = ImageFilter::Kaiser;
+        mipChainDesc.sRGB   = true;
+
+        const std::uint64_t serialStartTime = Timer::Tick();
+        for_range(i, numImages)
+            smallImage.GenerateMipChain(mipChainDesc);
+        const std::uint64_t serialEndTime = Timer::Tick();
+
+        DynamicVector<Image> mipChains[numImages];
+        TaskHandle tasks[numImages];
+
+        const std::uint64_t asyncStartTime = Timer::Tick();
+        for_range(i, numImages)
+            tasks[i] = smallImage.GenerateMipChainAsync(mipChains[i], mipChainDesc);
+        TaskScheduler::WaitAll(tasks);
+        const std::uint64_t asyncEndTime = Timer::Tick();
+
+        Log::Printf(
+            "Generate sRGB MIP-chains of %u 256x256 images: %.2f ms serial, %.2f ms with tasks\n",
+            numImages,
+            static_cast<double>(serialEndTime - serialStartTime) / static_cast<double>(Timer::Frequency()) * 1000.0,
+            static_cast<double>(asyncEndTime - asyncStartTime) / static_cast<double>(Timer::Frequency()) * 1000.0
+        );
+    }
+
+    return TestResult::Passed;
+}
+
@@ -0,0 +1,130 @@
+/*
+ * TestImageResize.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/Image.h>
+#include <LLGL/Timer.h>
+#include <cstdlib>
+#include <string.h>
+
+
+// This test scales images with each resampling filter and compares them against known results.
+DEF_RITEST( ImageResize )
+{
+    // Test bilinear upsampling of a horizontal gradient against linear interpolation between pixel centers
+    {
+        const std::uint8_t srcPixels[2 * 4] = { 0, 0, 0, 255, 255, 128, 64, 255 };
+        const std::uint8_t expectedPixels[4 * 4] =
+        {
+              0,   0,  0, 255,
+             64,  32, 16, 255,
+            191,  96, 48, 255,
+            255, 128, 64, 255,
+        };
+
+        Image image{ Extent3D{ 2, 1, 1 }, ImageFormat::RGBA, DataType::UInt8 };
+        ::memcpy(image.GetData(), srcPixels, sizeof(srcPixels));
+        image.Resize(Extent3D{ 4, 1, 1 }, ImageFilter::Bilinear);
+
+        if (image.GetExtent() != Extent3D{ 4, 1, 1 })
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Mismatch between extent of scaled image\n");
+            return TestResult::FailedMismatch;
+        }
+
+        for_range(i, sizeof(expectedPixels))
+        {
+            const int value = static_cast<const std::uint8_t*>(image.GetData())[i];
+            if (std::abs(value - static_cast<int>(expectedPixels[i])) > 1)
+            {
+                Log::Errorf(Log::ColorFlags::StdError, "Mismatch in bilinear upsampled component [%u]: %d (expected %d)\n", static_cast<unsigned>(i), value, static_cast<int>(expectedPixels[i]));
+                return TestResult::FailedMismatch;
+            }
+        }
+    }
+
+    // Test that constant images stay constant with all filters for up- and downsampling, and that results are independent of the thread count
+    const ColorRGBAf fillColor{ 0.2f, 0.4f, 0.6f, 0.8f };
+    const Image constImage{ Extent3D{ 67, 35, 3 }, ImageFormat::RGBA, DataType::UInt8, fillColor };
+
+    for (ImageFilter filter : { ImageFilter::Box, ImageFilter::Bilinear, ImageFilter::Bicubic, ImageFilter::Kaiser, ImageFilter::Lanczos3 })
+    {
+        for (const Extent3D& extent : { Extent3D{ 16, 9, 3 }, Extent3D{ 150, 71, 3 }, Extent3D{ 33, 100, 2 } })
+        {
+            Image images[2] = { constImage, constImage };
+            images[0].Resize(extent, filter, false, 0);
+            images[1].Resize(extent, filter, false, LLGL_MAX_THREAD_COUNT);
+
+            if (images[0].GetExtent() != extent ||
+                images[1].GetDataSize() != images[0].GetDataSize() ||
+                ::memcmp(images[1].GetData(), images[0].GetData(), images[0].GetDataSize()) != 0)
+            {
+                Log::Errorf(
+                    Log::ColorFlags::StdError,
+                    "Mismatch between single- and multi-threaded image scaling to %ux%ux%u (filter: %d)\n",
+                    extent.width, extent.height, extent.depth, static_cast<int>(filter)
+                );
+                return TestResult::FailedMismatch;
+            }
+
+            const std::uint8_t* pixels = static_cast<const std::uint8_t*>(images[0].GetData());
+            for_range(i, images[0].GetDataSize())
+            {
+                const int expected = static_cast<int>(fillColor[i % 4] * 255.0f + 0.5f);
+                if (std::abs(static_cast<int>(pixels[i]) - expected) > 1)
+                {
+                    Log::Errorf(
+                        Log::ColorFlags::StdError,
+                        "Mismatch in constant image scaled to %ux%ux%u (filter: %d): component [%u] is %d (expected %d)\n",
+                        extent.width, extent.height, extent.depth, static_cast<int>(filter), static_cast<unsigned>(i), static_cast<int>(pixels[i]), expected
+                    );
+                    return TestResult::FailedMismatch;
+                }
+            }
+        }
+    }
+
+    // Test that ringing of sharpening filters at hard edges is clamped instead of wrapping around
+    for (ImageFilter filter : { ImageFilter::Bicubic, ImageFilter::Lanczos3 })
+    {
+        Image image{ Extent3D{ 8, 1, 1 }, ImageFormat::R, DataType::UInt8 };
+        ::memcpy(image.GetData(), "\x00\x00\x00\x00\xFF\xFF\xFF\xFF", 8);
+        image.Resize(Extent3D{ 32, 1, 1 }, filter);
+
+        const std::uint8_t* pixels = static_cast<const std::uint8_t*>(image.GetData());
+        for_range(x, 32u)
+        {
+            if ((x < 8 && pixels[x] > 16) || (x >= 24 && pixels[x] < 239))
+            {
+                Log::Errorf(Log::ColorFlags::StdError, "Mismatch in scaled hard edge (filter: %d): pixel [%u] is %d\n", static_cast<int>(filter), x, static_cast<int>(pixels[x]));
+                return TestResult::FailedMismatch;
+            }
+        }
+    }
+
+    // Measure downsampling of a large image with each filter
+    if (opt.showTiming)
+    {
+        const Image srcImage{ Extent3D{ 2048, 2048, 1 }, ImageFormat::RGBA, DataType::UInt8, fillColor };
+        for (ImageFilter filter : { ImageFilter::Box, ImageFilter::Bilinear, ImageFilter::Bicubic, ImageFilter::Kaiser, ImageFilter::Lanczos3 })
+        {
+            Image image = srcImage;
+
+            const std::uint64_t startTime = Timer::Tick();
+            image.Resize(Extent3D{ 720, 720, 1 }, filter, false, LLGL_MAX_THREAD_COUNT);
+            const std::uint64_t endTime = Timer::Tick();
+
+            Log::Printf(
+                "Scale 2048x2048 image to 720x720 (filter: %d): %.2f ms\n",
+                static_cast<int>(filter), static_cast<double>(endTime - startTime) / static_cast<double>(Timer::Frequency()) * 1000.0
+            );
+        }
+    }
+
+    return TestResult::Passed;
+}
+
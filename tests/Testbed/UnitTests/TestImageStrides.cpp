@@ -13,7 +13,7 @@
 #include <thread>
 
 
-// This test ensures that the ImageView::rowStride field works in the image conversion functions.
+// This test ensures that the ImageView::rowStride and ::layerStride fields work in the image conversion functions and in Image::WritePixels.
 DEF_RITEST( ImageStrides )
 {
     // Manual testing
@@ -131,6 +131,42 @@ DEF_RITEST( ImageStrides )
         }
     }
 
+    // Write padded input image into images with the same and with a different format, i.e. with and without conversion
+    Image dstImageRGBA8ub{ imageExtent, ImageFormat::RGBA, DataType::UInt8 };
+    Image dstImageRGB32f{ imageExtent, ImageFormat::RGB, DataType::Float32 };
+
+    dstImageRGBA8ub.WritePixels(Offset3D{}, imageExtent, srcImg);
+    dstImageRGB32f.WritePixels(Offset3D{}, imageExtent, srcImg);
+
+    for_range(z, imageExtent.depth)
+    {
+        for_range(y, imageExtent.height)
+        {
+            for_range(x, imageExtent.width)
+            {
+                const std::uint32_t i = (z * imageExtent.height + y) * imageExtent.width + x;
+                const ColorRGBAub srcCol = testsetColors[i % testsetColors.size()];
+                const ColorRGBAub dstColRGBA8ub = static_cast<const ColorRGBAub*>(dstImageRGBA8ub.GetData())[i];
+                const ColorRGBub dstColRGB32f = static_cast<const ColorRGBf*>(dstImageRGB32f.GetData())[i].Cast<std::uint8_t>();
+                if (srcCol != dstColRGBA8ub || srcCol.ToRGB() != dstColRGB32f)
+                {
+                    const std::string srcColStr = FormatByteArray(srcCol.Ptr(), sizeof(srcCol));
+                    const std::string dstColRGBA8ubStr = FormatByteArray(dstColRGBA8ub.Ptr(), sizeof(dstColRGBA8ub));
+                    const std::string dstColRGB32fStr = FormatByteArray(dstColRGB32f.Ptr(), sizeof(dstColRGB32f));
+                    Log::Errorf(
+                        Log::ColorFlags::StdError,
+                        "Mismatch between written image pixels and padded input image at (%u,%u,%u):\n"
+                        " -> Expected:          [%s]\n"
+                        " -> Actual (RGBA8UB):  [%s]\n"
+                        " -> Actual (RGB32F):   [%s]\n",
+                        x, y, z, srcColStr.c_str(), dstColRGBA8ubStr.c_str(), dstColRGB32fStr.c_str()
+                    );
+                    return TestResult::FailedMismatch;
+                }
+            }
+        }
+    }
+
     return TestResult::Passed;
 }
 
@@ -0,0 +1,170 @@
+/*
+ * TestNullBufferMap.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <string.h>
+
+
+/*
+Tests buffer mapping of the Null renderer in both of its modes:
+By default, buffers are mapped directly, i.e. WriteDiscard keeps the previous content of the buffer.
+With RenderSystemFlags::DebugDevice, buffers are mapped via a temporary copy, i.e. WriteDiscard fills the entire buffer
+with the uninitialized pattern and write-only mappings start with the uninitialized pattern as well.
+*/
+DEF_TEST( NullBufferMap )
+{
+    if (renderer->GetRendererID() != RendererID::Null)
+        return TestResult::Skipped;
+
+    constexpr std::uint32_t numWords            = 16;
+    constexpr std::uint32_t uninitializedWord   = 0xDEADBEEF;
+
+    std::uint32_t initialData[numWords];
+    for_range(i, numWords)
+        initialData[i] = 0x1000u + i;
+
+    // Runs all map operations on a separate Null renderer and compares the buffer content with the expected words after each one
+    auto TestMapping = [&initialData](RenderSystem& mapRenderer, bool isCopyOnMap) -> TestResult
+    {
+        const char* modeName = (isCopyOnMap ? "copy-on-map" : "direct");
+
+        BufferDescriptor bufDesc;
+        {
+            bufDesc.size            = sizeof(initialData);
+            bufDesc.cpuAccessFlags  = CPUAccessFlags::ReadWrite;
+        }
+        Buffer* buf = mapRenderer.CreateBuffer(bufDesc, initialData);
+
+        std::uint32_t expectedData[numWords];
+        ::memcpy(expectedData, initialData, sizeof(initialData));
+
+        auto MapWords = [&mapRenderer, buf, modeName](CPUAccess access, std::uint32_t firstWord, std::uint32_t numMappedWords) -> std::uint32_t*
+        {
+            void* data = mapRenderer.MapBuffer(*buf, access, firstWord * sizeof(std::uint32_t), numMappedWords * sizeof(std::uint32_t));
+            if (data == nullptr)
+                Log::Errorf(Log::ColorFlags::StdError, "Failed to map words [%u, %u) of buffer (%s)\n", firstWord, firstWord + numMappedWords, modeName);
+            return static_cast<std::uint32_t*>(data);
+        };
+
+        auto CompareBufferContent = [&mapRenderer, buf, &expectedData, modeName](const char* operation) -> bool
+        {
+            std::uint32_t actualData[numWords] = {};
+            mapRenderer.ReadBuffer(*buf, 0, actualData, sizeof(actualData));
+            for_range(i, numWords)
+            {
+                if (actualData[i] != expectedData[i])
+                {
+                    Log::Errorf(
+                        Log::ColorFlags::StdError,
+                        "Mismatch between buffer word [%u] after %s (0x%08X) and expected word (0x%08X) (%s)\n",
+                        i, operation, actualData[i], expectedData[i], modeName
+                    );
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        TestResult result = TestResult::Passed;
+
+        // Map entire buffer for reading
+        if (std::uint32_t* words = MapWords(CPUAccess::ReadOnly, 0, numWords))
+        {
+            const bool isEqual = (::memcmp(words, initialData, sizeof(initialData)) == 0);
+            mapRenderer.UnmapBuffer(*buf);
+            if (!isEqual)
+            {
+                Log::Errorf(Log::ColorFlags::StdError, "Mismatch between read-only mapped buffer and initial data (%s)\n", modeName);
+                result = TestResult::FailedMismatch;
+            }
+        }
+        else
+            result = TestResult::FailedErrors;
+
+        // Map words [4, 8) for writing only and overwrite all of them
+        if (result == TestResult::Passed)
+        {
+            if (std::uint32_t* words = MapWords(CPUAccess::WriteOnly, 4, 4))
+            {
+                for_range(i, 4)
+                    words[i] = expectedData[4 + i] = 0x2000u + i;
+                mapRenderer.UnmapBuffer(*buf);
+                if (!CompareBufferContent("WriteOnly mapping"))
+                    result = TestResult::FailedMismatch;
+            }
+            else
+                result = TestResult::FailedErrors;
+        }
+
+        // Map words [8, 12) for reading and writing and increment each of them
+        if (result == TestResult::Passed)
+        {
+            if (std::uint32_t* words = MapWords(CPUAccess::ReadWrite, 8, 4))
+            {
+                for_range(i, 4)
+                    words[i] = expectedData[8 + i] = words[i] + 1u;
+                mapRenderer.UnmapBuffer(*buf);
+                if (!CompareBufferContent("ReadWrite mapping"))
+                    result = TestResult::FailedMismatch;
+            }
+            else
+                result = TestResult::FailedErrors;
+        }
+
+        // Map words [0, 4) with WriteDiscard and only overwrite the first two of them
+        if (result == TestResult::Passed)
+        {
+            if (std::uint32_t* words = MapWords(CPUAccess::WriteDiscard, 0, 4))
+            {
+                if (isCopyOnMap)
+                {
+                    // Entire buffer is discarded, and the mapped range starts with the uninitialized pattern
+                    for (std::uint32_t& word : expectedData)
+                        word = uninitializedWord;
+                }
+
+                for_range(i, 2)
+                    words[i] = expectedData[i] = 0x3000u + i;
+                mapRenderer.UnmapBuffer(*buf);
+                if (!CompareBufferContent("WriteDiscard mapping"))
+                    result = TestResult::FailedMismatch;
+            }
+            else
+                result = TestResult::FailedErrors;
+        }
+
+        mapRenderer.Release(*buf);
+
+        return result;
+    };
+
+    // Load separate Null renderers for direct mapping and for mapping via temporary copies
+    const long modeFlags[2] = { 0, RenderSystemFlags::DebugDevice };
+
+    for (long flags : modeFlags)
+    {
+        RenderSystemDescriptor mapRendererDesc;
+        {
+            mapRendererDesc.moduleName  = "Null";
+            mapRendererDesc.flags       = flags;
+        }
+        Report report;
+        RenderSystemPtr mapRenderer = RenderSystem::Load(mapRendererDesc, &report);
+        if (!mapRenderer)
+        {
+            Log::Errorf("Failed to load Null renderer for buffer mapping: %s", report.GetText());
+            return TestResult::FailedErrors;
+        }
+
+        const TestResult result = TestMapping(*mapRenderer, (flags & RenderSystemFlags::DebugDevice) != 0);
+        if (result != TestResult::Passed)
+            return result;
+    }
+
+    return TestResult::Passed;
+}
+
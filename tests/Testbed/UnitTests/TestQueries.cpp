@@ -0,0 +1,219 @@
+/*
+ * TestQueries.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+
+
+/*
+Tests occlusion, pipeline statistics, and time elapsed queries by drawing a known number of pixel-aligned rectangles.
+Occlusion queries must count exactly the number of covered pixels and input assembly statistics must match the draw calls.
+*/
+DEF_TEST( Queries )
+{
+    if (shaders[VSUnprojected] == nullptr || shaders[PSUnprojected] == nullptr)
+    {
+        Log::Errorf("Missing shaders for backend\n");
+        return TestResult::FailedErrors;
+    }
+
+    constexpr std::uint32_t numRects        = 4;
+    constexpr std::uint32_t rectSize        = 100;
+    constexpr std::uint32_t numRectVertices = numRects * 6;
+    constexpr std::uint32_t numRepetitions  = 16;
+
+    const Extent2D resolution = opt.resolution;
+    if (resolution.width < rectSize * 4 || resolution.height < rectSize * 4)
+    {
+        Log::Errorf("Resolution is too small to draw %u rectangles of %ux%u pixels\n", numRects, rectSize, rectSize);
+        return TestResult::FailedErrors;
+    }
+
+    // Generate pixel-aligned rectangles that don't overlap and another one outside the viewport
+    auto GenerateRectVertices = [&resolution](UnprojectedVertex* vertices, std::uint32_t x, std::uint32_t y, std::uint32_t size) -> void
+    {
+        const float left    = static_cast<float>(x       ) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float right   = static_cast<float>(x + size) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float top     = 1.0f - static_cast<float>(y       ) / static_cast<float>(resolution.height) * 2.0f;
+        const float bottom  = 1.0f - static_cast<float>(y + size) / static_cast<float>(resolution.height) * 2.0f;
+
+        vertices[0] = UnprojectedVertex{ { left,  top    }, { 255,   0,   0, 255 } };
+        vertices[1] = UnprojectedVertex{ { right, top    }, {   0, 255,   0, 255 } };
+        vertices[2] = UnprojectedVertex{ { left,  bottom }, {   0,   0, 255, 255 } };
+        vertices[3] = UnprojectedVertex{ { left,  bottom }, {   0,   0, 255, 255 } };
+        vertices[4] = UnprojectedVertex{ { right, top    }, {   0, 255,   0, 255 } };
+        vertices[5] = UnprojectedVertex{ { right, bottom }, { 255, 255, 255, 255 } };
+    };
+
+    UnprojectedVertex vertices[numRectVertices + 6];
+    GenerateRectVertices(&vertices[ 0], rectSize * 1, rectSize * 1, rectSize);
+    GenerateRectVertices(&vertices[ 6], rectSize * 3, rectSize * 1, rectSize);
+    GenerateRectVertices(&vertices[12], rectSize * 1, rectSize * 3, rectSize);
+    GenerateRectVertices(&vertices[18], rectSize * 3, rectSize * 3, rectSize);
+
+    for_range(i, 6)
+    {
+        vertices[numRectVertices + i] = vertices[i];
+        vertices[numRectVertices + i].position[0] += 4.0f;
+    }
+
+    BufferDescriptor vertexBufDesc;
+    {
+        vertexBufDesc.size          = sizeof(vertices);
+        vertexBufDesc.bindFlags     = BindFlags::VertexBuffer;
+        vertexBufDesc.vertexAttribs = vertexFormats[VertFmtUnprojected].attributes;
+    }
+    CREATE_BUFFER(vertexBuf, vertexBufDesc, "queries.vertices", vertices);
+
+    GraphicsPipelineDescriptor psoDesc;
+    {
+        psoDesc.pipelineLayout      = nullptr; // No resource bindings, therefore no pipeline layout
+        psoDesc.renderPass          = swapChain->GetRenderPass();
+        psoDesc.vertexShader        = shaders[VSUnprojected];
+        psoDesc.fragmentShader      = shaders[PSUnprojected];
+        psoDesc.primitiveTopology   = PrimitiveTopology::TriangleList;
+    }
+    CREATE_GRAPHICS_PSO(pso, psoDesc, "psoQueries");
+
+    // Create query heaps: occlusion queries for visible and culled rectangles, one statistics query, and time queries for light and heavy workload
+    QueryHeapDescriptor occlusionQueryDesc;
+    {
+        occlusionQueryDesc.type         = QueryType::SamplesPassed;
+        occlusionQueryDesc.numQueries   = 2;
+    }
+    QueryHeap* occlusionQuery = renderer->CreateQueryHeap(occlusionQueryDesc);
+
+    QueryHeap* statisticsQuery = nullptr;
+    if (caps.features.hasPipelineStatistics)
+    {
+        QueryHeapDescriptor statisticsQueryDesc;
+        {
+            statisticsQueryDesc.type        = QueryType::PipelineStatistics;
+            statisticsQueryDesc.numQueries  = 1;
+        }
+        statisticsQuery = renderer->CreateQueryHeap(statisticsQueryDesc);
+    }
+
+    QueryHeapDescriptor timerQueryDesc;
+    {
+        timerQueryDesc.type         = QueryType::TimeElapsed;
+        timerQueryDesc.numQueries   = 2;
+    }
+    QueryHeap* timerQuery = renderer->CreateQueryHeap(timerQueryDesc);
+
+    // Render scene
+    BEGIN();
+    {
+        cmdBuffer->SetVertexBuffer(*vertexBuf);
+        cmdBuffer->BeginRenderPass(*swapChain);
+        {
+            cmdBuffer->Clear(ClearFlags::Color);
+            cmdBuffer->SetViewport(resolution);
+            cmdBuffer->SetPipelineState(*pso);
+
+            // Draw visible rectangles
+            cmdBuffer->BeginQuery(*occlusionQuery, 0);
+            {
+                if (statisticsQuery != nullptr)
+                    cmdBuffer->BeginQuery(*statisticsQuery, 0);
+
+                cmdBuffer->BeginQuery(*timerQuery, 0);
+                cmdBuffer->Draw(numRectVertices, 0);
+                cmdBuffer->EndQuery(*timerQuery, 0);
+
+                if (statisticsQuery != nullptr)
+                    cmdBuffer->EndQuery(*statisticsQuery, 0);
+            }
+            cmdBuffer->EndQuery(*occlusionQuery, 0);
+
+            // Draw rectangle outside the viewport
+            cmdBuffer->BeginQuery(*occlusionQuery, 1);
+            cmdBuffer->Draw(6, numRectVertices);
+            cmdBuffer->EndQuery(*occlusionQuery, 1);
+
+            // Draw visible rectangles repeatedly for a heavier workload
+            cmdBuffer->BeginQuery(*timerQuery, 1);
+            for_range(i, numRepetitions)
+                cmdBuffer->Draw(numRectVertices, 0);
+            cmdBuffer->EndQuery(*timerQuery, 1);
+        }
+        cmdBuffer->EndRenderPass();
+    }
+    END();
+
+    cmdQueue->WaitIdle();
+
+    // Evaluate query results
+    TestResult result = TestResult::Passed;
+
+    auto EvaluateQueryValue = [&result](const char* name, std::uint64_t actualValue, std::uint64_t expectedValue, bool exactMatch) -> void
+    {
+        if (exactMatch ? (actualValue != expectedValue) : (actualValue < expectedValue))
+        {
+            Log::Errorf(
+                "Mismatch between query result %s (%" PRIu64 ") and expected value (%s%" PRIu64 ")\n",
+                name, actualValue, (exactMatch ? "" : ">= "), expectedValue
+            );
+            result = TestResult::FailedMismatch;
+        }
+    };
+
+    constexpr std::uint64_t numRectSamples = static_cast<std::uint64_t>(numRects) * rectSize * rectSize;
+
+    std::uint64_t occlusionResults[2] = {};
+    if (!cmdQueue->QueryResult(*occlusionQuery, 0, 2, occlusionResults, sizeof(occlusionResults)))
+    {
+        Log::Errorf("Failed to retrieve results of occlusion queries\n");
+        return TestResult::FailedErrors;
+    }
+
+    EvaluateQueryValue("samplesPassed[visible]", occlusionResults[0], numRectSamples, true);
+    EvaluateQueryValue("samplesPassed[culled]",  occlusionResults[1], 0, true);
+
+    if (statisticsQuery != nullptr)
+    {
+        QueryPipelineStatistics statistics;
+        if (!cmdQueue->QueryResult(*statisticsQuery, 0, 1, &statistics, sizeof(statistics)))
+        {
+            Log::Errorf("Failed to retrieve result of pipeline statistics query\n");
+            return TestResult::FailedErrors;
+        }
+
+        EvaluateQueryValue("inputAssemblyVertices",     statistics.inputAssemblyVertices,       numRectVertices,        true);
+        EvaluateQueryValue("inputAssemblyPrimitives",   statistics.inputAssemblyPrimitives,     numRects * 2,           true);
+        EvaluateQueryValue("vertexShaderInvocations",   statistics.vertexShaderInvocations,     4 * numRects,           false);
+        EvaluateQueryValue("clippingInvocations",       statistics.clippingInvocations,         numRects * 2,           false);
+        EvaluateQueryValue("fragmentShaderInvocations", statistics.fragmentShaderInvocations,   numRectSamples,         false);
+    }
+
+    std::uint64_t timerResults[2] = {};
+    if (!cmdQueue->QueryResult(*timerQuery, 0, 2, timerResults, sizeof(timerResults)))
+    {
+        Log::Errorf("Failed to retrieve results of time elapsed queries\n");
+        return TestResult::FailedErrors;
+    }
+
+    if (opt.verbose)
+        Log::Printf("Time elapsed for 1 and %u draw calls: %" PRIu64 " ns, %" PRIu64 " ns\n", numRepetitions, timerResults[0], timerResults[1]);
+
+    EvaluateQueryValue("timeElapsed[light]", timerResults[0], 1, false);
+    EvaluateQueryValue("timeElapsed[heavy]", timerResults[1], 1, false);
+
+    // CPU execution time of the Null backend scales with its workload, unlike small workloads on a GPU
+    if (renderer->GetRendererID() == RendererID::Null)
+        EvaluateQueryValue("timeElapsed[heavy]", timerResults[1], timerResults[0], false);
+
+    // Delete old resources
+    renderer->Release(*occlusionQuery);
+    if (statisticsQuery != nullptr)
+        renderer->Release(*statisticsQuery);
+    renderer->Release(*timerQuery);
+    renderer->Release(*pso);
+    renderer->Release(*vertexBuf);
+
+    return result;
+}
+
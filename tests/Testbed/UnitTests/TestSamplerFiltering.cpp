@@ -0,0 +1,336 @@
+/*
+ * TestSamplerFiltering.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <cmath>
+
+
+/*
+Tests sampler filters and address modes by sampling a small texture with known texels in pixel-aligned rectangles.
+The texture stores its X coordinate in the red channel, its Y coordinate in the green channel, and its MIP-map level in the blue channel,
+so each pixel of the magnified rectangles can be validated exactly for nearest and linear filters with repeat, mirror, and clamp address modes.
+Two minified rectangles validate the MIP-map selection for a whole and a fractional level of detail with linear MIP-map filter.
+*/
+DEF_TEST( SamplerFiltering )
+{
+    if (shaders[VSTextured] == nullptr || shaders[PSTextured] == nullptr)
+    {
+        Log::Errorf("Missing shaders for backend\n");
+        return TestResult::FailedErrors;
+    }
+
+    constexpr std::uint32_t texSize         = 4;
+    constexpr std::uint32_t numMips         = 3;
+    constexpr std::uint32_t cellSpacing     = 16;
+    constexpr std::uint32_t magCellSize     = 32;   // 16 texels across 32 pixels, i.e. magnified by 2
+    constexpr std::uint32_t minCellSize     = 16;
+    constexpr float         magCellCoords[2] = { -1.0f, 3.0f };
+
+    const Extent2D resolution = opt.resolution;
+
+    // Create texture with distinct texels for each MIP-map level; 'mipMarkers' identifies the level in the blue channel
+    const std::uint8_t mipMarkers[numMips] = { 0, 128, 255 };
+
+    auto GetTexelValue = [](std::int32_t coord, std::uint32_t size) -> float
+    {
+        return static_cast<float>(coord * static_cast<std::int32_t>(256 / size));
+    };
+
+    TextureDescriptor texDesc;
+    {
+        texDesc.type        = TextureType::Texture2D;
+        texDesc.bindFlags   = BindFlags::Sampled;
+        texDesc.format      = Format::RGBA8UNorm;
+        texDesc.extent      = Extent3D{ texSize, texSize, 1 };
+        texDesc.mipLevels   = numMips;
+        texDesc.miscFlags   = MiscFlags::NoInitialData;
+    }
+    CREATE_TEXTURE(tex, texDesc, "samplerFiltering.tex", nullptr);
+
+    for_range(mip, numMips)
+    {
+        const std::uint32_t mipSize = texSize >> mip;
+
+        std::vector<std::uint8_t> texels;
+        texels.resize(mipSize * mipSize * 4);
+
+        for_range(y, mipSize)
+        {
+            for_range(x, mipSize)
+            {
+                std::uint8_t* texel = &texels[(y * mipSize + x) * 4];
+                texel[0] = static_cast<std::uint8_t>(GetTexelValue(x, mipSize));
+                texel[1] = static_cast<std::uint8_t>(GetTexelValue(y, mipSize));
+                texel[2] = mipMarkers[mip];
+                texel[3] = 255;
+            }
+        }
+
+        ImageView srcImage;
+        {
+            srcImage.format     = ImageFormat::RGBA;
+            srcImage.dataType   = DataType::UInt8;
+            srcImage.data       = texels.data();
+            srcImage.dataSize   = texels.size();
+        }
+        renderer->WriteTexture(*tex, TextureRegion{ TextureSubresource{ 0, mip }, Offset3D{}, Extent3D{ mipSize, mipSize, 1 } }, srcImage);
+    }
+
+    // Describe test cases: Magnified rectangles for each filter and address mode, and minified rectangles for MIP-map selection
+    struct SamplerCase
+    {
+        const char*         name;
+        SamplerFilter       filter;
+        SamplerAddressMode  addressMode;
+        float               lodBias;
+        std::uint32_t       cellSize;
+        float               coords[2];  // Texture coordinates at the left/top and right/bottom edges of the rectangle.
+        float               lod;        // Expected level of detail for minified rectangles.
+    };
+
+    const SamplerCase samplerCases[] =
+    {
+        { "nearest/repeat",     SamplerFilter::Nearest, SamplerAddressMode::Repeat, 0.0f, magCellSize, { magCellCoords[0], magCellCoords[1] }, 0.0f },
+        { "nearest/mirror",     SamplerFilter::Nearest, SamplerAddressMode::Mirror, 0.0f, magCellSize, { magCellCoords[0], magCellCoords[1] }, 0.0f },
+        { "nearest/clamp",      SamplerFilter::Nearest, SamplerAddressMode::Clamp,  0.0f, magCellSize, { magCellCoords[0], magCellCoords[1] }, 0.0f },
+        { "linear/repeat",      SamplerFilter::Linear,  SamplerAddressMode::Repeat, 0.0f, magCellSize, { magCellCoords[0], magCellCoords[1] }, 0.0f },
+        { "linear/mirror",      SamplerFilter::Linear,  SamplerAddressMode::Mirror, 0.0f, magCellSize, { magCellCoords[0], magCellCoords[1] }, 0.0f },
+        { "linear/clamp",       SamplerFilter::Linear,  SamplerAddressMode::Clamp,  0.0f, magCellSize, { magCellCoords[0], magCellCoords[1] }, 0.0f },
+        { "mip-linear/lod1",    SamplerFilter::Nearest, SamplerAddressMode::Repeat, 0.0f, minCellSize, { 0.0f, 8.0f },                         1.0f }, // 2 texels per pixel
+        { "mip-linear/lod0.5",  SamplerFilter::Nearest, SamplerAddressMode::Repeat, 0.5f, minCellSize, { 0.0f, 4.0f },                         0.5f }, // 1 texel per pixel plus LOD bias
+    };
+
+    constexpr std::uint32_t numCases = sizeof(samplerCases)/sizeof(samplerCases[0]);
+
+    auto GetCellOrigin = [](std::uint32_t index) -> Offset2D
+    {
+        return Offset2D
+        {
+            static_cast<std::int32_t>(cellSpacing + (index % 4) * (magCellSize + cellSpacing)),
+            static_cast<std::int32_t>(cellSpacing + (index / 4) * (magCellSize + cellSpacing)),
+        };
+    };
+
+    if (resolution.width < (magCellSize + cellSpacing) * 4 + cellSpacing ||
+        resolution.height < (magCellSize + cellSpacing) * ((numCases + 3) / 4) + cellSpacing)
+    {
+        Log::Errorf("Resolution is too small to draw %u rectangles of %ux%u pixels\n", numCases, magCellSize, magCellSize);
+        return TestResult::FailedErrors;
+    }
+
+    // Generate a rectangle for each case in clip space; normals point towards the light, so the shading factor is 1
+    std::vector<StandardVertex> vertices;
+    vertices.reserve(numCases * 4);
+
+    for_range(i, numCases)
+    {
+        const SamplerCase&  samplerCase = samplerCases[i];
+        const Offset2D      origin      = GetCellOrigin(i);
+
+        const float left    = static_cast<float>(origin.x                       ) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float right   = static_cast<float>(origin.x + samplerCase.cellSize) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float top     = 1.0f - static_cast<float>(origin.y                       ) / static_cast<float>(resolution.height) * 2.0f;
+        const float bottom  = 1.0f - static_cast<float>(origin.y + samplerCase.cellSize) / static_cast<float>(resolution.height) * 2.0f;
+
+        const float t0 = samplerCase.coords[0];
+        const float t1 = samplerCase.coords[1];
+
+        vertices.push_back(StandardVertex{ { left,  top,    0.5f }, { 0, 0, -1 }, { t0, t0 } });
+        vertices.push_back(StandardVertex{ { left,  bottom, 0.5f }, { 0, 0, -1 }, { t0, t1 } });
+        vertices.push_back(StandardVertex{ { right, top,    0.5f }, { 0, 0, -1 }, { t1, t0 } });
+        vertices.push_back(StandardVertex{ { right, bottom, 0.5f }, { 0, 0, -1 }, { t1, t1 } });
+    }
+
+    BufferDescriptor vertexBufDesc;
+    {
+        vertexBufDesc.size          = vertices.size() * sizeof(StandardVertex);
+        vertexBufDesc.bindFlags     = BindFlags::VertexBuffer;
+        vertexBufDesc.vertexAttribs = vertexFormats[VertFmtStd].attributes;
+    }
+    CREATE_BUFFER(vertexBuf, vertexBufDesc, "samplerFiltering.vertices", vertices.data());
+
+    Sampler* caseSamplers[numCases] = {};
+
+    for_range(i, numCases)
+    {
+        SamplerDescriptor samplerDesc;
+        {
+            samplerDesc.addressModeU    = samplerCases[i].addressMode;
+            samplerDesc.addressModeV    = samplerCases[i].addressMode;
+            samplerDesc.addressModeW    = samplerCases[i].addressMode;
+            samplerDesc.minFilter       = samplerCases[i].filter;
+            samplerDesc.magFilter       = samplerCases[i].filter;
+            samplerDesc.mipMapFilter    = SamplerFilter::Linear;
+            samplerDesc.mipMapLODBias   = samplerCases[i].lodBias;
+        }
+        caseSamplers[i] = renderer->CreateSampler(samplerDesc);
+    }
+
+    GraphicsPipelineDescriptor psoDesc;
+    {
+        psoDesc.pipelineLayout      = layouts[PipelineTextured];
+        psoDesc.renderPass          = swapChain->GetRenderPass();
+        psoDesc.vertexShader        = shaders[VSTextured];
+        psoDesc.fragmentShader      = shaders[PSTextured];
+        psoDesc.primitiveTopology   = PrimitiveTopology::TriangleStrip;
+    }
+    CREATE_GRAPHICS_PSO(pso, psoDesc, "psoSamplerFiltering");
+
+    // Draw rectangles with identity transformations, i.e. the vertices are already in clip space
+    sceneConstants = SceneConstants{};
+    sceneConstants.vpMatrix.LoadIdentity();
+    sceneConstants.wMatrix.LoadIdentity();
+
+    Texture* readbackTex = nullptr;
+
+    BEGIN();
+    {
+        cmdBuffer->UpdateBuffer(*sceneCbuffer, 0, &sceneConstants, sizeof(sceneConstants));
+        cmdBuffer->SetVertexBuffer(*vertexBuf);
+        cmdBuffer->BeginRenderPass(*swapChain);
+        {
+            cmdBuffer->Clear(ClearFlags::ColorDepth, bgColorDarkBlue);
+            cmdBuffer->SetViewport(resolution);
+            cmdBuffer->SetPipelineState(*pso);
+            cmdBuffer->SetResource(0, *sceneCbuffer);
+            cmdBuffer->SetResource(1, *tex);
+
+            for_range(i, numCases)
+            {
+                cmdBuffer->SetResource(2, *caseSamplers[i]);
+                cmdBuffer->Draw(4, i * 4);
+            }
+
+            readbackTex = CaptureFramebuffer(*cmdBuffer, swapChain->GetColorFormat(), resolution);
+        }
+        cmdBuffer->EndRenderPass();
+    }
+    END();
+
+    // Read entire framebuffer capture
+    std::vector<std::uint8_t> readbackImage;
+    readbackImage.resize(resolution.width * resolution.height * 4);
+
+    MutableImageView dstImage;
+    {
+        dstImage.format     = ImageFormat::RGBA;
+        dstImage.dataType   = DataType::UInt8;
+        dstImage.data       = readbackImage.data();
+        dstImage.dataSize   = readbackImage.size();
+    }
+    renderer->ReadTexture(*readbackTex, TextureRegion{ Offset3D{}, Extent3D{ resolution.width, resolution.height, 1 } }, dstImage);
+
+    // Returns the texel index for the specified address mode
+    auto AddressTexel = [](SamplerAddressMode addressMode, std::int32_t coord, std::int32_t size) -> std::int32_t
+    {
+        switch (addressMode)
+        {
+            case SamplerAddressMode::Repeat:
+                return ((coord % size) + size) % size;
+            case SamplerAddressMode::Mirror:
+            {
+                const std::int32_t mirrored = ((coord % (size * 2)) + size * 2) % (size * 2);
+                return (mirrored < size ? mirrored : size * 2 - 1 - mirrored);
+            }
+            default:
+                return std::max(0, std::min(coord, size - 1));
+        }
+    };
+
+    // Returns the expected red or green channel (in the range [0, 255]) at the specified unnormalized texture coordinate of a MIP-map level
+    auto SampleTexels = [&AddressTexel, &GetTexelValue](SamplerFilter filter, SamplerAddressMode addressMode, float coord, std::uint32_t size) -> float
+    {
+        const std::int32_t isize = static_cast<std::int32_t>(size);
+        if (filter == SamplerFilter::Nearest)
+        {
+            const std::int32_t texel = static_cast<std::int32_t>(std::floor(coord));
+            return GetTexelValue(AddressTexel(addressMode, texel, isize), size);
+        }
+        else
+        {
+            const float         center  = coord - 0.5f;
+            const std::int32_t  texel   = static_cast<std::int32_t>(std::floor(center));
+            const float         weight  = center - std::floor(center);
+            return
+            (
+                GetTexelValue(AddressTexel(addressMode, texel,     isize), size) * (1.0f - weight) +
+                GetTexelValue(AddressTexel(addressMode, texel + 1, isize), size) * weight
+            );
+        }
+    };
+
+    // Evaluate each pixel of each rectangle
+    TestResult result = TestResult::Passed;
+
+    for_range(i, numCases)
+    {
+        const SamplerCase&  samplerCase = samplerCases[i];
+        const Offset2D      origin      = GetCellOrigin(i);
+
+        // Blend between the two nearest MIP-map levels
+        const std::uint32_t mipLow      = static_cast<std::uint32_t>(samplerCase.lod);
+        const std::uint32_t mipHigh     = std::min(mipLow + 1, numMips - 1);
+        const float         mipWeight   = samplerCase.lod - static_cast<float>(mipLow);
+
+        auto GetExpectedChannel = [&](std::uint32_t pixel) -> float
+        {
+            const float coord = samplerCase.coords[0] + (static_cast<float>(pixel) + 0.5f) / static_cast<float>(samplerCase.cellSize) * (samplerCase.coords[1] - samplerCase.coords[0]);
+            const float value0 = SampleTexels(samplerCase.filter, samplerCase.addressMode, coord * static_cast<float>(texSize >> mipLow), texSize >> mipLow);
+            const float value1 = SampleTexels(samplerCase.filter, samplerCase.addressMode, coord * static_cast<float>(texSize >> mipHigh), texSize >> mipHigh);
+            return value0 * (1.0f - mipWeight) + value1 * mipWeight;
+        };
+
+        const float expectedBlue = static_cast<float>(mipMarkers[mipLow]) * (1.0f - mipWeight) + static_cast<float>(mipMarkers[mipHigh]) * mipWeight;
+
+        bool hasMismatch = false;
+
+        for (std::uint32_t y = 0; y < samplerCase.cellSize && !hasMismatch; ++y)
+        {
+            for_range(x, samplerCase.cellSize)
+            {
+                const std::uint8_t expectedColor[4] =
+                {
+                    static_cast<std::uint8_t>(std::min(GetExpectedChannel(x) + 0.5f, 255.0f)),
+                    static_cast<std::uint8_t>(std::min(GetExpectedChannel(y) + 0.5f, 255.0f)),
+                    static_cast<std::uint8_t>(expectedBlue + 0.5f),
+                    255
+                };
+
+                const std::uint8_t* actualColor = &readbackImage[((origin.y + y) * resolution.width + (origin.x + x)) * 4];
+                if (!IsRGBA8ubInThreshold(actualColor, expectedColor))
+                {
+                    Log::Errorf(
+                        "Mismatch between sampler [%s] at pixel (%u, %u) color [%02X %02X %02X %02X] and expected color [%02X %02X %02X %02X]\n",
+                        samplerCase.name, x, y,
+                        actualColor[0], actualColor[1], actualColor[2], actualColor[3],
+                        expectedColor[0], expectedColor[1], expectedColor[2], expectedColor[3]
+                    );
+                    hasMismatch = true;
+                    break;
+                }
+            }
+        }
+
+        if (hasMismatch)
+        {
+            result = TestResult::FailedMismatch;
+            if (!opt.greedy)
+                break;
+        }
+    }
+
+    // Delete old resources
+    renderer->Release(*readbackTex);
+    renderer->Release(*pso);
+    for (Sampler* sampler : caseSamplers)
+        renderer->Release(*sampler);
+    renderer->Release(*vertexBuf);
+    renderer->Release(*tex);
+
+    return result;
+}
+
@@ -0,0 +1,573 @@
+/*
+ * TestSpirvInterpreter.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/Parse.h>
+#include <cmath>
+
+
+#if LLGL_TESTBED_INCLUDE_NULL_SPIRV_TESTS
+
+/*
+Execute the SPIR-V modules from the tests/Shaders/ folder with the CPU interpreter of the Null renderer.
+Frame 0 renders a textured quad with Triangle.vert/.frag into the right half of a small render target and compares every pixel.
+Frame 1 dispatches SpirvReflectTest.comp and compares the storage buffer and storage image against the CPU reference.
+Frame 2 dispatches WorkgroupReduction.comp over several workgroups, directly and indirectly, and compares the sum of each workgroup,
+which requires shared memory and barriers to be synchronized across all invocations of a workgroup.
+This test is only included if the Null renderer was built with LLGL_NULL_ENABLE_SPIRV_EXECUTION.
+*/
+DEF_TEST( SpirvInterpreter )
+{
+    if (renderer->GetRendererID() != RendererID::Null)
+        return TestResult::Skipped;
+
+    static TestResult result = TestResult::Passed;
+    constexpr unsigned numFrames = 3;
+
+    if (frame == 0)
+        result = TestResult::Passed;
+
+    auto LoadSpirvShader = [this](const char* filename, ShaderType type, const VertexFormat* vertexFormat = nullptr) -> Shader*
+    {
+        const std::string filePath = std::string("../Shaders/") + filename;
+        ShaderDescriptor shaderDesc;
+        {
+            shaderDesc.type         = type;
+            shaderDesc.source       = filePath.c_str();
+            shaderDesc.sourceType   = ShaderSourceType::BinaryFile;
+            if (vertexFormat != nullptr)
+                shaderDesc.vertex.inputAttribs = vertexFormat->attributes;
+        }
+        Shader* shader = renderer->CreateShader(shaderDesc);
+        if (const Report* report = shader->GetReport())
+        {
+            if (report->HasErrors())
+            {
+                Log::Errorf("Failed to load SPIR-V shader: %s\n%s", filePath.c_str(), report->GetText());
+                renderer->Release(*shader);
+                return nullptr;
+            }
+        }
+        return shader;
+    };
+
+    auto IsFloatEqual = [](float lhs, float rhs) -> bool
+    {
+        return (std::abs(lhs - rhs) <= 1.0e-5f);
+    };
+
+    if (frame == 0)
+    {
+        // Load shaders; Triangle.vert reads a 2D position, texture coordinate, and RGB color per vertex
+        VertexFormat vertexFormat;
+        vertexFormat.AppendAttribute({ "coord",    Format::RG32Float  });
+        vertexFormat.AppendAttribute({ "texCoord", Format::RG32Float  });
+        vertexFormat.AppendAttribute({ "color",    Format::RGB32Float });
+
+        Shader* vertShader = LoadSpirvShader("Triangle.vert.spv", ShaderType::Vertex, &vertexFormat);
+        Shader* fragShader = LoadSpirvShader("Triangle.frag.spv", ShaderType::Fragment);
+        if (vertShader == nullptr || fragShader == nullptr)
+            return TestResult::FailedErrors;
+
+        // Create fullscreen quad as triangle strip; texture coordinates start at the top-left corner
+        struct TriangleVertex
+        {
+            float coord[2];
+            float texCoord[2];
+            float color[3];
+        };
+        const float vertexColor[3] = { 1.0f, 0.5f, 0.25f };
+        const TriangleVertex vertices[4] =
+        {
+            { { -1.0f, +1.0f }, { 0.0f, 0.0f }, { vertexColor[0], vertexColor[1], vertexColor[2] } },
+            { { +1.0f, +1.0f }, { 1.0f, 0.0f }, { vertexColor[0], vertexColor[1], vertexColor[2] } },
+            { { -1.0f, -1.0f }, { 0.0f, 1.0f }, { vertexColor[0], vertexColor[1], vertexColor[2] } },
+            { { +1.0f, -1.0f }, { 1.0f, 1.0f }, { vertexColor[0], vertexColor[1], vertexColor[2] } },
+        };
+
+        BufferDescriptor vertexBufferDesc;
+        {
+            vertexBufferDesc.size           = sizeof(vertices);
+            vertexBufferDesc.bindFlags      = BindFlags::VertexBuffer;
+            vertexBufferDesc.vertexAttribs  = vertexFormat.attributes;
+        }
+        CREATE_BUFFER(vertexBuffer, vertexBufferDesc, "spirv.vertices", vertices);
+
+        // Scale quad into the right half of the viewport; matrices are stored in column-major order
+        const float matrices[2][16] =
+        {
+            // projection
+            {
+                1.0f, 0.0f, 0.0f, 0.0f,
+                0.0f, 1.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 1.0f, 0.0f,
+                0.0f, 0.0f, 0.0f, 1.0f,
+            },
+            // modelView
+            {
+                0.5f, 0.0f, 0.0f, 0.0f,
+                0.0f, 1.0f, 0.0f, 0.0f,
+                0.0f, 0.0f, 1.0f, 0.0f,
+                0.5f, 0.0f, 0.0f, 1.0f,
+            },
+        };
+        BufferDescriptor matricesBufferDesc;
+        {
+            matricesBufferDesc.size         = sizeof(matrices);
+            matricesBufferDesc.bindFlags    = BindFlags::ConstantBuffer;
+        }
+        CREATE_BUFFER(matricesBuffer, matricesBufferDesc, "spirv.Matrices", matrices);
+
+        const float diffuse[4] = { 0.5f, 1.0f, 1.0f, 1.0f };
+        BufferDescriptor colorsBufferDesc;
+        {
+            colorsBufferDesc.size       = sizeof(diffuse);
+            colorsBufferDesc.bindFlags  = BindFlags::ConstantBuffer;
+        }
+        CREATE_BUFFER(colorsBuffer, colorsBufferDesc, "spirv.Colors", diffuse);
+
+        // Create 2x2 texture; the transparent texel must be replaced by white in the fragment shader
+        const std::uint8_t texels[2][2][4] =
+        {
+            { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFF, 0x00, 0x00, 0xFF } },
+            { { 0x00, 0xFF, 0x00, 0xFF }, { 0x00, 0x00, 0xFF, 0x00 } },
+        };
+        TextureDescriptor texDesc;
+        {
+            texDesc.type        = TextureType::Texture2D;
+            texDesc.format      = Format::RGBA8UNorm;
+            texDesc.extent      = Extent3D{ 2, 2, 1 };
+            texDesc.mipLevels   = 1;
+            texDesc.bindFlags   = BindFlags::Sampled;
+        }
+        const ImageView texImage{ ImageFormat::RGBA, DataType::UInt8, texels, sizeof(texels) };
+        CREATE_TEXTURE(tex, texDesc, "spirv.tex", &texImage);
+
+        Sampler* texSampler = renderer->CreateSampler(Parse("filter=nearest,address=clamp"));
+
+        // Create render target to read back the result
+        constexpr std::uint32_t targetSize = 8;
+        TextureDescriptor targetTexDesc;
+        {
+            targetTexDesc.type      = TextureType::Texture2D;
+            targetTexDesc.format    = Format::RGBA8UNorm;
+            targetTexDesc.extent    = Extent3D{ targetSize, targetSize, 1 };
+            targetTexDesc.mipLevels = 1;
+            targetTexDesc.bindFlags = BindFlags::ColorAttachment | BindFlags::CopySrc;
+        }
+        CREATE_TEXTURE(targetTex, targetTexDesc, "spirv.target", nullptr);
+
+        RenderTargetDescriptor targetDesc;
+        {
+            targetDesc.resolution           = Extent2D{ targetSize, targetSize };
+            targetDesc.colorAttachments[0]  = targetTex;
+        }
+        CREATE_RENDER_TARGET(target, targetDesc, "spirv.renderTarget");
+
+        // Create graphics PSO with the resources that are declared in the SPIR-V modules
+        PipelineLayout* psoLayout = renderer->CreatePipelineLayout(
+            Parse(
+                "cbuffer(Matrices@2):vert,"
+                "sampler(texSampler@3):frag,"
+                "texture(tex@4):frag,"
+                "cbuffer(Colors@5):frag,"
+            )
+        );
+
+        GraphicsPipelineDescriptor psoDesc;
+        {
+            psoDesc.pipelineLayout      = psoLayout;
+            psoDesc.renderPass          = target->GetRenderPass();
+            psoDesc.vertexShader        = vertShader;
+            psoDesc.fragmentShader      = fragShader;
+            psoDesc.primitiveTopology   = PrimitiveTopology::TriangleStrip;
+        }
+        CREATE_GRAPHICS_PSO(pso, psoDesc, "spirv.PSO");
+
+        // Render quad
+        const ClearValue clearValue{ 0.0f, 0.0f, 0.0f, 1.0f };
+
+        BEGIN();
+        {
+            cmdBuffer->SetVertexBuffer(*vertexBuffer);
+            cmdBuffer->BeginRenderPass(*target);
+            {
+                cmdBuffer->Clear(ClearFlags::Color, clearValue);
+                cmdBuffer->SetViewport(Extent2D{ targetSize, targetSize });
+                cmdBuffer->SetPipelineState(*pso);
+                cmdBuffer->SetResource(0, *matricesBuffer);
+                cmdBuffer->SetResource(1, *texSampler);
+                cmdBuffer->SetResource(2, *tex);
+                cmdBuffer->SetResource(3, *colorsBuffer);
+                cmdBuffer->Draw(4, 0);
+            }
+            cmdBuffer->EndRenderPass();
+        }
+        END();
+
+        // Read back render target and compare each pixel with the expected result
+        std::uint8_t pixels[targetSize][targetSize][4] = {};
+        MutableImageView pixelsView{ ImageFormat::RGBA, DataType::UInt8, pixels, sizeof(pixels) };
+        renderer->ReadTexture(*targetTex, TextureRegion{ Offset3D{}, targetTexDesc.extent }, pixelsView);
+
+        auto EvalExpectedPixel = [&](std::uint32_t x, std::uint32_t y, std::uint8_t (&outColor)[4]) -> void
+        {
+            // Left half is only cleared
+            if (x < targetSize/2)
+            {
+                for_range(i, 4)
+                    outColor[i] = static_cast<std::uint8_t>(clearValue.color[i] * 255.0f + 0.5f);
+                return;
+            }
+
+            // Right half samples one texel per quadrant and multiplies it by the diffuse and vertex color
+            const std::uint8_t (&texel)[4] = texels[y / (targetSize/2)][(x - targetSize/2) / (targetSize/4)];
+            float color[4];
+            for_range(i, 4)
+                color[i] = diffuse[i] * (i < 3 ? vertexColor[i] : 1.0f) * (static_cast<float>(texel[i]) / 255.0f);
+
+            // Blend with white by the alpha channel as done in the fragment shader
+            for_range(i, 3)
+                color[i] = 1.0f + (color[i] - 1.0f) * color[3];
+            color[3] = 1.0f;
+
+            for_range(i, 4)
+                outColor[i] = static_cast<std::uint8_t>(color[i] * 255.0f + 0.5f);
+        };
+
+        for_range(y, targetSize)
+        {
+            for_range(x, targetSize)
+            {
+                std::uint8_t expectedColor[4];
+                EvalExpectedPixel(x, y, expectedColor);
+                const std::uint8_t (&actualColor)[4] = pixels[y][x];
+                if (!TestbedContext::IsRGBA8ubInThreshold(actualColor, expectedColor))
+                {
+                    Log::Errorf(
+                        Log::ColorFlags::StdError,
+                        "Mismatch between SPIR-V rendered pixel (%u, %u) [%02X %02X %02X %02X] and expected color [%02X %02X %02X %02X]\n",
+                        x, y,
+                        actualColor[0], actualColor[1], actualColor[2], actualColor[3],
+                        expectedColor[0], expectedColor[1], expectedColor[2], expectedColor[3]
+                    );
+                    result = TestResult::FailedMismatch;
+                    if (!opt.greedy)
+                        break;
+                }
+            }
+        }
+
+        // Clear resources
+        SAFE_RELEASE(pso);
+        SAFE_RELEASE(psoLayout);
+        SAFE_RELEASE(target);
+        SAFE_RELEASE(targetTex);
+        SAFE_RELEASE(texSampler);
+        SAFE_RELEASE(tex);
+        SAFE_RELEASE(colorsBuffer);
+        SAFE_RELEASE(matricesBuffer);
+        SAFE_RELEASE(vertexBuffer);
+        SAFE_RELEASE(fragShader);
+        SAFE_RELEASE(vertShader);
+    }
+    else if (frame == 1)
+    {
+        Shader* compShader = LoadSpirvShader("SpirvReflectTest.comp.spv", ShaderType::Compute);
+        if (compShader == nullptr)
+            return TestResult::FailedErrors;
+
+        // Create input texture with a gradient and two single-colored textures for the combined texture-samplers
+        constexpr std::uint32_t gridSize = 8;
+
+        float colorMapTexels[gridSize][gridSize][4];
+        for_range(y, gridSize)
+        {
+            for_range(x, gridSize)
+            {
+                colorMapTexels[y][x][0] = static_cast<float>(x) / gridSize;
+                colorMapTexels[y][x][1] = static_cast<float>(y) / gridSize;
+                colorMapTexels[y][x][2] = 0.25f;
+                colorMapTexels[y][x][3] = 1.0f;
+            }
+        }
+        const float combinedTexels[2][4] =
+        {
+            { 1.0f, 0.0f, 0.0f, 1.0f },
+            { 0.0f, 0.0f, 1.0f, 1.0f },
+        };
+
+        TextureDescriptor texDesc;
+        {
+            texDesc.type        = TextureType::Texture2D;
+            texDesc.format      = Format::RGBA32Float;
+            texDesc.extent      = Extent3D{ gridSize, gridSize, 1 };
+            texDesc.mipLevels   = 1;
+            texDesc.bindFlags   = BindFlags::Sampled;
+        }
+        const ImageView colorMapImage{ ImageFormat::RGBA, DataType::Float32, colorMapTexels, sizeof(colorMapTexels) };
+        CREATE_TEXTURE(colorMap, texDesc, "spirv.colorMap", &colorMapImage);
+
+        {
+            texDesc.extent      = Extent3D{ 1, 1, 1 };
+        }
+        const ImageView combinedImage0{ ImageFormat::RGBA, DataType::Float32, combinedTexels[0], sizeof(combinedTexels[0]) };
+        CREATE_TEXTURE(combinedTex0, texDesc, "spirv.combinedTex0", &combinedImage0);
+
+        const ImageView combinedImage1{ ImageFormat::RGBA, DataType::Float32, combinedTexels[1], sizeof(combinedTexels[1]) };
+        CREATE_TEXTURE(combinedTex1, texDesc, "spirv.combinedTex1", &combinedImage1);
+
+        {
+            texDesc.extent      = Extent3D{ gridSize, gridSize, 1 };
+            texDesc.bindFlags   = BindFlags::Storage | BindFlags::CopySrc;
+        }
+        CREATE_TEXTURE(colorMapOut, texDesc, "spirv.colorMapOut", nullptr);
+
+        // Sample exactly at texel corners with nearest filtering to get one texel per invocation
+        Sampler* linearSampler = renderer->CreateSampler(Parse("filter=nearest,address=clamp"));
+
+        // Create constant buffer and output buffer for each invocation of a single 8x8 workgroup
+        const float constBufferData[4] =
+        {
+            1.0f / gridSize, 1.0f / gridSize,   // colorMapSizeInv
+            0.5f, 0.25f,                        // blendFactors
+        };
+        BufferDescriptor constBufferDesc;
+        {
+            constBufferDesc.size        = sizeof(constBufferData);
+            constBufferDesc.bindFlags   = BindFlags::ConstantBuffer;
+        }
+        CREATE_BUFFER(constBuffer, constBufferDesc, "spirv.constBuffer", constBufferData);
+
+        BufferDescriptor outBufferDesc;
+        {
+            outBufferDesc.size      = sizeof(float) * 4 * gridSize * gridSize;
+            outBufferDesc.bindFlags = BindFlags::Storage | BindFlags::CopySrc;
+            outBufferDesc.stride    = sizeof(float) * 4;
+        }
+        CREATE_BUFFER(outBuffer, outBufferDesc, "spirv.outBuffer", nullptr);
+
+        // Create compute PSO; the combined texture-samplers are backed by a texture array in a heap and a static sampler
+        PipelineLayoutDescriptor psoLayoutDesc = Parse(
+            "cbuffer(constBuffer@1):comp,"
+            "rwbuffer(outBuffer@2):comp,"
+            "texture(colorMap@3):comp,"
+            "rwtexture(colorMapOut@4):comp,"
+            "sampler(linearSampler@5):comp,"
+            "heap{ texture(combinedTexSamplers@6[2]):comp },"
+            "float4(diffuseColor),"
+        );
+        psoLayoutDesc.staticSamplers.push_back(StaticSamplerDescriptor{ StageFlags::ComputeStage, BindingSlot{ 6 }, Parse("filter=nearest,address=clamp") });
+        PipelineLayout* psoLayout = renderer->CreatePipelineLayout(psoLayoutDesc);
+
+        ResourceHeap* resHeap = renderer->CreateResourceHeap(psoLayout, { combinedTex0, combinedTex1 });
+
+        ComputePipelineDescriptor psoDesc;
+        {
+            psoDesc.computeShader   = compShader;
+            psoDesc.pipelineLayout  = psoLayout;
+        }
+        CREATE_COMPUTE_PSO(pso, psoDesc, "spirv.computePSO");
+
+        // Dispatch compute kernel
+        const float diffuseColor[4] = { 1.0f, 0.5f, 2.0f, 1.0f };
+
+        BEGIN();
+        {
+            cmdBuffer->FillBuffer(*outBuffer, 0, 0xDEADBEEF);
+            cmdBuffer->SetPipelineState(*pso);
+            cmdBuffer->SetResourceHeap(*resHeap);
+            cmdBuffer->SetResource(0, *constBuffer);
+            cmdBuffer->SetResource(1, *outBuffer);
+            cmdBuffer->SetResource(2, *colorMap);
+            cmdBuffer->SetResource(3, *colorMapOut);
+            cmdBuffer->SetResource(4, *linearSampler);
+            cmdBuffer->SetUniforms(0, diffuseColor, sizeof(diffuseColor));
+            cmdBuffer->Dispatch(1, 1, 1);
+        }
+        END();
+
+        // Read back results and compare them with the CPU reference of the blended colors
+        float outColors[gridSize * gridSize][4] = {};
+        renderer->ReadBuffer(*outBuffer, 0, outColors, sizeof(outColors));
+
+        float imageColors[gridSize][gridSize][4] = {};
+        MutableImageView imageColorsView{ ImageFormat::RGBA, DataType::Float32, imageColors, sizeof(imageColors) };
+        renderer->ReadTexture(*colorMapOut, TextureRegion{ Offset3D{}, texDesc.extent }, imageColorsView);
+
+        for_range(y, gridSize)
+        {
+            for_range(x, gridSize)
+            {
+                float expectedBlend[4], expectedOut[4];
+                for_range(i, 4)
+                {
+                    const float color12 = combinedTexels[0][i] + (combinedTexels[1][i] - combinedTexels[0][i]) * constBufferData[2];
+                    expectedBlend[i]    = colorMapTexels[y][x][i] + (color12 - colorMapTexels[y][x][i]) * constBufferData[3];
+                    expectedOut[i]      = expectedBlend[i] * diffuseColor[i];
+                }
+
+                const float (&actualBlend)[4]   = imageColors[y][x];
+                const float (&actualOut)[4]     = outColors[y * gridSize + x];
+
+                for_range(i, 4)
+                {
+                    if (!IsFloatEqual(actualBlend[i], expectedBlend[i]) || !IsFloatEqual(actualOut[i], expectedOut[i]))
+                    {
+                        Log::Errorf(
+                            Log::ColorFlags::StdError,
+                            "Mismatch between SPIR-V compute result (%u, %u) [image: %f %f %f %f, buffer: %f %f %f %f] "
+                            "and expected values [image: %f %f %f %f, buffer: %f %f %f %f]\n",
+                            x, y,
+                            actualBlend[0], actualBlend[1], actualBlend[2], actualBlend[3],
+                            actualOut[0], actualOut[1], actualOut[2], actualOut[3],
+                            expectedBlend[0], expectedBlend[1], expectedBlend[2], expectedBlend[3],
+                            expectedOut[0], expectedOut[1], expectedOut[2], expectedOut[3]
+                        );
+                        result = TestResult::FailedMismatch;
+                        break;
+                    }
+                }
+
+                if (result != TestResult::Passed && !opt.greedy)
+                    break;
+            }
+        }
+
+        // Clear resources
+        SAFE_RELEASE(pso);
+        SAFE_RELEASE(resHeap);
+        SAFE_RELEASE(psoLayout);
+        SAFE_RELEASE(linearSampler);
+        SAFE_RELEASE(outBuffer);
+        SAFE_RELEASE(constBuffer);
+        SAFE_RELEASE(colorMapOut);
+        SAFE_RELEASE(combinedTex1);
+        SAFE_RELEASE(combinedTex0);
+        SAFE_RELEASE(colorMap);
+        SAFE_RELEASE(compShader);
+    }
+    else if (frame == 2)
+    {
+        Shader* compShader = LoadSpirvShader("WorkgroupReduction.comp.spv", ShaderType::Compute);
+        if (compShader == nullptr)
+            return TestResult::FailedErrors;
+
+        // Create input values for several workgroups of 64 invocations each
+        constexpr std::uint32_t localSize       = 64;
+        constexpr std::uint32_t numWorkGroups   = 5;
+        constexpr std::uint32_t numValues       = localSize * numWorkGroups;
+
+        std::uint32_t inValues[numValues];
+        std::uint32_t expectedSums[numWorkGroups] = {};
+
+        for_range(i, numValues)
+        {
+            inValues[i] = (i * 7919u) % 1000u + 1u;
+            expectedSums[i / localSize] += inValues[i];
+        }
+
+        BufferDescriptor inBufferDesc;
+        {
+            inBufferDesc.size       = sizeof(inValues);
+            inBufferDesc.bindFlags  = BindFlags::Storage;
+            inBufferDesc.stride     = sizeof(std::uint32_t);
+        }
+        CREATE_BUFFER(inBuffer, inBufferDesc, "spirv.reduction.inBuffer", inValues);
+
+        // Create one output buffer for the direct and one for the indirect dispatch
+        BufferDescriptor outBufferDesc;
+        {
+            outBufferDesc.size      = sizeof(expectedSums);
+            outBufferDesc.bindFlags = BindFlags::Storage | BindFlags::CopySrc;
+            outBufferDesc.stride    = sizeof(std::uint32_t);
+        }
+        CREATE_BUFFER(outBufferDirect, outBufferDesc, "spirv.reduction.outBufferDirect", nullptr);
+        CREATE_BUFFER(outBufferIndirect, outBufferDesc, "spirv.reduction.outBufferIndirect", nullptr);
+
+        const DispatchIndirectArguments indirectArgs = { { numWorkGroups, 1, 1 } };
+
+        BufferDescriptor argsBufferDesc;
+        {
+            argsBufferDesc.size         = sizeof(indirectArgs);
+            argsBufferDesc.bindFlags    = BindFlags::IndirectBuffer;
+        }
+        CREATE_BUFFER(argsBuffer, argsBufferDesc, "spirv.reduction.argsBuffer", &indirectArgs);
+
+        PipelineLayout* psoLayout = renderer->CreatePipelineLayout(Parse("rwbuffer(inBuffer@0):comp, rwbuffer(outBuffer@1):comp"));
+
+        ComputePipelineDescriptor psoDesc;
+        {
+            psoDesc.computeShader   = compShader;
+            psoDesc.pipelineLayout  = psoLayout;
+        }
+        CREATE_COMPUTE_PSO(pso, psoDesc, "spirv.reductionPSO");
+
+        // Dispatch workgroup reduction directly and indirectly
+        BEGIN();
+        {
+            cmdBuffer->FillBuffer(*outBufferDirect, 0, 0xDEADBEEF);
+            cmdBuffer->FillBuffer(*outBufferIndirect, 0, 0xDEADBEEF);
+            cmdBuffer->SetPipelineState(*pso);
+            cmdBuffer->SetResource(0, *inBuffer);
+            cmdBuffer->SetResource(1, *outBufferDirect);
+            cmdBuffer->Dispatch(numWorkGroups, 1, 1);
+            cmdBuffer->SetResource(1, *outBufferIndirect);
+            cmdBuffer->DispatchIndirect(*argsBuffer, 0);
+        }
+        END();
+
+        // Read back sums of each workgroup
+        Buffer* outBuffers[2] = { outBufferDirect, outBufferIndirect };
+        const char* dispatchNames[2] = { "Dispatch", "DispatchIndirect" };
+
+        for_range(i, 2)
+        {
+            std::uint32_t outSums[numWorkGroups] = {};
+            renderer->ReadBuffer(*outBuffers[i], 0, outSums, sizeof(outSums));
+
+            for_range(workGroup, numWorkGroups)
+            {
+                if (outSums[workGroup] != expectedSums[workGroup])
+                {
+                    Log::Errorf(
+                        Log::ColorFlags::StdError,
+                        "Mismatch between SPIR-V workgroup reduction [%u] with %s (0x%08X) and expected sum (0x%08X)\n",
+                        workGroup, dispatchNames[i], outSums[workGroup], expectedSums[workGroup]
+                    );
+                    result = TestResult::FailedMismatch;
+                    if (!opt.greedy)
+                        break;
+                }
+            }
+        }
+
+        // Clear resources
+        SAFE_RELEASE(pso);
+        SAFE_RELEASE(psoLayout);
+        SAFE_RELEASE(argsBuffer);
+        SAFE_RELEASE(outBufferIndirect);
+        SAFE_RELEASE(outBufferDirect);
+        SAFE_RELEASE(inBuffer);
+        SAFE_RELEASE(compShader);
+    }
+
+    if (frame + 1 < numFrames)
+        return TestResult::Continue;
+
+    return result;
+}
+
+#else // LLGL_TESTBED_INCLUDE_NULL_SPIRV_TESTS
+
+DEF_TEST( SpirvInterpreter )
+{
+    return TestResult::Skipped; // SPIR-V execution not included in Null renderer
+}
+
+#endif // /LLGL_TESTBED_INCLUDE_NULL_SPIRV_TESTS
+
@@ -0,0 +1,120 @@
+/*
+ * TestTaskScheduler.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/TaskScheduler.h>
+#include <LLGL/ThreadPool.h>
+#include <atomic>
+#include <vector>
+
+
+// This test ensures that scheduled tasks are executed exactly once and only after all of their dependencies have completed.
+DEF_RITEST( TaskScheduler )
+{
+    // Test diamond-shaped dependency graph: A -> (B, C) -> D
+    std::atomic<int> counter{ 0 };
+    int orderA = -1, orderB = -1, orderC = -1, orderD = -1;
+
+    TaskHandle taskA = TaskScheduler::Schedule([&]() { orderA = counter++; });
+    TaskHandle taskB = taskA.Then([&]() { orderB = counter++; });
+    TaskHandle taskC = TaskScheduler::Schedule([&]() { orderC = counter++; }, { taskA });
+    TaskHandle taskD = TaskScheduler::Schedule([&]() { orderD = counter++; }, { taskB, taskC, TaskHandle{} });
+
+    taskD.Wait();
+
+    if (!(taskA.IsCompleted() && taskB.IsCompleted() && taskC.IsCompleted() && taskD.IsCompleted()))
+    {
+        Log::Errorf(Log::ColorFlags::StdError, "TaskHandle::Wait() returned before all dependencies have completed\n");
+        return TestResult::FailedErrors;
+    }
+
+    if (!(orderA == 0 && orderB > orderA && orderC > orderA && orderD == 3))
+    {
+        Log::Errorf(
+            Log::ColorFlags::StdError,
+            "Mismatch between order of dependent tasks: A = %d, B = %d, C = %d, D = %d\n",
+            orderA, orderB, orderC, orderD
+        );
+        return TestResult::FailedMismatch;
+    }
+
+    // Test dependency on a task that has already completed
+    bool isLateTaskExecuted = false;
+    taskA.Then([&isLateTaskExecuted]() { isLateTaskExecuted = true; }).Wait();
+    if (!isLateTaskExecuted)
+    {
+        Log::Errorf(Log::ColorFlags::StdError, "Continuation of completed task was not executed\n");
+        return TestResult::FailedErrors;
+    }
+
+    // Test fan-out and fan-in with nested parallel ranges inside tasks; each chain step must see the result of its predecessor
+    const int numChains = 16, numChainSteps = 8;
+    std::vector<int> chainValues(numChains, 0);
+    std::vector<std::atomic<int>> chainElements(numChains);
+    std::vector<TaskHandle> chainTasks;
+
+    for (int chain = 0; chain < numChains; ++chain)
+    {
+        chainElements[chain] = 0;
+        TaskHandle task;
+        for (int step = 0; step < numChainSteps; ++step)
+        {
+            task = TaskScheduler::Schedule(
+                [&chainValues, &chainElements, chain, step]()
+                {
+                    if (chainValues[chain] == step)
+                        ++chainValues[chain];
+                    ThreadPool::ParallelFor(
+                        [&chainElements, chain](std::size_t begin, std::size_t end)
+                        {
+                            chainElements[chain] += static_cast<int>(end - begin);
+                        },
+                        256, 4, 16
+                    );
+                },
+                { task }
+            );
+        }
+        chainTasks.push_back(task);
+    }
+
+    TaskScheduler::WaitAll(chainTasks);
+
+    for (int chain = 0; chain < numChains; ++chain)
+    {
+        if (chainValues[chain] != numChainSteps || chainElements[chain] != numChainSteps * 256)
+        {
+            Log::Errorf(
+                Log::ColorFlags::StdError,
+                "Mismatch in task chain [%d]: %d steps (expected %d), %d elements (expected %d)\n",
+                chain, chainValues[chain], numChainSteps, static_cast<int>(chainElements[chain]), numChainSteps * 256
+            );
+            return TestResult::FailedMismatch;
+        }
+    }
+
+    // Test tasks with disabled thread pool, which are executed immediately
+    const unsigned prevWorkerCount = ThreadPool::GetWorkerCount();
+
+    ThreadPool::SetWorkerCount(0);
+    {
+        int value = 0;
+        TaskHandle first = TaskScheduler::Schedule([&value]() { value = 1; });
+        TaskHandle second = first.Then([&value]() { value *= 2; });
+        second.Wait();
+        if (value != 2)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "Mismatch of task result with disabled thread pool: %d (expected 2)\n", value);
+            ThreadPool::SetWorkerCount(prevWorkerCount);
+            return TestResult::FailedMismatch;
+        }
+    }
+    ThreadPool::SetWorkerCount(prevWorkerCount);
+
+    return TestResult::Passed;
+}
+
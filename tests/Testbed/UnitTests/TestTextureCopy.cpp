@@ -194,6 +194,95 @@ DEF_TEST( TextureCopy )
     if (caps.features.hasCubeArrayTextures)
         TEST_TEXTURE_COPY("tex{Cube[2],16w}", TextureType::TextureCubeArray, Extent3D(16, 16, 1), 2, 6*2);
 
+    // Copy large region that exceeds the size at which backends might copy textures with multiple threads
+    auto CopyLargeTextureRegion = [this](const Extent3D& extent, const Offset3D& srcOffset, const Offset3D& dstOffset, const Extent3D& copyExtent) -> TestResult
+    {
+        // Generate unique value for each texel of the source texture
+        std::vector<std::uint32_t> srcImageData;
+        srcImageData.resize(extent.width * extent.height);
+        for_range(i, srcImageData.size())
+            srcImageData[i] = static_cast<std::uint32_t>(i * 2654435761u);
+
+        ImageView srcImage;
+        {
+            srcImage.format     = ImageFormat::RGBA;
+            srcImage.dataType   = DataType::UInt8;
+            srcImage.data       = srcImageData.data();
+            srcImage.dataSize   = srcImageData.size() * sizeof(std::uint32_t);
+        }
+        TextureDescriptor texDesc;
+        {
+            texDesc.bindFlags   = BindFlags::CopySrc | BindFlags::CopyDst;
+            texDesc.format      = Format::RGBA8UNorm;
+            texDesc.extent      = extent;
+            texDesc.mipLevels   = 1;
+        }
+        CREATE_TEXTURE(srcTex, texDesc, "src.tex{2D,large}", &srcImage);
+
+        const std::vector<std::uint32_t> dstInitialData(srcImageData.size(), 0xDEADBEEF);
+        ImageView dstInitialImage = srcImage;
+        dstInitialImage.data = dstInitialData.data();
+        CREATE_TEXTURE(dstTex, texDesc, "dst.tex{2D,large}", &dstInitialImage);
+
+        BEGIN();
+        {
+            cmdBuffer->CopyTexture(*dstTex, TextureLocation{ dstOffset }, *srcTex, TextureLocation{ srcOffset }, copyExtent);
+        }
+        END();
+
+        // Read entire destination texture back to also validate the texels surrounding the copied region
+        std::vector<std::uint32_t> dstImageData;
+        dstImageData.resize(srcImageData.size());
+
+        MutableImageView dstImage;
+        {
+            dstImage.format     = ImageFormat::RGBA;
+            dstImage.dataType   = DataType::UInt8;
+            dstImage.data       = dstImageData.data();
+            dstImage.dataSize   = dstImageData.size() * sizeof(std::uint32_t);
+        }
+        renderer->ReadTexture(*dstTex, TextureRegion{ Offset3D{}, extent }, dstImage);
+
+        TestResult result = TestResult::Passed;
+
+        for (std::uint32_t y = 0; y < extent.height && result == TestResult::Passed; ++y)
+        {
+            for_range(x, extent.width)
+            {
+                const std::int32_t  srcX            = static_cast<std::int32_t>(x) - dstOffset.x + srcOffset.x;
+                const std::int32_t  srcY            = static_cast<std::int32_t>(y) - dstOffset.y + srcOffset.y;
+                const bool          isInsideRegion  =
+                (
+                    static_cast<std::int32_t>(x) >= dstOffset.x && static_cast<std::int32_t>(x) < dstOffset.x + static_cast<std::int32_t>(copyExtent.width) &&
+                    static_cast<std::int32_t>(y) >= dstOffset.y && static_cast<std::int32_t>(y) < dstOffset.y + static_cast<std::int32_t>(copyExtent.height)
+                );
+                const std::uint32_t expectedValue   = (isInsideRegion ? srcImageData[srcY * extent.width + srcX] : dstInitialData[y * extent.width + x]);
+                const std::uint32_t actualValue     = dstImageData[y * extent.width + x];
+
+                if (actualValue != expectedValue)
+                {
+                    Log::Errorf(
+                        "Mismatch between data of large texture copy at (%u, %u) [0x%08X] and expected value [0x%08X]\n",
+                        x, y, actualValue, expectedValue
+                    );
+                    result = TestResult::FailedMismatch;
+                    break;
+                }
+            }
+        }
+
+        renderer->Release(*srcTex);
+        renderer->Release(*dstTex);
+
+        return result;
+    };
+
+    {
+        TestResult result = CopyLargeTextureRegion(Extent3D{ 512, 512, 1 }, Offset3D{ 7, 3, 0 }, Offset3D{ 64, 100, 0 }, Extent3D{ 384, 300, 1 });
+        if (result != TestResult::Passed)
+            return result;
+    }
+
     return TestResult::Passed;
 }
 
@@ -0,0 +1,159 @@
+/*
+ * TestThreadPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/ThreadPool.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Timer.h>
+#include <atomic>
+#include <vector>
+
+
+// This test ensures that the process-wide thread pool processes each element of a range exactly once, also for nested and disabled pools.
+DEF_RITEST( ThreadPool )
+{
+    auto TestParallelFor = [](const char* name, std::size_t count, unsigned threadCount, unsigned threadMinWorkSize) -> TestResult
+    {
+        std::vector<std::atomic<int>> visits(count);
+        for (std::atomic<int>& v : visits)
+            v = 0;
+
+        ThreadPool::ParallelFor(
+            [&visits](std::size_t begin, std::size_t end)
+            {
+                for_subrange(i, begin, end)
+                    ++visits[i];
+            },
+            count,
+            threadCount,
+            threadMinWorkSize
+        );
+
+        for_range(i, count)
+        {
+            if (visits[i] != 1)
+            {
+                Log::Errorf(
+                    Log::ColorFlags::StdError,
+                    "ThreadPool::ParallelFor(%s) visited element [%u] %d times\n",
+                    name, static_cast<unsigned>(i), static_cast<int>(visits[i])
+                );
+                return TestResult::FailedMismatch;
+            }
+        }
+
+        return TestResult::Passed;
+    };
+
+    #define TEST_PARALLEL_FOR(NAME, COUNT, THREADS, MINWORKSIZE)                                    \
+        {                                                                                           \
+            const TestResult result = TestParallelFor((NAME), (COUNT), (THREADS), (MINWORKSIZE));   \
+            if (result != TestResult::Passed)                                                       \
+                return result;                                                                      \
+        }
+
+    // Test ranges with different thread counts and remainders
+    TEST_PARALLEL_FOR("single", 100, 1, 64);
+    TEST_PARALLEL_FOR("uneven", 1001, 7, 16);
+    TEST_PARALLEL_FOR("max", 100000, LLGL_MAX_THREAD_COUNT, 64);
+
+    // Test nested ranges from within pool tasks
+    const int numNestedTasks = 8;
+    std::atomic<int> numNestedTasksCompleted{ 0 };
+    std::atomic<int> numNestedElements{ 0 };
+
+    for (int i = 0; i < numNestedTasks; ++i)
+    {
+        ThreadPool::Submit(
+            [&numNestedTasksCompleted, &numNestedElements]()
+            {
+                ThreadPool::ParallelFor(
+                    [&numNestedElements](std::size_t begin, std::size_t end)
+                    {
+                        numNestedElements += static_cast<int>(end - begin);
+                    },
+                    1000, 4, 16
+                );
+                ++numNestedTasksCompleted;
+            }
+        );
+    }
+
+    while (numNestedTasksCompleted < numNestedTasks)
+        std::this_thread::yield();
+
+    if (numNestedElements != numNestedTasks * 1000)
+    {
+        Log::Errorf(Log::ColorFlags::StdError, "Nested ThreadPool::ParallelFor processed %d elements, but expected %d\n", static_cast<int>(numNestedElements), numNestedTasks * 1000);
+        return TestResult::FailedMismatch;
+    }
+
+    // Test opt-out of the thread pool: ranges are still processed by temporary threads and submitted tasks run immediately
+    const unsigned prevWorkerCount = ThreadPool::GetWorkerCount();
+
+    ThreadPool::SetWorkerCount(0);
+    {
+        if (ThreadPool::GetWorkerCount() != 0)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "ThreadPool::GetWorkerCount() returned %u for disabled thread pool\n", ThreadPool::GetWorkerCount());
+            ThreadPool::SetWorkerCount(prevWorkerCount);
+            return TestResult::FailedMismatch;
+        }
+
+        bool isTaskExecuted = false;
+        ThreadPool::Submit([&isTaskExecuted]() { isTaskExecuted = true; });
+        if (!isTaskExecuted)
+        {
+            Log::Errorf(Log::ColorFlags::StdError, "ThreadPool::Submit() did not execute task immediately for disabled thread pool\n");
+            ThreadPool::SetWorkerCount(prevWorkerCount);
+            return TestResult::FailedMismatch;
+        }
+
+        const TestResult result = TestParallelFor("disabled", 1001, 7, 16);
+        if (result != TestResult::Passed)
+        {
+            ThreadPool::SetWorkerCount(prevWorkerCount);
+            return result;
+        }
+    }
+
+    // Compare timing of small image conversions between temporary threads and persistent worker threads
+    if (opt.showTiming)
+    {
+        std::vector<std::uint8_t> srcImage(64 * 64 * 4, 0x80);
+        std::vector<float> dstImage(64 * 64 * 4);
+
+        const ImageView         srcImageView{ ImageFormat::RGBA, DataType::UInt8,   srcImage.data(), srcImage.size() };
+        const MutableImageView  dstImageView{ ImageFormat::BGRA, DataType::Float32, dstImage.data(), dstImage.size() * sizeof(float) };
+
+        auto MeasureConversions = [&]() -> double
+        {
+            const int numIterations = 1000;
+            const std::uint64_t startTime = Timer::Tick();
+            for (int i = 0; i < numIterations; ++i)
+                ConvertImageBuffer(srcImageView, dstImageView, Extent3D{ 64, 64, 1 }, 4);
+            const std::uint64_t endTime = Timer::Tick();
+            return static_cast<double>(endTime - startTime) / static_cast<double>(Timer::Frequency()) * 1000.0 / numIterations;
+        };
+
+        const double temporaryThreadsTime = MeasureConversions();
+        ThreadPool::SetWorkerCount(prevWorkerCount);
+        const double threadPoolTime = MeasureConversions();
+
+        Log::Printf(
+            "Conversions of 64x64 image with 4 threads: temporary threads (%.4f ms), thread pool with %u workers (%.4f ms)\n",
+            temporaryThreadsTime, ThreadPool::GetWorkerCount(), threadPoolTime
+        );
+    }
+
+    ThreadPool::SetWorkerCount(prevWorkerCount);
+
+    #undef TEST_PARALLEL_FOR
+
+    return TestResult::Passed;
+}
+
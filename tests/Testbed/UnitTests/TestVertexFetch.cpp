@@ -0,0 +1,443 @@
+/*
+ * TestVertexFetch.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <LLGL/Utils/TypeNames.h>
+
+
+/*
+Tests vertex fetch and input assembly with pixel-aligned rectangles in a grid of cells:
+The first row draws each rectangle with a different combination of normalized vertex formats for position and color,
+the second row draws rectangles with per-instance colors, and the third row draws indexed triangle strips with primitive restart.
+Each cell has a solid color, so the center of each cell and the gaps between the strips are validated with exact pixel colors.
+Integer vertex formats are not covered, since the unprojected mesh shader only takes floating-point inputs.
+*/
+DEF_TEST( VertexFetch )
+{
+    // Test loads the unprojected mesh shader with custom vertex formats, which is only available as SPIR-V for all backends
+    if (!IsShadingLanguageSupported(ShadingLanguage::SPIRV))
+    {
+        if (opt.verbose)
+            Log::Printf("SPIR-V not supported\n");
+        return TestResult::Skipped;
+    }
+
+    if (!caps.features.hasInstancing)
+    {
+        if (opt.verbose)
+            Log::Printf("Instancing not supported\n");
+        return TestResult::Skipped;
+    }
+
+    constexpr std::uint32_t cellSize    = 64;
+    constexpr std::uint32_t cellSpacing = 16;
+    constexpr std::uint32_t numColumns  = 8;
+    constexpr std::uint32_t numRows     = 3;
+
+    const Extent2D resolution = opt.resolution;
+    if (resolution.width < (cellSize + cellSpacing) * numColumns + cellSpacing ||
+        resolution.height < (cellSize + cellSpacing) * numRows + cellSpacing)
+    {
+        Log::Errorf("Resolution is too small to draw %ux%u cells of %ux%u pixels\n", numColumns, numRows, cellSize, cellSize);
+        return TestResult::FailedErrors;
+    }
+
+    // Vertex with the same position and color in multiple encodings; each draw selects its encoding with the vertex attribute offsets
+    struct FetchVertex
+    {
+        float           positionF32[2];
+        std::int16_t    positionS16[2];
+        std::int8_t     positionS8[2];
+        std::uint8_t    padding[2];
+        std::uint8_t    colorU8[4];
+        std::uint8_t    colorBGRA8[4];
+        std::int8_t     colorS8[4];
+        std::uint16_t   colorU16[4];
+        std::int16_t    colorS16[4];
+    };
+
+    const ColorRGBAf cellColors[] =
+    {
+        ColorRGBAf{ 1.0f, 0.2f, 0.0f, 1.0f },
+        ColorRGBAf{ 0.2f, 1.0f, 0.6f, 1.0f },
+        ColorRGBAf{ 0.0f, 0.6f, 1.0f, 1.0f },
+        ColorRGBAf{ 1.0f, 1.0f, 0.2f, 1.0f },
+        ColorRGBAf{ 0.6f, 0.0f, 1.0f, 1.0f },
+        ColorRGBAf{ 0.2f, 0.6f, 0.2f, 0.2f }, // Alpha must be ignored by RGB8UNorm format
+        ColorRGBAf{ 0.6f, 0.2f, 1.0f, 0.6f }, // Green, blue, and alpha must be ignored by R16UNorm format
+    };
+
+    constexpr std::uint32_t numFormatCells      = sizeof(cellColors)/sizeof(cellColors[0]);
+    constexpr std::uint32_t numInstanceCells    = 4;
+    constexpr std::uint32_t numStripCells       = 4;
+    constexpr std::uint32_t numCells            = numFormatCells + numInstanceCells + numStripCells;
+
+    struct CellLocation
+    {
+        std::uint32_t column;
+        std::uint32_t row;
+    };
+
+    auto GetCellLocation = [](std::uint32_t cell) -> CellLocation
+    {
+        if (cell < numFormatCells)
+            return CellLocation{ cell, 0 };
+        else if (cell < numFormatCells + numInstanceCells)
+            return CellLocation{ cell - numFormatCells, 1 };
+        else
+            return CellLocation{ (cell - numFormatCells - numInstanceCells) * 2, 2 }; // Strip cells leave a gap column between each other
+    };
+
+    auto GetCellOrigin = [](std::uint32_t column, std::uint32_t row) -> Offset2D
+    {
+        return Offset2D
+        {
+            static_cast<std::int32_t>(cellSpacing + column * (cellSize + cellSpacing)),
+            static_cast<std::int32_t>(cellSpacing + row    * (cellSize + cellSpacing)),
+        };
+    };
+
+    auto EncodeUNorm8 = [](float value) -> std::uint8_t
+    {
+        return static_cast<std::uint8_t>(value * 255.0f + 0.5f);
+    };
+
+    auto EncodeSNorm8 = [](float value) -> std::int8_t
+    {
+        return static_cast<std::int8_t>(std::round(value * 127.0f));
+    };
+
+    auto EncodeUNorm16 = [](float value) -> std::uint16_t
+    {
+        return static_cast<std::uint16_t>(value * 65535.0f + 0.5f);
+    };
+
+    auto EncodeSNorm16 = [](float value) -> std::int16_t
+    {
+        return static_cast<std::int16_t>(std::round(value * 32767.0f));
+    };
+
+    // Generate 4 vertices per cell in triangle strip order: left-top, left-bottom, right-top, right-bottom
+    std::vector<FetchVertex> vertices;
+    vertices.resize(numCells * 4);
+
+    for_range(cell, numCells)
+    {
+        const CellLocation  location    = GetCellLocation(cell);
+        const Offset2D      origin      = GetCellOrigin(location.column, location.row);
+        const ColorRGBAf&   color       = cellColors[cell % numFormatCells];
+
+        const float left    = static_cast<float>(origin.x           ) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float right   = static_cast<float>(origin.x + cellSize) / static_cast<float>(resolution.width ) * 2.0f - 1.0f;
+        const float top     = 1.0f - static_cast<float>(origin.y           ) / static_cast<float>(resolution.height) * 2.0f;
+        const float bottom  = 1.0f - static_cast<float>(origin.y + cellSize) / static_cast<float>(resolution.height) * 2.0f;
+
+        const float corners[4][2] = { { left, top }, { left, bottom }, { right, top }, { right, bottom } };
+
+        for_range(i, 4)
+        {
+            FetchVertex& v = vertices[cell * 4 + i];
+            for_range(c, 2)
+            {
+                v.positionF32[c]    = corners[i][c];
+                v.positionS16[c]    = EncodeSNorm16(corners[i][c]);
+                v.positionS8[c]     = EncodeSNorm8(corners[i][c]);
+                v.padding[c]        = 0;
+            }
+            for_range(c, 4)
+            {
+                v.colorU8[c]    = EncodeUNorm8(color[c]);
+                v.colorBGRA8[c] = EncodeUNorm8(color[c < 3 ? 2 - c : c]);
+                v.colorS8[c]    = EncodeSNorm8(color[c]);
+                v.colorU16[c]   = EncodeUNorm16(color[c]);
+                v.colorS16[c]   = EncodeSNorm16(color[c]);
+            }
+        }
+    }
+
+    const VertexAttribute positionAttribsF32[] =
+    {
+        VertexAttribute{ "position", Format::RG32Float, 0, offsetof(FetchVertex, positionF32), sizeof(FetchVertex) },
+    };
+
+    BufferDescriptor vertexBufDesc;
+    {
+        vertexBufDesc.size          = vertices.size() * sizeof(FetchVertex);
+        vertexBufDesc.bindFlags     = BindFlags::VertexBuffer;
+        vertexBufDesc.vertexAttribs = positionAttribsF32;
+    }
+    CREATE_BUFFER(vertexBuf, vertexBufDesc, "vertexFetch.vertices", vertices.data());
+
+    // Create per-instance colors in separate vertex buffer
+    const std::uint8_t instanceColors[numInstanceCells][4] =
+    {
+        { 255,   0,   0, 255 },
+        {   0, 255,   0, 255 },
+        {   0,   0, 255, 255 },
+        { 255, 255,   0, 255 },
+    };
+
+    const VertexAttribute instanceColorAttribs[] =
+    {
+        VertexAttribute{ "color", Format::RGBA8UNorm, 1, 0, sizeof(instanceColors[0]), /*slot:*/ 1, /*instanceDivisor:*/ 1 },
+    };
+
+    BufferDescriptor instanceBufDesc;
+    {
+        instanceBufDesc.size            = sizeof(instanceColors);
+        instanceBufDesc.bindFlags       = BindFlags::VertexBuffer;
+        instanceBufDesc.vertexAttribs   = instanceColorAttribs;
+    }
+    CREATE_BUFFER(instanceBuf, instanceBufDesc, "vertexFetch.instances", instanceColors);
+
+    Buffer* vertexBuffers[2] = { vertexBuf, instanceBuf };
+    BufferArray* vertexBufArray = renderer->CreateBufferArray(2, vertexBuffers);
+
+    // Create 16-bit and 32-bit indices for two rectangles with primitive restart into single buffer
+    const std::uint16_t indicesUI16[] = { 0, 1, 2, 3, 0xFFFF,     4, 5, 6, 7 };
+    const std::uint32_t indicesUI32[] = { 0, 1, 2, 3, 0xFFFFFFFF, 4, 5, 6, 7 };
+
+    constexpr std::uint64_t indicesUI16Offset   = 0;
+    constexpr std::uint64_t indicesUI32Offset   = sizeof(indicesUI16) + 2; // Keep 32-bit indices 4-byte aligned
+    constexpr std::uint32_t numStripIndices     = sizeof(indicesUI16)/sizeof(indicesUI16[0]);
+
+    BufferDescriptor indexBufDesc;
+    {
+        indexBufDesc.size       = indicesUI32Offset + sizeof(indicesUI32);
+        indexBufDesc.bindFlags  = BindFlags::IndexBuffer;
+    }
+    CREATE_BUFFER(indexBuf, indexBufDesc, "vertexFetch.indices", nullptr);
+
+    renderer->WriteBuffer(*indexBuf, indicesUI16Offset, indicesUI16, sizeof(indicesUI16));
+    renderer->WriteBuffer(*indexBuf, indicesUI32Offset, indicesUI32, sizeof(indicesUI32));
+
+    // Create one PSO for each vertex format
+    struct VertexFormatCase
+    {
+        Format          positionFormat;
+        std::uint32_t   positionOffset;
+        Format          colorFormat;
+        std::uint32_t   colorOffset;
+    };
+
+    const VertexFormatCase formatCases[numFormatCells] =
+    {
+        { Format::RG32Float, offsetof(FetchVertex, positionF32), Format::RGBA8UNorm,  offsetof(FetchVertex, colorU8)    },
+        { Format::RG16SNorm, offsetof(FetchVertex, positionS16), Format::RGBA16UNorm, offsetof(FetchVertex, colorU16)   },
+        { Format::RG8SNorm,  offsetof(FetchVertex, positionS8),  Format::RGBA16SNorm, offsetof(FetchVertex, colorS16)   },
+        { Format::RG32Float, offsetof(FetchVertex, positionF32), Format::BGRA8UNorm,  offsetof(FetchVertex, colorBGRA8) },
+        { Format::RG16SNorm, offsetof(FetchVertex, positionS16), Format::RGBA8SNorm,  offsetof(FetchVertex, colorS8)    },
+        { Format::RG8SNorm,  offsetof(FetchVertex, positionS8),  Format::RGB8UNorm,   offsetof(FetchVertex, colorU8)    },
+        { Format::RG16SNorm, offsetof(FetchVertex, positionS16), Format::R16UNorm,    offsetof(FetchVertex, colorU16)   },
+    };
+
+    const std::string vertShaderFilename = "UnprojectedMesh.450core.vert.spv";
+
+    GraphicsPipelineDescriptor psoDesc;
+    {
+        psoDesc.pipelineLayout      = nullptr; // No resource bindings, therefore no pipeline layout
+        psoDesc.renderPass          = swapChain->GetRenderPass();
+        psoDesc.fragmentShader      = shaders[PSUnprojected];
+        psoDesc.primitiveTopology   = PrimitiveTopology::TriangleStrip;
+    }
+
+    std::vector<VertexAttribute> formatCaseAttribs[numFormatCells];
+    Shader* vertShaders[numFormatCells + 1] = {};
+    PipelineState* formatPSOs[numFormatCells] = {};
+
+    for_range(i, numFormatCells)
+    {
+        const VertexFormatCase& formatCase = formatCases[i];
+        formatCaseAttribs[i] =
+        {
+            VertexAttribute{ "position", formatCase.positionFormat, 0, formatCase.positionOffset, sizeof(FetchVertex) },
+            VertexAttribute{ "color",    formatCase.colorFormat,    1, formatCase.colorOffset,    sizeof(FetchVertex) },
+        };
+
+        vertShaders[i] = LoadShaderFromFile(vertShaderFilename, ShaderType::Vertex, nullptr, nullptr, nullptr, formatCaseAttribs[i]);
+        if (vertShaders[i] == nullptr)
+            return TestResult::FailedErrors;
+
+        psoDesc.vertexShader = vertShaders[i];
+        const std::string psoName = "Test.VertexFetch.Format(" + std::string(ToString(formatCase.positionFormat)) + "," + std::string(ToString(formatCase.colorFormat)) + ")";
+        CREATE_GRAPHICS_PSO_EXT(formatPSOs[i], psoDesc, psoName.c_str());
+    }
+
+    // Create PSO with per-instance color attribute from second vertex buffer
+    vertShaders[numFormatCells] = LoadShaderFromFile(vertShaderFilename, ShaderType::Vertex, nullptr, nullptr, nullptr, { positionAttribsF32[0], instanceColorAttribs[0] });
+    if (vertShaders[numFormatCells] == nullptr)
+        return TestResult::FailedErrors;
+
+    psoDesc.vertexShader = vertShaders[numFormatCells];
+    CREATE_GRAPHICS_PSO(instancePSO, psoDesc, "Test.VertexFetch.Instanced");
+
+    // Create PSOs for triangle strips with fixed index formats and the vertex format of the first cell
+    psoDesc.vertexShader    = vertShaders[0];
+    psoDesc.indexFormat     = Format::R16UInt;
+    CREATE_GRAPHICS_PSO(stripPSO16, psoDesc, "Test.VertexFetch.Strip(R16UInt)");
+
+    psoDesc.indexFormat     = Format::R32UInt;
+    CREATE_GRAPHICS_PSO(stripPSO32, psoDesc, "Test.VertexFetch.Strip(R32UInt)");
+
+    const std::uint32_t instanceCellsFirstVertex    = numFormatCells * 4;
+    const std::uint32_t stripCellsFirstVertex       = (numFormatCells + numInstanceCells) * 4;
+
+    Texture* readbackTex = nullptr;
+
+    // Render scene
+    BEGIN();
+    {
+        cmdBuffer->BeginRenderPass(*swapChain);
+        {
+            cmdBuffer->Clear(ClearFlags::Color, bgColorDarkBlue);
+            cmdBuffer->SetViewport(resolution);
+
+            // Draw each format cell with its own vertex format
+            for_range(i, numFormatCells)
+            {
+                cmdBuffer->SetVertexBuffer(*vertexBuf, static_cast<std::uint32_t>(formatCaseAttribs[i].size()), formatCaseAttribs[i].data());
+                cmdBuffer->SetPipelineState(*formatPSOs[i]);
+                cmdBuffer->Draw(4, i * 4);
+            }
+
+            // Draw instance cells: Later instances are drawn on top of earlier ones, so the last instance determines the color
+            cmdBuffer->SetVertexBufferArray(*vertexBufArray);
+            cmdBuffer->SetPipelineState(*instancePSO);
+            cmdBuffer->DrawInstanced(4, instanceCellsFirstVertex + 0*4, 1);
+            cmdBuffer->DrawInstanced(4, instanceCellsFirstVertex + 1*4, 4);
+            if (caps.features.hasOffsetInstancing)
+            {
+                cmdBuffer->DrawInstanced(4, instanceCellsFirstVertex + 2*4, 1, 2);
+                cmdBuffer->DrawInstanced(4, instanceCellsFirstVertex + 3*4, 2, 1);
+            }
+
+            // Draw two rectangles with one triangle strip each for 16-bit and 32-bit indices
+            cmdBuffer->SetVertexBuffer(*vertexBuf, static_cast<std::uint32_t>(formatCaseAttribs[0].size()), formatCaseAttribs[0].data());
+
+            cmdBuffer->SetPipelineState(*stripPSO16);
+            cmdBuffer->SetIndexBuffer(*indexBuf, Format::R16UInt, indicesUI16Offset);
+            cmdBuffer->DrawIndexed(numStripIndices, 0, static_cast<std::int32_t>(stripCellsFirstVertex));
+
+            cmdBuffer->SetPipelineState(*stripPSO32);
+            cmdBuffer->SetIndexBuffer(*indexBuf, Format::R32UInt, indicesUI32Offset);
+            cmdBuffer->DrawIndexed(numStripIndices, 0, static_cast<std::int32_t>(stripCellsFirstVertex + 8));
+
+            readbackTex = CaptureFramebuffer(*cmdBuffer, swapChain->GetColorFormat(), resolution);
+        }
+        cmdBuffer->EndRenderPass();
+    }
+    END();
+
+    // Read entire framebuffer capture
+    std::vector<std::uint8_t> readbackImage;
+    readbackImage.resize(resolution.width * resolution.height * 4);
+
+    MutableImageView dstImage;
+    {
+        dstImage.format     = ImageFormat::RGBA;
+        dstImage.dataType   = DataType::UInt8;
+        dstImage.data       = readbackImage.data();
+        dstImage.dataSize   = readbackImage.size();
+    }
+    renderer->ReadTexture(*readbackTex, TextureRegion{ Offset3D{}, Extent3D{ resolution.width, resolution.height, 1 } }, dstImage);
+
+    // Evaluate results
+    TestResult result = TestResult::Passed;
+
+    auto EvaluatePixel = [&](const char* name, std::int32_t x, std::int32_t y, const std::uint8_t (&expectedColor)[4]) -> void
+    {
+        if (result != TestResult::Passed && !opt.greedy)
+            return;
+
+        const std::uint8_t* actualColor = &readbackImage[(y * resolution.width + x) * 4];
+        if (!IsRGBA8ubInThreshold(actualColor, expectedColor))
+        {
+            Log::Errorf(
+                "Mismatch between %s at (%d, %d) color [%02X %02X %02X %02X] and expected color [%02X %02X %02X %02X]\n",
+                name, x, y,
+                actualColor[0], actualColor[1], actualColor[2], actualColor[3],
+                expectedColor[0], expectedColor[1], expectedColor[2], expectedColor[3]
+            );
+            result = TestResult::FailedMismatch;
+        }
+    };
+
+    auto EvaluateCell = [&](const char* name, std::uint32_t column, std::uint32_t row, const std::uint8_t (&expectedColor)[4]) -> void
+    {
+        const Offset2D origin = GetCellOrigin(column, row);
+        EvaluatePixel(name, origin.x + cellSize/2, origin.y + cellSize/2, expectedColor);
+    };
+
+    for_range(i, numFormatCells)
+    {
+        const ColorRGBAf& color = cellColors[i];
+        std::uint8_t expectedColor[4] =
+        {
+            EncodeUNorm8(color.r),
+            EncodeUNorm8(color.g),
+            EncodeUNorm8(color.b),
+            EncodeUNorm8(color.a),
+        };
+
+        // Missing components of vertex attributes are filled with (0, 0, 0, 1)
+        const std::uint32_t numComponents = GetFormatAttribs(formatCases[i].colorFormat).components;
+        for (std::uint32_t c = numComponents; c < 4; ++c)
+            expectedColor[c] = (c < 3 ? 0 : 255);
+
+        const std::string cellName = "vertex format (" + std::string(ToString(formatCases[i].positionFormat)) + ", " + std::string(ToString(formatCases[i].colorFormat)) + ")";
+        EvaluateCell(cellName.c_str(), i, 0, expectedColor);
+    }
+
+    EvaluateCell("instance 0 of 1", 0, 1, instanceColors[0]);
+    EvaluateCell("instance 3 of 4", 1, 1, instanceColors[3]);
+    if (caps.features.hasOffsetInstancing)
+    {
+        EvaluateCell("instance 2 with first instance 2", 2, 1, instanceColors[2]);
+        EvaluateCell("instance 2 with first instance 1", 3, 1, instanceColors[2]);
+    }
+
+    // Strips must cover their cells but not the gap in between, which a triangle strip without primitive restart would cover
+    const std::uint8_t clearColor[4] =
+    {
+        EncodeUNorm8(bgColorDarkBlue.color[0]),
+        EncodeUNorm8(bgColorDarkBlue.color[1]),
+        EncodeUNorm8(bgColorDarkBlue.color[2]),
+        EncodeUNorm8(bgColorDarkBlue.color[3]),
+    };
+
+    for_range(i, 2)
+    {
+        const char* stripName = (i == 0 ? "triangle strip with 16-bit indices" : "triangle strip with 32-bit indices");
+        for_range(j, 2)
+        {
+            const std::uint32_t cell = numFormatCells + numInstanceCells + i*2 + j;
+            const ColorRGBAf& color = cellColors[cell % numFormatCells];
+            const std::uint8_t expectedColor[4] = { EncodeUNorm8(color.r), EncodeUNorm8(color.g), EncodeUNorm8(color.b), EncodeUNorm8(color.a) };
+            EvaluateCell(stripName, i*4 + j*2, 2, expectedColor);
+        }
+
+        const Offset2D gapOrigin = GetCellOrigin(i*4 + 1, 2);
+        EvaluatePixel(stripName, gapOrigin.x, gapOrigin.y + cellSize/2, clearColor);
+    }
+
+    // Delete old resources
+    renderer->Release(*readbackTex);
+    renderer->Release(*stripPSO32);
+    renderer->Release(*stripPSO16);
+    renderer->Release(*instancePSO);
+    for_range(i, numFormatCells)
+        renderer->Release(*formatPSOs[i]);
+    for (Shader* sh : vertShaders)
+        renderer->Release(*sh);
+    renderer->Release(*indexBuf);
+    renderer->Release(*vertexBufArray);
+    renderer->Release(*instanceBuf);
+    renderer->Release(*vertexBuf);
+
+    return result;
+}
+
@@ -0,0 +1,182 @@
+/*
+ * TestVirtualCommandChunkPool.cpp
+ *
+ * Copyright (c) 2015 Lukas Hermanns. All rights reserved.
+ * Licensed under the terms of the BSD 3-Clause license (see LICENSE.txt).
+ */
+
+#include "Testbed.h"
+#include <Renderer/VirtualCommandChunkPool.h>
+#include <atomic>
+#include <mutex>
+#include <cstring>
+
+
+/*
+This test allocates and frees memory chunks for virtual command buffers on multiple threads.
+Half of the chunks are freed by the allocating thread and the other half by another thread.
+Chunk capacities must always match their size class, also for recycled chunks, and chunks above the biggest size class must bypass the pool.
+*/
+DEF_RITEST( VirtualCommandChunkPool )
+{
+    constexpr unsigned      numThreads      = 8;
+    constexpr unsigned      numIterations   = 64;
+    constexpr std::size_t   maxPooledSize   = 1024u * 1024u;
+
+    // Capacities of all size classes in ascending order; bigger chunks are allocated with their exact capacity
+    const std::size_t chunkClassCapacities[] =
+    {
+        8u*1024u, 12u*1024u, 16u*1024u, 24u*1024u, 32u*1024u, 48u*1024u, 64u*1024u, 96u*1024u,
+        128u*1024u, 192u*1024u, 256u*1024u, 384u*1024u, 512u*1024u, 768u*1024u, maxPooledSize,
+    };
+
+    const std::size_t requestSizes[] =
+    {
+        1, 8u*1024u, 8u*1024u + 1, 12u*1024u, 12u*1024u + 1, 100u*1024u,
+        maxPooledSize - 1, maxPooledSize, maxPooledSize + 1, 3u * maxPooledSize,
+    };
+
+    constexpr std::size_t numRequests = sizeof(requestSizes)/sizeof(requestSizes[0]);
+
+    auto GetExpectedCapacity = [&chunkClassCapacities](std::size_t minCapacity) -> std::size_t
+    {
+        for (std::size_t capacity : chunkClassCapacities)
+        {
+            if (capacity >= minCapacity)
+                return capacity;
+        }
+        return minCapacity;
+    };
+
+    // Unique tags are written to the begin and end of each payload to detect chunks that are handed out more than once
+    struct TaggedChunk
+    {
+        VirtualCommandChunk*    chunk;
+        std::uint64_t           tag;
+    };
+
+    std::atomic<std::uint64_t>  nextTag{ 1 };
+    std::mutex                  sharedChunksMutex;
+    std::vector<TaggedChunk>    sharedChunks;
+    std::atomic<unsigned>       numErrors{ 0 };
+    std::atomic<unsigned>       numRecycledChunks{ 0 };
+
+    auto ReportError = [&numErrors](const char* what, std::size_t minCapacity, std::size_t capacity) -> void
+    {
+        if (numErrors++ == 0)
+        {
+            Log::Errorf(
+                Log::ColorFlags::StdError,
+                "%s: minCapacity = %zu, capacity = %zu\n",
+                what, minCapacity, capacity
+            );
+        }
+    };
+
+    auto AllocChunk = [&](std::size_t minCapacity) -> TaggedChunk
+    {
+        TaggedChunk tagged{ AllocVirtualCommandChunk(minCapacity), nextTag++ };
+        if (tagged.chunk == nullptr)
+        {
+            ReportError("AllocVirtualCommandChunk() returned null", minCapacity, 0);
+            return tagged;
+        }
+
+        if (tagged.chunk->capacity != GetExpectedCapacity(minCapacity))
+            ReportError("Mismatch between chunk capacity and size class", minCapacity, tagged.chunk->capacity);
+
+        char* payload = reinterpret_cast<char*>(tagged.chunk + 1);
+        ::memcpy(payload, &tagged.tag, sizeof(tagged.tag));
+        ::memcpy(payload + tagged.chunk->capacity - sizeof(tagged.tag), &tagged.tag, sizeof(tagged.tag));
+
+        return tagged;
+    };
+
+    auto FreeChunk = [&](const TaggedChunk& tagged) -> void
+    {
+        const char* payload = reinterpret_cast<const char*>(tagged.chunk + 1);
+        if (::memcmp(payload, &tagged.tag, sizeof(tagged.tag)) != 0 ||
+            ::memcmp(payload + tagged.chunk->capacity - sizeof(tagged.tag), &tagged.tag, sizeof(tagged.tag)) != 0)
+        {
+            ReportError("Chunk payload was modified by another owner", 0, tagged.chunk->capacity);
+        }
+        FreeVirtualCommandChunk(tagged.chunk);
+    };
+
+    auto ThreadMain = [&](unsigned threadIndex) -> void
+    {
+        TaggedChunk chunks[numRequests] = {};
+
+        for_range(iteration, numIterations)
+        {
+            // Allocate one chunk for each request size in an order that is different for each thread and iteration
+            for_range(i, numRequests)
+            {
+                const std::size_t request = (i + threadIndex + iteration) % numRequests;
+                chunks[request] = AllocChunk(requestSizes[request]);
+            }
+
+            // Free odd chunks on this thread and re-allocate them immediately, which must recycle them with the same capacity
+            for (std::size_t i = 1; i < numRequests; i += 2)
+            {
+                if (chunks[i].chunk == nullptr)
+                    continue;
+
+                const VirtualCommandChunk* prevChunk = chunks[i].chunk;
+                FreeChunk(chunks[i]);
+
+                chunks[i] = AllocChunk(requestSizes[i]);
+                if (chunks[i].chunk == nullptr)
+                    continue;
+
+                if (chunks[i].chunk == prevChunk)
+                    ++numRecycledChunks;
+
+                FreeChunk(chunks[i]);
+            }
+
+            // Pass even chunks to other threads and free chunks that other threads have passed to this one
+            std::vector<TaggedChunk> chunksToFree;
+            {
+                std::lock_guard<std::mutex> guard{ sharedChunksMutex };
+                chunksToFree.swap(sharedChunks);
+                for (std::size_t i = 0; i < numRequests; i += 2)
+                {
+                    if (chunks[i].chunk != nullptr)
+                        sharedChunks.push_back(chunks[i]);
+                }
+            }
+
+            for (const TaggedChunk& tagged : chunksToFree)
+                FreeChunk(tagged);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+
+    for_range(i, numThreads)
+        threads.emplace_back(ThreadMain, i);
+
+    for (std::thread& t : threads)
+        t.join();
+
+    // Free remaining chunks on main thread
+    for (const TaggedChunk& tagged : sharedChunks)
+        FreeChunk(tagged);
+
+    if (numErrors > 0)
+        return TestResult::FailedMismatch;
+
+    if (numRecycledChunks == 0)
+    {
+        Log::Errorf(Log::ColorFlags::StdError, "No chunks were recycled by the thread caches of the virtual command chunk pool\n");
+        return TestResult::FailedMismatch;
+    }
+
+    if (opt.verbose)
+        Log::Printf("Recycled %u chunks on %u threads\n", numRecycledChunks.load(), numThreads);
+
+    return TestResult::Passed;
+}
+